@@ -15,12 +15,18 @@ int main(int argc, char *argv[])
    // Initialize ossim stuff, factories, plugin, etc.
    ossimInit::instance()->initialize(argc, argv);
 
+   // Threaded, persistent mode: --threads <n>
+   ossimArgumentParser ap (&argc, argv);
+   unsigned int threads = 0;
+   ap.read("--threads", threads);
+
    const char* DEFAULT_PORT = "ossimd";
    const char* portid = DEFAULT_PORT;
-   if (argc > 1)
-      portid = argv[1];
+   if (ap.argc() > 1)
+      portid = ap.argv()[1];
 
    ossimToolServer ots;
+   ots.setNumberOfThreads(threads);
    ots.startListening(portid);
 
    return 0;
@@ -0,0 +1,98 @@
+#ifndef ossimBlockCache_HEADER
+#define ossimBlockCache_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ossim{
+   /**
+   * @brief Process wide least recently used cache of fixed size stream
+   * blocks.
+   *
+   * Blocks are keyed by the connection string they were read from, the
+   * block size and the block index, so every stream opened on the same url
+   * shares them.  A block is handed out as a shared pointer to const bytes,
+   * an evicted block stays valid for as long as someone still holds it.
+   *
+   * Blocks are never checked against their source again.  BlockSource
+   * erases a url's blocks when the url is first opened again, call erase()
+   * for a url whose contents changed while it is open.
+   */
+   class OSSIM_DLL BlockCache{
+   public:
+      typedef std::shared_ptr<const std::vector<char> > BlockPtr;
+
+      /**
+      * @param maxBytes Bytes of block data kept before the least recently
+      *                 used blocks are dropped.
+      */
+      BlockCache(ossim_uint64 maxBytes=DEFAULT_MAX_BYTES);
+
+      /** @brief The cache shared by the streams of the registry. */
+      static BlockCache* instance();
+
+      /**
+      * @return The block or a null pointer if it is not cached.  A found
+      *         block becomes the most recently used.
+      */
+      BlockPtr find(const std::string& url,
+                    ossim_uint64 blockSize,
+                    ossim_int64 blockIndex);
+
+      /** @brief Adds or replaces a block, then trims to the byte limit. */
+      void insert(const std::string& url,
+                  ossim_uint64 blockSize,
+                  ossim_int64 blockIndex,
+                  BlockPtr block);
+
+      /** @brief Drops every block read from url. */
+      void erase(const std::string& url);
+
+      void clear();
+
+      void setMaxBytes(ossim_uint64 maxBytes);
+      ossim_uint64 getMaxBytes()const;
+
+      /** @return Bytes of block data currently held. */
+      ossim_uint64 getBytes()const;
+
+      ossim_uint64 getHitCount()const;
+      ossim_uint64 getMissCount()const;
+
+      static const ossim_uint64 DEFAULT_MAX_BYTES;
+
+   protected:
+      struct Key{
+         Key(const std::string& url, ossim_uint64 blockSize, ossim_int64 blockIndex)
+         :m_url(url), m_blockSize(blockSize), m_blockIndex(blockIndex){}
+
+         bool operator<(const Key& rhs)const{
+            if(m_blockIndex != rhs.m_blockIndex) return m_blockIndex < rhs.m_blockIndex;
+            if(m_blockSize != rhs.m_blockSize) return m_blockSize < rhs.m_blockSize;
+            return m_url < rhs.m_url;
+         }
+
+         std::string  m_url;
+         ossim_uint64 m_blockSize;
+         ossim_int64  m_blockIndex;
+      };
+      typedef std::list<std::pair<Key, BlockPtr> > LruList;
+
+      /** @brief Drops least recently used blocks until within m_maxBytes. */
+      void trim();
+
+      mutable std::mutex               m_mutex;
+      LruList                          m_lru;
+      std::map<Key, LruList::iterator> m_index;
+      ossim_uint64                     m_maxBytes;
+      ossim_uint64                     m_bytes;
+      ossim_uint64                     m_hitCount;
+      ossim_uint64                     m_missCount;
+   };
+}
+#endif
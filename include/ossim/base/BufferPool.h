@@ -0,0 +1,113 @@
+#ifndef ossimBufferPool_HEADER
+#define ossimBufferPool_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace ossim
+{
+   struct BufferPoolLocalCache;
+
+   /**
+   * Recycles byte buffers by size.
+   *
+   * Released buffers are kept in a size class keyed by their byte count so
+   * the next request for the same size gets the memory back without a
+   * malloc, free or page faults.  Each thread keeps a few buffers of its own
+   * so the common acquire/release pair on one thread takes no lock.  The
+   * rest go to a shared list.  All pooled bytes, the per thread ones too,
+   * count against one global cap and buffers that would go past it are
+   * simply freed.
+   *
+   * The pool is disabled by default.  ossimImageDataFactory enables it from
+   * the preferences and ossimImageData uses it for its band buffers.
+   *
+   * @code
+   * std::vector<ossim_uint8> buf;
+   * ossim::BufferPool::instance()->acquire(buf, 65536);
+   * ...
+   * ossim::BufferPool::instance()->release(buf); // buf is now empty
+   * @endcode
+   */
+   class OSSIM_DLL BufferPool
+   {
+   public:
+      typedef std::vector<ossim_uint8> Buffer;
+
+      static BufferPool* instance();
+
+      /**
+      * Swaps a pooled buffer of exactly size bytes into buffer.
+      *
+      * @param buffer Must be empty.  Left untouched on a miss.
+      * @param size Byte count wanted.
+      * @return true if a pooled buffer was handed out.  The contents are
+      * whatever the previous owner left.
+      */
+      bool acquire(Buffer& buffer, ossim_uint32 size);
+
+      /**
+      * Takes the memory of buffer into the pool if enabled and under the
+      * cap.  The buffer is left empty either way when pooled.
+      */
+      void release(Buffer& buffer);
+
+      void setEnabled(bool flag);
+      bool getEnabled()const;
+
+      /** Global cap on the bytes held by the pool. */
+      void setMaxBytes(ossim_uint64 maxBytes);
+      ossim_uint64 getMaxBytes()const;
+
+      /**
+      * Frees every buffer in the shared list and those of the calling
+      * thread.  Another thread's buffers are freed on its next acquire or
+      * release, or when it exits, and count in getPooledBytes() until then.
+      */
+      void flush();
+
+      ossim_uint64 getPooledBytes()const { return m_pooledBytes; }
+      ossim_uint64 getHitCount()const { return m_hitCount; }
+      ossim_uint64 getMissCount()const { return m_missCount; }
+
+      /** @return Number of buffers freed because the pool was full. */
+      ossim_uint64 getDropCount()const { return m_dropCount; }
+
+      std::ostream& print(std::ostream& out)const;
+
+   protected:
+      typedef std::map<ossim_uint32, std::vector<Buffer> > SizeClassMap;
+      friend struct BufferPoolLocalCache;
+
+      BufferPool();
+
+      /**
+      * Moves a thread's buffers to the shared list at thread exit, or frees
+      * them if the pool was flushed since.
+      */
+      void returnToShared(BufferPoolLocalCache& cache);
+
+      /** Frees a thread's buffers and brings it up to the current flush. */
+      void dropLocal(BufferPoolLocalCache& cache);
+
+      static ossim_uint64 countBytes(const SizeClassMap& buffers);
+
+      std::atomic<bool>         m_enabled;
+      std::atomic<ossim_uint64> m_maxBytes;
+      std::atomic<ossim_uint64> m_pooledBytes;
+      std::atomic<ossim_uint64> m_hitCount;
+      std::atomic<ossim_uint64> m_missCount;
+      std::atomic<ossim_uint64> m_dropCount;
+
+      /** Bumped by flush(), see BufferPoolLocalCache. */
+      std::atomic<ossim_uint64> m_generation;
+
+      mutable std::mutex        m_mutex;
+      SizeClassMap              m_sharedBuffers;
+   };
+}
+
+#endif
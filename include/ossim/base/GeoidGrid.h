@@ -0,0 +1,124 @@
+#ifndef ossimGeoidGrid_HEADER
+#define ossimGeoidGrid_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimCommon.h>
+#include <vector>
+
+namespace ossim{
+   /**
+   * @brief Read-only lattice of geoid posts addressed by fractional column
+   * and row.
+   *
+   * Posts are kept row major in 32 bit floats, or in 16 bit integers of a
+   * fixed resolution for half the memory.  The grid is filled once by
+   * create() and setPosts() and never changes afterwards, so any number of
+   * threads may query it without locking.  Null posts carry no weight in an
+   * interpolated value.
+   */
+   class OSSIM_DLL GeoidGrid{
+   public:
+      enum Storage{
+         FLOAT32_STORAGE = 0,
+         SINT16_STORAGE  = 1  // Post = value / resolution, rounded.
+      };
+
+      enum Interpolation{
+         BILINEAR = 0,
+         BICUBIC  = 1  // Falls back to bilinear next to nulls and edges.
+      };
+
+      GeoidGrid();
+
+      /**
+      * @brief Sizes the grid to width x height null posts.  Grids smaller
+      * than 2 x 2 are left empty.
+      * @param resolution Value of one step, SINT16_STORAGE only.
+      */
+      void create(ossim_uint32 width,
+                  ossim_uint32 height,
+                  Storage storage=FLOAT32_STORAGE,
+                  double resolution=0.01);
+
+      void clear();
+
+      /**
+      * @brief Copies rows [row, row + rows) from posts, width values per
+      * row.  Values equal to nullValue, and nans, become null posts.
+      */
+      template <class T>
+      void setPosts(ossim_uint32 row, ossim_uint32 rows,
+                    const T* posts, double nullValue);
+
+      ossim_uint32 getWidth()const{ return m_width; }
+      ossim_uint32 getHeight()const{ return m_height; }
+      bool empty()const{ return m_width == 0; }
+      Storage getStorage()const{ return m_storage; }
+      ossim_uint64 getSizeInBytes()const;
+
+      /** @return Post at column x, row y; ossim::nan() if null. */
+      double getPost(ossim_uint32 x, ossim_uint32 y)const;
+
+      /**
+      * @return Value at column x, row y, or ossim::nan() if the nearest post
+      * is outside the grid or all posts used are null.  Points on the last
+      * column or row use the cell before it.
+      */
+      double interpolate(double x, double y,
+                         Interpolation interpolation=BILINEAR)const;
+
+      /** @brief interpolate() for count points. */
+      void interpolate(const double* x, const double* y, ossim_uint32 count,
+                       double* values,
+                       Interpolation interpolation=BILINEAR)const;
+
+      /**
+      * @return Bilinear value of the cell posts p00, p01 (next column),
+      * p10 (next row) and p11 at offsets xt, yt, with nan posts given no
+      * weight; ossim::nan() if all four are nan.
+      */
+      static double bilinear(double p00, double p01, double p10, double p11,
+                             double xt, double yt);
+
+   protected:
+      static const ossim_sint16 SINT16_NULL;
+
+      void setPost(ossim_uint64 index, double value, double nullValue);
+
+      double bicubic(double x, double y, ossim_int32 x0, ossim_int32 y0)const;
+
+      ossim_uint32               m_width;
+      ossim_uint32               m_height;
+      Storage                    m_storage;
+      double                     m_resolution;
+      std::vector<ossim_float32> m_floatPosts;
+      std::vector<ossim_sint16>  m_shortPosts;
+   };
+}
+
+template <class T>
+void ossim::GeoidGrid::setPosts(ossim_uint32 row, ossim_uint32 rows,
+                                const T* posts, double nullValue)
+{
+   if(!posts || (row >= m_height)) return;
+   if(rows > m_height - row) rows = m_height - row;
+
+   ossim_uint64 index = (ossim_uint64)row * m_width;
+   const ossim_uint64 END = index + (ossim_uint64)rows * m_width;
+   for(; index < END; ++index, ++posts)
+   {
+      setPost(index, (double)*posts, nullValue);
+   }
+}
+
+inline double ossim::GeoidGrid::getPost(ossim_uint32 x, ossim_uint32 y)const
+{
+   ossim_uint64 index = (ossim_uint64)y * m_width + x;
+   if(m_storage == SINT16_STORAGE)
+   {
+      ossim_sint16 post = m_shortPosts[index];
+      return (post == SINT16_NULL) ? ossim::nan() : post * m_resolution;
+   }
+   return m_floatPosts[index];
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef ossimMemoryMap_HEADER
+#define ossimMemoryMap_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <string>
+
+namespace ossim{
+
+   /**
+   * Read only memory mapping of an entire file.
+   *
+   * The pages are backed by the operating system page cache so several
+   * processes mapping the same file share one physical copy of the data.
+   * Opening is constant time since nothing is read until a page is touched,
+   * and once opened the data pointer can be read from any number of threads
+   * without locking.
+   *
+   * @code
+   * #include <ossim/base/MemoryMap.h>
+   * ossim::MemoryMap map;
+   * if(map.open("/data/dted/w112/n33.dt2"))
+   * {
+   *    const ossim_uint8* buf = map.data();
+   *    ossim_uint64 size = map.size();
+   * }
+   * @endcode
+   */
+   class OSSIM_DLL MemoryMap
+   {
+   public:
+      MemoryMap();
+
+      /**
+      * Destructor will unmap the file.
+      */
+      ~MemoryMap();
+
+      /**
+      * Maps the whole file read only.  Any previous mapping is closed first.
+      *
+      * @param file Local file to map.
+      * @return true on success.  Will return false for empty files, non
+      *         local files or platforms without mapping support.
+      */
+      bool open(const std::string& file);
+
+      /**
+      * Unmaps the file.
+      */
+      void close();
+
+      bool isOpen()const;
+      bool empty()const;
+
+      /**
+      * @return Pointer to the first byte of the mapped file or 0 if not open.
+      */
+      const ossim_uint8* data()const;
+
+      /**
+      * @return Size of the mapping in bytes.  This is the virtual memory used.
+      */
+      ossim_uint64 size()const;
+
+      /**
+      * @return Number of bytes of the mapping currently resident in physical
+      *         memory.  Returns 0 if not open or if the platform can not
+      *         query page residency.
+      */
+      ossim_uint64 residentBytes()const;
+
+      /**
+      * @return The file that is mapped.
+      */
+      const std::string& getFilename()const;
+
+   private:
+      MemoryMap(const MemoryMap&);
+      const MemoryMap& operator=(const MemoryMap&);
+
+      const ossim_uint8* m_data;
+      ossim_uint64       m_size;
+      std::string        m_filename;
+#if defined(_WIN32)
+      void*              m_fileHandle;
+      void*              m_mappingHandle;
+#endif
+   };
+}
+
+inline bool ossim::MemoryMap::isOpen()const
+{
+   return (m_data != 0);
+}
+
+inline bool ossim::MemoryMap::empty()const
+{
+   return (m_data == 0);
+}
+
+inline const ossim_uint8* ossim::MemoryMap::data()const
+{
+   return m_data;
+}
+
+inline ossim_uint64 ossim::MemoryMap::size()const
+{
+   return m_size;
+}
+
+inline const std::string& ossim::MemoryMap::getFilename()const
+{
+   return m_filename;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef ossimRectIndex_HEADER
+#define ossimRectIndex_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIrect.h>
+#include <vector>
+
+namespace ossim{
+   /**
+   * @brief Static R-tree over a list of rectangles, packed with the sort tile
+   * recursive (STR) method.
+   *
+   * The tree is built once from all rectangles and answers which of them
+   * intersect a query rectangle in O(log n + k).  Rectangles are identified
+   * by their position in the list given to build(), those with nans are left
+   * out.  There is no insert or remove; build again when the list changes.
+   */
+   class OSSIM_DLL RectIndex{
+   public:
+      RectIndex();
+
+      /** @brief Builds the tree over rects, replacing the previous one. */
+      void build(const std::vector<ossimIrect>& rects);
+
+      void clear();
+
+      /** @return Number of rectangles in the tree, nans excluded. */
+      ossim_uint32 size()const{ return m_size; }
+      bool empty()const{ return m_size == 0; }
+
+      /**
+      * @brief Appends the ids of the rectangles intersecting rect, in
+      * ascending order, to ids.
+      */
+      void query(const ossimIrect& rect, std::vector<ossim_uint32>& ids)const;
+
+      /** @return Number of rectangles intersecting rect. */
+      ossim_uint32 count(const ossimIrect& rect)const;
+
+      /**
+      * @return Union of all rectangles, the first one's orientation.  Nan
+      *         if the tree is empty.
+      */
+      const ossimIrect& getBounds()const{ return m_bounds; }
+
+      /** @brief Most children of a node. */
+      static const ossim_uint32 NODE_SIZE;
+
+   protected:
+      struct Node{
+         ossim_int32  m_minX;
+         ossim_int32  m_minY;
+         ossim_int32  m_maxX;
+         ossim_int32  m_maxY;
+         ossim_uint32 m_first; // First child in the level below, id on level 0.
+         ossim_uint32 m_count; // Children, 0 on level 0.
+      };
+
+      /**
+      * @brief Orders level in tiles of NODE_SIZE nodes, sorted on x into
+      * vertical slices, then on y within each slice.
+      */
+      static void sortTiles(std::vector<Node>& level);
+
+      /** @brief Groups each NODE_SIZE nodes of level into one parent. */
+      static void makeParents(const std::vector<Node>& level, std::vector<Node>& parents);
+
+      /** @brief Calls visit(id) for every rectangle intersecting rect. */
+      template <class Visitor>
+      void visit(const ossimIrect& rect, Visitor& visitor)const;
+
+      /** Level 0 holds one node per rectangle, the last level the root. */
+      std::vector< std::vector<Node> > m_levels;
+      std::vector<ossimIrect>          m_rects;
+      ossim_uint32                     m_size;
+      ossimIrect                       m_bounds;
+   };
+}
+#endif
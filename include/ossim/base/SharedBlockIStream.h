@@ -0,0 +1,69 @@
+#ifndef ossimSharedBlockIStream_HEADER
+#define ossimSharedBlockIStream_HEADER 1
+#include <ossim/base/SharedBlockStreamBuffer.h>
+
+namespace ossim {
+   /**
+   *
+   * @brief Block aligned input stream reading through the process wide
+   * BlockCache.
+   *
+   * Streams opened on the same url share the cached blocks and the
+   * underlying connections, see BlockSource.  Besides the usual istream
+   * reads the blocks themselves can be had without a copy.
+   *
+   * Example:
+   * @code
+   *
+   * std::shared_ptr<ossim::SharedBlockIStream> in =
+   *    std::make_shared<ossim::SharedBlockIStream>(
+   *       ossim::BlockSource::get(url, 65536, stream, opener));
+   *
+   * // Fetch a tile's bytes in parallel, then read them in place:
+   * std::vector<ossim::BlockCache::BlockPtr> blocks;
+   * in->getBlocks(tileOffset, tileSize, blocks);
+   *
+   * @endcode
+   */
+   class SharedBlockIStream : public ossim::istream
+   {
+   public:
+      typedef BlockCache::BlockPtr BlockPtr;
+
+      /**
+      * @param source The shared source of the url to read.
+      */
+      SharedBlockIStream(std::shared_ptr<BlockSource> source):
+      ossim::istream(&m_blockStreamBuffer),
+      m_blockStreamBuffer(source)
+      {
+      }
+
+      virtual ~SharedBlockIStream(){
+      }
+
+      /** @see SharedBlockStreamBuffer::getBlock */
+      BlockPtr getBlock(ossim_int64 pos){
+         return m_blockStreamBuffer.getBlock(pos);
+      }
+
+      /** @see SharedBlockStreamBuffer::getBlocks */
+      void getBlocks(ossim_int64 pos, ossim_int64 size, std::vector<BlockPtr>& blocks){
+         m_blockStreamBuffer.getBlocks(pos, size, blocks);
+      }
+
+      /** @see SharedBlockStreamBuffer::prefetch */
+      void prefetch(ossim_int64 pos, ossim_int64 size){
+         m_blockStreamBuffer.prefetch(pos, size);
+      }
+
+      /**
+      *
+      * The buffer where all the block implementation resides
+      *
+      */
+      SharedBlockStreamBuffer m_blockStreamBuffer;
+   };
+}
+
+#endif
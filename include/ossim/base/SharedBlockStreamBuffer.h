@@ -0,0 +1,194 @@
+#ifndef ossimSharedBlockStreamBuffer_HEADER
+#define ossimSharedBlockStreamBuffer_HEADER 1
+#include <ossim/base/ossimIosFwd.h>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/BlockCache.h>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ossim{
+   /**
+   * @brief Reads fixed size blocks of one url into the BlockCache.
+   *
+   * Every stream opened on the same url and block size shares one source.
+   * The source keeps a few streams on the url open so blocks can be fetched
+   * concurrently.  A run of adjacent missing blocks is fetched with one
+   * seek and back to back reads on the same stream, straight into the
+   * block buffers.  A block already being fetched by another caller is
+   * waited on rather than fetched twice.
+   */
+   class OSSIM_DLL BlockSource : public std::enable_shared_from_this<BlockSource>{
+   public:
+      typedef BlockCache::BlockPtr BlockPtr;
+
+      /** @brief Opens another stream on the url. */
+      typedef std::function<std::shared_ptr<ossim::istream>()> Opener;
+
+      /**
+      * @brief Returns the source for url, creating it if no stream on url
+      * is open.
+      *
+      * Creating a source drops the url's cached blocks, so a file
+      * rewritten while no stream had it open is read afresh.
+      *
+      * @param url The connection string, also the cache key.
+      * @param blockSize Bytes per block.
+      * @param stream An open stream on url, used as the first stream.
+      * @param opener Opens more streams, may be empty.
+      * @param maxStreams Most streams open at once, i.e. most concurrent
+      *                   fetches.
+      */
+      static std::shared_ptr<BlockSource> get(const std::string& url,
+                                              ossim_uint64 blockSize,
+                                              std::shared_ptr<ossim::istream> stream,
+                                              const Opener& opener,
+                                              ossim_uint32 maxStreams=DEFAULT_MAX_STREAMS);
+
+      ~BlockSource();
+
+      /**
+      * @return The block, a null pointer past the end of the stream or on
+      *         error.  The last block may be short.
+      */
+      BlockPtr getBlock(ossim_int64 blockIndex);
+
+      /**
+      * @brief Gets count blocks starting at firstBlock.  The missing runs
+      * are fetched in parallel on the thread pool.
+      *
+      * @param blocks Resized to count, null past the end of the stream.
+      */
+      void getBlocks(ossim_int64 firstBlock,
+                     ossim_int64 count,
+                     std::vector<BlockPtr>& blocks);
+
+      /** @brief Starts fetching the missing blocks in the background. */
+      void prefetch(ossim_int64 firstBlock, ossim_int64 count);
+
+      /** @return Size of the stream in bytes or -1 if unknown. */
+      ossim_int64 getSize();
+
+      const std::string& getUrl()const{ return m_url; }
+      ossim_uint64 getBlockSize()const{ return m_blockSize; }
+
+      static const ossim_uint32 DEFAULT_MAX_STREAMS;
+
+      /** @brief Most blocks read with one seek. */
+      static const ossim_int64 MAX_RUN_BLOCKS;
+
+   protected:
+      BlockSource(const std::string& url,
+                  ossim_uint64 blockSize,
+                  std::shared_ptr<ossim::istream> stream,
+                  const Opener& opener,
+                  ossim_uint32 maxStreams);
+
+      typedef std::shared_future<BlockPtr> PendingBlock;
+
+      /**
+      * @brief Looks the blocks up in the cache and among the pending
+      * fetches.  The blocks neither has are registered as pending and
+      * returned in runs of adjacent indexes.
+      */
+      void claimBlocks(ossim_int64 firstBlock,
+                       ossim_int64 count,
+                       std::vector<BlockPtr>& blocks,
+                       std::vector<PendingBlock>& pending,
+                       std::vector< std::pair<ossim_int64, ossim_int64> >& runs);
+
+      /**
+      * @brief Reads a claimed run into the cache and fulfills its pending
+      * entries.
+      */
+      void fetchRun(ossim_int64 firstBlock, ossim_int64 count);
+
+      /**
+      * @brief Takes an idle stream, opening one if allowed, else waits.
+      * @return A null pointer if no stream can be had.
+      */
+      std::shared_ptr<ossim::istream> acquireStream();
+
+      /** @brief Returns a stream to the idle list, or closes it if it went bad. */
+      void releaseStream(std::shared_ptr<ossim::istream> stream);
+
+      /** @brief Waits for a block another caller is fetching. */
+      static BlockPtr waitFor(PendingBlock& pending);
+
+      std::string  m_url;
+      ossim_uint64 m_blockSize;
+      Opener       m_opener;
+      ossim_uint32 m_maxStreams;
+
+      std::mutex                                   m_mutex;
+      std::condition_variable                      m_streamCondition;
+      std::vector< std::shared_ptr<ossim::istream> > m_idleStreams;
+      ossim_uint32                                 m_openStreams;
+      ossim_int64                                  m_size;
+      std::map<ossim_int64, std::shared_ptr< std::promise<BlockPtr> > > m_promises;
+      std::map<ossim_int64, PendingBlock>          m_pending;
+   };
+
+   /**
+   * @brief Stream buffer reading through a shared BlockSource.
+   *
+   * Unlike BlockStreamBuffer there is no private block buffer: the get area
+   * points straight into the cached block, so a read copies the bytes once,
+   * from the cache to the caller.  Reads spanning several blocks fetch the
+   * missing ones concurrently.
+   */
+   class OSSIM_DLL SharedBlockStreamBuffer : public std::streambuf{
+   public:
+      typedef BlockCache::BlockPtr BlockPtr;
+
+      SharedBlockStreamBuffer(std::shared_ptr<BlockSource> source=std::shared_ptr<BlockSource>());
+      virtual ~SharedBlockStreamBuffer(){}
+
+      /**
+      * @return The block holding the absolute byte position pos or a null
+      *         pointer past the end.  The bytes stay valid for as long as
+      *         the pointer is held.
+      */
+      BlockPtr getBlock(ossim_int64 pos);
+
+      /**
+      * @brief Gets the blocks covering size bytes from the absolute position
+      * pos, fetching the missing ones concurrently.
+      */
+      void getBlocks(ossim_int64 pos, ossim_int64 size, std::vector<BlockPtr>& blocks);
+
+      /** @brief Starts fetching the blocks covering size bytes from pos. */
+      void prefetch(ossim_int64 pos, ossim_int64 size);
+
+      std::shared_ptr<BlockSource> getSource()const{ return m_source; }
+
+   protected:
+      /** @brief Points the get area at the current block, if loaded. */
+      void setgPtrs();
+
+      /** @brief Makes the block holding m_currentPosValue current. */
+      void loadBlock();
+
+      /** @brief Picks up gptr moves made by the base class. */
+      void syncCurrentPosition();
+
+      virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                               std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
+      virtual pos_type seekpos(pos_type pos,
+                               std::ios_base::openmode mode = std::ios_base::in | std::ios_base::out);
+      virtual std::streamsize xsgetn(char_type* s, std::streamsize n);
+      virtual int underflow();
+
+      std::shared_ptr<BlockSource> m_source;
+      BlockPtr                     m_block;
+      ossim_int64                  m_blockStart;
+      ossim_int64                  m_currentPosValue;
+   };
+}
+#endif
@@ -0,0 +1,111 @@
+#ifndef ossimSparseBlockMatrix_HEADER
+#define ossimSparseBlockMatrix_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <map>
+#include <vector>
+
+namespace ossim{
+   /**
+   * @brief Symmetric positive definite matrix of dense blocks, most of them
+   * zero, with a block sparse Cholesky factorization.
+   *
+   * Block rows and columns may differ in size.  Only blocks on or below the
+   * diagonal are stored, row major; diagonal blocks are stored in full.
+   * factor() orders the blocks by minimum degree to limit fill-in and
+   * computes L * L' block by block.  The factor gives solve() and, through
+   * computeInverse(), the blocks of the inverse on the factor's pattern,
+   * which include every nonzero block of the matrix.  solvePcg() solves
+   * without a factorization, with a block Jacobi preconditioner.
+   */
+   class OSSIM_DLL SparseBlockMatrix{
+   public:
+      struct Statistics{
+         Statistics();
+         ossim_uint32 m_blocks;        // Stored blocks, diagonal included.
+         ossim_uint64 m_entries;       // Stored values.
+         ossim_uint32 m_factorBlocks;  // Blocks of L.
+         ossim_uint64 m_factorEntries; // Values of L.
+         ossim_uint32 m_iterations;    // Of the last solvePcg().
+         double       m_residual;      // Relative, of the last solvePcg().
+      };
+
+      SparseBlockMatrix();
+
+      /** @brief Sizes the matrix to blockSizes blocks, all zero. */
+      void create(const std::vector<ossim_uint32>& blockSizes);
+
+      void clear();
+
+      ossim_uint32 getNumberOfBlocks()const{ return (ossim_uint32)m_sizes.size(); }
+      ossim_uint32 getBlockSize(ossim_uint32 i)const{ return m_sizes[i]; }
+
+      /** @return First scalar row of block row i. */
+      ossim_uint32 getOffset(ossim_uint32 i)const{ return m_offsets[i]; }
+
+      /** @return Scalar rows. */
+      ossim_uint32 getRank()const{ return m_rank; }
+
+      /**
+      * @return Block (i, k), i >= k, of getBlockSize(i) x getBlockSize(k)
+      * values, created zero on first use.  Drops the factorization.
+      */
+      double* block(ossim_uint32 i, ossim_uint32 k);
+
+      /** @return Block (i, k), i >= k, or 0 if it is zero. */
+      const double* findBlock(ossim_uint32 i, ossim_uint32 k)const;
+
+      /** @brief y = A * x. */
+      void multiply(const double* x, double* y)const;
+
+      /** @return false if the matrix is not positive definite. */
+      bool factor();
+
+      bool isFactored()const{ return !m_factor.empty() || m_sizes.empty(); }
+
+      /** @brief Solves A * x = b with the factorization. */
+      bool solve(const double* b, double* x)const;
+
+      /**
+      * @brief Solves A * x = b by preconditioned conjugate gradients,
+      * starting from x.
+      * @return true if the relative residual got below tolerance.
+      */
+      bool solvePcg(const double* b, double* x, double tolerance,
+                    ossim_uint32 maxIterations);
+
+      /** @brief Computes the inverse on the factor's pattern. */
+      bool computeInverse();
+
+      /**
+      * @brief Copies block (i, k) of the inverse, in either order, to out,
+      * getBlockSize(i) x getBlockSize(k) row major.
+      * @return false if computeInverse() has not run or the block is off
+      * the factor's pattern.
+      */
+      bool getInverseBlock(ossim_uint32 i, ossim_uint32 k, double* out)const;
+
+      const Statistics& getStatistics()const{ return m_statistics; }
+
+   protected:
+      /** Row to block, rows at or below the column. */
+      typedef std::map<ossim_uint32, std::vector<double> > Column;
+
+      /**
+      * @brief Minimum degree ordering of the block graph.  Sets m_perm,
+      * m_iperm and the factor positions of the rows below each column of
+      * L in structure.
+      */
+      void order(std::vector< std::vector<ossim_uint32> >& structure);
+
+      std::vector<ossim_uint32> m_sizes;
+      std::vector<ossim_uint32> m_offsets;
+      ossim_uint32              m_rank;
+      std::vector<Column>       m_columns;  // By block.
+      std::vector<ossim_uint32> m_perm;     // Factor position to block.
+      std::vector<ossim_uint32> m_iperm;    // Block to factor position.
+      std::vector<Column>       m_factor;   // By factor position.
+      std::vector<Column>       m_inverse;  // Pattern of m_factor.
+      Statistics                m_statistics;
+   };
+}
+#endif
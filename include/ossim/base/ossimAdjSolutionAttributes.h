@@ -70,9 +70,13 @@ protected:
    NEWMAT::ColumnVector theLastCorrections;  // theFullRank X 1
    NEWMAT::ColumnVector theTotalCorrections; // theFullRank X 1
 
-   // A posteriori full covariance matrix
+   // A posteriori full covariance matrix, empty if the sparse solution
+   // was too large to form it
    NEWMAT::UpperTriangularMatrix theFullCovMatrix;
 
+   // A posteriori variances, diagonal of the full covariance matrix
+   NEWMAT::ColumnVector theVariances;        // theFullRank X 1
+
    // Map obj vs. images (measurements)
    ObjImgMap_t theObjImgXref;
 
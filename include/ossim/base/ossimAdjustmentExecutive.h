@@ -15,6 +15,7 @@
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimGpt.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/base/ossimWLSBundleSolution.h>
 #include <ossim/matrix/newmat.h>
 #include <ossim/matrix/newmatap.h>
 #include <ossim/matrix/newmatio.h>
@@ -23,7 +24,6 @@
 #include <vector>
 #include <iostream>
 
-class ossimWLSBundleSolution;
 class ossimAdjSolutionAttributes;
 
 
@@ -107,6 +107,19 @@ public:
 
    void setConvCriteria(const int convCriteria) { theConvCriteria = convCriteria; }
 
+   /**
+    * @brief Set the normal equation solver; sparse Cholesky by default.
+    * Takes effect at the next initializeSolution().
+    */
+   void setSolverType(ossimWLSBundleSolution::SolverType solverType)
+   { theSolverType = solverType; }
+
+   /**
+    * @brief Turn the propagated standard deviations on or off.  Takes
+    * effect at the next initializeSolution().
+    */
+   void setComputeCovariance(bool flag) { theComputeCovariance = flag; }
+
 protected:
    bool theExecValid;
 
@@ -115,6 +128,8 @@ protected:
 
    // Optimizer
    ossimWLSBundleSolution* theSol;
+   ossimWLSBundleSolution::SolverType theSolverType;
+   bool theComputeCovariance;
 
    // Attribute interface
    ossimAdjSolutionAttributes* theSolAttributes;
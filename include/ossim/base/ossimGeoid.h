@@ -36,6 +36,15 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt) = 0;
 
+   /**
+    *  @brief Offsets from the ellipsoid to the geoid for count points, one
+    *  call for a whole batch.  Entries are ossim::nan() where the grid does
+    *  not contain the point.  Default calls offsetFromEllipsoid per point.
+    */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     ossim_uint32 count,
+                                     double* offsets);
+
 protected:
    virtual ~ossimGeoid();
    
@@ -15,8 +15,8 @@
 #ifndef ossimGeoidEgm96_HEADER
 #define ossimGeoidEgm96_HEADER
 
+#include <ossim/base/GeoidGrid.h>
 #include <ossim/base/ossimGeoid.h>
-#include <vector>
 
 #define GEOID_NO_ERROR              0x0000
 #define GEOID_FILE_OPEN_ERROR       0x0001
@@ -48,6 +48,11 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt);
 
+   /** @brief Batch form of offsetFromEllipsoid. */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     ossim_uint32 count,
+                                     double* offsets);
+
    double geoidToEllipsoidHeight(double lat,
                                  double lon,
                                  double geoidHeight);
@@ -57,8 +62,14 @@ public:
                            double ellipsoidHeight);
 protected:
 
-   std::vector<float> theGeoidHeightBuffer;
-   mutable float* theGeoidHeightBufferPtr;
+   /**
+    * @return Offset at gpt already in wgs84, or ossim::nan() if not
+    * initialized or out of range.
+    */
+   double offsetFromWgs84(const ossimGpt& gpt) const;
+
+   /** Posts at 15', row 0 at 90N, column 0 at 0E through 360E. */
+   ossim::GeoidGrid theGrid;
    TYPE_DATA
 };
 
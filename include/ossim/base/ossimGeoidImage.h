@@ -14,12 +14,15 @@
 #ifndef ossimGeoidImage_HEADER
 #define ossimGeoidImage_HEADER 1
    
+#include <ossim/base/GeoidGrid.h>
 #include <ossim/base/ossimGeoid.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <mutex>
 
+class ossimDatum;
 class ossimFilename;
 
 /**
@@ -31,6 +34,13 @@ class ossimFilename;
  * to an elevation source.
  *
  * The keyword "type" is fixed for this object as "geoid_image".
+ *
+ * The grid is decoded once on open into a read-only ossim::GeoidGrid when
+ * "memory_map" is true or the grid fits in "max_grid_bytes" (default 256
+ * MiB).  Optional keywords "grid_storage" (float32 or int16) and
+ * "interpolation" (bilinear or bicubic) select the lattice format and
+ * interpolator.  Grids too large to load are read through the image
+ * handler, one query at a time.  Either way queries are thread safe.
  */
 class OSSIM_DLL ossimGeoidImage : public ossimGeoid
 {
@@ -64,14 +74,29 @@ public:
 
    /**
     * @brief Gets the memory map flag.
-    * @return true if geoid image is memory mapped; else, false.
+    * @return true if the whole grid is to be loaded regardless of its
+    * size; else, false.
     */
    bool getMemoryMapFlag() const;
 
    /**
-    * @brief Set the memory map flag.
+    * @brief Set the memory map flag.  Takes effect on the next open.
     */
    void setMemoryMapFlag( bool flag );
+
+   /** @return true if the grid was decoded into memory by open. */
+   bool isGridLoaded() const;
+
+   /** @brief Sets the lattice format, takes effect on the next open. */
+   void setGridStorage( ossim::GeoidGrid::Storage storage );
+   ossim::GeoidGrid::Storage getGridStorage() const;
+
+   /**
+    * @brief Sets the interpolator.  Bicubic needs the grid loaded; reads
+    * through the image handler are always bilinear.
+    */
+   void setInterpolation( ossim::GeoidGrid::Interpolation interpolation );
+   ossim::GeoidGrid::Interpolation getInterpolation() const;
    
    /**
     * Method to save the state of the object to a keyword list.
@@ -93,24 +118,62 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt);
 
+   /** @brief Batch form of offsetFromEllipsoid. */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     ossim_uint32 count,
+                                     double* offsets);
+
    bool getEnableFlag() const;
 
    void setEnableFlag(bool flag);
 
 protected:
 
+   /** @return true if the object can answer queries. */
+   bool isInitialized() const;
+
+   /**
+    * @brief Decodes the grid from m_handler into m_grid, in strips.
+    * @return true on success.
+    */
+   bool loadGrid();
+
+   /**
+    * @brief Fits m_lonLatToGrid to the projection and sets m_affineFlag if
+    * it reproduces worldToLocal over the whole grid.
+    */
+   void computeAffine();
+
+   /**
+    * @return Grid column, row of gpt relative to the image rectangle, after
+    * shifting gpt to datum (if not null) and wrapping it.
+    */
+   ossimDpt toGridPoint( const ossimGpt& gpt, const ossimDatum* datum ) const;
+
+   /** @brief Bilinear value at grid point pt read through the handler. */
    template <class T>
-   double offsetFromEllipsoidTemplate(T dummy, const ossimGpt& gpt);
+   double offsetFromHandlerTemplate(T dummy, const ossimDpt& pt);
 
    ossimRefPtr<ossimImageGeometry> m_geom;
    ossimRefPtr<ossimImageHandler>  m_handler;
-   ossimRefPtr<ossimImageData>     m_cacheTile;
    std::string                     m_connectionString;
    ossimString                     m_geoidTypeName;
    bool                            m_memoryMapFlag;
    bool                            m_enabledFlag;
    ossimIrect                      m_imageRect;
    ossimScalarType                 m_scalarType;
+
+   ossim::GeoidGrid                m_grid;
+   ossim::GeoidGrid::Storage       m_gridStorage;
+   ossim::GeoidGrid::Interpolation m_interpolation;
+   ossim_uint64                    m_maxGridBytes;
+
+   /** x = [0] + [1]*lon + [2]*lat, y = [3] + [4]*lon + [5]*lat */
+   double                          m_lonLatToGrid[6];
+   bool                            m_affineFlag;
+
+   /** Serializes reads through m_handler. */
+   std::mutex                      m_handlerMutex;
 };
 
 #endif /* #define ossimGeoidImage_HEADER 1 */
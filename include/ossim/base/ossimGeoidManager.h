@@ -48,6 +48,14 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt);
 
+   /**
+    *  @brief Batch form of offsetFromEllipsoid.  Each geoid is asked once
+    *  for all points still without an offset.
+    */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     ossim_uint32 count,
+                                     double* offsets);
+
    /**
     * Method to save the state of the object to a keyword list.
     * Return true if ok or false on error. DO NOTHING
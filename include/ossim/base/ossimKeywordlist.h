@@ -574,6 +574,24 @@ protected:
    KeywordlistParseState readValue(ossimString& sequence, ossim::istream& in)const;
    KeywordlistParseState readKeyAndValuePair(ossimString& key,
                                              ossimString& value, ossim::istream& in)const;
+
+   /**
+    * Single pass parse of a keyword list held in memory, same rules as the
+    * read methods above.  Used by parseStream after a bulk read.
+    * @return true if parsed, false on a malformed list.
+    */
+   bool parseBuffer(const char* pos, const char* end);
+
+   /**
+    * Scans the value starting at pos, as readValue does, leaving pos past
+    * the end of the line or the closing tripple quotes.
+    */
+   KeywordlistParseState scanValue(const char*& pos,
+                                   const char* end,
+                                   std::string& value)const;
+
+   /** Handles a preprocessor line, e.g. "#include <file>". */
+   void processPreprocDirective(const ossimString& sequence);
    
    // Method to see if keyword exists in list.
    KeywordMap::iterator getMapEntry(const std::string& key);
@@ -57,6 +57,13 @@ OSSIMDLLEXPORT void ossimSetNotifyStream(std::ostream* outputStream,
 
 OSSIMDLLEXPORT std::ostream* ossimGetNotifyStream(ossimNotifyLevel whichLevel);
 
+/**
+ * @brief Sends the notify levels that go to std::cout to outputStream instead,
+ * for the calling thread only.  Lets a server collect the output of each
+ * request while several run at once.  Pass 0 to go back to std::cout.
+ */
+OSSIMDLLEXPORT void ossimSetThreadNotifyStream(std::ostream* outputStream);
+
 OSSIMDLLEXPORT bool ossimIsReportingEnabled();
 
 OSSIMDLLEXPORT std::ostream& ossimNotify(ossimNotifyLevel level = ossimNotifyLevel_WARN);
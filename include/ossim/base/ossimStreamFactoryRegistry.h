@@ -42,6 +42,19 @@ namespace ossim
   * ossim.stream.factory.registry.istream.buffer1.size: 65536
   * @endcode
   *
+  * With enableShared the stream is a SharedBlockIStream instead: blocks
+  * of size bytes are kept in the process wide BlockCache and shared by
+  * every stream opened on the same connection string, and up to streams
+  * connections per url fetch missing blocks concurrently.
+  * @code
+  * ossim.stream.factory.registry.istream.buffer2.enabled: true
+  * ossim.stream.factory.registry.istream.buffer2.includePattern: ^s3://
+  * ossim.stream.factory.registry.istream.buffer2.enableShared: true
+  * ossim.stream.factory.registry.istream.buffer2.size: 65536
+  * ossim.stream.factory.registry.istream.buffer2.streams: 4
+  * ossim.stream.factory.registry.block_cache.size: 67108864
+  * @endcode
+  *
   * The includePattern keyword is a regular expression.
   * Examples:
   *   - ^/  Anything that starts with /
@@ -192,12 +205,16 @@ namespace ossim
       public:
         BufferInfo():m_enabled(false),
                      m_enableBlocked(false),
+                     m_enableShared(false),
                      m_pattern(""),
-                     m_size(4096){}
+                     m_size(4096),
+                     m_streams(4){}
         bool                 m_enabled;
         bool                 m_enableBlocked;
+        bool                 m_enableShared;
         ossimString          m_pattern;
         ossim_uint64         m_size;
+        ossim_uint32         m_streams;
 
       };     
       /** @brief copy constructor hidden from use */
@@ -13,6 +13,8 @@
 #include <ossim/matrix/newmat.h>
 #include <ossim/matrix/newmatap.h>
 #include <ossim/matrix/newmatio.h>
+#include <ossim/base/SparseBlockMatrix.h>
+#include <iosfwd>
 #include <vector>
 
 class ossimAdjSolutionAttributes;
@@ -21,6 +23,30 @@ class ossimAdjSolutionAttributes;
 class OSSIM_DLL ossimWLSBundleSolution
 {
 public:
+   /**
+    * DENSE_SOLVER forms and inverts the full normal matrix.  The sparse
+    * solvers eliminate the ground points and solve the reduced camera
+    * system, block sparse, by Cholesky or by preconditioned conjugate
+    * gradients.
+    */
+   enum SolverType
+   {
+      DENSE_SOLVER           = 0,
+      SPARSE_CHOLESKY_SOLVER = 1,
+      SPARSE_PCG_SOLVER      = 2
+   };
+
+   /** Timing and size of the last run(). */
+   struct Statistics
+   {
+      Statistics();
+      int    theReducedRank;    // Image parameters.
+      int    theFullRank;       // Image and ground point parameters.
+      double theFormTime;       // Seconds, normals and Schur complement.
+      double theSolveTime;      // Seconds, factor or PCG and back substitution.
+      double theCovarianceTime; // Seconds.
+      ossim::SparseBlockMatrix::Statistics theMatrixStatistics;
+   };
 
    /**
     * @brief Constructor
@@ -31,6 +57,30 @@ public:
     * @brief Run solution
     */
    bool run(ossimAdjSolutionAttributes* solAttributes);
+
+   void setSolverType(SolverType solverType) { theSolverType = solverType; }
+   SolverType getSolverType() const { return theSolverType; }
+
+   /**
+    * @brief Turn the a posteriori covariance on or off.  Without it the
+    * variances are left zero.
+    */
+   void setComputeCovariance(bool flag) { theComputeCovariance = flag; }
+   bool getComputeCovariance() const { return theComputeCovariance; }
+
+   /**
+    * @brief Largest full rank for which the sparse solvers form the full
+    * covariance matrix.  Above it only the variances are computed.
+    */
+   void setMaxFullCovarianceRank(int rank) { theMaxFullCovRank = rank; }
+   int getMaxFullCovarianceRank() const { return theMaxFullCovRank; }
+
+   const Statistics& getStatistics() const { return theStatistics; }
+
+   /**
+    * @brief Print timing and fill-in of the last run.
+    */
+   std::ostream& printStatistics(std::ostream& out) const;
    
    /**
     * @brief Destructor
@@ -40,6 +90,13 @@ public:
 
 protected:
    bool theSolValid;
+   SolverType theSolverType;
+   bool theComputeCovariance;
+   int theMaxFullCovRank;
+   Statistics theStatistics;
+
+   bool runDense(ossimAdjSolutionAttributes* solAttributes);
+   bool runSparse(ossimAdjSolutionAttributes* solAttributes);
 
    // Internal solution methods
    bool solveSystem(double* d, double* c, double* delta, int jb);
@@ -25,6 +25,7 @@
 
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/base/MemoryMap.h>
 #include <ossim/elevation/ossimElevCellHandler.h>
 #include <ossim/support_data/ossimDtedVol.h>
 #include <ossim/support_data/ossimDtedHdr.h>
@@ -67,6 +68,7 @@ public:
    * Constructor
    */
    ossimDtedHandler()
+      : m_memoryMapData(0)
    {
    }
 
@@ -75,9 +77,9 @@ public:
    *
    * @param dted_file is a file path to the dted cell we wish to
    *        open
-   * @param memoryMapFlag If this is set we will pull the entire cell
-   *        into memory and treat that memory location as an 
-   *        inputstream.
+   * @param memoryMapFlag If this is set the cell is mapped read only into
+   *        memory.  Local files are mapped through the operating system
+   *        so the pages are shared by all processes using the cell.
    */
    ossimDtedHandler(const ossimFilename& dted_file, bool memoryMapFlag=false);
 
@@ -94,9 +96,9 @@ public:
    *
    * @param file is a file path to the dted cell we wish to
    *        open
-   * @param memoryMapFlag If this is set we will pull the entire cell
-   *        into memory and treat that memory location as an 
-   *        inputstream.
+   * @param memoryMapFlag If this is set the cell is mapped read only into
+   *        memory.  Local files are mapped through the operating system
+   *        so the pages are shared by all processes using the cell.
    */
    virtual bool open(const ossimFilename& file, bool memoryMapFlag=false);
 
@@ -107,9 +109,9 @@ public:
    *        to a cell.
    * @param connectionString is the connection string used to open the
    *        input stream.
-   * @param memoryMapFlag If this is set we will pull the entire cell
-   *        into memory and treat that memory location as an 
-   *        inputstream.
+   * @param memoryMapFlag If this is set the cell is mapped read only into
+   *        memory.  If the connection string is not a local file the
+   *        stream is read into memory instead.
    */
    virtual bool open(std::shared_ptr<ossim::istream>& fileStr, const std::string& connectionString, bool memoryMapFlag=false);
    virtual void close();
@@ -121,6 +123,15 @@ public:
     */
    virtual double getHeightAboveMSL(const ossimGpt& gpt);
 
+   /**
+    * @brief Batch form of getHeightAboveMSL.  The memory map or stream
+    * choice is made once and the posts interpolated in one loop.
+    */
+   virtual ossim_uint32 getHeightsAboveMSL(const ossimGpt* gpts,
+                                           ossim_uint32 count,
+                                           ossim_float64* heights,
+                                           bool* valid=0);
+
    /*!
     *  METHOD:  getSizeOfElevCell
     *  Returns the number of post in the cell.  Satisfies pure virtual.
@@ -142,6 +153,9 @@ public:
    virtual bool isOpen()const;
    
    virtual bool getAccuracyInfo(ossimElevationAccuracyInfo& info, const ossimGpt& gpt) const;
+
+   virtual bool getMemoryMapUsage(ossim_uint64& residentBytes,
+                                  ossim_uint64& virtualBytes) const;
    
    const ossimDtedVol& vol()const
    {
@@ -166,7 +180,7 @@ public:
 
    virtual ossimObject* dup () const
    {
-      return new ossimDtedHandler(this->getFilename(), (m_memoryMap.size() != 0));
+      return new ossimDtedHandler(this->getFilename(), (m_memoryMapData != 0));
    }
 
    virtual ~ossimDtedHandler();
@@ -252,8 +266,14 @@ protected:
    // Indicates whether byte swapping is needed.
    bool m_swapBytesFlag;
 
-   mutable std::mutex m_memoryMapMutex;
-   mutable std::vector<ossim_uint8> m_memoryMap;
+   // Read only mapping of a local cell file.
+   ossim::MemoryMap m_mappedFile;
+
+   // Copy of the cell when memory mapping a stream that is not a local file.
+   std::vector<ossim_uint8> m_memoryMap;
+
+   // Points to m_mappedFile or m_memoryMap data when memory mapped, else 0.
+   const ossim_uint8* m_memoryMapData;
    
    std::shared_ptr<ossimDtedVol> m_vol;
    std::shared_ptr<ossimDtedHdr> m_hdr;
@@ -284,7 +304,7 @@ inline ossim_sint16 ossimDtedHandler::convertSignedMagnitude(ossim_uint16& s) co
 inline bool ossimDtedHandler::isOpen()const
 {
 
-  if(!m_memoryMap.empty()) return true;
+  if(m_memoryMapData) return true;
   std::lock_guard<std::mutex> lock(m_fileStrMutex);
 
   return (m_fileStr != 0);
@@ -293,6 +313,8 @@ inline bool ossimDtedHandler::isOpen()const
 inline void ossimDtedHandler::close()
 {
    m_fileStr.reset();
+   m_memoryMapData = 0;
+   m_mappedFile.close();
    m_memoryMap.clear();
 }
 
@@ -82,6 +82,17 @@ public:
                             const ossimConnectableObject* object)const;
    virtual void close(){}
    virtual bool open(const ossimFilename&, bool=false){return false;}
+
+   /**
+    * @brief Gets the memory used by a memory mapped cell.
+    * @param residentBytes Initialized with the number of bytes of the cell
+    * currently resident in physical memory.
+    * @param virtualBytes Initialized with the number of bytes mapped.
+    * @return true if the cell is memory mapped, false if not.  Default
+    * implementation returns false and zeroes both values.
+    */
+   virtual bool getMemoryMapUsage(ossim_uint64& residentBytes,
+                                  ossim_uint64& virtualBytes) const;
       
    virtual std::ostream& print(std::ostream& out) const;
 
@@ -56,6 +56,28 @@ public:
    
    virtual double getHeightAboveEllipsoid(const ossimGpt& gpt);
    virtual double getHeightAboveMSL(const ossimGpt& gpt);
+
+   /**
+    * @brief Batch height lookups.
+    *
+    * Same results as calling the single point methods for each point but the
+    * database list is taken once for the whole batch, and each database only
+    * sees the points still without a height, as one batch.
+    *
+    * @param gpts Array of count ground points.
+    * @param count Number of points.
+    * @param heights Array of count heights initialized by this.
+    * @param valid Optional array of count validity flags.  Can be 0.
+    * @return Number of valid heights.
+    */
+   virtual ossim_uint32 getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                 ossim_uint32 count,
+                                                 ossim_float64* heights,
+                                                 bool* valid=0);
+   virtual ossim_uint32 getHeightsAboveMSL(const ossimGpt* gpts,
+                                           ossim_uint32 count,
+                                           ossim_float64* heights,
+                                           bool* valid=0);
    virtual bool pointHasCoverage(const ossimGpt&) const;
 
    /**
@@ -172,6 +194,16 @@ protected:
    void loadStandardElevationPaths();
 
    ElevationDatabaseListType& getNextElevDbList() const; // for multithreading
+
+   /**
+    * @brief Runs the batch through each database in order, each database
+    * getting the points that are still NaN.
+    * @param ellipsoidFlag true for heights above ellipsoid, false for MSL.
+    */
+   void getDatabaseHeights(const ossimGpt* gpts,
+                           ossim_uint32 count,
+                           ossim_float64* heights,
+                           bool ellipsoidFlag);
    
    //static ossimElevManager* m_instance;
    mutable std::vector<ElevationDatabaseListType> m_dbRoundRobin;
@@ -38,6 +38,30 @@ public:
    virtual double getHeightAboveMSL(const ossimGpt&) = 0;
    virtual double getHeightAboveEllipsoid(const ossimGpt&);
 
+   /**
+    * @brief Batch height access methods.
+    *
+    * Looks up heights for count points in one call.  Derived classes
+    * override to amortize locking, cell lookup and geoid work over the whole
+    * batch.  Default implementation loops over the single point methods.
+    *
+    * @param gpts Array of count ground points.
+    * @param count Number of points.
+    * @param heights Array of count heights initialized by this.  Points
+    * without a height are set to NaN.
+    * @param valid Optional array of count flags initialized by this, true
+    * if heights[i] is not NaN.  Can be 0.
+    * @return Number of valid heights.
+    */
+   virtual ossim_uint32 getHeightsAboveMSL(const ossimGpt* gpts,
+                                           ossim_uint32 count,
+                                           ossim_float64* heights,
+                                           bool* valid=0);
+   virtual ossim_uint32 getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                 ossim_uint32 count,
+                                                 ossim_float64* heights,
+                                                 bool* valid=0);
+
    // Forces all concrete subtypes to implement:
    virtual ossimObject* dup() const = 0;
 
@@ -60,6 +84,24 @@ public:
     *  Returns true if good intersection found.
     */
    bool intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, double defaultElevValue = 0.0);
+
+   /**
+    * @brief Batch version of intersectRay.
+    *
+    * Iterates all rays in lock step so each iteration does a single
+    * getHeightsAboveEllipsoid call for every ray not yet converged.
+    *
+    * @param rays Array of count rays.
+    * @param count Number of rays.
+    * @param gpts Array of count ground points.  Like intersectRay these are
+    * expected to be initialized with the desired datum.
+    * @param defaultElevValue Height used where there is no elevation.
+    * @return Number of rays that intersected.
+    */
+   ossim_uint32 intersectRays(const ossimEcefRay* rays,
+                              ossim_uint32 count,
+                              ossimGpt* gpts,
+                              double defaultElevValue = 0.0);
    
    /**
     * Access methods for the bounding elevations:
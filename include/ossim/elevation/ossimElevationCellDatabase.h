@@ -123,6 +123,22 @@ public:
    }
    virtual ossimRefPtr<ossimElevCellHandler> getOrCreateCellHandler(const ossimGpt& gpt);
 
+   /**
+    * @brief Batch height lookups.
+    *
+    * Points are grouped by cell id so each cell handler is resolved once per
+    * group and the group's posts are interpolated in one loop.  Geoid
+    * offsets for getHeightsAboveEllipsoid are applied in bulk.
+    */
+   virtual ossim_uint32 getHeightsAboveMSL(const ossimGpt* gpts,
+                                           ossim_uint32 count,
+                                           ossim_float64* heights,
+                                           bool* valid=0);
+   virtual ossim_uint32 getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                 ossim_uint32 count,
+                                                 ossim_float64* heights,
+                                                 bool* valid=0);
+
    virtual std::ostream& print(std::ostream& out) const;
 
 protected:
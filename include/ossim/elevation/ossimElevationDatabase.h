@@ -79,6 +79,14 @@ protected:
    }
    virtual double getOffsetFromEllipsoid(const ossimGpt& gpt);
 
+   /**
+    * @brief Batch version of getOffsetFromEllipsoid.  Geoid is resolved once
+    * for the batch.  Offsets that can not be computed are set to 0.
+    */
+   virtual void getOffsetsFromEllipsoid(const ossimGpt* gpts,
+                                        ossim_uint32 count,
+                                        ossim_float64* offsets);
+
    ossimString m_connectionString;
    ossimRefPtr<ossimGeoid>    m_geoid;
    ossim_float64              m_meanSpacing;
@@ -17,6 +17,7 @@
 
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimDatum.h>
+#include <ossim/base/MemoryMap.h>
 #include <ossim/elevation/ossimElevCellHandler.h>
 #include <ossim/imaging/ossimGeneralRasterInfo.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
@@ -115,6 +116,10 @@ public:
    /**
     * Opens a stream to the srtm cell.
     *
+    * @param file The raster cell.
+    * @param memoryMapFlag If true the cell is mapped read only into memory
+    * and lookups do not lock.  Falls back to the stream if the map fails.
+    *
     * @return Returns true on success, false on error.
     */
    bool open(const ossimFilename& file, bool memoryMapFlag=false);
@@ -124,6 +129,9 @@ public:
     */
    virtual void close();
 
+   virtual bool getMemoryMapUsage(ossim_uint64& residentBytes,
+                                  ossim_uint64& virtualBytes) const;
+
    /**
     * This method does not really fit the handler since this handle a
     * directory not a cell that could have holes in it.  So users looking for
@@ -162,7 +170,7 @@ private:
    /** @brief true if stream is open. */
    bool          m_streamOpen;
    
-   std::vector<char> m_memoryMap;
+   ossim::MemoryMap m_memoryMap;
 TYPE_DATA
 };
 
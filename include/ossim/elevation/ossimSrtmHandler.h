@@ -17,6 +17,7 @@
 //#include <fstream>
 
 #include <ossim/base/ossimString.h>
+#include <ossim/base/MemoryMap.h>
 #include <ossim/elevation/ossimElevCellHandler.h>
 #include <ossim/support_data/ossimSrtmSupportData.h>
 #include <mutex>
@@ -65,6 +66,10 @@ public:
    /**
     * Opens a stream to the srtm cell.
     *
+    * @param file The srtm cell.
+    * @param memoryMapFlag If true the cell is mapped read only into memory
+    * and lookups do not lock.  Falls back to the stream if the map fails.
+    *
     * @return Returns true on success, false on error.
     */
    virtual bool open(const ossimFilename& file, bool memoryMapFlag=false);
@@ -73,11 +78,14 @@ public:
     * Closes the stream to the file.
     */
    virtual void close();
+
+   virtual bool getMemoryMapUsage(ossim_uint64& residentBytes,
+                                  ossim_uint64& virtualBytes) const;
    
    virtual ossimObject* dup() const
    {
       ossimSrtmHandler* obj = new ossimSrtmHandler();
-      obj->open(theFilename, (m_memoryMap.size() != 0));
+      obj->open(theFilename, m_memoryMap.isOpen());
       return obj;
    }
 
@@ -100,7 +108,7 @@ protected:
    ossimEndian*     m_swapper;
    ossimScalarType  m_scalarType;
    
-   mutable std::vector<ossim_int8> m_memoryMap;
+   ossim::MemoryMap m_memoryMap;
    
    template <class T>
    double getHeightAboveMSLFileTemplate(T dummy, const ossimGpt& gpt);
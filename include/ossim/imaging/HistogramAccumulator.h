@@ -0,0 +1,91 @@
+#ifndef ossimHistogramAccumulator_HEADER
+#define ossimHistogramAccumulator_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ossimImageData;
+class ossimMultiBandHistogram;
+
+namespace ossim
+{
+   /**
+   * Integer histogram counting for 8 and 16 bit tiles.
+   *
+   * Pixels are counted by raw value into one integer bin per possible value
+   * and band, so the inner loop is a single increment with no float math.
+   * The bins of the ossimHistogram are only looked up once per distinct
+   * value, when the counts are added to it.  The result is the same as
+   * ossimImageData::populateHistogram: null pixels are skipped, everything
+   * else goes through ossimHistogram::GetIndex.
+   *
+   * accumulate() may be called from several threads at once.  Each caller
+   * takes a private set of bins for the duration of the call, the sets are
+   * summed in addTo().
+   *
+   * @code
+   * ossim::HistogramAccumulator counts;
+   * if(counts.initialize(OSSIM_UINT16, bands))
+   * {
+   *    // On any thread:
+   *    counts.accumulate(tile);
+   *    ...
+   *    counts.addTo(histogram);
+   * }
+   * @endcode
+   */
+   class OSSIM_DLL HistogramAccumulator
+   {
+   public:
+      HistogramAccumulator();
+
+      /** @return true if scalar has integer bins: 8 bit, 11 to 16 bit. */
+      static bool isSupported(ossimScalarType scalar);
+
+      /**
+      * Sets up counting for bands of scalar and drops any counts.
+      * @return false if scalar is not supported.
+      */
+      bool initialize(ossimScalarType scalar, ossim_uint32 bands);
+
+      bool isInitialized()const { return m_valueCount != 0; }
+
+      /**
+      * Counts the non-null pixels of tile.  Empty and null tiles and tiles of
+      * another scalar type or band count are ignored.  Thread safe.
+      */
+      void accumulate(const ossimImageData* tile);
+
+      /**
+      * Adds the counts to the bands of histo.  Call once the accumulate
+      * calls are done.
+      */
+      void addTo(ossimMultiBandHistogram* histo)const;
+
+      /** Zeroes the counts, keeps the bins for reuse. */
+      void clear();
+
+   protected:
+      typedef std::vector<ossim_uint64> Bins;
+
+      /** Takes a free set of bins, allocating one if none is left. */
+      Bins* acquireBins();
+      void  releaseBins(Bins* bins);
+
+      ossimScalarType m_scalar;
+      ossim_uint32    m_bands;
+
+      /** Bins per band: 256 or 65536. */
+      ossim_uint32    m_valueCount;
+
+      /** Subtracted from a raw value to get its bin, sint8 and sint16 only. */
+      ossim_int32     m_valueOffset;
+
+      mutable std::mutex                  m_mutex;
+      std::vector< std::unique_ptr<Bins> > m_bins;
+      std::vector<Bins*>                   m_freeBins;
+   };
+}
+
+#endif
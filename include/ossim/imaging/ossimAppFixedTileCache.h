@@ -14,13 +14,15 @@
 #define ossimAppFixedTileCache_HEADER
 #include <map>
 #include <list>
+#include <vector>
 #include <iostream>
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/imaging/ossimFixedTileCache.h>
+#include <atomic>
 #include <mutex>
 
-class ossimFixedTileCache;
 class ossimImageData;
 
 class OSSIM_DLL ossimAppFixedTileCache
@@ -64,7 +66,11 @@ public:
    void deleteTile(ossimAppFixedCacheId cacheId,
                    const ossimIpt& origin);
    
-   const ossimIpt& getTileSize(ossimAppFixedCacheId cacheId);
+   /**
+    * Returns a copy, the cache may be deleted by another thread once the
+    * call returns.
+    */
+   ossimIpt getTileSize(ossimAppFixedCacheId cacheId);
    
    virtual void setMaxCacheSize(ossim_uint32 cacheSize);
    
@@ -89,7 +95,25 @@ protected:
    
    ossimAppFixedTileCache();
    
-   ossimFixedTileCache* getCache(ossimAppFixedCacheId cacheId);
+   /**
+    * Caches are spread over shards by id so lookups from different caches
+    * do not serialize on one lock.  The lock is only held for the map
+    * lookup; the returned reference keeps the cache alive after that.
+    */
+   static const ossim_uint32 SHARD_COUNT = 16;
+   typedef std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> > CacheMap;
+   struct CacheShard
+   {
+      std::mutex m_mutex;
+      CacheMap   m_cacheMap;
+   };
+
+   ossimRefPtr<ossimFixedTileCache> getCache(ossimAppFixedCacheId cacheId);
+   CacheShard& getShard(ossimAppFixedCacheId cacheId);
+   ossimAppFixedCacheId addCache(ossimFixedTileCache* cache);
+
+   /** @return A reference to every cache at the time of the call. */
+   void getCaches(std::vector<ossimRefPtr<ossimFixedTileCache> >& caches);
 
    void shrinkGlobalCacheSize(ossim_int32 byteCount);
    void shrinkCacheSize(ossimAppFixedCacheId id,
@@ -103,15 +127,18 @@ protected:
    /*!
     * Will hold the current unique Application id.
     */
-   static ossimAppFixedCacheId    theUniqueAppIdCounter;
+   static std::atomic<ossimAppFixedCacheId> theUniqueAppIdCounter;
    ossimIpt                       theTileSize;
-   ossim_uint32                   theMaxCacheSize;
-   ossim_uint32                   theMaxGlobalCacheSize;
-   ossim_uint32                   theCurrentCacheSize;
+   std::atomic<ossim_uint32>      theMaxCacheSize;
+   std::atomic<ossim_uint32>      theMaxGlobalCacheSize;
+
+   /** Bytes held by all caches.  Kept current by the caches themselves. */
+   std::atomic<ossim_int64>       theCurrentCacheSize;
 
-   std::map<ossimAppFixedCacheId, ossimFixedTileCache*> theAppCacheMap;
+   CacheShard                     theShards[SHARD_COUNT];
 
-   std::mutex theMutex;
+   /** Only one thread shrinks at a time; others skip while it runs. */
+   std::mutex theShrinkMutex;
 };
 
 #endif
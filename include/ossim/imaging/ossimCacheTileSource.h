@@ -57,8 +57,29 @@ public:
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
-   
 
+   /**
+    * @brief Gets the cache aligned tiles covering rect that prefetchTile can
+    * fill from another thread.
+    *
+    * Only works when the input is an image handler that can read resLevel
+    * concurrently, see ossimImageHandler::isConcurrentReadSafe.
+    *
+    * @param rect Requested rectangle at resLevel.
+    * @param resLevel Reduced resolution level.
+    * @param tileRects Initialized by this.
+    * @return true if rect can be prefetched.
+    */
+   bool getPrefetchTileRects(const ossimIrect& rect,
+                             ossim_uint32 resLevel,
+                             std::vector<ossimIrect>& tileRects);
+
+   /**
+    * @brief Reads one tile returned by getPrefetchTileRects from the input
+    * handler into the cache unless it is already there.  Thread safe.
+    * @return true if the tile is in the cache on return.
+    */
+   bool prefetchTile(const ossimIrect& tileRect, ossim_uint32 resLevel);
    
 protected:
    void allocate();
@@ -83,7 +104,11 @@ protected:
    RLevelCacheList             theRLevelCacheList;
    ossimIpt                    theTileSizeXY;
    
-   /** For lock and unlock. */
+   /**
+    * Guards theRLevelCacheList, which prefetchTile reads on other threads.
+    * Recursive since getCacheId initializes the list.
+    */
+   std::recursive_mutex        theCacheIdMutex;
 
 TYPE_DATA
 };
@@ -15,6 +15,7 @@
 #include <ossim/imaging/ossimCastTileSourceFilter.h>
 #include <ossim/base/ossimEquTokenizer.h>
 #include <stack>
+#include <vector>
 
 //class ossimCastTileSourceFilter;
 
@@ -167,6 +168,12 @@
  * "acosd(band(in[0],2))/90"
  *
  * </pre>
+ *
+ * The equation is compiled once into a postfix program with its constant
+ * sub-expressions folded.  Each tile is then evaluated a band and a strip
+ * of pixels at a time, without intermediate tiles.  Equations using conv,
+ * blurr, shift or assign_band, and tiles whose inputs differ in band count,
+ * are interpreted as before.
  */
 class OSSIMDLLEXPORT ossimEquationCombiner : public ossimImageCombiner
 {
@@ -187,6 +194,14 @@ public:
       {
          return theEquation;
       }
+
+   /**
+    * @brief Enables evaluating the compiled equation, default true.  When
+    * false every tile is interpreted, i.e. the equation is parsed again
+    * for each tile.
+    */
+   virtual void setCompileFlag(bool flag);
+   bool getCompileFlag()const;
    
    virtual double getNullPixelValue(ossim_uint32 band=0)const;
    virtual double getMinPixelValue(ossim_uint32 band=0)const;
@@ -246,6 +261,34 @@ protected:
       ossimEquDataType d;
    };
 
+   enum ossimEquInstructionType
+   {
+      OSSIM_EQU_INSTRUCTION_CONSTANT        = 0, // The whole equation is value.
+      OSSIM_EQU_INSTRUCTION_INPUT           = 1, // Pushes an input.
+      OSSIM_EQU_INSTRUCTION_INPUT_BAND      = 2, // Pushes band of an input.
+      OSSIM_EQU_INSTRUCTION_UNARY           = 3, // op(image)
+      OSSIM_EQU_INSTRUCTION_BINARY          = 4, // image op image
+      OSSIM_EQU_INSTRUCTION_BINARY_CONSTANT = 5, // image op value
+      OSSIM_EQU_INSTRUCTION_CONSTANT_BINARY = 6, // value op image
+      OSSIM_EQU_INSTRUCTION_CLAMP           = 7  // clamp(image, value, value2)
+   };
+
+   /**
+    * One step of the compiled equation.  Steps pop their image operands
+    * off the evaluation stack and push their result.
+    */
+   struct ossimEquInstruction
+   {
+      int          type;   // ossimEquInstructionType
+      int          op;     // OSSIM_EQU_TOKEN_* of the operator or function.
+      double       value;
+      double       value2;
+      ossim_uint32 index;  // Index into theProgramInputs.
+      ossim_uint32 band;
+   };
+
+   class ossimEquCompiler;
+
    virtual ~ossimEquationCombiner();
    
    
@@ -259,6 +302,14 @@ protected:
    mutable int                theCurrentId;
    mutable std::stack<ossimEquValue> theValueStack;
    ossim_uint32                     theCurrentResLevel;
+
+   bool                             theCompileFlag;
+   ossimString                      theCompiledEquation;
+   std::vector<ossimEquInstruction> theProgram;
+   std::vector<ossim_uint32>        theProgramInputs; // Input indexes.
+   ossim_uint32                     theProgramDepth;
+   std::vector< ossimRefPtr<ossimImageData> > theInputTiles;
+   std::vector<double>              theStripBuffer;
    virtual void assignValue();
    virtual void clearStacks();
    virtual void clearArgList(vector<ossimEquValue>& argList);
@@ -271,6 +322,18 @@ protected:
                              bool popValueStack = true);
    
    virtual ossimRefPtr<ossimImageData> parseEquation();
+
+   /**
+    * Compiles theEquation into theProgram.  Leaves theProgram empty if the
+    * equation can only be interpreted.
+    */
+   virtual bool compileEquation();
+
+   /**
+    * Evaluates theProgram into theTile with the null pixel handling of the
+    * interpreter.  Returns false if this tile has to be interpreted.
+    */
+   virtual bool evaluateProgram();
   
    virtual bool parseAssignBand();
    virtual bool parseExpression();
@@ -98,6 +98,29 @@ public:
   {
     return theScaleFactor;
   }
+
+  /**
+   * Scale only transforms take the separable two pass path unless this is
+   * turned off, which forces the general kernel loop.  The two sum in a
+   * different order: integer outputs can differ by one count where the
+   * truncation falls the other way, float outputs in the last bits.  The
+   * switch is there to compare them.  Default is on.
+   */
+  void setSeparableFlag(bool flag);
+  bool getSeparableFlag()const
+  {
+    return theSeparableFlag;
+  }
+
+  /**
+   * Bumped when the filters, the blur factor or the separable flag change, so copies of this
+   * resampler can tell they are out of date without comparing states.  The
+   * scale and input rect are left out, callers set those per resample.
+   */
+  ossim_uint32 getChangeCount()const
+  {
+    return theChangeCount;
+  }
   /*!
    * Saves the state of this object.
    */
@@ -128,6 +151,28 @@ private:
 			    const ossimDpt& deltaUr,
 			    const ossimDpt& outLength);
   
+  /**
+   * Two pass (x then y) kernel resample used when the output rows and
+   * columns map to input rows and columns, i.e. the transform is scale and
+   * translate only.  Matches the general kernel loop up to summing order,
+   * which can move an integer output by one count after truncation and a
+   * float output in the last bits.
+   *
+   * @return false without touching the output if the transform is not axis
+   * aligned or the kernel footprint leaves the input tile, in which case
+   * the caller must use the general path.
+   */
+  template <class T>
+  bool resampleSeparableTile(T dummy,
+                             const ossimRefPtr<ossimImageData>& input,
+                             ossimRefPtr<ossimImageData>& output,
+                             const ossimIrect& outputSubRect,
+                             const ossimDpt& inputUl,
+                             const ossimDpt& inputUr,
+                             const ossimDpt& deltaUl,
+                             const ossimDpt& deltaUr,
+                             const ossimDpt& outLength);
+
    void computeTable();
    ossimString getFilterTypeAsString(ossimFilterResamplerType type)const;
    ossimFilterResamplerType getFilterType(const ossimString& type)const;
@@ -146,6 +191,8 @@ private:
    
    ossimIrect               theInputRect;
    ossim_float64            theBlurFactor;
+   ossim_uint32             theChangeCount;
+   bool                     theSeparableFlag;
 };
 
 #endif
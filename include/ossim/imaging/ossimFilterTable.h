@@ -56,6 +56,20 @@ public:
     */
    const double* getClosestWeights(const double& x, const double& y)const;
 
+   /**
+    * Inlined below.
+    *
+    * The table is the outer product of one weight row per axis.  These
+    * return that row so separable resamplers can apply x and y in two
+    * passes.
+    *
+    * @return const double* to getWidth() x weights closest to x.
+    */
+   const double* getClosestXWeights(const double& x)const;
+
+   /** @return const double* to getHeight() y weights closest to y. */
+   const double* getClosestYWeights(const double& y)const;
+
 protected:
 
    /**
@@ -65,6 +79,8 @@ protected:
    void allocateWeights();
 
    double*      theWeights;
+   double*      theXWeights;
+   double*      theYWeights;
    ossim_uint32 theWidth;
    ossim_uint32 theHeight;
    ossim_uint32 theWidthHeight;
@@ -94,4 +110,20 @@ inline const double* ossimFilterTable::getClosestWeights(const double& x,
                       kernelSamp)*theWidthHeight];
 }
 
+inline const double* ossimFilterTable::getClosestXWeights(const double& x)const
+{
+   double intPartDummy;
+   ossim_int32 kernelSamp =
+      (ossim_int32)(theFilterSteps*fabs(modf(x, &intPartDummy)));
+   return &theXWeights[kernelSamp*theWidth];
+}
+
+inline const double* ossimFilterTable::getClosestYWeights(const double& y)const
+{
+   double intPartDummy;
+   ossim_int32 kernelLine =
+      (ossim_int32)(theFilterSteps*fabs(modf(y, &intPartDummy)));
+   return &theYWeights[kernelLine*theHeight];
+}
+
 #endif /* End of "#ifndef ossimFilterTable_HEADER" */
@@ -2,23 +2,25 @@
 // Copyright (C) 2000 ImageLinks Inc.
 //
 // License:  MIT
-// 
+//
 // See LICENSE.txt file in the top level directory for more details.
 //
 // Author: Garrett Potts
-// 
+//
 // Description: This file contains the Application cache algorithm
 //
 //***********************************
 // $Id: ossimFixedTileCache.h 16276 2010-01-06 01:54:47Z gpotts $
 #ifndef ossimFixedTileCache_HEADER
 #define ossimFixedTileCache_HEADER
-#include <map>
-#include <list>
+#include <unordered_map>
+#include <vector>
+#include <iosfwd>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimReferenced.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <atomic>
 #include <mutex>
 
 class  ossimFixedTileCacheInfo
@@ -27,10 +29,12 @@ public:
    ossimFixedTileCacheInfo(ossimRefPtr<ossimImageData>& tile,
                            ossim_int32 tileId=-1)
       :theTile(tile),
-      theTileId(tileId)
+      theTileId(tileId),
+      theReferencedFlag(false),
+      theClockIndex(0)
       {
       }
-   
+
    bool operator <(const ossimFixedTileCacheInfo& rhs)const
       {
          return (theTileId < rhs.theTileId);
@@ -55,11 +59,26 @@ public:
       {
          return (theTileId == tileId);
       }
-   
+
    ossimRefPtr<ossimImageData> theTile;
    ossim_int32 theTileId;
+
+   /** Second chance bit for CLOCK eviction.  Set on every hit. */
+   bool         theReferencedFlag;
+
+   /** Slot of this tile in the owning shard's clock ring. */
+   ossim_uint32 theClockIndex;
 };
 
+/**
+ * Fixed grid tile cache.
+ *
+ * Tiles are spread over SHARD_COUNT shards by tile id, each with its own
+ * lock and hash map, so threads working on different tiles rarely wait on
+ * each other.  Eviction is CLOCK (second chance) per shard: a hit only sets
+ * a flag on the tile and the clock hand gives referenced tiles one more pass
+ * before they are dropped.
+ */
 class ossimFixedTileCache : public ossimReferenced
 {
 public:
@@ -100,7 +119,7 @@ public:
       }
    virtual ossim_uint32 getNumberOfTiles()const
       {
-         return (ossim_uint32)theTileMap.size();
+         return theNumberOfTiles;
       }
    virtual const ossimIpt& getTileSize()const
       {
@@ -108,11 +127,16 @@ public:
       }
    virtual ossim_uint32 getCacheSize()const
       {
-         return theCacheSize;
+         return static_cast<ossim_uint32>(theCacheSize);
       }
+
+   /**
+    * Evicts one tile picked by the clock hand.  Does nothing if the lru
+    * flag is off.
+    */
    virtual void deleteTile();
    virtual ossimRefPtr<ossimImageData> removeTile();
-   
+
    virtual void setMaxCacheSize(ossim_uint32 cacheSize)
       {
          theMaxCacheSize = cacheSize;
@@ -122,25 +146,79 @@ public:
       {
          return theMaxCacheSize;
       }
-   
+
    virtual ossimIpt getTileOrigin(ossim_int32 tileId);
    virtual ossim_int32 computeId(const ossimIpt& tileOrigin)const;
    virtual void setTileSize(const ossimIpt& tileSize);
+
+   /**
+    * Byte counter shared by a group of caches.  Every byte added to or
+    * removed from this cache is also applied to the counter.  Used by
+    * ossimAppFixedTileCache to track its global size without locking.
+    */
+   void setSharedCacheSizeCounter(std::atomic<ossim_int64>* counter);
+
+   ossim_uint64 getHitCount()const { return theHitCount; }
+   ossim_uint64 getMissCount()const { return theMissCount; }
+   ossim_uint64 getEvictionCount()const { return theEvictionCount; }
+
+   /** @return Number of times a shard lock was found held by another thread. */
+   ossim_uint64 getContentionCount()const { return theContentionCount; }
+
+   /**
+    * Prints size, tile count and the hit/miss/eviction/contention counters
+    * on one line.
+    */
+   std::ostream& print(std::ostream& out)const;
+
+   static const ossim_uint32 SHARD_COUNT = 16;
+
 protected:
+   typedef std::unordered_map<ossim_int32, ossimFixedTileCacheInfo> TileMap;
+   struct Shard
+   {
+      Shard():m_mutex(), m_tileMap(), m_clock(), m_clockHand(0){}
+
+      std::mutex                m_mutex;
+      TileMap                   m_tileMap;
+      std::vector<ossim_int32>  m_clock;
+      ossim_uint32              m_clockHand;
+   };
+
    virtual ~ossimFixedTileCache();
+
+   Shard& getShard(ossim_int32 id);
+
+   /** Locks the shard mutex counting it as contention if already held. */
+   void lockShard(Shard& shard);
+
+   /** Shard lock must be held.  Returns the tile removed or null. */
+   ossimRefPtr<ossimImageData> eraseTile(Shard& shard, ossim_int32 id);
+
+   /** Shard lock must be held.  Runs the clock hand and removes the victim. */
+   ossimRefPtr<ossimImageData> evictTile(Shard& shard);
+
+   void adjustCacheSize(ossim_int64 delta);
+
+   /** Guards the grid geometry. */
    std::mutex theMutex;
    ossimIrect   theTileBoundaryRect;
    ossimIpt     theTileSize;
    ossimIpt     theBoundaryWidthHeight;
    ossim_uint32 theTilesHorizontal;
    ossim_uint32 theTilesVertical;
-   ossim_uint32 theCacheSize;
+   std::atomic<ossim_int64>  theCacheSize;
    ossim_uint32 theMaxCacheSize;
-   std::map<ossim_int32, ossimFixedTileCacheInfo> theTileMap;
-   std::list<ossim_int32> theLruQueue;
-   bool                   theUseLruFlag;
-   virtual void eraseFromLru(ossim_int32 id);
-   void adjustLru(ossim_int32 id);
+   Shard                     theShards[SHARD_COUNT];
+   std::atomic<ossim_uint32> theNumberOfTiles;
+   std::atomic<ossim_uint32> theNextEvictShard;
+   std::atomic<ossim_int64>* theSharedCacheSize;
+   bool                      theUseLruFlag;
+
+   std::atomic<ossim_uint64> theHitCount;
+   std::atomic<ossim_uint64> theMissCount;
+   std::atomic<ossim_uint64> theEvictionCount;
+   std::atomic<ossim_uint64> theContentionCount;
 };
 
 #endif
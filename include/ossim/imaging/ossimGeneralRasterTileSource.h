@@ -21,7 +21,9 @@
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimIoStream.h>
 #include <ossim/imaging/ossimGeneralRasterInfo.h>
+#include <ossim/base/MemoryMap.h>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class  ossimImageData;
@@ -169,6 +171,19 @@ public:
    /** @brief Initializes bandList to the zero based order of output bands. */
    virtual void getOutputBandList(std::vector<ossim_uint32>& bandList) const;
 
+   /**
+    * @brief Memory maps the image files so full res tiles are copied straight
+    * from the mapping into the caller's tile.
+    *
+    * Overrides: ossimImageHandler::enableConcurrentReads
+    *
+    * @return true if every image file could be mapped.
+    */
+   virtual bool enableConcurrentReads();
+
+   /** Overrides: ossimImageHandler::isConcurrentReadSafe */
+   virtual bool isConcurrentReadSafe(ossim_uint32 resLevel) const;
+
 protected:
    virtual ~ossimGeneralRasterTileSource();
    /**
@@ -184,6 +199,12 @@ protected:
    virtual ossimKeywordlist getXmlInfo(ossimFilename xmlFile);
 
    bool initializeHandler();
+
+   /**
+    * Fills result from the memory mapped files.  Touches no member buffers
+    * so it may run on several threads at once.
+    */
+   bool loadFromMappedFiles(ossimImageData* result) const;
    
    ossimRefPtr<ossimImageData>              m_tile;
    ossim_uint8*                             m_buffer;
@@ -197,6 +218,15 @@ protected:
    ossim_uint32                             m_bufferSizeInPixels;
    std::vector<ossim_uint32>                m_outputBandList;
 
+   /** One per image file when concurrent reads are enabled. */
+   std::vector< std::shared_ptr<ossim::MemoryMap> > m_memoryMaps;
+
+   /**
+    * Serializes the stream path, which shares m_buffer and the streams, for
+    * mapped reads that fall back to it.
+    */
+   std::mutex                               m_streamMutex;
+
 private:
    
    /** @brief Allocates m_tile. */
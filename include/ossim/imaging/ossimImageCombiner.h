@@ -8,15 +8,21 @@
 // $Id: ossimImageCombiner.h 23108 2015-01-27 17:00:20Z okramer $
 #ifndef ossimImageCombiner_HEADER
 #define ossimImageCombiner_HEADER
+#include <map>
 #include <vector>
 
 #include <ossim/imaging/ossimImageSource.h>
+#include <ossim/base/RectIndex.h>
 #include <ossim/base/ossimConnectableObjectListener.h>
 #include <ossim/base/ossimPropertyEvent.h>
 
 /**
  * This will be a base for all combiners.  Combiners take N inputs and
  * will produce a single output.
+ *
+ * The inputs overlapping a tile are found through an R-tree over the input
+ * bounding rects, built per res level on first use, so large mosaics do not
+ * test every input for every tile.
  */
 class OSSIMDLLEXPORT ossimImageCombiner : public ossimImageSource,
                                           public ossimConnectableObjectListener
@@ -126,6 +132,29 @@ protected:
    virtual ~ossimImageCombiner();   
    void precomputeBounds()const;
 
+   /**
+    * @return The index over the input bounds at resLevel, built on first
+    * use.  Dropped when the bounds are recomputed.
+    */
+   const ossim::RectIndex& getInputIndex(ossim_uint32 resLevel)const;
+
+   /**
+    * Lets derived combiners skip an input whose bounding rect overlaps rect
+    * but whose valid data does not, before its tile is requested by
+    * getNextTile.  The default never skips.
+    */
+   virtual bool isInputOutside(ossim_uint32 inputIndex,
+                               const ossimIrect& rect,
+                               ossim_uint32 resLevel)const;
+
+   /**
+    * @return The indexes of the inputs overlapping tileRect, ascending.  The
+    * last query is kept since the getNextTile calls for one tile all ask
+    * for the same rect.
+    */
+   const std::vector<ossim_uint32>& getTileCandidates(const ossimIrect& tileRect,
+                                                      ossim_uint32 resLevel);
+
    ossim_uint32                theLargestNumberOfInputBands;
    ossim_uint32                theInputToPassThrough;
    bool                        theHasDifferentInputs;
@@ -133,6 +162,10 @@ protected:
    mutable std::vector<ossimIrect>     theFullResBounds;
    mutable bool                theComputeFullResBoundsFlag;
    ossim_uint32                theCurrentIndex;
+   mutable std::map<ossim_uint32, ossim::RectIndex> theInputIndexes;
+   mutable std::vector<ossim_uint32> theTileCandidates;
+   mutable ossimIrect          theTileCandidatesRect;
+   ossim_uint32                theTileCandidatesResLevel;
    
 TYPE_DATA  
 };
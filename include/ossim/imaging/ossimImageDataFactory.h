@@ -24,6 +24,11 @@ class ossimImageSource;
 /*!
  * This factory should be called by all image source producers to allocate
  * an image tile.
+ *
+ * Tile band buffers can be recycled through ossim::BufferPool.  Set the
+ * preference keyword ossim.imaging.image_data_factory.pool.enabled to true
+ * to turn it on and ossim.imaging.image_data_factory.pool.max_size to the
+ * cap in megabytes.
  */
 class OSSIM_DLL ossimImageDataFactory
 {
@@ -21,6 +21,8 @@
 #include <ossim/base/ossimObjectEvents.h>
 #include <ossim/base/ossimProcessProgressEvent.h>
 #include <ossim/base/ossimViewController.h>
+#include <ossim/parallel/TilePipeline.h>
+#include <memory>
 
 /**
  * Pure virtual base class for image file writers.
@@ -281,6 +283,16 @@ public:
    
    virtual void setPercentComplete(double percentComplete);
 
+   /**
+    * @brief Sets the number of tiles the writer pipeline keeps in flight.
+    *
+    * With a depth the input chain runs on its own thread ahead of the writer
+    * and writers that support it encode tiles on the thread pool.  0, the
+    * default, reads and writes in line.
+    */
+   void setPipelineDepth(ossim_uint32 depth);
+   ossim_uint32 getPipelineDepth() const;
+
    virtual void  setOutputImageType(ossim_int32 type);
    virtual void  setOutputImageType(const ossimString& type);
    virtual ossim_int32 getOutputImageType() const;
@@ -449,6 +461,34 @@ protected:
     * @return true on success, false on error.
     */
    virtual bool writeFile() = 0;
+
+   /**
+    * @brief Starts the tile pipeline if a pipeline depth is set.
+    *
+    * Resets the sequence.  Tiles are then taken with getNextTile and the
+    * pipeline ended with stopTilePipeline.
+    *
+    * @param encoder Optional per tile encoder run on the thread pool.
+    * @return true if the pipeline is running.
+    */
+   bool startTilePipeline(ossim::TilePipeline::Encoder encoder=ossim::TilePipeline::Encoder());
+
+   /**
+    * @brief Gets the next tile in sequence, from the pipeline if running
+    * else straight from theInputConnection.
+    *
+    * @param encoded If not null receives the encoder output.  Left empty when
+    * there is no encoder.
+    * @return The tile or null at the end of the sequence or on an encode
+    * error.
+    */
+   ossimRefPtr<ossimImageData> getNextTile(std::vector<ossim_uint8>* encoded=0);
+
+   /**
+    * @brief Stops the pipeline and reports its throughput through a process
+    * progress event.
+    */
+   void stopTilePipeline();
    
    ossimRefPtr<ossimImageSourceSequencer> theInputConnection;
    ossimRefPtr<ossimViewController>       theViewController;
@@ -492,6 +532,10 @@ protected:
 
    /** OSSIM_PIXEL_IS_POINT = 0, OSSIM_PIXEL_IS_AREA  = 1 */
    ossimPixelType             thePixelType;
+
+   /** Tiles kept in flight by the writer pipeline, 0 for none. */
+   ossim_uint32               thePipelineDepth;
+   std::shared_ptr<ossim::TilePipeline> thePipeline;
    
 TYPE_DATA
 };
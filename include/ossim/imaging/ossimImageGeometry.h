@@ -140,6 +140,10 @@ public:
    bool localToWorld(const ossimDpt& local_pt, ossimGpt& world_pt) const;
    bool localToWorld(const ossimDrect& local_rect, ossimGrect& world_rect) const;
 
+   //! Batch form of localToWorld for count points. Elevation for all points is looked up in
+   //! one pass by the projection. Returns FALSE if no projection is defined.
+   bool localToWorld(const ossimDpt* local_pts, ossim_uint32 count, ossimGpt* world_pts) const;
+
    //! Exposes the 3D projection from image to world coordinates given a constant height above 
    //! ellipsoid. The caller should verify that a valid projection exists before calling this
    //! method. Returns TRUE if a valid ground point is available in the ground_pt argument.
@@ -151,6 +155,11 @@ public:
    bool worldToLocal(const ossimGpt& world_pt, ossimDpt& local_pt) const;
    bool worldToLocal(const ossimGrect& world_rect, ossimDrect& local_rect) const;
 
+   //! Batch form of worldToLocal for count points. Points with a NAN height on a projection
+   //! affected by elevation get their heights in one bulk elevation query. Returns FALSE if no
+   //! projection is defined.
+   bool worldToLocal(const ossimGpt* world_pts, ossim_uint32 count, ossimDpt* local_pts) const;
+
    //! Sets the transform to be used for local-to-full-image coordinate transformation
    void setTransform(ossim2dTo2dTransform* transform);
 
@@ -444,6 +444,27 @@ public:
     */
    virtual bool isBandSelector() const;
 
+   /**
+    * @brief Switches the handler to a read mode where
+    * getTile(ossimImageData*, resLevel) can be called from several threads at
+    * once, typically by positional reads of a memory mapped file into the
+    * caller's tile.
+    *
+    * This method returns false. Derived classes that can read without shared
+    * state should override.
+    *
+    * @return true if concurrent reads are now enabled.
+    */
+   virtual bool enableConcurrentReads();
+
+   /**
+    * @brief Indicates whether getTile(ossimImageData*, resLevel) for this
+    * level may run concurrently with itself.  Levels served by an overview
+    * handler are not safe unless the overview says so.
+    * @return true if safe; false, if not.
+    */
+   virtual bool isConcurrentReadSafe(ossim_uint32 resLevel) const;
+
    /**
     * @brief If the image handler "isBandSeletor()" then the band selection
     * of the output chip can be controlled.
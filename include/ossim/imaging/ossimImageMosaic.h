@@ -15,6 +15,8 @@
 using namespace std;
 
 #include <ossim/imaging/ossimImageCombiner.h>
+#include <ossim/base/ossimPolygon.h>
+#include <map>
 
 
 /**
@@ -22,6 +24,11 @@ using namespace std;
  * just do a simple mosaic.  It just checks NULL pix values until it finds a
  * pixel that is not empty and copies it out to the output.  The list will
  * have same size tiles and have the same number of bands.
+ *
+ * Once a layer has been copied only the bounding rect of the pixels still
+ * null is requested from the layers below, so a layer filling a sliver
+ * produces a sliver.  With the valid footprints flag set, layers whose
+ * valid image vertices miss that rect are skipped without a request.
  */
 class OSSIMDLLEXPORT ossimImageMosaic : public ossimImageCombiner
 {
@@ -48,6 +55,14 @@ public:
    virtual bool loadState(const ossimKeywordlist& kwl,
                           const char* prefix=0);
 
+   /**
+    * Enables skipping inputs by their valid image vertices.  Default false,
+    * keyword "use_valid_footprints".  The vertices of each input are
+    * fetched once per res level.
+    */
+   void setUseValidFootprintsFlag(bool flag);
+   bool getUseValidFootprintsFlag()const;
+
 protected:
    virtual ~ossimImageMosaic();
 
@@ -58,6 +73,20 @@ protected:
    
    ossimRefPtr<ossimImageData> theTile;
 
+   virtual bool isInputOutside(ossim_uint32 inputIndex,
+                               const ossimIrect& rect,
+                               ossim_uint32 resLevel)const;
+
+   /**
+    * @return The valid image vertices of the input at resLevel, no vertices
+    * if unknown.
+    */
+   const ossimPolygon& getFootprint(ossim_uint32 inputIndex,
+                                    ossim_uint32 resLevel)const;
+
+   bool theUseValidFootprintsFlag;
+   mutable std::map<ossim_uint32, std::vector<ossimPolygon> > theFootprints;
+
    template <class T> ossimRefPtr<ossimImageData> combine(
       T, // dummy template variable not used
       const ossimIrect& tileRect,
@@ -114,6 +114,17 @@ public:
 
    void setMaxLevelsToCompute(ossim_uint32 maxLevels);
    ossim_uint32 getMaxLevelsToCompute()const;
+
+   /**
+    * Output tiles of at least this many pixels are resampled on the thread
+    * pool: the sub rects are split up front, the input each resolution
+    * level needs is read in one request, and the sub rects are filled in
+    * parallel, each thread with its own resampler.  Defaults to the
+    * preference "image_renderer.parallel_threshold" or 65536 (256x256).
+    * 0 keeps every tile on the calling thread.
+    */
+   void setParallelThreshold(ossim_uint32 pixels);
+   ossim_uint32 getParallelThreshold()const;
    
    void connectInputEvent(ossimConnectionEvent& event);
    void disconnectInputEvent(ossimConnectionEvent& event);
@@ -273,6 +284,39 @@ private:
 
    void fillTile(ossimRefPtr<ossimImageData> outputData,
                  const ossimRendererSubRectInfo& rectInfo);
+
+   /** Input rect and level a sub rect resamples from. */
+   struct FillRequest
+   {
+      ossim_uint32 m_resLevel;
+      double       m_scale;
+      ossimIrect   m_inputRect;
+   };
+
+   /** First half of fillTile. @return false if the sub rect has nothing to fill. */
+   bool getFillRequest(const ossimRendererSubRectInfo& rectInfo,
+                       FillRequest& request)const;
+
+   /** Second half of fillTile, resamples from input which covers request. */
+   void resampleFill(ossimFilterResampler* resampler,
+                     const ossimRefPtr<ossimImageData>& input,
+                     ossimRefPtr<ossimImageData> outputData,
+                     const ossimRendererSubRectInfo& rectInfo,
+                     const FillRequest& request)const;
+
+   /** The split loop of recursiveResample, returns the sub rects to fill. */
+   void splitToLeaves(const ossimRendererSubRectInfo& rectInfo,
+                      std::vector<ossimRendererSubRectInfo>& leaves)const;
+
+   /**
+    * recursiveResample on the thread pool.
+    * @return false if the tile is below the threshold or there is no pool.
+    */
+   bool parallelResample(ossimRefPtr<ossimImageData> outputData,
+                         const ossimRendererSubRectInfo& rectInfo);
+
+   /** Brings the per thread resamplers in line with m_Resampler. */
+   void updateWorkerResamplers(ossim_uint32 count);
                  
    ossimIrect getBoundingImageRect()const;
 
@@ -343,6 +387,10 @@ private:
    double                   m_averageViewToImageScale;
    double                   m_averageViewToImageRLevelScale;
 
+   ossim_uint32                        m_parallelThreshold;
+   std::vector<ossimFilterResampler*>  m_workerResamplers;
+   ossim_uint32                        m_workerResamplerChangeCount;
+
    TYPE_DATA
 };
 
@@ -17,7 +17,12 @@
 #include <ossim/base/ossimConnectableObjectListener.h>
 #include <ossim/base/ossimHistogramSource.h>
 #include <ossim/base/ossimMultiResLevelHistogram.h>
+#include <memory>
 
+namespace ossim
+{
+   class TilePrefetcher;
+}
 
 class OSSIMDLLEXPORT ossimImageSourceSequencer
    :
@@ -146,6 +151,23 @@ public:
    void getBinInformation(ossim_uint32& numberOfBins,
                           ossim_float64& minValue,
                           ossim_float64& maxValue, ossimScalarType stype)const;
+
+   /**
+    * @brief Sets how many tiles of the sequence are read ahead into the
+    * image handler caches of the input chain.  0 turns read ahead off.
+    *
+    * Initialized from the preferences, e.g.:
+    * ossim.imaging.sequencer.prefetch.depth: 8
+    * ossim.imaging.sequencer.prefetch.max_size: 64  (megabytes)
+    */
+   void setPrefetchDepth(ossim_uint32 depth);
+   ossim_uint32 getPrefetchDepth()const;
+
+   /** @brief Cap on the bytes read ahead and not yet consumed. */
+   void setPrefetchMaxBytes(ossim_uint64 maxBytes);
+
+   /** @return The read ahead stage, for its hit rate and stall counters. */
+   std::shared_ptr<ossim::TilePrefetcher> getPrefetcher()const;
    
 protected:
    ossimImageSource*  theInputConnection;
@@ -170,9 +192,16 @@ protected:
    ossim_int64 theNumberOfTilesVertical;
    ossim_int64 theCurrentTileNumber;
    bool theCreateHistogram;
+   std::shared_ptr<ossim::TilePrefetcher> thePrefetcher;
 
    virtual void updateTileDimensions();
 
+   /** Points the prefetcher at source if read ahead is on. */
+   void initializePrefetcher(ossimImageSource* source);
+
+   /** Runs the read ahead for tile id.  Call right before id is read. */
+   void prefetchTiles(ossim_int64 id);
+
 TYPE_DATA
 };
 
@@ -18,6 +18,7 @@
 
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimIoStream.h>
+#include <ossim/base/MemoryMap.h>
 #include <ossim/imaging/ossimAppFixedTileCache.h>
 #include <ossim/support_data/ossimNitfFile.h>
 #include <ossim/support_data/ossimNitfFileHeader.h>
@@ -97,6 +98,27 @@ public:
    virtual ossimRefPtr<ossimImageData> getTile(const  ossimIrect& tileRect,
                                                ossim_uint32 resLevel=0);
 
+   /**
+    * @brief Fills result.  Uncompressed blocks are read from the memory
+    * mapped file when concurrent reads are enabled, everything else goes
+    * through getTile(const ossimIrect&, ossim_uint32).
+    *
+    * @return true on success, false on error.
+    */
+   virtual bool getTile(ossimImageData* result, ossim_uint32 resLevel=0);
+
+   /**
+    * @brief Memory maps the file for the uncompressed read modes.
+    *
+    * Overrides: ossimImageHandler::enableConcurrentReads
+    *
+    * @return true if the file was mapped.
+    */
+   virtual bool enableConcurrentReads();
+
+   /** Overrides: ossimImageHandler::isConcurrentReadSafe */
+   virtual bool isConcurrentReadSafe(ossim_uint32 resLevel) const;
+
     /**
      * @return Returns the number of bands in the image.
      * Satisfies pure virtual from ImageHandler class.
@@ -406,6 +428,24 @@ protected:
     */
    virtual bool loadBlock(ossim_uint32 x, ossim_uint32 y);
 
+   /**
+    * @return true if the current entry is stored uncompressed so blocks can
+    * be copied straight from the mapped file.
+    */
+   bool canReadMapped() const;
+
+   /**
+    * Loads the blocks covering result from the memory mapped file or the
+    * block cache.  Uses no member buffers so it can run concurrently.
+    */
+   bool loadMappedTile(ossimImageData* result) const;
+
+   /**
+    * Loads the block at the origin of block from the memory mapped file.
+    * The mapped equivalent of loadBlock.
+    */
+   bool loadMappedBlock(ossimImageData* block) const;
+
    /**
     * @param x Horizontal upper left pixel position of the requested block.
     *
@@ -549,6 +589,9 @@ protected:
    // prior to grabbing a block.
    //---
    bool m_jpegOffsetsDirty;
+
+   /** Whole file mapping used by the concurrent read path. */
+   ossim::MemoryMap m_memoryMap;
    
 TYPE_DATA
 };
@@ -19,6 +19,7 @@
 #include <ossim/imaging/ossimFilterResampler.h>
 #include <ossim/imaging/ossimBitMaskWriter.h>
 #include <ossim/imaging/ossimMaskFilter.h>
+#include <ossim/imaging/HistogramAccumulator.h>
 #include <string>
 #include <vector>
 
@@ -276,6 +277,9 @@ protected:
     */
    ossim_uint32 m_histoTileIndex;
 
+   /** Integer counts for 8 and 16 bit input, added to m_histogram when written. */
+   ossim::HistogramAccumulator m_histoCounts;
+
    /** Control flags for min, max, null scanning. */
    bool m_scanForMinMax;
    bool m_scanForMinMaxNull;
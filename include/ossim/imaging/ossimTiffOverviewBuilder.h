@@ -125,6 +125,26 @@ public:
     */
    void setCopyAllFlag(bool flag);
 
+   /**
+    * @brief Sets the single pass flag.
+    *
+    * If true all reduced resolution levels are made in one pass over the
+    * source level, each 2x reduction feeding the next from memory instead
+    * of rereading the level just written.  Tile reductions run on the
+    * thread pool.  A requested histogram is counted from the source tiles
+    * of the pass, every tile in both histogram modes.  Ignored when running
+    * under mpi, when a mask or min/max scan is requested, when a
+    * histogram is requested for input other than 8 or 16 bit, or for a
+    * scalar type the single pass has no reduction for.
+    *
+    * Default is false, or overview_builder.single_pass_flag from the
+    * preferences.
+    */
+   void setSinglePassFlag(bool flag);
+
+   /** @return The single pass flag. */
+   bool getSinglePassFlag() const;
+
    /** @return ossimObject* to this object. */
    virtual ossimObject* getObject();
 
@@ -236,6 +256,26 @@ private:
                 ossim_uint32 resLevel,
                 bool firstResLevel);
    
+   /**
+    * Writes levels startingResLevel through requiredResLevels-1 in one pass
+    * over the source level of m_imageHandler.  The first level goes
+    * directly to tif, deeper levels through scratchFile until their turn
+    * to be written comes.
+    *
+    * @return true on success, false on error.
+    */
+   bool writeRnSinglePass(TIFF* tif,
+                          ossim_uint32 startingResLevel,
+                          ossim_uint32 requiredResLevels,
+                          const ossimFilename& scratchFile);
+
+   /**
+    * @return true if m_singlePassFlag is set, the input scalar type can be
+    * reduced in a single pass and nothing needs the level by level
+    * sequencer.
+    */
+   bool useSinglePass() const;
+
    /**
     *  Set the tiff tags for the appropriate resLevel.  Level zero is the
     *  full resolution image.
@@ -297,6 +337,7 @@ private:
    ossimString                                        m_tempExtension;
    bool                                               m_outputTileSizeSetFlag;
    bool                                               m_internalOverviewsFlag;
+   bool                                               m_singlePassFlag;
 
 TYPE_DATA   
 };
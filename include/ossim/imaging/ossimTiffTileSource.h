@@ -23,6 +23,7 @@
 #include <vector>
 #include <ossim/base/ossimStreamFactoryRegistry.h>
 #include <ossim/support_data/TiffStreamAdaptor.h>
+#include <ossim/base/MemoryMap.h>
 /*
  * TIFF is defined as an incomplete type to hide the tiff library's internal
  * data structures from clients.
@@ -216,6 +217,20 @@ public:
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
    bool isColorMapped() const;
+
+   /**
+    * @brief Memory maps the file and records the tile offsets of every
+    * uncompressed tiled level so those tiles are copied straight from the
+    * mapping without going through libtiff.
+    *
+    * Overrides: ossimImageHandler::enableConcurrentReads
+    *
+    * @return true if at least one level can be read from the mapping.
+    */
+   virtual bool enableConcurrentReads();
+
+   /** Overrides: ossimImageHandler::isConcurrentReadSafe */
+   virtual bool isConcurrentReadSafe(ossim_uint32 resLevel) const;
    
    virtual std::ostream& print(std::ostream& os) const;
 
@@ -303,6 +318,18 @@ private:
 
    bool loadFromTile(const ossimIrect& clip_rect,
                      ossimImageData* result);
+
+   /**
+    * Same as loadFromTile but copies the tiles of level out of the memory
+    * map.  Touches no member buffers or the tiff handle so it may run on
+    * several threads at once.
+    */
+   bool loadFromMappedTiles(const ossimIrect& clip_rect,
+                            ossim_uint32 level,
+                            ossimImageData* result) const;
+
+   /** @return true if level has its tile offsets recorded. */
+   bool isMappedLevel(ossim_uint32 level) const;
    
    void setReadMethod();
    
@@ -387,6 +414,12 @@ private:
    std::vector<ossim_uint32> theOutputBandList;
    std::shared_ptr<ossim::TiffIStreamAdaptor> m_streamAdaptor;
 
+   // Concurrent reads: the mapping and, per level, the tile offsets and
+   // byte counts.  A level with no offsets goes through libtiff.
+   ossim::MemoryMap                          m_memoryMap;
+   std::vector< std::vector<ossim_uint64> >  m_tileOffsets;
+   bool                                      m_swapBytesFlag;
+
 TYPE_DATA
 };
 
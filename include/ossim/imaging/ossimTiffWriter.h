@@ -96,6 +96,21 @@ public:
    virtual ossim_int32 setProjectionInfo(const ossimMapProjectionInfo& proj);
 
    void setLut(const ossimNBandLutDataObject& lut);
+
+   /**
+    * Cloud optimized GeoTIFF output.  When set the image is written tiled
+    * with internal overviews in one file: every directory ahead of the image
+    * data, the tiles of the smallest overview first and row by row within a
+    * level, and GDAL's structural metadata block right after the header.
+    * Keyword and property "cog_flag", default false.
+    */
+   void setCogFlag(bool flag);
+   bool getCogFlag()const;
+
+   /**
+    * @return true in cloud optimized mode.
+    */
+   virtual bool getOutputHasInternalOverviews( void ) const;
       
    /**
     * saves the state of the object.
@@ -152,6 +167,34 @@ public:
 protected:
    virtual bool writeFile();
 
+   /**
+    * Writes theFilename as a plain tiff or tiled tiff.
+    * @return true on success, false on error.
+    */
+   bool writeTiffFile();
+
+   /**
+    * Builds the overviews of the full resolution file r0File and lays both
+    * out as a cloud optimized GeoTIFF in theFilename.  r0File is consumed.
+    * @return true on success, false on error.
+    */
+   bool writeCog(const ossimFilename& r0File);
+
+   /**
+    * @return true if libtiff can write directories ahead of their tiles,
+    * i.e. is 4.1 or later.  Without it the cloud optimized mode writes a
+    * tiled tiff with internal overviews only.
+    */
+   virtual bool hasCogLayoutSupport()const;
+
+   /**
+    * Copies the directories and raw tiles of r0File and the overview file
+    * ovrFile, if any, into theFilename in cloud optimized order.
+    * @return true on success, false on error.
+    */
+   bool writeCogLayout(const ossimFilename& r0File,
+                       const ossimFilename& ovrFile);
+
    /**
     *  @return true on success, false on error.
     */
@@ -226,6 +269,7 @@ protected:
    ossimFilename           theLutFilename;
    bool                    theForceBigTiffFlag;
    bool                    theBigTiffFlag;
+   bool                    theCogFlag;
    mutable ossimRefPtr<ossimNBandToIndexFilter> theNBandToIndexFilter;
 TYPE_DATA
 };
@@ -0,0 +1,180 @@
+#ifndef ossimThreadPool_HEADER
+#define ossimThreadPool_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ossimJob;
+
+namespace ossim
+{
+   /**
+   * Work stealing thread pool.
+   *
+   * Every worker owns a deque of tasks.  A task submitted from a worker goes
+   * to the back of that worker's deque and is popped back off LIFO, so sub
+   * jobs a tile job fans out run while its data is still in cache.  Tasks
+   * submitted from outside the pool are dealt round robin.  A worker that
+   * runs dry steals from the front of the other deques before going to
+   * sleep.
+   *
+   * Waiting on a future from inside a task must go through wait() which
+   * keeps running pending tasks until the future is ready, otherwise a pool
+   * whose workers all wait on sub jobs would deadlock.
+   *
+   * @code
+   * ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+   * std::vector<std::future<double> > parts;
+   * for(ossim_uint32 idx = 0; idx < 4; ++idx)
+   * {
+   *    parts.push_back(pool->async([idx](){ return computePart(idx); }));
+   * }
+   * double sum = 0.0;
+   * for(auto& part:parts)
+   * {
+   *    sum += pool->wait(part);
+   * }
+   * @endcode
+   */
+   class OSSIM_DLL ThreadPool
+   {
+   public:
+      typedef std::function<void()> Task;
+
+      /**
+      * @param nThreads Number of workers.  0 uses ossim::getNumberOfThreads().
+      * @param pinThreads If true worker i is bound to cpu (i % cpus).
+      */
+      ThreadPool(ossim_uint32 nThreads=0, bool pinThreads=false);
+
+      /** Drops queued tasks and joins the workers. */
+      ~ThreadPool();
+
+      /** Process wide pool sized to the number of cpus. */
+      static ThreadPool* instance();
+
+      void submit(Task task);
+
+      /**
+      * Runs job->start() on the pool if the job is still ready when a worker
+      * gets to it.
+      */
+      void submit(std::shared_ptr<ossimJob> job);
+
+      /** Submits f and returns a future for its result. */
+      template<class F>
+      std::future<typename std::result_of<F()>::type> async(F f)
+      {
+         typedef typename std::result_of<F()>::type ResultType;
+         std::shared_ptr<std::packaged_task<ResultType()> > task =
+            std::make_shared<std::packaged_task<ResultType()> >(f);
+         std::future<ResultType> result = task->get_future();
+         submit([task](){ (*task)(); });
+         return result;
+      }
+
+      /**
+      * Waits for the future running pending tasks in the meantime.  Safe to
+      * call from inside a task.
+      */
+      template<class T>
+      T wait(std::future<T>& result)
+      {
+         waitUntilReady(result);
+         return result.get();
+      }
+
+      /**
+      * Pops one task from the calling worker's deque or steals one and runs
+      * it on the calling thread.
+      *
+      * @return false if there was nothing to run.
+      */
+      bool runPendingTask();
+
+      /** Blocks until every queued and running task is done. */
+      void waitForIdle();
+
+      /** Drops the tasks that have not started yet. */
+      void clear();
+
+      ossim_uint32 getNumberOfThreads()const { return static_cast<ossim_uint32>(m_workers.size()); }
+
+      /** @return Tasks queued and not yet started. */
+      ossim_uint64 getQueueDepth()const { return m_queuedCount; }
+
+      /** @return Tasks started and not yet finished. */
+      ossim_uint32 getNumberOfBusyThreads()const { return m_runningCount; }
+
+      ossim_uint64 getStealCount()const { return m_stealCount; }
+      ossim_uint64 getExecutedCount()const { return m_executedCount; }
+
+      /** @return Total seconds the workers spent asleep waiting for work. */
+      double getIdleTime()const;
+
+      /**
+      * Prints the worker count and the queue depth, steal, executed and idle
+      * counters on one line.
+      */
+      std::ostream& print(std::ostream& out)const;
+
+   protected:
+      struct Worker
+      {
+         Worker():m_mutex(), m_tasks(), m_thread(){}
+
+         std::mutex        m_mutex;
+         std::deque<Task>  m_tasks;
+         std::thread       m_thread;
+      };
+
+      void workerLoop(ossim_uint32 index);
+
+      /** Pops from the back of the own deque then steals from the others. */
+      bool nextTask(ossim_int32 index, Task& task);
+
+      void execute(Task& task);
+
+      template<class T>
+      void waitUntilReady(std::future<T>& result)
+      {
+         while(result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+         {
+            if(!runPendingTask())
+            {
+               result.wait_for(std::chrono::microseconds(100));
+            }
+         }
+      }
+
+      /** @return Index of the calling worker in this pool or -1. */
+      ossim_int32 currentWorkerIndex()const;
+
+      void pinThread(std::thread& thread, ossim_uint32 index);
+
+      std::vector<std::unique_ptr<Worker> > m_workers;
+      std::atomic<bool>         m_doneFlag;
+      std::atomic<ossim_uint32> m_nextWorker;
+
+      std::mutex                m_sleepMutex;
+      std::condition_variable   m_wakeCondition;
+      std::condition_variable   m_idleCondition;
+
+      std::atomic<ossim_uint64> m_queuedCount;
+      std::atomic<ossim_uint32> m_runningCount;
+      std::atomic<ossim_uint64> m_stealCount;
+      std::atomic<ossim_uint64> m_executedCount;
+      std::atomic<ossim_uint64> m_idleMicroseconds;
+   };
+}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef ossimTilePipeline_HEADER
+#define ossimTilePipeline_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ossimImageSourceSequencer;
+
+namespace ossim
+{
+   /**
+   * Bounded producer / encoder / ordered consumer pipeline for the writers.
+   *
+   * A producer thread pulls tiles from the sequencer in sequence order and
+   * hands each one to the thread pool for encoding, keeping at most depth
+   * tiles between the sequencer and the writer.  The writer takes them back
+   * with next() in the original order, so the file is still written by a
+   * single thread while the chain and the compression of later tiles run
+   * in parallel.
+   *
+   * Without an encoder the tiles pass through unchanged and only the chain
+   * overlaps the writing.
+   *
+   * @code
+   * ossim::TilePipeline pipeline(sequencer, 8, encoder);
+   * pipeline.start();
+   * ossim::TilePipeline::Item item;
+   * while(pipeline.next(item))
+   * {
+   *    write(item.m_encoded);
+   * }
+   * @endcode
+   */
+   class OSSIM_DLL TilePipeline
+   {
+   public:
+      /**
+      * Encodes tile into encoded.  Called on pool threads, several at once.
+      * @return false on error.
+      */
+      typedef std::function<bool(const ossimImageData* tile,
+                                 std::vector<ossim_uint8>& encoded)> Encoder;
+
+      struct Item
+      {
+         Item():m_tile(0), m_encoded(), m_status(true){}
+
+         ossimRefPtr<ossimImageData> m_tile;
+         std::vector<ossim_uint8>    m_encoded;
+
+         /** false if the encoder failed. */
+         bool                        m_status;
+      };
+
+      TilePipeline(ossimImageSourceSequencer* sequencer,
+                   ossim_uint32 depth,
+                   Encoder encoder=Encoder());
+
+      /** Stops the producer. */
+      ~TilePipeline();
+
+      /** Resets the sequence and starts producing. */
+      void start();
+
+      /**
+      * Gets the next tile in sequence order, waiting for it if needed.
+      * @return false once the sequence is done or the pipeline stopped.
+      */
+      bool next(Item& item);
+
+      /** Stops producing and drops the tiles not taken yet. */
+      void stop();
+
+      ossim_uint64 getTileCount()const { return m_tileCount; }
+      ossim_uint64 getInputBytes()const { return m_inputBytes; }
+      ossim_uint64 getEncodedBytes()const { return m_encodedBytes; }
+
+      /** @return Seconds from start() to the last tile taken. */
+      double getElapsedTime()const;
+
+      /** @return Seconds the writer waited on the pipeline. */
+      double getWaitTime()const;
+
+      /** @return Seconds the producer waited for room in the queue. */
+      double getProducerWaitTime()const;
+
+      /** One line summary: tiles, megabytes per second, wait times. */
+      std::string getThroughputMessage()const;
+
+   protected:
+      struct Slot
+      {
+         ossimRefPtr<ossimImageData>               m_tile;
+         std::shared_ptr< std::vector<ossim_uint8> > m_encoded;
+         std::future<bool>                         m_status;
+      };
+
+      void produce();
+
+      ossimImageSourceSequencer*  m_sequencer;
+      ossim_uint32                m_depth;
+      Encoder                     m_encoder;
+
+      std::thread                 m_producer;
+      std::mutex                  m_mutex;
+      std::condition_variable     m_condition;
+      std::deque<Slot>            m_queue;
+      bool                        m_doneFlag;
+      bool                        m_stopFlag;
+
+      std::chrono::steady_clock::time_point m_startTime;
+      std::chrono::steady_clock::time_point m_lastTime;
+      std::atomic<ossim_uint64>   m_tileCount;
+      std::atomic<ossim_uint64>   m_inputBytes;
+      std::atomic<ossim_uint64>   m_encodedBytes;
+      std::atomic<ossim_uint64>   m_waitMicroseconds;
+      std::atomic<ossim_uint64>   m_producerWaitMicroseconds;
+   };
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef ossimTilePrefetcher_HEADER
+#define ossimTilePrefetcher_HEADER 1
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <vector>
+
+class ossimCacheTileSource;
+class ossimImageGeometry;
+class ossimImageHandler;
+class ossimImageSource;
+
+namespace ossim
+{
+   class ThreadPool;
+
+   /**
+   * Read ahead stage for the sequencers.
+   *
+   * Knows the traversal order through a tile rect function and keeps the
+   * reads for the next depth output tiles in flight on the thread pool.  A
+   * read goes to a cache tile source sitting directly on an image handler
+   * that can read concurrently, so when the chain gets to that tile the
+   * cache already holds the data.  Output tiles are mapped into handler
+   * space through the image geometries, or taken as is when the chain does
+   * not change geometry.
+   *
+   * The counters tell how well it works: a hit is an output tile whose reads
+   * were done when it was needed, a stall one whose reads were still running
+   * and a miss one that was never prefetched.
+   *
+   * @code
+   * ossim::TilePrefetcher prefetcher;
+   * prefetcher.setDepth(8);
+   * prefetcher.setInput(chain, [this](ossim_int64 id, ossimIrect& rect)
+   *                           { return getTileRect(id, rect); });
+   * ...
+   * prefetcher.advance(tileId); // before reading tileId from the chain
+   * @endcode
+   */
+   class OSSIM_DLL TilePrefetcher
+   {
+   public:
+      typedef std::function<bool(ossim_int64 id, ossimIrect& rect)> TileRectFunction;
+
+      TilePrefetcher();
+
+      /** Waits for the reads still running. */
+      ~TilePrefetcher();
+
+      /**
+      * Finds the prefetch targets in the inputs of source.
+      *
+      * @param source Output end of the chain the sequencer reads.
+      * @param tileRect Gives the rectangle of output tile id.
+      */
+      void setInput(ossimImageSource* source, TileRectFunction tileRect);
+
+      /** Number of output tiles read ahead.  0 turns prefetching off. */
+      void setDepth(ossim_uint32 depth);
+      ossim_uint32 getDepth()const;
+
+      /** Cap on the bytes read ahead and not yet consumed. */
+      void setMaxBytes(ossim_uint64 maxBytes);
+      ossim_uint64 getMaxBytes()const;
+
+      /** @return true if there is a depth and something to prefetch into. */
+      bool isEnabled()const;
+
+      /**
+      * Queues the reads for the tiles after id up to id + depth, then waits
+      * for the reads of id.  Call right before reading id from the chain.
+      * Thread safe.
+      */
+      void advance(ossim_int64 id);
+
+      /** Waits for the reads in flight and starts over at tile 0. */
+      void reset();
+
+      ossim_uint64 getHitCount()const;
+      ossim_uint64 getStallCount()const;
+      ossim_uint64 getMissCount()const;
+
+      /** @return Cache tiles read ahead. */
+      ossim_uint64 getReadCount()const;
+
+      /** @return Seconds spent waiting on reads that were not done yet. */
+      double getStallTime()const;
+
+      /** @return hits / (hits + stalls + misses) */
+      double getHitRate()const;
+
+      std::ostream& print(std::ostream& out)const;
+
+   protected:
+      struct Target
+      {
+         ossimRefPtr<ossimCacheTileSource> m_cache;
+         ossimRefPtr<ossimImageHandler>    m_handler;
+         ossimRefPtr<ossimImageGeometry>   m_geometry;
+      };
+
+      struct Pending
+      {
+         std::vector< std::future<bool> > m_reads;
+         ossim_uint64                     m_bytes;
+      };
+
+      /** Queues the reads of output tile id.  Caller holds m_mutex. */
+      bool schedule(ossim_int64 id);
+
+      /**
+      * Maps rect from output space into target space choosing the level the
+      * chain will most likely ask for.
+      */
+      bool mapToTarget(const ossimIrect& rect, const Target& target,
+                       ossimIrect& targetRect, ossim_uint32& resLevel)const;
+
+      void waitForAll();
+
+      ThreadPool*                         m_pool;
+      std::vector<Target>                 m_targets;
+      ossimRefPtr<ossimImageGeometry>     m_outputGeometry;
+      TileRectFunction                    m_tileRect;
+      ossim_uint32                        m_depth;
+      ossim_uint64                        m_maxBytes;
+
+      mutable std::mutex                  m_mutex;
+      std::map<ossim_int64, Pending>      m_pending;
+      ossim_int64                         m_nextId;
+      ossim_uint64                        m_pendingBytes;
+
+      std::atomic<ossim_uint64>           m_hitCount;
+      std::atomic<ossim_uint64>           m_stallCount;
+      std::atomic<ossim_uint64>           m_missCount;
+      std::atomic<ossim_uint64>           m_readCount;
+      std::atomic<ossim_uint64>           m_stallMicroseconds;
+   };
+}
+
+#endif
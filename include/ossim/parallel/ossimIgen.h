@@ -65,6 +65,7 @@ protected:
    bool              theProgressFlag;
    bool              theStdoutFlag;
    ossim_uint32      theThreadCount;
+   bool              thePinThreadsFlag;
 
 };
 
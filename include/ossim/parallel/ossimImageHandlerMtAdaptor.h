@@ -16,6 +16,7 @@
 //**************************************************************************************************
 //! Intended mainly to provide a mechanism for mutex-locking access to a shared resource during
 //! a getTile operation on an ossimImageHandler. This is needed for multi-threaded implementation.
+//! Handlers that report isConcurrentReadSafe() for a level are called without the lock.
 //**************************************************************************************************
 class OSSIMDLLEXPORT ossimImageHandlerMtAdaptor : public ossimImageHandler
 {
@@ -71,6 +72,9 @@ public:
    virtual ossim_float64   getNullPixelValue(ossim_uint32 band=0)const;
    void setCacheTileSize(ossim_uint32 cache_tile_size);
    void setUseCache(bool use_cache);
+
+   //! Cache in front of the adaptee, null if caching is off.
+   ossimCacheTileSource* getCache() { return m_cache.get(); }
    void writeTime() const;
 
    double       d_getTileT;
@@ -80,6 +84,10 @@ protected:
    //! Protected destructor forces using reference pointer for instantiation.
    virtual ~ossimImageHandlerMtAdaptor();
 
+   //! True when getTile can call the adaptee without the mutex, see
+   //! ossimImageHandler::isConcurrentReadSafe.
+   bool isConcurrentRead(ossim_uint32 rLevel) const;
+
    ossimRefPtr<ossimImageHandler>    m_adaptedHandler;
    ossimRefPtr<ossimCacheTileSource> m_cache;
    mutable std::mutex                m_mutex;   
@@ -13,7 +13,8 @@
 #include <ossim/imaging/ossimImageSourceSequencer.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimConnectableObjectListener.h>
-#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ThreadPool.h>
 #include <ossim/parallel/ossimImageChainMtAdaptor.h>
 #include <ossim/base/Thread.h>
 #include <ossim/base/Block.h>
@@ -54,6 +55,13 @@ public:
    void setCacheTileSize(ossim_uint32 cache_tile_size);
    void setUseCache(bool use_cache);
 
+   //! Binds the worker threads to cpus. Takes effect at the next setToStartOfSequence().
+   void setPinThreads(bool pin_threads);
+
+   //! Pool running the getTile jobs, null until the sequence is started. Exposes the queue depth,
+   //! steal and idle counters.
+   std::shared_ptr<ossim::ThreadPool> getThreadPool() const { return m_threadPool; }
+
    // FOR DEBUG:
    ossim_uint32 d_maxCacheUsed;
    ossim_uint32 d_cacheEmptyCount;
@@ -125,8 +133,9 @@ protected:
    void print(ostringstream& msg) const;
 
    ossimRefPtr<ossimImageChainMtAdaptor> m_inputChain; //!< Same as base class' theInputConnection
-   std::shared_ptr<ossimJobMultiThreadQueue> m_jobMtQueue;
+   std::shared_ptr<ossim::ThreadPool>    m_threadPool;
    ossim_uint32                          m_numThreads;
+   bool                                  m_pinThreads;
    std::shared_ptr<ossimGetTileCallback> m_callback;
    ossim_uint32                          m_nextTileID; //!< ID of next tile to be threaded, different from base class' theCurrentTileNumber
    TileCache                             m_tileCache;  //!< Saves tiles output by threaded jobs
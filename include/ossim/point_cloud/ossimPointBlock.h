@@ -14,12 +14,25 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimGrect.h>
 #include <ossim/point_cloud/ossimPointRecord.h>
+#include <mutex>
 #include <vector>
 
 class ossimSource;
 
 /***************************************************************************************************
- * Base class for all Point Cloud data sources, including input file handlers and processing nodes.
+ * Block of points read from a point cloud source.
+ *
+ * Points are stored either as a list of ossimPointRecord objects (the default) or, after
+ * setColumnar(true), as contiguous columns: one array each for latitude, longitude, height and
+ * point id plus one float array per field present in the block's field code. Columnar blocks cost
+ * a handful of allocations instead of one record and one map per point, and the arrays can be
+ * read directly through getLatitudes(), getFieldValues() etc.
+ *
+ * The record accessors keep working on columnar blocks for legacy callers: the const ones
+ * build record copies of the columns on first use, under a lock so threads may share a const
+ * block, the non-const ones switch the block back to record storage so changes made through
+ * the records are kept. The per-index accessors
+ * getPosition(i), getField(i, fc) and setField(i, fc, v) work in both modes without conversion.
  **************************************************************************************************/
 class OSSIMDLLEXPORT ossimPointBlock: public ossimDataObject
 {
@@ -31,7 +44,8 @@ public:
    ~ossimPointBlock();
 
    /** Returns allocated size. The pointList may contain only null points if not assigned */
-   virtual ossim_uint32 size() const { return (ossim_uint32)m_pointList.size(); }
+   virtual ossim_uint32 size() const
+   { return (ossim_uint32)(m_columnar ? m_lat.size() : m_pointList.size()); }
 
    bool empty() const { return (size() == 0); }
 
@@ -48,17 +62,51 @@ public:
     */
    void setFieldCode(ossim_uint32 code);
 
+   /**
+    * Selects the storage. Points already held are converted. Columnar storage keeps only the
+    * fields in the field code, set it first.
+    */
+   void setColumnar(bool columnar);
+   bool isColumnar() const { return m_columnar; }
+
+   /** Reserves storage for numPoints points. */
+   void reserve(ossim_uint32 numPoints);
+
    /** Adds single point to the tail of the list. */
    virtual void addPoint(ossimPointRecord* point);
 
+   /** Adds a point with all fields null to the tail of the list. */
+   void addPoint(const ossimGpt& position, ossim_uint32 pointId);
+
+   /**
+    * Appends count points of source starting at offset. Copies whole column ranges when both
+    * blocks are columnar, shares the records when both are not.
+    */
+   void addPoints(const ossimPointBlock& source, ossim_uint32 offset, ossim_uint32 count);
+
+   /** Per point access valid in both storage modes. No range checking. */
+   ossimGpt getPosition(ossim_uint32 i) const;
+   ossim_float32 getField(ossim_uint32 i, ossimPointRecord::FIELD_CODES fc) const;
+   void setField(ossim_uint32 i, ossimPointRecord::FIELD_CODES fc, ossim_float32 value);
+
+   /**
+    * Zero copy views of the columns, size() entries each. NULL if the block is not columnar, or
+    * for getFieldValues(), if the field is not stored.
+    */
+   const ossim_float64* getLatitudes() const;
+   const ossim_float64* getLongitudes() const;
+   const ossim_float64* getHeights() const;
+   const ossim_uint32* getPointIds() const;
+   const ossim_float32* getFieldValues(ossimPointRecord::FIELD_CODES fc) const;
+
    virtual const ossimPointRecord* getPoint(ossim_uint32 point_offset) const;
    virtual ossimPointRecord* getPoint(ossim_uint32 point_offset);
 
    const ossimPointRecord* operator[](ossim_uint32 i) const { return getPoint(i); }
    ossimPointRecord* operator[](ossim_uint32 i) { return getPoint(i); }
 
-   virtual const PointList&  getPoints() const { return m_pointList; }
-   virtual PointList&  getPoints()  { return m_pointList; }
+   virtual const PointList&  getPoints() const;
+   virtual PointList&  getPoints();
 
    void getFieldMin(ossimPointRecord::FIELD_CODES field, ossim_float32& value) const;
    void getFieldMax(ossimPointRecord::FIELD_CODES field, ossim_float32& value) const;
@@ -68,8 +116,8 @@ public:
 
    virtual ossimObject* dup() const;
 
-   /** Resets any storage to empty. */
-   virtual void clear() { m_pointList.clear(); m_isNormalized = false; m_minMaxValid = false;}
+   /** Resets any storage to empty. The storage mode is kept. */
+   virtual void clear();
 
    /**
     *  Fulfills base class pure virtual. TODO: Needs to be correctly implemented
@@ -80,8 +128,30 @@ public:
    virtual void initialize() {};
 
 protected:
+   /** Number of optional fields, one column each in columnar storage. */
+   enum { NUM_FIELDS = 8 };
+
    ossimPointBlock(const ossimPointBlock& /* rhs */) {}
    void scanForMinMax() const;
+   void scanColumnsForMinMax() const;
+
+   /** @return Column of field code fc, 0 to NUM_FIELDS-1. */
+   static ossim_uint32 fieldIndex(ossimPointRecord::FIELD_CODES fc);
+
+   /** Sizes the field columns to the field code. */
+   void resizeColumns();
+
+   /** @return New record holding column entry i. */
+   ossimPointRecord* makeRecord(ossim_uint32 i) const;
+
+   /**
+    * Builds the record copies of the columns for the const record accessors. Once it returns
+    * the cache is complete and left alone by other const calls, reading it needs no lock.
+    */
+   void makeRecordCache() const;
+
+   /** Converts the columns to records and leaves columnar storage. */
+   void makeRecords();
 
    ossimPointRecord m_nullPCR;
    mutable ossimPointRecord m_minRecord;
@@ -91,6 +161,15 @@ protected:
    mutable ossim_uint32 m_fieldCode; // OR'd mash-up of ossimPointRecord::FIELD_CODES
    bool m_isNormalized;
 
+   bool m_columnar;
+   std::vector<ossim_float64> m_lat;
+   std::vector<ossim_float64> m_lon;
+   std::vector<ossim_float64> m_hgt;
+   std::vector<ossim_uint32>  m_ids;
+   std::vector<ossim_float32> m_fields[NUM_FIELDS];
+   mutable PointList          m_recordCache;
+   mutable std::mutex         m_recordCacheMutex;
+
 TYPE_DATA
 };
 
@@ -17,6 +17,8 @@
 #include <ossim/point_cloud/ossimPointBlock.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/point_cloud/ossimPointCloudGeometry.h>
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <mutex>
 #include <vector>
 
 
@@ -67,9 +69,25 @@ public:
     * are NaN, then only the horizontal bounds are considered. Thread-safe version accepts data
     * block object from caller. The block object is cleared before points are pushed on the vector.
     * The block size will be non-zero if points were found.
+    *
+    * When a spatial index sidecar exists for the input file (see buildIndex()), only the runs of
+    * points in index cells overlapping the bounds are read instead of the whole file.
     */
    virtual void getBlock(const ossimGrect& bounds, ossimPointBlock& block) const;
 
+   /**
+    * Builds the spatial index sidecar (<input>.pci) for the opened file and starts using it.
+    * @return true on success.
+    */
+   bool buildIndex(ossim_uint32 pointsPerCell=ossimPointCloudIndex::DEFAULT_POINTS_PER_CELL);
+
+   /**
+    * @return The spatial index of the opened file if a valid sidecar exists, else NULL. The
+    * sidecar is looked up once per input file. The index stays valid while the pointer is
+    * held, even if buildIndex() or another input file replaces it.
+    */
+   ossimRefPtr<const ossimPointCloudIndex> getIndex() const;
+
    virtual const ossimPointRecord*  getMinPoint() const { return m_minRecord.get(); }
    virtual const ossimPointRecord*  getMaxPoint() const { return m_maxRecord.get(); }
 
@@ -91,6 +109,10 @@ protected:
    ossimRefPtr<ossimPointRecord>  m_maxRecord;
    mutable ossim_uint32 m_currentPID;
 
+   mutable std::mutex m_indexMutex;
+   mutable ossimFilename m_indexedFilename;
+   mutable ossimRefPtr<ossimPointCloudIndex> m_index;
+
 TYPE_DATA
 };
 
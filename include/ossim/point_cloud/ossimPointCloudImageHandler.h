@@ -233,9 +233,11 @@ protected:
 
    void initTile();
 
+   /** Accumulates point i of the columnar block. */
    void addSample(std::map<ossim_int32, PcrBucket*>& accumulator,
                   ossim_int32 index,
-                  const ossimPointRecord* sample);
+                  const ossimPointBlock& block,
+                  ossim_uint32 i);
 
    void normalize(std::map<ossim_int32, PcrBucket*>& accumulator);
 
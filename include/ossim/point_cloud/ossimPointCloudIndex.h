@@ -0,0 +1,99 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointCloudIndex_HEADER
+#define ossimPointCloudIndex_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/MemoryMap.h>
+#include <vector>
+
+class ossimPointCloudHandler;
+
+/***************************************************************************************************
+ * Spatial index sidecar for point cloud files.
+ *
+ * The horizontal extent of the cloud is cut into a grid of cells and the index holds, per cell,
+ * the file order ids of the points falling in it. The file is built once per cloud, next to it
+ * with a ".pci" extension, and memory mapped when read so opening costs nothing and the pages
+ * are shared between processes.
+ *
+ * Layout, native byte order: a fixed header, (cols*rows + 1) ossim_uint64 cell start offsets
+ * into the id array, then the ossim_uint32 point ids grouped by cell and ascending within a cell.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointCloudIndex : public ossimReferenced
+{
+public:
+   /** Average number of points per cell aimed for when building. */
+   static ossim_uint32 DEFAULT_POINTS_PER_CELL;
+
+   ossimPointCloudIndex();
+   virtual ~ossimPointCloudIndex();
+
+   /** @return The sidecar name for a point cloud file, e.g. foo.las -> foo.pci */
+   static ossimFilename getIndexFilename(const ossimFilename& pointCloudFile);
+
+   /**
+    * Builds the index of all points in handler and writes it to indexFile. Reads the cloud
+    * through the handler's file blocks, twice if the handler does not know its bounds.
+    * @return true on success.
+    */
+   static bool build(const ossimPointCloudHandler& handler,
+                     const ossimFilename& pointCloudFile,
+                     const ossimFilename& indexFile,
+                     ossim_uint32 pointsPerCell=DEFAULT_POINTS_PER_CELL);
+
+   /**
+    * Maps indexFile. Fails if it is not an index or was built for a different version of
+    * pointCloudFile, judged by the point count and file size.
+    */
+   bool open(const ossimFilename& indexFile,
+             const ossimFilename& pointCloudFile,
+             ossim_uint32 numPoints);
+
+   void close();
+
+   bool isOpen() const { return m_header != 0; }
+
+   /**
+    * Gets the ids of the points in cells overlapping bounds, ascending. Points near the edges
+    * may lie outside bounds, callers filter.
+    */
+   void getPointIds(const ossimGrect& bounds, std::vector<ossim_uint32>& ids) const;
+
+   ossim_uint32 getNumberOfColumns() const;
+   ossim_uint32 getNumberOfRows() const;
+
+private:
+   struct Header
+   {
+      char          m_magic[8];
+      ossim_uint32  m_version;
+      ossim_uint32  m_byteOrder;
+      ossim_uint64  m_numPoints;
+      ossim_uint64  m_sourceSize;
+      ossim_uint32  m_cols;
+      ossim_uint32  m_rows;
+      ossim_float64 m_minLon;
+      ossim_float64 m_minLat;
+      ossim_float64 m_maxLon;
+      ossim_float64 m_maxLat;
+   };
+
+   ossimPointCloudIndex(const ossimPointCloudIndex&);
+   const ossimPointCloudIndex& operator=(const ossimPointCloudIndex&);
+
+   ossim::MemoryMap    m_map;
+   const Header*       m_header;
+   const ossim_uint64* m_cellOffsets;
+   const ossim_uint32* m_pointIds;
+};
+
+#endif /* #ifndef ossimPointCloudIndex_HEADER */
@@ -0,0 +1,84 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Error bounded interpolation grid standing in for a
+//              rigorous view-to-image projection.
+//
+//*******************************************************************
+#ifndef ossimImageViewApproximationGrid_HEADER
+#define ossimImageViewApproximationGrid_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDblGrid.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimDrect.h>
+#include <ossim/base/ossimFilename.h>
+#include <functional>
+
+/**
+ * Regular grid of image points over a view rectangle, bilinearly interpolated
+ * in between.
+ *
+ * build() samples the rigorous projection at the grid nodes and at every cell
+ * center, and halves the node spacing until nearly all cells interpolate their
+ * center within the maximum error. Cells that still miss it, or touch a point
+ * the projection could not resolve, are marked unusable and viewToImage()
+ * returns false for them so the caller falls back to the rigorous projection.
+ *
+ * Grids are immutable once built and may be shared between threads.
+ */
+class OSSIM_DLL ossimImageViewApproximationGrid
+{
+public:
+   /** Projects count view points to image points, NaN where it cannot. */
+   typedef std::function<void(const ossimDpt* viewPoints,
+                              ossim_uint32    count,
+                              ossimDpt*       imagePoints)> Projector;
+
+   ossimImageViewApproximationGrid();
+   virtual ~ossimImageViewApproximationGrid();
+
+   /**
+    * Builds the grid over viewRect.
+    * @param maxError Largest interpolation error allowed, in image pixels.
+    * @return false if no cell is usable.
+    */
+   bool build(const ossimDrect& viewRect, double maxError, const Projector& project);
+
+   /**
+    * Interpolates the image point of viewPoint.
+    * @return false if viewPoint is off the grid or in an unusable cell.
+    */
+   bool viewToImage(const ossimDpt& viewPoint, ossimDpt& imagePoint) const;
+
+   /** Writes the grid to file, tagged with key. */
+   bool save(const ossimFilename& file, ossim_uint64 key) const;
+
+   /** Reads a grid saved with the same key. */
+   bool load(const ossimFilename& file, ossim_uint64 key);
+
+   double getMaxError() const { return m_maxError; }
+   const ossimDpt& getSpacing() const { return m_imageX.spacing(); }
+
+   /** @return Fraction of cells falling back to the rigorous projection. */
+   double getUnusableFraction() const;
+
+protected:
+   /** Samples the nodes and cell centers at spacing, fills the grids. */
+   void sample(const ossimDrect& viewRect, double spacing, const Projector& project);
+
+   ossimDblGrid m_imageX;
+   ossimDblGrid m_imageY;
+
+   /** Center error per cell, null where the cell is unusable. */
+   ossimDblGrid m_cellError;
+
+   double m_maxError;
+
+   /** Cells with all four nodes resolved, and those of them unusable. */
+   ossim_uint32 m_resolvedCells;
+   ossim_uint32 m_failedCells;
+};
+
+#endif /* #ifndef ossimImageViewApproximationGrid_HEADER */
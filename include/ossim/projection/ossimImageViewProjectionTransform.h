@@ -19,8 +19,13 @@
 #define ossimImageViewProjectionTransform_HEADER 1
 
 #include <ossim/projection/ossimImageViewTransform.h>
+#include <ossim/projection/ossimImageViewApproximationGrid.h>
 #include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimPolyArea2d.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 class OSSIMDLLEXPORT ossimImageViewProjectionTransform : public ossimImageViewTransform
 {
@@ -53,6 +58,31 @@ public:
    //! Other workhorse of the object. Converts view-space to image-space.
    virtual void viewToImage(const ossimDpt& viewPoint, ossimDpt& imagePoint) const;
 
+   //! Batch form of viewToImage. When both sides must go through the ground the view points are
+   //! projected as a set so the elevation lookups are done in bulk.
+   virtual void viewPointsToImage(const ossimDpt* viewPoints,
+                                  ossim_uint32    count,
+                                  ossimDpt*       imagePoints) const;
+
+   /**
+    * Lets viewToImage() interpolate from a grid instead of projecting through the ground.
+    * The grid is built over the view footprint of the image on first use and only answers
+    * where it is known to be within maxError image pixels of the rigorous projection,
+    * everywhere else the rigorous projection is used. Defaults to the preference
+    * "image_view_transform.approximation_max_error".
+    * @param maxError Largest error in image pixels, 0 disables the grid.
+    */
+   void setApproximationMaxError(double maxError);
+   double getApproximationMaxError() const { return m_approximationMaxError; }
+
+   /**
+    * Caches the grid on disk. The grid is stored with a key of the geometries inserted before
+    * the extension, e.g. "image.ivg" becomes "image.<key>.ivg", so grids for several views of
+    * the same image live side by side. Empty keeps the grid in memory only.
+    */
+   void setApproximationCacheFile(const ossimFilename& file);
+   const ossimFilename& getApproximationCacheFile() const { return m_approximationCacheFile; }
+
    //! Dumps contents to stream
    virtual std::ostream& print(std::ostream& out) const;
    
@@ -120,10 +150,36 @@ protected:
    bool initializeViewSize();  
    void initializeDatelineCrossing();
 
+   //! Returns true if view points must be projected through the ground.
+   bool needsGround() const;
+
+   //! viewPointsToImage through the ground, never consults the grid.
+   void rigorousViewPointsToImage(const ossimDpt* viewPoints,
+                                  ossim_uint32    count,
+                                  ossimDpt*       imagePoints) const;
+
+   //! Builds or loads the grid the first time through. Returns null if there is none.
+   //! Callers hold on to the returned pointer, a reset may drop the grid meanwhile.
+   std::shared_ptr<const ossimImageViewApproximationGrid> getApproximationGrid() const;
+
+   //! Drops the grid, called whenever a geometry changes.
+   void resetApproximationGrid();
+
+   //! Hash of the geometries and error the grid is built for.
+   ossim_uint64 getApproximationKey() const;
+
    ossimRefPtr<ossimImageGeometry> m_imageGeometry;
    ossimRefPtr<ossimImageGeometry> m_viewGeometry;
 
    bool m_crossesDateline;
+
+   double        m_approximationMaxError;
+   ossimFilename m_approximationCacheFile;
+
+   mutable std::mutex                                   m_approximationMutex;
+   mutable std::atomic<bool>                            m_approximationChecked;
+   //! Read and written with std::atomic_load/atomic_store.
+   mutable std::shared_ptr<const ossimImageViewApproximationGrid> m_approximationGrid;
 TYPE_DATA
 };
 
@@ -79,6 +79,15 @@ public:
   
   virtual void viewToImage(const ossimDpt& viewPoint,
                            ossimDpt&       imagePoint)const;
+
+  /*!
+   * Batch form of viewToImage for count points.  The default loops over
+   * viewToImage.  Transforms that go through the ground override this so
+   * the elevation for all points is looked up at once.
+   */
+  virtual void viewPointsToImage(const ossimDpt* viewPoints,
+                                 ossim_uint32    count,
+                                 ossimDpt*       imagePoints)const;
   
   virtual std::ostream& print(std::ostream& out) const;
   
@@ -57,6 +57,18 @@ public:
                                         const double&   heightEllipsoid,
                                         ossimGpt&       worldPoint) const;
 
+   /**
+    * @brief Batch forms of the above, applying the decimation around the
+    * ossimRpcModel batch methods.
+    */
+   virtual void worldToLineSamples(const ossimGpt* world_points,
+                                   ossim_uint32    count,
+                                   ossimDpt*       image_points) const;
+   virtual void lineSampleHeightsToWorld(const ossimDpt* image_points,
+                                         const double*   heightsEllipsoid,
+                                         ossim_uint32    count,
+                                         ossimGpt*       worldPoints) const;
+
    /**
     * @brief Saves "decimation".  Then calls ossimRpcModel::saveState.
     */
@@ -60,6 +60,37 @@ public:
     */
    virtual void lineSampleToWorld(const ossimDpt& lineSampPt,
                                   ossimGpt&       worldPt) const = 0;
+
+   /*!
+    * METHOD: lineSamplesToWorld()
+    * Batch form of lineSampleToWorld for count points.  The default loops
+    * over lineSampleToWorld.  Models that intersect a DEM override this to
+    * query the elevation for all points at once.
+    */
+   virtual void lineSamplesToWorld(const ossimDpt* lineSampPts,
+                                   ossim_uint32    count,
+                                   ossimGpt*       worldPts) const;
+
+   /*!
+    * METHOD: worldToLineSamples()
+    * Batch form of worldToLineSample for count points.  The default loops
+    * over worldToLineSample.  Models with a closed form projection override
+    * this to evaluate many points at once.
+    */
+   virtual void worldToLineSamples(const ossimGpt* worldPts,
+                                   ossim_uint32    count,
+                                   ossimDpt*       lineSampPts) const;
+
+   /*!
+    * METHOD: lineSampleHeightsToWorld()
+    * Batch form of lineSampleHeightToWorld for count points, with one height
+    * above ellipsoid per point.  The default loops over
+    * lineSampleHeightToWorld.
+    */
+   virtual void lineSampleHeightsToWorld(const ossimDpt* lineSampPts,
+                                         const double*   heightsAboveEllipsoid,
+                                         ossim_uint32    count,
+                                         ossimGpt*       worldPts) const;
    
    /*!
     * METHOD: lineSampleHeightToWorld
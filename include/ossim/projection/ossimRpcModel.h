@@ -109,6 +109,17 @@ public:
     */
    virtual void  worldToLineSample(const ossimGpt& world_point,
                                    ossimDpt&       image_point) const;
+
+   /**
+    * @brief worldToLineSamples()
+    * Overrides base class implementation. Evaluates the polynomials for
+    * blocks of points at a time, the monomial terms of a point are computed
+    * once and shared by the four polynomials.
+    */
+   virtual void worldToLineSamples(const ossimGpt* world_points,
+                                   ossim_uint32    count,
+                                   ossimDpt*       image_points) const;
+
    /**
     * @brief print()
     * Extends base-class implementation. Dumps contents of object to ostream.
@@ -137,6 +148,15 @@ public:
    //***
    virtual void  lineSampleToWorld(const ossimDpt& image_point,
                                    ossimGpt&       world_point) const;
+
+   //***
+   // @brief lineSamplesToWorld()
+   // Overrides base class implementation.  Intersects the DEM for all points
+   // in one pass.
+   //***
+   virtual void lineSamplesToWorld(const ossimDpt* image_points,
+                                   ossim_uint32    count,
+                                   ossimGpt*       world_points) const;
    //***
    // @brief lineSampleHeightToWorld()
    // Overrides base class pure virtual. Height understood to be relative to
@@ -145,6 +165,16 @@ public:
    virtual void lineSampleHeightToWorld(const ossimDpt& image_point,
                                         const double&   heightEllipsoid,
                                         ossimGpt&       worldPoint) const;
+
+   //***
+   // @brief lineSampleHeightsToWorld()
+   // Overrides base class implementation. Runs the Newton iteration of
+   // lineSampleHeightToWorld for blocks of points in lock step.
+   //***
+   virtual void lineSampleHeightsToWorld(const ossimDpt* image_points,
+                                         const double*   heightsEllipsoid,
+                                         ossim_uint32    count,
+                                         ossimGpt*       worldPoints) const;
    
    /**
     * @brief imagingRay()
@@ -263,6 +293,13 @@ protected:
                      const double& nhgt,
                      const double* coeffs) const;
    
+   /**
+    * Copies the line/sample numerator/denominator coefficients, in that
+    * order, into coeffs rearranged to the RPC00B term order used by the
+    * batch methods.
+    */
+   void getBTermOrderCoefficients(double coeffs[4][20]) const;
+
    PolynomialType thePolyType;
 
    //***
@@ -170,6 +170,9 @@ protected:
 
    void evalPoint(const ossimGpt& gpt, ossimDpt& ipt) const;
 
+   /** Batch form of evalPoint for count points. */
+   void evalPoints(const ossimGpt* gpts, ossim_uint32 count, ossimDpt* ipts) const;
+
    /**
     * Inverts using the SVD method
     */
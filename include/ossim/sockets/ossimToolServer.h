@@ -10,12 +10,34 @@
 
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ossimTool;
 
 /**
  * Utility class provides the server interface to ossimTool-derived functionality via TCP sockets
  * Results are returned either as streamed text (for non-image responses such as image info) or
  * streamed binary file representing imagery or vector products. Clients interfacing to this class
  * should know the commands available (or execute the command "help" and view the text response).
+ *
+ * By default one connection is served at a time. With setNumberOfThreads() the server stays a
+ * single long lived process that watches all connections with poll() and runs their requests on
+ * a pool of worker threads, so ossimInit, the plugins, the elevation cells and the tile cache stay
+ * warm between requests. The command "stats" returns the request counts and latencies.
+ *
+ * In threaded mode each request writes to its own stream, handed to the tool and to ossimNotify
+ * for the worker thread. Not every tool can share the process with another request though: the
+ * chip processors load DEMs into the shared elevation manager (viewshed also changes its flags)
+ * and pointcloud, shoreline and vertices write straight to std::cout. Those run alone, with no
+ * other request running. Only info, subimage and help run alongside other requests.
  * @see ossimToolClient for concrete client implementation.
  */
 class OSSIM_DLL ossimToolServer
@@ -23,22 +45,90 @@ class OSSIM_DLL ossimToolServer
 public:
    ossimToolServer();
    ~ossimToolServer();
+
+   /**
+    * Number of worker threads serving requests. 0, the default, serves one connection at a time
+    * on the listening thread. Set before startListening().
+    */
+   void setNumberOfThreads(ossim_uint32 numThreads);
+   ossim_uint32 getNumberOfThreads() const { return m_numThreads; }
+
    void startListening(const char* portid);
 
+   /**
+    * Makes startListening() return; call from another thread. In threaded mode the running
+    * requests finish and every connection is closed first, otherwise the connection being served
+    * is finished first.
+    */
+   void stopListening();
+
+   /** @return Request counts and latencies since startListening(), one item per line. */
+   std::string getStatistics() const;
+
 private:
+   /** One client connection, owned by either the poll loop or a single worker at a time. */
+   struct Connection
+   {
+      Connection(int sockfd, const std::string& peer);
+
+      int m_sockfd;
+      std::string m_peer;
+      std::vector<char> m_buffer;
+
+      std::chrono::steady_clock::time_point m_requestStart;
+      bool m_responseStarted;
+   };
+
    void initSocket(const char* portid);
-   bool processOssimRequest(struct sockaddr_in& cli_addr);
-   bool runCommand(ossimString& command);
-   void writeSocket(const char* buf, int bufsize);
-   bool sendFile(const ossimFilename& fname);
+   void serveConnections();
+   void serveConnection(std::shared_ptr<Connection> connection);
+   void wake();
+   bool processOssimRequest(Connection& connection);
+   bool runCommand(Connection& connection, ossimString& command);
+   bool executeCommand(ossimString& command, ossimRefPtr<ossimTool>& utility, std::ostream& out);
+   bool writeSocket(Connection& connection, const char* buf, int bufsize);
+   bool sendFile(Connection& connection, const ossimFilename& fname);
    void error(const char* msg);
-   bool acknowledgeRcvd();
+   bool acknowledgeRcvd(Connection& connection);
+   void closeConnection(Connection& connection);
 
    static void sigchld_handler(int s);
 
+   /** @return true if the tool named in command may run while other requests run. */
+   static bool isConcurrentSafe(const ossimString& command);
+
+   /** Waits until the tool may run: alone if exclusive, else alongside other shared ones. */
+   void beginTool(bool exclusive);
+   void endTool(bool exclusive);
+
    int m_svrsockfd;
-   int m_clisockfd;
-   char* m_buffer;
+   ossim_uint32 m_numThreads;
+
+   /** Connections handed back by workers, picked up by the poll loop when woken. */
+   std::mutex m_returnedMutex;
+   std::vector< std::shared_ptr<Connection> > m_returned;
+
+   /** Wakes the poll loop. A socket pair, not a pipe, so WSAPoll can wait on it too. */
+   int m_wakeSockets[2];
+   std::atomic<bool> m_stopFlag;
+
+   /** Running shared tools and the exclusive one, see beginTool(). */
+   std::mutex m_toolMutex;
+   std::condition_variable m_toolCondition;
+   ossim_uint32 m_sharedTools;
+   ossim_uint32 m_exclusiveWaiting;
+   bool m_exclusiveTool;
+
+   std::chrono::steady_clock::time_point m_startTime;
+   std::atomic<ossim_uint64> m_connectionCount;
+   std::atomic<ossim_uint32> m_openConnections;
+   std::atomic<ossim_uint64> m_requestCount;
+   std::atomic<ossim_uint64> m_errorCount;
+   std::atomic<ossim_uint32> m_activeRequests;
+   std::atomic<ossim_uint32> m_maxActiveRequests;
+   std::atomic<ossim_uint64> m_latencyMicroseconds;
+   std::atomic<ossim_uint64> m_maxLatencyMicroseconds;
+   std::atomic<ossim_uint64> m_firstByteMicroseconds;
 };
 
 
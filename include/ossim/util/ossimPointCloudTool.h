@@ -54,6 +54,7 @@ protected:
    ossimFilename m_prodFile;
    ossimFilename m_demFile;
    ossimFilename m_pcFile;
+   bool m_buildIndex;
 
 };
 
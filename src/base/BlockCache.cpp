@@ -0,0 +1,126 @@
+#include <ossim/base/BlockCache.h>
+
+const ossim_uint64 ossim::BlockCache::DEFAULT_MAX_BYTES = 64*1024*1024;
+
+ossim::BlockCache::BlockCache(ossim_uint64 maxBytes)
+   :  m_mutex(),
+      m_lru(),
+      m_index(),
+      m_maxBytes(maxBytes),
+      m_bytes(0),
+      m_hitCount(0),
+      m_missCount(0)
+{
+}
+
+ossim::BlockCache* ossim::BlockCache::instance()
+{
+   static BlockCache cache;
+   return &cache;
+}
+
+ossim::BlockCache::BlockPtr ossim::BlockCache::find(const std::string& url,
+                                                    ossim_uint64 blockSize,
+                                                    ossim_int64 blockIndex)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   std::map<Key, LruList::iterator>::iterator iter = m_index.find(Key(url, blockSize, blockIndex));
+   if(iter == m_index.end())
+   {
+      ++m_missCount;
+      return BlockPtr();
+   }
+   ++m_hitCount;
+   m_lru.splice(m_lru.begin(), m_lru, iter->second);
+   return iter->second->second;
+}
+
+void ossim::BlockCache::insert(const std::string& url,
+                               ossim_uint64 blockSize,
+                               ossim_int64 blockIndex,
+                               BlockPtr block)
+{
+   if(!block) return;
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   Key key(url, blockSize, blockIndex);
+   std::map<Key, LruList::iterator>::iterator iter = m_index.find(key);
+   if(iter != m_index.end())
+   {
+      m_bytes -= iter->second->second->size();
+      m_lru.erase(iter->second);
+      m_index.erase(iter);
+   }
+   m_lru.push_front(std::make_pair(key, block));
+   m_index[key] = m_lru.begin();
+   m_bytes += block->size();
+   trim();
+}
+
+void ossim::BlockCache::erase(const std::string& url)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   LruList::iterator iter = m_lru.begin();
+   while(iter != m_lru.end())
+   {
+      if(iter->first.m_url == url)
+      {
+         m_bytes -= iter->second->size();
+         m_index.erase(iter->first);
+         iter = m_lru.erase(iter);
+      }
+      else
+      {
+         ++iter;
+      }
+   }
+}
+
+void ossim::BlockCache::clear()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_lru.clear();
+   m_index.clear();
+   m_bytes = 0;
+}
+
+void ossim::BlockCache::setMaxBytes(ossim_uint64 maxBytes)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_maxBytes = maxBytes;
+   trim();
+}
+
+ossim_uint64 ossim::BlockCache::getMaxBytes()const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_maxBytes;
+}
+
+ossim_uint64 ossim::BlockCache::getBytes()const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_bytes;
+}
+
+ossim_uint64 ossim::BlockCache::getHitCount()const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_hitCount;
+}
+
+ossim_uint64 ossim::BlockCache::getMissCount()const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_missCount;
+}
+
+void ossim::BlockCache::trim()
+{
+   while((m_bytes > m_maxBytes) && !m_lru.empty())
+   {
+      m_bytes -= m_lru.back().second->size();
+      m_index.erase(m_lru.back().first);
+      m_lru.pop_back();
+   }
+}
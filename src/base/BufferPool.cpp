@@ -0,0 +1,207 @@
+#include <ossim/base/BufferPool.h>
+#include <ostream>
+
+namespace ossim
+{
+   //---
+   // Per thread front of the pool.  Holds at most MAX_BUFFERS so a thread
+   // that only releases does not hoard memory other threads could reuse.
+   // Buffers from before the last flush are freed on the next use.
+   //---
+   struct BufferPoolLocalCache
+   {
+      static const ossim_uint32 MAX_BUFFERS = 8;
+
+      BufferPoolLocalCache():m_buffers(), m_count(0), m_generation(0){}
+      ~BufferPoolLocalCache()
+      {
+         BufferPool::instance()->returnToShared(*this);
+      }
+
+      BufferPool::SizeClassMap m_buffers;
+      ossim_uint32             m_count;
+      ossim_uint64             m_generation;
+   };
+}
+
+static thread_local ossim::BufferPoolLocalCache localCache;
+
+ossim::BufferPool* ossim::BufferPool::instance()
+{
+   static ossim::BufferPool pool;
+   return &pool;
+}
+
+ossim::BufferPool::BufferPool()
+:m_enabled(false),
+ m_maxBytes(256*1024*1024),
+ m_pooledBytes(0),
+ m_hitCount(0),
+ m_missCount(0),
+ m_dropCount(0),
+ m_generation(0),
+ m_mutex(),
+ m_sharedBuffers()
+{
+}
+
+bool ossim::BufferPool::acquire(Buffer& buffer, ossim_uint32 size)
+{
+   if(localCache.m_generation != m_generation) dropLocal(localCache);
+   if(!m_enabled || !size || !buffer.empty()) return false;
+
+   SizeClassMap::iterator iter = localCache.m_buffers.find(size);
+   if((iter != localCache.m_buffers.end()) && !iter->second.empty())
+   {
+      buffer.swap(iter->second.back());
+      iter->second.pop_back();
+      --localCache.m_count;
+   }
+   else
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      iter = m_sharedBuffers.find(size);
+      if((iter != m_sharedBuffers.end()) && !iter->second.empty())
+      {
+         buffer.swap(iter->second.back());
+         iter->second.pop_back();
+      }
+   }
+
+   if(buffer.empty())
+   {
+      ++m_missCount;
+      return false;
+   }
+   m_pooledBytes -= size;
+   ++m_hitCount;
+   return true;
+}
+
+void ossim::BufferPool::release(Buffer& buffer)
+{
+   if(localCache.m_generation != m_generation) dropLocal(localCache);
+   ossim_uint32 size = static_cast<ossim_uint32>(buffer.size());
+   if(!m_enabled || !size) return;
+
+   // Reserve the bytes first so concurrent releases can't overshoot the cap:
+   ossim_uint64 pooled = m_pooledBytes;
+   do
+   {
+      if((pooled + size) > m_maxBytes)
+      {
+         ++m_dropCount;
+         return;
+      }
+   } while(!m_pooledBytes.compare_exchange_weak(pooled, pooled + size));
+
+   if(localCache.m_count < BufferPoolLocalCache::MAX_BUFFERS)
+   {
+      std::vector<Buffer>& sizeClass = localCache.m_buffers[size];
+      sizeClass.push_back(Buffer());
+      sizeClass.back().swap(buffer);
+      ++localCache.m_count;
+   }
+   else
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      std::vector<Buffer>& sizeClass = m_sharedBuffers[size];
+      sizeClass.push_back(Buffer());
+      sizeClass.back().swap(buffer);
+   }
+}
+
+void ossim::BufferPool::setEnabled(bool flag)
+{
+   m_enabled = flag;
+   if(!flag)
+   {
+      flush();
+   }
+}
+
+bool ossim::BufferPool::getEnabled()const
+{
+   return m_enabled;
+}
+
+void ossim::BufferPool::setMaxBytes(ossim_uint64 maxBytes)
+{
+   m_maxBytes = maxBytes;
+}
+
+ossim_uint64 ossim::BufferPool::getMaxBytes()const
+{
+   return m_maxBytes;
+}
+
+void ossim::BufferPool::flush()
+{
+   SizeClassMap buffers;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      buffers.swap(m_sharedBuffers);
+      ++m_generation;
+   }
+   m_pooledBytes -= countBytes(buffers);
+
+   // The calling thread's own buffers go right away, the others' on next use:
+   dropLocal(localCache);
+}
+
+void ossim::BufferPool::returnToShared(BufferPoolLocalCache& cache)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if(cache.m_generation != m_generation)
+   {
+      // Flushed since these were pooled:
+      m_pooledBytes -= countBytes(cache.m_buffers);
+   }
+   else
+   {
+      SizeClassMap::iterator iter = cache.m_buffers.begin();
+      while(iter != cache.m_buffers.end())
+      {
+         std::vector<Buffer>& sizeClass = m_sharedBuffers[iter->first];
+         for(ossim_uint32 idx = 0; idx < iter->second.size(); ++idx)
+         {
+            sizeClass.push_back(Buffer());
+            sizeClass.back().swap(iter->second[idx]);
+         }
+         ++iter;
+      }
+   }
+   cache.m_buffers.clear();
+   cache.m_count = 0;
+}
+
+void ossim::BufferPool::dropLocal(BufferPoolLocalCache& cache)
+{
+   m_pooledBytes -= countBytes(cache.m_buffers);
+   cache.m_buffers.clear();
+   cache.m_count = 0;
+   cache.m_generation = m_generation;
+}
+
+ossim_uint64 ossim::BufferPool::countBytes(const SizeClassMap& buffers)
+{
+   ossim_uint64 bytes = 0;
+   SizeClassMap::const_iterator iter = buffers.begin();
+   while(iter != buffers.end())
+   {
+      bytes += static_cast<ossim_uint64>(iter->first)*iter->second.size();
+      ++iter;
+   }
+   return bytes;
+}
+
+std::ostream& ossim::BufferPool::print(std::ostream& out)const
+{
+   out << "BufferPool enabled = " << (m_enabled ? "true" : "false")
+       << " pooled_bytes = "      << m_pooledBytes
+       << " max_bytes = "         << m_maxBytes
+       << " hits = "              << m_hitCount
+       << " misses = "            << m_missCount
+       << " drops = "             << m_dropCount;
+   return out;
+}
@@ -0,0 +1,180 @@
+#include <ossim/base/GeoidGrid.h>
+#include <algorithm>
+
+const ossim_sint16 ossim::GeoidGrid::SINT16_NULL = -32768;
+
+ossim::GeoidGrid::GeoidGrid()
+   :  m_width(0),
+      m_height(0),
+      m_storage(FLOAT32_STORAGE),
+      m_resolution(0.01),
+      m_floatPosts(),
+      m_shortPosts()
+{
+}
+
+void ossim::GeoidGrid::create(ossim_uint32 width,
+                              ossim_uint32 height,
+                              Storage storage,
+                              double resolution)
+{
+   clear();
+   if((width < 2) || (height < 2)) return;
+
+   m_width      = width;
+   m_height     = height;
+   m_storage    = storage;
+   m_resolution = (resolution > 0.0) ? resolution : 0.01;
+
+   const ossim_uint64 POSTS = (ossim_uint64)width * height;
+   if(m_storage == SINT16_STORAGE)
+   {
+      m_shortPosts.assign(POSTS, SINT16_NULL);
+   }
+   else
+   {
+      m_floatPosts.assign(POSTS, ossim::nan());
+   }
+}
+
+void ossim::GeoidGrid::clear()
+{
+   m_width  = 0;
+   m_height = 0;
+   std::vector<ossim_float32>().swap(m_floatPosts);
+   std::vector<ossim_sint16>().swap(m_shortPosts);
+}
+
+ossim_uint64 ossim::GeoidGrid::getSizeInBytes()const
+{
+   return (ossim_uint64)m_floatPosts.size() * sizeof(ossim_float32) +
+          (ossim_uint64)m_shortPosts.size() * sizeof(ossim_sint16);
+}
+
+void ossim::GeoidGrid::setPost(ossim_uint64 index, double value, double nullValue)
+{
+   bool isNull = ossim::isnan(value) || (value == nullValue);
+   if(m_storage == SINT16_STORAGE)
+   {
+      if(isNull)
+      {
+         m_shortPosts[index] = SINT16_NULL;
+      }
+      else
+      {
+         double step = value / m_resolution;
+         step = std::max(-32767.0, std::min(32767.0, step));
+         m_shortPosts[index] = ossim::round<ossim_sint16>(step);
+      }
+   }
+   else
+   {
+      m_floatPosts[index] = isNull ? ossim::nan() : (ossim_float32)value;
+   }
+}
+
+double ossim::GeoidGrid::interpolate(double x, double y,
+                                     Interpolation interpolation)const
+{
+   double value = ossim::nan();
+
+   // Same test as rounding to the nearest post and checking it, nans fail:
+   if(m_width && (x > -0.5) && (y > -0.5) &&
+      (x < m_width - 0.5) && (y < m_height - 0.5))
+   {
+      ossim_int32 x0 = static_cast<ossim_int32>(x);
+      ossim_int32 y0 = static_cast<ossim_int32>(y);
+      if(x0 == static_cast<ossim_int32>(m_width - 1))
+      {
+         --x0; // Move over one point.
+      }
+      if(y0 == static_cast<ossim_int32>(m_height - 1))
+      {
+         --y0; // Move over one point.
+      }
+
+      if(interpolation == BICUBIC)
+      {
+         value = bicubic(x, y, x0, y0);
+      }
+      if(ossim::isnan(value))
+      {
+         value = bilinear(getPost(x0, y0),     getPost(x0 + 1, y0),
+                          getPost(x0, y0 + 1), getPost(x0 + 1, y0 + 1),
+                          x - x0, y - y0);
+      }
+   }
+
+   return value;
+}
+
+void ossim::GeoidGrid::interpolate(const double* x, const double* y,
+                                   ossim_uint32 count, double* values,
+                                   Interpolation interpolation)const
+{
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      values[i] = interpolate(x[i], y[i], interpolation);
+   }
+}
+
+double ossim::GeoidGrid::bilinear(double p00, double p01, double p10, double p11,
+                                  double xt, double yt)
+{
+   double w00 = (1.0 - xt) * (1.0 - yt);
+   double w01 = xt * (1.0 - yt);
+   double w10 = (1.0 - xt) * yt;
+   double w11 = xt * yt;
+
+   // Null posts get no weight:
+   if(ossim::isnan(p00)){ w00 = 0.0; p00 = 0.0; }
+   if(ossim::isnan(p01)){ w01 = 0.0; p01 = 0.0; }
+   if(ossim::isnan(p10)){ w10 = 0.0; p10 = 0.0; }
+   if(ossim::isnan(p11)){ w11 = 0.0; p11 = 0.0; }
+
+   double sumWeights = w00 + w01 + w10 + w11;
+   return sumWeights ? (p00*w00 + p01*w01 + p10*w10 + p11*w11) / sumWeights : ossim::nan();
+}
+
+double ossim::GeoidGrid::bicubic(double x, double y, ossim_int32 x0, ossim_int32 y0)const
+{
+   // Needs the full 4 x 4 neighborhood, inside the cell:
+   if((x0 < 1) || (y0 < 1) ||
+      (x0 + 2 >= static_cast<ossim_int32>(m_width)) ||
+      (y0 + 2 >= static_cast<ossim_int32>(m_height)) ||
+      (x < x0) || (y < y0))
+   {
+      return ossim::nan();
+   }
+
+   // Catmull-Rom weights of the posts at -1, 0, 1 and 2:
+   double wx[4];
+   double wy[4];
+   double t = x - x0;
+   wx[0] = ((-0.5 * t + 1.0) * t - 0.5) * t;
+   wx[1] = (1.5 * t - 2.5) * t * t + 1.0;
+   wx[2] = ((-1.5 * t + 2.0) * t + 0.5) * t;
+   wx[3] = (0.5 * t - 0.5) * t * t;
+   t = y - y0;
+   wy[0] = ((-0.5 * t + 1.0) * t - 0.5) * t;
+   wy[1] = (1.5 * t - 2.5) * t * t + 1.0;
+   wy[2] = ((-1.5 * t + 2.0) * t + 0.5) * t;
+   wy[3] = (0.5 * t - 0.5) * t * t;
+
+   double value = 0.0;
+   for(ossim_int32 row = 0; row < 4; ++row)
+   {
+      double rowValue = 0.0;
+      for(ossim_int32 col = 0; col < 4; ++col)
+      {
+         double post = getPost(x0 + col - 1, y0 + row - 1);
+         if(ossim::isnan(post))
+         {
+            return ossim::nan();
+         }
+         rowValue += wx[col] * post;
+      }
+      value += wy[row] * rowValue;
+   }
+   return value;
+}
@@ -0,0 +1,133 @@
+#include <ossim/base/MemoryMap.h>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+ossim::MemoryMap::MemoryMap()
+:m_data(0),
+ m_size(0),
+ m_filename()
+#if defined(_WIN32)
+ ,m_fileHandle(INVALID_HANDLE_VALUE),
+ m_mappingHandle(0)
+#endif
+{
+}
+
+ossim::MemoryMap::~MemoryMap()
+{
+   close();
+}
+
+bool ossim::MemoryMap::open(const std::string& file)
+{
+   close();
+   if(file.empty()) return false;
+
+#if defined(_WIN32)
+   HANDLE fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                   0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+   if(fileHandle == INVALID_HANDLE_VALUE) return false;
+
+   LARGE_INTEGER fileSize;
+   if(!GetFileSizeEx(fileHandle, &fileSize) || (fileSize.QuadPart < 1))
+   {
+      CloseHandle(fileHandle);
+      return false;
+   }
+   HANDLE mappingHandle = CreateFileMappingA(fileHandle, 0, PAGE_READONLY, 0, 0, 0);
+   if(!mappingHandle)
+   {
+      CloseHandle(fileHandle);
+      return false;
+   }
+   void* ptr = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+   if(!ptr)
+   {
+      CloseHandle(mappingHandle);
+      CloseHandle(fileHandle);
+      return false;
+   }
+   m_fileHandle    = fileHandle;
+   m_mappingHandle = mappingHandle;
+   m_size          = static_cast<ossim_uint64>(fileSize.QuadPart);
+#else
+   int fd = ::open(file.c_str(), O_RDONLY);
+   if(fd < 0) return false;
+
+   struct stat fileStat;
+   if((fstat(fd, &fileStat) != 0) || (fileStat.st_size < 1) || !S_ISREG(fileStat.st_mode))
+   {
+      ::close(fd);
+      return false;
+   }
+   void* ptr = mmap(0, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+   // The mapping holds its own reference to the file.
+   ::close(fd);
+   if(ptr == MAP_FAILED) return false;
+
+   m_size = static_cast<ossim_uint64>(fileStat.st_size);
+#endif
+
+   m_data     = static_cast<const ossim_uint8*>(ptr);
+   m_filename = file;
+
+   return true;
+}
+
+void ossim::MemoryMap::close()
+{
+   if(m_data)
+   {
+#if defined(_WIN32)
+      UnmapViewOfFile(m_data);
+      CloseHandle(m_mappingHandle);
+      CloseHandle(m_fileHandle);
+      m_mappingHandle = 0;
+      m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+      munmap(const_cast<ossim_uint8*>(m_data), m_size);
+#endif
+   }
+   m_data = 0;
+   m_size = 0;
+   m_filename.clear();
+}
+
+ossim_uint64 ossim::MemoryMap::residentBytes()const
+{
+   ossim_uint64 result = 0;
+#if !defined(_WIN32)
+   if(m_data)
+   {
+      ossim_uint64 pageSize  = static_cast<ossim_uint64>(sysconf(_SC_PAGESIZE));
+      ossim_uint64 pageCount = (m_size + pageSize - 1) / pageSize;
+#if defined(__APPLE__)
+      std::vector<char> pages(pageCount);
+#else
+      std::vector<unsigned char> pages(pageCount);
+#endif
+      if(mincore(const_cast<ossim_uint8*>(m_data), m_size, &pages.front()) == 0)
+      {
+         for(ossim_uint64 idx = 0; idx < pageCount; ++idx)
+         {
+            if(pages[idx] & 1)
+            {
+               result += pageSize;
+            }
+         }
+         if(result > m_size) result = m_size;
+      }
+   }
+#endif
+   return result;
+}
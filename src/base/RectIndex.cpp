@@ -0,0 +1,189 @@
+#include <ossim/base/RectIndex.h>
+#include <algorithm>
+#include <cmath>
+
+const ossim_uint32 ossim::RectIndex::NODE_SIZE = 16;
+
+namespace
+{
+   struct CenterXLess
+   {
+      template <class N> bool operator()(const N& a, const N& b)const
+      {
+         return ((ossim_int64)a.m_minX + a.m_maxX) < ((ossim_int64)b.m_minX + b.m_maxX);
+      }
+   };
+
+   struct CenterYLess
+   {
+      template <class N> bool operator()(const N& a, const N& b)const
+      {
+         return ((ossim_int64)a.m_minY + a.m_maxY) < ((ossim_int64)b.m_minY + b.m_maxY);
+      }
+   };
+
+   struct CollectIds
+   {
+      CollectIds(std::vector<ossim_uint32>& ids):m_ids(ids){}
+      void operator()(ossim_uint32 id){ m_ids.push_back(id); }
+      std::vector<ossim_uint32>& m_ids;
+   };
+
+   struct CountIds
+   {
+      CountIds():m_count(0){}
+      void operator()(ossim_uint32 /* id */){ ++m_count; }
+      ossim_uint32 m_count;
+   };
+}
+
+ossim::RectIndex::RectIndex()
+   :  m_levels(),
+      m_rects(),
+      m_size(0),
+      m_bounds()
+{
+   m_bounds.makeNan();
+}
+
+void ossim::RectIndex::build(const std::vector<ossimIrect>& rects)
+{
+   clear();
+   m_rects = rects;
+
+   std::vector<Node> level;
+   level.reserve(rects.size());
+   for(ossim_uint32 i = 0; i < rects.size(); ++i)
+   {
+      const ossimIrect& rect = rects[i];
+      if(rect.hasNans()) continue;
+
+      Node node;
+      node.m_minX  = std::min(rect.ul().x, rect.lr().x);
+      node.m_maxX  = std::max(rect.ul().x, rect.lr().x);
+      node.m_minY  = std::min(rect.ul().y, rect.lr().y);
+      node.m_maxY  = std::max(rect.ul().y, rect.lr().y);
+      node.m_first = i;
+      node.m_count = 0;
+      level.push_back(node);
+
+      m_bounds = m_bounds.hasNans() ? rect : m_bounds.combine(rect);
+   }
+   m_size = (ossim_uint32)level.size();
+   if(level.empty()) return;
+
+   while(true)
+   {
+      sortTiles(level);
+      m_levels.push_back(level);
+      if(level.size() == 1) break;
+
+      std::vector<Node> parents;
+      makeParents(m_levels.back(), parents);
+      level.swap(parents);
+   }
+}
+
+void ossim::RectIndex::clear()
+{
+   m_levels.clear();
+   m_rects.clear();
+   m_size = 0;
+   m_bounds.makeNan();
+}
+
+void ossim::RectIndex::query(const ossimIrect& rect, std::vector<ossim_uint32>& ids)const
+{
+   std::vector<ossim_uint32>::size_type start = ids.size();
+   CollectIds visitor(ids);
+   visit(rect, visitor);
+   std::sort(ids.begin() + start, ids.end());
+}
+
+ossim_uint32 ossim::RectIndex::count(const ossimIrect& rect)const
+{
+   CountIds visitor;
+   visit(rect, visitor);
+   return visitor.m_count;
+}
+
+void ossim::RectIndex::sortTiles(std::vector<Node>& level)
+{
+   if(level.size() <= NODE_SIZE) return;
+
+   // S vertical slices of S tiles each, S = ceil(sqrt(tiles)):
+   ossim_uint32 tiles = (ossim_uint32)((level.size() + NODE_SIZE - 1) / NODE_SIZE);
+   ossim_uint32 slices = (ossim_uint32)std::ceil(std::sqrt((double)tiles));
+   std::vector<Node>::size_type sliceSize = (std::vector<Node>::size_type)slices * NODE_SIZE;
+
+   std::sort(level.begin(), level.end(), CenterXLess());
+   for(std::vector<Node>::size_type start = 0; start < level.size(); start += sliceSize)
+   {
+      std::vector<Node>::size_type end = std::min(start + sliceSize, level.size());
+      std::sort(level.begin() + start, level.begin() + end, CenterYLess());
+   }
+}
+
+void ossim::RectIndex::makeParents(const std::vector<Node>& level, std::vector<Node>& parents)
+{
+   parents.clear();
+   parents.reserve((level.size() + NODE_SIZE - 1) / NODE_SIZE);
+   for(std::vector<Node>::size_type start = 0; start < level.size(); start += NODE_SIZE)
+   {
+      std::vector<Node>::size_type end = std::min(start + (std::vector<Node>::size_type)NODE_SIZE,
+                                                  level.size());
+      Node parent = level[start];
+      for(std::vector<Node>::size_type i = start + 1; i < end; ++i)
+      {
+         parent.m_minX = std::min(parent.m_minX, level[i].m_minX);
+         parent.m_minY = std::min(parent.m_minY, level[i].m_minY);
+         parent.m_maxX = std::max(parent.m_maxX, level[i].m_maxX);
+         parent.m_maxY = std::max(parent.m_maxY, level[i].m_maxY);
+      }
+      parent.m_first = (ossim_uint32)start;
+      parent.m_count = (ossim_uint32)(end - start);
+      parents.push_back(parent);
+   }
+}
+
+template <class Visitor>
+void ossim::RectIndex::visit(const ossimIrect& rect, Visitor& visitor)const
+{
+   if(m_levels.empty() || rect.hasNans()) return;
+
+   ossim_int32 minX = std::min(rect.ul().x, rect.lr().x);
+   ossim_int32 maxX = std::max(rect.ul().x, rect.lr().x);
+   ossim_int32 minY = std::min(rect.ul().y, rect.lr().y);
+   ossim_int32 maxY = std::max(rect.ul().y, rect.lr().y);
+
+   // Pending (level, first node, node count) ranges:
+   struct Range{ ossim_uint32 level; ossim_uint32 first; ossim_uint32 count; };
+   std::vector<Range> stack;
+   Range root = { (ossim_uint32)m_levels.size() - 1, 0, 1 };
+   stack.push_back(root);
+   while(!stack.empty())
+   {
+      Range range = stack.back();
+      stack.pop_back();
+      const std::vector<Node>& level = m_levels[range.level];
+      for(ossim_uint32 i = range.first; i < range.first + range.count; ++i)
+      {
+         const Node& node = level[i];
+         if((node.m_minX > maxX) || (node.m_maxX < minX) ||
+            (node.m_minY > maxY) || (node.m_maxY < minY))
+         {
+            continue;
+         }
+         if(range.level)
+         {
+            Range child = { range.level - 1, node.m_first, node.m_count };
+            stack.push_back(child);
+         }
+         else if(m_rects[node.m_first].intersects(rect))
+         {
+            // Final test by ossimIrect itself so orientation rules match.
+            visitor(node.m_first);
+         }
+      }
+   }
+}
@@ -0,0 +1,559 @@
+#include <ossim/base/SharedBlockStreamBuffer.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <algorithm>
+#include <cstring> /* for memcpy */
+
+static ossimTrace traceDebug("SharedBlockStreamBuffer:debug");
+
+const ossim_uint32 ossim::BlockSource::DEFAULT_MAX_STREAMS = 4;
+const ossim_int64  ossim::BlockSource::MAX_RUN_BLOCKS = 16;
+
+namespace
+{
+   typedef std::pair<std::string, ossim_uint64> SourceKey;
+
+   std::mutex& sourcesMutex()
+   {
+      static std::mutex mutex;
+      return mutex;
+   }
+
+   std::map<SourceKey, std::weak_ptr<ossim::BlockSource> >& sources()
+   {
+      static std::map<SourceKey, std::weak_ptr<ossim::BlockSource> > sourceMap;
+      return sourceMap;
+   }
+}
+
+std::shared_ptr<ossim::BlockSource> ossim::BlockSource::get(const std::string& url,
+                                                            ossim_uint64 blockSize,
+                                                            std::shared_ptr<ossim::istream> stream,
+                                                            const Opener& opener,
+                                                            ossim_uint32 maxStreams)
+{
+   std::shared_ptr<BlockSource> result;
+   if(!blockSize || (!stream && !opener)) return result;
+
+   std::lock_guard<std::mutex> lock(sourcesMutex());
+   std::map<SourceKey, std::weak_ptr<BlockSource> >& sourceMap = sources();
+
+   // Drop the sources nobody reads any more:
+   for(std::map<SourceKey, std::weak_ptr<BlockSource> >::iterator iter = sourceMap.begin();
+       iter != sourceMap.end();)
+   {
+      if(iter->second.expired())
+      {
+         sourceMap.erase(iter++);
+      }
+      else
+      {
+         ++iter;
+      }
+   }
+
+   SourceKey key(url, blockSize);
+   std::map<SourceKey, std::weak_ptr<BlockSource> >::iterator iter = sourceMap.find(key);
+   if(iter != sourceMap.end())
+   {
+      result = iter->second.lock();
+   }
+   if(result)
+   {
+      // Keep the caller's stream if the source has room for it:
+      if(stream)
+      {
+         std::lock_guard<std::mutex> sourceLock(result->m_mutex);
+         if(result->m_openStreams < result->m_maxStreams)
+         {
+            ++result->m_openStreams;
+            result->m_idleStreams.push_back(stream);
+            result->m_streamCondition.notify_one();
+         }
+      }
+   }
+   else
+   {
+      //---
+      // Nobody has the url open, so it may have been rewritten since its
+      // blocks were cached.  Start over rather than serve stale bytes.
+      //---
+      BlockCache::instance()->erase(url);
+      result.reset(new BlockSource(url, blockSize, stream, opener, maxStreams));
+      sourceMap[key] = result;
+   }
+   return result;
+}
+
+ossim::BlockSource::BlockSource(const std::string& url,
+                                ossim_uint64 blockSize,
+                                std::shared_ptr<ossim::istream> stream,
+                                const Opener& opener,
+                                ossim_uint32 maxStreams)
+   :  m_url(url),
+      m_blockSize(blockSize),
+      m_opener(opener),
+      m_maxStreams(std::max<ossim_uint32>(1, maxStreams)),
+      m_mutex(),
+      m_streamCondition(),
+      m_idleStreams(),
+      m_openStreams(0),
+      m_size(-1),
+      m_promises(),
+      m_pending()
+{
+   if(stream)
+   {
+      m_idleStreams.push_back(stream);
+      m_openStreams = 1;
+   }
+}
+
+ossim::BlockSource::~BlockSource()
+{
+}
+
+ossim::BlockSource::BlockPtr ossim::BlockSource::getBlock(ossim_int64 blockIndex)
+{
+   std::vector<BlockPtr> blocks;
+   getBlocks(blockIndex, 1, blocks);
+   return blocks[0];
+}
+
+void ossim::BlockSource::getBlocks(ossim_int64 firstBlock,
+                                   ossim_int64 count,
+                                   std::vector<BlockPtr>& blocks)
+{
+   std::vector<PendingBlock> pending;
+   std::vector< std::pair<ossim_int64, ossim_int64> > runs;
+   claimBlocks(firstBlock, count, blocks, pending, runs);
+
+   // First run on this thread, the others on the pool:
+   if(!runs.empty())
+   {
+      ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+      std::vector< std::future<void> > fetches;
+      for(ossim_uint32 idx = 1; idx < runs.size(); ++idx)
+      {
+         std::pair<ossim_int64, ossim_int64> run = runs[idx];
+         fetches.push_back(pool->async([this, run](){ fetchRun(run.first, run.second); }));
+      }
+      fetchRun(runs[0].first, runs[0].second);
+      for(ossim_uint32 idx = 0; idx < fetches.size(); ++idx)
+      {
+         pool->wait(fetches[idx]);
+      }
+   }
+
+   for(ossim_int64 idx = 0; idx < count; ++idx)
+   {
+      if(!blocks[idx] && pending[idx].valid())
+      {
+         blocks[idx] = waitFor(pending[idx]);
+      }
+   }
+}
+
+void ossim::BlockSource::prefetch(ossim_int64 firstBlock, ossim_int64 count)
+{
+   std::vector<BlockPtr> blocks;
+   std::vector<PendingBlock> pending;
+   std::vector< std::pair<ossim_int64, ossim_int64> > runs;
+   claimBlocks(firstBlock, count, blocks, pending, runs);
+
+   std::shared_ptr<BlockSource> self = shared_from_this();
+   for(ossim_uint32 idx = 0; idx < runs.size(); ++idx)
+   {
+      std::pair<ossim_int64, ossim_int64> run = runs[idx];
+      ossim::ThreadPool::instance()->submit([self, run](){ self->fetchRun(run.first, run.second); });
+   }
+}
+
+ossim_int64 ossim::BlockSource::getSize()
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(m_size >= 0) return m_size;
+   }
+
+   ossim_int64 size = -1;
+   std::shared_ptr<ossim::istream> stream = acquireStream();
+   if(stream)
+   {
+      stream->clear();
+      stream->seekg(0, std::ios_base::end);
+      size = stream->tellg();
+      releaseStream(stream);
+   }
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if(size >= 0) m_size = size;
+   return m_size;
+}
+
+void ossim::BlockSource::claimBlocks(ossim_int64 firstBlock,
+                                     ossim_int64 count,
+                                     std::vector<BlockPtr>& blocks,
+                                     std::vector<PendingBlock>& pending,
+                                     std::vector< std::pair<ossim_int64, ossim_int64> >& runs)
+{
+   blocks.assign(std::max<ossim_int64>(0, count), BlockPtr());
+   pending.assign(blocks.size(), PendingBlock());
+   runs.clear();
+
+   BlockCache* cache = BlockCache::instance();
+   std::lock_guard<std::mutex> lock(m_mutex);
+   for(ossim_int64 idx = 0; idx < count; ++idx)
+   {
+      ossim_int64 blockIndex = firstBlock + idx;
+      if((blockIndex < 0) ||
+         ((m_size >= 0) && (blockIndex*static_cast<ossim_int64>(m_blockSize) >= m_size)))
+      {
+         continue;
+      }
+
+      blocks[idx] = cache->find(m_url, m_blockSize, blockIndex);
+      if(blocks[idx]) continue;
+
+      std::map<ossim_int64, PendingBlock>::iterator iter = m_pending.find(blockIndex);
+      if(iter != m_pending.end())
+      {
+         pending[idx] = iter->second;
+         continue;
+      }
+
+      // Nobody has it, claim it:
+      std::shared_ptr< std::promise<BlockPtr> > promise = std::make_shared< std::promise<BlockPtr> >();
+      m_promises[blockIndex] = promise;
+      pending[idx] = m_pending[blockIndex] = promise->get_future().share();
+      if(!runs.empty() &&
+         (runs.back().first + runs.back().second == blockIndex) &&
+         (runs.back().second < MAX_RUN_BLOCKS))
+      {
+         ++runs.back().second;
+      }
+      else
+      {
+         runs.push_back(std::make_pair(blockIndex, static_cast<ossim_int64>(1)));
+      }
+   }
+}
+
+void ossim::BlockSource::fetchRun(ossim_int64 firstBlock, ossim_int64 count)
+{
+   std::vector<BlockPtr> results(count);
+   ossim_int64 size = -1;
+
+   std::shared_ptr<ossim::istream> stream = acquireStream();
+   if(stream)
+   {
+      try
+      {
+         // One seek, then the blocks back to back straight into their buffers:
+         stream->clear();
+         stream->seekg(firstBlock*static_cast<ossim_int64>(m_blockSize));
+         for(ossim_int64 idx = 0; (idx < count) && stream->good(); ++idx)
+         {
+            std::shared_ptr< std::vector<char> > block =
+               std::make_shared< std::vector<char> >(m_blockSize);
+            stream->read(&block->front(), m_blockSize);
+            ossim_int64 bytesRead = stream->gcount();
+            if(bytesRead > 0)
+            {
+               block->resize(bytesRead);
+               results[idx] = block;
+            }
+            if(bytesRead < static_cast<ossim_int64>(m_blockSize))
+            {
+               if(!stream->bad())
+               {
+                  size = (firstBlock + idx)*static_cast<ossim_int64>(m_blockSize) +
+                         std::max<ossim_int64>(0, bytesRead);
+               }
+               break;
+            }
+         }
+      }
+      catch(const std::exception& e)
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "BlockSource::fetchRun WARNING: " << e.what() << " reading " << m_url << "\n";
+         stream->setstate(std::ios_base::badbit);
+      }
+      releaseStream(stream);
+   }
+
+   BlockCache* cache = BlockCache::instance();
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if(size >= 0) m_size = size;
+   for(ossim_int64 idx = 0; idx < count; ++idx)
+   {
+      ossim_int64 blockIndex = firstBlock + idx;
+      if(results[idx])
+      {
+         cache->insert(m_url, m_blockSize, blockIndex, results[idx]);
+      }
+      std::map<ossim_int64, std::shared_ptr< std::promise<BlockPtr> > >::iterator iter =
+         m_promises.find(blockIndex);
+      if(iter != m_promises.end())
+      {
+         iter->second->set_value(results[idx]);
+         m_promises.erase(iter);
+      }
+      m_pending.erase(blockIndex);
+   }
+}
+
+std::shared_ptr<ossim::istream> ossim::BlockSource::acquireStream()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while(true)
+   {
+      if(!m_idleStreams.empty())
+      {
+         std::shared_ptr<ossim::istream> stream = m_idleStreams.back();
+         m_idleStreams.pop_back();
+         return stream;
+      }
+      if(m_opener && (m_openStreams < m_maxStreams))
+      {
+         ++m_openStreams;
+         lock.unlock();
+         std::shared_ptr<ossim::istream> stream = m_opener();
+         lock.lock();
+         if(stream) return stream;
+
+         // Could not open another, make do with the ones we have:
+         --m_openStreams;
+         m_maxStreams = std::max<ossim_uint32>(1, m_openStreams);
+         if(traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << "BlockSource::acquireStream DEBUG: could not open " << m_url
+               << ", limited to " << m_maxStreams << " streams\n";
+         }
+      }
+      if(m_openStreams == 0) return std::shared_ptr<ossim::istream>();
+      m_streamCondition.wait(lock);
+   }
+}
+
+void ossim::BlockSource::releaseStream(std::shared_ptr<ossim::istream> stream)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if(stream->bad())
+   {
+      --m_openStreams;
+   }
+   else
+   {
+      m_idleStreams.push_back(stream);
+   }
+   m_streamCondition.notify_one();
+}
+
+ossim::BlockSource::BlockPtr ossim::BlockSource::waitFor(PendingBlock& pending)
+{
+   // Keep the pool busy while waiting, the fetch may be queued behind us:
+   ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+   while(pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+   {
+      if(!pool->runPendingTask())
+      {
+         pending.wait_for(std::chrono::microseconds(100));
+      }
+   }
+   return pending.get();
+}
+
+ossim::SharedBlockStreamBuffer::SharedBlockStreamBuffer(std::shared_ptr<BlockSource> source)
+   :  m_source(source),
+      m_block(),
+      m_blockStart(0),
+      m_currentPosValue(0)
+{
+   setg(0, 0, 0);
+}
+
+ossim::SharedBlockStreamBuffer::BlockPtr ossim::SharedBlockStreamBuffer::getBlock(ossim_int64 pos)
+{
+   if(!m_source || (pos < 0)) return BlockPtr();
+   return m_source->getBlock(pos/static_cast<ossim_int64>(m_source->getBlockSize()));
+}
+
+void ossim::SharedBlockStreamBuffer::getBlocks(ossim_int64 pos,
+                                               ossim_int64 size,
+                                               std::vector<BlockPtr>& blocks)
+{
+   blocks.clear();
+   if(!m_source || (pos < 0) || (size <= 0)) return;
+   ossim_int64 blockSize = m_source->getBlockSize();
+   ossim_int64 firstBlock = pos/blockSize;
+   ossim_int64 lastBlock  = (pos + size - 1)/blockSize;
+   m_source->getBlocks(firstBlock, lastBlock - firstBlock + 1, blocks);
+}
+
+void ossim::SharedBlockStreamBuffer::prefetch(ossim_int64 pos, ossim_int64 size)
+{
+   if(!m_source || (pos < 0) || (size <= 0)) return;
+   ossim_int64 blockSize = m_source->getBlockSize();
+   ossim_int64 firstBlock = pos/blockSize;
+   ossim_int64 lastBlock  = (pos + size - 1)/blockSize;
+   m_source->prefetch(firstBlock, lastBlock - firstBlock + 1);
+}
+
+void ossim::SharedBlockStreamBuffer::setgPtrs()
+{
+   if(m_block &&
+      (m_currentPosValue >= m_blockStart) &&
+      (m_currentPosValue < m_blockStart + static_cast<ossim_int64>(m_block->size())))
+   {
+      // The get area is never written through, only read.
+      char* base = const_cast<char*>(&m_block->front());
+      setg(base,
+           base + (m_currentPosValue - m_blockStart),
+           base + m_block->size());
+   }
+   else
+   {
+      setg(0, 0, 0);
+   }
+}
+
+void ossim::SharedBlockStreamBuffer::loadBlock()
+{
+   if(m_currentPosValue < 0) m_currentPosValue = 0;
+   ossim_int64 blockSize = m_source->getBlockSize();
+   ossim_int64 blockIndex = m_currentPosValue/blockSize;
+   m_block = m_source->getBlock(blockIndex);
+   m_blockStart = blockIndex*blockSize;
+   setgPtrs();
+}
+
+void ossim::SharedBlockStreamBuffer::syncCurrentPosition()
+{
+   if(m_block && gptr())
+   {
+      m_currentPosValue = m_blockStart + (gptr() - eback());
+   }
+}
+
+std::streambuf::pos_type ossim::SharedBlockStreamBuffer::seekoff(
+   off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode mode)
+{
+   syncCurrentPosition();
+   pos_type result = pos_type(off_type(-1));
+   if(m_source)
+   {
+      switch(dir)
+      {
+         case std::ios_base::beg:
+         {
+            result = seekpos(offset, mode);
+            break;
+         }
+         case std::ios_base::cur:
+         {
+            result = seekpos(m_currentPosValue + offset, mode);
+            break;
+         }
+         case std::ios_base::end:
+         {
+            ossim_int64 size = m_source->getSize();
+            if(size >= 0)
+            {
+               result = seekpos(size + offset, mode);
+            }
+            break;
+         }
+         default:
+         {
+            break;
+         }
+      }
+   }
+   return result;
+}
+
+std::streambuf::pos_type ossim::SharedBlockStreamBuffer::seekpos(pos_type pos,
+                                                                 std::ios_base::openmode /* mode */)
+{
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "SharedBlockStreamBuffer::seekpos DEBUG: absolute position: " << pos << "\n";
+   }
+   if(!m_source || (static_cast<ossim_int64>(pos) < 0))
+   {
+      return pos_type(off_type(-1));
+   }
+
+   // Only moves the get area, the block is fetched on the next read.
+   m_currentPosValue = pos;
+   setgPtrs();
+   return pos;
+}
+
+std::streamsize ossim::SharedBlockStreamBuffer::xsgetn(char_type* s, std::streamsize n)
+{
+   if(!m_source || (n <= 0)) return 0;
+   syncCurrentPosition();
+   if(m_currentPosValue < 0) m_currentPosValue = 0;
+
+   // Fetch every block the read spans at once so the misses go out together:
+   ossim_int64 blockSize  = m_source->getBlockSize();
+   ossim_int64 firstBlock = m_currentPosValue/blockSize;
+   ossim_int64 lastBlock  = (m_currentPosValue + n - 1)/blockSize;
+   std::vector<BlockPtr> blocks;
+   if(lastBlock > firstBlock)
+   {
+      m_source->getBlocks(firstBlock, lastBlock - firstBlock + 1, blocks);
+   }
+
+   ossim_int64 bytesRead = 0;
+   while(bytesRead < n)
+   {
+      ossim_int64 blockIndex = m_currentPosValue/blockSize;
+      if(blocks.empty())
+      {
+         if(!m_block || (m_blockStart != blockIndex*blockSize))
+         {
+            loadBlock();
+         }
+      }
+      else
+      {
+         m_block = blocks[blockIndex - firstBlock];
+         m_blockStart = blockIndex*blockSize;
+      }
+      if(!m_block) break;
+
+      ossim_int64 offset = m_currentPosValue - m_blockStart;
+      ossim_int64 available = static_cast<ossim_int64>(m_block->size()) - offset;
+      if(available <= 0) break;
+
+      ossim_int64 bytes = std::min<ossim_int64>(available, n - bytesRead);
+      std::memcpy(s + bytesRead, &m_block->front() + offset, bytes);
+      bytesRead += bytes;
+      m_currentPosValue += bytes;
+   }
+   setgPtrs();
+   return bytesRead;
+}
+
+int ossim::SharedBlockStreamBuffer::underflow()
+{
+   if(!m_source) return EOF;
+   syncCurrentPosition();
+   setgPtrs();
+   if(!gptr())
+   {
+      loadBlock();
+   }
+   if(!gptr() || (gptr() == egptr()))
+   {
+      return EOF;
+   }
+   return (int)static_cast<ossim_uint8>(*gptr());
+}
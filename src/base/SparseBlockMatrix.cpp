@@ -0,0 +1,591 @@
+#include <ossim/base/SparseBlockMatrix.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+namespace
+{
+   // c += alpha * op(a) * op(b), op(a) m x k, op(b) k x n, all row major.
+   void multiplyAdd(double alpha,
+                    const double* a, bool transA,
+                    const double* b, bool transB,
+                    double* c, ossim_uint32 m, ossim_uint32 n, ossim_uint32 k)
+   {
+      for(ossim_uint32 i = 0; i < m; ++i)
+      {
+         for(ossim_uint32 j = 0; j < n; ++j)
+         {
+            double sum = 0.0;
+            for(ossim_uint32 p = 0; p < k; ++p)
+            {
+               sum += (transA ? a[p * m + i] : a[i * k + p]) *
+                      (transB ? b[j * k + p] : b[p * n + j]);
+            }
+            c[i * n + j] += alpha * sum;
+         }
+      }
+   }
+
+   // Lower Cholesky factor of the n x n a in place, upper part zeroed.
+   bool cholesky(double* a, ossim_uint32 n)
+   {
+      for(ossim_uint32 j = 0; j < n; ++j)
+      {
+         double d = a[j * n + j];
+         for(ossim_uint32 k = 0; k < j; ++k)
+         {
+            d -= a[j * n + k] * a[j * n + k];
+         }
+         if(!(d > 0.0)) return false;
+         d = std::sqrt(d);
+         a[j * n + j] = d;
+         for(ossim_uint32 i = j + 1; i < n; ++i)
+         {
+            double s = a[i * n + j];
+            for(ossim_uint32 k = 0; k < j; ++k)
+            {
+               s -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = s / d;
+         }
+         for(ossim_uint32 i = 0; i < j; ++i)
+         {
+            a[i * n + j] = 0.0;
+         }
+      }
+      return true;
+   }
+
+   // x = inverse(l) * x for lower triangular l.
+   void solveLower(const double* l, ossim_uint32 n, double* x)
+   {
+      for(ossim_uint32 i = 0; i < n; ++i)
+      {
+         double s = x[i];
+         for(ossim_uint32 k = 0; k < i; ++k)
+         {
+            s -= l[i * n + k] * x[k];
+         }
+         x[i] = s / l[i * n + i];
+      }
+   }
+
+   // x = inverse(l') * x for lower triangular l.
+   void solveLowerTransposed(const double* l, ossim_uint32 n, double* x)
+   {
+      for(ossim_uint32 i = n; i-- > 0; )
+      {
+         double s = x[i];
+         for(ossim_uint32 k = i + 1; k < n; ++k)
+         {
+            s -= l[k * n + i] * x[k];
+         }
+         x[i] = s / l[i * n + i];
+      }
+   }
+
+   void transpose(const double* a, ossim_uint32 rows, ossim_uint32 cols, double* out)
+   {
+      for(ossim_uint32 i = 0; i < rows; ++i)
+      {
+         for(ossim_uint32 j = 0; j < cols; ++j)
+         {
+            out[j * rows + i] = a[i * cols + j];
+         }
+      }
+   }
+
+   double dot(const std::vector<double>& a, const std::vector<double>& b)
+   {
+      double sum = 0.0;
+      for(std::vector<double>::size_type i = 0; i < a.size(); ++i)
+      {
+         sum += a[i] * b[i];
+      }
+      return sum;
+   }
+}
+
+ossim::SparseBlockMatrix::Statistics::Statistics()
+   :  m_blocks(0),
+      m_entries(0),
+      m_factorBlocks(0),
+      m_factorEntries(0),
+      m_iterations(0),
+      m_residual(0.0)
+{
+}
+
+ossim::SparseBlockMatrix::SparseBlockMatrix()
+   :  m_sizes(),
+      m_offsets(),
+      m_rank(0),
+      m_columns(),
+      m_perm(),
+      m_iperm(),
+      m_factor(),
+      m_inverse(),
+      m_statistics()
+{
+}
+
+void ossim::SparseBlockMatrix::create(const std::vector<ossim_uint32>& blockSizes)
+{
+   clear();
+   m_sizes = blockSizes;
+   m_offsets.resize(m_sizes.size());
+   for(ossim_uint32 i = 0; i < m_sizes.size(); ++i)
+   {
+      m_offsets[i] = m_rank;
+      m_rank += m_sizes[i];
+   }
+   m_columns.resize(m_sizes.size());
+}
+
+void ossim::SparseBlockMatrix::clear()
+{
+   m_sizes.clear();
+   m_offsets.clear();
+   m_rank = 0;
+   m_columns.clear();
+   m_perm.clear();
+   m_iperm.clear();
+   m_factor.clear();
+   m_inverse.clear();
+   m_statistics = Statistics();
+}
+
+double* ossim::SparseBlockMatrix::block(ossim_uint32 i, ossim_uint32 k)
+{
+   m_factor.clear();
+   m_inverse.clear();
+
+   std::vector<double>& values = m_columns[k][i];
+   if(values.empty())
+   {
+      values.assign((std::vector<double>::size_type)m_sizes[i] * m_sizes[k], 0.0);
+      ++m_statistics.m_blocks;
+      m_statistics.m_entries += values.size();
+   }
+   return values.empty() ? 0 : &values.front();
+}
+
+const double* ossim::SparseBlockMatrix::findBlock(ossim_uint32 i, ossim_uint32 k)const
+{
+   Column::const_iterator iter = m_columns[k].find(i);
+   return ((iter != m_columns[k].end()) && !iter->second.empty()) ? &iter->second.front() : 0;
+}
+
+void ossim::SparseBlockMatrix::multiply(const double* x, double* y)const
+{
+   std::fill(y, y + m_rank, 0.0);
+   for(ossim_uint32 k = 0; k < m_columns.size(); ++k)
+   {
+      const double* xk = x + m_offsets[k];
+      double*       yk = y + m_offsets[k];
+      Column::const_iterator iter = m_columns[k].begin();
+      for( ; iter != m_columns[k].end(); ++iter)
+      {
+         if(iter->second.empty()) continue;
+         ossim_uint32 i = iter->first;
+         const double* a = &iter->second.front();
+         multiplyAdd(1.0, a, false, xk, false, y + m_offsets[i], m_sizes[i], 1, m_sizes[k]);
+         if(i != k)
+         {
+            multiplyAdd(1.0, a, true, x + m_offsets[i], false, yk, m_sizes[k], 1, m_sizes[i]);
+         }
+      }
+   }
+}
+
+void ossim::SparseBlockMatrix::order(std::vector< std::vector<ossim_uint32> >& structure)
+{
+   const ossim_uint32 N = getNumberOfBlocks();
+   std::vector< std::set<ossim_uint32> > adjacent(N);
+   for(ossim_uint32 k = 0; k < N; ++k)
+   {
+      Column::const_iterator iter = m_columns[k].begin();
+      for( ; iter != m_columns[k].end(); ++iter)
+      {
+         if((iter->first != k) && !iter->second.empty())
+         {
+            adjacent[k].insert(iter->first);
+            adjacent[iter->first].insert(k);
+         }
+      }
+   }
+
+   // Eliminate the block of fewest neighbors first, ties by index:
+   typedef std::pair<ossim_uint32, ossim_uint32> Degree;
+   std::set<Degree> queue;
+   for(ossim_uint32 v = 0; v < N; ++v)
+   {
+      queue.insert(Degree((ossim_uint32)adjacent[v].size(), v));
+   }
+
+   m_perm.resize(N);
+   m_iperm.resize(N);
+   std::vector< std::vector<ossim_uint32> > neighbors(N);
+   for(ossim_uint32 step = 0; step < N; ++step)
+   {
+      ossim_uint32 v = queue.begin()->second;
+      queue.erase(queue.begin());
+      m_perm[step] = v;
+      m_iperm[v]   = step;
+
+      // The remaining neighbors of v become the rows of L below it, and a
+      // clique once v is gone:
+      neighbors[step].assign(adjacent[v].begin(), adjacent[v].end());
+      std::set<ossim_uint32>::const_iterator u = adjacent[v].begin();
+      for( ; u != adjacent[v].end(); ++u)
+      {
+         queue.erase(Degree((ossim_uint32)adjacent[*u].size(), *u));
+         adjacent[*u].erase(v);
+         std::set<ossim_uint32>::const_iterator w = adjacent[v].begin();
+         for( ; w != adjacent[v].end(); ++w)
+         {
+            if(*w != *u) adjacent[*u].insert(*w);
+         }
+         queue.insert(Degree((ossim_uint32)adjacent[*u].size(), *u));
+      }
+      std::set<ossim_uint32>().swap(adjacent[v]);
+   }
+
+   structure.assign(N, std::vector<ossim_uint32>());
+   for(ossim_uint32 j = 0; j < N; ++j)
+   {
+      for(ossim_uint32 n = 0; n < neighbors[j].size(); ++n)
+      {
+         structure[j].push_back(m_iperm[neighbors[j][n]]);
+      }
+      std::sort(structure[j].begin(), structure[j].end());
+   }
+}
+
+bool ossim::SparseBlockMatrix::factor()
+{
+   m_factor.clear();
+   m_inverse.clear();
+   m_statistics.m_factorBlocks  = 0;
+   m_statistics.m_factorEntries = 0;
+
+   const ossim_uint32 N = getNumberOfBlocks();
+   if(!N) return true;
+
+   std::vector< std::vector<ossim_uint32> > structure;
+   order(structure);
+
+   // Symbolic: every block of L, zero.
+   std::vector<Column> factor(N);
+   for(ossim_uint32 j = 0; j < N; ++j)
+   {
+      const ossim_uint32 BJ = m_sizes[m_perm[j]];
+      factor[j][j].assign((std::vector<double>::size_type)BJ * BJ, 0.0);
+      for(ossim_uint32 n = 0; n < structure[j].size(); ++n)
+      {
+         ossim_uint32 r = structure[j][n];
+         factor[j][r].assign((std::vector<double>::size_type)m_sizes[m_perm[r]] * BJ, 0.0);
+      }
+      m_statistics.m_factorBlocks += (ossim_uint32)factor[j].size();
+   }
+
+   // Scatter A into the permuted lower triangle:
+   for(ossim_uint32 k = 0; k < N; ++k)
+   {
+      Column::const_iterator iter = m_columns[k].begin();
+      for( ; iter != m_columns[k].end(); ++iter)
+      {
+         if(iter->second.empty()) continue;
+         ossim_uint32 i  = iter->first;
+         ossim_uint32 ni = m_iperm[i];
+         ossim_uint32 nk = m_iperm[k];
+         if(ni >= nk)
+         {
+            std::copy(iter->second.begin(), iter->second.end(), factor[nk][ni].begin());
+         }
+         else
+         {
+            transpose(&iter->second.front(), m_sizes[i], m_sizes[k], &factor[ni][nk].front());
+         }
+      }
+   }
+
+   // Numeric, right looking:
+   for(ossim_uint32 j = 0; j < N; ++j)
+   {
+      const ossim_uint32 BJ = m_sizes[m_perm[j]];
+      Column& column = factor[j];
+      Column::iterator diagonal = column.begin();
+      double* ljj = &diagonal->second.front();
+      if(!cholesky(ljj, BJ)) return false;
+
+      // L(r, j) = A(r, j) * inverse(L(j, j))'
+      Column::iterator r = diagonal;
+      for(++r; r != column.end(); ++r)
+      {
+         const ossim_uint32 BR = m_sizes[m_perm[r->first]];
+         for(ossim_uint32 row = 0; row < BR; ++row)
+         {
+            solveLower(ljj, BJ, &r->second[row * BJ]);
+         }
+      }
+
+      // A(r, s) -= L(r, j) * L(s, j)' for j < s <= r
+      for(r = diagonal, ++r; r != column.end(); ++r)
+      {
+         const ossim_uint32 BR = m_sizes[m_perm[r->first]];
+         Column::iterator s = diagonal;
+         for(++s; s != column.end() && (s->first <= r->first); ++s)
+         {
+            const ossim_uint32 BS = m_sizes[m_perm[s->first]];
+            std::vector<double>& target = factor[s->first][r->first];
+            multiplyAdd(-1.0, &r->second.front(), false, &s->second.front(), true,
+                        &target.front(), BR, BS, BJ);
+         }
+      }
+   }
+
+   m_factor.swap(factor);
+   for(ossim_uint32 j = 0; j < N; ++j)
+   {
+      Column::const_iterator iter = m_factor[j].begin();
+      for( ; iter != m_factor[j].end(); ++iter)
+      {
+         m_statistics.m_factorEntries += iter->second.size();
+      }
+   }
+   return true;
+}
+
+bool ossim::SparseBlockMatrix::solve(const double* b, double* x)const
+{
+   if(!isFactored()) return false;
+
+   const ossim_uint32 N = getNumberOfBlocks();
+   std::vector<double> y(b, b + m_rank);
+
+   // L * z = b
+   for(ossim_uint32 j = 0; j < N; ++j)
+   {
+      const ossim_uint32 BJ = m_sizes[m_perm[j]];
+      double* yj = &y[m_offsets[m_perm[j]]];
+      Column::const_iterator iter = m_factor[j].begin();
+      solveLower(&iter->second.front(), BJ, yj);
+      for(++iter; iter != m_factor[j].end(); ++iter)
+      {
+         ossim_uint32 r = m_perm[iter->first];
+         multiplyAdd(-1.0, &iter->second.front(), false, yj, false,
+                     &y[m_offsets[r]], m_sizes[r], 1, BJ);
+      }
+   }
+
+   // L' * x = z
+   for(ossim_uint32 j = N; j-- > 0; )
+   {
+      const ossim_uint32 BJ = m_sizes[m_perm[j]];
+      double* yj = &y[m_offsets[m_perm[j]]];
+      Column::const_iterator iter = m_factor[j].begin();
+      const double* ljj = &iter->second.front();
+      for(++iter; iter != m_factor[j].end(); ++iter)
+      {
+         ossim_uint32 r = m_perm[iter->first];
+         multiplyAdd(-1.0, &iter->second.front(), true, &y[m_offsets[r]], false,
+                     yj, BJ, 1, m_sizes[r]);
+      }
+      solveLowerTransposed(ljj, BJ, yj);
+   }
+
+   std::copy(y.begin(), y.end(), x);
+   return true;
+}
+
+bool ossim::SparseBlockMatrix::solvePcg(const double* b, double* x, double tolerance,
+                                        ossim_uint32 maxIterations)
+{
+   m_statistics.m_iterations = 0;
+   m_statistics.m_residual   = 0.0;
+
+   // Block Jacobi preconditioner, the Cholesky factor of each diagonal block:
+   const ossim_uint32 N = getNumberOfBlocks();
+   std::vector< std::vector<double> > preconditioner(N);
+   for(ossim_uint32 i = 0; i < N; ++i)
+   {
+      const double* d = findBlock(i, i);
+      if(!d) return false;
+      preconditioner[i].assign(d, d + m_sizes[i] * m_sizes[i]);
+      if(!cholesky(&preconditioner[i].front(), m_sizes[i])) return false;
+   }
+
+   std::vector<double> r(m_rank);
+   std::vector<double> z(m_rank);
+   std::vector<double> p(m_rank);
+   std::vector<double> ap(m_rank);
+
+   double bNorm = 0.0;
+   for(ossim_uint32 i = 0; i < m_rank; ++i)
+   {
+      bNorm += b[i] * b[i];
+   }
+   const double B_NORM = std::sqrt(bNorm);
+   if(B_NORM == 0.0)
+   {
+      std::fill(x, x + m_rank, 0.0);
+      return true;
+   }
+
+   multiply(x, &ap.front());
+   for(ossim_uint32 i = 0; i < m_rank; ++i)
+   {
+      r[i] = b[i] - ap[i];
+   }
+
+   double rz = 0.0;
+   for(ossim_uint32 iteration = 0; ; ++iteration)
+   {
+      m_statistics.m_iterations = iteration;
+      m_statistics.m_residual   = std::sqrt(dot(r, r)) / B_NORM;
+      if(m_statistics.m_residual <= tolerance) return true;
+      if(iteration == maxIterations) return false;
+
+      z = r;
+      for(ossim_uint32 i = 0; i < N; ++i)
+      {
+         solveLower(&preconditioner[i].front(), m_sizes[i], &z[m_offsets[i]]);
+         solveLowerTransposed(&preconditioner[i].front(), m_sizes[i], &z[m_offsets[i]]);
+      }
+
+      double rzNext = dot(r, z);
+      if(iteration == 0)
+      {
+         p = z;
+      }
+      else
+      {
+         double beta = rzNext / rz;
+         for(ossim_uint32 i = 0; i < m_rank; ++i)
+         {
+            p[i] = z[i] + beta * p[i];
+         }
+      }
+      rz = rzNext;
+
+      multiply(&p.front(), &ap.front());
+      double pap = dot(p, ap);
+      if(!(pap > 0.0)) return false; // Not positive definite.
+      double alpha = rz / pap;
+      for(ossim_uint32 i = 0; i < m_rank; ++i)
+      {
+         x[i] += alpha * p[i];
+         r[i] -= alpha * ap[i];
+      }
+   }
+}
+
+bool ossim::SparseBlockMatrix::computeInverse()
+{
+   m_inverse.clear();
+   if(!isFactored()) return false;
+
+   // Takahashi's equations, Z = inverse(L * L') on the pattern of L, from
+   // the last column back:
+   //    Z(i, j) = -sum Z(i, k) * L(k, j) * inverse(L(j, j))  for i > j
+   //    Z(j, j) = inverse(L(j, j))' * (inverse(L(j, j)) - sum L(k, j)' * Z(k, j))
+   // summed over the rows k > j of column j of L.
+   const ossim_uint32 N = getNumberOfBlocks();
+   std::vector<Column> inverse(N);
+   for(ossim_uint32 j = N; j-- > 0; )
+   {
+      const ossim_uint32 BJ = m_sizes[m_perm[j]];
+      const Column& column = m_factor[j];
+      Column::const_iterator diagonal = column.begin();
+
+      // inverse(L(j, j)), column by column:
+      std::vector<double> lInv(BJ * BJ, 0.0);
+      std::vector<double> e(BJ);
+      for(ossim_uint32 c = 0; c < BJ; ++c)
+      {
+         std::fill(e.begin(), e.end(), 0.0);
+         e[c] = 1.0;
+         solveLower(&diagonal->second.front(), BJ, &e.front());
+         for(ossim_uint32 row = 0; row < BJ; ++row)
+         {
+            lInv[row * BJ + c] = e[row];
+         }
+      }
+
+      Column::const_iterator i = diagonal;
+      for(++i; i != column.end(); ++i)
+      {
+         const ossim_uint32 BI = m_sizes[m_perm[i->first]];
+         std::vector<double> sum(BI * BJ, 0.0);
+         Column::const_iterator k = diagonal;
+         for(++k; k != column.end(); ++k)
+         {
+            const ossim_uint32 BK = m_sizes[m_perm[k->first]];
+            if(i->first >= k->first)
+            {
+               const std::vector<double>& zik = inverse[k->first][i->first];
+               multiplyAdd(1.0, &zik.front(), false, &k->second.front(), false,
+                           &sum.front(), BI, BJ, BK);
+            }
+            else
+            {
+               const std::vector<double>& zki = inverse[i->first][k->first];
+               multiplyAdd(1.0, &zki.front(), true, &k->second.front(), false,
+                           &sum.front(), BI, BJ, BK);
+            }
+         }
+         std::vector<double>& zij = inverse[j][i->first];
+         zij.assign(BI * BJ, 0.0);
+         multiplyAdd(-1.0, &sum.front(), false, &lInv.front(), false,
+                     &zij.front(), BI, BJ, BJ);
+      }
+
+      std::vector<double> inner(lInv);
+      for(i = diagonal, ++i; i != column.end(); ++i)
+      {
+         const ossim_uint32 BI = m_sizes[m_perm[i->first]];
+         multiplyAdd(-1.0, &i->second.front(), true, &inverse[j][i->first].front(), false,
+                     &inner.front(), BJ, BJ, BI);
+      }
+      std::vector<double>& zjj = inverse[j][j];
+      zjj.assign(BJ * BJ, 0.0);
+      multiplyAdd(1.0, &lInv.front(), true, &inner.front(), false, &zjj.front(), BJ, BJ, BJ);
+
+      // Symmetric up to rounding:
+      for(ossim_uint32 r = 0; r < BJ; ++r)
+      {
+         for(ossim_uint32 c = r + 1; c < BJ; ++c)
+         {
+            double v = 0.5 * (zjj[r * BJ + c] + zjj[c * BJ + r]);
+            zjj[r * BJ + c] = v;
+            zjj[c * BJ + r] = v;
+         }
+      }
+   }
+
+   m_inverse.swap(inverse);
+   return true;
+}
+
+bool ossim::SparseBlockMatrix::getInverseBlock(ossim_uint32 i, ossim_uint32 k, double* out)const
+{
+   if(m_inverse.empty()) return false;
+
+   ossim_uint32 ni = m_iperm[i];
+   ossim_uint32 nk = m_iperm[k];
+   if(ni >= nk)
+   {
+      Column::const_iterator iter = m_inverse[nk].find(ni);
+      if(iter == m_inverse[nk].end()) return false;
+      std::copy(iter->second.begin(), iter->second.end(), out);
+   }
+   else
+   {
+      Column::const_iterator iter = m_inverse[ni].find(nk);
+      if(iter == m_inverse[ni].end()) return false;
+      transpose(&iter->second.front(), m_sizes[k], m_sizes[i], out);
+   }
+   return true;
+}
@@ -35,8 +35,10 @@ ossimAdjSolutionAttributes::ossimAdjSolutionAttributes(
 {
    theTotalCorrections.ReSize(rankN,1);
    theLastCorrections.ReSize(rankN,1);
+   theVariances.ReSize(rankN,1);
    theTotalCorrections = 0.0;
    theLastCorrections = 0.0;
+   theVariances = 0.0;
 }
 
 
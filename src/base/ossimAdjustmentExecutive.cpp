@@ -32,6 +32,8 @@ ossimAdjustmentExecutive::ossimAdjustmentExecutive(std::ostream& report)
    :
       theExecValid(false),
       theSol(0),
+      theSolverType(ossimWLSBundleSolution::SPARSE_CHOLESKY_SOLVER),
+      theComputeCovariance(true),
       theSolAttributes(0),
       theConvCriteria(5.0),
       theMaxIter(7),      
@@ -77,6 +79,8 @@ ossimAdjustmentExecutive(ossimObservationSet& obsSet, std::ostream& report)
    :
       theExecValid(false),
       theSol(0),
+      theSolverType(ossimWLSBundleSolution::SPARSE_CHOLESKY_SOLVER),
+      theComputeCovariance(true),
       theSolAttributes(0),
       theConvCriteria(5.0),
       theMaxIter(7),      
@@ -375,6 +379,8 @@ bool ossimAdjustmentExecutive::initializeSolution(ossimObservationSet& obsSet)
 
    // Instantiate solution object
    theSol = new ossimWLSBundleSolution();
+   theSol->setSolverType(theSolverType);
+   theSol->setComputeCovariance(theComputeCovariance);
 
    theExecValid = true;
 
@@ -413,6 +419,9 @@ bool ossimAdjustmentExecutive::runSolution()
       theExecValid = theSol->run(theSolAttributes);
 
 
+      // Report solver timing and fill-in
+      theSol->printStatistics(theRep);
+
       if (theExecValid)
       {
          // Report corrections
@@ -700,7 +709,10 @@ printParameterCorrectionSummary(std::ostream& out) const
       out<<setw(12)<<theSolAttributes->theTotalCorrections(pc);
       out<<setw(12)<<theSolAttributes->theLastCorrections(pc);
       out<<setw(12)<<theParInitialStdDev[pc-1];
-      out<<setw(12)<<sqrt(theSolAttributes->theFullCovMatrix(pc,pc));
+      if (theSol && theSol->getComputeCovariance())
+         out<<setw(12)<<sqrt(theSolAttributes->theVariances(pc));
+      else
+         out<<setw(12)<<"n/a";
    }
    out<<endl;
 
@@ -742,7 +754,10 @@ printObservationCorrectionSummary(std::ostream& out) const
          out<<setw(12)<<theSolAttributes->theTotalCorrections(idx)*factor;
          out<<setw(12)<<theSolAttributes->theLastCorrections(idx)*factor;
          out<<setw(12)<<theObsInitialStdDev[obs*3+k]*factor;
-         out<<setw(12)<<sqrt(theSolAttributes->theFullCovMatrix(idx,idx))*factor;
+         if (theSol && theSol->getComputeCovariance())
+            out<<setw(12)<<sqrt(theSolAttributes->theVariances(idx))*factor;
+         else
+            out<<setw(12)<<"n/a";
          out<<endl<<"                       ";
       }
    }
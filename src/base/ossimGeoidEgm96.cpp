@@ -16,6 +16,7 @@
 #include <ossim/base/ossimNotifyContext.h>
 #include <ossim/base/ossimDatumFactory.h>
 #include <fstream>
+#include <vector>
 
 static ossimTrace traceDebug ("ossimGeoidEgm96:debug");
 
@@ -31,18 +32,18 @@ static ossimTrace traceDebug ("ossimGeoidEgm96:debug");
 RTTI_DEF1(ossimGeoidEgm96, "ossimGeoidEgm96", ossimGeoid)
 
 ossimGeoidEgm96::ossimGeoidEgm96()
-   :theGeoidHeightBufferPtr(0)
+   :theGrid()
 {
 }
 
 ossimGeoidEgm96::ossimGeoidEgm96(const ossimFilename& grid_file,
                                  ossimByteOrder byteOrder)
-   :theGeoidHeightBufferPtr(0)
+   :theGrid()
 {
    open(grid_file, byteOrder);
    if (getErrorStatus() != ossimErrorCodes::OSSIM_OK)
    {
-      theGeoidHeightBuffer.clear();
+      theGrid.clear();
    }
 }
 
@@ -65,11 +66,8 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
       ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " Entered...\n";
    }
 
-   if(theGeoidHeightBuffer.size() != NumbGeoidElevs)
-   {
-      theGeoidHeightBuffer.resize(NumbGeoidElevs);
-      theGeoidHeightBufferPtr = &theGeoidHeightBuffer.front();
-   }
+   theGrid.clear();
+   std::vector<float> heights(NumbGeoidElevs);
    
    // int   ItemsRead = 0;
    long  ElevationsRead = 0;
@@ -110,16 +108,16 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
       float f;
       gridHeightFile.read( (char*)(&f), 4);
       if (swap_bytes) oe.swap(f);
-      theGeoidHeightBuffer[num] = f;
+      heights[num] = f;
       ++num;
    }
    // Determine if header read properly, or NOT:
-   if ((!ossim::almostEqual(theGeoidHeightBuffer[0], (float)-90.0)) ||
-       (!ossim::almostEqual(theGeoidHeightBuffer[1], (float)90.0)) ||
-       (!ossim::almostEqual(theGeoidHeightBuffer[2], (float)0.0)) ||
-       (!ossim::almostEqual(theGeoidHeightBuffer[3],(float)360.0))||
-       (!ossim::almostEqual(theGeoidHeightBuffer[4],(float)(1.0 / ScaleFactor ))) ||
-       (!ossim::almostEqual(theGeoidHeightBuffer[5],(float)( 1.0 / ScaleFactor ))) ||
+   if ((!ossim::almostEqual(heights[0], (float)-90.0)) ||
+       (!ossim::almostEqual(heights[1], (float)90.0)) ||
+       (!ossim::almostEqual(heights[2], (float)0.0)) ||
+       (!ossim::almostEqual(heights[3],(float)360.0))||
+       (!ossim::almostEqual(heights[4],(float)(1.0 / ScaleFactor ))) ||
+       (!ossim::almostEqual(heights[5],(float)( 1.0 / ScaleFactor ))) ||
        gridHeightFile.fail())
    {
       if(traceDebug())
@@ -141,7 +139,7 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
       float f;
       gridHeightFile.read( (char*)(&f), 4);
       if (swap_bytes) oe.swap(f);
-      theGeoidHeightBuffer[num] = f;
+      heights[num] = f;
       ++ElevationsRead;
       ++num;
    }
@@ -158,6 +156,10 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
      return false;
   }
 
+   // Read-only from here on, so queries need no locking:
+   theGrid.create(NumbGeoidCols, NumbGeoidRows);
+   theGrid.setPosts(0, NumbGeoidRows, &heights.front(), ossim::nan());
+
    if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -169,14 +171,39 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
 
 double ossimGeoidEgm96::offsetFromEllipsoid(const ossimGpt& gpt)
 {
-   double offset = ossim::nan();
    ossimGpt savedGpt = gpt;
    if(ossimDatumFactory::instance()->wgs84())
    {
       savedGpt.changeDatum(ossimDatumFactory::instance()->wgs84());
    }
+   return offsetFromWgs84(savedGpt);
+}
+
+void ossimGeoidEgm96::offsetsFromEllipsoid(const ossimGpt* gpts,
+                                           ossim_uint32 count,
+                                           double* offsets)
+{
+   const ossimDatum* wgs84 = ossimDatumFactory::instance()->wgs84();
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (wgs84 && (gpts[i].datum() != wgs84))
+      {
+         ossimGpt savedGpt = gpts[i];
+         savedGpt.changeDatum(wgs84);
+         offsets[i] = offsetFromWgs84(savedGpt);
+      }
+      else
+      {
+         offsets[i] = offsetFromWgs84(gpts[i]);
+      }
+   }
+}
+
+double ossimGeoidEgm96::offsetFromWgs84(const ossimGpt& savedGpt) const
+{
+   double offset = ossim::nan();
    
-   if (!theGeoidHeightBufferPtr)
+   if (theGrid.empty())
    {
       if(traceDebug())
       {
@@ -188,13 +215,8 @@ double ossimGeoidEgm96::offsetFromEllipsoid(const ossimGpt& gpt)
       return offset;
    }
    
-   long    Index;
-   double DeltaX, DeltaY;
-   double ElevationSE, ElevationSW, ElevationNE, ElevationNW;
    double LatitudeDD, LongitudeDD;
    double OffsetX, OffsetY;
-   double PostX, PostY;
-   double UpperY, LowerY;
 
    LatitudeDD  = savedGpt.latd();
    
@@ -257,33 +279,10 @@ double ossimGeoidEgm96::offsetFromEllipsoid(const ossimGpt& gpt)
    OffsetY = ( 90.0 - LatitudeDD ) * ScaleFactor;
    
    //---
-   // Find Four Nearest Geoid Height Cells for specified Latitude,
-   // Longitude;  Assumes that (0,0) of Geoid Height Array is at
-   // Northwest corner:
+   // Bilinear between the four nearest posts; assumes that (0,0) of the
+   // grid is at the Northwest corner:
    //---
-   PostX = floor( OffsetX );
-   if ((PostX + 1) == NumbGeoidCols)
-      PostX--;
-   PostY = floor( OffsetY );
-   if ((PostY + 1) == NumbGeoidRows)
-      PostY--;
-   
-   Index = (long)(PostY * NumbGeoidCols + PostX);
-   ElevationNW = theGeoidHeightBufferPtr[ Index ];
-   ElevationNE = theGeoidHeightBufferPtr[ Index+ 1 ];
-   
-   Index = (long)((PostY + 1) * NumbGeoidCols + PostX);
-   ElevationSW = theGeoidHeightBufferPtr[ Index ];
-   ElevationSE = theGeoidHeightBufferPtr[ Index + 1 ];
-   
-   //Perform Bi-Linear Interpolation to compute Height above Ellipsoid:
-   DeltaX = OffsetX - PostX;
-   DeltaY = OffsetY - PostY;
-   
-   UpperY = ElevationNW + DeltaX * ( ElevationNE - ElevationNW );
-   LowerY = ElevationSW + DeltaX * ( ElevationSE - ElevationSW );
-   
-   offset = UpperY + DeltaY * ( LowerY - UpperY );
+   offset = theGrid.interpolate(OffsetX, OffsetY);
    
    return offset;
 }
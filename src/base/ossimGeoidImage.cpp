@@ -14,6 +14,7 @@
 
 #include <ossim/base/ossimGeoidImage.h>
 
+#include <ossim/base/ossimDatumFactory.h>
 #include <ossim/base/ossimDrect.h>
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimFilename.h>
@@ -23,24 +24,30 @@
 #include <ossim/base/ossimScalarTypeLut.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <ossim/projection/ossimProjection.h>
+#include <algorithm>
 #include <cmath>
 
 ossimGeoidImage::ossimGeoidImage()
    : m_geom(0),
      m_handler(0),
-     m_cacheTile(0),
      m_geoidTypeName(),
      m_memoryMapFlag(false),
      m_enabledFlag(true),
-     m_imageRect()
+     m_imageRect(),
+     m_grid(),
+     m_gridStorage(ossim::GeoidGrid::FLOAT32_STORAGE),
+     m_interpolation(ossim::GeoidGrid::BILINEAR),
+     m_maxGridBytes(268435456), // 256 MiB
+     m_affineFlag(false),
+     m_handlerMutex()
 {
+   std::fill( m_lonLatToGrid, m_lonLatToGrid + 6, 0.0 );
 }
 
 ossimGeoidImage::~ossimGeoidImage()
 {
    m_geom = 0;
    m_handler = 0;
-   m_cacheTile = 0;
 }
 
 bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrder */ )
@@ -48,7 +55,8 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
    static const char MODULE[] = "ossimGeoidImage::open";
    
    m_geom = 0;
-   m_cacheTile = 0;
+   m_grid.clear();
+   m_affineFlag = false;
    if ( m_handler.valid() )
    {
       m_handler->close();
@@ -74,13 +82,16 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
          // Verify the geometry object has a good projection.
          if ( m_geom->getProjection() )
          {
-            if ( m_memoryMapFlag )
+            const ossim_uint64 POST_BYTES =
+               ( m_gridStorage == ossim::GeoidGrid::SINT16_STORAGE ) ? 2 : 4;
+            const ossim_uint64 GRID_BYTES = POST_BYTES *
+               m_imageRect.width() * m_imageRect.height();
+            
+            if ( m_memoryMapFlag || ( GRID_BYTES <= m_maxGridBytes ) )
             {
                try
                {
-                  m_cacheTile = m_handler->getTile( m_imageRect, 0 );
-                  
-                  if ( m_cacheTile.valid() )
+                  if ( loadGrid() )
                   {
                      // Close the image handler:
                      m_handler->close();
@@ -90,7 +101,7 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
                catch ( const ossimException& e )
                {
                   m_memoryMapFlag = false;
-                  m_cacheTile = 0;
+                  m_grid.clear();
                   
                   ossimNotify(ossimNotifyLevel_WARN)
                      << MODULE << " ERROR: Caught Exception!"
@@ -99,6 +110,8 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
                      << std::endl;
                }
             }
+
+            computeAffine();
          }
          else
          {
@@ -121,7 +134,178 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
       }
    }
    
-   return ( m_geom.valid() && (m_handler.valid() || (m_memoryMapFlag && m_cacheTile.valid()) ));
+   return isInitialized();
+}
+
+bool ossimGeoidImage::loadGrid()
+{
+   static const ossim_uint32 STRIP_HEIGHT = 256;
+
+   if ( ( m_scalarType != OSSIM_SINT16 ) &&
+        ( m_scalarType != OSSIM_FLOAT32 ) &&
+        ( m_scalarType != OSSIM_FLOAT64 ) )
+   {
+      return false; // Reported on query.
+   }
+
+   const ossim_uint32 W = m_imageRect.width();
+   const ossim_uint32 H = m_imageRect.height();
+   m_grid.create( W, H, m_gridStorage );
+   if ( m_grid.empty() )
+   {
+      return false;
+   }
+
+   // Strips keep the transient decode buffer small for large grids.
+   for ( ossim_uint32 row = 0; row < H; row += STRIP_HEIGHT )
+   {
+      ossim_uint32 rows = std::min( STRIP_HEIGHT, H - row );
+      ossimIrect stripRect( m_imageRect.ul().x,
+                            m_imageRect.ul().y + static_cast<ossim_int32>(row),
+                            m_imageRect.lr().x,
+                            m_imageRect.ul().y + static_cast<ossim_int32>(row + rows - 1) );
+      ossimRefPtr<ossimImageData> strip = m_handler->getTile( stripRect, 0 );
+      if ( !strip.valid() || ( strip->getWidth() != W ) || ( strip->getHeight() != rows ) )
+      {
+         m_grid.clear();
+         return false;
+      }
+      if ( ( strip->getDataObjectStatus() == OSSIM_EMPTY ) || !strip->getBuf() )
+      {
+         continue; // Posts stay null.
+      }
+
+      const double NP = strip->getNullPix( 0 );
+      switch ( m_scalarType )
+      {
+         case OSSIM_SINT16:
+         {
+            m_grid.setPosts( row, rows, static_cast<const ossim_sint16*>(strip->getBuf()), NP );
+            break;
+         }
+         case OSSIM_FLOAT32:
+         {
+            m_grid.setPosts( row, rows, static_cast<const ossim_float32*>(strip->getBuf()), NP );
+            break;
+         }
+         default:
+         {
+            m_grid.setPosts( row, rows, static_cast<const ossim_float64*>(strip->getBuf()), NP );
+            break;
+         }
+      }
+   }
+
+   return true;
+}
+
+void ossimGeoidImage::computeAffine()
+{
+   m_affineFlag = false;
+   if ( !m_geom.valid() || m_imageRect.hasNans() ||
+        ( m_imageRect.width() < 2 ) || ( m_imageRect.height() < 2 ) )
+   {
+      return;
+   }
+
+   const ossimDatum* wgs84 = ossimDatumFactory::instance()->wgs84();
+   const ossimDpt UL( m_imageRect.ul() );
+   const ossimDpt LR( m_imageRect.lr() );
+
+   //---
+   // Ground points of three corners fix the affine.  Heights are given so
+   // no elevation lookup, which may land back here, is made.
+   //---
+   const ossimDpt CORNERS[3] = { UL, ossimDpt( LR.x, UL.y ), ossimDpt( UL.x, LR.y ) };
+   double lon[3];
+   double lat[3];
+   for ( int i = 0; i < 3; ++i )
+   {
+      ossimGpt gpt;
+      m_geom->localToWorld( CORNERS[i], 0.0, gpt );
+      if ( wgs84 )
+      {
+         gpt.changeDatum( wgs84 );
+      }
+      gpt.wrap();
+      lon[i] = gpt.lond();
+      lat[i] = gpt.latd();
+   }
+
+   // Cramer's rule on [ 1 lon lat ] * a = x, then = y:
+   const double DET = ( lon[1] - lon[0] ) * ( lat[2] - lat[0] ) -
+                      ( lon[2] - lon[0] ) * ( lat[1] - lat[0] );
+   if ( ossim::isnan( DET ) || ( std::fabs( DET ) < 1.0e-12 ) )
+   {
+      return;
+   }
+   const double X[3] = { 0.0, LR.x - UL.x, 0.0 };
+   const double Y[3] = { 0.0, 0.0, LR.y - UL.y };
+   for ( int axis = 0; axis < 2; ++axis )
+   {
+      const double* v = axis ? Y : X;
+      double* a = m_lonLatToGrid + axis * 3;
+      a[1] = ( ( v[1] - v[0] ) * ( lat[2] - lat[0] ) -
+               ( v[2] - v[0] ) * ( lat[1] - lat[0] ) ) / DET;
+      a[2] = ( ( lon[1] - lon[0] ) * ( v[2] - v[0] ) -
+               ( lon[2] - lon[0] ) * ( v[1] - v[0] ) ) / DET;
+      a[0] = v[0] - a[1] * lon[0] - a[2] * lat[0];
+   }
+
+   //---
+   // Check against worldToLocal over the grid and around the globe, which
+   // also catches projections that wrap longitudes differently.
+   //---
+   static const double TOLERANCE = 1.0e-6; // pixels
+   static const int STEPS = 8;
+   const double W = LR.x - UL.x + 1.0;
+   const double H = LR.y - UL.y + 1.0;
+   std::vector<ossimGpt> checks;
+   for ( int j = 0; j <= STEPS; ++j )
+   {
+      for ( int i = 0; i <= STEPS; ++i )
+      {
+         ossimGpt gpt;
+         m_geom->localToWorld( ossimDpt( UL.x + ( LR.x - UL.x ) * i / STEPS + 0.37,
+                                         UL.y + ( LR.y - UL.y ) * j / STEPS + 0.61 ),
+                               0.0, gpt );
+         checks.push_back( gpt );
+         checks.push_back( ossimGpt( -89.5 + 179.0 * j / STEPS,
+                                     -179.5 + 359.0 * i / STEPS, 0.0 ) );
+      }
+   }
+
+   for ( std::vector<ossimGpt>::size_type i = 0; i < checks.size(); ++i )
+   {
+      ossimGpt gpt = checks[i];
+      if ( wgs84 )
+      {
+         gpt.changeDatum( wgs84 );
+      }
+      gpt.wrap();
+
+      ossimDpt expected;
+      m_geom->worldToLocal( gpt, expected );
+      expected.x -= UL.x;
+      expected.y -= UL.y;
+
+      const double* a = m_lonLatToGrid;
+      ossimDpt actual( a[0] + a[1] * gpt.lond() + a[2] * gpt.latd(),
+                       a[3] + a[4] * gpt.lond() + a[5] * gpt.latd() );
+
+      bool expectedIn = ( expected.x > -0.5 ) && ( expected.x < W - 0.5 ) &&
+                        ( expected.y > -0.5 ) && ( expected.y < H - 0.5 );
+      bool actualIn   = ( actual.x > -0.5 ) && ( actual.x < W - 0.5 ) &&
+                        ( actual.y > -0.5 ) && ( actual.y < H - 0.5 );
+      if ( ( expectedIn || actualIn ) &&
+           !( ( std::fabs( expected.x - actual.x ) <= TOLERANCE ) &&
+              ( std::fabs( expected.y - actual.y ) <= TOLERANCE ) ) )
+      {
+         return;
+      }
+   }
+
+   m_affineFlag = true;
 }
 
 ossimString ossimGeoidImage::getShortName() const
@@ -143,6 +327,31 @@ void ossimGeoidImage::setMemoryMapFlag( bool flag )
 {
    m_memoryMapFlag = flag; 
 }
+
+bool ossimGeoidImage::isGridLoaded() const
+{
+   return !m_grid.empty();
+}
+
+void ossimGeoidImage::setGridStorage( ossim::GeoidGrid::Storage storage )
+{
+   m_gridStorage = storage;
+}
+
+ossim::GeoidGrid::Storage ossimGeoidImage::getGridStorage() const
+{
+   return m_gridStorage;
+}
+
+void ossimGeoidImage::setInterpolation( ossim::GeoidGrid::Interpolation interpolation )
+{
+   m_interpolation = interpolation;
+}
+
+ossim::GeoidGrid::Interpolation ossimGeoidImage::getInterpolation() const
+{
+   return m_interpolation;
+}
    
 bool ossimGeoidImage::saveState( ossimKeywordlist& kwl,
                                  const char* prefix ) const
@@ -162,6 +371,19 @@ bool ossimGeoidImage::saveState( ossimKeywordlist& kwl,
    std::string value = (m_memoryMapFlag ? "true" : "false");
    kwl.addPair( myPrefix, key, value, true );
 
+   // Save the grid options:
+   key = "max_grid_bytes";
+   value = ossimString::toString( m_maxGridBytes ).string();
+   kwl.addPair( myPrefix, key, value, true );
+
+   key = "grid_storage";
+   value = ( m_gridStorage == ossim::GeoidGrid::SINT16_STORAGE ) ? "int16" : "float32";
+   kwl.addPair( myPrefix, key, value, true );
+
+   key = "interpolation";
+   value = ( m_interpolation == ossim::GeoidGrid::BICUBIC ) ? "bicubic" : "bilinear";
+   kwl.addPair( myPrefix, key, value, true );
+
    // Save the enabledFlag:
    key = ossimKeywordNames::ENABLED_KW;
    value = m_enabledFlag ? "true" : "false";
@@ -197,6 +419,30 @@ bool ossimGeoidImage::loadState( const ossimKeywordlist& kwl,
       value = kwl.findKey( myPrefix, key );
       m_memoryMapFlag = ossimString( value ).toBool();
 
+      // Get the grid options, keeping the defaults if not set:
+      key = "max_grid_bytes";
+      value = kwl.findKey( myPrefix, key );
+      if ( value.size() )
+      {
+         m_maxGridBytes = ossimString( value ).toUInt64();
+      }
+
+      key = "grid_storage";
+      value = ossimString( kwl.findKey( myPrefix, key ) ).downcase().string();
+      if ( value.size() )
+      {
+         m_gridStorage = ( value == "int16" ) ?
+            ossim::GeoidGrid::SINT16_STORAGE : ossim::GeoidGrid::FLOAT32_STORAGE;
+      }
+
+      key = "interpolation";
+      value = ossimString( kwl.findKey( myPrefix, key ) ).downcase().string();
+      if ( value.size() )
+      {
+         m_interpolation = ( value == "bicubic" ) ?
+            ossim::GeoidGrid::BICUBIC : ossim::GeoidGrid::BILINEAR;
+      }
+
       // Get the enabled flag:
       key = ossimKeywordNames::ENABLED_KW;
       value = kwl.findKey( myPrefix, key );
@@ -215,43 +461,53 @@ bool ossimGeoidImage::loadState( const ossimKeywordlist& kwl,
 }
 
 
+bool ossimGeoidImage::isInitialized() const
+{
+   return ( m_geom.valid() && ( m_handler.valid() || !m_grid.empty() ) );
+}
+
 double ossimGeoidImage::offsetFromEllipsoid( const ossimGpt& gpt )
 {
    double offset = ossim::nan();
 
    if ( m_enabledFlag )
    {
-      if ( m_geom.valid() &&
-           ( m_handler.valid() ||
-             ( m_memoryMapFlag && m_cacheTile.valid() )
-             )
-           )
+      if ( isInitialized() )
       {
-         switch(m_scalarType)
+         ossimDpt pt = toGridPoint( gpt, ossimDatumFactory::instance()->wgs84() );
+         
+         if ( !m_grid.empty() )
          {
-            case OSSIM_SINT16:
-            {
-               offset = offsetFromEllipsoidTemplate((ossim_sint16)0, gpt);
-               break;
-            }
-            case OSSIM_FLOAT32:
-            {
-               offset = offsetFromEllipsoidTemplate((ossim_float32)0, gpt);
-               break;
-            }
-            case OSSIM_FLOAT64:
-            {
-               offset = offsetFromEllipsoidTemplate((ossim_float64)0, gpt);
-               break;
-            }
-            default:
+            offset = m_grid.interpolate( pt.x, pt.y, m_interpolation );
+         }
+         else
+         {
+            switch(m_scalarType)
             {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << "ossimGeoidImage::offsetFromEllipsoid ERROR:\n"
-                  << "Unhandled scalar type: "
-                  << ossimScalarTypeLut::instance()->getEntryString( m_scalarType )
-                  << std::endl;
-               break;
+               case OSSIM_SINT16:
+               {
+                  offset = offsetFromHandlerTemplate((ossim_sint16)0, pt);
+                  break;
+               }
+               case OSSIM_FLOAT32:
+               {
+                  offset = offsetFromHandlerTemplate((ossim_float32)0, pt);
+                  break;
+               }
+               case OSSIM_FLOAT64:
+               {
+                  offset = offsetFromHandlerTemplate((ossim_float64)0, pt);
+                  break;
+               }
+               default:
+               {
+                  ossimNotify(ossimNotifyLevel_WARN)
+                     << "ossimGeoidImage::offsetFromEllipsoid ERROR:\n"
+                     << "Unhandled scalar type: "
+                     << ossimScalarTypeLut::instance()->getEntryString( m_scalarType )
+                     << std::endl;
+                  break;
+               }
             }
          }
       }
@@ -267,33 +523,69 @@ double ossimGeoidImage::offsetFromEllipsoid( const ossimGpt& gpt )
    return offset;
 }
 
-template <class T>
-double ossimGeoidImage::offsetFromEllipsoidTemplate(T /* dummy */,
-                                                    const ossimGpt& gpt)
+void ossimGeoidImage::offsetsFromEllipsoid( const ossimGpt* gpts,
+                                            ossim_uint32 count,
+                                            double* offsets )
 {
-   double geoidOffset = ossim::nan();
+   if ( m_enabledFlag && m_geom.valid() && !m_grid.empty() )
+   {
+      const ossimDatum* wgs84 = ossimDatumFactory::instance()->wgs84();
+      for ( ossim_uint32 i = 0; i < count; ++i )
+      {
+         ossimDpt pt = toGridPoint( gpts[i], wgs84 );
+         offsets[i] = m_grid.interpolate( pt.x, pt.y, m_interpolation );
+      }
+   }
+   else
+   {
+      ossimGeoid::offsetsFromEllipsoid( gpts, count, offsets );
+   }
+}
 
+ossimDpt ossimGeoidImage::toGridPoint( const ossimGpt& gpt, const ossimDatum* datum ) const
+{
    // Change the datum if needed:
    ossimGpt copyGpt = gpt;
-   if(ossimDatumFactory::instance()->wgs84())
+   if ( datum )
    {
-      copyGpt.changeDatum(ossimDatumFactory::instance()->wgs84());
+      copyGpt.changeDatum( datum );
    }
    
    // Fix wrap conditions:
    copyGpt.wrap();
-   
-   // Get the local image point for the input ground point.
-   ossimDpt imgDpt;
-   m_geom->worldToLocal( copyGpt, imgDpt );
 
-   if ( m_imageRect.pointWithin( ossimIpt( imgDpt ) ) )
+   ossimDpt pt;
+   if ( m_affineFlag )
    {
-      ossim_int32 x0 = static_cast<ossim_int32>( imgDpt.x );
-      ossim_int32 y0 = static_cast<ossim_int32>( imgDpt.y );
-      
-      ossim_int32 IW = static_cast<ossim_int32>(m_imageRect.width());
-      ossim_int32 IH = static_cast<ossim_int32>(m_imageRect.height());
+      const double LON = copyGpt.lond();
+      const double LAT = copyGpt.latd();
+      pt.x = m_lonLatToGrid[0] + m_lonLatToGrid[1] * LON + m_lonLatToGrid[2] * LAT;
+      pt.y = m_lonLatToGrid[3] + m_lonLatToGrid[4] * LON + m_lonLatToGrid[5] * LAT;
+   }
+   else
+   {
+      // Get the local image point for the input ground point.
+      m_geom->worldToLocal( copyGpt, pt );
+      pt.x -= m_imageRect.ul().x;
+      pt.y -= m_imageRect.ul().y;
+   }
+   return pt;
+}
+
+template <class T>
+double ossimGeoidImage::offsetFromHandlerTemplate(T /* dummy */,
+                                                  const ossimDpt& pt)
+{
+   double geoidOffset = ossim::nan();
+
+   ossim_int32 IW = static_cast<ossim_int32>(m_imageRect.width());
+   ossim_int32 IH = static_cast<ossim_int32>(m_imageRect.height());
+
+   // Nearest post must be in the image:
+   if ( ( pt.x > -0.5 ) && ( pt.y > -0.5 ) && ( pt.x < IW - 0.5 ) && ( pt.y < IH - 0.5 ) )
+   {
+      ossim_int32 x0 = static_cast<ossim_int32>( pt.x );
+      ossim_int32 y0 = static_cast<ossim_int32>( pt.y );
       
       if ( x0 == (IW-1) )
       {
@@ -304,60 +596,40 @@ double ossimGeoidImage::offsetFromEllipsoidTemplate(T /* dummy */,
          --y0; // Move over one point.
       }
 
-      if ( !m_memoryMapFlag )
-      {
-         // Get the four points from the image handler.
-         ossimIrect tileRect(ossimIpt(x0, y0), ossimIpt(x0+1, y0+1));
-         m_cacheTile = m_handler->getTile( tileRect, 0 );
-      }
+      double p00 = ossim::nan();
+      double p01 = ossim::nan();
+      double p10 = ossim::nan();
+      double p11 = ossim::nan();
       
-      if ( m_cacheTile.valid() )
+      // Get the four points from the image handler.
+      ossimIpt origin( m_imageRect.ul().x + x0, m_imageRect.ul().y + y0 );
+      ossimIrect tileRect( origin, ossimIpt( origin.x + 1, origin.y + 1 ) );
       {
-         // Get a pointer to the buffer.
-         const T* buf = static_cast<const T*>(m_cacheTile->getBuf());
-         
+         // The handler and its tile are shared; copy the posts out locked.
+         std::lock_guard<std::mutex> lock( m_handlerMutex );
+         ossimRefPtr<ossimImageData> tile = m_handler->getTile( tileRect, 0 );
+         const T* buf = tile.valid() ? static_cast<const T*>(tile->getBuf()) : 0;
          if ( buf )
          {
-            const ossim_float64 NP = m_cacheTile->getNullPix(0);
-            const ossim_int64 TW = static_cast<ossim_int64>(m_cacheTile->getWidth());
-            ossim_int64 offset = (y0 - m_cacheTile->getOrigin().y) * TW +
-               (x0 - m_cacheTile->getOrigin().x);
+            const ossim_float64 NP = tile->getNullPix(0);
+            const ossim_int64 TW = static_cast<ossim_int64>(tile->getWidth());
+            ossim_int64 offset = (origin.y - tile->getOrigin().y) * TW +
+               (origin.x - tile->getOrigin().x);
             ossim_int64 offset2 = offset + TW;
-            
-            double p00 = buf[offset];
-            double p01 = buf[offset+1];
-            double p10 = buf[offset2];
-            double p11 = buf[offset2+1];
-            
-            double xt0 = imgDpt.x - x0;
-            double yt0 = imgDpt.y - y0;
-            double xt1 = 1-xt0;
-            double yt1 = 1-yt0;
-            
-            double w00 = xt1*yt1;
-            double w01 = xt0*yt1;
-            double w10 = xt1*yt0;
-            double w11 = xt0*yt0;
-            
+
             //---
-            // Test for null posts and set the corresponding weights to 0:
+            // Null posts are passed as nan so they get no weight:
             //---
-            if (p00 == NP) w00 = 0.0;
-            if (p01 == NP) w01 = 0.0;
-            if (p10 == NP) w10 = 0.0;
-            if (p11 == NP) w11 = 0.0;                  
-            
-            double sum_weights = w00 + w01 + w10 + w11;
-            if (sum_weights)
-            {
-               geoidOffset = (p00*w00 + p01*w01 + p10*w10 + p11*w11) / sum_weights;
-            }
+            if ( buf[offset]    != NP ) p00 = buf[offset];
+            if ( buf[offset+1]  != NP ) p01 = buf[offset+1];
+            if ( buf[offset2]   != NP ) p10 = buf[offset2];
+            if ( buf[offset2+1] != NP ) p11 = buf[offset2+1];
          }
-         
-      } // Matches: if ( m_cacheTile.valid() )
+      }
+
+      geoidOffset = ossim::GeoidGrid::bilinear( p00, p01, p10, p11, pt.x - x0, pt.y - y0 );
       
-   } // Matches: if ( m_imageRect.pointWithin( imgPt ) )
+   } // Matches: if ( nearest post within image )
 
    return geoidOffset;
 }
-
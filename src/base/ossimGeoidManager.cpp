@@ -30,6 +30,7 @@
 // Define Trace flags for use within this file:
 //***
 #include <ossim/base/ossimTrace.h>
+#include <algorithm>
 static ossimTrace traceExec  ("ossimGeoidManager:exec");
 static ossimTrace traceDebug ("ossimGeoidManager:debug");
 
@@ -325,6 +326,49 @@ double ossimGeoidManager::offsetFromEllipsoid(const ossimGpt& gpt)
    return offset;
 }
 
+void ossimGeoidManager::offsetsFromEllipsoid(const ossimGpt* gpts,
+                                             ossim_uint32 count,
+                                             double* offsets)
+{
+   std::fill(offsets, offsets + count, ossim::nan());
+
+   // Points without an offset yet, handed to the next geoid:
+   std::vector<ossim_uint32> pending;
+   std::vector<ossimGpt> pendingGpts;
+   std::vector<double> pendingOffsets;
+   std::vector<ossimRefPtr<ossimGeoid> >::iterator geoid = theGeoidList.begin();
+   for ( ; geoid != theGeoidList.end(); ++geoid )
+   {
+      if ( geoid == theGeoidList.begin() )
+      {
+         (*geoid)->offsetsFromEllipsoid(gpts, count, offsets);
+      }
+      else
+      {
+         pendingOffsets.resize(pending.size());
+         (*geoid)->offsetsFromEllipsoid(&pendingGpts.front(),
+                                        (ossim_uint32)pendingGpts.size(),
+                                        &pendingOffsets.front());
+         for ( ossim_uint32 i = 0; i < pending.size(); ++i )
+         {
+            offsets[pending[i]] = pendingOffsets[i];
+         }
+      }
+
+      pending.clear();
+      pendingGpts.clear();
+      for ( ossim_uint32 i = 0; i < count; ++i )
+      {
+         if ( ossim::isnan(offsets[i]) )
+         {
+            pending.push_back(i);
+            pendingGpts.push_back(gpts[i]);
+         }
+      }
+      if ( pending.empty() ) break;
+   }
+}
+
 ossimGeoid* ossimGeoidManager::findGeoidByShortName(const ossimString& shortName, bool caseSensitive)
 {
    ossim_uint32 idx=0;
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <list>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <utility>
 
@@ -30,6 +31,93 @@
 
 static ossimTrace traceDebug("ossimKeywordlist:debug");
 
+// Stream bytes read per chunk when parsing.
+static const std::streamsize PARSE_CHUNK_SIZE = 65536;
+
+static bool isKeywordlistCharacter(ossim_uint8 c)
+{
+   return ( ((c >= 0x20) && (c <= 0x7e)) || (c == '\n') || (c == '\r') || (c == '\t') );
+}
+
+//---
+// Joins prefix and key in a per thread buffer so lookups stop allocating
+// once the buffer has grown to the longest key.  Only valid until the next
+// call on the same thread.
+//---
+static const std::string& joinKey(const char* prefix, const char* key)
+{
+   static thread_local std::string joined;
+   joined.assign( prefix ? prefix : "" );
+   joined.append( key ? key : "" );
+   return joined;
+}
+
+static const std::string& joinKey(const std::string& prefix, const std::string& key)
+{
+   return joinKey( prefix.c_str(), key.c_str() );
+}
+
+//---
+// Literal text every match of regularExpression starts with.  Empty unless
+// the expression is anchored with '^' and free of alternation.  Collection
+// stops at the first group, since a group may be optional or repeated.
+//---
+static std::string getAnchoredPrefix(const ossimString& regularExpression)
+{
+   std::string prefix;
+   const std::string& re = regularExpression.string();
+   if ( re.empty() || (re[0] != '^') || (re.find('|') != std::string::npos) )
+   {
+      return prefix;
+   }
+
+   std::string::size_type pos = 1;
+   static const std::string SPECIAL = "^$.[]()*+?{}|\\";
+   while ( pos < re.size() )
+   {
+      char c = re[pos];
+      if ( (c == '\\') && (pos + 1 < re.size()) && !isalnum( (ossim_uint8)re[pos+1] ) )
+      {
+         c = re[++pos]; // Escaped literal.
+      }
+      else if ( SPECIAL.find(c) != std::string::npos )
+      {
+         // The character before an optional quantifier may not be there.
+         if ( !prefix.empty() && ( (c == '*') || (c == '?') || (c == '{') ) )
+         {
+            prefix.erase( prefix.size() - 1 );
+         }
+         break;
+      }
+      prefix += c;
+      ++pos;
+   }
+   return prefix;
+}
+
+//---
+// The keys that can match regularExpression.  The map is sorted, so keys
+// sharing the anchored prefix are one contiguous range.
+//---
+static std::pair<ossimKeywordlist::KeywordMap::const_iterator,
+                 ossimKeywordlist::KeywordMap::const_iterator>
+getCandidateRange(const ossimKeywordlist::KeywordMap& map,
+                  const ossimString& regularExpression)
+{
+   std::string prefix = getAnchoredPrefix(regularExpression);
+   if ( prefix.empty() )
+   {
+      return std::make_pair( map.begin(), map.end() );
+   }
+   ossimKeywordlist::KeywordMap::const_iterator first = map.lower_bound(prefix);
+   ossimKeywordlist::KeywordMap::const_iterator last  = first;
+   while ( (last != map.end()) && (last->first.compare(0, prefix.size(), prefix) == 0) )
+   {
+      ++last;
+   }
+   return std::make_pair( first, last );
+}
+
 #ifdef OSSIM_ID_ENABLED
 static const bool TRACE = false;
 static const char OSSIM_ID[] = "$Id: ossimKeywordlist.cpp 23632 2015-11-19 20:43:06Z dburken $";
@@ -592,23 +680,12 @@ const std::string& ossimKeywordlist::findKey(const std::string& key) const
 const std::string& ossimKeywordlist::findKey(const std::string& prefix,
                                              const std::string& key) const
 {
-   std::string k = prefix+key;
-   return findKey(k);
+   return findKey( joinKey(prefix, key) );
 }
 
 const char* ossimKeywordlist::find(const char* key) const
 {
-   const char* result = 0;
-   if (key)
-   {
-      std::string k = key;
-      KeywordMap::const_iterator i = m_map.find( k );
-      if (i != m_map.end())
-      {
-         result = (*i).second.c_str();
-      }
-   }
-   return result;
+   return find(0, key);
 }
 
 const char* ossimKeywordlist::find(const char* prefix,
@@ -617,10 +694,7 @@ const char* ossimKeywordlist::find(const char* prefix,
    const char* result = 0;
    if (key)
    {
-      std::string k;
-      if (prefix) k = prefix;
-      k += key;
-      KeywordMap::const_iterator i = m_map.find( k );
+      KeywordMap::const_iterator i = m_map.find( joinKey(prefix, key) );
       if (i != m_map.end())
       {
          result = (*i).second.c_str();
@@ -631,9 +705,7 @@ const char* ossimKeywordlist::find(const char* prefix,
 
 void ossimKeywordlist::remove(const char * key)
 {
-   ossimString k = key?key:"";
-   
-   KeywordMap::iterator i = m_map.find(k);
+   KeywordMap::iterator i = m_map.find( joinKey(0, key) );
    
    if(i != m_map.end())
    {
@@ -645,11 +717,7 @@ void ossimKeywordlist::remove(const char* prefix, const char * key)
 {
    if (key)
    {
-      ossimString k;
-      if (prefix) k = prefix;
-      k += key;
-      
-      KeywordMap::iterator i = m_map.find(k);
+      KeywordMap::iterator i = m_map.find( joinKey(prefix, key) );
       
       if(i != m_map.end())
       {
@@ -668,7 +736,7 @@ ossim_uint32 ossimKeywordlist::numberOf(const char* str) const
       
       while (i != m_map.end())
       {
-         if ( ossimString((*i).first).contains(str) )
+         if ( (*i).first.find(str) != std::string::npos )
          {
             ++count;
          }
@@ -684,8 +752,7 @@ ossim_uint32 ossimKeywordlist::numberOf(const char* prefix,
 {
    if ( key ) // Must have key, sometimes no prefix.
    {
-      std::string k(prefix ? (std::string(prefix)+std::string(key)) : key);
-      return numberOf(k.c_str());
+      return numberOf( joinKey(prefix, key).c_str() );
    }
    return 0;
 }
@@ -700,8 +767,7 @@ ossimKeywordlist::getMapEntry(const char* key)
 {
    if (key)
    {
-      std::string k = key;
-      return m_map.find(k);
+      return m_map.find( joinKey(0, key) );
    }
    else
    {
@@ -756,18 +822,7 @@ bool ossimKeywordlist::parseString(const std::string& inString)
 
 bool ossimKeywordlist::isValidKeywordlistCharacter(ossim_uint8 c)const
 {
-   if((c>=0x20&&c<=0x7e))
-   {
-      return true;
-   }
-   switch(c)
-   {
-      case '\n':
-      case '\r':
-      case '\t':
-         return true;
-   }
-   return false;
+   return isKeywordlistCharacter(c);
 }
 
 void ossimKeywordlist::skipWhitespace(ossim::istream& in)const
@@ -828,36 +883,40 @@ ossimKeywordlist::readPreprocDirective(ossim::istream& in)
       if (status)
          break;
 
-      ossimString directive = sequence.before(" ");
-
-      // Check for external KWL include file:
-      if (directive == "#include")
-      {
-         ossimFilename includeFile = sequence.after(" ");
-         if (includeFile.empty())
-            break; // ignore bogus preproc line
-         includeFile.trim("\"");
-         includeFile.expandEnvironmentVariable();
+      processPreprocDirective(sequence);
+      status = KeywordlistParseState_OK;
+      break;
+   }
+   return status;
+}
 
-         // The filename can be either relative to the current file being parsed or absolute:
-         if (includeFile.string()[0] != '/')
-            includeFile = m_currentlyParsing.path() + "/" + includeFile;
+void ossimKeywordlist::processPreprocDirective(const ossimString& sequence)
+{
+   ossimString directive = sequence.before(" ");
 
-         // Save the current path in case the new one contains it's own include directive!
-         ossimFilename savedCurrentPath = m_currentlyParsing;
-         addFile(includeFile); // Quietly ignore any errors loading external KWL.
-         m_currentlyParsing = savedCurrentPath;
-      }
+   // Check for external KWL include file:
+   if (directive == "#include")
+   {
+      ossimFilename includeFile = sequence.after(" ");
+      if (includeFile.empty())
+         return; // ignore bogus preproc line
+      includeFile.trim("\"");
+      includeFile.expandEnvironmentVariable();
 
-//      else if (directive == "#add_new_directive_here")
-//      {
-//         process directive
-//      }
+      // The filename can be either relative to the current file being parsed or absolute:
+      if (includeFile.string()[0] != '/')
+         includeFile = m_currentlyParsing.path() + "/" + includeFile;
 
-      status = KeywordlistParseState_OK;
-      break;
+      // Save the current path in case the new one contains it's own include directive!
+      ossimFilename savedCurrentPath = m_currentlyParsing;
+      addFile(includeFile); // Quietly ignore any errors loading external KWL.
+      m_currentlyParsing = savedCurrentPath;
    }
-   return status;
+
+//   else if (directive == "#add_new_directive_here")
+//   {
+//      process directive
+//   }
 }
 
 ossimKeywordlist::KeywordlistParseState ossimKeywordlist::readKey(ossimString& sequence, ossim::istream& in)const
@@ -1023,64 +1082,229 @@ bool ossimKeywordlist::parseStream(ossim::istream& is)
    {
       return false;
    }
-   ossimString key;
-   ossimString value;
-   ossimString sequence;
-   KeywordlistParseState state = KeywordlistParseState_OK;
-   while(!is.eof() && !is.bad())
+
+   //---
+   // Bulk read, then one pass over memory.  Reading stops after the first
+   // byte a keyword list cannot hold: the parse fails there anyway, and the
+   // binary files handed in by the image handler factories are not read
+   // whole.
+   //---
+   std::string buffer;
+   std::vector<char> chunk(PARSE_CHUNK_SIZE);
+   while ( !is.eof() && !is.bad() )
    {
-      skipWhitespace(is);
-      if(is.eof() || is.bad())
-         return true; // we skipped to end so valid keyword list
+      is.read( &chunk.front(), PARSE_CHUNK_SIZE );
+      std::streamsize count = is.gcount();
+      if ( count <= 0 )
+      {
+         break;
+      }
+      const char* first = &chunk.front();
+      const char* last  = first + count;
+      const char* bad   =
+         std::find_if( first, last,
+                       [](char c){ return !isKeywordlistCharacter( (ossim_uint8)c ); } );
+      if ( bad != last )
+      {
+         buffer.append( first, bad + 1 );
+         break;
+      }
+      buffer.append( first, last );
+   }
 
-      state = readPreprocDirective(is);
-      if(state & KeywordlistParseState_BAD_STREAM)
-         return false;
+   return parseBuffer( buffer.data(), buffer.data() + buffer.size() );
+}
+
+bool ossimKeywordlist::parseBuffer(const char* pos, const char* end)
+{
+   std::string key;
+   std::string value;
+   while ( true )
+   {
+      while ( (pos < end) &&
+              ( (*pos == ' ') || (*pos == '\t') || (*pos == '\n') || (*pos == '\r') ) )
+      {
+         ++pos;
+      }
+      if ( pos == end )
+      {
+         return true; // we skipped to end so valid keyword list
+      }
 
-      // if we failed a preprocessor directive parse then try comment parse.
-      if(state == KeywordlistParseState_FAIL)
+      // Preprocessor directive, the whole line:
+      if ( *pos == '#' )
       {
-         state = readComments(sequence, is);
-         if(state & KeywordlistParseState_BAD_STREAM)
+         value.clear();
+         if ( scanValue(pos, end, value) != KeywordlistParseState_OK )
+         {
             return false;
+         }
+         processPreprocDirective( ossimString(value) );
+         continue;
       }
 
-      // if we failed a comment parse then try key value parse.
-      if(state == KeywordlistParseState_FAIL)
+      // Comment to the end of the line:
+      if ( (*pos == '/') && (pos + 1 < end) && (pos[1] == '/') )
       {
-         key = sequence; // just in case there is a 1 token look ahead residual for a single slash test.
-         ossimKeywordlist::KeywordlistParseState testKeyValueState = readKeyAndValuePair(key, value, is);
-         if(testKeyValueState == KeywordlistParseState_OK)
+         for ( pos += 2; pos < end; )
          {
-            key = key.trim();
-            if(key.empty())
-               return true;
+            char c = *pos++;
+            if ( !isKeywordlistCharacter( (ossim_uint8)c ) )
+            {
+               return false;
+            }
+            if ( (c == '\n') || (c == '\r') )
+            {
+               break;
+            }
+         }
+         continue;
+      }
 
-            if ( m_expandEnvVars == true )
-               value = value.expandEnvironmentVariable();
-            m_map.insert(std::make_pair(key.string(), value.string()));
+      // Key, up to the delimiter:
+      const char* keyStart = pos;
+      while ( true )
+      {
+         if ( pos == end )
+         {
+            return false; // we never found a delimeter so we are mal formed
          }
-         else if(testKeyValueState & KeywordlistParseState_BAD_STREAM)
+         char c = *pos++;
+         if ( !isKeywordlistCharacter( (ossim_uint8)c ) )
          {
             return false;
          }
-#if 0
-         // Commented out to allow an invalid line in keyword list without
-         // erroring out, effectively skipping bad line. drb - 01 Sep. 2001
-         else
+         if ( (c == '\n') || (c == '\r') )
          {
-            return false;
+            // Hit end of line with no delimiter, allowed on the last line only.
+            return ( pos == end );
          }
-#endif
+         if ( c == m_delimiter )
+         {
+            break;
+         }
+      }
+      const char* keyEnd = pos - 1;
+      while ( (keyStart < keyEnd) &&
+              ( (*keyStart == ' ') || (*keyStart == '\t') ) )
+      {
+         ++keyStart;
+      }
+      while ( (keyEnd > keyStart) &&
+              ( (keyEnd[-1] == ' ') || (keyEnd[-1] == '\t') ) )
+      {
+         --keyEnd;
       }
-      else if(state & KeywordlistParseState_BAD_STREAM)
+      key.assign( keyStart, keyEnd );
+
+      value.clear();
+      if ( scanValue(pos, end, value) != KeywordlistParseState_OK )
       {
          return false;
       }
-      sequence = key = value = "";
-   }   
-   
-   return true;
+      if ( key.empty() )
+      {
+         return true;
+      }
+
+      if ( m_expandEnvVars == true )
+      {
+         value = ossimString(value).expandEnvironmentVariable().string();
+      }
+      m_map.insert( std::make_pair(key, value) );
+   }
+}
+
+ossimKeywordlist::KeywordlistParseState ossimKeywordlist::scanValue(const char*& pos,
+                                                                    const char* end,
+                                                                    std::string& value)const
+{
+   // make sure we check for a blank value
+   while ( pos < end )
+   {
+      if ( (*pos == ' ') || (*pos == '\t') )
+      {
+         ++pos;
+      }
+      else if ( (*pos == '\n') || (*pos == '\r') )
+      {
+         ++pos;
+         return KeywordlistParseState_OK;
+      }
+      else
+      {
+         break;
+      }
+   }
+
+   // Common case, one line.  Appended in one go.
+   static const char TRIPLE_QUOTE[] = "\"\"\"";
+   if ( (end - pos < 3) || !std::equal(TRIPLE_QUOTE, TRIPLE_QUOTE + 3, pos) )
+   {
+      const char* start = pos;
+      while ( (pos < end) && (*pos != '\n') && (*pos != '\r') )
+      {
+         if ( !isKeywordlistCharacter( (ossim_uint8)*pos ) )
+         {
+            return KeywordlistParseState_BAD_STREAM;
+         }
+         ++pos;
+      }
+      value.append( start, pos );
+      if ( pos < end )
+      {
+         ++pos;
+      }
+      return KeywordlistParseState_OK;
+   }
+
+   //---
+   // Leading tripple quotes: line breaks are kept up to the closing quotes,
+   // preserving paragraph style strings.
+   //---
+   ossim_int32 quoteCount = 0;
+   while ( pos < end )
+   {
+      char c = *pos++;
+      if ( !isKeywordlistCharacter( (ossim_uint8)c ) )
+      {
+         return KeywordlistParseState_BAD_STREAM;
+      }
+      if ( ( (c == '\n') || (c == '\r') ) && !quoteCount )
+      {
+         break;
+      }
+      value += c;
+      if ( value.size() > 2 )
+      {
+         if ( quoteCount < 1 )
+         {
+            if ( value.compare(0, 3, TRIPLE_QUOTE) == 0 )
+            {
+               ++quoteCount;
+            }
+         }
+         else if ( value.compare(value.size() - 3, 3, TRIPLE_QUOTE) == 0 )
+         {
+            ++quoteCount;
+         }
+      }
+      if ( quoteCount > 1 )
+      {
+         //---
+         // Have leading and trailing tripple quotes. Some tiff writers, e.g. Space
+         // Imaging are using four quotes.  Below code strips all quotes from each end.
+         //---
+         std::string::size_type startPos = value.find_first_not_of('"');
+         std::string::size_type stopPos  = value.find_last_not_of('"');
+         if ( ( startPos != std::string::npos ) && (stopPos != std::string::npos) )
+         {
+            value = value.substr( startPos, stopPos-startPos+1 );
+         }
+         break;
+      }
+   }
+   return KeywordlistParseState_OK;
 }
 
 void ossimKeywordlist::getSortedList(std::vector<ossimString>& prefixValues,
@@ -1116,7 +1340,7 @@ std::vector<ossimString> ossimKeywordlist::findAllKeysThatContains(const ossimSt
    
    for(i = m_map.begin(); i != m_map.end(); ++i)
    {
-      if( ossimString((*i).first).contains(searchString))
+      if( (*i).first.find(searchString.string()) != std::string::npos )
       {
          result.push_back((*i).first);
       }
@@ -1128,10 +1352,11 @@ std::vector<ossimString> ossimKeywordlist::findAllKeysThatContains(const ossimSt
 void ossimKeywordlist::findAllKeysThatMatch( std::vector<ossimString>& result,
                                              const ossimString &regularExpression ) const
 {
-   KeywordMap::const_iterator i;
    ossimRegExp regExp;
    regExp.compile(regularExpression.c_str());
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getCandidateRange(m_map, regularExpression);
+   for(KeywordMap::const_iterator i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1144,10 +1369,11 @@ ossim_uint32  ossimKeywordlist::getNumberOfKeysThatMatch(
    const ossimString &regularExpression ) const
 {
    ossim_uint32 result = 0;
-   KeywordMap::const_iterator i;
    ossimRegExp regExp;
    regExp.compile(regularExpression.c_str());
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getCandidateRange(m_map, regularExpression);
+   for(KeywordMap::const_iterator i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1160,13 +1386,13 @@ ossim_uint32  ossimKeywordlist::getNumberOfKeysThatMatch(
 void ossimKeywordlist::extractKeysThatMatch(ossimKeywordlist& kwl,
                                             const ossimString &regularExpression)const
 {
-   KeywordMap::const_iterator i;
-   std::vector<ossimString> result;
    ossimRegExp regExp;
    
    regExp.compile(regularExpression.c_str());
    
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getCandidateRange(m_map, regularExpression);
+   for(KeywordMap::const_iterator i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1177,22 +1403,23 @@ void ossimKeywordlist::extractKeysThatMatch(ossimKeywordlist& kwl,
 
 void ossimKeywordlist::removeKeysThatMatch(const ossimString &regularExpression)
 {
-   KeywordMap::const_iterator i;
-   std::vector<ossimString> result;
    ossimRegExp regExp;
    
    regExp.compile(regularExpression.c_str());
    
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getCandidateRange(m_map, regularExpression);
+   KeywordMap::const_iterator i = range.first;
+   while(i != range.second)
    {
       if(regExp.find( (*i).first.c_str()))
       {
-         result.push_back((*i).first);
+         i = m_map.erase(i);
+      }
+      else
+      {
+         ++i;
       }
-   }
-   for(ossim_uint32 i2 = 0; i2 < result.size(); ++i2)
-   {
-      remove(result[i2]);
    }
 }
 
@@ -1206,19 +1433,26 @@ std::vector<ossimString> ossimKeywordlist::getSubstringKeyList(const ossimString
 void ossimKeywordlist::getSubstringKeyList(std::vector<ossimString>& result,
                                            const ossimString& regularExpression)const
 {
-   KeywordMap::const_iterator i;
    ossimRegExp regExp;
    
    regExp.compile(regularExpression.c_str());
    
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   // Substrings already in the list, the list is not cleared.
+   std::set<std::string> found;
+   for(std::vector<ossimString>::const_iterator r = result.begin(); r != result.end(); ++r)
+   {
+      found.insert( (*r).string() );
+   }
+
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getCandidateRange(m_map, regularExpression);
+   std::string value;
+   for(KeywordMap::const_iterator i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
-         ossimString value = ossimString((*i).first.begin()+regExp.start(),
-                                         (*i).first.begin()+regExp.start()+regExp.end());
-         
-         if(std::find(result.begin(), result.end(), value) == result.end())
+         value.assign( (*i).first, regExp.start(), regExp.end() - regExp.start() );
+         if( found.insert(value).second )
          {
             result.push_back(value);
          }
@@ -1228,7 +1462,6 @@ void ossimKeywordlist::getSubstringKeyList(std::vector<ossimString>& result,
 
 ossim_uint32 ossimKeywordlist::getNumberOfSubstringKeys(const ossimString& regularExpression)const
 {
-   KeywordMap::const_iterator i;
    std::vector<ossimString> currentList;
    getSubstringKeyList(currentList, regularExpression);
    return (ossim_uint32)currentList.size();
@@ -1295,7 +1528,7 @@ void ossimKeywordlist::stripPrefixFromAll(const ossimString& regularExpression)
       if(regExp.find( (*values).first.c_str()))
       {
          newKey.erase(newKey.begin()+regExp.start(),
-                      newKey.begin()+regExp.start()+regExp.end());
+                      newKey.begin()+regExp.end());
          
          addPair(newKey, (*values).second, true);
       }
@@ -24,6 +24,9 @@ static std::ostream* theOssimNoticeStream = &std::cout;
 static std::ostream* theOssimDebugStream  = &std::cout;
 static std::ostream* theOssimAlwaysStream = &std::cout;
 
+// Stands in for std::cout on the calling thread, see ossimSetThreadNotifyStream.
+static thread_local std::ostream* theThreadNotifyStream = 0;
+
 static std::mutex theMutex;
 static ossimNotifyFlags theNotifyFlags     = ossimNotifyFlags_ALL;
 std::stack<ossimNotifyFlags> theNotifyFlagsStack;
@@ -235,9 +238,18 @@ std::ostream* ossimGetNotifyStream(ossimNotifyLevel whichLevel)
          break;
       }
    }
+   if(theThreadNotifyStream && (notifyStream == &std::cout))
+   {
+      notifyStream = theThreadNotifyStream;
+   }
    return notifyStream;
 }
 
+void ossimSetThreadNotifyStream(std::ostream* outputStream)
+{
+   theThreadNotifyStream = outputStream;
+}
+
 OSSIMDLLEXPORT std::ostream& ossimNotify(ossimNotifyLevel level)
 {
    if(ossimIsReportingEnabled())
@@ -13,6 +13,7 @@
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimPreferences.h>
 #include <ossim/base/BlockIStream.h>
+#include <ossim/base/SharedBlockIStream.h>
 
 #include <fstream>
 #include <algorithm>
@@ -21,6 +22,7 @@
 
 ossim::StreamFactoryRegistry* ossim::StreamFactoryRegistry::m_instance = 0;
 static const char* ISTREAM_BUFFER_KW = "ossim.stream.factory.registry.istream.buffer";
+static const char* BLOCK_CACHE_SIZE_KW = "ossim.stream.factory.registry.block_cache.size";
 static ossimTrace traceDebug("ossimStreamFactoryRegistry:debug");
 static std::mutex m_instanceMutex;
 ossim::StreamFactoryRegistry::StreamFactoryRegistry()
@@ -82,6 +84,8 @@ void ossim::StreamFactoryRegistry::loadPreferences()
       ossimString bufferIStreamBlockEnabled   = ossimPreferences::instance()->findPreference(prefix+".enableBlocked");
       ossimString bufferIStreamIncludePattern = ossimPreferences::instance()->findPreference(prefix+".includePattern");
       ossimString bufferIStreamSize           = ossimPreferences::instance()->findPreference(prefix+".size");
+      ossimString bufferIStreamSharedEnabled  = ossimPreferences::instance()->findPreference(prefix+".enableShared");
+      ossimString bufferIStreamStreams        = ossimPreferences::instance()->findPreference(prefix+".streams");
 
       if(!bufferIStreamSize.empty())
       {
@@ -95,6 +99,14 @@ void ossim::StreamFactoryRegistry::loadPreferences()
       {
          m_bufferInfoList[idx].m_enableBlocked = bufferIStreamBlockEnabled.toBool();
       }
+      if(!bufferIStreamSharedEnabled.empty())
+      {
+         m_bufferInfoList[idx].m_enableShared = bufferIStreamSharedEnabled.toBool();
+      }
+      if(!bufferIStreamStreams.empty())
+      {
+         m_bufferInfoList[idx].m_streams = bufferIStreamStreams.toUInt32();
+      }
       if(!bufferIStreamIncludePattern.empty())
       {
          m_bufferInfoList[idx].m_pattern = bufferIStreamIncludePattern;
@@ -105,11 +117,20 @@ void ossim::StreamFactoryRegistry::loadPreferences()
          << "ossim::StreamFactoryRegistry adding BufferInfo: \n"
          << "enabled:       " << ossimString::toString(m_bufferInfoList[idx].m_enabled)<< "\n"
          << "enableBlocked: " << ossimString::toString(m_bufferInfoList[idx].m_enableBlocked)<< "\n"
+         << "enableShared:  " << ossimString::toString(m_bufferInfoList[idx].m_enableShared)<< "\n"
+         << "streams:       " << m_bufferInfoList[idx].m_streams << "\n"
          << "size:          " << m_bufferInfoList[idx].m_size << "\n"
          << "pattern:       " << m_bufferInfoList[idx].m_pattern << "\n";
       }
 
    }
+
+   ossimString blockCacheSize = ossimPreferences::instance()->findPreference(BLOCK_CACHE_SIZE_KW);
+   if(!blockCacheSize.empty())
+   {
+      ossim::BlockCache::instance()->setMaxBytes(blockCacheSize.toUInt64());
+   }
+
    if(traceDebug())
    {
       ossimNotify(ossimNotifyLevel_WARN)
@@ -167,7 +188,25 @@ std::shared_ptr<ossim::istream> ossim::StreamFactoryRegistry::createIstream(
          BufferInfo bufferInfo;
          if(getBufferInfo(bufferInfo, connectionString))
          {
-            if(bufferInfo.m_enableBlocked)
+            if(bufferInfo.m_enableShared)
+            {
+               // More connections on the url come from the same factory:
+               ossim::StreamFactoryBase* factory = m_factoryList[i];
+               ossimKeywordlist factoryOptions = options;
+               ossim::BlockSource::Opener opener =
+                  [factory, connectionString, factoryOptions, openMode]()
+                  {
+                     return factory->createIstream(connectionString, factoryOptions, openMode);
+                  };
+               std::shared_ptr<ossim::BlockSource> source =
+                  ossim::BlockSource::get(connectionString, bufferInfo.m_size,
+                                          result, opener, bufferInfo.m_streams);
+               if(source)
+               {
+                  result = std::make_shared<ossim::SharedBlockIStream>(source);
+               }
+            }
+            else if(bufferInfo.m_enableBlocked)
             {
                result = std::make_shared<ossim::BlockIStream>(result, bufferInfo.m_size);
             }
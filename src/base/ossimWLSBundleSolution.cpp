@@ -13,7 +13,9 @@
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimTimer.h>
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -28,6 +30,30 @@ static ossimTrace traceExec(ossimString("ossimWLSBundleSolution:exec"));
 //  
 //*****************************************************************************
 ossimWLSBundleSolution::ossimWLSBundleSolution()
+   :
+      theSolValid(false),
+      theSolverType(SPARSE_CHOLESKY_SOLVER),
+      theComputeCovariance(true),
+      theMaxFullCovRank(3000),
+      theStatistics()
+{
+}
+
+
+//*****************************************************************************
+//  METHOD: ossimWLSBundleSolution::Statistics::Statistics()
+//  
+//  Constructor.
+//  
+//*****************************************************************************
+ossimWLSBundleSolution::Statistics::Statistics()
+   :
+      theReducedRank(0),
+      theFullRank(0),
+      theFormTime(0.0),
+      theSolveTime(0.0),
+      theCovarianceTime(0.0),
+      theMatrixStatistics()
 {
 }
 
@@ -58,9 +84,29 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
       ossimNotify(ossimNotifyLevel_DEBUG)
          << "\nossimWLSBundleSolution::run DEBUG:" << std::endl;
    }
-   
+
+   theStatistics = Statistics();
+
+   if (theSolverType == DENSE_SOLVER)
+      return runDense(solAttributes);
+   else
+      return runSparse(solAttributes);
+}
+
+
+//*****************************************************************************
+//  METHOD: ossimWLSBundleSolution::runDense()
+//  
+//  Form and solve the full normal equation system.
+//  
+//*****************************************************************************
+bool ossimWLSBundleSolution::runDense(ossimAdjSolutionAttributes* solAttributes)
+{
    theSolValid = false;
 
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t startTick = timer->tick();
+
 
    // Initialize traits
    int numObs    = solAttributes->numObjObs();
@@ -82,6 +128,9 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
    // Full rank
    Nrank += numObs*3;
 
+   theStatistics.theReducedRank = Nd_rank;
+   theStatistics.theFullRank = Nrank;
+
    if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -233,8 +282,8 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
          // SUM Ndd into N
          N.SymSubMatrix(NddIdx,NddIdx+2) += Ndd;
 
-         // INSERT Nb into N
-         N.SubMatrix(NdIdx,NdIdx+cNumPar-1,NddIdx,NddIdx+2) = Nb;
+         // SUM Nb into N
+         N.SubMatrix(NdIdx,NdIdx+cNumPar-1,NddIdx,NddIdx+2) += Nb;
 
          // SUM Cd into C
          C.Rows(NdIdx,NdIdx+cNumPar-1) += Cd;
@@ -263,6 +312,9 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
    //******************************
    NEWMAT::LowerTriangularMatrix Nl = N.t();
 
+   theStatistics.theFormTime = timer->delta_s(startTick);
+   startTick = timer->tick();
+
    // Solve
    //   Note: solveSystem uses 1-based indexing
 	if (!solveSystem(Nl.Store()-1, C.Store()-1, D.Store()-1, Nrank))
@@ -272,6 +324,8 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
    else
    {
       theSolValid = true;
+      theStatistics.theSolveTime = timer->delta_s(startTick);
+      startTick = timer->tick();
 
       //******************
       // load corrections 
@@ -284,9 +338,17 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
       // load covariance matrix 
       //   Note: recurBack uses 1-based indexing
       //************************
-      if (recurBack(Nl.Store()-1, Nrank))
+      if (!theComputeCovariance)
+      {
+         solAttributes->theFullCovMatrix.CleanUp();
+         solAttributes->theVariances = 0.0;
+      }
+      else if (recurBack(Nl.Store()-1, Nrank))
       {
          solAttributes->theFullCovMatrix = Nl.t();
+         for (int i=1; i<=Nrank; ++i)
+            solAttributes->theVariances(i) = solAttributes->theFullCovMatrix(i,i);
+         theStatistics.theCovarianceTime = timer->delta_s(startTick);
       }
       else
       {
@@ -298,6 +360,460 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
 }
 
 
+//*****************************************************************************
+//  METHOD: ossimWLSBundleSolution::runSparse()
+//  
+//  Eliminate the ground points and solve the reduced camera system,
+//  stored block sparse, one block per image with adjustable parameters.
+//  With N partitioned as [Nd Nb; Nb' Ndd], the reduced system is
+//  (Nd - Nb Ndd^-1 Nb') Dd = Cd - Nb Ndd^-1 Cdd, and each ground point
+//  follows from Ddd = Ndd^-1 (Cdd - Nb' Dd).
+//  
+//*****************************************************************************
+bool ossimWLSBundleSolution::runSparse(ossimAdjSolutionAttributes* solAttributes)
+{
+   theSolValid = false;
+
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t startTick = timer->tick();
+
+   // Initialize traits
+   int numObs    = solAttributes->numObjObs();
+   int numImages = solAttributes->numImages();
+
+   // Images without adjustable parameters get no block.  Their parameters
+   // take no rows, so the reduced rows match the full ones.
+   std::vector<int> NdIndex(numImages);
+   std::vector<int> imgBlock(numImages, -1);
+   std::vector<ossim_uint32> blockSizes;
+   int Nd_rank = 0;
+   for (int n=0; n<numImages; ++n)
+   {
+      int numpar = solAttributes->theImgNumparXref[n];
+      NdIndex[n] = Nd_rank + 1;
+      if (numpar > 0)
+      {
+         imgBlock[n] = (int)blockSizes.size();
+         blockSizes.push_back(numpar);
+      }
+      Nd_rank += numpar;
+   }
+   int Nrank = Nd_rank + numObs*3;
+
+   theStatistics.theReducedRank = Nd_rank;
+   theStatistics.theFullRank = Nrank;
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         <<"\n Sparse bundle........"
+         <<"\n   numObs    = "<<numObs
+         <<"\n   numImages = "<<numImages
+         <<"\n   Nd_rank   = "<<Nd_rank
+         <<"\n   Nrank     = "<<Nrank<<std::endl;
+   }
+
+   // REDUCED NORMAL EQUATION ARRAYS
+   ossim::SparseBlockMatrix S;            // reduced coefficient matrix
+   S.create(blockSizes);
+   NEWMAT::ColumnVector C(Nd_rank);       // reduced normal constant vector
+   C = 0.0;
+
+   // IMAGE PARTITION ARRAYS (for image having "p" parameters)
+   NEWMAT::Matrix Bd;                     // [B-dot] matrix            (2Xp)
+   NEWMAT::Matrix Bdt_w;                  // [B-dot(t) * w] matrix     (pX2)
+   NEWMAT::Matrix Nd;                     // [N-dot] matrix            (pXp)
+   NEWMAT::Matrix Nb;                     // [N-bar] matrix            (pX3)
+
+   NEWMAT::ColumnVector eps(2);           // image pt residual matrix  (2X1)
+   NEWMAT::Matrix w(2,2);                 // image pt weight matrix    (2X2)
+
+   // GROUND PARTITION ARRAYS
+   NEWMAT::Matrix Bdd(2,3);               // [B-dbl-dot] matrix        (2X3)
+   NEWMAT::Matrix Bddt_w(3,2);            // [B-dbl-dot(t) * w] matrix (3X2)
+   NEWMAT::Matrix Ndd(3,3);               // [N-dbl-dot] matrix        (3X3)
+   NEWMAT::ColumnVector Cdd(3);           // [C-dbl_dot] matrix        (3X1)
+
+   // Per object point: Ndd inverse, Cdd, and N-bar of each image
+   std::vector<NEWMAT::Matrix> NddInv(numObs);
+   std::vector<NEWMAT::ColumnVector> CddObs(numObs);
+   std::vector< std::vector<int> > obsImgs(numObs);
+   std::vector< std::vector<NEWMAT::Matrix> > obsNb(numObs);
+
+   // initialize reduced partitions with weights
+   for (int img=0; img<numImages; img++)
+   {
+      if (imgBlock[img] < 0)
+         continue;
+      int size = solAttributes->theImgNumparXref[img];
+      int rcBeg = NdIndex[img];
+      int rcEnd = rcBeg+size-1;
+
+      NEWMAT::Matrix Wd(size,size);
+      Wd = solAttributes->theAdjParCov.SubMatrix(rcBeg,rcEnd,rcBeg,rcEnd).i();
+
+      NEWMAT::ColumnVector Ed(size);
+      Ed = solAttributes->theTotalCorrections.Rows(rcBeg,rcEnd);
+
+      std::copy(Wd.Store(), Wd.Store()+size*size, S.block(imgBlock[img], imgBlock[img]));
+      C.Rows(rcBeg,rcEnd) = Wd * Ed;
+   }
+
+   //*******************
+   // object point loop 
+   //*******************
+   int cMeas = 1;
+   int cImgIdx = 1;
+   int cObjIdx = 1;
+
+   for (int obs=0; obs<numObs; obs++)
+   {
+      // Initialize Ndd & Cdd partitions with weight matrix
+      int idx = obs*3 + 1;
+      Ndd = solAttributes->theObjectPtCov.Rows(idx,idx+2).i();
+      int NddIdx = Nd_rank + idx;
+
+      NEWMAT::ColumnVector Edd(3);
+      Edd = solAttributes->theTotalCorrections.Rows(NddIdx, NddIdx+2);
+      Cdd = Ndd * Edd;
+
+      std::vector<int>& imgs = obsImgs[obs];
+      std::vector<NEWMAT::Matrix>& Nbs = obsNb[obs];
+
+      //*******************************************
+      // image point loop for current object point 
+      //*******************************************
+      int nMeasOnObs = (int) solAttributes->theObjImgXref.count(obs);
+      ObjImgMapIterPair_t imgRng;
+      imgRng = solAttributes->theObjImgXref.equal_range(obs);
+      ObjImgMapIter_t currImg = imgRng.first;
+
+      for (int meas=0; meas<nMeasOnObs; meas++)
+      {
+         // object point partials
+         Bdd = solAttributes->theObjPartials.Rows(cObjIdx,cObjIdx+2).t();
+         cObjIdx += 3;
+
+         //image parameter partials
+         int cNumPar = solAttributes->theImgNumparXref[currImg->second];
+
+         // residuals
+         eps = solAttributes->theMeasResiduals.Row(cMeas).t();
+
+         // compute N-dd & C-dd contributions
+         int start = (cMeas-1)*2 + 1;
+         w = solAttributes->theImagePtCov.Rows(start,start+1).i();
+         Bddt_w = Bdd.t() * w;
+         Ndd += Bddt_w * Bdd;
+         Cdd += Bddt_w * eps;
+
+         if (cNumPar > 0)
+         {
+            // compute N-dot, C-dot & N-bar contributions
+            int NdIdx = NdIndex[currImg->second];
+            int blk = imgBlock[currImg->second];
+            Bd = solAttributes->theParPartials.Rows(cImgIdx,cImgIdx+cNumPar-1).t();
+            Bdt_w = Bd.t() * w;
+            Nd = Bdt_w * Bd;
+            Nb = Bdt_w * Bdd;
+
+            // SUM Nd into S
+            double* sd = S.block(blk, blk);
+            const double* nd = Nd.Store();
+            for (int i=0; i<cNumPar*cNumPar; ++i)
+               sd[i] += nd[i];
+
+            // SUM Cd into C
+            C.Rows(NdIdx,NdIdx+cNumPar-1) += Bdt_w * eps;
+
+            // SUM Nb into the point's image list
+            std::vector<int>::iterator it = std::find(imgs.begin(), imgs.end(), blk);
+            if (it == imgs.end())
+            {
+               imgs.push_back(blk);
+               Nbs.push_back(Nb);
+            }
+            else
+            {
+               Nbs[it-imgs.begin()] += Nb;
+            }
+         }
+
+         // Increment index counters
+         cImgIdx += cNumPar;
+         cMeas++;
+         currImg++;
+      }
+      //**********************
+      // END image point loop 
+      //**********************
+
+      // Eliminate the point: S -= Nb Ndd^-1 Nb', C -= Nb Ndd^-1 Cdd
+      NddInv[obs] = Ndd.i();
+      CddObs[obs] = Cdd;
+      for (std::vector<int>::size_type a=0; a<imgs.size(); ++a)
+      {
+         NEWMAT::Matrix NbNddInv = Nbs[a] * NddInv[obs];
+         int rowBeg = S.getOffset(imgs[a]) + 1;
+         C.Rows(rowBeg, rowBeg+Nbs[a].Nrows()-1) -= NbNddInv * Cdd;
+         for (std::vector<int>::size_type b=0; b<imgs.size(); ++b)
+         {
+            if (imgs[b] > imgs[a])
+               continue;
+            NEWMAT::Matrix Sab = NbNddInv * Nbs[b].t();
+            double* sab = S.block(imgs[a], imgs[b]);
+            const double* s = Sab.Store();
+            for (int i=0; i<Sab.Nrows()*Sab.Ncols(); ++i)
+               sab[i] -= s[i];
+         }
+      }
+   }
+   //***********************
+   // END object point loop 
+   //***********************
+
+   theStatistics.theFormTime = timer->delta_s(startTick);
+   startTick = timer->tick();
+
+
+   //*******************************
+   // solve reduced camera system
+   //*******************************
+   NEWMAT::ColumnVector Dd(Nd_rank);
+   Dd = 0.0;
+   bool solved = false;
+   if (Nd_rank == 0)
+   {
+      solved = true;
+   }
+   else if (theSolverType == SPARSE_PCG_SOLVER)
+   {
+      solved = S.solvePcg(C.Store(), Dd.Store(), 1.0e-12, 2*Nd_rank + 10);
+      if (!solved)
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimWLSBundleSolution::runSparse WARNING: conjugate gradients"
+            << " did not converge, factoring instead." << std::endl;
+      }
+   }
+   if (!solved)
+   {
+      solved = S.factor() && S.solve(C.Store(), Dd.Store());
+   }
+   if (!solved)
+   {
+      theStatistics.theMatrixStatistics = S.getStatistics();
+      return theSolValid;
+   }
+
+   //*******************************
+   // back substitute object points
+   //*******************************
+   NEWMAT::ColumnVector D(Nrank);
+   if (Nd_rank > 0)
+      D.Rows(1, Nd_rank) = Dd;
+   for (int obs=0; obs<numObs; obs++)
+   {
+      NEWMAT::ColumnVector Cr = CddObs[obs];
+      for (std::vector<int>::size_type a=0; a<obsImgs[obs].size(); ++a)
+      {
+         int rowBeg = S.getOffset(obsImgs[obs][a]) + 1;
+         const NEWMAT::Matrix& Nba = obsNb[obs][a];
+         Cr -= Nba.t() * Dd.Rows(rowBeg, rowBeg+Nba.Nrows()-1);
+      }
+      int NddIdx = Nd_rank + obs*3 + 1;
+      D.Rows(NddIdx, NddIdx+2) = NddInv[obs] * Cr;
+   }
+
+   theSolValid = true;
+   theStatistics.theSolveTime = timer->delta_s(startTick);
+   startTick = timer->tick();
+
+   //******************
+   // load corrections 
+   //******************
+   solAttributes->theLastCorrections = -D;
+   solAttributes->theTotalCorrections -= D;
+
+
+   //************************
+   // load covariance matrix 
+   //   Z = S^-1 gives the image partition; the rest follows from
+   //   Cov(Dd,Ddd) = -Z Nb Ndd^-1 and
+   //   Cov(Ddd,Ddd) = Ndd^-1 + Ndd^-1 Nb' Z Nb Ndd^-1.
+   //************************
+   solAttributes->theFullCovMatrix.CleanUp();
+   solAttributes->theVariances = 0.0;
+   if (!theComputeCovariance)
+   {
+      theStatistics.theMatrixStatistics = S.getStatistics();
+      return theSolValid;
+   }
+   if ((Nd_rank > 0) && !S.isFactored() && !S.factor())
+   {
+      theSolValid = false;
+      theStatistics.theMatrixStatistics = S.getStatistics();
+      return theSolValid;
+   }
+
+   if (Nrank <= theMaxFullCovRank)
+   {
+      // Image partition, one solve per column
+      NEWMAT::Matrix Z(Nd_rank, Nd_rank);
+      NEWMAT::ColumnVector e(Nd_rank);
+      NEWMAT::ColumnVector z(Nd_rank);
+      for (int j=1; j<=Nd_rank; ++j)
+      {
+         e = 0.0;
+         e(j) = 1.0;
+         S.solve(e.Store(), z.Store());
+         Z.Column(j) = z;
+      }
+
+      NEWMAT::UpperTriangularMatrix& cov = solAttributes->theFullCovMatrix;
+      cov.ReSize(Nrank);
+      cov = 0.0;
+      for (int i=1; i<=Nd_rank; ++i)
+         for (int j=i; j<=Nd_rank; ++j)
+            cov(i,j) = Z(i,j);
+
+      // Image vs. object point partitions, G = -Z Nb Ndd^-1
+      std::vector<NEWMAT::Matrix> G(numObs);
+      for (int obs=0; obs<numObs; obs++)
+      {
+         G[obs].ReSize(Nd_rank, 3);
+         G[obs] = 0.0;
+         for (std::vector<int>::size_type a=0; a<obsImgs[obs].size(); ++a)
+         {
+            int colBeg = S.getOffset(obsImgs[obs][a]) + 1;
+            const NEWMAT::Matrix& Nba = obsNb[obs][a];
+            G[obs] -= Z.Columns(colBeg, colBeg+Nba.Nrows()-1) * Nba;
+         }
+         G[obs] = G[obs] * NddInv[obs];
+         int NddIdx = Nd_rank + obs*3 + 1;
+         for (int i=1; i<=Nd_rank; ++i)
+            for (int k=0; k<3; ++k)
+               cov(i,NddIdx+k) = G[obs](i,k+1);
+      }
+
+      // Object point partitions, Ndd^-1 (I - Nb' G)
+      for (int j=0; j<numObs; j++)
+      {
+         int jIdx = Nd_rank + j*3 + 1;
+         for (int k=j; k<numObs; k++)
+         {
+            int kIdx = Nd_rank + k*3 + 1;
+            NEWMAT::Matrix NbtG(3,3);
+            NbtG = 0.0;
+            for (std::vector<int>::size_type a=0; a<obsImgs[j].size(); ++a)
+            {
+               int rowBeg = S.getOffset(obsImgs[j][a]) + 1;
+               const NEWMAT::Matrix& Nba = obsNb[j][a];
+               NbtG += Nba.t() * G[k].Rows(rowBeg, rowBeg+Nba.Nrows()-1);
+            }
+            NEWMAT::Matrix Cjk = -(NddInv[j] * NbtG);
+            if (j == k)
+               Cjk += NddInv[j];
+            for (int r=0; r<3; ++r)
+               for (int c=(j==k ? r : 0); c<3; ++c)
+                  cov(jIdx+r,kIdx+c) = Cjk(r+1,c+1);
+         }
+      }
+
+      for (int i=1; i<=Nrank; ++i)
+         solAttributes->theVariances(i) = cov(i,i);
+   }
+   else
+   {
+      // Variances only, from the inverse blocks on the factor's pattern
+      if ((Nd_rank > 0) && !S.computeInverse())
+      {
+         theSolValid = false;
+         theStatistics.theMatrixStatistics = S.getStatistics();
+         return theSolValid;
+      }
+
+      std::vector<double> Zab(Nd_rank > 0 ? 
+         *std::max_element(blockSizes.begin(), blockSizes.end()) *
+         *std::max_element(blockSizes.begin(), blockSizes.end()) : 0);
+      for (ossim_uint32 b=0; b<S.getNumberOfBlocks(); ++b)
+      {
+         ossim_uint32 size = S.getBlockSize(b);
+         S.getInverseBlock(b, b, &Zab.front());
+         for (ossim_uint32 r=0; r<size; ++r)
+            solAttributes->theVariances(S.getOffset(b)+r+1) = Zab[r*size+r];
+      }
+
+      for (int obs=0; obs<numObs; obs++)
+      {
+         const std::vector<int>& imgs = obsImgs[obs];
+         NEWMAT::Matrix Q(3,3);
+         Q = 0.0;
+         for (std::vector<int>::size_type a=0; a<imgs.size(); ++a)
+         {
+            for (std::vector<int>::size_type b=0; b<imgs.size(); ++b)
+            {
+               int rows = obsNb[obs][a].Nrows();
+               int cols = obsNb[obs][b].Nrows();
+               S.getInverseBlock(imgs[a], imgs[b], &Zab.front());
+               NEWMAT::Matrix Z(rows, cols);
+               std::copy(Zab.begin(), Zab.begin()+rows*cols, Z.Store());
+               Q += obsNb[obs][a].t() * Z * obsNb[obs][b];
+            }
+         }
+         NEWMAT::Matrix Cov = NddInv[obs] + NddInv[obs] * Q * NddInv[obs];
+         int NddIdx = Nd_rank + obs*3 + 1;
+         for (int k=0; k<3; ++k)
+            solAttributes->theVariances(NddIdx+k) = Cov(k+1,k+1);
+      }
+   }
+
+   theStatistics.theCovarianceTime = timer->delta_s(startTick);
+   theStatistics.theMatrixStatistics = S.getStatistics();
+
+   return theSolValid;
+}
+
+
+//*****************************************************************************
+//  METHOD: ossimWLSBundleSolution::printStatistics()
+//  
+//  Print timing and fill-in of the last run.
+//  
+//*****************************************************************************
+std::ostream& ossimWLSBundleSolution::printStatistics(std::ostream& out) const
+{
+   const char* solver[] = { "dense", "sparse cholesky", "sparse pcg" };
+   const ossim::SparseBlockMatrix::Statistics& ms = theStatistics.theMatrixStatistics;
+
+   out<<"\nSolution Statistics...";
+   out<<"\n  solver            = "<<solver[theSolverType];
+   out<<"\n  full rank         = "<<theStatistics.theFullRank;
+   out<<"\n  reduced rank      = "<<theStatistics.theReducedRank;
+   if (theSolverType != DENSE_SOLVER)
+   {
+      out<<"\n  reduced blocks    = "<<ms.m_blocks<<" ("<<ms.m_entries<<" values)";
+      if (ms.m_factorBlocks)
+      {
+         out<<"\n  factor blocks     = "<<ms.m_factorBlocks<<" ("<<ms.m_factorEntries
+            <<" values)";
+         out<<"\n  fill-in blocks    = "<<ms.m_factorBlocks-ms.m_blocks;
+      }
+      if (theSolverType == SPARSE_PCG_SOLVER)
+      {
+         out<<"\n  pcg iterations    = "<<ms.m_iterations
+            <<" (residual "<<ms.m_residual<<")";
+      }
+   }
+   out<<"\n  form time         = "<<theStatistics.theFormTime<<" s";
+   out<<"\n  solve time        = "<<theStatistics.theSolveTime<<" s";
+   out<<"\n  covariance time   = "<<theStatistics.theCovarianceTime<<" s";
+   out<<std::endl;
+
+   return out;
+}
+
+
 //*****************************************************************************
 // method: recursive forward solution
 //
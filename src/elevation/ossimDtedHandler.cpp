@@ -47,7 +47,10 @@ ossimDtedHandler::ossimDtedHandler(const ossimFilename& dted_file, bool memoryMa
       m_latSpacing(0.0),
       m_lonSpacing(0.0),
       m_swCornerPost(),
-      m_swapBytesFlag(false)
+      m_swapBytesFlag(false),
+      m_mappedFile(),
+      m_memoryMap(),
+      m_memoryMapData(0)
 {
 
    static const char MODULE[] = "ossimDtedHandler (Filename) Constructor";
@@ -113,9 +116,26 @@ bool ossimDtedHandler::getAccuracyInfo(ossimElevationAccuracyInfo& info,
   return info.hasValidAbsoluteError();
 }
 
+bool ossimDtedHandler::getMemoryMapUsage(ossim_uint64& residentBytes,
+                                         ossim_uint64& virtualBytes) const
+{
+   if(m_mappedFile.isOpen())
+   {
+      residentBytes = m_mappedFile.residentBytes();
+      virtualBytes  = m_mappedFile.size();
+   }
+   else
+   {
+      // Heap copy of a non-local stream is always resident.
+      residentBytes = m_memoryMap.size();
+      virtualBytes  = m_memoryMap.size();
+   }
+   return (m_memoryMapData != 0);
+}
+
 double ossimDtedHandler::getHeightAboveMSL(const ossimGpt& gpt)
 {
-   if(m_memoryMap.size())
+   if(m_memoryMapData)
    {
       return getHeightAboveMSL(gpt, false);
    }
@@ -127,6 +147,37 @@ double ossimDtedHandler::getHeightAboveMSL(const ossimGpt& gpt)
    return ossim::nan();
 }
 
+ossim_uint32 ossimDtedHandler::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                  ossim_uint32 count,
+                                                  ossim_float64* heights,
+                                                  bool* valid)
+{
+   bool readFromFile = false;
+   if(!m_memoryMapData)
+   {
+      if(!m_fileStr || !m_fileStr->good())
+      {
+         for(ossim_uint32 i = 0; i < count; ++i)
+         {
+            heights[i] = ossim::nan();
+            if(valid) valid[i] = false;
+         }
+         return 0;
+      }
+      readFromFile = true;
+   }
+
+   ossim_uint32 result = 0;
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      heights[i] = ossimDtedHandler::getHeightAboveMSL(gpts[i], readFromFile);
+      bool isValid = !ossim::isnan(heights[i]);
+      if(isValid) ++result;
+      if(valid) valid[i] = isValid;
+   }
+   return result;
+}
+
 bool ossimDtedHandler::open(const ossimFilename& file, bool memoryMapFlag)
 {
   std::string connectionString = file.c_str();
@@ -187,18 +238,6 @@ bool ossimDtedHandler::open(std::shared_ptr<ossim::istream>& fileStr,
     close();
     return false;
   }
-  if(memoryMapFlag)
-  {
-    ossim_int64 streamSize;
-    m_fileStr->clear();
-    m_fileStr->seekg(0, std::ios::end);
-    streamSize = m_fileStr->tellg();
-    m_fileStr->seekg(0, std::ios::beg);
-
-    m_memoryMap.resize(streamSize);//theFilename.fileSize());
-    m_fileStr->read((char*)(&m_memoryMap.front()), (std::streamsize)m_memoryMap.size());
-    m_fileStr.reset();
-  }
 
   m_numLonLines  = m_uhl->numLonLines();
   m_numLatPoints = m_uhl->numLatPoints();
@@ -212,6 +251,51 @@ bool ossimDtedHandler::open(std::shared_ptr<ossim::istream>& fileStr,
 
   m_offsetToFirstDataRecord = m_acc->stopOffset();
 
+  if(memoryMapFlag)
+  {
+    // Last byte any post lookup can touch.
+    ossim_uint64 requiredSize = static_cast<ossim_uint64>(m_offsetToFirstDataRecord) +
+       static_cast<ossim_uint64>(m_numLonLines)*m_dtedRecordSizeInBytes;
+
+    //---
+    // Map local files read only so the page cache is shared across processes
+    // and the open does not read the cell.  Anything else, i.e. a stream from
+    // a stream factory, is pulled into memory.
+    //---
+    if(m_mappedFile.open(m_connectionString) && (m_mappedFile.size() >= requiredSize))
+    {
+      m_memoryMapData = m_mappedFile.data();
+      m_fileStr.reset();
+    }
+    else
+    {
+      m_mappedFile.close();
+
+      ossim_int64 streamSize;
+      m_fileStr->clear();
+      m_fileStr->seekg(0, std::ios::end);
+      streamSize = m_fileStr->tellg();
+      m_fileStr->seekg(0, std::ios::beg);
+
+      if(streamSize >= static_cast<ossim_int64>(requiredSize))
+      {
+        m_memoryMap.resize(streamSize);
+        m_fileStr->read((char*)(&m_memoryMap.front()), (std::streamsize)m_memoryMap.size());
+        if(m_fileStr->good())
+        {
+          m_memoryMapData = &m_memoryMap.front();
+          m_fileStr.reset();
+        }
+        else
+        {
+          // Stay on the stream path.
+          m_memoryMap.clear();
+          m_fileStr->clear();
+        }
+      }
+    }
+  }
+
   #if 0 /* Serious debug only... */
   std::cout << m_numLonLines
            << "\t" << m_numLatPoints
@@ -309,7 +393,7 @@ double ossimDtedHandler::getHeightAboveMSL(const ossimGpt& gpt, bool readFromFil
    }
    else
    {
-     ossim_uint8* buf = &m_memoryMap.front();
+     const ossim_uint8* buf = m_memoryMapData;
      {
        ossim_uint16 us;
 
@@ -410,13 +494,22 @@ double ossimDtedHandler::getPostValue(const ossimIpt& gridPt) const
       m_offsetToFirstDataRecord + gridPt.x * m_dtedRecordSizeInBytes +
       gridPt.y * 2 + DATA_RECORD_OFFSET_TO_POST;
    
-   // Put the file pointer at the start of the first elevation post.
-   m_fileStr->seekg(offset, std::ios::beg);
-
    ossim_uint16 us;
 
-   // Get the post.
-   m_fileStr->read((char*)&us, POST_SIZE);
+   if (m_memoryMapData)
+   {
+      memcpy(&us, m_memoryMapData+offset, POST_SIZE);
+   }
+   else
+   {
+      std::lock_guard<std::mutex> lock(m_fileStrMutex);
+
+      // Put the file pointer at the start of the first elevation post.
+      m_fileStr->seekg(offset, std::ios::beg);
+
+      // Get the post.
+      m_fileStr->read((char*)&us, POST_SIZE);
+   }
    
    return double(convertSignedMagnitude(us));
 }
@@ -456,7 +549,7 @@ void ossimDtedHandler::gatherStatistics()
       theMinHeightAboveMSL = atoi(min_str);
       theMaxHeightAboveMSL = atoi(max_str);
    }
-   else if (theComputeStatsFlag&&!m_memoryMap.size())  // Scan the cell and gather the statistics...
+   else if (theComputeStatsFlag&&!m_memoryMapData)  // Scan the cell and gather the statistics...
    {
       if(traceDebug())
       {
@@ -83,6 +83,14 @@ bool ossimElevCellHandler::getAccuracyInfo(ossimElevationAccuracyInfo& info,
   return info.hasValidAbsoluteError();
 }
 
+bool ossimElevCellHandler::getMemoryMapUsage(ossim_uint64& residentBytes,
+                                             ossim_uint64& virtualBytes) const
+{
+   residentBytes = 0;
+   virtualBytes  = 0;
+   return false;
+}
+
 bool ossimElevCellHandler::canConnectMyInputTo(
    ossim_int32 /* inputIndex */,
    const ossimConnectableObject* /* object */) const
@@ -168,6 +168,149 @@ double ossimElevManager::getHeightAboveMSL(const ossimGpt& gpt)
    return result;
 }
 
+ossim_uint32 ossimElevManager::getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                        ossim_uint32 count,
+                                                        ossim_float64* heights,
+                                                        bool* valid)
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+      heights[i] = ossim::nan();
+
+   if (isSourceEnabled())
+   {
+      getDatabaseHeights(gpts, count, heights, true);
+
+      // Same fall backs as getHeightAboveEllipsoid:
+      if (!ossim::isnan(m_defaultHeightAboveEllipsoid))
+      {
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            if (ossim::isnan(heights[i]))
+               heights[i] = m_defaultHeightAboveEllipsoid;
+         }
+      }
+      else if (m_useGeoidIfNullFlag)
+      {
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            if (ossim::isnan(heights[i]))
+               heights[i] = ossimGeoidManager::instance()->offsetFromEllipsoid(gpts[i]);
+         }
+      }
+   }
+
+   ossim_uint32 result = 0;
+   bool hasOffset = !ossim::isnan(m_elevationOffset);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      bool isValid = !ossim::isnan(heights[i]);
+      if (isValid)
+      {
+         if (hasOffset) heights[i] += m_elevationOffset;
+         ++result;
+      }
+      if (valid) valid[i] = isValid;
+   }
+   return result;
+}
+
+ossim_uint32 ossimElevManager::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                  ossim_uint32 count,
+                                                  ossim_float64* heights,
+                                                  bool* valid)
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+      heights[i] = ossim::nan();
+
+   if (isSourceEnabled())
+   {
+      getDatabaseHeights(gpts, count, heights, false);
+
+      // Same fall backs as getHeightAboveMSL:
+      if (m_useGeoidIfNullFlag)
+      {
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            if (ossim::isnan(heights[i]))
+            {
+               heights[i] = 0.0; // MSL
+               if (!ossim::isnan(m_defaultHeightAboveEllipsoid))
+               {
+                  double dh = ossimGeoidManager::instance()->offsetFromEllipsoid(gpts[i]);
+                  if (!ossim::isnan(dh))
+                     heights[i] = m_defaultHeightAboveEllipsoid - dh;
+               }
+            }
+         }
+      }
+   }
+
+   ossim_uint32 result = 0;
+   bool hasOffset = !ossim::isnan(m_elevationOffset);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      bool isValid = !ossim::isnan(heights[i]);
+      if (isValid)
+      {
+         if (hasOffset) heights[i] += m_elevationOffset;
+         ++result;
+      }
+      if (valid) valid[i] = isValid;
+   }
+   return result;
+}
+
+void ossimElevManager::getDatabaseHeights(const ossimGpt* gpts,
+                                          ossim_uint32 count,
+                                          ossim_float64* heights,
+                                          bool ellipsoidFlag)
+{
+   ElevationDatabaseListType& elevDbList = getNextElevDbList();
+   if (elevDbList.empty() || !count)
+      return;
+
+   // Points still needing a height.  First database gets them all.
+   std::vector<ossim_uint32>  pending;
+   std::vector<ossimGpt>      pendingPts(gpts, gpts + count);
+   std::vector<ossim_float64> pendingHeights(count);
+   pending.reserve(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+      pending.push_back(i);
+
+   for (ossim_uint32 idx = 0; (idx < elevDbList.size()) && !pending.empty(); ++idx)
+   {
+      ossim_uint32 pendingCount = (ossim_uint32)pending.size();
+      if (ellipsoidFlag)
+      {
+         elevDbList[idx]->getHeightsAboveEllipsoid(&pendingPts.front(), pendingCount,
+                                                   &pendingHeights.front());
+      }
+      else
+      {
+         elevDbList[idx]->getHeightsAboveMSL(&pendingPts.front(), pendingCount,
+                                             &pendingHeights.front());
+      }
+
+      // Scatter the results and compact the points still NaN for the next database:
+      ossim_uint32 stillPending = 0;
+      for (ossim_uint32 p = 0; p < pendingCount; ++p)
+      {
+         if (ossim::isnan(pendingHeights[p]))
+         {
+            pending[stillPending]    = pending[p];
+            pendingPts[stillPending] = pendingPts[p];
+            ++stillPending;
+         }
+         else
+         {
+            heights[pending[p]] = pendingHeights[p];
+         }
+      }
+      pending.resize(stillPending);
+      pendingPts.resize(stillPending);
+   }
+}
+
 void ossimElevManager::loadStandardElevationPaths()
 {
    if (!m_useStandardPaths)
@@ -24,6 +24,7 @@
 #include <ossim/base/ossimDatum.h>
 #include <ossim/base/ossimEllipsoid.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <vector>
 
 RTTI_DEF1(ossimElevSource, "ossimElevSource" , ossimSource)
 
@@ -102,6 +103,38 @@ double ossimElevSource::getHeightAboveEllipsoid(const ossimGpt& /* argGpt */)
    return theNullHeightValue;
 }
 
+ossim_uint32 ossimElevSource::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                 ossim_uint32 count,
+                                                 ossim_float64* heights,
+                                                 bool* valid)
+{
+   ossim_uint32 result = 0;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      heights[i] = getHeightAboveMSL(gpts[i]);
+      bool isValid = !ossim::isnan(heights[i]);
+      if (isValid) ++result;
+      if (valid) valid[i] = isValid;
+   }
+   return result;
+}
+
+ossim_uint32 ossimElevSource::getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                       ossim_uint32 count,
+                                                       ossim_float64* heights,
+                                                       bool* valid)
+{
+   ossim_uint32 result = 0;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      heights[i] = getHeightAboveEllipsoid(gpts[i]);
+      bool isValid = !ossim::isnan(heights[i]);
+      if (isValid) ++result;
+      if (valid) valid[i] = isValid;
+   }
+   return result;
+}
+
 //*****************************************************************************
 //  METHOD: intersectRay()
 //  
@@ -217,6 +250,96 @@ bool ossimElevSource::intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, doubl
    return intersected;
 }
 
+ossim_uint32 ossimElevSource::intersectRays(const ossimEcefRay* rays,
+                                            ossim_uint32 count,
+                                            ossimGpt* gpts,
+                                            double defaultElevValue)
+{
+   static const double CONVERGENCE_THRESHOLD = 0.001; // meters
+   static const int    MAX_NUM_ITERATIONS    = 50;
+
+   ossim_uint32 result = 0;
+   if (!count) return result;
+
+   // Indexes of rays still iterating and their previous intersections:
+   std::vector<ossim_uint32>   active;
+   std::vector<ossimEcefPoint> prevPts(count);
+   active.reserve(count);
+
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (rays[i].hasNans())
+      {
+         gpts[i].makeNan();
+      }
+      else
+      {
+         prevPts[i] = rays[i].origin();
+         gpts[i] = ossimGpt(prevPts[i], gpts[i].datum());
+         active.push_back(i);
+      }
+   }
+
+   std::vector<ossimGpt>      queryPts;
+   std::vector<ossim_float64> heights;
+   ossimEcefPoint             newPt;
+   int iteration_count = 0;
+
+   while (!active.empty() && (iteration_count < MAX_NUM_ITERATIONS))
+   {
+      // One height lookup for every ray still iterating:
+      ossim_uint32 activeCount = (ossim_uint32)active.size();
+      queryPts.resize(activeCount);
+      heights.resize(activeCount);
+      for (ossim_uint32 a = 0; a < activeCount; ++a)
+      {
+         queryPts[a] = gpts[active[a]];
+      }
+      getHeightsAboveEllipsoid(&queryPts.front(), activeCount, &heights.front());
+
+      ossim_uint32 stillActive = 0;
+      for (ossim_uint32 a = 0; a < activeCount; ++a)
+      {
+         ossim_uint32 i = active[a];
+         const ossimDatum* datum = gpts[i].datum();
+         double h_ellips = ossim::isnan(heights[a]) ? defaultElevValue : heights[a];
+
+         if (!datum->ellipsoid()->nearestIntersection(rays[i], h_ellips, newPt))
+         {
+            // No intersection (looking over the horizon):
+            gpts[i].makeNan();
+            continue;
+         }
+
+         gpts[i] = ossimGpt(newPt, datum);
+         if ((newPt - prevPts[i]).magnitude() < CONVERGENCE_THRESHOLD)
+         {
+            ++result;
+         }
+         else
+         {
+            prevPts[i] = newPt;
+            active[stillActive++] = i;
+         }
+      }
+      active.resize(stillActive);
+      ++iteration_count;
+   }
+
+   if (!active.empty())
+   {
+      // Same as intersectRay, unconverged rays keep their last intersection.
+      result += (ossim_uint32)active.size();
+      if(traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << "WARNING ossimElevSource::intersectRays: Max number of iterations reached solving for "
+                                            << active.size() << " ground points. Results are probably inaccurate." << std::endl;
+      }
+   }
+
+   return result;
+}
+
 double ossimElevSource::getMinHeightAboveMSL() const
 {
    return theMinHeightAboveMSL;
@@ -1,4 +1,5 @@
 #include <ossim/elevation/ossimElevationCellDatabase.h>
+#include <algorithm>
 
 RTTI_DEF1(ossimElevationCellDatabase, "ossimElevationCellDatabase", ossimElevationDatabase);
 
@@ -175,6 +176,105 @@ ossimRefPtr<ossimElevCellHandler> ossimElevationCellDatabase::getOrCreateCellHan
 }
 #endif
 
+ossim_uint32 ossimElevationCellDatabase::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                            ossim_uint32 count,
+                                                            ossim_float64* heights,
+                                                            bool* valid)
+{
+   ossim_uint32 result = 0;
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      heights[i] = ossim::nan();
+      if(valid) valid[i] = false;
+   }
+   if(!count || !isSourceEnabled()) return result;
+
+   // Sort the point indexes by cell so each cell is resolved once:
+   std::vector< std::pair<ossim_uint64, ossim_uint32> > order(count);
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      order[i] = std::make_pair(createId(gpts[i]), i);
+   }
+   std::sort(order.begin(), order.end());
+
+   std::vector<ossimGpt>      cellPts;
+   std::vector<ossim_float64> cellHeights;
+   ossim_uint32 k = 0;
+   while(k < count)
+   {
+      const ossim_uint64 id = order[k].first;
+      ossimRefPtr<ossimElevCellHandler> handler = getOrCreateCellHandler(gpts[order[k].second]);
+
+      //---
+      // The points of the cell go to its handler in one call.  Some databases
+      // do not have unique ids (createId returns 0) so coverage is checked
+      // too.
+      //---
+      ossim_uint32 end = k + 1;
+      if(handler.valid())
+      {
+         while( (end < count) && (order[end].first == id) &&
+                handler->pointHasCoverage(gpts[order[end].second]) )
+         {
+            ++end;
+         }
+
+         const ossim_uint32 n = end - k;
+         cellPts.resize(n);
+         cellHeights.resize(n);
+         for(ossim_uint32 j = 0; j < n; ++j)
+         {
+            cellPts[j] = gpts[order[k + j].second];
+         }
+         handler->getHeightsAboveMSL(&cellPts.front(), n, &cellHeights.front());
+         for(ossim_uint32 j = 0; j < n; ++j)
+         {
+            const ossim_uint32 i = order[k + j].second;
+            heights[i] = cellHeights[j];
+            if(!ossim::isnan(heights[i]))
+            {
+               ++result;
+               if(valid) valid[i] = true;
+            }
+         }
+      }
+      k = end;
+   }
+   
+   return result;
+}
+
+ossim_uint32 ossimElevationCellDatabase::getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                                  ossim_uint32 count,
+                                                                  ossim_float64* heights,
+                                                                  bool* valid)
+{
+   ossim_uint32 result = getHeightsAboveMSL(gpts, count, heights, valid);
+   if(result)
+   {
+      // Geoid offsets for the points that have a height:
+      std::vector<ossimGpt>      validPts;
+      std::vector<ossim_uint32>  validIdx;
+      std::vector<ossim_float64> offsets(result);
+      validPts.reserve(result);
+      validIdx.reserve(result);
+      for(ossim_uint32 i = 0; i < count; ++i)
+      {
+         if(!ossim::isnan(heights[i]))
+         {
+            validPts.push_back(gpts[i]);
+            validIdx.push_back(i);
+         }
+      }
+      getOffsetsFromEllipsoid(&validPts.front(), result, &offsets.front());
+      for(ossim_uint32 v = 0; v < result; ++v)
+      {
+         heights[validIdx[v]] += offsets[v];
+      }
+   }
+   return result;
+}
+
 bool ossimElevationCellDatabase::loadState(const ossimKeywordlist& kwl, const char* prefix)
 {
    ossimString minOpenCells = kwl.find(prefix, "min_open_cells");
@@ -215,7 +315,25 @@ std::ostream& ossimElevationCellDatabase::print(ostream& out) const
 {
    ossimKeywordlist kwl;
    saveState(kwl);
-   out << "\nossimElevationCellDatabase @ "<< (ossim_uint64) this << kwl << ends;
+   out << "\nossimElevationCellDatabase @ "<< (ossim_uint64) this << kwl;
+
+   // Memory used by memory mapped cells:
+   std::lock_guard<std::mutex> lock(m_cacheMapMutex);
+   CellMap::const_iterator iter = m_cacheMap.begin();
+   while(iter != m_cacheMap.end())
+   {
+      ossim_uint64 residentBytes = 0;
+      ossim_uint64 virtualBytes  = 0;
+      if ( iter->second->m_handler.valid() &&
+           iter->second->m_handler->getMemoryMapUsage(residentBytes, virtualBytes) )
+      {
+         out << "\ncell: " << iter->second->m_handler->getFilename()
+             << "\nresident_bytes: " << residentBytes
+             << "\nvirtual_bytes: " << virtualBytes;
+      }
+      ++iter;
+   }
+   out << ends;
    return out;
 }
 
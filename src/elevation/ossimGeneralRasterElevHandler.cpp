@@ -12,6 +12,7 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimGpt.h>
+#include <cstring>
 
 RTTI_DEF1(ossimGeneralRasterElevHandler, "ossimGeneralRasterElevHandler", ossimElevCellHandler);
 
@@ -29,8 +30,13 @@ ossimGeneralRasterElevHandler::ossimGeneralRasterElevHandler(const ossimGeneralR
    :ossimElevCellHandler(src),
     theGeneralRasterInfo(src.theGeneralRasterInfo),
     m_streamOpen(false), // ????
-    m_memoryMap(src.m_memoryMap)
+    m_memoryMap()
 {
+   if(src.m_memoryMap.isOpen())
+   {
+      // Maps are shared through the page cache so this does not copy the cell.
+      m_memoryMap.open(src.m_memoryMap.getFilename());
+   }
 }
 
 ossimGeneralRasterElevHandler::ossimGeneralRasterElevHandler(const ossimGeneralRasterElevHandler::GeneralRasterInfo& generalRasterInfo)
@@ -217,22 +223,29 @@ bool ossimGeneralRasterElevHandler::open(const ossimFilename& file, bool memoryM
 {
    close();
    if(!setFilename(file)) return false;
-   m_inputStream.clear();
-   m_inputStream.open(theGeneralRasterInfo.theFilename.c_str(), ios::in | ios::binary);
 
    if(memoryMapFlag)
    {
-      if(!m_inputStream.bad())
+      //---
+      // Map read only.  Lookups then go straight to the page cache with no
+      // stream lock.  A truncated file stays on the stream path.
+      //---
+      ossim_uint64 requiredSize = static_cast<ossim_uint64>(theGeneralRasterInfo.theBytesPerRawLine)*
+                                  theGeneralRasterInfo.theHeight;
+      if(m_memoryMap.open(theGeneralRasterInfo.theFilename.string()) &&
+         (m_memoryMap.size() < requiredSize))
       {
-         m_memoryMap.resize(theGeneralRasterInfo.theFilename.fileSize());
-         if(!m_memoryMap.empty())
-         {
-           m_inputStream.read((char*)(&m_memoryMap.front()), (streamsize)m_memoryMap.size());
-         }
+         m_memoryMap.close();
+      }
+      if(m_memoryMap.isOpen())
+      {
+         return true;
       }
-      m_inputStream.close();
    }
 
+   m_inputStream.clear();
+   m_inputStream.open(theGeneralRasterInfo.theFilename.c_str(), ios::in | ios::binary);
+
    // Capture the stream state for non-const is_open on old compiler.
    m_streamOpen = m_inputStream.is_open();
    
@@ -245,10 +258,18 @@ bool ossimGeneralRasterElevHandler::open(const ossimFilename& file, bool memoryM
 void ossimGeneralRasterElevHandler::close()
 {
    m_inputStream.close();
-   m_memoryMap.clear();
+   m_memoryMap.close();
    m_streamOpen = false;
 }
 
+bool ossimGeneralRasterElevHandler::getMemoryMapUsage(ossim_uint64& residentBytes,
+                                                      ossim_uint64& virtualBytes) const
+{
+   residentBytes = m_memoryMap.residentBytes();
+   virtualBytes  = m_memoryMap.size();
+   return m_memoryMap.isOpen();
+}
+
 bool ossimGeneralRasterElevHandler::setFilename(const ossimFilename& file)
 {
    if(file.trim() == "")
@@ -615,10 +636,15 @@ double ossimGeneralRasterElevHandler::getHeightAboveMSLMemoryTemplate(
    ossim_uint64 offset = y0*bytesPerLine + x0*sizeof(T);
    ossim_uint64 offset2 = offset+bytesPerLine;
    
-   T v00 = *(reinterpret_cast<T*> (&m_memoryMap[offset]));
-   T v01 = *(reinterpret_cast<T*> (&m_memoryMap[offset + sizeof(T)]));
-   T v10 = *(reinterpret_cast<T*> (&m_memoryMap[offset2]));
-   T v11 = *(reinterpret_cast<T*> (&m_memoryMap[offset2 + sizeof(T)]));
+   const ossim_uint8* buf = m_memoryMap.data();
+   T v00;
+   T v01;
+   T v10;
+   T v11;
+   memcpy(&v00, buf + offset, sizeof(T));
+   memcpy(&v01, buf + offset + sizeof(T), sizeof(T));
+   memcpy(&v10, buf + offset2, sizeof(T));
+   memcpy(&v11, buf + offset2 + sizeof(T), sizeof(T));
    if(endian.getSystemEndianType() != info.theByteOrder)
    {
       endian.swap(v00);
@@ -18,6 +18,7 @@
 #include <ossim/base/ossimGpt.h>
 #include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimStreamFactoryRegistry.h>
+#include <cstring>
 
 RTTI_DEF1(ossimSrtmHandler, "ossimSrtmHandler" , ossimElevCellHandler)
 
@@ -270,10 +271,15 @@ double ossimSrtmHandler::getHeightAboveMSLMemoryTemplate(T /* dummy */,
    // Grab the four points from the srtm cell needed.
    ossim_uint64 offset = y0 * m_srtmRecordSizeInBytes + x0 * sizeof(T);
    ossim_uint64 offset2 =offset+m_srtmRecordSizeInBytes;
-   T v00 = *(reinterpret_cast<T*> (&m_memoryMap[offset]));
-   T v01 = *(reinterpret_cast<T*> (&m_memoryMap[offset + sizeof(T)]));
-   T v10 = *(reinterpret_cast<T*> (&m_memoryMap[offset2]));
-   T v11 = *(reinterpret_cast<T*> (&m_memoryMap[offset2 + sizeof(T)]));
+   const ossim_uint8* buf = m_memoryMap.data();
+   T v00;
+   T v01;
+   T v10;
+   T v11;
+   memcpy(&v00, buf + offset, sizeof(T));
+   memcpy(&v01, buf + offset + sizeof(T), sizeof(T));
+   memcpy(&v10, buf + offset2, sizeof(T));
+   memcpy(&v11, buf + offset2 + sizeof(T), sizeof(T));
    if (m_swapper)
    {
       m_swapper->swap(v00);
@@ -393,8 +399,13 @@ m_lonSpacing(src.m_lonSpacing),
 m_nwCornerPost(src.m_nwCornerPost),
 m_swapper(src.m_swapper?new ossimEndian:0),
 m_scalarType(src.m_scalarType),
-m_memoryMap(src.m_memoryMap)
+m_memoryMap()
 {
+   if(src.m_memoryMap.isOpen())
+   {
+      // Maps are shared through the page cache so this does not copy the cell.
+      m_memoryMap.open(src.m_memoryMap.getFilename());
+   }
    if(m_memoryMap.empty()&&src.isOpen())
    {
       m_fileStr.open(src.getFilename().c_str(),
@@ -402,6 +413,14 @@ m_memoryMap(src.m_memoryMap)
    }
 }
 
+bool ossimSrtmHandler::getMemoryMapUsage(ossim_uint64& residentBytes,
+                                         ossim_uint64& virtualBytes) const
+{
+   residentBytes = m_memoryMap.residentBytes();
+   virtualBytes  = m_memoryMap.size();
+   return m_memoryMap.isOpen();
+}
+
 bool ossimSrtmHandler::isOpen()const
 {
    if(!m_memoryMap.empty()) return true;
@@ -448,18 +467,28 @@ bool ossimSrtmHandler::open(const ossimFilename& file, bool memoryMapFlag)
    // Set the base class null height value.
    theNullHeightValue = -32768.0;
 
-   m_fileStr.clear();
-   m_fileStr.open(theFilename.c_str(), std::ios::in | std::ios::binary);
-   if(!m_fileStr)
+   close();
+   if(memoryMapFlag)
    {
-      return false;
+      //---
+      // Map read only.  Lookups then go straight to the page cache with no
+      // stream lock.  A truncated file stays on the stream path.
+      //---
+      if(m_memoryMap.open(theFilename.string()) &&
+         (m_memoryMap.size() < static_cast<ossim_uint64>(m_srtmRecordSizeInBytes)*m_numberOfLines))
+      {
+         m_memoryMap.close();
+      }
    }
-   
-   if(memoryMapFlag)
+
+   if(m_memoryMap.empty())
    {
-      m_memoryMap.resize(theFilename.fileSize());
-      m_fileStr.read((char*)&m_memoryMap.front(), (streamsize)m_memoryMap.size());
-      m_fileStr.close();
+      m_fileStr.clear();
+      m_fileStr.open(theFilename.c_str(), std::ios::in | std::ios::binary);
+      if(!m_fileStr)
+      {
+         return false;
+      }
    }
    m_streamOpen = true;
    // Capture the stream state for non-const is_open on old compiler.
@@ -492,6 +521,6 @@ bool ossimSrtmHandler::open(const ossimFilename& file, bool memoryMapFlag)
 void ossimSrtmHandler::close()
 {
    m_fileStr.close();
-   m_memoryMap.clear();
+   m_memoryMap.close();
    m_streamOpen = false;
 }
@@ -0,0 +1,219 @@
+#include <ossim/imaging/HistogramAccumulator.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/base/ossimMultiBandHistogram.h>
+#include <ossim/base/ossimHistogram.h>
+#include <algorithm>
+
+namespace
+{
+   // Counts buffer into bins, skipping nulls.  offset maps a raw value to its bin.
+   template <class T>
+   void countValues(const T* buffer,
+                    ossim_uint32 size,
+                    T nullPix,
+                    ossim_int32 offset,
+                    ossim_uint64* bins)
+   {
+      for (ossim_uint32 i = 0; i < size; ++i)
+      {
+         if (buffer[i] != nullPix)
+         {
+            ++bins[static_cast<ossim_int32>(buffer[i]) - offset];
+         }
+      }
+   }
+}
+
+ossim::HistogramAccumulator::HistogramAccumulator()
+:m_scalar(OSSIM_SCALAR_UNKNOWN),
+ m_bands(0),
+ m_valueCount(0),
+ m_valueOffset(0),
+ m_mutex(),
+ m_bins(),
+ m_freeBins()
+{
+}
+
+bool ossim::HistogramAccumulator::isSupported(ossimScalarType scalar)
+{
+   switch (scalar)
+   {
+      case OSSIM_UINT8:
+      case OSSIM_SINT8:
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+      case OSSIM_USHORT12:
+      case OSSIM_USHORT13:
+      case OSSIM_USHORT14:
+      case OSSIM_USHORT15:
+      case OSSIM_SINT16:
+         return true;
+      default:
+         return false;
+   }
+}
+
+bool ossim::HistogramAccumulator::initialize(ossimScalarType scalar, ossim_uint32 bands)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_bins.clear();
+   m_freeBins.clear();
+   m_scalar      = OSSIM_SCALAR_UNKNOWN;
+   m_bands       = 0;
+   m_valueCount  = 0;
+   m_valueOffset = 0;
+
+   if ( !bands || !isSupported(scalar) )
+   {
+      return false;
+   }
+
+   m_scalar = scalar;
+   m_bands  = bands;
+   switch (scalar)
+   {
+      case OSSIM_UINT8:
+         m_valueCount = 256;
+         break;
+      case OSSIM_SINT8:
+         m_valueCount  = 256;
+         m_valueOffset = -128;
+         break;
+      case OSSIM_SINT16:
+         m_valueCount  = 65536;
+         m_valueOffset = -32768;
+         break;
+      default:
+         m_valueCount = 65536;
+         break;
+   }
+   return true;
+}
+
+void ossim::HistogramAccumulator::accumulate(const ossimImageData* tile)
+{
+   if ( !tile || !m_valueCount ||
+        (tile->getScalarType() != m_scalar) ||
+        (tile->getNumberOfBands() != m_bands) ||
+        (tile->getDataObjectStatus() == OSSIM_NULL) ||
+        (tile->getDataObjectStatus() == OSSIM_EMPTY) ||
+        !tile->getBuf() )
+   {
+      return;
+   }
+
+   Bins* bins = acquireBins();
+   ossim_uint32 size = tile->getWidth()*tile->getHeight();
+   for (ossim_uint32 band = 0; band < m_bands; ++band)
+   {
+      ossim_uint64* bandBins = &(*bins)[static_cast<size_t>(band)*m_valueCount];
+      switch (m_scalar)
+      {
+         case OSSIM_UINT8:
+            countValues(static_cast<const ossim_uint8*>(tile->getBuf(band)), size,
+                        static_cast<ossim_uint8>(tile->getNullPix(band)),
+                        m_valueOffset, bandBins);
+            break;
+         case OSSIM_SINT8:
+            countValues(static_cast<const ossim_sint8*>(tile->getBuf(band)), size,
+                        static_cast<ossim_sint8>(tile->getNullPix(band)),
+                        m_valueOffset, bandBins);
+            break;
+         case OSSIM_SINT16:
+            countValues(static_cast<const ossim_sint16*>(tile->getBuf(band)), size,
+                        static_cast<ossim_sint16>(tile->getNullPix(band)),
+                        m_valueOffset, bandBins);
+            break;
+         default:
+            countValues(static_cast<const ossim_uint16*>(tile->getBuf(band)), size,
+                        static_cast<ossim_uint16>(tile->getNullPix(band)),
+                        m_valueOffset, bandBins);
+            break;
+      }
+   }
+   releaseBins(bins);
+}
+
+void ossim::HistogramAccumulator::addTo(ossimMultiBandHistogram* histo)const
+{
+   if ( !histo || !m_valueCount )
+   {
+      return;
+   }
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if ( m_bins.empty() )
+   {
+      return;
+   }
+
+   std::vector<ossim_uint64> counts(m_valueCount);
+   ossim_uint32 bands = std::min(m_bands, histo->getNumberOfBands());
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      ossimRefPtr<ossimHistogram> h = histo->getHistogram(band);
+      if ( !h.valid() || !h->GetCounts() )
+      {
+         continue;
+      }
+
+      // Merge the per thread sets:
+      size_t start = static_cast<size_t>(band)*m_valueCount;
+      std::copy(m_bins[0]->begin() + start,
+                m_bins[0]->begin() + start + m_valueCount,
+                counts.begin());
+      for (size_t idx = 1; idx < m_bins.size(); ++idx)
+      {
+         const ossim_uint64* bins = &(*m_bins[idx])[start];
+         for (ossim_uint32 value = 0; value < m_valueCount; ++value)
+         {
+            counts[value] += bins[value];
+         }
+      }
+
+      // One bin lookup per distinct value:
+      float* histoBins = h->GetCounts();
+      for (ossim_uint32 value = 0; value < m_valueCount; ++value)
+      {
+         if ( counts[value] )
+         {
+            int idx = h->GetIndex(static_cast<float>(static_cast<ossim_int32>(value) +
+                                                     m_valueOffset));
+            if ( idx >= 0 )
+            {
+               histoBins[idx] += static_cast<float>(counts[value]);
+            }
+         }
+      }
+   }
+}
+
+void ossim::HistogramAccumulator::clear()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   for (size_t idx = 0; idx < m_bins.size(); ++idx)
+   {
+      std::fill(m_bins[idx]->begin(), m_bins[idx]->end(), 0);
+   }
+}
+
+ossim::HistogramAccumulator::Bins* ossim::HistogramAccumulator::acquireBins()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if ( m_freeBins.empty() )
+   {
+      m_bins.push_back(std::unique_ptr<Bins>(
+                          new Bins(static_cast<size_t>(m_bands)*m_valueCount, 0)));
+      return m_bins.back().get();
+   }
+   Bins* bins = m_freeBins.back();
+   m_freeBins.pop_back();
+   return bins;
+}
+
+void ossim::HistogramAccumulator::releaseBins(Bins* bins)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_freeBins.push_back(bins);
+}
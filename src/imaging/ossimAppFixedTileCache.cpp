@@ -19,26 +19,51 @@
 #include <ossim/base/ossimTrace.h>
 
 ossimAppFixedTileCache* ossimAppFixedTileCache::theInstance = 0;
-ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::theUniqueAppIdCounter = 0;
+std::atomic<ossimAppFixedTileCache::ossimAppFixedCacheId> ossimAppFixedTileCache::theUniqueAppIdCounter(0);
 const ossim_uint32 ossimAppFixedTileCache::DEFAULT_SIZE = 1024*1024*80;
+const ossim_uint32 ossimAppFixedTileCache::SHARD_COUNT;
 
 static const ossimTrace traceDebug("ossimAppFixedTileCache:debug");
 std::ostream& operator <<(std::ostream& out, const ossimAppFixedTileCache& rhs)
 {
-   std::map<ossimAppFixedTileCache::ossimAppFixedCacheId, ossimFixedTileCache*>::const_iterator iter = rhs.theAppCacheMap.begin();
+   ossimAppFixedTileCache& cache = const_cast<ossimAppFixedTileCache&>(rhs);
+   ossim_uint64 hits       = 0;
+   ossim_uint64 misses     = 0;
+   ossim_uint64 evictions  = 0;
+   ossim_uint64 contention = 0;
+   ossim_uint32 count      = 0;
+   for(ossim_uint32 idx = 0; idx < ossimAppFixedTileCache::SHARD_COUNT; ++idx)
+   {
+      ossimAppFixedTileCache::CacheShard& shard = cache.theShards[idx];
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      ossimAppFixedTileCache::CacheMap::const_iterator iter = shard.m_cacheMap.begin();
+      while(iter != shard.m_cacheMap.end())
+      {
+         const ossimFixedTileCache* tileCache = (*iter).second.get();
+         out << "Cache id = "<< (*iter).first << " ";
+         tileCache->print(out) << endl;
+         hits       += tileCache->getHitCount();
+         misses     += tileCache->getMissCount();
+         evictions  += tileCache->getEvictionCount();
+         contention += tileCache->getContentionCount();
+         ++count;
+         ++iter;
+      }
+   }
 
-   if(iter == rhs.theAppCacheMap.end())
+   if(count == 0)
    {
       ossimNotify(ossimNotifyLevel_NOTICE)
          << "***** APP CACHE EMPTY *****" << endl;
    }
    else
    {
-      while(iter != rhs.theAppCacheMap.end())
-      {
-         out << "Cache id = "<< (*iter).first << " size = " << (*iter).second->getCacheSize() << endl;
-         ++iter;
-      }
+      out << "Total caches = " << count
+          << " size = "        << rhs.theCurrentCacheSize
+          << " hits = "        << hits
+          << " misses = "      << misses
+          << " evictions = "   << evictions
+          << " contention = "  << contention << endl;
    }
 
    return out;
@@ -54,6 +79,8 @@ ossimAppFixedTileCache::ossimAppFixedTileCache()
    theInstance = this;
    theTileSize = ossimIpt(64, 64);
    theCurrentCacheSize = 0;
+   theMaxCacheSize = 0;
+   theMaxGlobalCacheSize = 0;
 
    // ossim::defaultTileSize(theTileSize);
    
@@ -118,7 +145,6 @@ ossimAppFixedTileCache *ossimAppFixedTileCache::instance(ossim_uint32  maxSize)
 
 void ossimAppFixedTileCache::setMaxCacheSize(ossim_uint32 cacheSize)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    theMaxGlobalCacheSize = cacheSize;
    theMaxCacheSize = cacheSize;
    //   theMaxCacheSize      = (ossim_uint32)(theMaxGlobalCacheSize*.2);
@@ -126,51 +152,50 @@ void ossimAppFixedTileCache::setMaxCacheSize(ossim_uint32 cacheSize)
 
 void ossimAppFixedTileCache::flush()
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::iterator currentIter = theAppCacheMap.begin();
-   
-   while(currentIter != theAppCacheMap.end())
+   std::vector<ossimRefPtr<ossimFixedTileCache> > caches;
+   getCaches(caches);
+   for(ossim_uint32 idx = 0; idx < caches.size(); ++idx)
    {
-      (*currentIter).second->flush();
-      ++currentIter;
+      caches[idx]->flush();
    }
-   theCurrentCacheSize = 0;
 }
 
 void ossimAppFixedTileCache::flush(ossimAppFixedCacheId cacheId)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
-      if(cache)
-      {
-         theCurrentCacheSize -= cache->getCacheSize();
-         cache->flush();
-      }
+      cache->flush();
    }
 }
 
 void ossimAppFixedTileCache::deleteCache(ossimAppFixedCacheId cacheId)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   ossimRefPtr<ossimFixedTileCache> cache = 0;
    {
-      std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::iterator iter = theAppCacheMap.find(cacheId);
-      
-      if(cache.valid())
+      CacheShard& shard = getShard(cacheId);
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      CacheMap::iterator iter = shard.m_cacheMap.find(cacheId);
+      if(iter != shard.m_cacheMap.end())
       {
-         theAppCacheMap.erase(iter);
-         theCurrentCacheSize -= cache->getCacheSize();
+         cache = (*iter).second;
+         shard.m_cacheMap.erase(iter);
       }
-      cache = 0;
+   }
+
+   //---
+   // Tiles are released now even if another thread still holds a reference
+   // to the cache from a lookup in progress.
+   //---
+   if(cache.valid())
+   {
+      cache->flush();
    }
 }
 
 ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::newTileCache(const ossimIrect& tileBoundaryRect,
                                                                                   const ossimIpt& tileSize)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimAppFixedCacheId result = -1; 
    ossimFixedTileCache* newCache = new ossimFixedTileCache;
    if(tileSize.x == 0 ||
       tileSize.y == 0)
@@ -183,56 +208,34 @@ ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::newTileCach
    {
       newCache->setRect(tileBoundaryRect, tileSize);
    }
-   result = theUniqueAppIdCounter;
-   theAppCacheMap.insert(std::make_pair(result, newCache));
-   ++theUniqueAppIdCounter;
-   
-   return result;
+
+   return addCache(newCache);
 }
 
 ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::newTileCache()
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimAppFixedCacheId result = -1;
-   ossimFixedTileCache* newCache = new ossimFixedTileCache;
-   
-   {
-      result = theUniqueAppIdCounter;
-      theAppCacheMap.insert(std::make_pair(result, newCache));
-      ++theUniqueAppIdCounter;
-   }
-   
-   return result;
-   
+   return addCache(new ossimFixedTileCache);
 }
 
 void ossimAppFixedTileCache::setRect(ossimAppFixedCacheId cacheId,
                                      const ossimIrect& boundaryTileRect)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
-      
-      ossim_uint32 cacheSize = cache->getCacheSize();
       // cache->setRect(boundaryTileRect, theTileSize);
       cache->setRect(boundaryTileRect,
-                     cache->getTileSize());      
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
+                     cache->getTileSize());
    }
 }
 
 void ossimAppFixedTileCache::setTileSize(ossimAppFixedCacheId cacheId,
                                          const ossimIpt& tileSize)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
-      ossim_uint32 cacheSize = cache->getCacheSize();
       cache->setRect(cache->getTileBoundaryRect(), tileSize);
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
-      theTileSize = cache->getTileSize();
    }
 }
 
@@ -240,10 +243,9 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::getTile(
    ossimAppFixedCacheId cacheId,
    const ossimIpt& origin)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = 0;
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
       result = cache->getTile(origin);
    }
@@ -257,10 +259,9 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::addTile(
                                                             ossimRefPtr<ossimImageData> data,
                                                             bool duplicateData)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = 0;
-   ossimFixedTileCache *aCache = this->getCache(cacheId);
-   if(!aCache)
+   ossimRefPtr<ossimFixedTileCache> aCache = getCache(cacheId);
+   if(!aCache.valid() || !data.valid())
    {         
       return result;
    }
@@ -271,47 +272,49 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::addTile(
       shrinkGlobalCacheSize((ossim_int32)(theMaxGlobalCacheSize*0.1));
    }
 
-   ossim_uint32 cacheSize = 0;
-   {
-      cacheSize = aCache->getCacheSize();
-   }
-   if(cacheSize > theMaxCacheSize)
+   if(aCache->getCacheSize() > theMaxCacheSize)
    {
 //       shrinkCacheSize(aCache,
 //                       (ossim_int32)(aCache->getCacheSize()*.1));
-      shrinkCacheSize(aCache,
+      shrinkCacheSize(aCache.get(),
                       (ossim_int32)(1024*1024));
    }
-   {
-      cacheSize = aCache->getCacheSize();
-      result    = aCache->addTile(data, duplicateData);
-   
-      theCurrentCacheSize += (aCache->getCacheSize() - cacheSize);
-   }
+
+   result = aCache->addTile(data, duplicateData);
    
    return result;
 }
 
 void ossimAppFixedTileCache::deleteAll()
 {
-   std::lock_guard<std::mutex> lock(theMutex);
+   for(ossim_uint32 idx = 0; idx < SHARD_COUNT; ++idx)
+   {
+      CacheMap caches;
+      {
+         std::lock_guard<std::mutex> lock(theShards[idx].m_mutex);
+         caches.swap(theShards[idx].m_cacheMap);
+      }
+      CacheMap::iterator iter = caches.begin();
+      while(iter != caches.end())
+      {
+         (*iter).second->flush();
+         (*iter).second->setSharedCacheSizeCounter(0);
+         ++iter;
+      }
+   }
    theCurrentCacheSize = 0;
-   theAppCacheMap.clear();
 }
 
 ossimRefPtr<ossimImageData> ossimAppFixedTileCache::removeTile(
    ossimAppFixedCacheId cacheId,
    const ossimIpt& origin)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = 0;
    
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
-      ossim_uint32 cacheSize = cache->getCacheSize();
       result = cache->removeTile(origin);
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
    }
 
    return result;
@@ -320,24 +323,21 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::removeTile(
 void ossimAppFixedTileCache::deleteTile(ossimAppFixedCacheId cacheId,
                                         const ossimIpt& origin)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
-      ossim_uint32 cacheSize = cache->getCacheSize();
       cache->deleteTile(origin);
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
    }
 }
 
-ossimFixedTileCache* ossimAppFixedTileCache::getCache(
+ossimRefPtr<ossimFixedTileCache> ossimAppFixedTileCache::getCache(
    ossimAppFixedCacheId cacheId)
 {   
-   std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::const_iterator
-      currentIter = theAppCacheMap.find(cacheId);
-   ossimFixedTileCache* result = 0;
-   
-   if(currentIter != theAppCacheMap.end())
+   ossimRefPtr<ossimFixedTileCache> result = 0;
+   CacheShard& shard = getShard(cacheId);
+   std::lock_guard<std::mutex> lock(shard.m_mutex);
+   CacheMap::const_iterator currentIter = shard.m_cacheMap.find(cacheId);
+   if(currentIter != shard.m_cacheMap.end())
    {
       result = (*currentIter).second;
    }
@@ -345,28 +345,67 @@ ossimFixedTileCache* ossimAppFixedTileCache::getCache(
    return result;
 }
 
+ossimAppFixedTileCache::CacheShard& ossimAppFixedTileCache::getShard(ossimAppFixedCacheId cacheId)
+{
+   return theShards[static_cast<ossim_uint32>(cacheId) % SHARD_COUNT];
+}
+
+ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::addCache(
+   ossimFixedTileCache* cache)
+{
+   cache->setSharedCacheSizeCounter(&theCurrentCacheSize);
+   ossimAppFixedCacheId result = theUniqueAppIdCounter++;
+   CacheShard& shard = getShard(result);
+   std::lock_guard<std::mutex> lock(shard.m_mutex);
+   shard.m_cacheMap.insert(std::make_pair(result, ossimRefPtr<ossimFixedTileCache>(cache)));
+
+   return result;
+}
+
+void ossimAppFixedTileCache::getCaches(std::vector<ossimRefPtr<ossimFixedTileCache> >& caches)
+{
+   caches.clear();
+   for(ossim_uint32 idx = 0; idx < SHARD_COUNT; ++idx)
+   {
+      std::lock_guard<std::mutex> lock(theShards[idx].m_mutex);
+      CacheMap::const_iterator iter = theShards[idx].m_cacheMap.begin();
+      while(iter != theShards[idx].m_cacheMap.end())
+      {
+         caches.push_back((*iter).second);
+         ++iter;
+      }
+   }
+}
+
 void ossimAppFixedTileCache::shrinkGlobalCacheSize(ossim_int32 byteCount)
 {
-   if(static_cast<ossim_uint32>(byteCount) >= theCurrentCacheSize)
+   // Another thread is already making room:
+   std::unique_lock<std::mutex> lock(theShrinkMutex, std::try_to_lock);
+   if(!lock.owns_lock())
+   {
+      return;
+   }
+
+   if(byteCount >= theCurrentCacheSize)
    {
       flush();
    }
    else
    {
-      while(byteCount > 0)
+      std::vector<ossimRefPtr<ossimFixedTileCache> > caches;
+      getCaches(caches);
+      bool evicted = true;
+      while((byteCount > 0) && evicted)
       {
-         std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::iterator iter = theAppCacheMap.begin();
-         while( (iter != theAppCacheMap.end())&&(byteCount>0))
+         evicted = false;
+         std::vector<ossimRefPtr<ossimFixedTileCache> >::iterator iter = caches.begin();
+         while( (iter != caches.end())&&(byteCount>0))
          {
-            ossimFixedTileCache* cache = getCache((*iter).first);
-            if(cache)
+            ossimRefPtr<ossimImageData> tile = (*iter)->removeTile();
+            if(tile.valid())
             {
-               ossim_uint32 before = cache->getCacheSize();
-               cache->deleteTile();
-               ossim_uint32 after = cache->getCacheSize();
-               ossim_uint32 delta = (before - after);
-               byteCount -= delta;
-               theCurrentCacheSize -= (delta);
+               byteCount -= tile->getDataSizeInBytes();
+               evicted = true;
             }
             ++iter;
          }
@@ -377,11 +416,11 @@ void ossimAppFixedTileCache::shrinkGlobalCacheSize(ossim_int32 byteCount)
 void ossimAppFixedTileCache::shrinkCacheSize(ossimAppFixedCacheId id,
                                              ossim_int32 byteCount)
 {
-   ossimFixedTileCache* cache = getCache(id);
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(id);
 
-   if(cache)
+   if(cache.valid())
    {
-      shrinkCacheSize(cache, byteCount);
+      shrinkCacheSize(cache.get(), byteCount);
    }
 }
 
@@ -399,14 +438,10 @@ void ossimAppFixedTileCache::shrinkCacheSize(ossimFixedTileCache* cache,
       {
          while(byteCount > 0)
          {
-            ossim_uint32 before = cache->getCacheSize();
-            cache->deleteTile();
-            ossim_uint32 after = cache->getCacheSize();
-            ossim_uint32 delta = std::abs((int)(before - after));
-            if(delta)
+            ossimRefPtr<ossimImageData> tile = cache->removeTile();
+            if(tile.valid())
             {
-               byteCount -= delta;
-               theCurrentCacheSize -= (delta);
+               byteCount -= tile->getDataSizeInBytes();
             }
             else
             {
@@ -417,11 +452,10 @@ void ossimAppFixedTileCache::shrinkCacheSize(ossimFixedTileCache* cache,
    }
 }
 
-const ossimIpt& ossimAppFixedTileCache::getTileSize(ossimAppFixedCacheId cacheId)
+ossimIpt ossimAppFixedTileCache::getTileSize(ossimAppFixedCacheId cacheId)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   if(cache.valid())
    {
       return cache->getTileSize();
    }
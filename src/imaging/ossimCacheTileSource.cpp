@@ -17,6 +17,7 @@
 #include <ossim/imaging/ossimCacheTileSource.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimKeywordlist.h>
 
@@ -53,6 +54,7 @@ ossimCacheTileSource::~ossimCacheTileSource()
 void ossimCacheTileSource::flush()
 {
    //ossimAppFixedTileCache::instance()->flush(theCacheId);
+   std::lock_guard<std::recursive_mutex> lock(theCacheIdMutex);
    ossim_uint32 idx = 0;
    for(idx = 0; idx < theRLevelCacheList.size();++idx)
    {
@@ -583,6 +585,7 @@ void ossimCacheTileSource::getTileSize(ossimIpt& size) const
 
 void ossimCacheTileSource::setTileSize(const ossimIpt& size)
 {
+   std::lock_guard<std::recursive_mutex> lock(theCacheIdMutex);
    if (size != theFixedTileSize)
    {
       theTile = 0; // Force an allocate of new tile.
@@ -601,8 +604,94 @@ void ossimCacheTileSource::fireProgressEvent(double percentComplete)
    }
 }
 
+bool ossimCacheTileSource::getPrefetchTileRects(const ossimIrect& rect,
+                                                ossim_uint32 resLevel,
+                                                std::vector<ossimIrect>& tileRects)
+{
+   tileRects.clear();
+
+   ossimImageHandler* handler = dynamic_cast<ossimImageHandler*>(theInputConnection);
+   if ( !handler || !isSourceEnabled() || !theCachingEnabled ||
+        !handler->isConcurrentReadSafe(resLevel) )
+   {
+      return false;
+   }
+
+   ossimAppFixedTileCache::ossimAppFixedCacheId cacheId = getCacheId(resLevel);
+   if ( cacheId < 0 )
+   {
+      return false;
+   }
+
+   ossimIrect boundingRect = getBoundingRect(resLevel);
+   if ( boundingRect.hasNans() || !rect.intersects(boundingRect) )
+   {
+      return false;
+   }
+
+   ossimIrect alignedRect = rect.clipToRect(boundingRect);
+
+   ossimIpt cacheTileSize = ossimAppFixedTileCache::instance()->getTileSize(cacheId);
+   alignedRect.stretchToTileBoundary(cacheTileSize);
+
+   for ( ossim_int32 y = alignedRect.ul().y; y <= alignedRect.lr().y; y += cacheTileSize.y )
+   {
+      for ( ossim_int32 x = alignedRect.ul().x; x <= alignedRect.lr().x; x += cacheTileSize.x )
+      {
+         tileRects.push_back( ossimIrect(x, y, x + cacheTileSize.x - 1, y + cacheTileSize.y - 1) );
+      }
+   }
+
+   return ( tileRects.size() != 0 );
+}
+
+bool ossimCacheTileSource::prefetchTile(const ossimIrect& tileRect, ossim_uint32 resLevel)
+{
+   ossimImageHandler* handler = dynamic_cast<ossimImageHandler*>(theInputConnection);
+   if ( !handler || !handler->isConcurrentReadSafe(resLevel) )
+   {
+      return false;
+   }
+
+   ossimAppFixedTileCache::ossimAppFixedCacheId cacheId = getCacheId(resLevel);
+   if ( cacheId < 0 )
+   {
+      return false;
+   }
+
+   // The tile size may have changed since the rects were computed.
+   ossimIpt cacheTileSize = ossimAppFixedTileCache::instance()->getTileSize( cacheId );
+   if ( ( (ossim_int64)tileRect.width() != cacheTileSize.x ) ||
+        ( (ossim_int64)tileRect.height() != cacheTileSize.y ) )
+   {
+      return false;
+   }
+
+   if ( ossimAppFixedTileCache::instance()->getTile( cacheId, tileRect.ul() ).valid() )
+   {
+      return true; // Already read.
+   }
+
+   ossimRefPtr<ossimImageData> tile = ossimImageDataFactory::instance()->create(this, this);
+   if ( !tile.valid() )
+   {
+      return false;
+   }
+   tile->setImageRectangle(tileRect);
+   tile->initialize();
+
+   bool status = handler->getTile( tile.get(), resLevel );
+   if ( status && tile->getBuf() && (tile->getDataObjectStatus() != OSSIM_EMPTY) )
+   {
+      // Our own tile, no need to duplicate it.
+      ossimAppFixedTileCache::instance()->addTile(cacheId, tile, false);
+   }
+   return status;
+}
+
 ossimAppFixedTileCache::ossimAppFixedCacheId ossimCacheTileSource::getCacheId(ossim_uint32 resLevel)
 {
+   std::lock_guard<std::recursive_mutex> lock(theCacheIdMutex);
    ossimAppFixedTileCache::ossimAppFixedCacheId result = -1;
    if(theRLevelCacheList.empty())
    {
@@ -645,6 +734,7 @@ ossimAppFixedTileCache::ossimAppFixedCacheId ossimCacheTileSource::getCacheId(os
 
 void ossimCacheTileSource::deleteRlevelCache()
 {
+   std::lock_guard<std::recursive_mutex> lock(theCacheIdMutex);
    ossim_uint32 idx = 0;
    for(idx = 0; idx < theRLevelCacheList.size();++idx)
    {
@@ -655,6 +745,7 @@ void ossimCacheTileSource::deleteRlevelCache()
 
 void ossimCacheTileSource::initializeRlevelCache()
 {
+   std::lock_guard<std::recursive_mutex> lock(theCacheIdMutex);
    ossim_uint32 nLevels = getNumberOfDecimationLevels();
    deleteRlevelCache();
    
@@ -375,6 +375,315 @@ public:
       }
 };
 
+//---
+// Compiled evaluation.  The op classes above are applied a strip of pixels
+// at a time through a concrete object, so the calls are direct and the
+// loops can be vectorized.
+//---
+
+// Pixels of a band evaluated at a time.  Small enough for the strips of
+// the evaluation stack to stay in cache.
+static const ossim_uint32 STRIP_SIZE = 512;
+
+// Which pixels an operation touches, from the status of its operands the
+// way the interpreter's applyOp decides it.
+enum ossimEquNullMode
+{
+   OSSIM_EQU_NULL_ALL         = 0, // Every pixel.
+   OSSIM_EQU_NULL_VALID1      = 1, // Where the first operand is not null.
+   OSSIM_EQU_NULL_VALID2      = 2, // Where the second operand is not null.
+   OSSIM_EQU_NULL_VALID12     = 3, // Where neither operand is null.
+   OSSIM_EQU_NULL_TAKE2       = 4, // Copies the second operand.
+   OSSIM_EQU_NULL_TAKE2_VALID = 5, // Copies the second operand where not null.
+   OSSIM_EQU_NULL_KEEP1       = 6  // Leaves the first operand alone.
+};
+
+static int getUnaryNullMode(ossimDataObjectStatus status)
+{
+   if(status == OSSIM_FULL)    return OSSIM_EQU_NULL_ALL;
+   if(status == OSSIM_PARTIAL) return OSSIM_EQU_NULL_VALID1;
+   return OSSIM_EQU_NULL_KEEP1;
+}
+
+static int getBinaryNullMode(ossimDataObjectStatus status1,
+                             ossimDataObjectStatus status2)
+{
+   if(status1 == OSSIM_EMPTY)
+   {
+      if(status2 == OSSIM_FULL)    return OSSIM_EQU_NULL_TAKE2;
+      if(status2 == OSSIM_PARTIAL) return OSSIM_EQU_NULL_TAKE2_VALID;
+   }
+   else if(status1 == OSSIM_FULL)
+   {
+      if(status2 == OSSIM_FULL)    return OSSIM_EQU_NULL_ALL;
+      if(status2 == OSSIM_PARTIAL) return OSSIM_EQU_NULL_VALID2;
+   }
+   else if(status1 == OSSIM_PARTIAL)
+   {
+      if(status2 == OSSIM_FULL)    return OSSIM_EQU_NULL_VALID1;
+      if(status2 == OSSIM_PARTIAL) return OSSIM_EQU_NULL_VALID12;
+   }
+   return OSSIM_EQU_NULL_KEEP1;
+}
+
+template <class Op>
+static void applyUnaryStrip(int mode,
+                            const double* v,
+                            double* out,
+                            ossim_uint32 n,
+                            double np)
+{
+   Op op;
+   if(mode == OSSIM_EQU_NULL_ALL)
+   {
+      for(ossim_uint32 i = 0; i < n; ++i)
+      {
+         out[i] = op.apply(v[i]);
+      }
+   }
+   else
+   {
+      for(ossim_uint32 i = 0; i < n; ++i)
+      {
+         out[i] = (v[i] != np) ? op.apply(v[i]) : v[i];
+      }
+   }
+}
+
+template <class Op>
+static void applyBinaryStrip(int mode,
+                             const double* v1,
+                             const double* v2,
+                             double* out,
+                             ossim_uint32 n,
+                             double np1,
+                             double np2)
+{
+   Op op;
+   switch(mode)
+   {
+      case OSSIM_EQU_NULL_ALL:
+      {
+         for(ossim_uint32 i = 0; i < n; ++i)
+         {
+            out[i] = op.apply(v1[i], v2[i]);
+         }
+         break;
+      }
+      case OSSIM_EQU_NULL_VALID1:
+      {
+         for(ossim_uint32 i = 0; i < n; ++i)
+         {
+            out[i] = (v1[i] != np1) ? op.apply(v1[i], v2[i]) : v1[i];
+         }
+         break;
+      }
+      case OSSIM_EQU_NULL_VALID2:
+      {
+         for(ossim_uint32 i = 0; i < n; ++i)
+         {
+            out[i] = (v2[i] != np2) ? op.apply(v1[i], v2[i]) : v1[i];
+         }
+         break;
+      }
+      case OSSIM_EQU_NULL_VALID12:
+      {
+         for(ossim_uint32 i = 0; i < n; ++i)
+         {
+            out[i] = ((v1[i] != np1) && (v2[i] != np2)) ? op.apply(v1[i], v2[i]) : v1[i];
+         }
+         break;
+      }
+   }
+}
+
+template <class Op>
+static void applyBinaryConstantStrip(int mode,
+                                     const double* v,
+                                     double value,
+                                     bool constantFirst,
+                                     double* out,
+                                     ossim_uint32 n,
+                                     double np)
+{
+   Op op;
+   if(mode == OSSIM_EQU_NULL_ALL)
+   {
+      if(constantFirst)
+      {
+         for(ossim_uint32 i = 0; i < n; ++i)
+         {
+            out[i] = op.apply(value, v[i]);
+         }
+      }
+      else
+      {
+         for(ossim_uint32 i = 0; i < n; ++i)
+         {
+            out[i] = op.apply(v[i], value);
+         }
+      }
+   }
+   else if(constantFirst)
+   {
+      for(ossim_uint32 i = 0; i < n; ++i)
+      {
+         out[i] = (v[i] != np) ? op.apply(value, v[i]) : v[i];
+      }
+   }
+   else
+   {
+      for(ossim_uint32 i = 0; i < n; ++i)
+      {
+         out[i] = (v[i] != np) ? op.apply(v[i], value) : v[i];
+      }
+   }
+}
+
+static void applyClampStrip(int mode,
+                            const double* v,
+                            double minValue,
+                            double maxValue,
+                            double* out,
+                            ossim_uint32 n,
+                            double np)
+{
+   for(ossim_uint32 i = 0; i < n; ++i)
+   {
+      double value = v[i];
+      if((mode == OSSIM_EQU_NULL_ALL) || (value != np))
+      {
+         if(value < minValue) value = minValue;
+         else if(value > maxValue) value = maxValue;
+      }
+      out[i] = value;
+   }
+}
+
+// Folds constant sub-expressions at compile time.
+struct ossimEquFold
+{
+   double v1;
+   double v2;
+   double result;
+
+   template <class Op> void unary()  { result = Op().apply(v1); }
+   template <class Op> void binary() { result = Op().apply(v1, v2); }
+};
+
+// Runs one operation over a strip.
+struct ossimEquStrip
+{
+   enum
+   {
+      UNARY           = 0,
+      BINARY          = 1,
+      BINARY_CONSTANT = 2,
+      CONSTANT_BINARY = 3
+   };
+
+   int           kind;
+   int           mode;
+   const double* v1;
+   const double* v2;
+   double        value;
+   double        np1;
+   double        np2;
+   double*       out;
+   ossim_uint32  n;
+
+   template <class Op> void unary()
+   {
+      applyUnaryStrip<Op>(mode, v1, out, n, np1);
+   }
+
+   template <class Op> void binary()
+   {
+      if(kind == BINARY)
+      {
+         applyBinaryStrip<Op>(mode, v1, v2, out, n, np1, np2);
+      }
+      else
+      {
+         applyBinaryConstantStrip<Op>(mode, v1, value, (kind == CONSTANT_BINARY), out, n, np1);
+      }
+   }
+};
+
+// Calls visitor.unary<Op>() with the class of a unary operator or function.
+template <class Visitor>
+static bool dispatchUnaryOp(int op, Visitor& visitor)
+{
+   switch(op)
+   {
+      case OSSIM_EQU_TOKEN_MINUS: visitor.template unary<ossimUnaryOpNeg>();            break;
+      case OSSIM_EQU_TOKEN_TILDE: visitor.template unary<ossimUnaryOpOnesComplement>(); break;
+      case OSSIM_EQU_TOKEN_ABS:   visitor.template unary<ossimUnaryOpAbs>();            break;
+      case OSSIM_EQU_TOKEN_SIN:   visitor.template unary<ossimUnaryOpSin>();            break;
+      case OSSIM_EQU_TOKEN_SIND:  visitor.template unary<ossimUnaryOpSind>();           break;
+      case OSSIM_EQU_TOKEN_ASIN:  visitor.template unary<ossimUnaryOpASin>();           break;
+      case OSSIM_EQU_TOKEN_ASIND: visitor.template unary<ossimUnaryOpASind>();          break;
+      case OSSIM_EQU_TOKEN_COS:   visitor.template unary<ossimUnaryOpCos>();            break;
+      case OSSIM_EQU_TOKEN_COSD:  visitor.template unary<ossimUnaryOpCosd>();           break;
+      case OSSIM_EQU_TOKEN_ACOS:  visitor.template unary<ossimUnaryOpACos>();           break;
+      case OSSIM_EQU_TOKEN_ACOSD: visitor.template unary<ossimUnaryOpACosd>();          break;
+      case OSSIM_EQU_TOKEN_TAN:   visitor.template unary<ossimUnaryOpTan>();            break;
+      case OSSIM_EQU_TOKEN_TAND:  visitor.template unary<ossimUnaryOpTand>();           break;
+      case OSSIM_EQU_TOKEN_ATAN:  visitor.template unary<ossimUnaryOpATan>();           break;
+      case OSSIM_EQU_TOKEN_ATAND: visitor.template unary<ossimUnaryOpATand>();          break;
+      case OSSIM_EQU_TOKEN_LOG:   visitor.template unary<ossimUnaryOpLog>();            break;
+      case OSSIM_EQU_TOKEN_LOG10: visitor.template unary<ossimUnaryOpLog10>();          break;
+      case OSSIM_EQU_TOKEN_SQRT:  visitor.template unary<ossimUnaryOpSqrt>();           break;
+      case OSSIM_EQU_TOKEN_EXP:   visitor.template unary<ossimUnaryOpExp>();            break;
+      default: return false;
+   }
+   return true;
+}
+
+// Calls visitor.binary<Op>() with the class of a binary operator.
+template <class Visitor>
+static bool dispatchBinaryOp(int op, Visitor& visitor)
+{
+   switch(op)
+   {
+      case OSSIM_EQU_TOKEN_PLUS:            visitor.template binary<ossimBinaryOpAdd>();            break;
+      case OSSIM_EQU_TOKEN_MINUS:           visitor.template binary<ossimBinaryOpSub>();            break;
+      case OSSIM_EQU_TOKEN_MULT:            visitor.template binary<ossimBinaryOpMul>();            break;
+      case OSSIM_EQU_TOKEN_DIV:             visitor.template binary<ossimBinaryOpDiv>();            break;
+      case OSSIM_EQU_TOKEN_MOD:             visitor.template binary<ossimBinaryOpMod>();            break;
+      case OSSIM_EQU_TOKEN_POWER:           visitor.template binary<ossimBinaryOpPow>();            break;
+      case OSSIM_EQU_TOKEN_AMPERSAND:       visitor.template binary<ossimBinaryOpAnd>();            break;
+      case OSSIM_EQU_TOKEN_OR_BAR:          visitor.template binary<ossimBinaryOpOr>();             break;
+      case OSSIM_EQU_TOKEN_XOR:             visitor.template binary<ossimBinaryOpXor>();            break;
+      case OSSIM_EQU_TOKEN_BEQUAL:          visitor.template binary<ossimBinaryOpEqual>();          break;
+      case OSSIM_EQU_TOKEN_BGREATER:        visitor.template binary<ossimBinaryOpGreater>();        break;
+      case OSSIM_EQU_TOKEN_BGREATEROREQUAL: visitor.template binary<ossimBinaryOpGreaterOrEqual>(); break;
+      case OSSIM_EQU_TOKEN_BLESS:           visitor.template binary<ossimBinaryOpLess>();           break;
+      case OSSIM_EQU_TOKEN_BLESSOREQUAL:    visitor.template binary<ossimBinaryOpLessOrEqual>();    break;
+      case OSSIM_EQU_TOKEN_BDIFFERENT:      visitor.template binary<ossimBinaryOpDifferent>();      break;
+      case OSSIM_EQU_TOKEN_MIN:             visitor.template binary<ossimBinaryOpMin>();            break;
+      case OSSIM_EQU_TOKEN_MAX:             visitor.template binary<ossimBinaryOpMax>();            break;
+      default: return false;
+   }
+   return true;
+}
+
+// Status of the single band image the interpreter's band() function makes.
+static ossimDataObjectStatus getBandStatus(const ossimImageData* data, ossim_uint32 band)
+{
+   const double* buf = static_cast<const double*>(data->getBuf(band));
+   ossim_uint32 size = data->getSizePerBand();
+   double np = data->getNullPix(band);
+   ossim_uint32 count = 0;
+   for(ossim_uint32 i = 0; i < size; ++i)
+   {
+      if(buf[i] != np) ++count;
+   }
+   if(!count)        return OSSIM_EMPTY;
+   if(count == size) return OSSIM_FULL;
+   return OSSIM_PARTIAL;
+}
+
 
 ossimEquationCombiner::ossimEquationCombiner()
    :ossimImageCombiner(),
@@ -385,7 +694,14 @@ ossimEquationCombiner::ossimEquationCombiner()
     theCastFilter(NULL),
     theCastOutputFilter(NULL),
     theCurrentId(0),
-    theCurrentResLevel(0)
+    theCurrentResLevel(0),
+    theCompileFlag(true),
+    theCompiledEquation(""),
+    theProgram(),
+    theProgramInputs(),
+    theProgramDepth(0),
+    theInputTiles(),
+    theStripBuffer()
 {
    theLexer      = new ossimEquTokenizer;
    theCastFilter = new ossimCastTileSourceFilter;
@@ -401,7 +717,14 @@ ossimEquationCombiner::ossimEquationCombiner(ossimConnectableObject::Connectable
     theCastFilter(NULL),
     theCastOutputFilter(NULL),
     theCurrentId(0),
-    theCurrentResLevel(0)
+    theCurrentResLevel(0),
+    theCompileFlag(true),
+    theCompiledEquation(""),
+    theProgram(),
+    theProgramInputs(),
+    theProgramDepth(0),
+    theInputTiles(),
+    theStripBuffer()
 {
    theLexer      = new ossimEquTokenizer;
    theCastFilter = new ossimCastTileSourceFilter;
@@ -525,8 +848,17 @@ ossimRefPtr<ossimImageData> ossimEquationCombiner::getTile(
          theTile->makeBlank();
       }
       theCurrentResLevel = resLevel;
-      
-      ossimRefPtr<ossimImageData> outputTile =  parseEquation();
+
+      if(theCompileFlag && (theCompiledEquation != theEquation))
+      {
+         compileEquation();
+      }
+
+      ossimRefPtr<ossimImageData> outputTile = theTile;
+      if(!theCompileFlag || !evaluateProgram())
+      {
+         outputTile = parseEquation();
+      }
 
       if(theCastOutputFilter.valid())
       {
@@ -654,6 +986,22 @@ void ossimEquationCombiner::initialize()
    {
       theCastOutputFilter->initialize();
    }
+
+   theInputTiles.clear();
+   if(theCompileFlag)
+   {
+      compileEquation();
+   }
+}
+
+void ossimEquationCombiner::setCompileFlag(bool flag)
+{
+   theCompileFlag = flag;
+}
+
+bool ossimEquationCombiner::getCompileFlag()const
+{
+   return theCompileFlag;
 }
 
 void ossimEquationCombiner::assignValue()
@@ -1330,7 +1678,7 @@ bool ossimEquationCombiner::parseStdFuncs()
             theValueStack.pop();
             v1 = theValueStack.top();
             theValueStack.pop();
-            argCount -=2;
+            --argCount;
 
             do
             {
@@ -2844,6 +3192,714 @@ ossimRefPtr<ossimImageData> ossimEquationCombiner::parseEquation()
    return theTile;
 }    
 
+//---
+// Compiles the equation with the grammar of the parse methods above.  A
+// value on the stack is either a folded constant or an image whose
+// instructions are already in the program.  Anything the program cannot
+// express makes compile() return false.
+//---
+class ossimEquationCombiner::ossimEquCompiler
+{
+public:
+   ossimEquCompiler(ossimEquTokenizer* lexer,
+                    std::vector<ossimEquInstruction>& program,
+                    std::vector<ossim_uint32>& inputs)
+      :theLexer(lexer),
+       theCurrentId(0),
+       theValues(),
+       theProgram(program),
+       theInputs(inputs)
+      {
+      }
+
+   bool compile(const ossimString& equation)
+   {
+      istringstream inS(equation.string());
+      theLexer->switch_streams(&inS, &ossimNotify(ossimNotifyLevel_WARN));
+
+      theCurrentId = theLexer->yylex();
+      bool result = (theCurrentId != 0);
+      while(result && theCurrentId)
+      {
+         // Only the last of several expressions is assigned:
+         clear();
+         result = parseExpression() && (theValues.size() == 1);
+      }
+
+      if(result && !theValues.back().imageFlag)
+      {
+         double value = theValues.back().value;
+         clear();
+         emit(OSSIM_EQU_INSTRUCTION_CONSTANT, 0, value);
+      }
+      else if(!result)
+      {
+         clear();
+      }
+      theValues.clear();
+
+      return result;
+   }
+
+protected:
+   struct ossimEquCompiledValue
+   {
+      bool   imageFlag;
+      double value;
+   };
+
+   void clear()
+   {
+      theValues.clear();
+      theProgram.clear();
+      theInputs.clear();
+   }
+
+   void emit(int type, int op, double value = 0.0, double value2 = 0.0,
+             ossim_uint32 index = 0, ossim_uint32 band = 0)
+   {
+      ossimEquInstruction instruction;
+      instruction.type   = type;
+      instruction.op     = op;
+      instruction.value  = value;
+      instruction.value2 = value2;
+      instruction.index  = index;
+      instruction.band   = band;
+      theProgram.push_back(instruction);
+   }
+
+   void pushConstant(double value)
+   {
+      ossimEquCompiledValue v;
+      v.imageFlag = false;
+      v.value     = value;
+      theValues.push_back(v);
+   }
+
+   void pushInput(ossim_uint32 index)
+   {
+      ossim_uint32 slot = 0;
+      while((slot < theInputs.size()) && (theInputs[slot] != index))
+      {
+         ++slot;
+      }
+      if(slot == theInputs.size())
+      {
+         theInputs.push_back(index);
+      }
+      emit(OSSIM_EQU_INSTRUCTION_INPUT, 0, 0.0, 0.0, slot);
+
+      ossimEquCompiledValue v;
+      v.imageFlag = true;
+      v.value     = 0.0;
+      theValues.push_back(v);
+   }
+
+   bool applyUnary(int op)
+   {
+      if(theValues.empty()) return false;
+
+      ossimEquCompiledValue& v = theValues.back();
+      if(v.imageFlag)
+      {
+         emit(OSSIM_EQU_INSTRUCTION_UNARY, op);
+         return true;
+      }
+      ossimEquFold fold;
+      fold.v1 = v.value;
+      fold.v2 = 0.0;
+      fold.result = 0.0;
+      bool result = dispatchUnaryOp(op, fold);
+      v.value = fold.result;
+      return result;
+   }
+
+   bool applyBinary(int op)
+   {
+      if(theValues.size() < 2) return false;
+
+      ossimEquCompiledValue v2 = theValues.back();
+      theValues.pop_back();
+      ossimEquCompiledValue& v1 = theValues.back();
+
+      bool result = true;
+      if(v1.imageFlag && v2.imageFlag)
+      {
+         emit(OSSIM_EQU_INSTRUCTION_BINARY, op);
+      }
+      else if(v1.imageFlag)
+      {
+         emit(OSSIM_EQU_INSTRUCTION_BINARY_CONSTANT, op, v2.value);
+      }
+      else if(v2.imageFlag)
+      {
+         emit(OSSIM_EQU_INSTRUCTION_CONSTANT_BINARY, op, v1.value);
+         v1.imageFlag = true;
+      }
+      else
+      {
+         ossimEquFold fold;
+         fold.v1 = v1.value;
+         fold.v2 = v2.value;
+         fold.result = 0.0;
+         result = dispatchBinaryOp(op, fold);
+         v1.value = fold.result;
+      }
+      return result;
+   }
+
+   bool parseArgList(ossim_uint32& count)
+   {
+      if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_PAREN) return false;
+
+      theCurrentId = theLexer->yylex();
+      do
+      {
+         if(!parseExpression()) return false;
+         ++count;
+
+         if(theCurrentId == OSSIM_EQU_TOKEN_COMMA)
+         {
+            theCurrentId = theLexer->yylex();
+         }
+         else if(theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN)
+         {
+            return false;
+         }
+      }while(theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN);
+
+      theCurrentId = theLexer->yylex();
+      return true;
+   }
+
+   bool parseStdFuncs()
+   {
+      int function = theCurrentId;
+      switch(function)
+      {
+         case OSSIM_EQU_TOKEN_ABS:
+         case OSSIM_EQU_TOKEN_SIN:
+         case OSSIM_EQU_TOKEN_SIND:
+         case OSSIM_EQU_TOKEN_ASIN:
+         case OSSIM_EQU_TOKEN_ASIND:
+         case OSSIM_EQU_TOKEN_COS:
+         case OSSIM_EQU_TOKEN_COSD:
+         case OSSIM_EQU_TOKEN_ACOS:
+         case OSSIM_EQU_TOKEN_ACOSD:
+         case OSSIM_EQU_TOKEN_TAN:
+         case OSSIM_EQU_TOKEN_TAND:
+         case OSSIM_EQU_TOKEN_ATAN:
+         case OSSIM_EQU_TOKEN_ATAND:
+         case OSSIM_EQU_TOKEN_LOG:
+         case OSSIM_EQU_TOKEN_LOG10:
+         case OSSIM_EQU_TOKEN_SQRT:
+         case OSSIM_EQU_TOKEN_EXP:
+         {
+            theCurrentId = theLexer->yylex();
+            if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_PAREN) return false;
+
+            theCurrentId = theLexer->yylex();
+            if(!parseExpression() || (theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN))
+            {
+               return false;
+            }
+            theCurrentId = theLexer->yylex();
+            return applyUnary(function);
+         }
+         case OSSIM_EQU_TOKEN_MIN:
+         case OSSIM_EQU_TOKEN_MAX:
+         {
+            theCurrentId = theLexer->yylex();
+            if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_PAREN) return false;
+
+            theCurrentId = theLexer->yylex();
+            ossim_uint32 count = 0;
+            bool done = false;
+            while(!done)
+            {
+               if(!parseExpression()) return false;
+               ++count;
+
+               if(theCurrentId == OSSIM_EQU_TOKEN_RIGHT_PAREN)
+               {
+                  done = true;
+               }
+               else if(theCurrentId != OSSIM_EQU_TOKEN_COMMA)
+               {
+                  return false;
+               }
+               theCurrentId = theLexer->yylex();
+            }
+            if(count < 2) return false;
+
+            // Folded from the last argument like the interpreter, i.e.
+            // min(a, b, c) is min(a, min(b, c)):
+            for(ossim_uint32 i = 1; i < count; ++i)
+            {
+               if(!applyBinary(function)) return false;
+            }
+            return true;
+         }
+         case OSSIM_EQU_TOKEN_CLAMP:
+         {
+            theCurrentId = theLexer->yylex();
+            ossim_uint32 count = 0;
+            if(!parseArgList(count) || (count != 3)) return false;
+
+            ossimEquCompiledValue maxValue = theValues.back();
+            theValues.pop_back();
+            ossimEquCompiledValue minValue = theValues.back();
+            theValues.pop_back();
+            if(!theValues.back().imageFlag || minValue.imageFlag || maxValue.imageFlag)
+            {
+               return false;
+            }
+            if(minValue.value > maxValue.value)
+            {
+               std::swap(minValue, maxValue);
+            }
+            emit(OSSIM_EQU_INSTRUCTION_CLAMP, function, minValue.value, maxValue.value);
+            return true;
+         }
+         case OSSIM_EQU_TOKEN_BAND:
+         {
+            theCurrentId = theLexer->yylex();
+            ossim_uint32 count = 0;
+            if(!parseArgList(count) || (count != 2)) return false;
+
+            // Only the band of an input, the band is taken where it is read:
+            ossimEquCompiledValue bandValue = theValues.back();
+            theValues.pop_back();
+            if(bandValue.imageFlag || !theValues.back().imageFlag ||
+               (theProgram.back().type != OSSIM_EQU_INSTRUCTION_INPUT))
+            {
+               return false;
+            }
+            theProgram.back().type = OSSIM_EQU_INSTRUCTION_INPUT_BAND;
+            theProgram.back().band = (ossim_uint32)bandValue.value;
+            return true;
+         }
+         default:
+         {
+            // assign_band, conv, blurr and shift are left to the interpreter.
+            return false;
+         }
+      }
+   }
+
+   bool parseUnaryFactor()
+   {
+      int op = theCurrentId;
+      if((op != OSSIM_EQU_TOKEN_MINUS) && (op != OSSIM_EQU_TOKEN_TILDE))
+      {
+         return false;
+      }
+      theCurrentId = theLexer->yylex();
+      return parseFactor() && applyUnary(op);
+   }
+
+   bool parseFactor()
+   {
+      switch(theCurrentId)
+      {
+         case OSSIM_EQU_TOKEN_CONSTANT:
+         {
+            pushConstant(atof(theLexer->YYText()));
+            theCurrentId = theLexer->yylex();
+            return true;
+         }
+         case OSSIM_EQU_TOKEN_PI:
+         {
+            pushConstant(M_PI);
+            theCurrentId = theLexer->yylex();
+            return true;
+         }
+         case OSSIM_EQU_TOKEN_IMAGE_VARIABLE:
+         {
+            theCurrentId = theLexer->yylex();
+            if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_ARRAY_BRACKET) return false;
+
+            theCurrentId = theLexer->yylex();
+            if(!parseExpression() || theValues.empty() || theValues.back().imageFlag ||
+               (theCurrentId != OSSIM_EQU_TOKEN_RIGHT_ARRAY_BRACKET))
+            {
+               return false;
+            }
+            theCurrentId = theLexer->yylex();
+
+            ossim_uint32 index = (ossim_uint32)theValues.back().value;
+            theValues.pop_back();
+            pushInput(index);
+            return true;
+         }
+         case OSSIM_EQU_TOKEN_LEFT_PAREN:
+         {
+            theCurrentId = theLexer->yylex();
+            if(!parseExpression() || (theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN))
+            {
+               return false;
+            }
+            theCurrentId = theLexer->yylex();
+            return true;
+         }
+         case OSSIM_EQU_TOKEN_MINUS:
+         case OSSIM_EQU_TOKEN_TILDE:
+         {
+            return parseUnaryFactor();
+         }
+      }
+      return parseStdFuncs();
+   }
+
+   bool parseRestOfTerm()
+   {
+      int op = theCurrentId;
+      switch(op)
+      {
+         case OSSIM_EQU_TOKEN_MULT:
+         case OSSIM_EQU_TOKEN_DIV:
+         case OSSIM_EQU_TOKEN_XOR:
+         case OSSIM_EQU_TOKEN_AMPERSAND:
+         case OSSIM_EQU_TOKEN_OR_BAR:
+         case OSSIM_EQU_TOKEN_MOD:
+         case OSSIM_EQU_TOKEN_POWER:
+         case OSSIM_EQU_TOKEN_BEQUAL:
+         case OSSIM_EQU_TOKEN_BGREATER:
+         case OSSIM_EQU_TOKEN_BGREATEROREQUAL:
+         case OSSIM_EQU_TOKEN_BLESS:
+         case OSSIM_EQU_TOKEN_BLESSOREQUAL:
+         case OSSIM_EQU_TOKEN_BDIFFERENT:
+         {
+            theCurrentId = theLexer->yylex();
+            return parseFactor() && applyBinary(op) && parseRestOfTerm();
+         }
+      }
+      return true;
+   }
+
+   bool parseTerm()
+   {
+      return parseFactor() && parseRestOfTerm();
+   }
+
+   bool parseRestOfExp()
+   {
+      int op = theCurrentId;
+      if((op == OSSIM_EQU_TOKEN_PLUS) || (op == OSSIM_EQU_TOKEN_MINUS))
+      {
+         theCurrentId = theLexer->yylex();
+         return parseTerm() && applyBinary(op) && parseRestOfExp();
+      }
+      return true;
+   }
+
+   bool parseExpression()
+   {
+      return parseTerm() && parseRestOfExp();
+   }
+
+   ossimEquTokenizer*                 theLexer;
+   int                                theCurrentId;
+   std::vector<ossimEquCompiledValue> theValues;
+   std::vector<ossimEquInstruction>&  theProgram;
+   std::vector<ossim_uint32>&         theInputs;
+};
+
+bool ossimEquationCombiner::compileEquation()
+{
+   theCompiledEquation = theEquation;
+   theProgramDepth = 0;
+
+   ossimEquCompiler compiler(theLexer, theProgram, theProgramInputs);
+   bool result = compiler.compile(theEquation);
+
+   ossim_uint32 depth = 0;
+   for(ossim_uint32 i = 0; i < theProgram.size(); ++i)
+   {
+      int type = theProgram[i].type;
+      if((type == OSSIM_EQU_INSTRUCTION_INPUT) || (type == OSSIM_EQU_INSTRUCTION_INPUT_BAND))
+      {
+         theProgramDepth = std::max(theProgramDepth, ++depth);
+      }
+      else if(type == OSSIM_EQU_INSTRUCTION_BINARY)
+      {
+         --depth;
+      }
+   }
+   theStripBuffer.resize(theProgramDepth * STRIP_SIZE);
+
+   return result;
+}
+
+// Planning state of an image on the evaluation stack.
+struct ossimEquNode
+{
+   ossimDataObjectStatus status;
+   ossim_uint32          bands;
+   ossim_uint32          owner; // Instruction of the input whose nulls it carries.
+};
+
+// Per tile and band state of an instruction.
+struct ossimEquStep
+{
+   int           mode;
+   ossim_uint32  owner1;
+   ossim_uint32  owner2;
+   double        np1;
+   double        np2;
+   const double* leaf;
+};
+
+bool ossimEquationCombiner::evaluateProgram()
+{
+   if(theProgram.empty() || !theTile->getBuf()) return false;
+
+   const ossim_uint32 SIZE = theTile->getSizePerBand();
+   const ossim_uint32 OUTPUT_BANDS = theTile->getNumberOfBands();
+
+   if(theProgram[0].type == OSSIM_EQU_INSTRUCTION_CONSTANT)
+   {
+      double* buf = static_cast<double*>(theTile->getBuf());
+      std::fill(buf, buf + theTile->getSize(), theProgram[0].value);
+      theTile->validate();
+      return true;
+   }
+
+   // Each input is read once however often the equation uses it:
+   ossim_uint32 inputCount = (ossim_uint32)theProgramInputs.size();
+   if(theInputTiles.size() < inputCount)
+   {
+      theInputTiles.resize(inputCount);
+   }
+   std::vector< ossimRefPtr<ossimImageData> > inputs(inputCount);
+   for(ossim_uint32 i = 0; i < inputCount; ++i)
+   {
+      ossimRefPtr<ossimImageData> data = getImageData(theProgramInputs[i]);
+      if(!data.valid() || !data->getBuf() || (data->getSizePerBand() != SIZE))
+      {
+         return false;
+      }
+      ossimDataObjectStatus status = data->getDataObjectStatus();
+      if((status != OSSIM_FULL) && (status != OSSIM_PARTIAL) && (status != OSSIM_EMPTY))
+      {
+         return false;
+      }
+      if(i + 1 < inputCount)
+      {
+         // The cast filter reuses its tile for the next input:
+         if(theInputTiles[i].valid())
+         {
+            *theInputTiles[i] = *data;
+         }
+         else
+         {
+            theInputTiles[i] = (ossimImageData*)data->dup();
+         }
+         data = theInputTiles[i];
+      }
+      inputs[i] = data;
+   }
+
+   // Which pixels each step touches, from the input statuses:
+   std::vector<ossimEquStep> steps(theProgram.size());
+   std::vector<ossimEquNode> nodes;
+   nodes.reserve(theProgramDepth);
+   for(ossim_uint32 i = 0; i < theProgram.size(); ++i)
+   {
+      const ossimEquInstruction& instruction = theProgram[i];
+      ossimEquStep& step = steps[i];
+      step.mode = OSSIM_EQU_NULL_KEEP1;
+      switch(instruction.type)
+      {
+         case OSSIM_EQU_INSTRUCTION_INPUT:
+         {
+            const ossimImageData* data = inputs[instruction.index].get();
+            ossimEquNode node;
+            node.status = data->getDataObjectStatus();
+            node.bands  = data->getNumberOfBands();
+            node.owner  = i;
+            nodes.push_back(node);
+            break;
+         }
+         case OSSIM_EQU_INSTRUCTION_INPUT_BAND:
+         {
+            const ossimImageData* data = inputs[instruction.index].get();
+            if(instruction.band >= data->getNumberOfBands()) return false;
+
+            ossimEquNode node;
+            node.status = getBandStatus(data, instruction.band);
+            node.bands  = 1;
+            node.owner  = i;
+            nodes.push_back(node);
+            break;
+         }
+         case OSSIM_EQU_INSTRUCTION_BINARY:
+         {
+            ossimEquNode node2 = nodes.back();
+            nodes.pop_back();
+            ossimEquNode& node1 = nodes.back();
+
+            // The interpreter's band broadcasting is not reproduced:
+            if(node1.bands != node2.bands) return false;
+
+            step.mode   = getBinaryNullMode(node1.status, node2.status);
+            step.owner1 = node1.owner;
+            step.owner2 = node2.owner;
+            if(node1.status == OSSIM_EMPTY)
+            {
+               node1.status = node2.status;
+            }
+            break;
+         }
+         default:
+         {
+            step.mode   = getUnaryNullMode(nodes.back().status);
+            step.owner1 = nodes.back().owner;
+            break;
+         }
+      }
+   }
+
+   const ossimEquNode& result = nodes.back();
+   if((result.status == OSSIM_FULL) || (result.status == OSSIM_PARTIAL))
+   {
+      std::vector<const double*> operands(theProgramDepth);
+      double* strips = &theStripBuffer.front();
+
+      for(ossim_uint32 band = 0; band < OUTPUT_BANDS; ++band)
+      {
+         // Output bands past the result's repeat its last band:
+         ossim_uint32 inputBand = std::min(band, result.bands - 1);
+
+         for(ossim_uint32 i = 0; i < theProgram.size(); ++i)
+         {
+            const ossimEquInstruction& instruction = theProgram[i];
+            ossimEquStep& step = steps[i];
+            if(instruction.type == OSSIM_EQU_INSTRUCTION_INPUT)
+            {
+               step.leaf = static_cast<const double*>(inputs[instruction.index]->getBuf(inputBand));
+            }
+            else if(instruction.type == OSSIM_EQU_INSTRUCTION_INPUT_BAND)
+            {
+               step.leaf = static_cast<const double*>(inputs[instruction.index]->getBuf(instruction.band));
+            }
+            else if(step.mode != OSSIM_EQU_NULL_KEEP1)
+            {
+               const ossimEquInstruction& owner1 = theProgram[step.owner1];
+               step.np1 = inputs[owner1.index]->getNullPix(
+                  (owner1.type == OSSIM_EQU_INSTRUCTION_INPUT) ? inputBand : owner1.band);
+               if(instruction.type == OSSIM_EQU_INSTRUCTION_BINARY)
+               {
+                  const ossimEquInstruction& owner2 = theProgram[step.owner2];
+                  step.np2 = inputs[owner2.index]->getNullPix(
+                     (owner2.type == OSSIM_EQU_INSTRUCTION_INPUT) ? inputBand : owner2.band);
+               }
+            }
+         }
+
+         // Null of the result, out of range past its bands as in assignValue():
+         double np = ossim::defaultNull(OSSIM_FLOAT64);
+         if(band < result.bands)
+         {
+            const ossimEquInstruction& owner = theProgram[result.owner];
+            np = inputs[owner.index]->getNullPix(
+               (owner.type == OSSIM_EQU_INSTRUCTION_INPUT) ? band : owner.band);
+         }
+
+         double* outBuf = static_cast<double*>(theTile->getBuf(band));
+         for(ossim_uint32 start = 0; start < SIZE; start += STRIP_SIZE)
+         {
+            ossim_uint32 n = std::min(STRIP_SIZE, SIZE - start);
+            ossim_uint32 top = 0;
+
+            for(ossim_uint32 i = 0; i < theProgram.size(); ++i)
+            {
+               const ossimEquInstruction& instruction = theProgram[i];
+               const ossimEquStep& step = steps[i];
+
+               if((instruction.type == OSSIM_EQU_INSTRUCTION_INPUT) ||
+                  (instruction.type == OSSIM_EQU_INSTRUCTION_INPUT_BAND))
+               {
+                  operands[top++] = step.leaf + start;
+                  continue;
+               }
+
+               ossim_uint32 slot = (instruction.type == OSSIM_EQU_INSTRUCTION_BINARY) ? top - 2 : top - 1;
+               double* out = strips + slot * STRIP_SIZE;
+               if(step.mode == OSSIM_EQU_NULL_TAKE2)
+               {
+                  std::copy(operands[top - 1], operands[top - 1] + n, out);
+                  operands[slot] = out;
+               }
+               else if(step.mode == OSSIM_EQU_NULL_TAKE2_VALID)
+               {
+                  const double* v1 = operands[slot];
+                  const double* v2 = operands[top - 1];
+                  for(ossim_uint32 p = 0; p < n; ++p)
+                  {
+                     out[p] = (v2[p] != step.np2) ? v2[p] : v1[p];
+                  }
+                  operands[slot] = out;
+               }
+               else if(step.mode != OSSIM_EQU_NULL_KEEP1)
+               {
+                  if(instruction.type == OSSIM_EQU_INSTRUCTION_CLAMP)
+                  {
+                     applyClampStrip(step.mode, operands[slot], instruction.value,
+                                     instruction.value2, out, n, step.np1);
+                  }
+                  else
+                  {
+                     ossimEquStrip strip;
+                     strip.mode  = step.mode;
+                     strip.v1    = operands[slot];
+                     strip.v2    = operands[top - 1];
+                     strip.value = instruction.value;
+                     strip.np1   = step.np1;
+                     strip.np2   = step.np2;
+                     strip.out   = out;
+                     strip.n     = n;
+                     if(instruction.type == OSSIM_EQU_INSTRUCTION_UNARY)
+                     {
+                        strip.kind = ossimEquStrip::UNARY;
+                        dispatchUnaryOp(instruction.op, strip);
+                     }
+                     else
+                     {
+                        strip.kind = (instruction.type == OSSIM_EQU_INSTRUCTION_BINARY) ?
+                           ossimEquStrip::BINARY :
+                           (instruction.type == OSSIM_EQU_INSTRUCTION_BINARY_CONSTANT) ?
+                           ossimEquStrip::BINARY_CONSTANT : ossimEquStrip::CONSTANT_BINARY;
+                        dispatchBinaryOp(instruction.op, strip);
+                     }
+                  }
+                  operands[slot] = out;
+               }
+               top = slot + 1;
+            }
+
+            // Assigned like assignValue(), null pixels keep the blank tile's:
+            const double* value = operands[0];
+            double* outPtr = outBuf + start;
+            if(result.status == OSSIM_FULL)
+            {
+               std::copy(value, value + n, outPtr);
+            }
+            else
+            {
+               for(ossim_uint32 p = 0; p < n; ++p)
+               {
+                  if(value[p] != np) outPtr[p] = value[p];
+               }
+            }
+         }
+      }
+   }
+
+   theTile->validate();
+   return true;
+}
+
 bool ossimEquationCombiner::applyClamp(ossimImageData* &result,
                                        const vector<ossimEquValue>& argList)
 {
@@ -22,6 +22,15 @@
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimDrect.h>
 #include <ossim/imaging/ossimFilterTable.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define OSSIM_RESAMPLER_X86 1
+#  include <immintrin.h>
+#endif
+
 ossimFilterResampler::ossimFilterResampler()
    :theMinifyFilter(new ossimNearestNeighborFilter()),
     theMagnifyFilter(new ossimNearestNeighborFilter()),
@@ -29,7 +38,9 @@ ossimFilterResampler::ossimFilterResampler()
     theMagnifyFilterType(ossimFilterResampler_NEAREST_NEIGHBOR),
     theScaleFactor(1.0, 1.0),
     theInverseScaleFactor(1.0, 1.0),
-    theBlurFactor(1.0)
+    theBlurFactor(1.0),
+    theChangeCount(0),
+    theSeparableFlag(true)
 {
    setScaleFactor(ossimDpt(1.0, 1.0));
    loadState(ossimPreferences::instance()->preferencesKWL(),"resampler.");
@@ -359,28 +370,32 @@ template <class T> void ossimFilterResampler::resampleBilinearTile(
    ossim_uint32 resultOffset=(outputSubRect.ul().y - outputRect.ul().y)*outputRectW +
                              (outputSubRect.ul().x - outputRect.ul().x);
 
-   // make a local copy of the band pointers (at resultOffset)
-   ossim_float64 *densityvals=new ossim_float64[BANDS];
-   ossim_float64 *pixelvals=new ossim_float64[BANDS];
-   const T* *inputBuf  = new const T*[BANDS];
-   T* *resultBuf = new T*[BANDS];
-   if(!pixelvals||!inputBuf||!resultBuf)
+   // FILTER INFORMAION
+   ossim_uint32 xkernel_width  = theFilterTable.getWidth();;
+   ossim_uint32 ykernel_height = theFilterTable.getHeight();
+   double xkernel_half_width   = theFilterTable.getXSupport();
+   double ykernel_half_height  = theFilterTable.getYSupport();
+
+   // Scale only transforms take the separable two pass path:
+   if ( xkernel_width && ykernel_height && theSeparableFlag &&
+        resampleSeparableTile(T(0), input, output, outputSubRect,
+                              inputUl, inputUr, deltaUl, deltaUr, outLength) )
    {
       return;
    }
-   
+
+   // make a local copy of the band pointers (at resultOffset)
+   std::vector<ossim_float64> densityvals(BANDS);
+   std::vector<ossim_float64> pixelvals(BANDS);
+   std::vector<const T*> inputBuf(BANDS);
+   std::vector<T*> resultBuf(BANDS);
+
    for(band = 0; band < BANDS; ++band)
    {
       inputBuf[band] = static_cast<const T*>(input->getBuf(band));
       resultBuf[band] = static_cast<T*>(output->getBuf(band))+resultOffset;
    }
 
-   // FILTER INFORMAION
-   ossim_uint32 xkernel_width  = theFilterTable.getWidth();;
-   ossim_uint32 ykernel_height = theFilterTable.getHeight();
-   double xkernel_half_width   = theFilterTable.getXSupport();
-   double ykernel_half_height  = theFilterTable.getYSupport();
-
    double initialx  = inputUl.x-inputRect.ul().x;
    double initialy  = inputUl.y-inputRect.ul().y;
    double terminalx = inputUr.x-inputRect.ul().x;
@@ -475,8 +490,8 @@ template <class T> void ossimFilterResampler::resampleBilinearTile(
                if(kernel)
                {
                   // reset the pixel/density sums for each band to zero.
-                  memset(densityvals,'\0',sizeof(ossim_float64)*BANDS);
-                  memset(pixelvals,'\0',sizeof(ossim_float64)*BANDS);
+                  std::fill(densityvals.begin(), densityvals.end(), 0.0);
+                  std::fill(pixelvals.begin(), pixelvals.end(), 0.0);
 
                   // apply kernel to input space.
                   for (iy=0;((iy<ykernel_height)&&(sourceIndex<inBandSize));++iy)
@@ -551,11 +566,668 @@ template <class T> void ossimFilterResampler::resampleBilinearTile(
          terminaly  += deltaUr.y;
       } // End of loop in y direction.
    } // USING A KERNEL END
+}
+
+//---
+// Kernels for the separable path.  Each has a plain C++ version and, on x86
+// with gcc or clang, SSE2 and AVX2 versions compiled with target attributes,
+// so the build needs no arch flags.  The widest set the cpu runs is picked
+// once at run time; the preference "resampler.simd" (none, sse2 or avx2) can
+// lower it.  The vector versions add in the same order as the plain ones and
+// do not fuse multiply adds, so every set gives the same bits.
+//---
+namespace
+{
+   enum SimdLevel
+   {
+      SIMD_NONE = 0,
+      SIMD_SSE2 = 1,
+      SIMD_AVX2 = 2
+   };
+
+   SimdLevel findSimdLevel()
+   {
+      SimdLevel level = SIMD_NONE;
+#if defined(OSSIM_RESAMPLER_X86)
+      __builtin_cpu_init();
+      if ( __builtin_cpu_supports("avx2") )
+      {
+         level = SIMD_AVX2;
+      }
+      else if ( __builtin_cpu_supports("sse2") )
+      {
+         level = SIMD_SSE2;
+      }
+#endif
+      const char* lookup = ossimPreferences::instance()->findPreference("resampler.simd");
+      if ( lookup )
+      {
+         ossimString cap = ossimString(lookup).downcase();
+         if ( cap == "none" )
+         {
+            level = SIMD_NONE;
+         }
+         else if ( (cap == "sse2") && (level > SIMD_SSE2) )
+         {
+            level = SIMD_SSE2;
+         }
+      }
+      return level;
+   }
+
+   SimdLevel getSimdLevel()
+   {
+      static const SimdLevel LEVEL = findSimdLevel();
+      return LEVEL;
+   }
+
+   //---
+   // Line conversion, input type to double.
+   //---
+   template <class T>
+   void convertLine(const T* src, ossim_int32 count, ossim_float64* dst)
+   {
+      for (ossim_int32 i = 0; i < count; ++i)
+      {
+         dst[i] = src[i];
+      }
+   }
+
+#if defined(OSSIM_RESAMPLER_X86)
+   // Four int32 to doubles, low two then high two:
+   __attribute__((target("sse2")))
+   inline void storeSse2(__m128i v, ossim_float64* dst)
+   {
+      _mm_storeu_pd(dst, _mm_cvtepi32_pd(v));
+      _mm_storeu_pd(dst + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2))));
+   }
 
-   delete [] densityvals;
-   delete [] pixelvals;
-   delete [] resultBuf;
-   delete [] inputBuf;
+   __attribute__((target("sse2")))
+   void convertLineSse2(const ossim_uint8* src, ossim_int32 count, ossim_float64* dst)
+   {
+      const __m128i ZERO = _mm_setzero_si128();
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         ossim_int32 bytes;
+         memcpy(&bytes, src + i, 4);
+         __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), ZERO);
+         storeSse2(_mm_unpacklo_epi16(v, ZERO), dst + i);
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("sse2")))
+   void convertLineSse2(const ossim_uint16* src, ossim_int32 count, ossim_float64* dst)
+   {
+      const __m128i ZERO = _mm_setzero_si128();
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+         storeSse2(_mm_unpacklo_epi16(v, ZERO), dst + i);
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("sse2")))
+   void convertLineSse2(const ossim_sint16* src, ossim_int32 count, ossim_float64* dst)
+   {
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         // Each value into the high half of a lane, then shift back with sign:
+         __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+         storeSse2(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16), dst + i);
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("sse2")))
+   void convertLineSse2(const ossim_float32* src, ossim_int32 count, ossim_float64* dst)
+   {
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128 v = _mm_loadu_ps(src + i);
+         _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+         _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("avx2")))
+   void convertLineAvx2(const ossim_uint8* src, ossim_int32 count, ossim_float64* dst)
+   {
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         ossim_int32 bytes;
+         memcpy(&bytes, src + i, 4);
+         __m128i v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+         _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(v));
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("avx2")))
+   void convertLineAvx2(const ossim_uint16* src, ossim_int32 count, ossim_float64* dst)
+   {
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+         _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(v)));
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("avx2")))
+   void convertLineAvx2(const ossim_sint16* src, ossim_int32 count, ossim_float64* dst)
+   {
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+         _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(v)));
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+
+   __attribute__((target("avx2")))
+   void convertLineAvx2(const ossim_float32* src, ossim_int32 count, ossim_float64* dst)
+   {
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+      }
+      convertLine(src + i, count - i, dst + i);
+   }
+#endif /* #if defined(OSSIM_RESAMPLER_X86) */
+
+   // Other input types keep the plain conversion:
+   template <class T>
+   struct LineConverter
+   {
+      typedef void (*Function)(const T*, ossim_int32, ossim_float64*);
+
+      static Function get()
+      {
+         return convertLine<T>;
+      }
+
+      static Function pick(Function sse2, Function avx2)
+      {
+         switch ( getSimdLevel() )
+         {
+            case SIMD_AVX2:
+               return avx2;
+            case SIMD_SSE2:
+               return sse2;
+            default:
+               return convertLine<T>;
+         }
+      }
+   };
+
+#if defined(OSSIM_RESAMPLER_X86)
+   template <> LineConverter<ossim_uint8>::Function LineConverter<ossim_uint8>::get()
+   {
+      return pick(convertLineSse2, convertLineAvx2);
+   }
+
+   template <> LineConverter<ossim_uint16>::Function LineConverter<ossim_uint16>::get()
+   {
+      return pick(convertLineSse2, convertLineAvx2);
+   }
+
+   template <> LineConverter<ossim_sint16>::Function LineConverter<ossim_sint16>::get()
+   {
+      return pick(convertLineSse2, convertLineAvx2);
+   }
+
+   template <> LineConverter<ossim_float32>::Function LineConverter<ossim_float32>::get()
+   {
+      return pick(convertLineSse2, convertLineAvx2);
+   }
+#endif
+
+   //---
+   // Horizontal pass over one converted line.  Output column x sums the
+   // kernel from line[colStart[x]] with weights[k*count + x], skipping nulls,
+   // into pixelSum[x] and the weights used into densitySum[x].
+   //---
+   typedef void (*HorizontalFunction)(const ossim_float64* line,
+                                      const ossim_int32* colStart,
+                                      const ossim_float64* weights,
+                                      ossim_int32 kernelWidth,
+                                      ossim_uint32 count,
+                                      ossim_float64 np,
+                                      ossim_float64* pixelSum,
+                                      ossim_float64* densitySum);
+
+   // Columns first to count; the vector versions finish their tails here.
+   inline void horizontalColumns(ossim_uint32 first,
+                                 const ossim_float64* line,
+                                 const ossim_int32* colStart,
+                                 const ossim_float64* weights,
+                                 ossim_int32 kernelWidth,
+                                 ossim_uint32 count,
+                                 ossim_float64 np,
+                                 ossim_float64* pixelSum,
+                                 ossim_float64* densitySum)
+   {
+      for (ossim_uint32 x = first; x < count; ++x)
+      {
+         const ossim_float64* s = line + colStart[x];
+         const ossim_float64* w = weights + x;
+         ossim_float64 p = 0.0;
+         ossim_float64 d = 0.0;
+         for (ossim_int32 k = 0; k < kernelWidth; ++k, w += count)
+         {
+            ossim_float64 v  = s[k];
+            ossim_float64 wk = (v != np) ? *w : 0.0;
+            p += v*wk;
+            d += wk;
+         }
+         pixelSum[x]   = p;
+         densitySum[x] = d;
+      }
+   }
+
+   void horizontalPass(const ossim_float64* line,
+                       const ossim_int32* colStart,
+                       const ossim_float64* weights,
+                       ossim_int32 kernelWidth,
+                       ossim_uint32 count,
+                       ossim_float64 np,
+                       ossim_float64* pixelSum,
+                       ossim_float64* densitySum)
+   {
+      horizontalColumns(0, line, colStart, weights, kernelWidth, count, np,
+                        pixelSum, densitySum);
+   }
+
+#if defined(OSSIM_RESAMPLER_X86)
+   //---
+   // Nulls are masked with an and on the weight, which gives +0 like the
+   // plain version, so even the sign of zero sums matches.
+   //---
+   __attribute__((target("sse2")))
+   void horizontalPassSse2(const ossim_float64* line,
+                           const ossim_int32* colStart,
+                           const ossim_float64* weights,
+                           ossim_int32 kernelWidth,
+                           ossim_uint32 count,
+                           ossim_float64 np,
+                           ossim_float64* pixelSum,
+                           ossim_float64* densitySum)
+   {
+      const __m128d NP = _mm_set1_pd(np);
+      ossim_uint32 x = 0;
+      for (; x + 2 <= count; x += 2)
+      {
+         const ossim_float64* s0 = line + colStart[x];
+         const ossim_float64* s1 = line + colStart[x + 1];
+         const ossim_float64* w  = weights + x;
+         __m128d p = _mm_setzero_pd();
+         __m128d d = _mm_setzero_pd();
+         for (ossim_int32 k = 0; k < kernelWidth; ++k, w += count)
+         {
+            __m128d v  = _mm_set_pd(s1[k], s0[k]);
+            __m128d wk = _mm_and_pd(_mm_loadu_pd(w), _mm_cmpneq_pd(v, NP));
+            p = _mm_add_pd(p, _mm_mul_pd(v, wk));
+            d = _mm_add_pd(d, wk);
+         }
+         _mm_storeu_pd(pixelSum + x, p);
+         _mm_storeu_pd(densitySum + x, d);
+      }
+      horizontalColumns(x, line, colStart, weights, kernelWidth, count, np,
+                        pixelSum, densitySum);
+   }
+
+   __attribute__((target("avx2")))
+   void horizontalPassAvx2(const ossim_float64* line,
+                           const ossim_int32* colStart,
+                           const ossim_float64* weights,
+                           ossim_int32 kernelWidth,
+                           ossim_uint32 count,
+                           ossim_float64 np,
+                           ossim_float64* pixelSum,
+                           ossim_float64* densitySum)
+   {
+      const __m256d NP = _mm256_set1_pd(np);
+      ossim_uint32 x = 0;
+      for (; x + 4 <= count; x += 4)
+      {
+         const __m128i offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colStart + x));
+         const ossim_float64* w = weights + x;
+         __m256d p = _mm256_setzero_pd();
+         __m256d d = _mm256_setzero_pd();
+         for (ossim_int32 k = 0; k < kernelWidth; ++k, w += count)
+         {
+            __m256d v  = _mm256_i32gather_pd(line + k, offsets, 8);
+            __m256d wk = _mm256_and_pd(_mm256_loadu_pd(w), _mm256_cmp_pd(v, NP, _CMP_NEQ_UQ));
+            p = _mm256_add_pd(p, _mm256_mul_pd(v, wk));
+            d = _mm256_add_pd(d, wk);
+         }
+         _mm256_storeu_pd(pixelSum + x, p);
+         _mm256_storeu_pd(densitySum + x, d);
+      }
+      horizontalColumns(x, line, colStart, weights, kernelWidth, count, np,
+                        pixelSum, densitySum);
+   }
+#endif /* #if defined(OSSIM_RESAMPLER_X86) */
+
+   HorizontalFunction getHorizontalPass()
+   {
+#if defined(OSSIM_RESAMPLER_X86)
+      switch ( getSimdLevel() )
+      {
+         case SIMD_AVX2:
+            return horizontalPassAvx2;
+         case SIMD_SSE2:
+            return horizontalPassSse2;
+         default:
+            break;
+      }
+#endif
+      return horizontalPass;
+   }
+
+   //---
+   // Vertical pass, adds wk times one line of horizontal sums to the output
+   // row sums.
+   //---
+   typedef void (*VerticalFunction)(ossim_float64 wk,
+                                    const ossim_float64* pixelSum,
+                                    const ossim_float64* densitySum,
+                                    ossim_uint32 count,
+                                    ossim_float64* pixelvals,
+                                    ossim_float64* densityvals);
+
+   void verticalPass(ossim_float64 wk,
+                     const ossim_float64* pixelSum,
+                     const ossim_float64* densitySum,
+                     ossim_uint32 count,
+                     ossim_float64* pixelvals,
+                     ossim_float64* densityvals)
+   {
+      for (ossim_uint32 x = 0; x < count; ++x)
+      {
+         pixelvals[x]   += wk*pixelSum[x];
+         densityvals[x] += wk*densitySum[x];
+      }
+   }
+
+#if defined(OSSIM_RESAMPLER_X86)
+   __attribute__((target("sse2")))
+   void verticalPassSse2(ossim_float64 wk,
+                         const ossim_float64* pixelSum,
+                         const ossim_float64* densitySum,
+                         ossim_uint32 count,
+                         ossim_float64* pixelvals,
+                         ossim_float64* densityvals)
+   {
+      const __m128d WK = _mm_set1_pd(wk);
+      ossim_uint32 x = 0;
+      for (; x + 2 <= count; x += 2)
+      {
+         _mm_storeu_pd(pixelvals + x, _mm_add_pd(_mm_loadu_pd(pixelvals + x),
+                                                 _mm_mul_pd(WK, _mm_loadu_pd(pixelSum + x))));
+         _mm_storeu_pd(densityvals + x, _mm_add_pd(_mm_loadu_pd(densityvals + x),
+                                                   _mm_mul_pd(WK, _mm_loadu_pd(densitySum + x))));
+      }
+      verticalPass(wk, pixelSum + x, densitySum + x, count - x, pixelvals + x, densityvals + x);
+   }
+
+   __attribute__((target("avx2")))
+   void verticalPassAvx2(ossim_float64 wk,
+                         const ossim_float64* pixelSum,
+                         const ossim_float64* densitySum,
+                         ossim_uint32 count,
+                         ossim_float64* pixelvals,
+                         ossim_float64* densityvals)
+   {
+      const __m256d WK = _mm256_set1_pd(wk);
+      ossim_uint32 x = 0;
+      for (; x + 4 <= count; x += 4)
+      {
+         _mm256_storeu_pd(pixelvals + x,
+                          _mm256_add_pd(_mm256_loadu_pd(pixelvals + x),
+                                        _mm256_mul_pd(WK, _mm256_loadu_pd(pixelSum + x))));
+         _mm256_storeu_pd(densityvals + x,
+                          _mm256_add_pd(_mm256_loadu_pd(densityvals + x),
+                                        _mm256_mul_pd(WK, _mm256_loadu_pd(densitySum + x))));
+      }
+      verticalPass(wk, pixelSum + x, densitySum + x, count - x, pixelvals + x, densityvals + x);
+   }
+#endif /* #if defined(OSSIM_RESAMPLER_X86) */
+
+   VerticalFunction getVerticalPass()
+   {
+#if defined(OSSIM_RESAMPLER_X86)
+      switch ( getSimdLevel() )
+      {
+         case SIMD_AVX2:
+            return verticalPassAvx2;
+         case SIMD_SSE2:
+            return verticalPassSse2;
+         default:
+            break;
+      }
+#endif
+      return verticalPass;
+   }
+}
+
+template <class T> bool ossimFilterResampler::resampleSeparableTile(
+   T /* dummy */,
+   const ossimRefPtr<ossimImageData>& input,
+   ossimRefPtr<ossimImageData>& output,
+   const ossimIrect& outputSubRect,
+   const ossimDpt& inputUl,
+   const ossimDpt& inputUr,
+   const ossimDpt& deltaUl,
+   const ossimDpt& deltaUr,
+   const ossimDpt& outLength)
+{
+   //---
+   // Axis aligned test.  Each output row must map to one input line and the
+   // column positions must not move from row to row.
+   //---
+   const double AXIS_TOLERANCE = 1.0e-8;
+   if ( (fabs(inputUr.y - inputUl.y) > AXIS_TOLERANCE) ||
+        (fabs(deltaUl.x) > AXIS_TOLERANCE) ||
+        (fabs(deltaUr.x) > AXIS_TOLERANCE) ||
+        (fabs(deltaUr.y - deltaUl.y) > AXIS_TOLERANCE) )
+   {
+      return false;
+   }
+
+   ossim_float64 stepSizeWidth = (outLength.x > 1) ? 1.0/(outLength.x-1.0) : 1.0;
+
+   ossim_int32  inWidth   = (ossim_int32)input->getWidth();
+   ossim_int32  inHeight  = (ossim_int32)input->getHeight();
+   ossim_uint32 BANDS     = input->getNumberOfBands();
+   ossimIrect   inputRect = input->getImageRectangle();
+
+   const ossim_float64* NULL_PIX    = output->getNullPix();
+   const ossim_float64* MIN_PIX     = output->getMinPix();
+   const ossim_float64* MAX_PIX     = output->getMaxPix();
+   ossimIrect           outputRect  = output->getImageRectangle();
+   ossim_uint32         resultRectH = outputSubRect.height();
+   ossim_uint32         resultRectW = outputSubRect.width();
+   ossim_uint32         outputRectW = outputRect.width();
+   ossim_uint32 resultOffset = (outputSubRect.ul().y - outputRect.ul().y)*outputRectW +
+                               (outputSubRect.ul().x - outputRect.ul().x);
+
+   ossim_int32 xkernel_width   = (ossim_int32)theFilterTable.getWidth();
+   ossim_int32 ykernel_height  = (ossim_int32)theFilterTable.getHeight();
+   double xkernel_half_width   = theFilterTable.getXSupport();
+   double ykernel_half_height  = theFilterTable.getYSupport();
+
+   //---
+   // Per column and per row tables.  Positions are stepped the same way as
+   // the general loop so both paths pick the same input pixels and weights.
+   //---
+   std::vector<ossim_int32>   colStart(resultRectW);
+   std::vector<ossim_int32>   colCenter(resultRectW);
+   std::vector<const double*> colWeights(resultRectW);
+   double initialx = inputUl.x - inputRect.ul().x;
+   double initialy = inputUl.y - inputRect.ul().y;
+   double deltaX   = (inputUr.x - inputUl.x) * stepSizeWidth;
+   double pointx   = initialx;
+   ossim_uint32 idx;
+   for (idx = 0; idx < resultRectW; ++idx)
+   {
+      colStart[idx]   = ossim::round<int>(pointx - xkernel_half_width + .5);
+      colCenter[idx]  = ossim::round<int>(pointx);
+      colWeights[idx] = theFilterTable.getClosestXWeights(pointx);
+      if ( (colStart[idx] < 0) || ((colStart[idx] + xkernel_width) > inWidth) )
+      {
+         return false;
+      }
+      pointx += deltaX;
+   }
+
+   std::vector<ossim_int32>   rowStart(resultRectH);
+   std::vector<ossim_int32>   rowCenter(resultRectH);
+   std::vector<const double*> rowWeights(resultRectH);
+   double pointy = initialy;
+   ossim_int32 minRow = inHeight;
+   ossim_int32 maxRow = 0;
+   for (idx = 0; idx < resultRectH; ++idx)
+   {
+      rowStart[idx]   = ossim::round<int>(pointy - ykernel_half_height + .5);
+      rowCenter[idx]  = ossim::round<int>(pointy);
+      rowWeights[idx] = theFilterTable.getClosestYWeights(pointy);
+      if ( (rowStart[idx] < 0) || ((rowStart[idx] + ykernel_height) > inHeight) )
+      {
+         return false;
+      }
+      minRow = std::min(minRow, rowStart[idx]);
+      maxRow = std::max(maxRow, rowStart[idx] + ykernel_height);
+      pointy += deltaUl.y;
+   }
+   if ( !resultRectW || !resultRectH )
+   {
+      return true;
+   }
+
+   // Only input lines under some kernel need the horizontal pass:
+   ossim_int32 lines = maxRow - minRow;
+   std::vector<char> lineUsed(lines, 0);
+   for (idx = 0; idx < resultRectH; ++idx)
+   {
+      std::fill(lineUsed.begin() + (rowStart[idx] - minRow),
+                lineUsed.begin() + (rowStart[idx] - minRow + ykernel_height), 1);
+   }
+
+   // Pixels whose center is null in every band are null on output:
+   std::vector<ossim_uint32> centerNullCount(resultRectW*resultRectH, 0);
+   ossim_uint32 band;
+   for (band = 0; band < BANDS; ++band)
+   {
+      const T* inBuf = static_cast<const T*>(input->getBuf(band));
+      const T  np    = static_cast<T>(NULL_PIX[band]);
+      ossim_uint32* counts = &centerNullCount.front();
+      for (ossim_uint32 y = 0; y < resultRectH; ++y)
+      {
+         const T* line = inBuf + rowCenter[y]*inWidth;
+         for (ossim_uint32 x = 0; x < resultRectW; ++x)
+         {
+            if (line[colCenter[x]] == np)
+            {
+               ++counts[x];
+            }
+         }
+         counts += resultRectW;
+      }
+   }
+
+   //---
+   // Horizontal pass output.  Each input line gets the weighted sum of its
+   // non null pixels and the sum of the weights used, per output column.
+   // The vertical pass combines those the same way so nulls are excluded
+   // exactly as in the general loop.
+   //---
+   std::vector<ossim_float64> pixelSums(lines*resultRectW);
+   std::vector<ossim_float64> densitySums(lines*resultRectW);
+   std::vector<ossim_float64> pixelvals(resultRectW);
+   std::vector<ossim_float64> densityvals(resultRectW);
+
+   //---
+   // The kernels read lines converted to double, only the columns under some
+   // kernel, with column starts relative to the first of those.  Weights are
+   // stored kernel tap major so a tap is contiguous across output columns.
+   //---
+   ossim_int32 minCol = *std::min_element(colStart.begin(), colStart.end());
+   ossim_int32 maxCol = *std::max_element(colStart.begin(), colStart.end()) + xkernel_width;
+   std::vector<ossim_int32>   colOffset(resultRectW);
+   std::vector<ossim_float64> colWeightTable(xkernel_width*resultRectW);
+   for (idx = 0; idx < resultRectW; ++idx)
+   {
+      colOffset[idx] = colStart[idx] - minCol;
+      for (ossim_int32 k = 0; k < xkernel_width; ++k)
+      {
+         colWeightTable[k*resultRectW + idx] = colWeights[idx][k];
+      }
+   }
+   std::vector<ossim_float64> lineBuf(maxCol - minCol);
+
+   typename LineConverter<T>::Function convert = LineConverter<T>::get();
+   HorizontalFunction horizontal = getHorizontalPass();
+   VerticalFunction vertical = getVerticalPass();
+
+   for (band = 0; band < BANDS; ++band)
+   {
+      const T* inBuf = static_cast<const T*>(input->getBuf(band));
+      T* outBuf      = static_cast<T*>(output->getBuf(band)) + resultOffset;
+      const ossim_float64 np = NULL_PIX[band];
+
+      for (ossim_int32 line = 0; line < lines; ++line)
+      {
+         if (!lineUsed[line]) continue;
+
+         convert(inBuf + (minRow + line)*inWidth + minCol, maxCol - minCol, &lineBuf.front());
+         horizontal(&lineBuf.front(), &colOffset.front(), &colWeightTable.front(),
+                    xkernel_width, resultRectW, np,
+                    &pixelSums[line*resultRectW], &densitySums[line*resultRectW]);
+      }
+
+      const ossim_uint32* counts = &centerNullCount.front();
+      for (ossim_uint32 y = 0; y < resultRectH; ++y)
+      {
+         std::fill(pixelvals.begin(), pixelvals.end(), 0.0);
+         std::fill(densityvals.begin(), densityvals.end(), 0.0);
+         const double* w = rowWeights[y];
+         for (ossim_int32 k = 0; k < ykernel_height; ++k)
+         {
+            ossim_uint32 line = rowStart[y] - minRow + k;
+            vertical(w[k], &pixelSums[line*resultRectW], &densitySums[line*resultRectW],
+                     resultRectW, &pixelvals.front(), &densityvals.front());
+         }
+
+         for (ossim_uint32 x = 0; x < resultRectW; ++x)
+         {
+            if (counts[x] == BANDS)
+            {
+               outBuf[x] = static_cast<T>(np);
+               continue;
+            }
+            ossim_float64 value = (densityvals[x] <= FLT_EPSILON) ? np :
+                                  pixelvals[x]/densityvals[x];
+            value = (value>=MIN_PIX[band]?(value<MAX_PIX[band]?value:MAX_PIX[band]):MIN_PIX[band]);
+            outBuf[x] = static_cast<T>(value);
+         }
+         counts += resultRectW;
+         outBuf += outputRectW;
+      }
+   }
+
+   return true;
 }
 
 ossimString ossimFilterResampler::getFilterTypeAsString(ossimFilterResamplerType type)const
@@ -863,6 +1535,7 @@ void ossimFilterResampler::setFilterType(
    theMinifyFilter  = createNewFilter(minifyFilterType, theMinifyFilterType);
    theMagnifyFilter = createNewFilter(magnifyFilterType, theMagnifyFilterType);
    computeTable();
+   ++theChangeCount;
 }
 
 ossim_float64 ossimFilterResampler::getBlurFactor()const
@@ -873,6 +1546,13 @@ ossim_float64 ossimFilterResampler::getBlurFactor()const
 void ossimFilterResampler::setBlurFactor(ossim_float64 blur)
 {
    theBlurFactor = blur;
+   ++theChangeCount;
+}
+
+void ossimFilterResampler::setSeparableFlag(bool flag)
+{
+   theSeparableFlag = flag;
+   ++theChangeCount;
 }
 
 bool ossimFilterResampler::saveState(ossimKeywordlist& kwl,
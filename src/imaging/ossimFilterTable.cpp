@@ -14,6 +14,8 @@
 
 ossimFilterTable::ossimFilterTable()
    :theWeights(0),
+    theXWeights(0),
+    theYWeights(0),
     theWidth(0),
     theHeight(0),
     theWidthHeight(0),
@@ -31,6 +33,16 @@ ossimFilterTable::~ossimFilterTable()
       delete [] theWeights;
       theWeights = 0;
    }
+   if(theXWeights)
+   {
+      delete [] theXWeights;
+      theXWeights = 0;
+   }
+   if(theYWeights)
+   {
+      delete [] theYWeights;
+      theYWeights = 0;
+   }
 }
 
 void ossimFilterTable::buildTable(ossim_uint32  filterSteps,
@@ -92,13 +104,22 @@ void ossimFilterTable::buildTable(ossim_uint32  filterSteps,
          {
              y = kernelV - dy;
              double tempWeight = yFilter.filter(y, yFilter.getSupport());
+             if(subpixelSample == 0)
+             {
+                theYWeights[subpixelLine*theHeight + (ossim_uint32)(kernelV-top)] = tempWeight;
+             }
              for(kernelH=left; kernelH<=right;++kernelH)
              {
                x = kernelH - dx;
                    
                // Get the weight for the current pixel.
                //   ----------------------------------------
-               theWeights[idx] = tempWeight*xFilter.filter(x, xFilter.getSupport());
+               double xWeight = xFilter.filter(x, xFilter.getSupport());
+               theWeights[idx] = tempWeight*xWeight;
+               if((subpixelLine == 0) && (kernelV == top))
+               {
+                  theXWeights[subpixelSample*theWidth + (ossim_uint32)(kernelH-left)] = xWeight;
+               }
                ++idx;
              }
           }
@@ -139,10 +160,23 @@ void ossimFilterTable::allocateWeights()
       theWeights = 0;
    }
 
+   if(theXWeights)
+   {
+      delete [] theXWeights;
+      theXWeights = 0;
+   }
+   if(theYWeights)
+   {
+      delete [] theYWeights;
+      theYWeights = 0;
+   }
+
    ossim_uint32 size = (theWidthHeight*(theFilterSteps*theFilterSteps));
 
    if(size)
    {
-      theWeights = new double[size];
+      theWeights  = new double[size];
+      theXWeights = new double[theWidth*theFilterSteps];
+      theYWeights = new double[theHeight*theFilterSteps];
    }
 }
\ No newline at end of file
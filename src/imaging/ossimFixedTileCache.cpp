@@ -3,13 +3,16 @@
 // License:  See top level LICENSE.txt file.
 //
 // Author: Garrett Potts
-// 
+//
 // Description: This file contains the Application cache algorithm
 //
 //***********************************
 // $Id: ossimFixedTileCache.cpp 16276 2010-01-06 01:54:47Z gpotts $
 #include <ossim/imaging/ossimFixedTileCache.h>
 #include <algorithm>
+#include <ostream>
+
+const ossim_uint32 ossimFixedTileCache::SHARD_COUNT;
 
 ossimFixedTileCache::ossimFixedTileCache()
    : theTileBoundaryRect(),
@@ -19,9 +22,14 @@ ossimFixedTileCache::ossimFixedTileCache()
      theTilesVertical(0),
      theCacheSize(0),
      theMaxCacheSize(0),
-     theTileMap(),
-     theLruQueue(),
-     theUseLruFlag(true)
+     theNumberOfTiles(0),
+     theNextEvictShard(0),
+     theSharedCacheSize(0),
+     theUseLruFlag(true),
+     theHitCount(0),
+     theMissCount(0),
+     theEvictionCount(0),
+     theContentionCount(0)
 {
    ossim::defaultTileSize(theTileSize);
 
@@ -29,10 +37,6 @@ ossimFixedTileCache::ossimFixedTileCache()
    tempRect.makeNan();
 
    setRect(tempRect);
-   
-   // theCacheSize    = 0;
-   // theMaxCacheSize = 0;
-   // theUseLruFlag = true;
 }
 
 ossimFixedTileCache::~ossimFixedTileCache()
@@ -74,27 +78,32 @@ void ossimFixedTileCache::setRect(const ossimIrect& rect,
 
 void ossimFixedTileCache::keepTilesWithinRect(const ossimIrect& rect)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter = theTileMap.begin();
-
-   while(tileIter != theTileMap.end())
+   for(ossim_uint32 shardIdx = 0; shardIdx < SHARD_COUNT; ++shardIdx)
    {
-      ossimIrect tileRect = (*tileIter).second.theTile->getImageRectangle();
-      if(!tileRect.intersects(rect))
+      Shard& shard = theShards[shardIdx];
+      std::vector<ossim_int32> outside;
+      lockShard(shard);
+      TileMap::iterator tileIter = shard.m_tileMap.begin();
+      while(tileIter != shard.m_tileMap.end())
+      {
+         if(!tileIter->second.theTile.valid() ||
+            !tileIter->second.theTile->getImageRectangle().intersects(rect))
+         {
+            outside.push_back(tileIter->first);
+         }
+         ++tileIter;
+      }
+      for(ossim_uint32 idx = 0; idx < outside.size(); ++idx)
       {
-         eraseFromLru(computeId((*tileIter).second.theTile->getOrigin()));
-         theCacheSize -= (*tileIter).second.theTile->getDataSizeInBytes();
-         (*tileIter).second.theTile = NULL;
-         theTileMap.erase(tileIter);
+         eraseTile(shard, outside[idx]);
       }
-      ++tileIter;
+      shard.m_mutex.unlock();
    }
 }
 
 ossimRefPtr<ossimImageData> ossimFixedTileCache::addTile(ossimRefPtr<ossimImageData> imageData,
                                                          bool duplicateData)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = NULL;
    if(!imageData.valid())
    {
@@ -104,17 +113,19 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::addTile(ossimRefPtr<ossimImageD
    {
       return result;
    }
-   
+
    ossim_int32 id = computeId(imageData->getOrigin());
    if(id < 0)
    {
       return result;
    }
-   
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(id);
 
-   if(tileIter==theTileMap.end())
+   Shard& shard = getShard(id);
+   lockShard(shard);
+   std::lock_guard<std::mutex> lock(shard.m_mutex, std::adopt_lock);
+
+   TileMap::iterator tileIter = shard.m_tileMap.find(id);
+   if(tileIter == shard.m_tileMap.end())
    {
       if(duplicateData)
       {
@@ -125,29 +136,43 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::addTile(ossimRefPtr<ossimImageD
          result = imageData;
       }
       ossimFixedTileCacheInfo cacheInfo(result, id);
-       
-      theCacheSize += imageData->getDataSizeInBytes();
-      theTileMap.insert(make_pair(id, cacheInfo));
-      if(theUseLruFlag)
-      {
-         theLruQueue.push_back(id);
-      }
+      cacheInfo.theClockIndex = static_cast<ossim_uint32>(shard.m_clock.size());
+      shard.m_clock.push_back(id);
+      shard.m_tileMap.insert(std::make_pair(id, cacheInfo));
+      ++theNumberOfTiles;
+      adjustCacheSize(imageData->getDataSizeInBytes());
    }
-   
+
    return result;
 }
 
 ossimRefPtr<ossimImageData> ossimFixedTileCache::getTile(ossim_int32 id)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = NULL;
+   if(id < 0)
+   {
+      ++theMissCount;
+      return result;
+   }
 
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(id);
-   if(tileIter!=theTileMap.end())
+   Shard& shard = getShard(id);
+   {
+      lockShard(shard);
+      std::lock_guard<std::mutex> lock(shard.m_mutex, std::adopt_lock);
+      TileMap::iterator tileIter = shard.m_tileMap.find(id);
+      if(tileIter != shard.m_tileMap.end())
+      {
+         result = tileIter->second.theTile;
+         tileIter->second.theReferencedFlag = true;
+      }
+   }
+   if(result.valid())
+   {
+      ++theHitCount;
+   }
+   else
    {
-      result = (*tileIter).second.theTile;
-      adjustLru(id);
+      ++theMissCount;
    }
 
    return result;
@@ -159,15 +184,15 @@ ossimIpt ossimFixedTileCache::getTileOrigin(ossim_int32 tileId)
    ossimIpt result;
    result.makeNan();
 
-   if(tileId < 0)
+   if((tileId < 0) || (theTilesHorizontal == 0))
    {
       return result;
    }
    ossim_int32 ty = (tileId/theTilesHorizontal);
-   ossim_int32 tx = (tileId%theTilesVertical);
-   
+   ossim_int32 tx = (tileId%theTilesHorizontal);
+
    ossimIpt ul = theTileBoundaryRect.ul();
-   
+
    result = ossimIpt(ul.x + tx*theTileSize.x, ul.y + ty*theTileSize.y);
 
    return result;
@@ -188,126 +213,198 @@ ossim_int32 ossimFixedTileCache::computeId(const ossimIpt& tileOrigin)const
    y*=theTilesHorizontal;
 
    ossim_uint32 x = idDiff.x/theTileSize.x;
-   
-   
+
+
    return (y + x);
 }
 
 void ossimFixedTileCache::deleteTile(ossim_int32 tileId)
 {
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(tileId);
+   if(tileId < 0) return;
 
-   if(tileIter != theTileMap.end())
+   ossimRefPtr<ossimImageData> tile;
+   Shard& shard = getShard(tileId);
    {
-      if((*tileIter).second.theTile.valid())
-      {
-         theCacheSize -= (*tileIter).second.theTile->getDataSizeInBytes();
-         (*tileIter).second.theTile = NULL;
-      }
-      theTileMap.erase(tileIter);
-      eraseFromLru(tileId);
+      lockShard(shard);
+      std::lock_guard<std::mutex> lock(shard.m_mutex, std::adopt_lock);
+      tile = eraseTile(shard, tileId);
    }
+
+   // Last reference, if any, is released outside of the shard lock.
+   tile = 0;
 }
 
 ossimRefPtr<ossimImageData> ossimFixedTileCache::removeTile(ossim_int32 tileId)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = NULL;
-   
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(tileId);
+   if(tileId < 0) return result;
+
+   Shard& shard = getShard(tileId);
+   lockShard(shard);
+   std::lock_guard<std::mutex> lock(shard.m_mutex, std::adopt_lock);
+   result = eraseTile(shard, tileId);
 
-   if(tileIter != theTileMap.end())
-   {
-      theCacheSize -= (*tileIter).second.theTile->getDataSizeInBytes();
-      if((*tileIter).second.theTile.valid())
-      {
-         result =  (*tileIter).second.theTile;
-      }
-      theTileMap.erase(tileIter);
-      eraseFromLru(tileId);
-   }
-   
    return result;
 }
 
 void ossimFixedTileCache::flush()
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.begin();
-
-   while(tileIter != theTileMap.end())
+   for(ossim_uint32 shardIdx = 0; shardIdx < SHARD_COUNT; ++shardIdx)
    {
-      if( (*tileIter).second.theTile.valid())
+      Shard& shard = theShards[shardIdx];
+      TileMap tiles;
       {
-         (*tileIter).second.theTile = 0;
+         lockShard(shard);
+         std::lock_guard<std::mutex> lock(shard.m_mutex, std::adopt_lock);
+         ossim_int64 bytes = 0;
+         TileMap::iterator tileIter = shard.m_tileMap.begin();
+         while(tileIter != shard.m_tileMap.end())
+         {
+            if(tileIter->second.theTile.valid())
+            {
+               bytes += tileIter->second.theTile->getDataSizeInBytes();
+            }
+            ++tileIter;
+         }
+         theNumberOfTiles -= static_cast<ossim_uint32>(shard.m_tileMap.size());
+         adjustCacheSize(-bytes);
+         tiles.swap(shard.m_tileMap);
+         shard.m_clock.clear();
+         shard.m_clockHand = 0;
       }
-      ++tileIter;
+      // Tiles are released here outside of the shard lock.
    }
-   theLruQueue.clear();
-   theTileMap.clear();
-   theCacheSize = 0;
 }
 
 void ossimFixedTileCache::deleteTile()
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   if(theUseLruFlag)
+   removeTile();
+}
+
+ossimRefPtr<ossimImageData> ossimFixedTileCache::removeTile()
+{
+   ossimRefPtr<ossimImageData> result = NULL;
+   if(!theUseLruFlag || (theNumberOfTiles == 0))
    {
-      if(theLruQueue.begin() != theLruQueue.end())
-      {
-         deleteTile(*(theLruQueue.begin()));
-      }
+      return result;
+   }
+
+   // Start at a different shard each call so eviction is spread evenly.
+   ossim_uint32 start = theNextEvictShard++;
+   for(ossim_uint32 idx = 0; (idx < SHARD_COUNT) && !result.valid(); ++idx)
+   {
+      Shard& shard = theShards[(start + idx) % SHARD_COUNT];
+      lockShard(shard);
+      std::lock_guard<std::mutex> lock(shard.m_mutex, std::adopt_lock);
+      result = evictTile(shard);
    }
+
+   return result;
 }
 
-ossimRefPtr<ossimImageData> ossimFixedTileCache::removeTile()
+void ossimFixedTileCache::setTileSize(const ossimIpt& tileSize)
 {
-   std::lock_guard<std::mutex> lock(theMutex);
-   if(theUseLruFlag)
+   setRect(theTileBoundaryRect, tileSize);
+}
+
+void ossimFixedTileCache::setSharedCacheSizeCounter(std::atomic<ossim_int64>* counter)
+{
+   theSharedCacheSize = counter;
+   if(theSharedCacheSize)
    {
-      if(theLruQueue.begin() != theLruQueue.end())
-      {
-         return removeTile(*(theLruQueue.begin()));
-      }
+      (*theSharedCacheSize) += theCacheSize;
    }
+}
 
-   return NULL;
+std::ostream& ossimFixedTileCache::print(std::ostream& out)const
+{
+   out << "size = "         << getCacheSize()
+       << " tiles = "       << getNumberOfTiles()
+       << " hits = "        << getHitCount()
+       << " misses = "      << getMissCount()
+       << " evictions = "   << getEvictionCount()
+       << " contention = "  << getContentionCount();
+   return out;
 }
 
-void ossimFixedTileCache::adjustLru(ossim_int32 id)
+ossimFixedTileCache::Shard& ossimFixedTileCache::getShard(ossim_int32 id)
 {
-   if(theUseLruFlag)
+   // Ids are row major tile indices so neighbouring tiles land on different shards.
+   return theShards[static_cast<ossim_uint32>(id) % SHARD_COUNT];
+}
+
+void ossimFixedTileCache::lockShard(Shard& shard)
+{
+   if(!shard.m_mutex.try_lock())
    {
-      std::list<ossim_int32>::iterator iter = std::find(theLruQueue.begin(), theLruQueue.end(), id);
-      
-      if(iter != theLruQueue.end())
+      ++theContentionCount;
+      shard.m_mutex.lock();
+   }
+}
+
+ossimRefPtr<ossimImageData> ossimFixedTileCache::eraseTile(Shard& shard, ossim_int32 id)
+{
+   ossimRefPtr<ossimImageData> result = NULL;
+   TileMap::iterator tileIter = shard.m_tileMap.find(id);
+   if(tileIter != shard.m_tileMap.end())
+   {
+      result = tileIter->second.theTile;
+
+      // Swap the last clock slot into the hole:
+      ossim_uint32 slot = tileIter->second.theClockIndex;
+      ossim_int32 lastId = shard.m_clock.back();
+      shard.m_clock[slot] = lastId;
+      shard.m_clock.pop_back();
+      if(lastId != id)
+      {
+         shard.m_tileMap.find(lastId)->second.theClockIndex = slot;
+      }
+      if(shard.m_clockHand >= shard.m_clock.size())
       {
-         ossim_int32 value = *iter;
-         theLruQueue.erase(iter);
-         theLruQueue.push_back(value);
+         shard.m_clockHand = 0;
+      }
+
+      shard.m_tileMap.erase(tileIter);
+      --theNumberOfTiles;
+      if(result.valid())
+      {
+         adjustCacheSize(-static_cast<ossim_int64>(result->getDataSizeInBytes()));
       }
    }
+   return result;
 }
 
-void ossimFixedTileCache::eraseFromLru(ossim_int32 id)
+ossimRefPtr<ossimImageData> ossimFixedTileCache::evictTile(Shard& shard)
 {
-   if(theUseLruFlag)
+   ossimRefPtr<ossimImageData> result = NULL;
+
+   // At most two sweeps: the first may only clear referenced flags.
+   ossim_uint32 steps = static_cast<ossim_uint32>(shard.m_clock.size()) * 2;
+   for(ossim_uint32 step = 0; step < steps; ++step)
    {
-      
-      std::list<ossim_int32>::iterator iter = std::find(theLruQueue.begin(), theLruQueue.end(), id);
-      
-      if(iter != theLruQueue.end())
+      ossim_int32 id = shard.m_clock[shard.m_clockHand];
+      ossimFixedTileCacheInfo& info = shard.m_tileMap.find(id)->second;
+      if(info.theReferencedFlag)
+      {
+         info.theReferencedFlag = false;
+         shard.m_clockHand = (shard.m_clockHand + 1) % shard.m_clock.size();
+      }
+      else
       {
-         theLruQueue.erase(iter);
+         result = eraseTile(shard, id);
+         ++theEvictionCount;
+         break;
       }
    }
-}
 
+   return result;
+}
 
-void ossimFixedTileCache::setTileSize(const ossimIpt& tileSize)
+void ossimFixedTileCache::adjustCacheSize(ossim_int64 delta)
 {
-   setRect(theTileBoundaryRect, tileSize);
+   theCacheSize += delta;
+   if(theSharedCacheSize)
+   {
+      (*theSharedCacheSize) += delta;
+   }
 }
@@ -54,7 +54,8 @@ ossimGeneralRasterTileSource::ossimGeneralRasterTileSource()
       m_bufferRect(0, 0, 0, 0),
       m_swapBytesFlag(false),
       m_bufferSizeInPixels(0),
-      m_outputBandList(0)
+      m_outputBandList(0),
+      m_memoryMaps(0)
 {}
 
 ossimGeneralRasterTileSource::~ossimGeneralRasterTileSource()
@@ -104,8 +105,19 @@ bool ossimGeneralRasterTileSource::getTile(ossimImageData* result,
       // call even if resLevel is 0.  Method returns true on success, false
       // on error.
       //---
-      status = getOverviewTile(resLevel, result);
-      if (status)
+      bool mapped = false;
+      if ( m_memoryMaps.size() && (resLevel == 0) &&
+           !( theOverview.valid() && theOverview->isValidRLevel(resLevel) ) )
+      {
+         // Straight from the mapped files, bypassing the shared buffer.
+         mapped = true;
+         status = loadFromMappedFiles(result);
+      }
+      else
+      {
+         status = getOverviewTile(resLevel, result);
+      }
+      if (status && !mapped)
       {
          if(getOutputScalarType() == OSSIM_USHORT11)
          {
@@ -134,8 +146,15 @@ bool ossimGeneralRasterTileSource::getTile(ossimImageData* result,
          }
       }
       
-      if (!status) // Did not get an overview tile.
+      //---
+      // Did not get an overview or mapped tile.  Mapped reads that fail,
+      // e.g. on a scalar size or interleave they do not handle or a file
+      // shorter than the header says, are served by the streams as before.
+      // Mapped reads may run concurrently, so the stream path is locked.
+      //---
+      if (!status)
       {
+         std::lock_guard<std::mutex> lock(m_streamMutex);
          status = true;
          
          //---
@@ -217,6 +236,119 @@ bool ossimGeneralRasterTileSource::getTile(ossimImageData* result,
    return status;
 }
 
+bool ossimGeneralRasterTileSource::loadFromMappedFiles(ossimImageData* result) const
+{
+   ossimIrect tile_rect  = result->getImageRectangle();
+   ossimIrect image_rect = getImageRectangle(0);
+
+   if ( !tile_rect.intersects(image_rect) )
+   {
+      result->makeBlank();
+      return true;
+   }
+
+   const ossim_int64 BYTES_PER_PIXEL = m_rasterInfo.bytesPerPixel();
+   if ( ossim::scalarSizeInBytes( result->getScalarType() ) != BYTES_PER_PIXEL )
+   {
+      return false;
+   }
+
+   // Initialize the tile if needed as we're going to stuff it.
+   if (result->getDataObjectStatus() == OSSIM_NULL)
+   {
+      result->initialize();
+   }
+
+   ossimIrect clip_rect = tile_rect.clipToRect(image_rect);
+   if ( !tile_rect.completely_within(clip_rect) )
+   {
+      result->makeBlank();
+   }
+
+   const ossimInterleaveType INTERLEAVE = m_rasterInfo.interleaveType();
+   const ossim_int64 INPUT_BANDS  = m_rasterInfo.numberOfBands();
+   const ossim_int64 LINE_BYTES   = m_rasterInfo.bytesPerRawLine();
+   const ossim_int64 FIRST_SAMPLE = m_rasterInfo.offsetToFirstValidSample();
+   const ossim_int64 CLIP_WIDTH   = clip_rect.width();
+   const ossim_int64 TILE_WIDTH   = result->getWidth();
+   const ossimScalarType SCALAR   = m_rasterInfo.getImageMetaData().getScalarType();
+
+   // Only BIP interleaves the bands within a line.
+   const ossim_int64 SAMPLE_STRIDE =
+      (INTERLEAVE == OSSIM_BIP) ? BYTES_PER_PIXEL * INPUT_BANDS : BYTES_PER_PIXEL;
+   const ossim_uint64 SPAN = (CLIP_WIDTH - 1) * SAMPLE_STRIDE + BYTES_PER_PIXEL;
+
+   ossimEndian endian;
+   for (ossim_uint32 band = 0; band < m_outputBandList.size(); ++band)
+   {
+      const ossim_int64 SRC_BAND = m_outputBandList[band];
+      const ossim_uint32 MAP_INDEX =
+         (INTERLEAVE == OSSIM_BSQ_MULTI_FILE) ? m_outputBandList[band] : 0;
+      if ( MAP_INDEX >= m_memoryMaps.size() )
+      {
+         return false;
+      }
+      const ossim::MemoryMap& memoryMap = *m_memoryMaps[MAP_INDEX];
+
+      ossim_uint8* dest = static_cast<ossim_uint8*>( result->getBuf(band) ) +
+         ( (clip_rect.ul().y - tile_rect.ul().y) * TILE_WIDTH +
+           (clip_rect.ul().x - tile_rect.ul().x) ) * BYTES_PER_PIXEL;
+
+      for (ossim_int64 line = clip_rect.ul().y; line <= clip_rect.lr().y; ++line)
+      {
+         ossim_int64 offset = FIRST_SAMPLE;
+         switch (INTERLEAVE)
+         {
+            case OSSIM_BIP:
+               offset += line * LINE_BYTES + clip_rect.ul().x * SAMPLE_STRIDE +
+                  SRC_BAND * BYTES_PER_PIXEL;
+               break;
+            case OSSIM_BIL:
+               offset += (line * INPUT_BANDS + SRC_BAND) * LINE_BYTES +
+                  clip_rect.ul().x * BYTES_PER_PIXEL;
+               break;
+            case OSSIM_BSQ:
+               offset += (SRC_BAND * m_rasterInfo.rawLines() + line) * LINE_BYTES +
+                  clip_rect.ul().x * BYTES_PER_PIXEL;
+               break;
+            case OSSIM_BSQ_MULTI_FILE:
+               offset += line * LINE_BYTES + clip_rect.ul().x * BYTES_PER_PIXEL;
+               break;
+            default:
+               return false;
+         }
+
+         if ( (offset < 0) || ( (static_cast<ossim_uint64>(offset) + SPAN) > memoryMap.size() ) )
+         {
+            return false;
+         }
+
+         const ossim_uint8* src = memoryMap.data() + offset;
+         if (SAMPLE_STRIDE == BYTES_PER_PIXEL)
+         {
+            memcpy( dest, src, CLIP_WIDTH * BYTES_PER_PIXEL );
+         }
+         else
+         {
+            for (ossim_int64 sample = 0; sample < CLIP_WIDTH; ++sample)
+            {
+               memcpy( dest + sample * BYTES_PER_PIXEL,
+                       src + sample * SAMPLE_STRIDE,
+                       BYTES_PER_PIXEL );
+            }
+         }
+         if (m_swapBytesFlag)
+         {
+            endian.swap( SCALAR, dest, static_cast<ossim_uint32>(CLIP_WIDTH) );
+         }
+         dest += TILE_WIDTH * BYTES_PER_PIXEL;
+      }
+   }
+
+   result->validate();
+   return true;
+}
+
 bool ossimGeneralRasterTileSource::fillBuffer(const ossimIpt& origin, const ossimIpt& size)
 {
 
@@ -1025,6 +1157,42 @@ void ossimGeneralRasterTileSource::close()
       ++is;
    }
    m_fileStrList.clear();
+   m_memoryMaps.clear();
+}
+
+bool ossimGeneralRasterTileSource::enableConcurrentReads()
+{
+   if ( m_memoryMaps.empty() && isOpen() )
+   {
+      std::vector<ossimFilename> aList = m_rasterInfo.getImageFileList();
+      for (ossim_uint32 i = 0; i < aList.size(); ++i)
+      {
+         std::shared_ptr<ossim::MemoryMap> memoryMap = std::make_shared<ossim::MemoryMap>();
+         if ( !memoryMap->open( aList[i].string() ) )
+         {
+            // Not a local file, stay with the streams.
+            m_memoryMaps.clear();
+            break;
+         }
+         m_memoryMaps.push_back(memoryMap);
+      }
+   }
+
+   if ( theOverview.valid() )
+   {
+      theOverview->enableConcurrentReads();
+   }
+
+   return ( m_memoryMaps.size() != 0 );
+}
+
+bool ossimGeneralRasterTileSource::isConcurrentReadSafe(ossim_uint32 resLevel) const
+{
+   if ( theOverview.valid() && theOverview->isValidRLevel(resLevel) )
+   {
+      return theOverview->isConcurrentReadSafe(resLevel);
+   }
+   return ( m_memoryMaps.size() && (resLevel == 0) );
 }
 
 ossim_uint32 ossimGeneralRasterTileSource::getImageTileWidth() const
@@ -11,6 +11,7 @@
 #include <ossim/base/ossimIrect.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/base/ossimTrace.h>
+#include <algorithm>
 
 using namespace std;
 
@@ -27,9 +28,14 @@ ossimImageCombiner::ossimImageCombiner()
     theInputToPassThrough(0),
     theHasDifferentInputs(false),
     theNormTile(NULL),
-    theCurrentIndex(0)
+    theCurrentIndex(0),
+    theInputIndexes(),
+    theTileCandidates(),
+    theTileCandidatesRect(),
+    theTileCandidatesResLevel(0)
 {
 	theComputeFullResBoundsFlag = true;
+   theTileCandidatesRect.makeNan();
    // until something is set we will just set the blank tile
    // to a 1 band unsigned char type
    addListener((ossimConnectableObjectListener*)this);
@@ -48,10 +54,15 @@ ossimImageCombiner::ossimImageCombiner(ossimObject* owner,
     theInputToPassThrough(0),
     theHasDifferentInputs(false),
     theNormTile(NULL),
-    theCurrentIndex(0)
+    theCurrentIndex(0),
+    theInputIndexes(),
+    theTileCandidates(),
+    theTileCandidatesRect(),
+    theTileCandidatesResLevel(0)
 {
    addListener((ossimConnectableObjectListener*)this);
    theComputeFullResBoundsFlag = true;
+   theTileCandidatesRect.makeNan();
 }
 
 ossimImageCombiner::ossimImageCombiner(ossimConnectableObject::ConnectableObjectList& inputSources)
@@ -64,9 +75,14 @@ ossimImageCombiner::ossimImageCombiner(ossimConnectableObject::ConnectableObject
                      theInputToPassThrough(0),
                      theHasDifferentInputs(false),
                      theNormTile(NULL),
-                     theCurrentIndex(0)
+                     theCurrentIndex(0),
+                     theInputIndexes(),
+                     theTileCandidates(),
+                     theTileCandidatesRect(),
+                     theTileCandidatesResLevel(0)
 {
 	theComputeFullResBoundsFlag = true;
+   theTileCandidatesRect.makeNan();
    for(ossim_uint32 index = 0; index < inputSources.size(); ++index)
    {
       connectMyInputTo(index, inputSources[index].get());
@@ -83,39 +99,13 @@ ossimImageCombiner::~ossimImageCombiner()
 ossimIrect ossimImageCombiner::getBoundingRect(ossim_uint32 resLevel)const
 {
    static const char* MODULE = "ossimImageCombiner::getBoundingRect";
-   ossimIrect result;
    if(theComputeFullResBoundsFlag)
    {
       precomputeBounds();
    }
-   
-   double scale = 1.0/std::pow(2.0, (double)resLevel);
-   ossimDpt scalar(scale, scale);
-   result.makeNan();
-   
-   ossim_uint32 inputIndex = 0;
-   ossimImageSource* interface;
-   for(inputIndex = 0;inputIndex < getNumberOfInputs(); ++inputIndex)
-   {
-      interface = PTR_CAST(ossimImageSource, getInput(inputIndex));
-      if(interface)
-      {
-         ossimIrect rect  = theFullResBounds[inputIndex];
-         if(result.hasNans())
-         {
-            result = rect;
-         }
-         else if(!rect.hasNans())
-         {
-            if(traceDebug())
-            {
-               CLOG << "rect " << inputIndex << " = " << result << endl;
-            }
-            rect = rect*scale;
-            result = result.combine(rect);
-         }
-      }
-   }
+
+   // Union of the input bounds at resLevel, kept by the index:
+   ossimIrect result = getInputIndex(resLevel).getBounds();
    if(traceDebug())
    {
       CLOG << "resulting bounding rect =  " << result << endl;
@@ -396,43 +386,36 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& return
    ossimRefPtr<ossimImageData> result = 0;
    ossimDataObjectStatus status = OSSIM_NULL;
 
-   double scale = 1.0/std::pow(2.0, (double)resLevel);
-   ossimDpt scalar(scale, scale);
+   // Only the inputs overlapping the tile, starting at theCurrentIndex:
+   const std::vector<ossim_uint32>& candidates = getTileCandidates(tileRect, resLevel);
+   std::vector<ossim_uint32>::const_iterator iter =
+      std::lower_bound(candidates.begin(), candidates.end(), theCurrentIndex);
 
-   while( (theCurrentIndex<size) && !result)
+   while( (iter != candidates.end()) && (*iter < size) && !result)
    {
-      ossimIrect rect = theFullResBounds[theCurrentIndex];
-      if(!rect.hasNans())
+      theCurrentIndex = *iter;
+      temp = PTR_CAST(ossimImageSource,
+                      getInput(theCurrentIndex));
+      if(temp && !isInputOutside(theCurrentIndex, tileRect, resLevel))
       {
-         rect = rect * scalar;
-         temp = PTR_CAST(ossimImageSource,
-                         getInput(theCurrentIndex));
-         
-         if(rect.intersects(tileRect)&&temp)
-         {
-            result = temp->getTile(tileRect, resLevel);
-            status = (result.valid() ?
-                      result->getDataObjectStatus():OSSIM_NULL);
-            if((status == OSSIM_NULL)||
-               (status == OSSIM_EMPTY))
-            {
-               result = 0;
-            }
-         }
-         else
+         result = temp->getTile(tileRect, resLevel);
+         status = (result.valid() ?
+                   result->getDataObjectStatus():OSSIM_NULL);
+         if((status == OSSIM_NULL)||
+            (status == OSSIM_EMPTY))
          {
-            status = OSSIM_NULL;
             result = 0;
          }
       }
-      else
-      {
-         status = OSSIM_NULL;
-         result = NULL;
-      }
       
       // Go to next source.
       ++theCurrentIndex;
+      ++iter;
+   }
+   if(!result)
+   {
+      // No more overlapping inputs.
+      theCurrentIndex = size;
    }
    returnedIdx = theCurrentIndex;
    if(result.valid())
@@ -461,31 +444,34 @@ bool ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
    ossimImageSource* temp = 0;
    ossimDataObjectStatus status = OSSIM_NULL;
 
-   double scale = 1.0/std::pow(2.0, (double)resLevel);
-   ossimDpt scalar(scale, scale);
+   const std::vector<ossim_uint32>& candidates =
+      getTileCandidates(tile->getImageRectangle(), resLevel);
+   std::vector<ossim_uint32>::const_iterator iter =
+      std::lower_bound(candidates.begin(), candidates.end(), theCurrentIndex);
 
-   while( (theCurrentIndex<size))
+   bool found = false;
+   while( (iter != candidates.end()) && (*iter < size) )
    {
-      ossimIrect rect = theFullResBounds[theCurrentIndex];
-      if(!rect.hasNans())
+      theCurrentIndex = *iter;
+      temp = PTR_CAST(ossimImageSource,
+                      getInput(theCurrentIndex));
+      if(temp && !isInputOutside(theCurrentIndex, tile->getImageRectangle(), resLevel))
       {
-         rect = rect * scalar;
-         temp = PTR_CAST(ossimImageSource,
-                         getInput(theCurrentIndex));
-
-         if(rect.intersects(tile->getImageRectangle()) && temp)
+         temp->getTile(tile, resLevel);
+         status = tile->getDataObjectStatus();
+         if((status != OSSIM_NULL) && (status != OSSIM_EMPTY))
          {
-            temp->getTile(tile, resLevel);
-            status = tile->getDataObjectStatus();
-            if((status != OSSIM_NULL) && (status != OSSIM_EMPTY))
-            {
-               break;
-            }
+            found = true;
+            break;
          }
       }
 
       // Go to next source.
-      ++theCurrentIndex;
+      ++iter;
+   }
+   if(!found)
+   {
+      theCurrentIndex = size;
    }
 
    returnedIdx = theCurrentIndex;
@@ -573,23 +559,7 @@ ossim_uint32 ossimImageCombiner::getNumberOfOverlappingImages(const ossimIrect&
    {
       precomputeBounds();
    }
-   double scale = 1.0/std::pow(2.0, (double)resLevel);
-   ossimDpt scalar(scale, scale);
-   ossim_uint32 result = 0;
-   ossim_uint32 maxIndex = getNumberOfInputs();
-   for(ossim_uint32 inputIndex = 0; inputIndex < maxIndex; ++inputIndex)
-   {
-      if(!theFullResBounds[inputIndex].hasNans())
-      {
-         ossimIrect boundingRect = theFullResBounds[inputIndex] * scalar;
-         if(rect.intersects(boundingRect))
-         {
-            ++result;
-         }
-      }
-   }
-   
-   return result;
+   return getInputIndex(resLevel).count(rect);
 }
 
 void ossimImageCombiner::getOverlappingImages(std::vector<ossim_uint32>& result,
@@ -600,22 +570,7 @@ void ossimImageCombiner::getOverlappingImages(std::vector<ossim_uint32>& result,
    {
       precomputeBounds();
    }
-   double scale = 1.0/std::pow(2.0, (double)resLevel);
-   ossimDpt scalar(scale, scale);
-   
-   ossim_uint32 inputIndex;
-   ossimIrect boundingRect;
-   for(inputIndex = 0; inputIndex < getNumberOfInputs(); ++inputIndex)
-   {
-      if(!theFullResBounds[inputIndex].hasNans())
-      {
-         boundingRect = theFullResBounds[inputIndex]*scalar;
-         if(rect.intersects(boundingRect))
-         {
-            result.push_back(inputIndex);
-         }
-      }
-   }
+   getInputIndex(resLevel).query(rect, result);
 }
 
 void ossimImageCombiner::connectInputEvent(ossimConnectionEvent& /* event */)
@@ -685,4 +640,52 @@ void ossimImageCombiner::precomputeBounds()const
    {
       theFullResBounds.clear();
    }
+
+   // The indexes are rebuilt from the new bounds on demand.
+   theInputIndexes.clear();
+   theTileCandidates.clear();
+   theTileCandidatesRect.makeNan();
+}
+
+const ossim::RectIndex& ossimImageCombiner::getInputIndex(ossim_uint32 resLevel)const
+{
+   std::map<ossim_uint32, ossim::RectIndex>::iterator iter = theInputIndexes.find(resLevel);
+   if(iter == theInputIndexes.end())
+   {
+      iter = theInputIndexes.insert(std::make_pair(resLevel, ossim::RectIndex())).first;
+
+      double scale = 1.0/std::pow(2.0, (double)resLevel);
+      ossimDpt scalar(scale, scale);
+      std::vector<ossimIrect> rects(theFullResBounds.size());
+      for(ossim_uint32 inputIndex = 0; inputIndex < rects.size(); ++inputIndex)
+      {
+         rects[inputIndex] = theFullResBounds[inputIndex];
+         if(!rects[inputIndex].hasNans())
+         {
+            rects[inputIndex] = rects[inputIndex] * scalar;
+         }
+      }
+      iter->second.build(rects);
+   }
+   return iter->second;
+}
+
+bool ossimImageCombiner::isInputOutside(ossim_uint32 /* inputIndex */,
+                                        const ossimIrect& /* rect */,
+                                        ossim_uint32 /* resLevel */)const
+{
+   return false;
+}
+
+const std::vector<ossim_uint32>& ossimImageCombiner::getTileCandidates(const ossimIrect& tileRect,
+                                                                      ossim_uint32 resLevel)
+{
+   if((tileRect != theTileCandidatesRect) || (resLevel != theTileCandidatesResLevel))
+   {
+      theTileCandidates.clear();
+      getInputIndex(resLevel).query(tileRect, theTileCandidates);
+      theTileCandidatesRect     = tileRect;
+      theTileCandidatesResLevel = resLevel;
+   }
+   return theTileCandidates;
 }
@@ -9,6 +9,7 @@
 //*************************************************************************
 // $Id$
 
+#include <ossim/base/BufferPool.h>
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimErrorCodes.h>
 //#include <ossim/base/ossimErrorContext.h>
@@ -121,6 +122,8 @@ const ossimImageData& ossimImageData::operator=(const ossimImageData& rhs)
 
 ossimImageData::~ossimImageData()
 {
+   // Hand the band buffer back for the next tile of the same size:
+   ossim::BufferPool::instance()->release(m_dataBuffer);
 }
 
 bool ossimImageData::isValidBand(ossim_uint32 band) const
@@ -1341,6 +1344,13 @@ template <class T> void ossimImageData::makeBlank(T /* dummyTemplate */ )
 
 void ossimImageData::initialize()
 {
+   // Reuse a recycled buffer if the pool has one; makeBlank clears it below.
+   if ( m_dataBuffer.empty() &&
+        ossim::BufferPool::instance()->acquire(m_dataBuffer, getDataSizeInBytes()) )
+   {
+      setDataObjectStatus(OSSIM_STATUS_UNKNOWN);
+   }
+
    // let the base class allocate a buffer
    ossimRectilinearDataObject::initialize();
 
@@ -25,6 +25,8 @@
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimScalarTypeLut.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/BufferPool.h>
 
 // Static trace for debugging
 static ossimTrace traceDebug("ossimImageDataFactory:debug");
@@ -34,6 +36,29 @@ std::mutex ossimImageDataFactory::theInstanceMutex;
 ossimImageDataFactory::ossimImageDataFactory() 
 {
    theInstance = 0;
+
+   //---
+   // Optional recycling of tile buffers:
+   // ossim.imaging.image_data_factory.pool.enabled: true
+   // ossim.imaging.image_data_factory.pool.max_size: 256  (megabytes)
+   //---
+   ossimString enabled = ossimPreferences::instance()->findPreference(
+      "ossim.imaging.image_data_factory.pool.enabled");
+   ossimString maxSize = ossimPreferences::instance()->findPreference(
+      "ossim.imaging.image_data_factory.pool.max_size");
+   if ( maxSize.size() )
+   {
+      ossim::BufferPool::instance()->setMaxBytes(maxSize.toUInt64()*1024*1024);
+   }
+   if ( enabled.size() )
+   {
+      ossim::BufferPool::instance()->setEnabled(enabled.toBool());
+   }
+   if (traceDebug())
+   {
+      ossim::BufferPool::instance()->print(ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimImageDataFactory::ossimImageDataFactory DEBUG:\n") << std::endl;
+   }
 }
 
 ossimImageDataFactory::~ossimImageDataFactory()
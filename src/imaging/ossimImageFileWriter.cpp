@@ -21,6 +21,7 @@
 #include <ossim/base/ossimMultiBandHistogram.h>
 #include <ossim/base/ossimHistogram.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimErrorContext.h>
 #include <ossim/base/ossimImageTypeLut.h>
 #include <ossim/base/ossimIoStream.h>
@@ -49,6 +50,7 @@
 
 static ossimTrace traceDebug("ossimImageFileWriter:debug");
 static const ossimString AUTO_CREATE_DIRECTORY_KW("auto_create_directory");
+static const char PIPELINE_DEPTH_KW[] = "pipeline_depth";
 
 #if OSSIM_ID_ENABLED
 static const char OSSIM_ID[] = "$Id: ossimImageFileWriter.cpp 23068 2015-01-07 23:08:29Z okramer $";
@@ -92,7 +94,9 @@ ossimImageFileWriter::ossimImageFileWriter(const ossimFilename& file,
      theWriteWorldFileFlag(false),
      theAutoCreateDirectoryFlag(true),
      theLinearUnits(OSSIM_UNIT_UNKNOWN),
-     thePixelType(OSSIM_PIXEL_IS_POINT)
+     thePixelType(OSSIM_PIXEL_IS_POINT),
+     thePipelineDepth(0),
+     thePipeline()
 {
    if (traceDebug())
    {
@@ -117,10 +121,22 @@ ossimImageFileWriter::ossimImageFileWriter(const ossimFilename& file,
 
    theInputConnection->connectMyInputTo(0, inputSource, false);
    theAreaOfInterest.makeNan();
+
+   //---
+   // Optional writer pipeline, tiles kept in flight:
+   // ossim.imaging.writer.pipeline.depth: 8
+   //---
+   ossimString depth = ossimPreferences::instance()->findPreference(
+      "ossim.imaging.writer.pipeline.depth");
+   if ( depth.size() )
+   {
+      thePipelineDepth = depth.toUInt32();
+   }
 }
 
 ossimImageFileWriter::~ossimImageFileWriter()
 {
+   thePipeline.reset();
    theInputConnection = 0;
    theProgressListener = NULL;
    removeListener((ossimConnectableObjectListener*)this);
@@ -242,6 +258,10 @@ bool ossimImageFileWriter::saveState(ossimKeywordlist& kwl,
            AUTO_CREATE_DIRECTORY_KW,
            theAutoCreateDirectoryFlag,
            true);
+   kwl.add(prefix,
+           PIPELINE_DEPTH_KW,
+           thePipelineDepth,
+           true);
    kwl.add(prefix,
            ossimKeywordNames::OVERVIEW_COMPRESSION_TYPE_KW,
            theOverviewCompressType,
@@ -421,6 +441,12 @@ bool ossimImageFileWriter::loadState(const ossimKeywordlist& kwl,
    {
       theAutoCreateDirectoryFlag = ossimString(lookup).toBool();
    }
+
+   lookup = kwl.find(prefix, PIPELINE_DEPTH_KW);
+   if(lookup)
+   {
+      thePipelineDepth = ossimString(lookup).toUInt32();
+   }
    lookup = kwl.find(prefix, ossimKeywordNames::OVERVIEW_COMPRESSION_TYPE_KW);
    if(lookup)
    {
@@ -1208,6 +1234,86 @@ void ossimImageFileWriter::setPercentComplete(double percentComplete)
    fireEvent(event);
 }
 
+void ossimImageFileWriter::setPipelineDepth(ossim_uint32 depth)
+{
+   thePipelineDepth = depth;
+}
+
+ossim_uint32 ossimImageFileWriter::getPipelineDepth() const
+{
+   return thePipelineDepth;
+}
+
+bool ossimImageFileWriter::startTilePipeline(ossim::TilePipeline::Encoder encoder)
+{
+   stopTilePipeline();
+   if ( thePipelineDepth && theInputConnection.valid() )
+   {
+      thePipeline = std::make_shared<ossim::TilePipeline>(theInputConnection.get(),
+                                                          thePipelineDepth,
+                                                          encoder);
+      thePipeline->start();
+   }
+   return (thePipeline.get() != 0);
+}
+
+ossimRefPtr<ossimImageData> ossimImageFileWriter::getNextTile(std::vector<ossim_uint8>* encoded)
+{
+   ossimRefPtr<ossimImageData> result = 0;
+   if ( thePipeline )
+   {
+      ossim::TilePipeline::Item item;
+      if ( thePipeline->next(item) )
+      {
+         if ( item.m_status )
+         {
+            result = item.m_tile;
+            if ( encoded )
+            {
+               encoded->swap(item.m_encoded);
+            }
+         }
+         else
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimImageFileWriter::getNextTile WARNING:"
+               << "\nTile encoding failed!" << std::endl;
+         }
+      }
+   }
+   else if ( theInputConnection.valid() )
+   {
+      if ( encoded )
+      {
+         encoded->clear();
+      }
+      result = theInputConnection->getNextTile();
+   }
+   return result;
+}
+
+void ossimImageFileWriter::stopTilePipeline()
+{
+   if ( thePipeline )
+   {
+      thePipeline->stop();
+      if ( thePipeline->getTileCount() )
+      {
+         ossimProcessProgressEvent event(this,
+                                         getPercentComplete(),
+                                         thePipeline->getThroughputMessage(),
+                                         false);
+         fireEvent(event);
+         if ( traceDebug() )
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << "ossimImageFileWriter: " << event.getMessage() << std::endl;
+         }
+      }
+      thePipeline.reset();
+   }
+}
+
 void ossimImageFileWriter::setOutputName(const ossimString& outputName)
 {
    ossimImageWriter::setOutputName(outputName);
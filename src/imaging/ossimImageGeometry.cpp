@@ -22,6 +22,7 @@
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <cmath>
+#include <vector>
 
 RTTI_DEF1(ossimImageGeometry, "ossimImageGeometry", ossimObject);
 
@@ -200,16 +201,44 @@ bool ossimImageGeometry::localToWorld(const ossimDpt& local_pt, ossimGpt& world_
 
 bool ossimImageGeometry::localToWorld(const ossimDrect& local_rect, ossimGrect& world_rect) const
 {
-   ossimGpt gp1, gp2, gp3, gp4;
-   if (  localToWorld(local_rect.ul(), gp1) && localToWorld(local_rect.ur(), gp2) &&
-         localToWorld(local_rect.lr(), gp3) && localToWorld(local_rect.ll(), gp4))
+   ossimDpt dp[4] = { local_rect.ul(), local_rect.ur(), local_rect.lr(), local_rect.ll() };
+   ossimGpt gp[4];
+   if ( localToWorld(dp, 4, gp) )
    {
-      world_rect = ossimGrect(gp1, gp2, gp3, gp4);
+      world_rect = ossimGrect(gp[0], gp[1], gp[2], gp[3]);
       return true;
    }
    return false;
 }
 
+//**************************************************************************************************
+//! Batch form of localToWorld.  The projection gets all of the full-image points at once so
+//! models that intersect the DEM can do a single elevation query for the set.
+//**************************************************************************************************
+bool ossimImageGeometry::localToWorld(const ossimDpt* local_pts,
+                                      ossim_uint32 count,
+                                      ossimGpt* world_pts) const
+{
+   if (!m_projection.valid())
+   {
+      for (ossim_uint32 idx = 0; idx < count; ++idx)
+      {
+         world_pts[idx].makeNan();
+      }
+      return false;
+   }
+   if (count == 0) return true;
+
+   std::vector<ossimDpt> full_image_pts(count);
+   for (ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      rnToFull(local_pts[idx], m_targetRrds, full_image_pts[idx]);
+   }
+   m_projection->lineSamplesToWorld(&full_image_pts.front(), count, world_pts);
+
+   return true;
+}
+
 //**************************************************************************************************
 //! Exposes the 3D projection from image to world coordinates given a constant height above 
 //! ellipsoid. The caller should verify that a valid projection exists before calling this
@@ -300,16 +329,69 @@ bool ossimImageGeometry::worldToLocal(const ossimGpt& world_pt, ossimDpt& local_
 
 bool ossimImageGeometry::worldToLocal(const ossimGrect& world_rect, ossimDrect& local_rect) const
 {
-   ossimDpt dp1, dp2, dp3, dp4;
-   if (  worldToLocal(world_rect.ul(), dp1) && worldToLocal(world_rect.ur(), dp2) &&
-         worldToLocal(world_rect.lr(), dp3) && worldToLocal(world_rect.ll(), dp4))
+   ossimGpt gp[4] = { world_rect.ul(), world_rect.ur(), world_rect.lr(), world_rect.ll() };
+   ossimDpt dp[4];
+   if ( worldToLocal(gp, 4, dp) )
    {
-      local_rect = ossimDrect(dp1, dp2, dp3, dp4);
+      local_rect = ossimDrect(dp[0], dp[1], dp[2], dp[3]);
       return true;
    }
    return false;
 }
 
+//**************************************************************************************************
+//! Batch form of worldToLocal.  Missing heights are filled with one bulk elevation query before
+//! the points are projected.
+//**************************************************************************************************
+bool ossimImageGeometry::worldToLocal(const ossimGpt* world_pts,
+                                      ossim_uint32 count,
+                                      ossimDpt* local_pts) const
+{
+   if ( !m_projection.valid() )
+   {
+      for (ossim_uint32 idx = 0; idx < count; ++idx)
+      {
+         local_pts[idx].makeNan();
+      }
+      return false;
+   }
+   if (count == 0) return true;
+
+   std::vector<ossimGpt> pts(world_pts, world_pts + count);
+   if ( isAffectedByElevation() )
+   {
+      std::vector<ossimGpt> missing;
+      std::vector<ossim_uint32> indices;
+      for (ossim_uint32 idx = 0; idx < count; ++idx)
+      {
+         if ( pts[idx].isHgtNan() )
+         {
+            missing.push_back(pts[idx]);
+            indices.push_back(idx);
+         }
+      }
+      if ( missing.size() )
+      {
+         std::vector<ossim_float64> heights(missing.size());
+         ossimElevManager::instance()->getHeightsAboveEllipsoid(
+            &missing.front(), static_cast<ossim_uint32>(missing.size()), &heights.front());
+         for (ossim_uint32 idx = 0; idx < indices.size(); ++idx)
+         {
+            pts[indices[idx]].hgt = heights[idx];
+         }
+      }
+   }
+
+   std::vector<ossimDpt> full_image_pts(count);
+   m_projection->worldToLineSamples(&pts.front(), count, &full_image_pts.front());
+   for (ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      fullToRn(full_image_pts[idx], m_targetRrds, local_pts[idx]);
+   }
+
+   return true;
+}
+
 //**************************************************************************************************
 //! Sets the transform to be used for local-to-full-image coordinate transformation
 //**************************************************************************************************
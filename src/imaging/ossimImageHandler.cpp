@@ -1275,6 +1275,16 @@ bool ossimImageHandler::isBandSelector() const
    return false;
 }
 
+bool ossimImageHandler::enableConcurrentReads()
+{
+   return false;
+}
+
+bool ossimImageHandler::isConcurrentReadSafe(ossim_uint32 /* resLevel */) const
+{
+   return false;
+}
+
 bool ossimImageHandler::setOutputBandList(const std::vector<ossim_uint32>& /* band_list */)
 {
    return false;
@@ -12,6 +12,10 @@
 #include <ossim/base/ossimMultiBandHistogram.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/HistogramAccumulator.h>
+#include <ossim/parallel/ThreadPool.h>
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimTrace.h>
 
@@ -342,6 +346,13 @@ void ossimImageHistogramSource::computeNormalModeHistogram()
       ossim_float64 minValue     = 0;
       ossim_float64 maxValue     = 0;
       getBinInformation(numberOfBins, minValue, maxValue, 0);
+
+      // 8 and 16 bit input is counted in parallel, others go through populateHistogram.
+      ossim::HistogramAccumulator counts;
+      bool countFlag = counts.initialize(input->getOutputScalarType(), numberOfBands);
+      ossimImageHandler* handler = PTR_CAST(ossimImageHandler, input);
+      ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+      const ossim_int64 batchSize = 4 * ossim::max<ossim_int64>(1, pool->getNumberOfThreads());
 		
       ossimRefPtr<ossimImageSourceSequencer> sequencer = new ossimImageSourceSequencer;
       sequencer->connectMyInputTo(0, getInput(0));
@@ -398,6 +409,79 @@ void ossimImageHistogramSource::computeNormalModeHistogram()
                                                                minValue,
                                                                maxValue);
             
+            if ( countFlag )
+            {
+               //---
+               // Tiles are counted on the thread pool into integer bins.  They
+               // are read there too when the handler allows concurrent reads,
+               // else read here in order and handed over as copies.
+               //---
+               counts.clear();
+               bool concurrentFlag = handler && handler->enableConcurrentReads() &&
+                                     handler->isConcurrentReadSafe(index);
+               ossim_int64 resLevelTotalTiles = sequencer->getNumberOfTiles();
+               for (ossim_int64 start = 0; start < resLevelTotalTiles; start += batchSize)
+               {
+                  ossim_int64 end = ossim::min(resLevelTotalTiles, start + batchSize);
+                  std::vector< std::future<void> > jobs;
+                  jobs.reserve(static_cast<size_t>(end - start));
+                  for (ossim_int64 id = start; id < end; ++id)
+                  {
+                     if ( concurrentFlag )
+                     {
+                        ossimIrect rect;
+                        if ( !sequencer->getTileRect(id, rect) )
+                        {
+                           continue;
+                        }
+                        ossimRefPtr<ossimImageData> tile =
+                           ossimImageDataFactory::instance()->create(0, numberOfBands, handler);
+                        tile->setImageRectangle(rect);
+                        tile->initialize();
+                        jobs.push_back(pool->async([handler, tile, index, &counts]() mutable
+                        {
+                           if ( handler->getTile(tile.get(), index) )
+                           {
+                              tile->validate();
+                              counts.accumulate(tile.get());
+                           }
+                        }));
+                     }
+                     else
+                     {
+                        ossimRefPtr<ossimImageData> data = sequencer->getTile(id, index);
+                        if ( data.valid() && data->getBuf() &&
+                             (data->getDataObjectStatus() != OSSIM_EMPTY) )
+                        {
+                           // The input may reuse its tile on the next read.
+                           ossimRefPtr<ossimImageData> tile =
+                              static_cast<ossimImageData*>(data->dup());
+                           jobs.push_back(pool->async([tile, &counts]()
+                           {
+                              counts.accumulate(tile.get());
+                           }));
+                        }
+                     }
+                  }
+                  for (ossim_uint32 idx = 0; idx < jobs.size(); ++idx)
+                  {
+                     pool->wait(jobs[idx]);
+                  }
+
+                  tileCount += static_cast<double>(end - start);
+                  setPercentComplete((100.0*(tileCount/totalTiles)));
+
+                  // Check for abort request.
+                  if (needsAborting())
+                  {
+                     setPercentComplete(100);
+                     break;
+                  }
+               }
+               counts.addTo(theHistogram->getMultiBandHistogram(index).get());
+               continue;
+            }
+
             ossimRefPtr<ossimImageData> data = sequencer->getNextTile(index);
             ++tileCount;
             setPercentComplete((100.0*(tileCount/totalTiles)));
@@ -12,22 +12,147 @@
 #include <ossim/imaging/ossimImageMosaic.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/base/ossimDrect.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimString.h>
 #include <ossim/base/ossimTrace.h>
 static const ossimTrace traceDebug("ossimImageMosaic:debug");
 
+static const char USE_VALID_FOOTPRINTS_KW[] = "use_valid_footprints";
+
 using namespace std;
 
+//---
+// Returns true if the segment a-b passes through rect, Liang-Barsky
+// clipping.
+//---
+static bool segmentIntersectsRect(const ossimDpt& a,
+                                  const ossimDpt& b,
+                                  const ossimDrect& rect)
+{
+   double t0 = 0.0;
+   double t1 = 1.0;
+   const double dx = b.x - a.x;
+   const double dy = b.y - a.y;
+   const double p[4] = { -dx, dx, -dy, dy };
+   const double q[4] = { a.x - rect.ul().x, rect.lr().x - a.x,
+                         a.y - rect.ul().y, rect.lr().y - a.y };
+   for(int i = 0; i < 4; ++i)
+   {
+      if(p[i] == 0.0)
+      {
+         if(q[i] < 0.0) return false; // Parallel and outside.
+      }
+      else
+      {
+         double t = q[i] / p[i];
+         if(p[i] < 0.0)
+         {
+            if(t > t1) return false;
+            if(t > t0) t0 = t;
+         }
+         else
+         {
+            if(t < t0) return false;
+            if(t < t1) t1 = t;
+         }
+      }
+   }
+   return true;
+}
+
+//---
+// Returns true if the polygon and rect share any point.  Unlike
+// ossimPolygon::rectIntersects this also catches a polygon inside the rect
+// and edges crossing it with no vertex or corner inside the other.
+//---
+static bool polygonIntersectsRect(const ossimPolygon& polygon,
+                                  const ossimDrect& rect)
+{
+   const ossim_uint32 n = polygon.getNumberOfVertices();
+   for(ossim_uint32 i = 0; i < n; ++i)
+   {
+      if(rect.pointWithin(polygon[i])) return true;
+   }
+   if(polygon.isPointWithin(rect.ul()) || polygon.isPointWithin(rect.ur()) ||
+      polygon.isPointWithin(rect.lr()) || polygon.isPointWithin(rect.ll()))
+   {
+      return true;
+   }
+   for(ossim_uint32 i = 0; i < n; ++i)
+   {
+      if(segmentIntersectsRect(polygon[i], polygon[(i + 1) % n], rect)) return true;
+   }
+   return false;
+}
+
+//---
+// Returns the bounding rect of the pixels of tile within rect that are null
+// in any band, nan if there are none.
+//---
+template <class T> static ossimIrect findNullRect(const ossimImageData* tile,
+                                                  const ossimIrect& rect)
+{
+   const ossimIrect tileRect = tile->getImageRectangle();
+   const ossim_int32 tileWidth = (ossim_int32)tile->getWidth();
+   const ossim_uint32 bands = tile->getNumberOfBands();
+   const ossim_int32 x0 = rect.ul().x - tileRect.ul().x;
+   const ossim_int32 x1 = rect.lr().x - tileRect.ul().x;
+   const ossim_int32 y0 = rect.ul().y - tileRect.ul().y;
+   const ossim_int32 y1 = rect.lr().y - tileRect.ul().y;
+
+   ossim_int32 minX = x1 + 1;
+   ossim_int32 maxX = x0 - 1;
+   ossim_int32 minY = y1 + 1;
+   ossim_int32 maxY = y0 - 1;
+   for(ossim_int32 y = y0; y <= y1; ++y)
+   {
+      for(ossim_uint32 band = 0; band < bands; ++band)
+      {
+         const T* row = static_cast<const T*>(tile->getBuf(band)) + y*tileWidth;
+         const T np = static_cast<T>(tile->getNullPix(band));
+
+         // First null from the left, then last from the right:
+         ossim_int32 x = x0;
+         while((x <= x1) && (row[x] != np)) ++x;
+         if(x > x1) continue;
+         if(x < minX) minX = x;
+         x = x1;
+         while(row[x] != np) --x;
+         if(x > maxX) maxX = x;
+         if(y < minY) minY = y;
+         maxY = y;
+      }
+   }
+
+   ossimIrect result;
+   if(maxY < minY)
+   {
+      result.makeNan();
+   }
+   else
+   {
+      result = ossimIrect(tileRect.ul().x + minX, tileRect.ul().y + minY,
+                          tileRect.ul().x + maxX, tileRect.ul().y + maxY);
+   }
+   return result;
+}
+
 RTTI_DEF1(ossimImageMosaic, "ossimImageMosaic", ossimImageCombiner)
 ossimImageMosaic::ossimImageMosaic()
    :ossimImageCombiner(),
-    theTile(NULL)
+    theTile(NULL),
+    theUseValidFootprintsFlag(false),
+    theFootprints()
 {
 
 }
 
 ossimImageMosaic::ossimImageMosaic(ossimConnectableObject::ConnectableObjectList& inputSources)
     : ossimImageCombiner(inputSources),
-      theTile(NULL)
+      theTile(NULL),
+      theUseValidFootprintsFlag(false),
+      theFootprints()
 {
 }
 
@@ -236,6 +361,7 @@ void ossimImageMosaic::initialize()
 {
   ossimImageCombiner::initialize();
   theTile = NULL;
+  theFootprints.clear();
 }
 
 void ossimImageMosaic::allocate()
@@ -252,15 +378,79 @@ void ossimImageMosaic::allocate()
 bool ossimImageMosaic::saveState(ossimKeywordlist& kwl,
                                  const char* prefix)const
 {
+   kwl.add(prefix,
+           USE_VALID_FOOTPRINTS_KW,
+           (theUseValidFootprintsFlag ? "true" : "false"),
+           true);
    return ossimImageCombiner::saveState(kwl, prefix);
 }
 
 bool ossimImageMosaic::loadState(const ossimKeywordlist& kwl,
                                  const char* prefix)
 {
+   const char* lookup = kwl.find(prefix, USE_VALID_FOOTPRINTS_KW);
+   if(lookup)
+   {
+      theUseValidFootprintsFlag = ossimString(lookup).toBool();
+   }
    return ossimImageCombiner::loadState(kwl, prefix);
 }
 
+void ossimImageMosaic::setUseValidFootprintsFlag(bool flag)
+{
+   theUseValidFootprintsFlag = flag;
+}
+
+bool ossimImageMosaic::getUseValidFootprintsFlag()const
+{
+   return theUseValidFootprintsFlag;
+}
+
+bool ossimImageMosaic::isInputOutside(ossim_uint32 inputIndex,
+                                      const ossimIrect& rect,
+                                      ossim_uint32 resLevel)const
+{
+   if(!theUseValidFootprintsFlag)
+   {
+      return false;
+   }
+   const ossimPolygon& footprint = getFootprint(inputIndex, resLevel);
+   if(footprint.getNumberOfVertices() < 3)
+   {
+      return false;
+   }
+
+   // Resampling can put data a pixel past the vertices, test one wider.
+   ossimDrect testRect(rect.ul().x - 1.0, rect.ul().y - 1.0,
+                       rect.lr().x + 1.0, rect.lr().y + 1.0);
+   return !polygonIntersectsRect(footprint, testRect);
+}
+
+const ossimPolygon& ossimImageMosaic::getFootprint(ossim_uint32 inputIndex,
+                                                   ossim_uint32 resLevel)const
+{
+   std::vector<ossimPolygon>& footprints = theFootprints[resLevel];
+   if(footprints.size() != getNumberOfInputs())
+   {
+      footprints.clear();
+      footprints.resize(getNumberOfInputs());
+      for(ossim_uint32 idx = 0; idx < footprints.size(); ++idx)
+      {
+         ossimImageSource* input = PTR_CAST(ossimImageSource, getInput(idx));
+         if(input)
+         {
+            std::vector<ossimIpt> vertices;
+            input->getValidImageVertices(vertices, OSSIM_CLOCKWISE_ORDER, resLevel);
+            if(vertices.size() > 2)
+            {
+               footprints[idx] = ossimPolygon(vertices);
+            }
+         }
+      }
+   }
+   return footprints[inputIndex];
+}
+
 template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
    T,// dummy template variable 
    const ossimIrect& tileRect,
@@ -291,6 +481,10 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
    
    ossim_uint32 band;
    ossim_uint32 upperBound = destination->getWidth()*destination->getHeight();
+   ossim_int32 destWidth = (ossim_int32)destination->getWidth();
+
+   // Bounding rect of the pixels still null, all the next layer is asked for.
+   ossimIrect holeRect = tileRect;
    ossim_uint32 minNumberOfBands = currentImageData->getNumberOfBands();
    for(band = 0; band < minNumberOfBands; ++band)
    {
@@ -327,7 +521,7 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
          currentImageData->getDataObjectStatus();
       if ( (currentStatus == OSSIM_EMPTY) || (currentStatus == OSSIM_NULL) )
       {
-         currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
+         currentImageData = getNextNormTile(layerIdx, holeRect, resLevel);
          continue;
       }
       
@@ -346,8 +540,10 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
          srcBandsNullPix[band] = static_cast<T>(currentImageData->getNullPix(minNumberOfBands - 1));
       }
       
+      ossimIrect srcRect = currentImageData->getImageRectangle();
       if ( (currentStatus == OSSIM_FULL) &&
-           (destinationStatus == OSSIM_EMPTY) )
+           (destinationStatus == OSSIM_EMPTY) &&
+           (srcRect == tileRect) )
       {
          // Copy full tile to empty tile.
          for(band=0; band < theLargestNumberOfInputBands; ++band)
@@ -362,37 +558,60 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
             }
          }
       }
-      else // Copy tile checking all the pixels...
+      else // Copy the hole checking all the pixels...
       {
-         for(band = 0; band < theLargestNumberOfInputBands; ++band)
+         ossimIrect copyRect = srcRect.clipToRect(holeRect);
+         if ( !copyRect.hasNans() )
          {
-            float delta = destBandsMaxPix[band] - destBandsMinPix[band];
-            float minP  = destBandsMinPix[band];
-            
-            for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+            ossim_int32 srcWidth  = (ossim_int32)srcRect.width();
+            ossim_int32 copyWidth = (ossim_int32)copyRect.width();
+            for(band = 0; band < theLargestNumberOfInputBands; ++band)
             {
-               if (destBands[band][offset] == destBandsNullPix[band])
+               float delta = destBandsMaxPix[band] - destBandsMinPix[band];
+               float minP  = destBandsMinPix[band];
+
+               for(ossim_int32 y = copyRect.ul().y; y <= copyRect.lr().y; ++y)
                {
-                  if (srcBands[band][offset] != srcBandsNullPix[band])
+                  T* destRow = destBands[band] +
+                     (y - tileRect.ul().y)*destWidth + (copyRect.ul().x - tileRect.ul().x);
+                  const float* srcRow = srcBands[band] +
+                     (y - srcRect.ul().y)*srcWidth + (copyRect.ul().x - srcRect.ul().x);
+                  for(ossim_int32 x = 0; x < copyWidth; ++x)
                   {
-                     destBands[band][offset] =
-                        (T)(minP + delta*srcBands[band][offset]);
+                     if (destRow[x] == destBandsNullPix[band])
+                     {
+                        if (srcRow[x] != srcBandsNullPix[band])
+                        {
+                           destRow[x] = (T)(minP + delta*srcRow[x]);
+                        }
+                     }
                   }
                }
             }
          }
       }
 
-      // Validate output tile and return if full.
-      destinationStatus = destination->validate();
-      if (destinationStatus == OSSIM_FULL)
+      // Shrink the hole to what is still null, done if nothing is.
+      holeRect = findNullRect<T>(destination.get(), holeRect);
+      if (holeRect.hasNans())
       {
-         
+         destinationStatus = OSSIM_FULL;
          break;//return destination;
       }
+      destinationStatus = OSSIM_PARTIAL;
 
-      // If we get here we're are still not full.  Get a tile from next layer.
-      currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
+      // If we get here we're are still not full.  Get the hole from next layer.
+      currentImageData = getNextNormTile(layerIdx, holeRect, resLevel);
+   }
+
+   // Only the hole was checked along the way.
+   if (destinationStatus == OSSIM_FULL)
+   {
+      destination->setDataObjectStatus(OSSIM_FULL);
+   }
+   else
+   {
+      destination->validate();
    }
 
    // Cleanup...
@@ -433,6 +652,10 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
       
    ossim_uint32 band;
    ossim_uint32 upperBound = destination->getWidth()*destination->getHeight();
+   ossim_int32 destWidth = (ossim_int32)destination->getWidth();
+
+   // Bounding rect of the pixels still null, all the next layer is asked for.
+   ossimIrect holeRect = tileRect;
    ossim_uint32 minNumberOfBands = currentImageData->getNumberOfBands();
    for(band = 0; band < minNumberOfBands; ++band)
    {
@@ -462,7 +685,7 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
          currentImageData->getDataObjectStatus();
       if ( (currentStatus == OSSIM_EMPTY) || (currentStatus == OSSIM_NULL) )
       {
-         currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
+         currentImageData = getNextTile(layerIdx, holeRect, resLevel);
          continue;
       }
       
@@ -481,8 +704,10 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
          srcBandsNullPix[band] = static_cast<T>(currentImageData->getNullPix(minNumberOfBands - 1));
       }
 
+      ossimIrect srcRect = currentImageData->getImageRectangle();
       if ( (currentStatus == OSSIM_FULL) &&
-           (destinationStatus == OSSIM_EMPTY) )
+           (destinationStatus == OSSIM_EMPTY) &&
+           (srcRect == tileRect) )
       {
          // Copy full tile to empty tile.
          for(ossim_uint32 band=0; band < theLargestNumberOfInputBands; ++band)
@@ -493,30 +718,54 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
             }
          }
       }
-      else // Copy tile checking all the pixels...
+      else // Copy the hole checking all the pixels...
       {
-         for(band = 0; band < theLargestNumberOfInputBands; ++band)
+         ossimIrect copyRect = srcRect.clipToRect(holeRect);
+         if ( !copyRect.hasNans() )
          {
-            
-            for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+            ossim_int32 srcWidth  = (ossim_int32)srcRect.width();
+            ossim_int32 copyWidth = (ossim_int32)copyRect.width();
+            for(band = 0; band < theLargestNumberOfInputBands; ++band)
             {
-               if(destBands[band][offset] == destBandsNullPix[band])
+               for(ossim_int32 y = copyRect.ul().y; y <= copyRect.lr().y; ++y)
                {
-                  destBands[band][offset] = srcBands[band][offset];
+                  T* destRow = destBands[band] +
+                     (y - tileRect.ul().y)*destWidth + (copyRect.ul().x - tileRect.ul().x);
+                  const T* srcRow = srcBands[band] +
+                     (y - srcRect.ul().y)*srcWidth + (copyRect.ul().x - srcRect.ul().x);
+                  for(ossim_int32 x = 0; x < copyWidth; ++x)
+                  {
+                     if(destRow[x] == destBandsNullPix[band])
+                     {
+                        destRow[x] = srcRow[x];
+                     }
+                  }
                }
             }
          }
       }
 
-      // Validate output tile and return if full.
-      destinationStatus = destination->validate();
-      if (destinationStatus == OSSIM_FULL)
+      // Shrink the hole to what is still null, done if nothing is.
+      holeRect = findNullRect<T>(destination.get(), holeRect);
+      if (holeRect.hasNans())
       {
+         destinationStatus = OSSIM_FULL;
          break;//return destination;
       }
+      destinationStatus = OSSIM_PARTIAL;
 
-      // If we get here we're are still not full.  Get a tile from next layer.
-      currentImageData = getNextTile(layerIdx, tileRect, resLevel);
+      // If we get here we're are still not full.  Get the hole from next layer.
+      currentImageData = getNextTile(layerIdx, holeRect, resLevel);
+   }
+
+   // Only the hole was checked along the way.
+   if (destinationStatus == OSSIM_FULL)
+   {
+      destination->setDataObjectStatus(OSSIM_FULL);
+   }
+   else
+   {
+      destination->validate();
    }
    
    // Cleanup...
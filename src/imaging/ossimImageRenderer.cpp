@@ -22,6 +22,8 @@
 #include <ossim/base/ossimViewController.h>
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/base/ossimNumericProperty.h>
+#include <ossim/base/ossimVisitor.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
@@ -34,7 +36,10 @@
 #include <ossim/projection/ossimImageViewTransformFactory.h>
 #include <ossim/projection/ossimMapProjection.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <atomic>
 #include <iostream>
+#include <map>
 #include <stack>
 // using namespace std;
 
@@ -44,6 +49,24 @@ static const char OSSIM_ID[] = "$Id: ossimImageRenderer.cpp 23663 2015-12-11 21:
 
 static ossimTrace traceDebug("ossimImageRenderer:debug");
 
+// Output pixels per tile at which getTile goes parallel unless overridden.
+static const ossim_uint32 DEFAULT_PARALLEL_THRESHOLD = 65536;
+
+static ossim_uint32 defaultParallelThreshold()
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("image_renderer.parallel_threshold");
+   return lookup ? ossimString(lookup).toUInt32() : DEFAULT_PARALLEL_THRESHOLD;
+}
+
+// The settings counted by getChangeCount, resampleFill sets the rest per sub rect.
+static void copyResamplerSettings(const ossimFilterResampler& from, ossimFilterResampler& to)
+{
+   to.setFilterType(from.getMinifyFilterTypeAsString(), from.getMagnifyFilterTypeAsString());
+   to.setBlurFactor(from.getBlurFactor());
+   to.setSeparableFlag(from.getSeparableFlag());
+}
+
 RTTI_DEF2(ossimImageRenderer, "ossimImageRenderer", ossimImageSourceFilter, ossimViewInterface);
 
 
@@ -566,10 +589,14 @@ void ossimImageRenderer::ossimRendererSubRectInfo::transformViewToImage()
    ossim_float64 w = vrect.width() - 1; // subtract 1 to prevent core dump in full-earth view rect
    ossim_float64 h = vrect.height();
 
-   m_transform->viewToImage(m_Vul, m_Iul);
-   m_transform->viewToImage(m_Vur, m_Iur);
-   m_transform->viewToImage(m_Vlr, m_Ilr);
-   m_transform->viewToImage(m_Vll, m_Ill);
+   // Corners go through the transform as one batch so elevation is fetched in bulk:
+   ossimDpt vpts[4] = { m_Vul, m_Vur, m_Vlr, m_Vll };
+   ossimDpt ipts[4];
+   m_transform->viewPointsToImage(vpts, 4, ipts);
+   m_Iul = ipts[0];
+   m_Iur = ipts[1];
+   m_Ilr = ipts[2];
+   m_Ill = ipts[3];
 
 //  m_ulRoundTripError = m_transform->getRoundTripErrorView(m_Vul);
 //  m_urRoundTripError = m_transform->getRoundTripErrorView(m_Vur);
@@ -1084,7 +1111,10 @@ ossimImageRenderer::ossimImageRenderer()
       m_AutoUpdateInputTransform(true),
       m_MaxLevelsToCompute(999999), // something large so it will always compute
       m_averageViewToImageScale(1.0),
-      m_averageViewToImageRLevelScale(0.0)
+      m_averageViewToImageRLevelScale(0.0),
+      m_parallelThreshold(defaultParallelThreshold()),
+      m_workerResamplers(),
+      m_workerResamplerChangeCount(0)
 {
   ossimViewInterface::theObject = this;
   m_Resampler = new ossimFilterResampler();
@@ -1108,7 +1138,10 @@ ossimImageRenderer::ossimImageRenderer(ossimImageSource *inputSource,
       m_AutoUpdateInputTransform(true),
       m_MaxLevelsToCompute(999999),
       m_averageViewToImageScale(1.0),
-      m_averageViewToImageRLevelScale(0.0)
+      m_averageViewToImageRLevelScale(0.0),
+      m_parallelThreshold(defaultParallelThreshold()),
+      m_workerResamplers(),
+      m_workerResamplerChangeCount(0)
 // something large so it will always compute
 {
    ossimViewInterface::theObject = this;
@@ -1128,6 +1161,11 @@ ossimImageRenderer::~ossimImageRenderer()
       delete m_Resampler;
       m_Resampler = 0;
    }
+   for(ossim_uint32 idx = 0; idx < m_workerResamplers.size(); ++idx)
+   {
+      delete m_workerResamplers[idx];
+   }
+   m_workerResamplers.clear();
 }
 
 ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
@@ -1309,7 +1347,10 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
 //   {
 //      return m_Tile;
 //   }
-   recursiveResample(m_Tile, subRectInfo, 1);
+   if(!parallelResample(m_Tile, subRectInfo))
+   {
+      recursiveResample(m_Tile, subRectInfo, 1);
+   }
   
    if(m_Tile.valid())
    {
@@ -1419,22 +1460,218 @@ void ossimImageRenderer::recursiveResample(ossimRefPtr<ossimImageData> outputDat
   #endif
 }
 
+void ossimImageRenderer::splitToLeaves(const ossimRendererSubRectInfo& rectInfo,
+                                       std::vector<ossimRendererSubRectInfo>& leaves)const
+{
+  // Same walk as recursiveResample, collecting instead of filling.
+  std::stack<ossimRendererSubRectInfo> rectStack;
+  rectStack.push(rectInfo);
+
+  while(!rectStack.empty())
+  {
+    ossimRendererSubRectInfo currentRectInfo = rectStack.top();
+    ossimIrect tempViewRect = currentRectInfo.getViewRect();
+    rectStack.pop();
+    if(!m_viewArea.intersects(tempViewRect))
+    {
+      continue;
+    }
+    std::vector<ossimRendererSubRectInfo> splitRects;
+    if((tempViewRect.width() >= 2) && (tempViewRect.height() >= 2))
+    {
+      currentRectInfo.splitView(splitRects);
+    }
+    if(splitRects.empty())
+    {
+      if(!currentRectInfo.imageHasNans())
+      {
+        leaves.push_back(currentRectInfo);
+      }
+    }
+    else
+    {
+      for(ossim_uint32 idx = 0; idx < splitRects.size(); ++idx)
+      {
+        if(m_viewArea.intersects(splitRects[idx].getViewRect()))
+        {
+          rectStack.push(splitRects[idx]);
+        }
+      }
+    }
+  }
+}
+
+bool ossimImageRenderer::parallelResample(ossimRefPtr<ossimImageData> outputData,
+                                          const ossimRendererSubRectInfo& rectInfo)
+{
+   ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+   if(!m_parallelThreshold || !outputData.valid() || !outputData->getBuf() ||
+      (outputData->getSizePerBand() < m_parallelThreshold) ||
+      (pool->getNumberOfThreads() < 2))
+   {
+      return false;
+   }
+
+   //---
+   // The splitting calls the transform and the input reads go down the
+   // chain, neither is thread safe so both stay on this thread.
+   //---
+   std::vector<ossimRendererSubRectInfo> leaves;
+   splitToLeaves(rectInfo, leaves);
+
+   std::vector<FillRequest> requests(leaves.size());
+   std::vector<bool>        hasRequest(leaves.size(), false);
+   std::map<ossim_uint32, ossimIrect>   levelRects;
+   std::map<ossim_uint32, ossim_uint64> levelAreas;
+   for(ossim_uint32 idx = 0; idx < leaves.size(); ++idx)
+   {
+      if(getFillRequest(leaves[idx], requests[idx]))
+      {
+         hasRequest[idx] = true;
+         const ossimIrect& rect = requests[idx].m_inputRect;
+         std::map<ossim_uint32, ossimIrect>::iterator level = levelRects.find(requests[idx].m_resLevel);
+         if(level == levelRects.end())
+         {
+            levelRects[requests[idx].m_resLevel] = rect;
+         }
+         else
+         {
+            level->second = level->second.combine(rect);
+         }
+         levelAreas[requests[idx].m_resLevel] +=
+            static_cast<ossim_uint64>(rect.width())*rect.height();
+      }
+   }
+
+   //---
+   // One read per resolution level covering all its sub rects.  A union much
+   // larger than the pieces, e.g. sub rects far apart across a dateline,
+   // would read more than it saves so fill those one by one as before.
+   //---
+   std::map<ossim_uint32, ossimRefPtr<ossimImageData> > levelData;
+   for(std::map<ossim_uint32, ossimIrect>::const_iterator level = levelRects.begin();
+       level != levelRects.end(); ++level)
+   {
+      ossim_uint64 area = static_cast<ossim_uint64>(level->second.width())*level->second.height();
+      if(area > 2*levelAreas[level->first])
+      {
+         for(ossim_uint32 idx = 0; idx < leaves.size(); ++idx)
+         {
+            if(hasRequest[idx])
+            {
+               ossimRefPtr<ossimImageData> data =
+                  getTileAtResLevel(requests[idx].m_inputRect, requests[idx].m_resLevel);
+               resampleFill(m_Resampler, data, outputData, leaves[idx], requests[idx]);
+            }
+         }
+         return true;
+      }
+   }
+   for(std::map<ossim_uint32, ossimIrect>::const_iterator level = levelRects.begin();
+       level != levelRects.end(); ++level)
+   {
+      ossimRefPtr<ossimImageData> data = getTileAtResLevel(level->second, level->first);
+
+      // The input hands back the same tile on the next read:
+      if(data.valid() && (levelRects.size() > 1))
+      {
+         data = static_cast<ossimImageData*>(data->dup());
+      }
+      levelData[level->first] = data;
+   }
+
+   // Fill on the pool, each task with its own resampler pulling sub rects off a shared index:
+   ossim_uint32 taskCount = std::min<ossim_uint32>(pool->getNumberOfThreads(),
+                                                   static_cast<ossim_uint32>(leaves.size()));
+   updateWorkerResamplers(taskCount);
+
+   const std::map<ossim_uint32, ossimRefPtr<ossimImageData> >& inputs = levelData;
+   std::atomic<ossim_uint32> next(0);
+   std::vector< std::future<void> > tasks;
+   for(ossim_uint32 task = 0; task < taskCount; ++task)
+   {
+      ossimFilterResampler* resampler = m_workerResamplers[task];
+      tasks.push_back(pool->async([&, resampler]()
+      {
+         ossim_uint32 idx;
+         while((idx = next++) < leaves.size())
+         {
+            if(hasRequest[idx])
+            {
+               resampleFill(resampler, inputs.find(requests[idx].m_resLevel)->second,
+                            outputData, leaves[idx], requests[idx]);
+            }
+         }
+      }));
+   }
+   for(ossim_uint32 task = 0; task < tasks.size(); ++task)
+   {
+      pool->wait(tasks[task]);
+   }
+
+   return true;
+}
+
+void ossimImageRenderer::updateWorkerResamplers(ossim_uint32 count)
+{
+   // The setters bump the change count, no need to compare states per tile:
+   if(m_Resampler->getChangeCount() != m_workerResamplerChangeCount)
+   {
+      for(ossim_uint32 idx = 0; idx < m_workerResamplers.size(); ++idx)
+      {
+         copyResamplerSettings(*m_Resampler, *m_workerResamplers[idx]);
+      }
+      m_workerResamplerChangeCount = m_Resampler->getChangeCount();
+   }
+   while(m_workerResamplers.size() < count)
+   {
+      ossimFilterResampler* resampler = new ossimFilterResampler();
+      copyResamplerSettings(*m_Resampler, *resampler);
+      m_workerResamplers.push_back(resampler);
+   }
+}
+
+void ossimImageRenderer::setParallelThreshold(ossim_uint32 pixels)
+{
+   m_parallelThreshold = pixels;
+}
+
+ossim_uint32 ossimImageRenderer::getParallelThreshold()const
+{
+   return m_parallelThreshold;
+}
+
 #define RSET_SEARCH_THRESHHOLD 0.1
 
 void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
                                   const ossimRendererSubRectInfo& rectInfo)
 {
-   if(!outputData.valid() || !outputData->getBuf() || rectInfo.imageHasNans())
+   if(!outputData.valid() || !outputData->getBuf())
    {
       return;
    }
-   ossimDrect vrect = rectInfo.getViewRect();
-   
+
+   FillRequest request;
+   if(!getFillRequest(rectInfo, request))
+   {
+      return;
+   }
+
+   ossimRefPtr<ossimImageData> data = getTileAtResLevel(request.m_inputRect, request.m_resLevel);
+   resampleFill(m_Resampler, data, outputData, rectInfo, request);
+}
+
+bool ossimImageRenderer::getFillRequest(const ossimRendererSubRectInfo& rectInfo,
+                                        FillRequest& request)const
+{
+   if(rectInfo.imageHasNans())
+   {
+      return false;
+   }
    ossimDpt imageToViewScale = rectInfo.getAbsValueImageToViewScales();
    
-   if(imageToViewScale.hasNans()) return;
+   if(imageToViewScale.hasNans()) return false;
    
-   ossimDpt tile_size = ossimDpt(vrect.width(), vrect.height());
    double kernelSupportX, kernelSupportY;
    
    double resLevelX = log( 1.0 / imageToViewScale.x )/ log( 2.0 );
@@ -1537,15 +1774,21 @@ void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
    ossimDrect boundingRect = ossimDrect( nul, nll, nlr, nur );
    
 
-   boundingRect = ossimIrect((ossim_int32)floor(boundingRect.ul().x - (kernelSupportX)-.5),
-                             (ossim_int32)floor(boundingRect.ul().y - (kernelSupportY)-.5),
-                             (ossim_int32)ceil (boundingRect.lr().x + (kernelSupportX)+.5),
-                             (ossim_int32)ceil (boundingRect.lr().y + (kernelSupportY)+.5));
-   
-   ossimDrect requestRect = boundingRect;
-   
-   ossimRefPtr<ossimImageData> data = getTileAtResLevel(requestRect, resLevel);
-   
+   request.m_resLevel  = resLevel;
+   request.m_scale     = closestScale;
+   request.m_inputRect = ossimIrect((ossim_int32)floor(boundingRect.ul().x - (kernelSupportX)-.5),
+                                    (ossim_int32)floor(boundingRect.ul().y - (kernelSupportY)-.5),
+                                    (ossim_int32)ceil (boundingRect.lr().x + (kernelSupportX)+.5),
+                                    (ossim_int32)ceil (boundingRect.lr().y + (kernelSupportY)+.5));
+   return true;
+}
+
+void ossimImageRenderer::resampleFill(ossimFilterResampler* resampler,
+                                      const ossimRefPtr<ossimImageData>& data,
+                                      ossimRefPtr<ossimImageData> outputData,
+                                      const ossimRendererSubRectInfo& rectInfo,
+                                      const FillRequest& request)const
+{
    ossimDataObjectStatus status = OSSIM_NULL;
    if( data.valid() )
    {
@@ -1556,6 +1799,7 @@ void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
       return;
    }
    
+   const ossimIrect& boundingRect = request.m_inputRect;
    if((boundingRect.width() <2)&&(boundingRect.height()<2))
    {
               
@@ -1563,9 +1807,22 @@ void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
    }// std::cout << "SMALL RECT!!!!!!\n";
    else
    {
+     double closestScale = request.m_scale;
+     ossimDrect vrect = rectInfo.getViewRect();
+     ossimDpt tile_size = ossimDpt(vrect.width(), vrect.height());
+     ossimDpt imageToViewScale = rectInfo.getAbsValueImageToViewScales();
+     ossimDpt nul(rectInfo.m_Iul.x*closestScale,
+                  rectInfo.m_Iul.y*closestScale);
+     ossimDpt nll(rectInfo.m_Ill.x*closestScale,
+                  rectInfo.m_Ill.y*closestScale);
+     ossimDpt nlr(rectInfo.m_Ilr.x*closestScale,
+                  rectInfo.m_Ilr.y*closestScale);
+     ossimDpt nur(rectInfo.m_Iur.x*closestScale,
+                  rectInfo.m_Iur.y*closestScale);
+
      ossimDrect inputRect = m_inputR0Rect;
      inputRect = inputRect*ossimDpt(closestScale, closestScale);
-     m_Resampler->setBoundingInputRect(inputRect);
+     resampler->setBoundingInputRect(inputRect);
      
      double denominatorY = 1.0;
      if(tile_size.y > 2)
@@ -1575,14 +1832,14 @@ void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
      
      ossimDpt newScale( imageToViewScale.x / closestScale,
                        imageToViewScale.y / closestScale );
-     m_Resampler->setScaleFactor(newScale);
+     resampler->setScaleFactor(newScale);
      
 
   //std::cout << "SPLIT VIEW RECT: " << vrect << std::endl;
   //std::cout << "VIEW RECT: " << outputData->getImageRectangle() << std::endl;
 
 
-     m_Resampler->resample(data,
+     resampler->resample(data,
                            outputData,
                            vrect,
                            nul,
@@ -2121,6 +2378,29 @@ void ossimImageRenderer::getPropertyNames(std::vector<ossimString>& propertyName
 //  propertyNames.push_back("Blur factor");
 }
 
+//*************************************************************************************************
+// Points the IVPT approximation grid cache next to the input image, if there is exactly one.
+//*************************************************************************************************
+static void setApproximationCacheFile(ossimImageViewProjectionTransform* ivpt,
+                                      ossimImageSource* inputSrc)
+{
+   ossimFilename cacheFile;
+   if (inputSrc)
+   {
+      ossimTypeNameVisitor visitor(ossimString("ossimImageHandler"),
+                                   true,
+                                   ossimVisitor::VISIT_CHILDREN|ossimVisitor::VISIT_INPUTS);
+      inputSrc->accept(visitor);
+      if (visitor.getObjects().size() == 1)
+      {
+         ossimRefPtr<ossimImageHandler> ih = visitor.getObjectAs<ossimImageHandler>(0);
+         if (ih.valid())
+            cacheFile = ih->getFilenameWithThisExtension(ossimString("ivg"));
+      }
+   }
+   ivpt->setApproximationCacheFile(cacheFile);
+}
+
 //*************************************************************************************************
 // Insures that a proper IVT is established.
 //*************************************************************************************************
@@ -2158,6 +2438,7 @@ void ossimImageRenderer::checkIVT()
          return;
       }
       ivpt->setImageGeometry( inputGeom.get() );
+      setApproximationCacheFile( ivpt, inputSrc );
       m_rectsDirty = true;
    }
 
@@ -2628,6 +2909,7 @@ void ossimImageRenderer::refreshEvent(ossimRefreshEvent& event)
          if(ivpt)
          {
             ivpt->setImageGeometry(inputGeom.get());
+            setApproximationCacheFile(ivpt, theInputConnection);
          }
       }
    }
@@ -21,6 +21,8 @@
 #include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/imaging/ossimImageWriter.h>
 #include <ossim/base/ossimMultiResLevelHistogram.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/parallel/TilePrefetcher.h>
 
 RTTI_DEF2(ossimImageSourceSequencer, "ossimImageSourceSequencer",
           ossimImageSource, ossimConnectableObjectListener);
@@ -40,9 +42,29 @@ ossimImageSourceSequencer::ossimImageSourceSequencer(ossimImageSource* inputSour
     theNumberOfTilesHorizontal(0),
     theNumberOfTilesVertical(0),
     theCurrentTileNumber(0),
-    theCreateHistogram(false)
+    theCreateHistogram(false),
+    thePrefetcher(std::make_shared<ossim::TilePrefetcher>())
 {
    ossim::defaultTileSize(theTileSize);
+
+   //---
+   // Optional read ahead into the handler caches:
+   // ossim.imaging.sequencer.prefetch.depth: 8
+   // ossim.imaging.sequencer.prefetch.max_size: 64  (megabytes)
+   //---
+   ossimString depth = ossimPreferences::instance()->findPreference(
+      "ossim.imaging.sequencer.prefetch.depth");
+   ossimString maxSize = ossimPreferences::instance()->findPreference(
+      "ossim.imaging.sequencer.prefetch.max_size");
+   if ( maxSize.size() )
+   {
+      thePrefetcher->setMaxBytes(maxSize.toUInt64()*1024*1024);
+   }
+   if ( depth.size() )
+   {
+      thePrefetcher->setDepth(depth.toUInt32());
+   }
+
    theAreaOfInterest.makeNan();
    theInputConnection    = inputSource;
    if(inputSource)
@@ -159,6 +181,8 @@ void ossimImageSourceSequencer::initialize()
       {
          theBlankTile->initialize();
       }
+
+      initializePrefetcher(theInputConnection);
    }
 }
 
@@ -243,6 +267,7 @@ const ossimIrect& ossimImageSourceSequencer::getAreaOfInterest()const
 void ossimImageSourceSequencer::setToStartOfSequence()
 {
    theCurrentTileNumber = 0;
+   thePrefetcher->reset();
 }
 
 ossimRefPtr<ossimImageData> ossimImageSourceSequencer::getTile(
@@ -323,6 +348,7 @@ ossimRefPtr<ossimImageData> ossimImageSourceSequencer::getNextTile( ossim_uint32
       ossimIrect tileRect;
       if ( getTileRect( theCurrentTileNumber, tileRect ) )
       {
+         prefetchTiles(theCurrentTileNumber);
          ++theCurrentTileNumber;
          result = theInputConnection->getTile(tileRect, resLevel);
          if( !result.valid() || !result->getBuf() )
@@ -362,6 +388,7 @@ ossimRefPtr<ossimImageData> ossimImageSourceSequencer::getTile(
       ossimIrect tileRect;
       if ( getTileRect( id, tileRect ) )
       {
+         prefetchTiles(id);
          result = theInputConnection->getTile(tileRect, resLevel);
          if( !result.valid() || !result->getBuf() )
          {	 
@@ -609,6 +636,16 @@ bool ossimImageSourceSequencer::loadState(const ossimKeywordlist& kwl, const cha
       bool create_histogram = ossimString(lookup).toBool();
       setCreateHistogram(create_histogram);
    }
+   lookup = kwl.find(prefix, "prefetch_max_bytes");
+   if(lookup)
+   {
+      setPrefetchMaxBytes(ossimString(lookup).toUInt64());
+   }
+   lookup = kwl.find(prefix, "prefetch_depth");
+   if(lookup)
+   {
+      setPrefetchDepth(ossimString(lookup).toUInt32());
+   }
    bool status = ossimImageSource::loadState(kwl, prefix);
 
    return status;
@@ -619,3 +656,48 @@ void ossimImageSourceSequencer::setCreateHistogram(bool create_histogram)
    theCreateHistogram = create_histogram;
 }
 
+void ossimImageSourceSequencer::setPrefetchDepth(ossim_uint32 depth)
+{
+   bool wasOff = (thePrefetcher->getDepth() == 0);
+   thePrefetcher->setDepth(depth);
+   if ( wasOff && depth )
+   {
+      initializePrefetcher(theInputConnection);
+   }
+}
+
+ossim_uint32 ossimImageSourceSequencer::getPrefetchDepth()const
+{
+   return thePrefetcher->getDepth();
+}
+
+void ossimImageSourceSequencer::setPrefetchMaxBytes(ossim_uint64 maxBytes)
+{
+   thePrefetcher->setMaxBytes(maxBytes);
+}
+
+std::shared_ptr<ossim::TilePrefetcher> ossimImageSourceSequencer::getPrefetcher()const
+{
+   return thePrefetcher;
+}
+
+void ossimImageSourceSequencer::initializePrefetcher(ossimImageSource* source)
+{
+   if ( thePrefetcher->getDepth() )
+   {
+      // The prefetcher is owned by this so capturing this is safe.
+      thePrefetcher->setInput( source, [this](ossim_int64 id, ossimIrect& rect)
+      {
+         return getTileRect(id, rect);
+      });
+   }
+}
+
+void ossimImageSourceSequencer::prefetchTiles(ossim_int64 id)
+{
+   if ( thePrefetcher->getDepth() )
+   {
+      thePrefetcher->advance(id);
+   }
+}
+
@@ -113,7 +113,8 @@ ossimNitfTileSource::ossimNitfTileSource()
       theCompressedBuf(0),
       theNitfBlockOffset(0),
       theNitfBlockSize(0),
-      m_jpegOffsetsDirty(false)
+      m_jpegOffsetsDirty(false),
+      m_memoryMap()
 {
    if (traceDebug())
    {
@@ -156,6 +157,7 @@ void ossimNitfTileSource::destroy()
    theCacheTile = 0;
    theTile      = 0;
    theOverview  = 0;
+   m_memoryMap.close();
  }
 
 bool ossimNitfTileSource::isOpen()const
@@ -1645,6 +1647,225 @@ ossimRefPtr<ossimImageData> ossimNitfTileSource::getTile(
    return theTile;   
 }
 
+bool ossimNitfTileSource::getTile(ossimImageData* result, ossim_uint32 resLevel)
+{
+   if ( !result || !isConcurrentReadSafe(resLevel) )
+   {
+      // Goes through theTile and theCacheTile.
+      return ossimImageHandler::getTile(result, resLevel);
+   }
+
+   if(!isSourceEnabled() || !isOpen() || !isValidRLevel(resLevel) ||
+      (result->getNumberOfBands() != getNumberOfOutputBands()) )
+   {
+      return false;
+   }
+
+   if (resLevel)
+   {
+      return getOverviewTile(resLevel, result);
+   }
+
+   return loadMappedTile(result);
+}
+
+bool ossimNitfTileSource::enableConcurrentReads()
+{
+   if ( !m_memoryMap.isOpen() && isOpen() && canReadMapped() )
+   {
+      if ( !theTile.valid() )
+      {
+         // Creates the block cache so it is not done on a reading thread.
+         allocateBuffers();
+      }
+      m_memoryMap.open( theImageFile.string() );
+   }
+
+   if ( theOverview.valid() )
+   {
+      theOverview->enableConcurrentReads();
+   }
+
+   return ( m_memoryMap.isOpen() && canReadMapped() );
+}
+
+bool ossimNitfTileSource::isConcurrentReadSafe(ossim_uint32 resLevel) const
+{
+   if ( resLevel && theOverview.valid() && theOverview->isValidRLevel(resLevel) )
+   {
+      return theOverview->isConcurrentReadSafe(resLevel);
+   }
+   return ( (resLevel == 0) && !theStartingResLevel && !thePackedBitsFlag &&
+            m_memoryMap.isOpen() && canReadMapped() );
+}
+
+bool ossimNitfTileSource::canReadMapped() const
+{
+   const ossimNitfImageHeader* hdr = getCurrentImageHeader();
+   if ( !hdr || !theTile.valid() ||
+        isVqCompressed( hdr->getCompressionCode() ) ||
+        hdr->getRepresentation().upcase().contains("LUT") )
+   {
+      return false;
+   }
+
+   ossimString code = hdr->getCompressionCode();
+   if ( (code != "NC") && (code != "NM") )
+   {
+      return false;
+   }
+
+   switch (theReadMode)
+   {
+      case READ_BIR:
+      case READ_BIR_BLOCK:
+      case READ_BIP:
+      case READ_BIP_BLOCK:
+      case READ_BSQ_BLOCK:
+      case READ_BIB_BLOCK:
+      case READ_BIB:
+         return true;
+      default:
+         return false;
+   }
+}
+
+bool ossimNitfTileSource::loadMappedTile(ossimImageData* result) const
+{
+   ossimIrect tileRect = result->getImageRectangle();
+
+   // Initialize the tile if needed as we're going to stuff it.
+   if (result->getDataObjectStatus() == OSSIM_NULL)
+   {
+      result->initialize();
+   }
+
+   if ( !tileRect.completely_within(theImageRect) )
+   {
+      result->makeBlank();
+   }
+
+   if ( !tileRect.intersects(theBlockImageRect) )
+   {
+      return true;
+   }
+
+   ossimIrect clipRect   = tileRect.clipToRect(theImageRect);
+   ossimIrect zbClipRect = clipRect;
+   zbClipRect.stretchToTileBoundary(theCacheSize);
+
+   // Scratch block, only made if a block misses the cache.
+   ossimRefPtr<ossimImageData> block = 0;
+
+   for (ossim_int32 y = zbClipRect.ul().y; y < zbClipRect.lr().y; y += theCacheSize.y)
+   {
+      for (ossim_int32 x = zbClipRect.ul().x; x < zbClipRect.lr().x; x += theCacheSize.x)
+      {
+         ossimIpt origin(x, y);
+         ossimRefPtr<ossimImageData> source = 0;
+         if (theCacheEnabledFlag)
+         {
+            source = ossimAppFixedTileCache::instance()->getTile(theCacheId, origin);
+         }
+         if ( !source.valid() )
+         {
+            if ( !block.valid() )
+            {
+               block = ossimImageDataFactory::instance()->create(
+                  0, theScalarType, theNumberOfOutputBands,
+                  theCacheSize.x, theCacheSize.y);
+               for (ossim_uint32 band = 0; band < block->getNumberOfBands(); ++band)
+               {
+                  block->setNullPix(theCacheTile->getNullPix(band), band);
+                  block->setMinPix(theCacheTile->getMinPix(band), band);
+                  block->setMaxPix(theCacheTile->getMaxPix(band), band);
+               }
+               block->initialize();
+            }
+            block->setOrigin(origin);
+            if ( !loadMappedBlock( block.get() ) )
+            {
+               return false;
+            }
+            source = block;
+         }
+
+         //---
+         // Note: Clip the block to the image clipRect since there are nitf
+         // blocks that go beyond the image dimensions, i.e., edge blocks.
+         //---
+         ossimIrect cr = source->getImageRectangle().clipToRect(clipRect);
+         result->loadTile(source->getBuf(),
+                          source->getImageRectangle(),
+                          cr,
+                          theCacheTileInterLeaveType);
+      }
+   }
+
+   result->validate();
+   return true;
+}
+
+bool ossimNitfTileSource::loadMappedBlock(ossimImageData* block) const
+{
+   const ossimNitfImageHeader* hdr = getCurrentImageHeader();
+   ossimIpt origin = block->getOrigin();
+
+   ossim_uint32 readSize = theReadBlockSizeInBytes;
+   if( !block->getImageRectangle().completely_within(theBlockImageRect) )
+   {
+      readSize = getPartialReadSize(origin);
+   }
+   if( hdr->hasBlockMaskRecords() || (readSize != theReadBlockSizeInBytes) )
+   {
+      block->makeBlank();
+   }
+
+   //---
+   // The interleaved modes read all bands in one go into the first band
+   // buffer, the band sequential ones one block per band.
+   //---
+   bool interleaved = ( (theReadMode == READ_BIR) || (theReadMode == READ_BIR_BLOCK) ||
+                        (theReadMode == READ_BIP) || (theReadMode == READ_BIP_BLOCK) );
+   ossim_uint32 bands = interleaved ? 1 : theNumberOfInputBands;
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      std::streamoff p;
+      if ( getPosition(p, origin.x, origin.y, band) )
+      {
+         if ( (p < 0) || ( (static_cast<ossim_uint64>(p) + readSize) > m_memoryMap.size() ) )
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimNitfTileSource::loadMappedBlock Read Error!"
+               << "\nReturning error..." << endl;
+            return false;
+         }
+         void* buf = interleaved ? block->getBuf() : block->getBuf(band);
+         memcpy( buf, m_memoryMap.data() + p, readSize );
+      }
+   }
+
+   // Check for swap bytes.
+   if (theSwapBytesFlag)
+   {
+      ossimEndian swapper;
+      swapper.swap(theScalarType,
+                   block->getBuf(),
+                   block->getSize());
+   }
+
+   convertTransparentToNull(block);
+   block->validate();
+
+   if (theCacheEnabledFlag)
+   {
+      // Add a copy to the cache for the next time.
+      ossimAppFixedTileCache::instance()->addTile(theCacheId, block);
+   }
+
+   return true;
+}
+
 bool ossimNitfTileSource::loadTile(const ossimIrect& clipRect)
 {
    ossimIrect zbClipRect  = clipRect;
@@ -2515,7 +2736,7 @@ ossim_uint32 ossimNitfTileSource::getBlockNumber(const ossimIpt& block_origin) c
    return blockNumber;
 }
 
-ossim_uint32 ossimNitfTileSource::getPartialReadSize(const ossimIpt& /* blockOrigin */)const
+ossim_uint32 ossimNitfTileSource::getPartialReadSize(const ossimIpt& blockOrigin)const
 {
    ossim_uint32 result = 0;
    const ossimNitfImageHeader* hdr = getCurrentImageHeader();
@@ -2523,12 +2744,17 @@ ossim_uint32 ossimNitfTileSource::getPartialReadSize(const ossimIpt& /* blockOri
    {
       return result;
    }
-   
-   if(theCacheTile->getImageRectangle().completely_within(theBlockImageRect))
+
+   // Same rectangle as the cache tile once its origin is set to blockOrigin.
+   ossimIrect blockRect(blockOrigin.x,
+                        blockOrigin.y,
+                        blockOrigin.x + theCacheSize.x - 1,
+                        blockOrigin.y + theCacheSize.y - 1);
+   if(blockRect.completely_within(theBlockImageRect))
    {
       return theReadBlockSizeInBytes;
    }
-   ossimIrect clipRect = theCacheTile->getImageRectangle().clipToRect(theBlockImageRect);
+   ossimIrect clipRect = blockRect.clipToRect(theBlockImageRect);
    
    result = (theCacheSize.x*
              clipRect.height()*
@@ -48,6 +48,7 @@ ossimOverviewSequencer::ossimOverviewSequencer()
    m_histogram(0),
    m_histoMode(OSSIM_HISTO_MODE_UNKNOWN),
    m_histoTileIndex(1),
+   m_histoCounts(),
    m_scanForMinMax(false),
    m_scanForMinMaxNull(false),
    m_minValues(0),
@@ -171,6 +172,11 @@ void ossimOverviewSequencer::writeHistogram(const ossimFilename& file)
 {
    if ( m_histogram.valid() )
    {
+      if ( m_histoCounts.isInitialized() )
+      {
+         m_histoCounts.addTo( m_histogram.get() );
+         m_histoCounts.clear();
+      }
       ossimRefPtr<ossimMultiResLevelHistogram> histo = new ossimMultiResLevelHistogram;
       histo->addHistogram( m_histogram.get() );
       ossimKeywordlist kwl;
@@ -232,6 +238,8 @@ void ossimOverviewSequencer::initialize()
       m_histogram = new ossimMultiBandHistogram;
       
       m_histogram->create(imageSource);
+      m_histoCounts.initialize(imageSource->getOutputScalarType(),
+                               imageSource->getNumberOfOutputBands());
 
       if (m_histoMode == OSSIM_HISTO_MODE_NORMAL)
       {
@@ -378,7 +386,14 @@ ossimRefPtr<ossimImageData> ossimOverviewSequencer::getNextTile()
                << "\npopulating histogram for tile: " << m_currentTileNumber
                << "\n";
          }
-         inputTile->populateHistogram(m_histogram);
+         if ( m_histoCounts.isInitialized() )
+         {
+            m_histoCounts.accumulate( inputTile.get() );
+         }
+         else
+         {
+            inputTile->populateHistogram(m_histogram);
+         }
       }
       
       if ( (inputTile->getDataObjectStatus() == OSSIM_PARTIAL) ||
@@ -19,8 +19,12 @@
 #include <ossim/base/ossimErrorCodes.h>
 #include <ossim/base/ossimErrorContext.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimStdOutProgress.h>
 #include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimMultiBandHistogram.h>
+#include <ossim/base/ossimMultiResLevelHistogram.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimScalarTypeLut.h>
@@ -31,13 +35,19 @@
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimTiffTileSource.h>
+#include <ossim/imaging/HistogramAccumulator.h>
 #include <ossim/projection/ossimMapProjection.h>
 #include <ossim/projection/ossimMapProjectionInfo.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/support_data/ossimGeoTiff.h>
+#include <ossim/parallel/ThreadPool.h>
 
 #include <xtiffio.h>
 #include <algorithm> /* for std::fill */
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <sstream>
 using namespace std;
 
@@ -51,11 +61,313 @@ static ossimTrace traceDebug("ossimTiffOverviewBuilder:debug");
 static const char COPY_ALL_KW[]           = "copy_all_flag";
 static const char TEMP_EXTENSION[] = "temp_extension";
 static const char INTERNAL_OVERVIEWS_KW[] = "internal_overviews_flag";
+static const char SINGLE_PASS_KW[]        = "single_pass_flag";
 
 #ifdef OSSIM_ID_ENABLED
 static const char OSSIM_ID[] = "$Id: ossimTiffOverviewBuilder.cpp 22362 2013-08-07 20:23:22Z dburken $";
 #endif
 
+namespace
+{
+   //---
+   // Single pass pyramid support for ossimTiffOverviewBuilder::writeRnSinglePass.
+   //---
+
+   typedef void (*ReduceFunction)(const void* src,
+                                  ossim_uint32 srcStride,
+                                  void* dst,
+                                  ossim_uint32 dstStride,
+                                  ossim_uint32 width,
+                                  ossim_uint32 height,
+                                  ossim_float64 nullPix,
+                                  bool boxFlag);
+
+   //---
+   // Reduces a (2*width x 2*height) block to (width x height), strides in
+   // pixels.  Same arithmetic as ossimOverviewSequencer::resampleTile but
+   // without branches in the sample loop so the compiler can vectorize it.
+   //---
+   template <class T>
+   void reduceBlock(const void* src,
+                    ossim_uint32 srcStride,
+                    void* dst,
+                    ossim_uint32 dstStride,
+                    ossim_uint32 width,
+                    ossim_uint32 height,
+                    ossim_float64 nullPix,
+                    bool boxFlag)
+   {
+      const T NP = static_cast<T>(nullPix);
+      const T* s = static_cast<const T*>(src);
+      T*       d = static_cast<T*>(dst);
+
+      for (ossim_uint32 i = 0; i < height; ++i)
+      {
+         const T* s0 = s + 2*i*srcStride;
+         const T* s1 = s0 + srcStride;
+         T*       dl = d + i*dstStride;
+
+         if ( boxFlag )
+         {
+            for (ossim_uint32 j = 0; j < width; ++j)
+            {
+               const T ul = s0[2*j];
+               const T ur = s0[2*j+1];
+               const T ll = s1[2*j];
+               const T lr = s1[2*j+1];
+
+               ossim_float64 weight = 0.0;
+               ossim_float64 value  = 0.0;
+               weight += (ul != NP) ? 1.0 : 0.0;
+               weight += (ur != NP) ? 1.0 : 0.0;
+               weight += (ll != NP) ? 1.0 : 0.0;
+               weight += (lr != NP) ? 1.0 : 0.0;
+               value  += (ul != NP) ? static_cast<ossim_float64>(ul) : 0.0;
+               value  += (ur != NP) ? static_cast<ossim_float64>(ur) : 0.0;
+               value  += (ll != NP) ? static_cast<ossim_float64>(ll) : 0.0;
+               value  += (lr != NP) ? static_cast<ossim_float64>(lr) : 0.0;
+
+               dl[j] = (weight != 0.0) ? static_cast<T>( value/weight ) : NP;
+            }
+         }
+         else // nearest neighbor
+         {
+            for (ossim_uint32 j = 0; j < width; ++j)
+            {
+               dl[j] = s0[2*j];
+            }
+         }
+      }
+   }
+
+   ReduceFunction getReduceFunction(ossimScalarType scalar)
+   {
+      switch(scalar)
+      {
+         case OSSIM_UINT8:
+            return &reduceBlock<ossim_uint8>;
+         case OSSIM_SINT8:
+            return &reduceBlock<ossim_sint8>;
+         case OSSIM_USHORT11:
+         case OSSIM_USHORT12:
+         case OSSIM_USHORT13:
+         case OSSIM_USHORT14:
+         case OSSIM_USHORT15:
+         case OSSIM_UINT16:
+            return &reduceBlock<ossim_uint16>;
+         case OSSIM_SINT16:
+            return &reduceBlock<ossim_sint16>;
+         case OSSIM_UINT32:
+            return &reduceBlock<ossim_uint32>;
+         case OSSIM_SINT32:
+            return &reduceBlock<ossim_sint32>;
+         case OSSIM_NORMALIZED_FLOAT:
+         case OSSIM_FLOAT32:
+            return &reduceBlock<ossim_float32>;
+         case OSSIM_NORMALIZED_DOUBLE:
+         case OSSIM_FLOAT64:
+            return &reduceBlock<ossim_float64>;
+         default:
+            break;
+      }
+      return 0;
+   }
+
+   /** One reduced resolution level held as a single row of tiles. */
+   struct PyramidLevel
+   {
+      ossim_uint32             m_resLevel;
+      ossimIrect               m_rect;
+      ossim_uint32             m_tilesWide;
+      ossim_uint32             m_tilesHigh;
+
+      /** Tile row currently in m_tiles. */
+      ossim_uint32             m_row;
+
+      /** Current tile row; tile after tile, bands separate within a tile. */
+      std::vector<ossim_uint8> m_tiles;
+
+      /** Upper input row from the level above waiting for its lower row. */
+      std::vector<ossim_uint8> m_top;
+      bool                     m_topFlag;
+
+      /** Where the level starts in the scratch file. */
+      std::streamoff           m_scratchOffset;
+   };
+
+   //---
+   // Cascades tile rows down the levels.  Memory per level is two tile rows:
+   // the row being made and the upper row of its input.
+   //---
+   class SinglePassPyramid
+   {
+   public:
+      typedef std::function<bool(const PyramidLevel& level)> RowWriter;
+
+      SinglePassPyramid(ossim_uint32 bands,
+                        ossim_uint32 tileWidth,
+                        ossim_uint32 tileHeight,
+                        ossim_uint32 bytesPerPixel,
+                        ReduceFunction reduce,
+                        bool boxFlag,
+                        const ossimImageData* blankTile,
+                        RowWriter writer)
+         : m_levels(),
+           m_bands(bands),
+           m_tileWidth(tileWidth),
+           m_tileHeight(tileHeight),
+           m_bytesPerPixel(bytesPerPixel),
+           m_bandBytes(tileWidth*tileHeight*bytesPerPixel),
+           m_reduce(reduce),
+           m_boxFlag(boxFlag),
+           m_blankTile(blankTile),
+           m_writer(writer)
+      {
+      }
+
+      ossim_uint8* getTileBuf(std::vector<ossim_uint8>& row,
+                              ossim_uint32 col,
+                              ossim_uint32 band) const
+      {
+         return &row.front() + (static_cast<size_t>(col)*m_bands + band)*m_bandBytes;
+      }
+
+      const ossim_uint8* getTileBuf(const std::vector<ossim_uint8>* row,
+                                    ossim_uint32 cols,
+                                    ossim_uint32 col,
+                                    ossim_uint32 band) const
+      {
+         if ( row && (col < cols) )
+         {
+            return &row->front() + (static_cast<size_t>(col)*m_bands + band)*m_bandBytes;
+         }
+         return static_cast<const ossim_uint8*>(m_blankTile->getBuf(band));
+      }
+
+      /** Reduces a 2x source tile into column col of the first level. */
+      bool reduceSourceTile(ossim_uint32 col, const ossimImageData* tile)
+      {
+         PyramidLevel& level = m_levels[0];
+         bool validFlag = tile &&
+            ( (tile->getDataObjectStatus() == OSSIM_PARTIAL) ||
+              (tile->getDataObjectStatus() == OSSIM_FULL) );
+         for (ossim_uint32 band = 0; band < m_bands; ++band)
+         {
+            ossim_uint8* d = getTileBuf(level.m_tiles, col, band);
+            if ( validFlag )
+            {
+               (*m_reduce)(tile->getBuf(band), 2*m_tileWidth,
+                           d, m_tileWidth,
+                           m_tileWidth, m_tileHeight,
+                           tile->getNullPix(band), m_boxFlag);
+            }
+            else
+            {
+               memcpy(d, m_blankTile->getBuf(band), m_bandBytes);
+            }
+         }
+         return true;
+      }
+
+      /**
+       * Called once the current row of level index is complete.  Writes it
+       * and feeds it to the next level, finishing that level's row too when
+       * this was its lower input row or the last row.
+       */
+      bool finishRow(ossim_uint32 index)
+      {
+         PyramidLevel& level = m_levels[index];
+         if ( !m_writer(level) )
+         {
+            return false;
+         }
+
+         bool lastFlag = ( (level.m_row + 1) >= level.m_tilesHigh );
+         ++level.m_row;
+
+         if ( (index + 1) < m_levels.size() )
+         {
+            PyramidLevel& next = m_levels[index+1];
+            if ( next.m_topFlag )
+            {
+               reduceRow(index+1, &next.m_top, &level.m_tiles);
+               next.m_topFlag = false;
+               return finishRow(index+1);
+            }
+            else if ( lastFlag )
+            {
+               reduceRow(index+1, &level.m_tiles, 0);
+               return finishRow(index+1);
+            }
+            else
+            {
+               // Keep the upper row, level gets the old buffer to refill.
+               next.m_top.swap(level.m_tiles);
+               next.m_topFlag = true;
+            }
+         }
+         return true;
+      }
+
+      std::vector<PyramidLevel> m_levels;
+
+   private:
+      /** Builds the current row of level index from two rows above it. */
+      void reduceRow(ossim_uint32 index,
+                     const std::vector<ossim_uint8>* top,
+                     const std::vector<ossim_uint8>* bottom)
+      {
+         ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+         PyramidLevel& level = m_levels[index];
+         const ossim_uint32 INPUT_COLS = m_levels[index-1].m_tilesWide;
+         const ossim_uint32 HALF_W = m_tileWidth/2;
+         const ossim_uint32 HALF_H = m_tileHeight/2;
+
+         std::vector< std::future<void> > jobs;
+         jobs.reserve(level.m_tilesWide);
+         for (ossim_uint32 col = 0; col < level.m_tilesWide; ++col)
+         {
+            jobs.push_back(pool->async([this, &level, top, bottom, col,
+                                        INPUT_COLS, HALF_W, HALF_H]()
+            {
+               for (ossim_uint32 band = 0; band < m_bands; ++band)
+               {
+                  ossim_uint8* d = getTileBuf(level.m_tiles, col, band);
+                  ossim_float64 nullPix = m_blankTile->getNullPix(band);
+
+                  // Each input tile reduces into one quadrant.
+                  for (ossim_uint32 qy = 0; qy < 2; ++qy)
+                  {
+                     const std::vector<ossim_uint8>* row = qy ? bottom : top;
+                     for (ossim_uint32 qx = 0; qx < 2; ++qx)
+                     {
+                        const ossim_uint8* s = getTileBuf(row, INPUT_COLS, 2*col+qx, band);
+                        ossim_uint8* q = d + (qy*HALF_H*m_tileWidth + qx*HALF_W)*m_bytesPerPixel;
+                        (*m_reduce)(s, m_tileWidth, q, m_tileWidth,
+                                    HALF_W, HALF_H, nullPix, m_boxFlag);
+                     }
+                  }
+               }
+            }));
+         }
+         for (ossim_uint32 idx = 0; idx < jobs.size(); ++idx)
+         {
+            pool->wait(jobs[idx]);
+         }
+      }
+
+      ossim_uint32          m_bands;
+      ossim_uint32          m_tileWidth;
+      ossim_uint32          m_tileHeight;
+      ossim_uint32          m_bytesPerPixel;
+      size_t                m_bandBytes;
+      ReduceFunction        m_reduce;
+      bool                  m_boxFlag;
+      const ossimImageData* m_blankTile;
+      RowWriter             m_writer;
+   };
+}
+
 
 //*******************************************************************
 // Public Constructor:
@@ -77,8 +389,16 @@ ossimTiffOverviewBuilder::ossimTiffOverviewBuilder()
       m_nullPixelValues(),
       m_copyAllFlag(false),
       m_outputTileSizeSetFlag(false),
-      m_internalOverviewsFlag(false)
+      m_internalOverviewsFlag(false),
+      m_singlePassFlag(false)
 {
+   // overview_builder.single_pass_flag: true
+   const char* lookup = ossimPreferences::instance()->findPreference("overview_builder.single_pass_flag");
+   if ( lookup )
+   {
+      m_singlePassFlag = ossimString(lookup).toBool();
+   }
+
    if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -304,6 +624,56 @@ bool ossimTiffOverviewBuilder::execute()
       TIFFFlush(tif);
       
    } // End of master only write of r0.
+
+   if ( useSinglePass() && (startingResLevel < requiedResLevels) )
+   {
+      //---
+      // All levels from one pass over the source level.  Deeper levels wait
+      // in a scratch file next to the output until their directory is due.
+      //---
+      ossimFilename scratchFile = buildInternalOverviews() ?
+         m_imageHandler->getFilename() : outputFileTemp;
+      scratchFile += ".levels.tmp";
+
+      if ( !writeRnSinglePass(tif, startingResLevel, requiedResLevels, scratchFile) )
+      {
+         // Set the error...
+         setErrorStatus();
+         ossimNotify(ossimNotifyLevel_WARN)
+            << __FILE__ << " " << __LINE__ << " " << MODULE
+            << "\nError creating reduced res sets in single pass." << std::endl;
+
+         closeTiff(tif);
+         tif = 0;
+         if (progressListener)
+         {
+            removeListener(progressListener);
+            delete progressListener;
+            progressListener = 0;
+         }
+         if ( outputFileTemp.exists() && !buildInternalOverviews() )
+         {
+            ossimFilename::remove( outputFileTemp );
+         }
+         return false;
+      }
+
+      if (needsAborting())
+      {
+         closeTiff(tif);
+         tif = 0;
+         if (progressListener)
+         {
+            removeListener(progressListener);
+            delete progressListener;
+            progressListener = 0;
+         }
+         return false;
+      }
+
+      // Nothing left for the level by level loop.
+      startingResLevel = requiedResLevels;
+   }
         
    for (ossim_uint32 i = startingResLevel; i < requiedResLevels; ++i)
    {
@@ -876,6 +1246,383 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
    return true;
 }
 
+bool ossimTiffOverviewBuilder::writeRnSinglePass(TIFF* tif,
+                                                 ossim_uint32 startingResLevel,
+                                                 ossim_uint32 requiredResLevels,
+                                                 const ossimFilename& scratchFile)
+{
+   static const char MODULE[] = "ossimTiffOverviewBuilder::writeRnSinglePass";
+
+   if ( !tif || (startingResLevel == 0) || (startingResLevel >= requiredResLevels) )
+   {
+      return false;
+   }
+
+   ReduceFunction reduce = getReduceFunction(m_imageHandler->getOutputScalarType());
+   if ( !reduce )
+   {
+      return false;
+   }
+
+   const ossim_uint32 BANDS        = m_imageHandler->getNumberOfOutputBands();
+   const ossim_uint32 SOURCE_LEVEL = startingResLevel - 1;
+   const ossim_uint32 TILE_WIDTH   = static_cast<ossim_uint32>(m_tileWidth);
+   const ossim_uint32 TILE_HEIGHT  = static_cast<ossim_uint32>(m_tileHeight);
+
+   // Stands in for tiles past the edge of a level.
+   ossimRefPtr<ossimImageData> blankTile =
+      ossimImageDataFactory::instance()->create(0, BANDS, m_imageHandler.get());
+   blankTile->setWidthHeight(TILE_WIDTH, TILE_HEIGHT);
+   blankTile->initialize();
+   blankTile->makeBlank();
+
+   std::fstream scratch;
+   bool boxFlag = (m_resampleType != ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR);
+
+   SinglePassPyramid pyramid(
+      BANDS, TILE_WIDTH, TILE_HEIGHT, m_bytesPerPixel, reduce, boxFlag, blankTile.get(),
+      [this, tif, &scratch, BANDS, TILE_WIDTH, TILE_HEIGHT, startingResLevel]
+      (const PyramidLevel& level) -> bool
+   {
+      if ( level.m_resLevel == startingResLevel )
+      {
+         // First level goes straight into the current directory.
+         for (ossim_uint32 col = 0; col < level.m_tilesWide; ++col)
+         {
+            for (ossim_uint32 band = 0; band < BANDS; ++band)
+            {
+               size_t offset = (static_cast<size_t>(col)*BANDS + band)*m_tileSizeInBytes;
+               int bytesWritten = TIFFWriteTile(tif,
+                                                const_cast<ossim_uint8*>(&level.m_tiles[offset]),
+                                                col*TILE_WIDTH,
+                                                level.m_row*TILE_HEIGHT,
+                                                0,        // z
+                                                band);    // sample
+               if (bytesWritten != m_tileSizeInBytes)
+               {
+                  ossimNotify(ossimNotifyLevel_WARN)
+                     << "ossimTiffOverviewBuilder::writeRnSinglePass ERROR:"
+                     << "Error returned writing tiff tile row:  " << level.m_row
+                     << "\nExpected bytes written:  " << m_tileSizeInBytes
+                     << "\nBytes written:  " << bytesWritten
+                     << std::endl;
+                  return false;
+               }
+            }
+         }
+         return true;
+      }
+
+      // Deeper levels wait in the scratch file for their directory.
+      std::streamoff rowBytes = static_cast<std::streamoff>(level.m_tiles.size());
+      scratch.seekp(level.m_scratchOffset + level.m_row*rowBytes);
+      scratch.write(reinterpret_cast<const char*>(&level.m_tiles.front()), rowBytes);
+      return scratch.good();
+   });
+
+   //---
+   // Level sizes follow ossimOverviewSequencer::getOutputImageRectangle,
+   // half rounded up.
+   //---
+   ossimIrect sourceRect = m_imageHandler->getImageRectangle(SOURCE_LEVEL);
+   ossim_uint32 width  = sourceRect.width();
+   ossim_uint32 height = sourceRect.height();
+   std::streamoff scratchSize = 0;
+   for (ossim_uint32 resLevel = startingResLevel; resLevel < requiredResLevels; ++resLevel)
+   {
+      width  = (width  + 1) / 2;
+      height = (height + 1) / 2;
+
+      PyramidLevel level;
+      level.m_resLevel  = resLevel;
+      level.m_rect      = ossimIrect(0, 0, width - 1, height - 1);
+      level.m_tilesWide = (width  + TILE_WIDTH  - 1) / TILE_WIDTH;
+      level.m_tilesHigh = (height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+      level.m_row       = 0;
+      level.m_topFlag   = false;
+      level.m_tiles.resize(static_cast<size_t>(level.m_tilesWide)*BANDS*m_tileSizeInBytes);
+      level.m_scratchOffset = 0;
+      if ( !pyramid.m_levels.empty() )
+      {
+         level.m_top.resize(pyramid.m_levels.back().m_tiles.size());
+         level.m_scratchOffset = scratchSize;
+         scratchSize += static_cast<std::streamoff>(level.m_tiles.size())*level.m_tilesHigh;
+      }
+      pyramid.m_levels.push_back(level);
+   }
+
+   if ( pyramid.m_levels.size() > 1 )
+   {
+      scratch.open(scratchFile.c_str(),
+                   std::ios::in|std::ios::out|std::ios::binary|std::ios::trunc);
+      if ( !scratch.is_open() )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " ERROR:"
+            << "\nCannot open scratch file: " << scratchFile << std::endl;
+         return false;
+      }
+   }
+
+   //---
+   // Directory for the first level.
+   //---
+   PyramidLevel& first = pyramid.m_levels[0];
+
+   ostringstream os;
+   os << "creating r" << startingResLevel << " through r" << (requiredResLevels-1)
+      << " in one pass...";
+   setCurrentMessage(os.str());
+
+   TIFFCreateDirectory( tif );
+   if (!setTags(tif, first.m_rect, startingResLevel))
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << MODULE << " Error writing tags!" << std::endl;
+      return false;
+   }
+   if ( !buildInternalOverviews() && !copyR0() && (startingResLevel == 1) )
+   {
+      // Set the geotif tags for the first layer.
+      if ( setGeotiffTags(m_imageHandler->getImageGeometry().get(),
+                          ossimDrect(first.m_rect),
+                          startingResLevel,
+                          tif) == false )
+      {
+         if (traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_NOTICE)
+               << MODULE << " NOTICE: geotiff tags not set." << std::endl;
+         }
+      }
+   }
+
+   //---
+   // The pass: each first level tile row reads one row of 2x source tiles.
+   // Reads go on the pool too when the handler allows concurrent reads.
+   //---
+   ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+   bool concurrentFlag = m_imageHandler->enableConcurrentReads() &&
+                         m_imageHandler->isConcurrentReadSafe(SOURCE_LEVEL);
+   bool status = true;
+
+   // A requested histogram is counted from the source tiles as they go by.
+   ossim::HistogramAccumulator histoCounts;
+   ossim::HistogramAccumulator* counts = 0;
+   if ( ( getHistogramMode() != OSSIM_HISTO_MODE_UNKNOWN ) &&
+        histoCounts.initialize(m_imageHandler->getOutputScalarType(), BANDS) )
+   {
+      counts = &histoCounts;
+   }
+
+   for (ossim_uint32 row = 0; (row < first.m_tilesHigh) && status && !needsAborting(); ++row)
+   {
+      std::vector< std::future<bool> > jobs;
+      jobs.reserve(first.m_tilesWide);
+
+      for (ossim_uint32 col = 0; col < first.m_tilesWide; ++col)
+      {
+         ossimIrect rect(2*col*TILE_WIDTH,
+                         2*row*TILE_HEIGHT,
+                         2*(col+1)*TILE_WIDTH  - 1,
+                         2*(row+1)*TILE_HEIGHT - 1);
+         ossimRefPtr<ossimImageData> tile = 0;
+         if ( concurrentFlag )
+         {
+            tile = ossimImageDataFactory::instance()->create(0, BANDS, m_imageHandler.get());
+            tile->setImageRectangle(rect);
+            tile->initialize();
+            jobs.push_back(pool->async([this, &pyramid, tile, col, SOURCE_LEVEL, counts]() mutable
+            {
+               if ( !m_imageHandler->getTile(tile.get(), SOURCE_LEVEL) )
+               {
+                  return false;
+               }
+               tile->validate();
+               if ( counts )
+               {
+                  counts->accumulate(tile.get());
+               }
+               return pyramid.reduceSourceTile(col, tile.get());
+            }));
+         }
+         else
+         {
+            ossimRefPtr<ossimImageData> t = m_imageHandler->getTile(rect, SOURCE_LEVEL);
+            if ( m_imageHandler->hasError() )
+            {
+               status = false;
+               break;
+            }
+
+            // The handler reuses its tile on the next read.
+            if ( t.valid() )
+            {
+               tile = static_cast<ossimImageData*>(t->dup());
+            }
+            jobs.push_back(pool->async([&pyramid, tile, col, counts]()
+            {
+               if ( counts )
+               {
+                  counts->accumulate(tile.get());
+               }
+               return pyramid.reduceSourceTile(col, tile.get());
+            }));
+         }
+      }
+
+      for (ossim_uint32 idx = 0; idx < jobs.size(); ++idx)
+      {
+         if ( !pool->wait(jobs[idx]) )
+         {
+            status = false;
+         }
+      }
+
+      if ( !status || m_imageHandler->hasError() )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " ERROR: reading tile row:  " << row << std::endl;
+         status = false;
+      }
+      else if ( !pyramid.finishRow(0) )
+      {
+         status = false;
+      }
+      else
+      {
+         double rows = row + 1;
+         double numRows = first.m_tilesHigh;
+         setPercentComplete(rows / numRows * 100.0);
+      }
+   }
+
+   if ( status && !needsAborting() )
+   {
+      if (!TIFFFlush(tif))
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " Error writing to TIF file!" << std::endl;
+         status = false;
+      }
+      ++m_currentTiffDir;
+   }
+
+   if ( status && counts && !needsAborting() )
+   {
+      // Same file writeRn makes through ossimOverviewSequencer::writeHistogram.
+      ossimRefPtr<ossimMultiBandHistogram> bandHisto = new ossimMultiBandHistogram;
+      bandHisto->create(m_imageHandler.get());
+      counts->addTo(bandHisto.get());
+
+      ossimRefPtr<ossimMultiResLevelHistogram> histo = new ossimMultiResLevelHistogram;
+      histo->addHistogram(bandHisto.get());
+      ossimKeywordlist kwl;
+      histo->saveState(kwl);
+
+      ossimFilename histoFilename = getOutputFile();
+      histoFilename.setExtension("his");
+      kwl.write(histoFilename.c_str());
+   }
+
+   //---
+   // Copy the deeper levels from the scratch file, one directory each.
+   //---
+   std::vector<ossim_uint8> rowBuffer;
+   for (ossim_uint32 idx = 1; (idx < pyramid.m_levels.size()) && status && !needsAborting(); ++idx)
+   {
+      const PyramidLevel& level = pyramid.m_levels[idx];
+
+      os.str("");
+      os << "writing r" << level.m_resLevel << "...";
+      setCurrentMessage(os.str());
+
+      TIFFCreateDirectory( tif );
+      if (!setTags(tif, level.m_rect, level.m_resLevel))
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << MODULE << " Error writing tags!" << std::endl;
+         status = false;
+         break;
+      }
+
+      rowBuffer.resize(level.m_tiles.size());
+      std::streamoff rowBytes = static_cast<std::streamoff>(rowBuffer.size());
+      for (ossim_uint32 row = 0; (row < level.m_tilesHigh) && status; ++row)
+      {
+         scratch.seekg(level.m_scratchOffset + row*rowBytes);
+         scratch.read(reinterpret_cast<char*>(&rowBuffer.front()), rowBytes);
+         if ( !scratch.good() )
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << MODULE << " ERROR: reading scratch file: " << scratchFile << std::endl;
+            status = false;
+            break;
+         }
+         for (ossim_uint32 col = 0; (col < level.m_tilesWide) && status; ++col)
+         {
+            for (ossim_uint32 band = 0; band < BANDS; ++band)
+            {
+               size_t offset = (static_cast<size_t>(col)*BANDS + band)*m_tileSizeInBytes;
+               int bytesWritten = TIFFWriteTile(tif,
+                                                &rowBuffer[offset],
+                                                col*TILE_WIDTH,
+                                                row*TILE_HEIGHT,
+                                                0,        // z
+                                                band);    // sample
+               if (bytesWritten != m_tileSizeInBytes)
+               {
+                  ossimNotify(ossimNotifyLevel_WARN)
+                     << MODULE << " ERROR:"
+                     << "Error returned writing tiff tile row:  " << row
+                     << "\nExpected bytes written:  " << m_tileSizeInBytes
+                     << "\nBytes written:  " << bytesWritten
+                     << std::endl;
+                  status = false;
+                  break;
+               }
+            }
+         }
+      }
+
+      if ( status )
+      {
+         if (!TIFFFlush(tif))
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << MODULE << " Error writing to TIF file!" << std::endl;
+            status = false;
+         }
+         ++m_currentTiffDir;
+      }
+   }
+
+   if ( scratch.is_open() )
+   {
+      scratch.close();
+      ossimFilename::remove( scratchFile );
+   }
+
+   if ( status && needsAborting() )
+   {
+      setPercentComplete(100.0);
+   }
+
+   return status;
+}
+
+bool ossimTiffOverviewBuilder::useSinglePass() const
+{
+   return ( m_singlePassFlag &&
+            m_imageHandler.valid() &&
+            getReduceFunction( m_imageHandler->getOutputScalarType() ) &&
+            ( ossimMpi::instance()->getNumberOfProcessors() == 1 ) &&
+            ( m_bitMaskSpec.getSize() == 0 ) &&
+            ( ( getHistogramMode() == OSSIM_HISTO_MODE_UNKNOWN ) ||
+              ossim::HistogramAccumulator::isSupported(
+                 m_imageHandler->getOutputScalarType() ) ) &&
+            !getScanForMinMax() &&
+            !getScanForMinMaxNull() );
+}
+
 //*******************************************************************
 // Private Method:
 //*******************************************************************
@@ -1125,6 +1872,16 @@ void ossimTiffOverviewBuilder::setCopyAllFlag(bool flag)
    m_copyAllFlag = flag;
 }
 
+void ossimTiffOverviewBuilder::setSinglePassFlag(bool flag)
+{
+   m_singlePassFlag = flag;
+}
+
+bool ossimTiffOverviewBuilder::getSinglePassFlag() const
+{
+   return m_singlePassFlag;
+}
+
 void ossimTiffOverviewBuilder::setInternalOverviewsFlag( bool flag )
 {
    m_internalOverviewsFlag = flag;
@@ -1394,6 +2151,10 @@ void ossimTiffOverviewBuilder::setProperty(ossimRefPtr<ossimProperty> property)
       {
          m_internalOverviewsFlag = property->valueToString().toBool();
       }
+      else if( property->getName() == SINGLE_PASS_KW )
+      {
+         m_singlePassFlag = property->valueToString().toBool();
+      }
       else if(property->getName() == ossimKeywordNames::OVERVIEW_STOP_DIMENSION_KW)
       {
          m_overviewStopDimension = property->valueToString().toUInt32();
@@ -1415,6 +2176,7 @@ void ossimTiffOverviewBuilder::getPropertyNames(std::vector<ossimString>& proper
    propertyNames.push_back(ossimKeywordNames::COMPRESSION_TYPE_KW);
    propertyNames.push_back(COPY_ALL_KW);
    propertyNames.push_back(INTERNAL_OVERVIEWS_KW);
+   propertyNames.push_back(SINGLE_PASS_KW);
    propertyNames.push_back(ossimKeywordNames::OVERVIEW_STOP_DIMENSION_KW);
    propertyNames.push_back(TEMP_EXTENSION);
 }
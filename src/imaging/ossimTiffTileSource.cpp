@@ -24,6 +24,7 @@
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimIoStream.h> /* for ossimIOMemoryStream */
 #include <ossim/base/ossimKeywordlist.h>
@@ -97,7 +98,10 @@ ossimTiffTileSource::ossimTiffTileSource()
       theImageDirectoryList(0),
       theCurrentTiffRlevel(0),
       theCompressionType(0),
-      theOutputBandList(0)
+      theOutputBandList(0),
+      m_memoryMap(),
+      m_tileOffsets(0),
+      m_swapBytesFlag(false)
 {
 }
 
@@ -180,6 +184,9 @@ bool ossimTiffTileSource::getTile(ossimImageData *result,
             }
          }
 
+         // Mapped levels are read without touching the tiff handle or buffer.
+         bool mapped = isMappedLevel(level);
+
          ossimIrect tile_rect = result->getImageRectangle();
 
          //---
@@ -198,8 +205,9 @@ bool ossimTiffTileSource::getTile(ossimImageData *result,
             }
 
             bool reallocateBuffer = false;
-            if ((tile_rect.width() != theCurrentTileWidth) ||
-                (tile_rect.height() != theCurrentTileHeight))
+            if (!mapped &&
+                ((tile_rect.width() != theCurrentTileWidth) ||
+                 (tile_rect.height() != theCurrentTileHeight)))
             {
                // Current tile size must be set prior to allocatBuffer call.
                theCurrentTileWidth = tile_rect.width();
@@ -208,7 +216,8 @@ bool ossimTiffTileSource::getTile(ossimImageData *result,
                reallocateBuffer = true;
             }
 
-            if (getCurrentTiffRLevel() != theImageDirectoryList[level])
+            if (!mapped &&
+                (getCurrentTiffRLevel() != theImageDirectoryList[level]))
             {
                status = setTiffDirectory(theImageDirectoryList[level]);
                if (status)
@@ -217,7 +226,7 @@ bool ossimTiffTileSource::getTile(ossimImageData *result,
                }
             }
 
-            if (status)
+            if (status && !mapped)
             {
                if (reallocateBuffer)
                {
@@ -240,7 +249,8 @@ bool ossimTiffTileSource::getTile(ossimImageData *result,
                }
 
                // Load the tile buffer with data from the tif.
-               if (loadTile(tile_rect, clip_rect, result))
+               if (mapped ? loadFromMappedTiles(clip_rect, level, result)
+                          : loadTile(tile_rect, clip_rect, result))
                {
                   result->validate();
                   status = true;
@@ -383,6 +393,8 @@ void ossimTiffTileSource::close()
    theRowsPerStrip.clear();
    theImageTileWidth.clear();
    theImageTileLength.clear();
+   m_tileOffsets.clear();
+   m_memoryMap.close();
    if (theBuffer)
    {
       delete[] theBuffer;
@@ -1249,6 +1261,185 @@ bool ossimTiffTileSource::loadFromTile(const ossimIrect &clip_rect,
    return true;
 }
 
+bool ossimTiffTileSource::loadFromMappedTiles(const ossimIrect &clip_rect,
+                                              ossim_uint32 level,
+                                              ossimImageData *result) const
+{
+   const ossim_uint32 DIR = theImageDirectoryList[level];
+   const ossim_int32 TILE_WIDTH = theImageTileWidth[DIR];
+   const ossim_int32 TILE_LENGTH = theImageTileLength[DIR];
+   const ossim_uint32 TILES_ACROSS = (theImageWidth[DIR] + TILE_WIDTH - 1) / TILE_WIDTH;
+   const ossim_uint32 TILES_DOWN = (theImageLength[DIR] + TILE_LENGTH - 1) / TILE_LENGTH;
+   const bool CONTIG = (thePlanarConfig[DIR] == PLANARCONFIG_CONTIG);
+   const ossim_uint32 PIXELS = TILE_WIDTH * TILE_LENGTH * (CONTIG ? theSamplesPerPixel : 1);
+   const std::vector<ossim_uint64> &offsets = m_tileOffsets[level];
+
+   std::vector<ossim_uint32> bandList;
+   getOutputBandList(bandList);
+
+   // Only needed when the file byte order differs from ours.
+   std::vector<ossim_uint8> swapBuffer;
+   ossimEndian endian;
+
+   ossimIpt ulTilePt(clip_rect.ul().x - (clip_rect.ul().x % TILE_WIDTH),
+                     clip_rect.ul().y - (clip_rect.ul().y % TILE_LENGTH));
+
+   for (ossim_int32 y = ulTilePt.y; y <= clip_rect.lr().y; y += TILE_LENGTH)
+   {
+      for (ossim_int32 x = ulTilePt.x; x <= clip_rect.lr().x; x += TILE_WIDTH)
+      {
+         ossimIrect tiff_tile_rect(x, y, x + TILE_WIDTH - 1, y + TILE_LENGTH - 1);
+         ossimIrect tiff_tile_clip_rect = tiff_tile_rect.clipToRect(clip_rect);
+         ossim_uint32 tileIndex = (y / TILE_LENGTH) * TILES_ACROSS + (x / TILE_WIDTH);
+
+         ossim_uint32 planes = CONTIG ? 1 : static_cast<ossim_uint32>(bandList.size());
+         for (ossim_uint32 plane = 0; plane < planes; ++plane)
+         {
+            ossim_uint32 index = CONTIG ? tileIndex
+                                        : tileIndex + bandList[plane] * TILES_ACROSS * TILES_DOWN;
+            if (index >= offsets.size())
+            {
+               return false;
+            }
+
+            // Offsets and sizes were checked against the mapping when enabled.
+            const void *src = m_memoryMap.data() + offsets[index];
+            if (m_swapBytesFlag)
+            {
+               swapBuffer.assign(static_cast<const ossim_uint8 *>(src),
+                                 static_cast<const ossim_uint8 *>(src) + PIXELS * theBytesPerPixel);
+               endian.swap(theScalarType, &swapBuffer.front(), PIXELS);
+               src = &swapBuffer.front();
+            }
+
+            if (CONTIG)
+            {
+               result->loadTile(src, tiff_tile_rect, tiff_tile_clip_rect, OSSIM_BIP);
+            }
+            else
+            {
+               result->loadBand(src, tiff_tile_rect, tiff_tile_clip_rect, plane);
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+bool ossimTiffTileSource::isMappedLevel(ossim_uint32 level) const
+{
+   return ((level < m_tileOffsets.size()) && !m_tileOffsets[level].empty());
+}
+
+bool ossimTiffTileSource::enableConcurrentReads()
+{
+   if (m_memoryMap.isOpen() == false && theTiffPtr &&
+       m_memoryMap.open(theImageFile.string()))
+   {
+      m_swapBytesFlag = (TIFFIsByteSwapped(theTiffPtr) != 0);
+      m_tileOffsets.resize(theImageDirectoryList.size());
+
+      const ossim_uint16 SAVED_DIRECTORY = theCurrentDirectory;
+      bool anyMapped = false;
+
+      for (ossim_uint32 level = 0; level < theImageDirectoryList.size(); ++level)
+      {
+         const ossim_uint32 DIR = theImageDirectoryList[level];
+
+         //---
+         // Only plain uncompressed tiles whose samples are whole bytes.
+         // Palette images are expanded by the rgba readers.
+         //---
+         if ((theReadMethod[DIR] != READ_TILE) ||
+             (thePhotometric[DIR] == PHOTOMETRIC_PALETTE) ||
+             !theImageTileWidth[DIR] || !theImageTileLength[DIR] ||
+             !TIFFSetDirectory(theTiffPtr, DIR))
+         {
+            continue;
+         }
+
+         ossim_uint16 compression = COMPRESSION_NONE;
+         ossim_uint16 bitsPerSample = 0;
+         TIFFGetField(theTiffPtr, TIFFTAG_COMPRESSION, &compression);
+         TIFFGetField(theTiffPtr, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
+         if ((compression != COMPRESSION_NONE) ||
+             (bitsPerSample != theBytesPerPixel * 8))
+         {
+            continue;
+         }
+
+         toff_t *tileOffsets = 0;
+         toff_t *tileByteCounts = 0;
+         if (!TIFFGetField(theTiffPtr, TIFFTAG_TILEOFFSETS, &tileOffsets) ||
+             !TIFFGetField(theTiffPtr, TIFFTAG_TILEBYTECOUNTS, &tileByteCounts) ||
+             !tileOffsets || !tileByteCounts)
+         {
+            continue;
+         }
+
+         const bool CONTIG = (thePlanarConfig[DIR] == PLANARCONFIG_CONTIG);
+         const ossim_uint64 TILE_BYTES =
+             static_cast<ossim_uint64>(theImageTileWidth[DIR]) * theImageTileLength[DIR] *
+             theBytesPerPixel * (CONTIG ? theSamplesPerPixel : 1);
+         const ossim_uint32 TILES =
+             ((theImageWidth[DIR] + theImageTileWidth[DIR] - 1) / theImageTileWidth[DIR]) *
+             ((theImageLength[DIR] + theImageTileLength[DIR] - 1) / theImageTileLength[DIR]) *
+             (CONTIG ? 1 : theSamplesPerPixel);
+
+         std::vector<ossim_uint64> offsets(TILES);
+         for (ossim_uint32 idx = 0; idx < TILES; ++idx)
+         {
+            // A short or sparse tile leaves the whole level to libtiff.
+            if ((tileByteCounts[idx] < TILE_BYTES) ||
+                ((tileOffsets[idx] + TILE_BYTES) > m_memoryMap.size()))
+            {
+               offsets.clear();
+               break;
+            }
+            offsets[idx] = tileOffsets[idx];
+         }
+
+         if (offsets.size())
+         {
+            m_tileOffsets[level].swap(offsets);
+            anyMapped = true;
+         }
+      }
+
+      // Put the handle back where the locked read path expects it.
+      TIFFSetDirectory(theTiffPtr, SAVED_DIRECTORY);
+
+      if (!anyMapped)
+      {
+         m_tileOffsets.clear();
+         m_memoryMap.close();
+      }
+   }
+
+   if (theOverview.valid())
+   {
+      theOverview->enableConcurrentReads();
+   }
+
+   return m_memoryMap.isOpen();
+}
+
+bool ossimTiffTileSource::isConcurrentReadSafe(ossim_uint32 resLevel) const
+{
+   if (theOverview.valid() && theOverview->isValidRLevel(resLevel))
+   {
+      return theOverview->isConcurrentReadSafe(resLevel);
+   }
+
+   ossim_uint32 level = resLevel;
+   if (theStartingResLevel && !theR0isFullRes && (level >= theStartingResLevel))
+   {
+      level -= theStartingResLevel;
+   }
+   return isMappedLevel(level);
+}
+
 bool ossimTiffTileSource::loadFromRgbaU8Tile(const ossimIrect &tile_rect,
                                              const ossimIrect &clip_rect,
                                              ossimImageData *result)
@@ -33,6 +33,8 @@
 #include <ossim/support_data/ossimGeoTiff.h>
 #include <ossim/imaging/ossimMemoryImageSource.h>
 #include <ossim/imaging/ossimScalarRemapper.h>
+#include <ossim/imaging/ossimTiffOverviewBuilder.h>
+#include <ossim/imaging/ossimTiffTileSource.h>
 
 #include <tiffio.h>
 #ifdef OSSIM_HAS_GEOTIFF
@@ -44,12 +46,213 @@
 #  endif
 #endif
 
+#if OSSIM_HAS_LIBZ
+#  include <zlib.h>
+#endif
+
 #include <algorithm>
+#include <cstdio>
+#include <memory>
 #include <sstream>
+#include <string>
 
 static ossimTrace traceDebug("ossimTiffWriter:debug");
+
+#if OSSIM_HAS_LIBZ
+//---
+// Deflates one tile the way libtiff does for COMPRESSION_DEFLATE without a
+// predictor so the result can go out through TIFFWriteRawTile.  blank is a
+// null tile used for the pixels an empty or partial tile does not cover.
+//---
+static bool deflateTile(const ossimImageData* tile,
+                        const std::vector<ossim_uint8>& blank,
+                        std::vector<ossim_uint8>& encoded)
+{
+   std::vector<ossim_uint8> bip(blank);
+   ossimDataObjectStatus status = tile->getDataObjectStatus();
+   if ( (status == OSSIM_PARTIAL) || (status == OSSIM_FULL) )
+   {
+      if ( tile->getSizeInBytes() != bip.size() )
+      {
+         return false;
+      }
+      tile->unloadTile(&bip.front(), tile->getImageRectangle(), OSSIM_BIP);
+   }
+
+   uLongf size = compressBound(static_cast<uLong>(bip.size()));
+   encoded.resize(size);
+   bool result = ( compress2(&encoded.front(), &size,
+                             &bip.front(), static_cast<uLong>(bip.size()),
+                             Z_DEFAULT_COMPRESSION) == Z_OK );
+   encoded.resize(result ? size : 0);
+   return result;
+}
+#endif
+
+//---
+// libtiff 4.1 can write a directory ahead of its tiles and fill the tile
+// offsets in later, which the cloud optimized layout depends on.
+//---
+#if defined(TIFFLIB_VERSION) && (TIFFLIB_VERSION >= 20191103)
+#  define OSSIM_TIFF_HAS_DEFERRED_STRILES 1
+#endif
+
+#ifdef OSSIM_TIFF_HAS_DEFERRED_STRILES
+//---
+// GDAL's structural metadata, written between the header and the first
+// directory where cloud optimized GeoTIFF readers look for it.
+//---
+static bool writeCogGhostArea(TIFF* tif)
+{
+   // Trailing space keeps the directory that follows on a word boundary.
+   std::string hints = "LAYOUT=IFDS_BEFORE_DATA\n"
+                       "BLOCK_ORDER=ROW_MAJOR\n"
+                       "KNOWN_INCOMPATIBLE_EDITION=NO\n ";
+   char head[64];
+   snprintf(head, sizeof(head), "GDAL_STRUCTURAL_METADATA_SIZE=%06d bytes\n",
+            static_cast<int>(hints.size()));
+   std::string ghost = head + hints;
+
+   // New directories go at the end of the file, i.e. after the ghost area.
+   thandle_t handle = TIFFClientdata(tif);
+   toff_t offset = TIFFIsBigTIFF(tif) ? 16 : 8;
+   return ( (TIFFGetSeekProc(tif)(handle, offset, SEEK_SET) == offset) &&
+            (TIFFGetWriteProc(tif)(handle, const_cast<char*>(ghost.data()),
+                                   static_cast<tmsize_t>(ghost.size())) ==
+             static_cast<tmsize_t>(ghost.size())) );
+}
+
+// Copies the tags a tiled directory written by this writer or the overview
+// builder can carry.  Compression goes first, the jpeg tables need it.
+static void copyCogTags(TIFF* in, TIFF* out)
+{
+   static const ttag_t TAGS16[] =
+   {
+      TIFFTAG_COMPRESSION, TIFFTAG_BITSPERSAMPLE, TIFFTAG_SAMPLESPERPIXEL,
+      TIFFTAG_SAMPLEFORMAT, TIFFTAG_PLANARCONFIG, TIFFTAG_PHOTOMETRIC,
+      TIFFTAG_MINSAMPLEVALUE, TIFFTAG_MAXSAMPLEVALUE, TIFFTAG_INDEXED
+   };
+   static const ttag_t TAGS32[] =
+   {
+      TIFFTAG_IMAGEWIDTH, TIFFTAG_IMAGELENGTH, TIFFTAG_TILEWIDTH, TIFFTAG_TILELENGTH
+   };
+   static const ttag_t TAGSDOUBLE[] =
+   {
+      TIFFTAG_SMINSAMPLEVALUE, TIFFTAG_SMAXSAMPLEVALUE
+   };
+
+   uint16 value16 = 0;
+   for (size_t i = 0; i < sizeof(TAGS16)/sizeof(TAGS16[0]); ++i)
+   {
+      if ( TIFFGetField(in, TAGS16[i], &value16) )
+      {
+         TIFFSetField(out, TAGS16[i], value16);
+      }
+   }
+   uint32 value32 = 0;
+   for (size_t i = 0; i < sizeof(TAGS32)/sizeof(TAGS32[0]); ++i)
+   {
+      if ( TIFFGetField(in, TAGS32[i], &value32) )
+      {
+         TIFFSetField(out, TAGS32[i], value32);
+      }
+   }
+   double valueDouble = 0.0;
+   for (size_t i = 0; i < sizeof(TAGSDOUBLE)/sizeof(TAGSDOUBLE[0]); ++i)
+   {
+      if ( TIFFGetField(in, TAGSDOUBLE[i], &valueDouble) )
+      {
+         TIFFSetField(out, TAGSDOUBLE[i], valueDouble);
+      }
+   }
+
+   uint16* r = 0;
+   uint16* g = 0;
+   uint16* b = 0;
+   if ( TIFFGetField(in, TIFFTAG_COLORMAP, &r, &g, &b) )
+   {
+      TIFFSetField(out, TIFFTAG_COLORMAP, r, g, b);
+   }
+   uint16 count16 = 0;
+   uint16* extraSamples = 0;
+   if ( TIFFGetField(in, TIFFTAG_EXTRASAMPLES, &count16, &extraSamples) )
+   {
+      TIFFSetField(out, TIFFTAG_EXTRASAMPLES, count16, extraSamples);
+   }
+   uint32 count32 = 0;
+   void* jpegTables = 0;
+   if ( TIFFGetField(in, TIFFTAG_JPEGTABLES, &count32, &jpegTables) )
+   {
+      TIFFSetField(out, TIFFTAG_JPEGTABLES, count32, jpegTables);
+   }
+}
+
+#if OSSIM_HAS_GEOTIFF
+static void copyGeotiffTags(TIFF* in, TIFF* out)
+{
+   static const ttag_t DOUBLE_TAGS[] =
+   {
+      TIFFTAG_GEOPIXELSCALE, TIFFTAG_GEOTIEPOINTS,
+      TIFFTAG_GEOTRANSMATRIX, TIFFTAG_GEODOUBLEPARAMS
+   };
+   uint16 count = 0;
+   double* doubles = 0;
+   for (size_t i = 0; i < sizeof(DOUBLE_TAGS)/sizeof(DOUBLE_TAGS[0]); ++i)
+   {
+      if ( TIFFGetField(in, DOUBLE_TAGS[i], &count, &doubles) )
+      {
+         TIFFSetField(out, DOUBLE_TAGS[i], count, doubles);
+      }
+   }
+   uint16* keys = 0;
+   if ( TIFFGetField(in, TIFFTAG_GEOKEYDIRECTORY, &count, &keys) )
+   {
+      TIFFSetField(out, TIFFTAG_GEOKEYDIRECTORY, count, keys);
+   }
+   char* ascii = 0;
+   if ( TIFFGetField(in, TIFFTAG_GEOASCIIPARAMS, &ascii) )
+   {
+      TIFFSetField(out, TIFFTAG_GEOASCIIPARAMS, ascii);
+   }
+}
+#endif
+
+// Copies the compressed tiles of the current directories in tile order.
+static bool copyCogTiles(TIFF* in, TIFF* out)
+{
+   ttile_t tiles = TIFFNumberOfTiles(in);
+   if ( tiles != TIFFNumberOfTiles(out) )
+   {
+      return false;
+   }
+   std::vector<ossim_uint8> buf;
+   for (ttile_t tile = 0; tile < tiles; ++tile)
+   {
+      tmsize_t size = static_cast<tmsize_t>(TIFFGetStrileByteCount(in, tile));
+      if ( size == 0 )
+      {
+         continue; // Sparse, stays sparse.
+      }
+      buf.resize(size);
+      if ( (TIFFReadRawTile(in, tile, &buf.front(), size) != size) ||
+           (TIFFWriteRawTile(out, tile, &buf.front(), size) != size) )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+#endif
+
+//---
+// On windows libtiff can treat class tiff offsets as signed(2GB limit) or
+// unsigned(4GB) so if even close to 2GB (2.1.47 GB) limit make a big tiff.
+//---
+static const ossim_uint64 BIGTIFF_THRESHOLD = 2000000000;
+
 static const char* TIFF_WRITER_OUTPUT_TILE_SIZE_X_KW = "output_tile_size_x";
 static const char* TIFF_WRITER_OUTPUT_TILE_SIZE_Y_KW = "output_tile_size_y";
+static const char* TIFF_WRITER_COG_FLAG_KW           = "cog_flag";
 static const long  DEFAULT_JPEG_QUALITY = 75;
 
 RTTI_DEF1(ossimTiffWriter, "ossimTiffWriter", ossimImageFileWriter);
@@ -69,7 +272,8 @@ ossimTiffWriter::ossimTiffWriter()
             theProjectionInfo(NULL),
             theOutputTileSize(OSSIM_DEFAULT_TILE_WIDTH, OSSIM_DEFAULT_TILE_HEIGHT),
             theForceBigTiffFlag(false),
-            theBigTiffFlag(false)
+            theBigTiffFlag(false),
+            theCogFlag(false)
 {
    theColorLut = new ossimNBandLutDataObject();
    ossim::defaultTileSize(theOutputTileSize);
@@ -104,11 +308,6 @@ bool ossimTiffWriter::openTiff()
    // Check for empty file name.
    if ( theFilename.size() )
    {
-      //---
-      // On windows libtiff can treat class tiff offsets as signed(2GB limit) or
-      // unsigned(4GB) so if even close to 2GB (2.1.47 GB) limit make a big tiff.
-      //---
-      const ossim_uint64 BIGTIFF_THRESHOLD = 2000000000;
       ossimIrect bounds = theInputConnection->getBoundingRect();
       ossim_uint64 byteCheck =
             (static_cast<ossim_uint64>(bounds.width())*
@@ -462,9 +661,264 @@ void ossimTiffWriter::checkColorLut()
 }
 
 bool ossimTiffWriter::writeFile()
+{
+   if ( !theCogFlag )
+   {
+      return writeTiffFile();
+   }
+
+   // Cloud optimized output is always tiled.
+   if ( !isTiled() )
+   {
+      theOutputImageType = "tiff_tiled";
+   }
+   if ( !theInputConnection.valid() || !theInputConnection->isMaster() )
+   {
+      return writeTiffFile();
+   }
+
+   //---
+   // Full resolution goes to a plain tiled tiff first, through the tile
+   // pipeline so deflate tiles are compressed in parallel.  The overviews
+   // are built from it and both are copied into theFilename.
+   //---
+   ossimFilename cogFile = theFilename;
+   ossimFilename r0File  = theFilename;
+   r0File += ".r0.tmp";
+
+   theFilename = r0File;
+   bool status = writeTiffFile();
+   theFilename = cogFile;
+
+   if ( status && !needsAborting() )
+   {
+      status = writeCog(r0File);
+   }
+   if ( r0File.exists() )
+   {
+      ossimFilename::remove(r0File);
+   }
+   return status;
+}
+
+bool ossimTiffWriter::writeCog(const ossimFilename& r0File)
+{
+   static const char MODULE[] = "ossimTiffWriter::writeCog";
+
+   ossim_uint16 compressType = COMPRESSION_NONE;
+   if ( theCompressionType == "jpeg" )
+   {
+      compressType = COMPRESSION_JPEG;
+   }
+   else if ( theCompressionType == "lzw" )
+   {
+      compressType = COMPRESSION_LZW;
+   }
+   else if ( theCompressionType == "packbits" )
+   {
+      compressType = COMPRESSION_PACKBITS;
+   }
+   else if ( (theCompressionType == "deflate") || (theCompressionType == "zip") )
+   {
+      compressType = COMPRESSION_DEFLATE;
+   }
+
+   bool layoutFlag = hasCogLayoutSupport();
+   ossimFilename sourceFile = r0File;
+   if ( !layoutFlag )
+   {
+      //---
+      // Without deferred tile offsets libtiff puts every directory after its
+      // tiles.  Settle for internal overviews in one file.
+      //---
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " WARNING:"
+         << "\nCloud optimized layout needs libtiff 4.1 or later."
+         << "\nWriting internal overviews only." << std::endl;
+      sourceFile = theFilename;
+      if ( !r0File.rename(sourceFile) )
+      {
+         setErrorStatus();
+         return false;
+      }
+   }
+
+   // We know we're a tiff so don't use the factory.
+   ossimRefPtr<ossimImageHandler> ih = new ossimTiffTileSource;
+   if ( !ih->open(sourceFile) )
+   {
+      setErrorStatus();
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " ERROR:"
+         << "\nCannot open file: " << sourceFile << std::endl;
+      return false;
+   }
+
+   ossimFilename ovrFile = r0File;
+   ovrFile.setExtension(ossimString("ovr"));
+
+   ossimRefPtr<ossimTiffOverviewBuilder> ob = new ossimTiffOverviewBuilder();
+   bool status = ob->setInputSource(ih.get());
+   if ( status )
+   {
+      // Give the listener to the overview builder if set.
+      if (theProgressListener)
+      {
+         ob->addListener(theProgressListener);
+      }
+      ob->setCompressionType(compressType);
+      ob->setJpegCompressionQuality(theJpegQuality);
+      ob->setOutputTileSize(theOutputTileSize);
+      ob->setInternalOverviewsFlag(!layoutFlag);
+      ob->setOutputFile(layoutFlag ? ovrFile : sourceFile);
+      status = ob->execute();
+
+      if (theProgressListener)
+      {
+         ob->removeListener(theProgressListener);
+      }
+   }
+   ob = 0;
+   ih->close();
+   ih = 0;
+
+   if ( status && layoutFlag && !needsAborting() )
+   {
+      status = writeCogLayout(r0File, ovrFile);
+   }
+   if ( ovrFile.exists() )
+   {
+      ossimFilename::remove(ovrFile);
+   }
+   if ( !status )
+   {
+      setErrorStatus();
+   }
+   return status;
+}
+
+bool ossimTiffWriter::hasCogLayoutSupport()const
+{
+#ifdef OSSIM_TIFF_HAS_DEFERRED_STRILES
+   return true;
+#else
+   return false;
+#endif
+}
+
+bool ossimTiffWriter::writeCogLayout(const ossimFilename& r0File,
+                                     const ossimFilename& ovrFile)
+{
+#ifdef OSSIM_TIFF_HAS_DEFERRED_STRILES
+   static const char MODULE[] = "ossimTiffWriter::writeCogLayout";
+
+   TIFF* r0 = XTIFFOpen(r0File.c_str(), "r");
+   if ( !r0 )
+   {
+      return false;
+   }
+   // A small image has no overviews.
+   TIFF* ovr = ovrFile.exists() ? XTIFFOpen(ovrFile.c_str(), "r") : 0;
+
+   // Source file and directory of each level, full resolution first.
+   std::vector< std::pair<TIFF*, tdir_t> > levels;
+   levels.push_back( std::make_pair(r0, tdir_t(0)) );
+   if ( ovr )
+   {
+      tdir_t count = TIFFNumberOfDirectories(ovr);
+      for (tdir_t dir = 0; dir < count; ++dir)
+      {
+         levels.push_back( std::make_pair(ovr, dir) );
+      }
+   }
+
+   ossimString openMode = "w";
+   ossim_uint64 bytes = static_cast<ossim_uint64>(r0File.fileSize()) +
+      ( ovr ? static_cast<ossim_uint64>(ovrFile.fileSize()) : 0 );
+   if ( TIFFIsBigTIFF(r0) || theForceBigTiffFlag || (bytes > BIGTIFF_THRESHOLD) )
+   {
+      openMode += "8";
+   }
+
+   //---
+   // Pass one: the ghost area and every directory, their tile offsets left
+   // for later.  libtiff chains the directories in the order written.
+   //---
+   bool status = false;
+   TIFF* out = XTIFFOpen( theFilename.c_str(), openMode.c_str() );
+   if ( out )
+   {
+      status = writeCogGhostArea(out);
+      for (size_t level = 0; status && (level < levels.size()); ++level)
+      {
+         TIFF* in = levels[level].first;
+         status = ( TIFFSetDirectory(in, levels[level].second) != 0 );
+         if ( status )
+         {
+            copyCogTags(in, out);
+            if ( level )
+            {
+               TIFFSetField(out, TIFFTAG_SUBFILETYPE, FILETYPE_REDUCEDIMAGE);
+            }
+#if OSSIM_HAS_GEOTIFF
+            else
+            {
+               copyGeotiffTags(in, out);
+            }
+#endif
+            status = ( TIFFDeferStrileArrayWriting(out) &&
+                       TIFFWriteCheck(out, 1, MODULE) &&
+                       TIFFWriteDirectory(out) );
+         }
+      }
+      XTIFFClose(out);
+      out = 0;
+   }
+
+   //---
+   // Pass two: tiles smallest overview first, each directory's offsets
+   // filled in place once its tiles are down.
+   //---
+   if ( status )
+   {
+      out = XTIFFOpen( theFilename.c_str(), "r+D" );
+      status = ( out != 0 );
+   }
+   for (size_t level = levels.size(); status && level && !needsAborting(); --level)
+   {
+      TIFF* in = levels[level-1].first;
+      status = ( TIFFSetDirectory(in, levels[level-1].second) &&
+                 TIFFSetDirectory(out, static_cast<tdir_t>(level-1)) &&
+                 copyCogTiles(in, out) &&
+                 TIFFForceStrileArrayWriting(out) );
+      setPercentComplete( 100.0 * (levels.size() - level + 1) / levels.size() );
+   }
+   if ( out )
+   {
+      XTIFFClose(out);
+   }
 
+   if ( ovr )
+   {
+      XTIFFClose(ovr);
+   }
+   XTIFFClose(r0);
+
+   if ( !status )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " ERROR:"
+         << "\nError writing cloud optimized layout: " << theFilename << std::endl;
+   }
+   return status && !needsAborting();
+#else
+   return false;
+#endif
+}
+
+bool ossimTiffWriter::writeTiffFile()
 {
-   static const char MODULE[] = "ossimTiffWriter::writeFile";
+   static const char MODULE[] = "ossimTiffWriter::writeTiffFile";
 
    if (traceDebug()) CLOG << "Entered..." << std::endl;
 
@@ -678,6 +1132,21 @@ void ossimTiffWriter::setLut(const ossimNBandLutDataObject& lut)
    theColorLut = (ossimNBandLutDataObject*)lut.dup();
 }
 
+void ossimTiffWriter::setCogFlag(bool flag)
+{
+   theCogFlag = flag;
+}
+
+bool ossimTiffWriter::getCogFlag()const
+{
+   return theCogFlag;
+}
+
+bool ossimTiffWriter::getOutputHasInternalOverviews( void ) const
+{
+   return theCogFlag;
+}
+
 bool ossimTiffWriter::saveState(ossimKeywordlist& kwl,
                                 const char* prefix)const
 {
@@ -711,6 +1180,11 @@ bool ossimTiffWriter::saveState(ossimKeywordlist& kwl,
            (ossim_uint32)theColorLutFlag,
            true);
 
+   kwl.add(prefix,
+           TIFF_WRITER_COG_FLAG_KW,
+           (ossim_uint32)theCogFlag,
+           true);
+
    if(theColorLutFlag)
    {
       if(theLutFilename != "")
@@ -797,6 +1271,12 @@ bool ossimTiffWriter::loadState(const ossimKeywordlist& kwl,
       theOutputGeotiffTagsFlag = ossimString(flag).toBool();
    }
 
+   flag = kwl.find(prefix, TIFF_WRITER_COG_FLAG_KW);
+   if(flag)
+   {
+      theCogFlag = ossimString(flag).toBool();
+   }
+
    ossimString newPrefix = ossimString(prefix) + "lut.";
 
    const char* colorLutFlag = kwl.find(prefix, "color_lut_flag");
@@ -884,10 +1364,38 @@ bool ossimTiffWriter::writeToTiles()
    ossim_uint32 tileHeight      = theInputConnection->getTileHeight();
    ossim_uint32 numberOfTiles   = theInputConnection->getNumberOfTiles();
 
+   //---
+   // With a pipeline deflate tiles are compressed on the thread pool and
+   // written raw in sequence order.  Other compressions run inside libtiff.
+   //---
+   bool rawTilesFlag = false;
+#if OSSIM_HAS_LIBZ
+   if ( thePipelineDepth && tempTile.valid() &&
+        ( (theCompressionType == "deflate") || (theCompressionType == "zip") ) )
+   {
+      tempTile->setImageRectangle(ossimIrect(0, 0, tileWidth-1, tileHeight-1));
+      tempTile->makeBlank();
+      const ossim_uint8* blankBuf = static_cast<const ossim_uint8*>(tempTile->getBuf());
+      std::shared_ptr< std::vector<ossim_uint8> > blank =
+         std::make_shared< std::vector<ossim_uint8> >(
+            blankBuf, blankBuf + tempTile->getSizeInBytes());
+      rawTilesFlag = startTilePipeline([blank](const ossimImageData* tile,
+                                               std::vector<ossim_uint8>& encoded)
+      {
+         return deflateTile(tile, *blank, encoded);
+      });
+   }
+#endif
+   if ( !rawTilesFlag )
+   {
+      startTilePipeline();
+   }
+
    // Tile loop in the height direction.
    ossim_uint32 tileNumber = 0;
    vector<ossim_float64> minBands;
    vector<ossim_float64> maxBands;
+   std::vector<ossim_uint8> encoded;
    for(ossim_uint32 i = 0; ((i < tilesHigh)&&!needsAborting()); i++)
    {
       ossimIpt origin(0,0);
@@ -899,7 +1407,7 @@ bool ossimTiffWriter::writeToTiles()
          origin.x = j * tileWidth;
 
          // Grab the tile.
-         ossimRefPtr<ossimImageData> id = theInputConnection->getNextTile();
+         ossimRefPtr<ossimImageData> id = getNextTile(rawTilesFlag ? &encoded : 0);
          if (!id)
          {
             ossimNotify(ossimNotifyLevel_WARN)
@@ -907,43 +1415,66 @@ bool ossimTiffWriter::writeToTiles()
                      << "Error returned writing tiff tile:  " << tileNumber
                      << "\nNULL Tile encountered"
                      << std::endl;
+            stopTilePipeline();
             return false;
          }
 
          ossimDataObjectStatus  tileStatus      = id->getDataObjectStatus();
          ossim_uint32           tileSizeInBytes = id->getSizeInBytes();
-         if (tileStatus != OSSIM_FULL)
-         {
-            // Clear out the buffer since it won't be filled all the way.
-            tempTile->setImageRectangle(id->getImageRectangle());
-            tempTile->makeBlank();
-         }
+         ossim_int64            bytesWritten    = 0;
 
-         if ((tileStatus == OSSIM_PARTIAL || tileStatus == OSSIM_FULL))
+         if (rawTilesFlag)
          {
-            // Stuff the tile into the tileBuffer.
-            id->unloadTile(tempTile->getBuf(),
-                           id->getImageRectangle(),
-                           OSSIM_BIP);
-            tempTile->setDataObjectStatus(id->getDataObjectStatus());
-            if(!theColorLutFlag&&!needsAborting())
+            // Already unloaded and deflated by the pipeline.
+            if ((tileStatus == OSSIM_PARTIAL || tileStatus == OSSIM_FULL) &&
+                !theColorLutFlag && !needsAborting())
             {
                id->computeMinMaxPix(minBands, maxBands);
             }
+            tileSizeInBytes = static_cast<ossim_uint32>(encoded.size());
+            bytesWritten = TIFFWriteRawTile(tiffPtr,
+                                            TIFFComputeTile(tiffPtr,
+                                                            origin.x,
+                                                            origin.y,
+                                                            0,  // z
+                                                            0), // s
+                                            &encoded.front(),
+                                            encoded.size());
          }
+         else
+         {
+            if (tileStatus != OSSIM_FULL)
+            {
+               // Clear out the buffer since it won't be filled all the way.
+               tempTile->setImageRectangle(id->getImageRectangle());
+               tempTile->makeBlank();
+            }
 
-         //---
-         // Write the tile to disk.
-         //---
-         ossim_uint32 bytesWritten = 0;
-         bytesWritten = TIFFWriteTile(tiffPtr,
-                                      tempTile->getBuf(),
-                                      origin.x,
-                                      origin.y,
-                                      0,            // z
-                                      0);           // s
-
-         if (bytesWritten != tileSizeInBytes)
+            if ((tileStatus == OSSIM_PARTIAL || tileStatus == OSSIM_FULL))
+            {
+               // Stuff the tile into the tileBuffer.
+               id->unloadTile(tempTile->getBuf(),
+                              id->getImageRectangle(),
+                              OSSIM_BIP);
+               tempTile->setDataObjectStatus(id->getDataObjectStatus());
+               if(!theColorLutFlag&&!needsAborting())
+               {
+                  id->computeMinMaxPix(minBands, maxBands);
+               }
+            }
+
+            //---
+            // Write the tile to disk.
+            //---
+            bytesWritten = TIFFWriteTile(tiffPtr,
+                                         tempTile->getBuf(),
+                                         origin.x,
+                                         origin.y,
+                                         0,            // z
+                                         0);           // s
+         }
+
+         if (bytesWritten != static_cast<ossim_int64>(tileSizeInBytes))
          {
             if(traceDebug())
             {
@@ -954,6 +1485,7 @@ bool ossimTiffWriter::writeToTiles()
                         << "\nBytes written:  " << bytesWritten
                         << std::endl;
             }
+            stopTilePipeline();
             setErrorStatus();
             return false;
          }
@@ -968,6 +1500,8 @@ bool ossimTiffWriter::writeToTiles()
 
    } // End of tile loop in the line (height) direction.
 
+   stopTilePipeline();
+
    if(!theColorLutFlag&&!needsAborting())
    {
       writeMinMaxTags(minBands, maxBands);
@@ -986,6 +1520,7 @@ bool ossimTiffWriter::writeToTilesBandSep()
 
    // Start the sequence at the first tile.
    theInputConnection->setToStartOfSequence();
+   startTilePipeline();
 
    ossim_uint32 bands     = theInputConnection->getNumberOfOutputBands();
    ossim_uint32 tilesWide = theInputConnection->getNumberOfTilesHorizontal();
@@ -1023,7 +1558,7 @@ bool ossimTiffWriter::writeToTilesBandSep()
       {
          origin.x = j * tileWidth;
 
-         ossimRefPtr<ossimImageData> id = theInputConnection->getNextTile();
+         ossimRefPtr<ossimImageData> id = getNextTile();
          if(!id)
          {
             ossimNotify(ossimNotifyLevel_WARN)
@@ -1031,6 +1566,7 @@ bool ossimTiffWriter::writeToTilesBandSep()
                      << "Error returned writing tiff tile:  " << i
                      << "\nNULL Tile encountered"
                      << std::endl;
+            stopTilePipeline();
             return false;
          }
          ossim_int32 tileSizeInBytes = id->getSizePerBandInBytes();
@@ -1070,6 +1606,7 @@ bool ossimTiffWriter::writeToTilesBandSep()
                            << std::endl;
                }
                setErrorStatus();
+               stopTilePipeline();
                return false;
             }
 
@@ -1089,6 +1626,8 @@ bool ossimTiffWriter::writeToTilesBandSep()
 
    } // End of tile loop in the line (height) direction.
 
+   stopTilePipeline();
+
    if(!theColorLutFlag&&!needsAborting())
    {
       writeMinMaxTags(minBands, maxBands);
@@ -1108,6 +1647,7 @@ bool ossimTiffWriter::writeToStrips()
 
    // Start the sequence at the first tile.
    theInputConnection->setToStartOfSequence();
+   startTilePipeline();
 
    ossim_uint32 bands = theInputConnection->getNumberOfOutputBands();
    ossim_uint32 tilesWide = theInputConnection->getNumberOfTilesHorizontal();
@@ -1144,7 +1684,7 @@ bool ossimTiffWriter::writeToStrips()
       for(ossim_uint32 j = 0; ((j < tilesWide)&&(!needsAborting())); ++j)
       {
          // Get the tile and copy it to the buffer.
-         ossimRefPtr<ossimImageData> id = theInputConnection->getNextTile();
+         ossimRefPtr<ossimImageData> id = getNextTile();
          if (!id)
          {
             ossimNotify(ossimNotifyLevel_WARN)
@@ -1153,6 +1693,7 @@ bool ossimTiffWriter::writeToStrips()
                      << "\nNULL Tile encountered"
                      << std::endl;
             delete [] buffer;
+            stopTilePipeline();
             return false;
          }
          id->unloadTile(buffer, bufferRect, OSSIM_BIP);
@@ -1184,6 +1725,7 @@ bool ossimTiffWriter::writeToStrips()
                      << std::endl;
             setErrorStatus();
             delete [] buffer;
+            stopTilePipeline();
             return false;
          }
 
@@ -1202,6 +1744,8 @@ bool ossimTiffWriter::writeToStrips()
 
    } // End of loop in the line (height) direction.
 
+   stopTilePipeline();
+
    if(!theColorLutFlag)
    {
       writeMinMaxTags(minBands, maxBands);
@@ -1224,6 +1768,7 @@ bool ossimTiffWriter::writeToStripsBandSep()
 
    // Start the sequence at the first tile.
    theInputConnection->setToStartOfSequence();
+   startTilePipeline();
 
    ossim_uint32 bands = theInputConnection->getNumberOfOutputBands();
    ossim_uint32 tilesWide = theInputConnection->getNumberOfTilesHorizontal();
@@ -1262,7 +1807,7 @@ bool ossimTiffWriter::writeToStripsBandSep()
       for(ossim_uint32 j = 0; ((j < tilesWide)&&(!needsAborting())); ++j)
       {
          // Get the tile and copy it to the buffer.
-         ossimRefPtr<ossimImageData> id = theInputConnection->getNextTile();
+         ossimRefPtr<ossimImageData> id = getNextTile();
          if (!id)
          {
             ossimNotify(ossimNotifyLevel_WARN)
@@ -1271,6 +1816,7 @@ bool ossimTiffWriter::writeToStripsBandSep()
                      << "\nNULL Tile encountered"
                      << std::endl;
             delete [] buffer;
+            stopTilePipeline();
             return false;
          }
          id->unloadTile(buffer, bufferRect, OSSIM_BIL);
@@ -1303,6 +1849,7 @@ bool ossimTiffWriter::writeToStripsBandSep()
                         << "Error returned writing tiff scanline:  " << row
                         << std::endl;
                delete [] buffer;
+               stopTilePipeline();
                return false;
             }
             buf += bytesInLine;
@@ -1321,6 +1868,8 @@ bool ossimTiffWriter::writeToStripsBandSep()
       }
    } // End of loop in the line (height) direction.
 
+   stopTilePipeline();
+
    if(!theColorLutFlag)
    {
       writeMinMaxTags(minBands, maxBands);
@@ -1457,6 +2006,10 @@ void ossimTiffWriter::setProperty(ossimRefPtr<ossimProperty> property)
    {
       theForceBigTiffFlag = property->valueToString().toBool();
    }
+   else if(property->getName() == TIFF_WRITER_COG_FLAG_KW)
+   {
+      theCogFlag = property->valueToString().toBool();
+   }
    else if(property->getName() == ossimKeywordNames::OUTPUT_TILE_SIZE_KW)
    {
       theOutputTileSize.x = property->valueToString().toInt32();
@@ -1526,6 +2079,10 @@ ossimRefPtr<ossimProperty> ossimTiffWriter::getProperty(const ossimString& name)
    {
       prop = new ossimBooleanProperty(name, theForceBigTiffFlag);
    }
+   else if(name == TIFF_WRITER_COG_FLAG_KW)
+   {
+      prop = new ossimBooleanProperty(name, theCogFlag);
+   }
    else if( name == ossimKeywordNames::OUTPUT_TILE_SIZE_KW )
    {
       ossimRefPtr<ossimStringProperty> stringProp =
@@ -1558,6 +2115,7 @@ void ossimTiffWriter::getPropertyNames(std::vector<ossimString>& propertyNames)c
    propertyNames.push_back(ossimString("lut_file"));
    propertyNames.push_back(ossimString("color_lut_flag"));
    propertyNames.push_back(ossimString("big_tiff_flag"));
+   propertyNames.push_back(ossimString(TIFF_WRITER_COG_FLAG_KW));
    propertyNames.push_back(ossimString(ossimKeywordNames::OUTPUT_TILE_SIZE_KW));
 
    ossimImageFileWriter::getPropertyNames(propertyNames);
@@ -0,0 +1,284 @@
+#include <ossim/parallel/ThreadPool.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/base/ossimCommon.h>
+#include <chrono>
+#include <ostream>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+static thread_local const ossim::ThreadPool* currentPool = 0;
+static thread_local ossim_int32 currentIndex = -1;
+
+ossim::ThreadPool* ossim::ThreadPool::instance()
+{
+   static ossim::ThreadPool pool;
+   return &pool;
+}
+
+ossim::ThreadPool::ThreadPool(ossim_uint32 nThreads, bool pinThreads)
+:m_workers(),
+ m_doneFlag(false),
+ m_nextWorker(0),
+ m_sleepMutex(),
+ m_wakeCondition(),
+ m_idleCondition(),
+ m_queuedCount(0),
+ m_runningCount(0),
+ m_stealCount(0),
+ m_executedCount(0),
+ m_idleMicroseconds(0)
+{
+   if(!nThreads) nThreads = ossim::getNumberOfThreads();
+   if(!nThreads) nThreads = 1;
+
+   // All deques must exist before the first worker starts stealing.
+   for(ossim_uint32 idx = 0; idx < nThreads; ++idx)
+   {
+      m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+   }
+   for(ossim_uint32 idx = 0; idx < nThreads; ++idx)
+   {
+      m_workers[idx]->m_thread = std::thread(&ThreadPool::workerLoop, this, idx);
+      if(pinThreads)
+      {
+         pinThread(m_workers[idx]->m_thread, idx);
+      }
+   }
+}
+
+ossim::ThreadPool::~ThreadPool()
+{
+   clear();
+   {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      m_doneFlag = true;
+   }
+   m_wakeCondition.notify_all();
+   for(ossim_uint32 idx = 0; idx < m_workers.size(); ++idx)
+   {
+      if(m_workers[idx]->m_thread.joinable())
+      {
+         m_workers[idx]->m_thread.join();
+      }
+   }
+}
+
+void ossim::ThreadPool::submit(Task task)
+{
+   if(!task || m_doneFlag) return;
+
+   ossim_int32 index = currentWorkerIndex();
+   if(index < 0)
+   {
+      index = static_cast<ossim_int32>(m_nextWorker++ % m_workers.size());
+   }
+
+   // Counted before it is visible so clear() can never take the count
+   // below zero.
+   ++m_queuedCount;
+   {
+      Worker& worker = *m_workers[index];
+      std::lock_guard<std::mutex> lock(worker.m_mutex);
+      worker.m_tasks.push_back(Task());
+      worker.m_tasks.back().swap(task);
+   }
+
+   // Taking the sleep lock orders this with a worker that has just found
+   // nothing to do and is about to wait.
+   {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+   }
+   m_wakeCondition.notify_one();
+}
+
+void ossim::ThreadPool::submit(std::shared_ptr<ossimJob> job)
+{
+   if(!job) return;
+   submit(Task([job]()
+   {
+      if(job->isReady())
+      {
+         job->start();
+      }
+   }));
+}
+
+bool ossim::ThreadPool::runPendingTask()
+{
+   Task task;
+   if(nextTask(currentWorkerIndex(), task))
+   {
+      execute(task);
+      return true;
+   }
+   return false;
+}
+
+void ossim::ThreadPool::waitForIdle()
+{
+   std::unique_lock<std::mutex> lock(m_sleepMutex);
+   m_idleCondition.wait(lock, [this]()
+   {
+      return (m_queuedCount == 0) && (m_runningCount == 0);
+   });
+}
+
+void ossim::ThreadPool::clear()
+{
+   for(ossim_uint32 idx = 0; idx < m_workers.size(); ++idx)
+   {
+      std::deque<Task> dropped;
+      {
+         std::lock_guard<std::mutex> lock(m_workers[idx]->m_mutex);
+         dropped.swap(m_workers[idx]->m_tasks);
+      }
+      m_queuedCount -= dropped.size();
+   }
+   {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+   }
+   m_idleCondition.notify_all();
+}
+
+double ossim::ThreadPool::getIdleTime()const
+{
+   return static_cast<double>(m_idleMicroseconds)*1.0e-6;
+}
+
+std::ostream& ossim::ThreadPool::print(std::ostream& out)const
+{
+   out << "ThreadPool threads = " << m_workers.size()
+       << " queue_depth = "       << m_queuedCount
+       << " busy = "              << m_runningCount
+       << " executed = "          << m_executedCount
+       << " steals = "            << m_stealCount
+       << " idle_seconds = "      << getIdleTime();
+   return out;
+}
+
+void ossim::ThreadPool::workerLoop(ossim_uint32 index)
+{
+   currentPool  = this;
+   currentIndex = static_cast<ossim_int32>(index);
+
+   Task task;
+   while(!m_doneFlag)
+   {
+      if(nextTask(currentIndex, task))
+      {
+         execute(task);
+      }
+      else
+      {
+         std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+         {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wakeCondition.wait(lock, [this]()
+            {
+               return m_doneFlag || (m_queuedCount > 0);
+            });
+         }
+         m_idleMicroseconds += static_cast<ossim_uint64>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start).count());
+      }
+   }
+}
+
+bool ossim::ThreadPool::nextTask(ossim_int32 index, Task& task)
+{
+   if(m_queuedCount == 0) return false;
+
+   ossim_uint32 count = static_cast<ossim_uint32>(m_workers.size());
+   if(index >= 0)
+   {
+      Worker& worker = *m_workers[index];
+      std::lock_guard<std::mutex> lock(worker.m_mutex);
+      if(!worker.m_tasks.empty())
+      {
+         task.swap(worker.m_tasks.back());
+         worker.m_tasks.pop_back();
+      }
+   }
+   if(!task)
+   {
+      // Steal the oldest task, starting with the next worker so thieves
+      // spread out over the victims.
+      ossim_uint32 start = (index >= 0) ? static_cast<ossim_uint32>(index + 1) : 0;
+      for(ossim_uint32 offset = 0; (offset < count) && !task; ++offset)
+      {
+         ossim_uint32 victim = (start + offset) % count;
+         if(static_cast<ossim_int32>(victim) == index) continue;
+
+         Worker& worker = *m_workers[victim];
+         std::lock_guard<std::mutex> lock(worker.m_mutex);
+         if(!worker.m_tasks.empty())
+         {
+            task.swap(worker.m_tasks.front());
+            worker.m_tasks.pop_front();
+            ++m_stealCount;
+         }
+      }
+   }
+   if(!task) return false;
+
+   // Count it running before it stops being queued so waitForIdle never
+   // sees both at zero in between.
+   ++m_runningCount;
+   --m_queuedCount;
+   return true;
+}
+
+void ossim::ThreadPool::execute(Task& task)
+{
+   try
+   {
+      task();
+   }
+   catch(...)
+   {
+      // A throwing task must not take the worker down with it.
+   }
+   task = Task();
+   ++m_executedCount;
+   if((--m_runningCount == 0) && (m_queuedCount == 0))
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_sleepMutex);
+      }
+      m_idleCondition.notify_all();
+   }
+}
+
+ossim_int32 ossim::ThreadPool::currentWorkerIndex()const
+{
+   return (currentPool == this) ? currentIndex : -1;
+}
+
+void ossim::ThreadPool::pinThread(std::thread& thread, ossim_uint32 index)
+{
+   ossim_uint32 cpuCount = std::thread::hardware_concurrency();
+   if(!cpuCount) return;
+   ossim_uint32 cpu = index % cpuCount;
+
+#if defined(_WIN32)
+   if(cpu < 64)
+   {
+      SetThreadAffinityMask(thread.native_handle(), (static_cast<DWORD_PTR>(1) << cpu));
+   }
+#elif defined(__linux__)
+   cpu_set_t cpuSet;
+   CPU_ZERO(&cpuSet);
+   CPU_SET(cpu, &cpuSet);
+   pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+   // No affinity interface, the scheduler decides.
+   (void)thread;
+   (void)cpu;
+#endif
+}
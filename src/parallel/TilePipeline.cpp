@@ -0,0 +1,206 @@
+#include <ossim/parallel/TilePipeline.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <iomanip>
+#include <sstream>
+
+static ossim_uint64 microsecondsSince(const std::chrono::steady_clock::time_point& start)
+{
+   return static_cast<ossim_uint64>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - start).count());
+}
+
+ossim::TilePipeline::TilePipeline(ossimImageSourceSequencer* sequencer,
+                                  ossim_uint32 depth,
+                                  Encoder encoder)
+:m_sequencer(sequencer),
+ m_depth(depth ? depth : 1),
+ m_encoder(encoder),
+ m_producer(),
+ m_mutex(),
+ m_condition(),
+ m_queue(),
+ m_doneFlag(false),
+ m_stopFlag(false),
+ m_startTime(std::chrono::steady_clock::now()),
+ m_lastTime(m_startTime),
+ m_tileCount(0),
+ m_inputBytes(0),
+ m_encodedBytes(0),
+ m_waitMicroseconds(0),
+ m_producerWaitMicroseconds(0)
+{
+}
+
+ossim::TilePipeline::~TilePipeline()
+{
+   stop();
+}
+
+void ossim::TilePipeline::start()
+{
+   stop();
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_doneFlag = false;
+      m_stopFlag = false;
+   }
+   m_startTime = std::chrono::steady_clock::now();
+   m_lastTime  = m_startTime;
+
+   if(m_sequencer)
+   {
+      m_sequencer->setToStartOfSequence();
+      m_producer = std::thread(&TilePipeline::produce, this);
+   }
+}
+
+bool ossim::TilePipeline::next(Item& item)
+{
+   Slot slot;
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this]()
+      {
+         return !m_queue.empty() || m_doneFlag || m_stopFlag;
+      });
+      if(m_queue.empty())
+      {
+         return false;
+      }
+      slot = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_waitMicroseconds += microsecondsSince(start);
+   }
+   m_condition.notify_all(); // Room for the producer.
+
+   item.m_tile = slot.m_tile;
+   item.m_status = true;
+   item.m_encoded.clear();
+   if(slot.m_status.valid())
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      item.m_status = slot.m_status.get();
+      m_waitMicroseconds += microsecondsSince(start);
+      item.m_encoded.swap(*slot.m_encoded);
+   }
+   m_encodedBytes += item.m_encoded.size();
+   ++m_tileCount;
+   m_lastTime = std::chrono::steady_clock::now();
+   return true;
+}
+
+void ossim::TilePipeline::stop()
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopFlag = true;
+   }
+   m_condition.notify_all();
+   if(m_producer.joinable())
+   {
+      m_producer.join();
+   }
+
+   // Encodes still running hold their own references, wait so nothing
+   // outlives the sequence.
+   std::deque<Slot> dropped;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      dropped.swap(m_queue);
+   }
+   for(ossim_uint32 idx = 0; idx < dropped.size(); ++idx)
+   {
+      if(dropped[idx].m_status.valid())
+      {
+         dropped[idx].m_status.wait();
+      }
+   }
+}
+
+void ossim::TilePipeline::produce()
+{
+   ossim::ThreadPool* pool = ossim::ThreadPool::instance();
+   while(true)
+   {
+      {
+         std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+         std::unique_lock<std::mutex> lock(m_mutex);
+         m_condition.wait(lock, [this]()
+         {
+            return (m_queue.size() < m_depth) || m_stopFlag;
+         });
+         m_producerWaitMicroseconds += microsecondsSince(start);
+         if(m_stopFlag) break;
+      }
+
+      ossimRefPtr<ossimImageData> tile = m_sequencer->getNextTile();
+      if(!tile.valid())
+      {
+         break;
+      }
+
+      // The sequencer may hand out the same tile object again next call.
+      Slot slot;
+      slot.m_tile = static_cast<ossimImageData*>(tile->dup());
+      m_inputBytes += slot.m_tile->getSizeInBytes();
+      if(m_encoder)
+      {
+         slot.m_encoded = std::make_shared< std::vector<ossim_uint8> >();
+         ossimRefPtr<ossimImageData> encodeTile = slot.m_tile;
+         std::shared_ptr< std::vector<ossim_uint8> > encoded = slot.m_encoded;
+         Encoder encoder = m_encoder;
+         slot.m_status = pool->async([encodeTile, encoded, encoder]()
+         {
+            return encoder(encodeTile.get(), *encoded);
+         });
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_queue.push_back(std::move(slot));
+      }
+      m_condition.notify_all();
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_doneFlag = true;
+   }
+   m_condition.notify_all();
+}
+
+double ossim::TilePipeline::getElapsedTime()const
+{
+   return std::chrono::duration_cast<std::chrono::microseconds>(
+      m_lastTime - m_startTime).count()*1.0e-6;
+}
+
+double ossim::TilePipeline::getWaitTime()const
+{
+   return static_cast<double>(m_waitMicroseconds)*1.0e-6;
+}
+
+double ossim::TilePipeline::getProducerWaitTime()const
+{
+   return static_cast<double>(m_producerWaitMicroseconds)*1.0e-6;
+}
+
+std::string ossim::TilePipeline::getThroughputMessage()const
+{
+   double elapsed = getElapsedTime();
+   double megabytes = static_cast<double>(m_inputBytes)/(1024.0*1024.0);
+   std::ostringstream out;
+   out << std::setiosflags(std::ios::fixed) << std::setprecision(2)
+       << "Wrote " << m_tileCount << " tiles, "
+       << megabytes << " MB in " << elapsed << " s ("
+       << (elapsed > 0.0 ? megabytes/elapsed : 0.0) << " MB/s)";
+   if(m_encodedBytes)
+   {
+      out << ", encoded to " << static_cast<double>(m_encodedBytes)/(1024.0*1024.0) << " MB";
+   }
+   out << ", writer waited " << getWaitTime() << " s"
+       << ", producer waited " << getProducerWaitTime() << " s";
+   return out.str();
+}
@@ -0,0 +1,394 @@
+#include <ossim/parallel/TilePrefetcher.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <ossim/parallel/ossimImageHandlerMtAdaptor.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimVisitor.h>
+#include <ossim/imaging/ossimCacheTileSource.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+
+// Pixels added around a mapped rect for the resampler kernels.
+static const double KERNEL_MARGIN = 4.0;
+
+ossim::TilePrefetcher::TilePrefetcher()
+:m_pool(0),
+ m_targets(),
+ m_outputGeometry(0),
+ m_tileRect(),
+ m_depth(0),
+ m_maxBytes(64*1024*1024),
+ m_mutex(),
+ m_pending(),
+ m_nextId(0),
+ m_pendingBytes(0),
+ m_hitCount(0),
+ m_stallCount(0),
+ m_missCount(0),
+ m_readCount(0),
+ m_stallMicroseconds(0)
+{
+}
+
+ossim::TilePrefetcher::~TilePrefetcher()
+{
+   waitForAll();
+}
+
+void ossim::TilePrefetcher::setInput(ossimImageSource* source, TileRectFunction tileRect)
+{
+   reset();
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_targets.clear();
+   m_outputGeometry = 0;
+   m_tileRect = tileRect;
+   if(!source) return;
+
+   m_outputGeometry = source->getImageGeometry();
+
+   // Caches in the chain plus the ones the mt adaptors keep off the chain.
+   std::vector<ossimCacheTileSource*> caches;
+   ossimTypeNameVisitor cacheVisitor(ossimString("ossimCacheTileSource"));
+   source->accept(cacheVisitor);
+   for(ossim_uint32 idx = 0; idx < cacheVisitor.getObjects().size(); ++idx)
+   {
+      caches.push_back(cacheVisitor.getObjectAs<ossimCacheTileSource>(idx));
+   }
+   ossimTypeNameVisitor adaptorVisitor(ossimString("ossimImageHandlerMtAdaptor"));
+   source->accept(adaptorVisitor);
+   for(ossim_uint32 idx = 0; idx < adaptorVisitor.getObjects().size(); ++idx)
+   {
+      ossimImageHandlerMtAdaptor* adaptor =
+         adaptorVisitor.getObjectAs<ossimImageHandlerMtAdaptor>(idx);
+      if(adaptor)
+      {
+         caches.push_back(adaptor->getCache());
+      }
+   }
+
+   for(ossim_uint32 idx = 0; idx < caches.size(); ++idx)
+   {
+      if(!caches[idx]) continue;
+
+      ossimImageHandler* handler = dynamic_cast<ossimImageHandler*>(caches[idx]->getInput(0));
+      if(!handler) continue;
+
+      bool duplicate = false;
+      for(ossim_uint32 t = 0; (t < m_targets.size()) && !duplicate; ++t)
+      {
+         duplicate = (m_targets[t].m_cache.get() == caches[idx]);
+      }
+      if(duplicate) continue;
+
+      // Reads ahead only go through a handler that can take them off thread.
+      handler->enableConcurrentReads();
+
+      Target target;
+      target.m_cache    = caches[idx];
+      target.m_handler  = handler;
+      target.m_geometry = handler->getImageGeometry();
+      m_targets.push_back(target);
+   }
+}
+
+void ossim::TilePrefetcher::setDepth(ossim_uint32 depth)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_depth = depth;
+}
+
+ossim_uint32 ossim::TilePrefetcher::getDepth()const
+{
+   return m_depth;
+}
+
+void ossim::TilePrefetcher::setMaxBytes(ossim_uint64 maxBytes)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_maxBytes = maxBytes;
+}
+
+ossim_uint64 ossim::TilePrefetcher::getMaxBytes()const
+{
+   return m_maxBytes;
+}
+
+bool ossim::TilePrefetcher::isEnabled()const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return (m_depth && !m_targets.empty() && m_tileRect);
+}
+
+void ossim::TilePrefetcher::advance(ossim_int64 id)
+{
+   Pending pending;
+   bool found = false;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(!m_depth || m_targets.empty() || !m_tileRect) return;
+
+      // Random access or a skip ahead, nothing before id is wanted anymore.
+      if(m_nextId <= id)
+      {
+         m_nextId = id + 1;
+      }
+      std::map<ossim_int64, Pending>::iterator iter = m_pending.begin();
+      while((iter != m_pending.end()) && (iter->first < (id - static_cast<ossim_int64>(m_depth))))
+      {
+         m_pendingBytes -= iter->second.m_bytes;
+         m_pending.erase(iter++);
+      }
+
+      while((m_nextId <= (id + static_cast<ossim_int64>(m_depth))) && schedule(m_nextId))
+      {
+         ++m_nextId;
+      }
+
+      iter = m_pending.find(id);
+      if(iter != m_pending.end())
+      {
+         pending.m_reads.swap(iter->second.m_reads);
+         m_pendingBytes -= iter->second.m_bytes;
+         m_pending.erase(iter);
+         found = true;
+      }
+   }
+
+   if(!found)
+   {
+      ++m_missCount;
+      return;
+   }
+
+   bool ready = true;
+   for(ossim_uint32 idx = 0; (idx < pending.m_reads.size()) && ready; ++idx)
+   {
+      ready = (pending.m_reads[idx].wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+   }
+   if(ready)
+   {
+      ++m_hitCount;
+   }
+   else
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for(ossim_uint32 idx = 0; idx < pending.m_reads.size(); ++idx)
+      {
+         pending.m_reads[idx].wait();
+      }
+      m_stallMicroseconds += static_cast<ossim_uint64>(
+         std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+      ++m_stallCount;
+   }
+}
+
+void ossim::TilePrefetcher::reset()
+{
+   waitForAll();
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_nextId = 0;
+}
+
+bool ossim::TilePrefetcher::schedule(ossim_int64 id)
+{
+   ossimIrect rect;
+   if(!m_tileRect(id, rect))
+   {
+      return false; // Past the last tile.
+   }
+
+   typedef std::pair<ossim_uint32, std::vector<ossimIrect> > LevelRects;
+   std::vector<LevelRects> targetRects(m_targets.size());
+   ossim_uint64 bytes = 0;
+
+   for(ossim_uint32 idx = 0; idx < m_targets.size(); ++idx)
+   {
+      ossimIrect targetRect;
+      ossim_uint32 resLevel = 0;
+      if(mapToTarget(rect, m_targets[idx], targetRect, resLevel) &&
+         m_targets[idx].m_cache->getPrefetchTileRects(targetRect, resLevel,
+                                                      targetRects[idx].second))
+      {
+         targetRects[idx].first = resLevel;
+
+         const ossim_uint64 PIXEL_BYTES =
+            ossim::scalarSizeInBytes(m_targets[idx].m_handler->getOutputScalarType()) *
+            m_targets[idx].m_handler->getNumberOfOutputBands();
+         for(ossim_uint32 r = 0; r < targetRects[idx].second.size(); ++r)
+         {
+            bytes += targetRects[idx].second[r].area() * PIXEL_BYTES;
+         }
+      }
+   }
+
+   if(m_pendingBytes && ((m_pendingBytes + bytes) > m_maxBytes))
+   {
+      return false; // Try again once some of the read ahead is consumed.
+   }
+
+   if(!m_pool)
+   {
+      // Not before the first read so idle sequencers start no threads.
+      m_pool = ossim::ThreadPool::instance();
+   }
+
+   Pending& pending = m_pending[id];
+   pending.m_bytes = 0;
+   if(bytes > m_maxBytes)
+   {
+      // Bigger than the whole budget on its own, leave it to the chain.
+      m_pending.erase(id);
+      return true;
+   }
+
+   for(ossim_uint32 idx = 0; idx < targetRects.size(); ++idx)
+   {
+      ossimRefPtr<ossimCacheTileSource> cache = m_targets[idx].m_cache;
+      ossim_uint32 resLevel = targetRects[idx].first;
+      for(ossim_uint32 r = 0; r < targetRects[idx].second.size(); ++r)
+      {
+         ossimIrect tileRect = targetRects[idx].second[r];
+         pending.m_reads.push_back(m_pool->async([cache, tileRect, resLevel]() mutable
+         {
+            return cache->prefetchTile(tileRect, resLevel);
+         }));
+         ++m_readCount;
+      }
+   }
+   pending.m_bytes = bytes;
+   m_pendingBytes += bytes;
+   return true;
+}
+
+bool ossim::TilePrefetcher::mapToTarget(const ossimIrect& rect, const Target& target,
+                                        ossimIrect& targetRect, ossim_uint32& resLevel)const
+{
+   resLevel = 0;
+
+   if(!m_outputGeometry.valid() || !target.m_geometry.valid() ||
+      (m_outputGeometry == target.m_geometry) ||
+      !m_outputGeometry->hasProjection() || !target.m_geometry->hasProjection())
+   {
+      // No geometry change between the handler and the output.
+      targetRect = rect;
+      return true;
+   }
+
+   ossimDpt outputPts[5] =
+   {
+      ossimDpt(rect.ul()), ossimDpt(rect.ur()), ossimDpt(rect.lr()), ossimDpt(rect.ll()),
+      ossimDpt(rect.midPoint())
+   };
+   ossimGpt worldPts[5];
+   ossimDpt targetPts[5];
+   if(!m_outputGeometry->localToWorld(outputPts, 5, worldPts) ||
+      !target.m_geometry->worldToLocal(worldPts, 5, targetPts))
+   {
+      return false;
+   }
+
+   ossimDpt ul(targetPts[0]);
+   ossimDpt lr(targetPts[0]);
+   for(ossim_uint32 idx = 0; idx < 5; ++idx)
+   {
+      if(targetPts[idx].hasNans()) return false;
+      ul.x = ossim::min(ul.x, targetPts[idx].x);
+      ul.y = ossim::min(ul.y, targetPts[idx].y);
+      lr.x = ossim::max(lr.x, targetPts[idx].x);
+      lr.y = ossim::max(lr.y, targetPts[idx].y);
+   }
+
+   //---
+   // Pick the coarsest level still at least as fine as the output, which is
+   // what the renderer will ask for.
+   //---
+   double scale = ossim::max((lr.x - ul.x + 1.0)/rect.width(),
+                             (lr.y - ul.y + 1.0)/rect.height());
+   ossimDpt decimation(1.0, 1.0);
+   ossim_uint32 levels = target.m_handler->getNumberOfDecimationLevels();
+   for(ossim_uint32 level = 1; level < levels; ++level)
+   {
+      ossimDpt next;
+      target.m_handler->getDecimationFactor(level, next);
+      if(next.hasNans() || ((next.x * scale) < 1.0)) break;
+      decimation = next;
+      resLevel   = level;
+   }
+
+   targetRect = ossimIrect(
+      static_cast<ossim_int32>(std::floor((ul.x - KERNEL_MARGIN) * decimation.x)),
+      static_cast<ossim_int32>(std::floor((ul.y - KERNEL_MARGIN) * decimation.y)),
+      static_cast<ossim_int32>(std::ceil((lr.x + KERNEL_MARGIN) * decimation.x)),
+      static_cast<ossim_int32>(std::ceil((lr.y + KERNEL_MARGIN) * decimation.y)));
+   return true;
+}
+
+void ossim::TilePrefetcher::waitForAll()
+{
+   std::map<ossim_int64, Pending> pending;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      pending.swap(m_pending);
+      m_pendingBytes = 0;
+   }
+   std::map<ossim_int64, Pending>::iterator iter = pending.begin();
+   while(iter != pending.end())
+   {
+      for(ossim_uint32 idx = 0; idx < iter->second.m_reads.size(); ++idx)
+      {
+         iter->second.m_reads[idx].wait();
+      }
+      ++iter;
+   }
+}
+
+ossim_uint64 ossim::TilePrefetcher::getHitCount()const
+{
+   return m_hitCount;
+}
+
+ossim_uint64 ossim::TilePrefetcher::getStallCount()const
+{
+   return m_stallCount;
+}
+
+ossim_uint64 ossim::TilePrefetcher::getMissCount()const
+{
+   return m_missCount;
+}
+
+ossim_uint64 ossim::TilePrefetcher::getReadCount()const
+{
+   return m_readCount;
+}
+
+double ossim::TilePrefetcher::getStallTime()const
+{
+   return static_cast<double>(m_stallMicroseconds)*1.0e-6;
+}
+
+double ossim::TilePrefetcher::getHitRate()const
+{
+   ossim_uint64 total = m_hitCount + m_stallCount + m_missCount;
+   return total ? static_cast<double>(m_hitCount)/total : 0.0;
+}
+
+std::ostream& ossim::TilePrefetcher::print(std::ostream& out)const
+{
+   out << "TilePrefetcher depth = " << m_depth
+       << " max_bytes = "           << m_maxBytes
+       << " targets = "             << m_targets.size()
+       << " reads = "               << m_readCount
+       << " hits = "                << m_hitCount
+       << " stalls = "              << m_stallCount
+       << " misses = "              << m_missCount
+       << " hit_rate = "            << getHitRate()
+       << " stall_seconds = "       << getStallTime();
+   return out;
+}
@@ -34,6 +34,7 @@
 #include <ossim/base/ossimPreferences.h>
 #include <ossim/parallel/ossimMpi.h>
 #include <ossim/parallel/ossimMultiThreadSequencer.h>
+#include <ossim/parallel/TilePrefetcher.h>
 #include <ossim/parallel/ossimMtDebug.h> //### For debug/performance eval
 #include <iterator>
 #include <sstream>
@@ -55,7 +56,8 @@ theKwl(),
 theTilingEnabled(false),
 theProgressFlag(true),
 theStdoutFlag(false),
-theThreadCount(9999) // Default no threading
+theThreadCount(9999), // Default no threading
+thePinThreadsFlag(false)
 {
    theOutputRect.makeNan();
 }
@@ -148,6 +150,18 @@ void ossimIgen::initializeAttributes()
       theNumberOfTilesToBuffer = ossimString(numberOfSlaveTileBuffersStr).toLong();
    }
 
+   // Thread count for the multi-threaded sequencer, 0 = one per cpu:
+   const char* threadsStr = theKwl.find("igen.threads");
+   if(threadsStr)
+   {
+      theThreadCount = ossimString(threadsStr).toUInt32();
+   }
+   const char* pinThreadsStr = theKwl.find("igen.pin_threads");
+   if(pinThreadsStr)
+   {
+      thePinThreadsFlag = ossimString(pinThreadsStr).toBool();
+   }
+
    const char* tilingKw = theKwl.find("igen.tiling.type");
    if(tilingKw)
    {
@@ -410,7 +424,11 @@ void ossimIgen::outputProduct()
    // we will just load a serial connection if MPI is not supported.
    // Threading?
    if (!sequencer.valid() && (theThreadCount != 9999))
-      sequencer = new ossimMultiThreadSequencer(0, theThreadCount);
+   {
+      ossimMultiThreadSequencer* mts = new ossimMultiThreadSequencer(0, theThreadCount);
+      mts->setPinThreads(thePinThreadsFlag);
+      sequencer = mts;
+   }
 
    if (!sequencer.valid())
       sequencer = new ossimImageSourceSequencer(0);
@@ -582,7 +600,22 @@ void ossimIgen::outputProduct()
          cout << "   Time waiting on cache:  "<<mts->d_idleTime5<<" s"<<endl;
          cout << "   Handler getTile T:      "<<mts->handlerGetTileT()<<" s"<<endl;
          cout << "   Job getTile T:          "<<jgtt<<" s"<<endl;
-         cout << "   Average getTile T/job:  "<<jgttpj<<" s\n"<<endl;
+         cout << "   Average getTile T/job:  "<<jgttpj<<" s"<<endl;
+         std::shared_ptr<ossim::ThreadPool> pool = mts->getThreadPool();
+         if (pool)
+         {
+            cout << "   Jobs executed:          "<<pool->getExecutedCount()<<endl;
+            cout << "   Jobs stolen:            "<<pool->getStealCount()<<endl;
+            cout << "   Worker idle T:          "<<pool->getIdleTime()<<" s"<<endl;
+         }
+         std::shared_ptr<ossim::TilePrefetcher> prefetcher = mts->getPrefetcher();
+         if (prefetcher && prefetcher->getDepth())
+         {
+            cout << "   Prefetch reads:         "<<prefetcher->getReadCount()<<endl;
+            cout << "   Prefetch hit rate:      "<<prefetcher->getHitRate()<<endl;
+            cout << "   Prefetch stall T:       "<<prefetcher->getStallTime()<<" s"<<endl;
+         }
+         cout << endl;
       }
    }
    //##################################################################
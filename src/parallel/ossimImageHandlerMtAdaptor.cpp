@@ -12,6 +12,7 @@
 //  $Id$
 #include <ossim/parallel/ossimImageHandlerMtAdaptor.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
   // #include <ossim/parallel/ossimMtDebug.h>
 #include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimTimer.h>
@@ -90,6 +91,9 @@ void ossimImageHandlerMtAdaptor::setAdaptee(ossimImageHandler* handler)
    connectMyOutputTo(output_list, true, true);
    handler->changeOwner(this);
 
+   // Handlers that can read without shared state skip the mutex in getTile():
+   handler->enableConcurrentReads();
+
    if (d_useFauxTile)
    {
       d_fauxTile = (ossimImageData*) handler->getTile(ossimIpt(0,0), 0)->dup();
@@ -157,6 +161,25 @@ ossimRefPtr<ossimImageData>
    if (!m_adaptedHandler.valid())
       return NULL;
 
+   if (isConcurrentRead(rLevel))
+   {
+      // The adaptee fills our own tile so there is nothing to lock or copy:
+      ossimRefPtr<ossimImageData> tile = ossimImageDataFactory::instance()->create(
+         this, getOutputScalarType(), getNumberOfOutputBands(),
+         tile_rect.width(), tile_rect.height());
+      for (ossim_uint32 band = 0; band < tile->getNumberOfBands(); ++band)
+      {
+         tile->setNullPix(m_adaptedHandler->getNullPixelValue(band), band);
+         tile->setMinPix(m_adaptedHandler->getMinPixelValue(band), band);
+         tile->setMaxPix(m_adaptedHandler->getMaxPixelValue(band), band);
+      }
+      tile->setImageRectangle(tile_rect);
+      tile->initialize();
+      if (!m_adaptedHandler->getTile(tile.get(), rLevel))
+         tile->makeBlank();
+      return tile;
+   }
+
    // The sole purpose of the adapter is this mutex lock around the actual handler getTile:
    //std::lock_guard<std::mutex> lock(m_mutex);
 
@@ -213,6 +236,9 @@ bool ossimImageHandlerMtAdaptor::getTile(ossimImageData* tile, ossim_uint32 rLev
    if ((!m_adaptedHandler.valid()) || (tile == NULL))
       return false;
 
+   if (isConcurrentRead(rLevel))
+      return m_adaptedHandler->getTile(tile, rLevel);
+
    // The sole purpose of the adapter is this mutex lock around the actual handler getTile:
    std::lock_guard<std::mutex> lock(m_mutex);
 
@@ -237,6 +263,14 @@ bool ossimImageHandlerMtAdaptor::getTile(ossimImageData* tile, ossim_uint32 rLev
    return status;
 }
 
+//**************************************************************************************************
+//! True when the adaptee reads this level without shared state and no cache sits in between.
+//**************************************************************************************************
+bool ossimImageHandlerMtAdaptor::isConcurrentRead(ossim_uint32 rLevel) const
+{
+   return (!d_useCache && m_adaptedHandler->isConcurrentReadSafe(rLevel));
+}
+
 //**************************************************************************************************
 //! Method to save the state of an object to a keyword list.
 //! Return true if ok or false on error.
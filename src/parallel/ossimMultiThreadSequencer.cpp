@@ -14,6 +14,7 @@
 
 #include <ossim/parallel/ossimMultiThreadSequencer.h>
 #include <ossim/parallel/ossimMtDebug.h>
+#include <ossim/parallel/TilePrefetcher.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimTimer.h>
 static const ossim_uint32 DEFAULT_MAX_TILE_CACHE_FACTOR = 8; // Must be > 1
@@ -43,6 +44,7 @@ void ossimMultiThreadSequencer::ossimGetTileJob::run()
       ossimImageSource* source = m_sequencer.m_inputChain->getClone(m_chainID);
       double dt = ossimTimer::instance()->time_s(); //###
 
+      m_sequencer.prefetchTiles(m_tileID);
       if (source != NULL)
          tile = source->getTile(tileRect);
       if (!tile.valid())
@@ -91,8 +93,9 @@ ossimMultiThreadSequencer::ossimMultiThreadSequencer(ossimImageSource* input,
    d_idleTime6(0.0),
    d_jobGetTileT(0.0),
    m_inputChain(0),
-   m_jobMtQueue(0),
+   m_threadPool(),
    m_numThreads (num_threads),
+   m_pinThreads(false),
    m_callback(std::make_shared<ossimGetTileCallback>()),
    m_nextTileID (0),
    m_tileCache(),                       
@@ -135,7 +138,7 @@ ossimMultiThreadSequencer::ossimMultiThreadSequencer(ossimImageSource* input,
 ossimMultiThreadSequencer::~ossimMultiThreadSequencer()
 {
    m_inputChain = 0; //!< Same as base class' theInputConnection
-   m_jobMtQueue = 0;
+   m_threadPool.reset();
    m_callback.reset();
 }
 
@@ -188,6 +191,10 @@ void ossimMultiThreadSequencer::setToStartOfSequence()
 
    // Set the output of the chain to be this sequencer:
    m_inputChain->disconnectAllOutputs();
+
+   // Shared handlers keep one cache so the first clone reaches all of them.
+   thePrefetcher->reset();
+   initializePrefetcher(m_inputChain->getClone(0));
    //connectMyInputTo(m_inputChain.get());
    //setAreaOfInterest(m_inputChain->getBoundingRect());
 
@@ -200,9 +207,10 @@ void ossimMultiThreadSequencer::setToStartOfSequence()
       job->start();
    }
 
-   // Set up the job queue and fill it with first N jobs:
+   // Start the pool and fill it with first N jobs. Each job queues its successor on the same
+   // chain from its worker, so chains stay on their worker unless an idle one steals them:
    ossim_uint32 num_jobs_to_launch =  min<ossim_uint32>(m_numThreads, m_totalNumberOfTiles);
-   std::shared_ptr<ossimJobQueue> jobQueue = std::make_shared<ossimJobQueue>();
+   m_threadPool = std::make_shared<ossim::ThreadPool>(num_jobs_to_launch, m_pinThreads);
    for (ossim_uint32 chain_id=0; chain_id<num_jobs_to_launch; ++chain_id)
    {
       if (d_debugEnabled)
@@ -214,13 +222,8 @@ void ossimMultiThreadSequencer::setToStartOfSequence()
 
       std::shared_ptr<ossimGetTileJob> job = std::make_shared<ossimGetTileJob>(m_nextTileID++, chain_id, *this);
       job->setCallback(m_callback);
-      jobQueue->add(job, false);
+      m_threadPool->submit(job);
    }
-
-   // Initialize the multi-thread queue. Note the setJobQueue is done after construction as it was 
-   // crashing do to jobs being launched during init:
-   m_jobMtQueue = std::make_shared<ossimJobMultiThreadQueue>(nullptr, num_jobs_to_launch);
-   m_jobMtQueue->setJobQueue(jobQueue);
 }
 
 
@@ -336,12 +339,17 @@ void ossimMultiThreadSequencer::setNumberOfThreads(ossim_uint32 num_threads)
    if (m_inputChain.valid())
       m_inputChain->setNumberOfThreads(num_threads);
 
-   if (m_jobMtQueue && m_jobMtQueue->hasJobsToProcess())
-      m_jobMtQueue->getJobQueue()->clear();
+   if (m_threadPool)
+      m_threadPool->clear();
 
    m_nextTileID = 0; // effectively resets this sequencer
 }
 
+void ossimMultiThreadSequencer::setPinThreads(bool pin_threads)
+{
+   m_pinThreads = pin_threads;
+}
+
 void ossimMultiThreadSequencer::setUseSharedHandlers(bool use_shared_handlers)
 {
    d_useSharedHandlers = use_shared_handlers;
@@ -451,7 +459,7 @@ void ossimMultiThreadSequencer::nextJob(ossim_uint32 chain_id)
 
    std::shared_ptr<ossimGetTileJob> job = std::make_shared<ossimGetTileJob>(m_nextTileID++, chain_id, *this);
    job->setCallback(m_callback);
-   m_jobMtQueue->getJobQueue()->add(job);
+   m_threadPool->submit(job);
 }
 
 //*************************************************************************************************
@@ -493,6 +501,11 @@ bool ossimMultiThreadSequencer::loadState(const ossimKeywordlist& kwl, const cha
       ossim_uint32 cache_tile_size = ossimString(lookup).toUInt32();
       setCacheTileSize(cache_tile_size);
    }
+   lookup = kwl.find(prefix, "pin_threads");
+   if(lookup)
+   {
+      setPinThreads(ossimString(lookup).toBool());
+   }
    lookup = kwl.find(prefix, "use_cache");
 
    if(lookup)
@@ -6,15 +6,20 @@
 //
 //**************************************************************************************************
 #include <ossim/point_cloud/ossimPointBlock.h>
+#include <algorithm>
 
 RTTI_DEF1(ossimPointBlock, "ossimPointBlock", ossimDataObject)
 
+// Field code of column 0, the others follow bit by bit:
+static const ossim_uint32 FIRST_FIELD = ossimPointRecord::Intensity;
+
 ossimPointBlock::ossimPointBlock(ossimSource* owner, ossim_uint32 fields)
 :  ossimDataObject(owner),
    m_nullPCR(fields),
    m_minMaxValid(false),
    m_fieldCode(0),
-   m_isNormalized(false)
+   m_isNormalized(false),
+   m_columnar(false)
 {
 }
 
@@ -54,6 +59,13 @@ void ossimPointBlock::getBounds(ossimGrect& block_bounds) const
 
 const ossimPointRecord* ossimPointBlock::getPoint(ossim_uint32 point_offset) const
 {
+   if (m_columnar)
+   {
+      if (point_offset >= size())
+         return 0;
+      makeRecordCache();
+      return m_recordCache[point_offset].get();
+   }
    if (point_offset < m_pointList.size())
       return m_pointList[point_offset].get();
    return 0;
@@ -61,25 +73,53 @@ const ossimPointRecord* ossimPointBlock::getPoint(ossim_uint32 point_offset) con
 
 ossimPointRecord* ossimPointBlock::getPoint(ossim_uint32 point_offset)
 {
+   makeRecords();
    if (point_offset < m_pointList.size())
       return m_pointList[point_offset].get();
    return 0;
 }
 
+const ossimPointBlock::PointList& ossimPointBlock::getPoints() const
+{
+   if (m_columnar)
+   {
+      makeRecordCache();
+      return m_recordCache;
+   }
+   return m_pointList;
+}
+
+ossimPointBlock::PointList& ossimPointBlock::getPoints()
+{
+   makeRecords();
+   return m_pointList;
+}
+
 const ossimPointBlock& ossimPointBlock::operator=(const ossimPointBlock& block )
 {
    ossim_uint32 numPoints = block.size();
    if (numPoints == 0)
       return *this;
 
-   for (ossim_uint32 i=0; i<numPoints; ++i)
-      m_pointList.push_back(new ossimPointRecord(*(block[i])));
+   if (empty())
+   {
+      m_columnar = block.m_columnar;
+      m_fieldCode = block.getFieldCode();
+   }
+
+   if (m_columnar || block.m_columnar)
+      addPoints(block, 0, numPoints);
+   else
+   {
+      for (ossim_uint32 i=0; i<numPoints; ++i)
+         m_pointList.push_back(new ossimPointRecord(*(block[i])));
+      m_fieldCode = block.m_fieldCode;
+   }
 
    m_nullPCR = block.m_nullPCR;
    m_minRecord = block.m_minRecord;
    m_maxRecord = block.m_maxRecord;
    m_minMaxValid = block.m_minMaxValid;
-   m_fieldCode = block.m_fieldCode;
    m_isNormalized = block.m_isNormalized;
 
    return *this;
@@ -94,7 +134,7 @@ ossimObject* ossimPointBlock::dup() const
 
 ossim_uint32 ossimPointBlock::getFieldCode() const
 {
-   if (!m_pointList.empty())
+   if (!m_columnar && !m_pointList.empty())
       m_fieldCode = m_pointList[0]->getFieldCode();
 
    return m_fieldCode;
@@ -130,18 +170,359 @@ void ossimPointBlock::setFieldCode(ossim_uint32 code)
    m_fieldCode = code;
 }
 
+void ossimPointBlock::clear()
+{
+   m_pointList.clear();
+   m_recordCache.clear();
+   m_lat.clear();
+   m_lon.clear();
+   m_hgt.clear();
+   m_ids.clear();
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+      m_fields[f].clear();
+   m_isNormalized = false;
+   m_minMaxValid = false;
+}
+
+void ossimPointBlock::setColumnar(bool columnar)
+{
+   if (columnar == m_columnar)
+      return;
+
+   if (!columnar)
+   {
+      makeRecords();
+      return;
+   }
+
+   PointList points;
+   points.swap(m_pointList);
+   if (!points.empty())
+      m_fieldCode = points[0]->getFieldCode();
+   m_columnar = true;
+   reserve((ossim_uint32) points.size());
+   for (ossim_uint32 i=0; i<points.size(); ++i)
+      addPoint(points[i].get());
+}
+
+void ossimPointBlock::reserve(ossim_uint32 numPoints)
+{
+   if (!m_columnar)
+   {
+      m_pointList.reserve(numPoints);
+      return;
+   }
+
+   m_lat.reserve(numPoints);
+   m_lon.reserve(numPoints);
+   m_hgt.reserve(numPoints);
+   m_ids.reserve(numPoints);
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      if (m_fieldCode & (FIRST_FIELD << f))
+         m_fields[f].reserve(numPoints);
+   }
+}
+
 void ossimPointBlock::addPoint(ossimPointRecord* opr)
 {
-   // First check that the fields match the expected. If not, sync up to this point:
-   if ((opr->getFieldCode() & m_fieldCode) != m_fieldCode)
+   if (!m_columnar)
+   {
+      // First check that the fields match the expected. If not, sync up to this point:
+      if ((opr->getFieldCode() & m_fieldCode) != m_fieldCode)
+         m_fieldCode = opr->getFieldCode();
+
+      m_pointList.push_back(ossimRefPtr<ossimPointRecord>(opr));
+      m_minMaxValid = false;
+      return;
+   }
+
+   // The values are copied, a record handed over is released on return:
+   ossimRefPtr<ossimPointRecord> point (opr);
+   if (empty() && ((opr->getFieldCode() & m_fieldCode) != m_fieldCode))
       m_fieldCode = opr->getFieldCode();
 
-   m_pointList.push_back(ossimRefPtr<ossimPointRecord>(opr));
+   ossim_uint32 i = size();
+   addPoint(opr->getPosition(), opr->getPointId());
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      ossim_uint32 code = FIRST_FIELD << f;
+      if (m_fieldCode & code)
+         m_fields[f][i] = opr->getField((ossimPointRecord::FIELD_CODES) code);
+   }
+}
+
+void ossimPointBlock::addPoint(const ossimGpt& position, ossim_uint32 pointId)
+{
+   if (!m_columnar)
+   {
+      ossimPointRecord* point = new ossimPointRecord(m_fieldCode);
+      point->setPosition(position);
+      point->setPointId(pointId);
+      addPoint(point);
+      return;
+   }
+
+   m_lat.push_back(position.lat);
+   m_lon.push_back(position.lon);
+   m_hgt.push_back(position.hgt);
+   m_ids.push_back(pointId);
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      if (m_fieldCode & (FIRST_FIELD << f))
+         m_fields[f].push_back(ossim::nan());
+   }
+   m_minMaxValid = false;
+}
+
+void ossimPointBlock::addPoints(const ossimPointBlock& source,
+                                ossim_uint32 offset,
+                                ossim_uint32 count)
+{
+   ossim_uint32 sourceSize = source.size();
+   if (offset >= sourceSize)
+      return;
+   count = std::min(count, sourceSize - offset);
+
+   if (!m_columnar || !source.m_columnar)
+   {
+      for (ossim_uint32 i=offset; i<offset+count; ++i)
+      {
+         if (source.m_columnar)
+            addPoint(source.makeRecord(i));
+         else // Shared, as the legacy getBlock() always did
+            addPoint(const_cast<ossimPointRecord*>(source.m_pointList[i].get()));
+      }
+      return;
+   }
+
+   if (empty() && ((source.m_fieldCode & m_fieldCode) != m_fieldCode))
+      m_fieldCode = source.m_fieldCode;
+
+   ossim_uint32 start = size();
+   ossim_uint32 end = offset + count;
+   m_lat.insert(m_lat.end(), source.m_lat.begin() + offset, source.m_lat.begin() + end);
+   m_lon.insert(m_lon.end(), source.m_lon.begin() + offset, source.m_lon.begin() + end);
+   m_hgt.insert(m_hgt.end(), source.m_hgt.begin() + offset, source.m_hgt.begin() + end);
+   m_ids.insert(m_ids.end(), source.m_ids.begin() + offset, source.m_ids.begin() + end);
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      ossim_uint32 code = FIRST_FIELD << f;
+      if (!(m_fieldCode & code))
+         continue;
+      if (source.m_fieldCode & code)
+      {
+         m_fields[f].insert(m_fields[f].end(),
+                            source.m_fields[f].begin() + offset,
+                            source.m_fields[f].begin() + end);
+      }
+      else
+         m_fields[f].resize(start + count, ossim::nan());
+   }
+   m_minMaxValid = false;
+}
+
+ossimGpt ossimPointBlock::getPosition(ossim_uint32 i) const
+{
+   if (m_columnar)
+      return ossimGpt(m_lat[i], m_lon[i], m_hgt[i]);
+   return m_pointList[i]->getPosition();
+}
+
+ossim_float32 ossimPointBlock::getField(ossim_uint32 i, ossimPointRecord::FIELD_CODES fc) const
+{
+   if (!m_columnar)
+      return m_pointList[i]->getField(fc);
+   if (m_fieldCode & fc)
+      return m_fields[fieldIndex(fc)][i];
+   return ossim::nan();
+}
+
+void ossimPointBlock::setField(ossim_uint32 i,
+                               ossimPointRecord::FIELD_CODES fc,
+                               ossim_float32 value)
+{
    m_minMaxValid = false;
+   if (!m_columnar)
+   {
+      m_pointList[i]->setField(fc, value);
+      return;
+   }
+
+   if (!(m_fieldCode & fc))
+   {
+      m_fieldCode |= fc;
+      resizeColumns();
+   }
+   m_fields[fieldIndex(fc)][i] = value;
+   m_recordCache.clear();
+}
+
+const ossim_float64* ossimPointBlock::getLatitudes() const
+{
+   return m_columnar ? m_lat.data() : 0;
+}
+
+const ossim_float64* ossimPointBlock::getLongitudes() const
+{
+   return m_columnar ? m_lon.data() : 0;
+}
+
+const ossim_float64* ossimPointBlock::getHeights() const
+{
+   return m_columnar ? m_hgt.data() : 0;
+}
+
+const ossim_uint32* ossimPointBlock::getPointIds() const
+{
+   return m_columnar ? m_ids.data() : 0;
+}
+
+const ossim_float32* ossimPointBlock::getFieldValues(ossimPointRecord::FIELD_CODES fc) const
+{
+   if (m_columnar && (m_fieldCode & fc))
+      return m_fields[fieldIndex(fc)].data();
+   return 0;
+}
+
+ossim_uint32 ossimPointBlock::fieldIndex(ossimPointRecord::FIELD_CODES fc)
+{
+   ossim_uint32 index = 0;
+   for (ossim_uint32 code = fc / FIRST_FIELD; code > 1; code >>= 1)
+      ++index;
+   return index;
+}
+
+void ossimPointBlock::resizeColumns()
+{
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      if (m_fieldCode & (FIRST_FIELD << f))
+         m_fields[f].resize(m_lat.size(), ossim::nan());
+      else
+         m_fields[f].clear();
+   }
+}
+
+ossimPointRecord* ossimPointBlock::makeRecord(ossim_uint32 i) const
+{
+   ossimPointRecord* point = new ossimPointRecord(m_fieldCode);
+   point->setPosition(ossimGpt(m_lat[i], m_lon[i], m_hgt[i]));
+   point->setPointId(m_ids[i]);
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      ossim_uint32 code = FIRST_FIELD << f;
+      if (m_fieldCode & code)
+         point->setField((ossimPointRecord::FIELD_CODES) code, m_fields[f][i]);
+   }
+   return point;
+}
+
+void ossimPointBlock::makeRecordCache() const
+{
+   // Readers of a const block may be on several threads, the first one fills the cache:
+   std::lock_guard<std::mutex> lock (m_recordCacheMutex);
+   ossim_uint32 numPoints = size();
+   m_recordCache.reserve(numPoints);
+   for (ossim_uint32 i=(ossim_uint32)m_recordCache.size(); i<numPoints; ++i)
+      m_recordCache.push_back(makeRecord(i));
+}
+
+void ossimPointBlock::makeRecords()
+{
+   if (!m_columnar)
+      return;
+
+   PointList points;
+   points.reserve(size());
+   for (ossim_uint32 i=0; i<size(); ++i)
+      points.push_back(makeRecord(i));
+
+   bool isNormalized = m_isNormalized;
+   bool minMaxValid = m_minMaxValid;
+   clear();
+   m_isNormalized = isNormalized;
+   m_minMaxValid = minMaxValid;
+   m_columnar = false;
+   m_pointList.swap(points);
+}
+
+void ossimPointBlock::scanColumnsForMinMax() const
+{
+   ossim_uint32 numPoints = size();
+   if (numPoints == 0)
+      return;
+
+   ossimGpt minPos (m_lat[0], m_lon[0], m_hgt[0]);
+   ossimGpt maxPos (minPos);
+   for (ossim_uint32 i=1; i<numPoints; ++i)
+   {
+      if (m_lat[i] < minPos.lat) minPos.lat = m_lat[i];
+      if (m_lon[i] < minPos.lon) minPos.lon = m_lon[i];
+      if (m_hgt[i] < minPos.hgt) minPos.hgt = m_hgt[i];
+      if (m_lat[i] > maxPos.lat) maxPos.lat = m_lat[i];
+      if (m_lon[i] > maxPos.lon) maxPos.lon = m_lon[i];
+      if (m_hgt[i] > maxPos.hgt) maxPos.hgt = m_hgt[i];
+   }
+
+   const ossim_uint32 RGB =
+      ossimPointRecord::Red | ossimPointRecord::Green | ossimPointRecord::Blue;
+   bool hasRGB = ((m_fieldCode & RGB) == RGB);
+
+   m_minRecord = ossimPointRecord(m_fieldCode);
+   m_maxRecord = ossimPointRecord(m_fieldCode);
+   for (ossim_uint32 f=0; f<NUM_FIELDS; ++f)
+   {
+      ossim_uint32 code = FIRST_FIELD << f;
+      if (!(m_fieldCode & code) || (hasRGB && (code & RGB)))
+         continue;
+
+      const std::vector<ossim_float32>& column = m_fields[f];
+      ossim_float32 minValue = column[0];
+      ossim_float32 maxValue = column[0];
+      for (ossim_uint32 i=1; i<numPoints; ++i)
+      {
+         if (column[i] < minValue) minValue = column[i];
+         if (column[i] > maxValue) maxValue = column[i];
+      }
+      m_minRecord.setField((ossimPointRecord::FIELD_CODES) code, minValue);
+      m_maxRecord.setField((ossimPointRecord::FIELD_CODES) code, maxValue);
+   }
+
+   // Color bands latch as one to minimize color distortion:
+   if (hasRGB)
+   {
+      const ossim_float32* r = m_fields[fieldIndex(ossimPointRecord::Red)].data();
+      const ossim_float32* g = m_fields[fieldIndex(ossimPointRecord::Green)].data();
+      const ossim_float32* b = m_fields[fieldIndex(ossimPointRecord::Blue)].data();
+      ossim_float32 minC = std::min(r[0], std::min(g[0], b[0]));
+      ossim_float32 maxC = std::max(r[0], std::max(g[0], b[0]));
+      for (ossim_uint32 i=1; i<numPoints; ++i)
+      {
+         minC = std::min(minC, std::min(r[i], std::min(g[i], b[i])));
+         maxC = std::max(maxC, std::max(r[i], std::max(g[i], b[i])));
+      }
+      m_minRecord.setField(ossimPointRecord::Red,   minC);
+      m_minRecord.setField(ossimPointRecord::Green, minC);
+      m_minRecord.setField(ossimPointRecord::Blue,  minC);
+      m_maxRecord.setField(ossimPointRecord::Red,   maxC);
+      m_maxRecord.setField(ossimPointRecord::Green, maxC);
+      m_maxRecord.setField(ossimPointRecord::Blue,  maxC);
+   }
+
+   m_minRecord.setPosition(minPos);
+   m_maxRecord.setPosition(maxPos);
+   m_minMaxValid = true;
 }
 
 void ossimPointBlock::scanForMinMax() const
 {
+   if (m_columnar)
+   {
+      scanColumnsForMinMax();
+      return;
+   }
+
    ossim_uint32 numPoints = size();
    if (numPoints == 0)
       return;
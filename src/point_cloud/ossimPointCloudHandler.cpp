@@ -8,11 +8,15 @@
 // $Id$
 
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <algorithm>
 
 RTTI_DEF1(ossimPointCloudHandler, "ossimPointCloudHandler" , ossimPointCloudSource);
 
 ossim_uint32 ossimPointCloudHandler::DEFAULT_BLOCK_SIZE = 0x400000;
 
+// Index hits closer than this many points in the file are read as one run, cheaper than a seek.
+static const ossim_uint32 MAX_INDEX_GAP = 256;
+
 ossimPointCloudHandler::ossimPointCloudHandler()
 :  m_currentPID(0)
 {
@@ -39,30 +43,94 @@ void ossimPointCloudHandler::getBlock(const ossimGrect& bounds, ossimPointBlock&
 {
    block.clear();
 
+   ossimRefPtr<const ossimPointCloudIndex> index = getIndex();
+   if (index.valid())
+   {
+      // Read only the runs of points in the cells overlapping the bounds:
+      std::vector<ossim_uint32> ids;
+      index->getPointIds(bounds, ids);
+      ossimPointBlock file_block;
+      file_block.setFieldCode(block.getFieldCode());
+      file_block.setColumnar(block.isColumnar());
+      std::vector<ossim_uint32>::const_iterator id = ids.begin();
+      while (id != ids.end())
+      {
+         ossim_uint32 start = *id;
+         ossim_uint32 end = start;
+         while ((++id != ids.end()) && (*id - end <= MAX_INDEX_GAP))
+            end = *id;
+
+         file_block.clear();
+         getFileBlock(start, file_block, end - start + 1);
+
+         // Not all handlers honor maxNumPoints:
+         ossim_uint32 count = std::min(file_block.size(), end - start + 1);
+         for (ossim_uint32 i=0; i<count; ++i)
+         {
+            if (bounds.pointWithin(file_block.getPosition(i)))
+               block.addPoints(file_block, i, 1);
+         }
+      }
+      return;
+   }
+
    // This default implementation simply reads the whole datafile in file-blocks, retaining
-   // only those points inside the bounds:
+   // only those points inside the bounds. The file blocks use the storage of the caller's block.
    ossimPointBlock file_block;
+   file_block.setFieldCode(block.getFieldCode());
+   file_block.setColumnar(block.isColumnar());
    rewind();
-   ossimGpt gpt;
 
    do
    {
       file_block.clear();
       getNextFileBlock(file_block, DEFAULT_BLOCK_SIZE);
-      ossimPointBlock::PointList& pointList = file_block.getPoints();
-      ossimPointBlock::PointList::iterator iter = pointList.begin();
-      while (iter != pointList.end())
+      ossim_uint32 numPoints = file_block.size();
+      for (ossim_uint32 i=0; i<numPoints; ++i)
       {
-         gpt = (*iter)->getPosition();
-         if (bounds.pointWithin(gpt))
-         {
-            block.addPoint(iter->get());
-         }
-         ++iter;
+         if (bounds.pointWithin(file_block.getPosition(i)))
+            block.addPoints(file_block, i, 1);
       }
    } while (file_block.size() == DEFAULT_BLOCK_SIZE);
 }
 
+bool ossimPointCloudHandler::buildIndex(ossim_uint32 pointsPerCell)
+{
+   if (m_inputFilename.empty())
+      return false;
+
+   std::lock_guard<std::mutex> lock (m_indexMutex);
+   m_index = 0;
+   m_indexedFilename = m_inputFilename;
+   ossimFilename indexFile = ossimPointCloudIndex::getIndexFilename(m_inputFilename);
+   if (!ossimPointCloudIndex::build(*this, m_inputFilename, indexFile, pointsPerCell))
+      return false;
+
+   ossimRefPtr<ossimPointCloudIndex> index = new ossimPointCloudIndex;
+   if (!index->open(indexFile, m_inputFilename, getNumPoints()))
+      return false;
+   m_index = index;
+   return true;
+}
+
+ossimRefPtr<const ossimPointCloudIndex> ossimPointCloudHandler::getIndex() const
+{
+   std::lock_guard<std::mutex> lock (m_indexMutex);
+   if (m_indexedFilename != m_inputFilename)
+   {
+      m_index = 0;
+      m_indexedFilename = m_inputFilename;
+      ossimFilename indexFile = ossimPointCloudIndex::getIndexFilename(m_inputFilename);
+      if (!m_inputFilename.empty() && indexFile.exists())
+      {
+         ossimRefPtr<ossimPointCloudIndex> index = new ossimPointCloudIndex;
+         if (index->open(indexFile, m_inputFilename, getNumPoints()))
+            m_index = index;
+      }
+   }
+   return ossimRefPtr<const ossimPointCloudIndex>(m_index.get());
+}
+
 void ossimPointCloudHandler::getBounds(ossimGrect& bounds) const
 {
    if (m_minRecord.valid() && m_maxRecord.valid())
@@ -83,16 +151,15 @@ void ossimPointCloudHandler::normalizeBlock(ossimPointBlock& block)
    ossimPointRecord::FIELD_CODES field_code;
    for (ossim_uint32 i=0; i<numPoints; ++i)
    {
-      ossimPointRecord* opr = block[i];
       iter = field_codes.begin();
       while (iter != field_codes.end())
       {
          field_code = *iter;
          min = m_minRecord->getField(field_code);
          max = m_maxRecord->getField(field_code);
-         val = opr->getField(field_code);
+         val = block.getField(i, field_code);
          norm = (val - min) / (max - min);
-         opr->setField(field_code, norm);
+         block.setField(i, field_code, norm);
          ++iter;
       }
    }
@@ -259,9 +259,11 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
    }
    std::map<ossim_int32, PcrBucket*> accumulator;
 
-   // initialize a point block with desired fields as requested in the reader properties
+   // initialize a point block with desired fields as requested in the reader properties. Columnar
+   // storage avoids a record object per point and lets the loops below read the arrays directly.
    ossimPointBlock pointBlock (this);
    pointBlock.setFieldCode(componentToFieldCode());
+   pointBlock.setColumnar(true);
    m_pch->rewind();
 
    ossimDpt ipt;
@@ -270,16 +272,22 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
 #define USE_GETBLOCK
 #ifdef USE_GETBLOCK
    m_pch->getBlock(gnd_rect, pointBlock);
+   pointBlock.setColumnar(true); // in case the handler asked for records
+   const ossim_float64* lat = pointBlock.getLatitudes();
+   const ossim_float64* lon = pointBlock.getLongitudes();
+   const ossim_float64* hgt = pointBlock.getHeights();
    for (ossim_uint32 id=0; id<pointBlock.size(); ++id)
    {
-      pos = pointBlock[id]->getPosition();
+      pos.lat = lat[id];
+      pos.lon = lon[id];
+      pos.hgt = hgt[id];
       theGeometry->worldToRn(pos, resLevel, ipt);
       ipt.x = ossim::round<double,double>(ipt.x) - tile_offset.x;
       ipt.y = ossim::round<double,double>(ipt.y) - tile_offset.y;
 
       ossim_int32 bucketIndex = ipt.y*tile_width + ipt.x;
       if ((bucketIndex >= 0) && (bucketIndex < (ossim_int32)tile_size))
-         addSample(accumulator, bucketIndex, pointBlock[id]);
+         addSample(accumulator, bucketIndex, pointBlock, id);
    }
 
 #else // using getFileBlock
@@ -293,11 +301,12 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
       pointBlock.clear();
       m_pch->getNextFileBlock(pointBlock, numPoints);
       //m_pch->normalizeBlock(pointBlock);
+      pointBlock.setColumnar(true);
 
       for (ossim_uint32 id=0; id<pointBlock.size(); ++id)
       {
          // Check that each point in read block is inside the ROI before accumulating it:
-         pos = pointBlock[id]->getPosition();
+         pos = pointBlock.getPosition(id);
          if (gnd_rect.pointWithin(pos))
          {
             theGeometry->worldToRn(pos, resLevel, ipt);
@@ -306,7 +315,7 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
 
             ossim_int32 bucketIndex = ipt.y*tile_width + ipt.x;
             if ((bucketIndex >= 0) && (bucketIndex < (ossim_int32)tile_size))
-               addSample(accumulator, bucketIndex, pointBlock[id]);
+               addSample(accumulator, bucketIndex, pointBlock, id);
          }
       }
    } while (pointBlock.size() == numPoints);
@@ -353,12 +362,10 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
 
 void ossimPointCloudImageHandler::addSample(std::map<ossim_int32, PcrBucket*>& accumulator,
                                             ossim_int32 index,
-                                            const ossimPointRecord* sample)
+                                            const ossimPointBlock& block,
+                                            ossim_uint32 i)
 {
-   if (sample == 0)
-      return;
-
-   //cout << "sample: "<<*sample<<endl;//TODO: REMOVE DEBUG
+   const ossim_float64 hgt = block.getHeights()[i];
 
    // Search map for exisiting point in that location:
    auto iter = accumulator.find(index);
@@ -367,20 +374,20 @@ void ossimPointCloudImageHandler::addSample(std::map<ossim_int32, PcrBucket*>& a
       // First hit. Initialize location with current sample:
       if (m_activeComponent == INTENSITY)
       {
-         accumulator[index] = new PcrBucket(sample->getField(ossimPointRecord::Intensity));
+         accumulator[index] = new PcrBucket(block.getField(i, ossimPointRecord::Intensity));
       }
       else if (m_activeComponent == RGB)
       {
          ossim_float32 color[3];
-         color[0] = sample->getField(ossimPointRecord::Red);
-         color[1] = sample->getField(ossimPointRecord::Green);
-         color[2] = sample->getField(ossimPointRecord::Blue);
+         color[0] = block.getField(i, ossimPointRecord::Red);
+         color[1] = block.getField(i, ossimPointRecord::Green);
+         color[2] = block.getField(i, ossimPointRecord::Blue);
          accumulator[index] = new PcrBucket(color, 3);
       }
       else if ((m_activeComponent == LOWEST) || (m_activeComponent == HIGHEST))
-         accumulator[index] = new PcrBucket(sample->getPosition().hgt);
+         accumulator[index] = new PcrBucket(hgt);
       else if (m_activeComponent == RETURNS)
-         accumulator[index] = new PcrBucket(sample->getField(ossimPointRecord::NumberOfReturns));
+         accumulator[index] = new PcrBucket(block.getField(i, ossimPointRecord::NumberOfReturns));
    }
    else
    {
@@ -388,22 +395,22 @@ void ossimPointCloudImageHandler::addSample(std::map<ossim_int32, PcrBucket*>& a
       // First hit. Initialize location with current sample:
       if (m_activeComponent == INTENSITY)
       {
-         iter->second->m_bucket[0] += sample->getField(ossimPointRecord::Intensity);
+         iter->second->m_bucket[0] += block.getField(i, ossimPointRecord::Intensity);
       }
       else if (m_activeComponent == RGB)
       {
-         iter->second->m_bucket[0] += sample->getField(ossimPointRecord::Red);
-         iter->second->m_bucket[1] += sample->getField(ossimPointRecord::Green);
-         iter->second->m_bucket[2] += sample->getField(ossimPointRecord::Blue);
+         iter->second->m_bucket[0] += block.getField(i, ossimPointRecord::Red);
+         iter->second->m_bucket[1] += block.getField(i, ossimPointRecord::Green);
+         iter->second->m_bucket[2] += block.getField(i, ossimPointRecord::Blue);
       }
       else if ((m_activeComponent == HIGHEST) &&
-            (sample->getPosition().hgt > iter->second->m_bucket[0]))
-         iter->second->m_bucket[0] = sample->getPosition().hgt;
+            (hgt > iter->second->m_bucket[0]))
+         iter->second->m_bucket[0] = hgt;
       else if ((m_activeComponent == LOWEST) &&
-            (sample->getPosition().hgt < iter->second->m_bucket[0]))
-         iter->second->m_bucket[0] = sample->getPosition().hgt;
+            (hgt < iter->second->m_bucket[0]))
+         iter->second->m_bucket[0] = hgt;
       else if (m_activeComponent == RETURNS)
-         iter->second->m_bucket[0] += sample->getField(ossimPointRecord::NumberOfReturns);
+         iter->second->m_bucket[0] += block.getField(i, ossimPointRecord::NumberOfReturns);
 
       iter->second->m_numSamples++;
    }
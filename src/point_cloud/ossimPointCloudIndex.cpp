@@ -0,0 +1,297 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/base/ossimNotify.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+ossim_uint32 ossimPointCloudIndex::DEFAULT_POINTS_PER_CELL = 4096;
+
+static const char         INDEX_MAGIC[8] = { 'O', 'S', 'S', 'I', 'M', 'P', 'C', 'I' };
+static const ossim_uint32 INDEX_VERSION = 1;
+static const ossim_uint32 INDEX_BYTE_ORDER = 0x01020304;
+
+// Largest grid side, keeps the offset table sane for degenerate extents.
+static const ossim_uint32 MAX_GRID_SIZE = 0x10000;
+
+namespace
+{
+   /** Cell holding value along one axis, clamped to the grid. NaN goes to cell 0. */
+   ossim_uint32 toCell(double value, double minValue, double scale, ossim_uint32 count)
+   {
+      double c = (value - minValue) * scale;
+      if (!(c >= 0.0))
+         return 0;
+      if (c >= count)
+         return count - 1;
+      return static_cast<ossim_uint32>(c);
+   }
+
+   /** Visits the first numPoints points of the handler in file order. */
+   void forEachPoint(const ossimPointCloudHandler& handler,
+                     ossim_uint32 numPoints,
+                     const std::function<void(ossim_uint32, const ossimGpt&)>& visit)
+   {
+      ossimPointBlock block;
+      block.setColumnar(true);
+      ossim_uint32 offset = 0;
+      while (offset < numPoints)
+      {
+         ossim_uint32 maxPoints = std::min(ossimPointCloudHandler::DEFAULT_BLOCK_SIZE,
+                                           numPoints - offset);
+         block.clear();
+         handler.getFileBlock(offset, block, maxPoints);
+         if (block.empty())
+            break;
+
+         // Not all handlers honor maxNumPoints.
+         ossim_uint32 count = std::min(block.size(), numPoints - offset);
+         for (ossim_uint32 i=0; i<count; ++i)
+            visit(offset + i, block.getPosition(i));
+         offset += count;
+      }
+   }
+}
+
+ossimPointCloudIndex::ossimPointCloudIndex()
+:  m_map(),
+   m_header(0),
+   m_cellOffsets(0),
+   m_pointIds(0)
+{
+}
+
+ossimPointCloudIndex::~ossimPointCloudIndex()
+{
+   close();
+}
+
+ossimFilename ossimPointCloudIndex::getIndexFilename(const ossimFilename& pointCloudFile)
+{
+   ossimFilename indexFile = pointCloudFile;
+   indexFile.setExtension(ossimString("pci"));
+   return indexFile;
+}
+
+bool ossimPointCloudIndex::build(const ossimPointCloudHandler& handler,
+                                 const ossimFilename& pointCloudFile,
+                                 const ossimFilename& indexFile,
+                                 ossim_uint32 pointsPerCell)
+{
+   ossim_uint32 numPoints = handler.getNumPoints();
+   if (numPoints == 0)
+      return false;
+   if (pointsPerCell == 0)
+      pointsPerCell = DEFAULT_POINTS_PER_CELL;
+
+   // Extent, scanned when the handler does not carry it:
+   double minLon, minLat, maxLon, maxLat;
+   ossimGrect bounds;
+   handler.getBounds(bounds);
+   if (!bounds.hasNans())
+   {
+      minLon = std::min(bounds.ul().lon, bounds.lr().lon);
+      maxLon = std::max(bounds.ul().lon, bounds.lr().lon);
+      minLat = std::min(bounds.ul().lat, bounds.lr().lat);
+      maxLat = std::max(bounds.ul().lat, bounds.lr().lat);
+   }
+   else
+   {
+      minLon = minLat = ossim::nan();
+      maxLon = maxLat = ossim::nan();
+      forEachPoint(handler, numPoints, [&](ossim_uint32, const ossimGpt& gpt)
+      {
+         if (gpt.isLatNan() || gpt.isLonNan())
+            return;
+         if (!(gpt.lon >= minLon)) minLon = gpt.lon;
+         if (!(gpt.lon <= maxLon)) maxLon = gpt.lon;
+         if (!(gpt.lat >= minLat)) minLat = gpt.lat;
+         if (!(gpt.lat <= maxLat)) maxLat = gpt.lat;
+      });
+      if (ossim::isnan(minLon) || ossim::isnan(minLat))
+         return false;
+   }
+
+   // Grid about pointsPerCell points per cell, cells roughly square in degrees:
+   double width  = maxLon - minLon;
+   double height = maxLat - minLat;
+   double cells  = std::max(1.0, static_cast<double>(numPoints) / pointsPerCell);
+   ossim_uint32 cols = 1;
+   ossim_uint32 rows = 1;
+   if ((width > 0.0) && (height > 0.0))
+   {
+      cols = static_cast<ossim_uint32>(
+         std::min<double>(MAX_GRID_SIZE, std::max(1.0, std::floor(std::sqrt(cells * width / height) + 0.5))));
+      rows = static_cast<ossim_uint32>(
+         std::min<double>(MAX_GRID_SIZE, std::max(1.0, std::ceil(cells / cols))));
+   }
+   else if (width > 0.0)
+      cols = static_cast<ossim_uint32>(std::min<double>(MAX_GRID_SIZE, cells));
+   else if (height > 0.0)
+      rows = static_cast<ossim_uint32>(std::min<double>(MAX_GRID_SIZE, cells));
+
+   double colScale = (width > 0.0) ? cols / width : 0.0;
+   double rowScale = (height > 0.0) ? rows / height : 0.0;
+   // Both sides may reach MAX_GRID_SIZE, the cell count needs 64 bits:
+   ossim_uint64 numCells = static_cast<ossim_uint64>(cols) * rows;
+
+   // Bucket the points, counting sort by cell keeps ids ascending within a cell:
+   std::vector<ossim_uint64> cellOf(numPoints, 0);
+   std::vector<ossim_uint64> offsets(numCells + 1, 0);
+   forEachPoint(handler, numPoints, [&](ossim_uint32 id, const ossimGpt& gpt)
+   {
+      ossim_uint64 cell = static_cast<ossim_uint64>(toCell(gpt.lat, minLat, rowScale, rows)) * cols +
+                          toCell(gpt.lon, minLon, colScale, cols);
+      cellOf[id] = cell;
+      ++offsets[cell + 1];
+   });
+   for (ossim_uint64 cell=0; cell<numCells; ++cell)
+      offsets[cell + 1] += offsets[cell];
+
+   std::vector<ossim_uint64> next(offsets.begin(), offsets.end() - 1);
+   std::vector<ossim_uint32> ids(numPoints);
+   for (ossim_uint32 id=0; id<numPoints; ++id)
+      ids[next[cellOf[id]]++] = id;
+
+   Header header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.m_magic, INDEX_MAGIC, sizeof(header.m_magic));
+   header.m_version    = INDEX_VERSION;
+   header.m_byteOrder  = INDEX_BYTE_ORDER;
+   header.m_numPoints  = numPoints;
+   header.m_sourceSize = static_cast<ossim_uint64>(std::max<ossim_int64>(0, pointCloudFile.fileSize()));
+   header.m_cols       = cols;
+   header.m_rows       = rows;
+   header.m_minLon     = minLon;
+   header.m_minLat     = minLat;
+   header.m_maxLon     = maxLon;
+   header.m_maxLat     = maxLat;
+
+   std::ofstream out(indexFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+   if (!out)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimPointCloudIndex::build ERR: Cannot write <" << indexFile << ">" << std::endl;
+      return false;
+   }
+   out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+   out.write(reinterpret_cast<const char*>(&offsets.front()), offsets.size() * sizeof(ossim_uint64));
+   out.write(reinterpret_cast<const char*>(&ids.front()), ids.size() * sizeof(ossim_uint32));
+   out.close();
+   if (!out)
+   {
+      indexFile.remove();
+      return false;
+   }
+   return true;
+}
+
+bool ossimPointCloudIndex::open(const ossimFilename& indexFile,
+                                const ossimFilename& pointCloudFile,
+                                ossim_uint32 numPoints)
+{
+   close();
+   if (!m_map.open(indexFile.string()) || (m_map.size() < sizeof(Header)))
+   {
+      m_map.close();
+      return false;
+   }
+
+   const Header* header = reinterpret_cast<const Header*>(m_map.data());
+   ossim_uint64 numCells = static_cast<ossim_uint64>(header->m_cols) * header->m_rows;
+   ossim_uint64 expectedSize = sizeof(Header) + (numCells + 1) * sizeof(ossim_uint64) +
+                               header->m_numPoints * sizeof(ossim_uint32);
+   ossim_int64 sourceSize = pointCloudFile.fileSize();
+   bool valid = (memcmp(header->m_magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0) &&
+                (header->m_version == INDEX_VERSION) &&
+                (header->m_byteOrder == INDEX_BYTE_ORDER) &&
+                (numCells > 0) &&
+                (header->m_numPoints == numPoints) &&
+                ((sourceSize <= 0) || (header->m_sourceSize == static_cast<ossim_uint64>(sourceSize))) &&
+                (m_map.size() == expectedSize);
+   if (valid)
+   {
+      const ossim_uint64* offsets = reinterpret_cast<const ossim_uint64*>(header + 1);
+      valid = (offsets[numCells] == header->m_numPoints);
+      if (valid)
+      {
+         m_header = header;
+         m_cellOffsets = offsets;
+         m_pointIds = reinterpret_cast<const ossim_uint32*>(offsets + numCells + 1);
+      }
+   }
+   if (!valid)
+      m_map.close();
+   return valid;
+}
+
+void ossimPointCloudIndex::close()
+{
+   m_header = 0;
+   m_cellOffsets = 0;
+   m_pointIds = 0;
+   m_map.close();
+}
+
+void ossimPointCloudIndex::getPointIds(const ossimGrect& bounds,
+                                       std::vector<ossim_uint32>& ids) const
+{
+   ids.clear();
+   if (!m_header)
+      return;
+
+   double minLon = std::min(bounds.ul().lon, bounds.lr().lon);
+   double maxLon = std::max(bounds.ul().lon, bounds.lr().lon);
+   double minLat = std::min(bounds.ul().lat, bounds.lr().lat);
+   double maxLat = std::max(bounds.ul().lat, bounds.lr().lat);
+   if ((maxLon < m_header->m_minLon) || (minLon > m_header->m_maxLon) ||
+       (maxLat < m_header->m_minLat) || (minLat > m_header->m_maxLat))
+      return;
+
+   ossim_uint32 cols = m_header->m_cols;
+   ossim_uint32 rows = m_header->m_rows;
+   double width  = m_header->m_maxLon - m_header->m_minLon;
+   double height = m_header->m_maxLat - m_header->m_minLat;
+   double colScale = (width > 0.0) ? cols / width : 0.0;
+   double rowScale = (height > 0.0) ? rows / height : 0.0;
+
+   // NaN bounds fall to cell 0 at the low end and to the last cell at the high end:
+   ossim_uint32 col0 = toCell(minLon, m_header->m_minLon, colScale, cols);
+   ossim_uint32 row0 = toCell(minLat, m_header->m_minLat, rowScale, rows);
+   ossim_uint32 col1 = ossim::isnan(maxLon) ? cols - 1 :
+                       toCell(maxLon, m_header->m_minLon, colScale, cols);
+   ossim_uint32 row1 = ossim::isnan(maxLat) ? rows - 1 :
+                       toCell(maxLat, m_header->m_minLat, rowScale, rows);
+
+   for (ossim_uint32 row=row0; row<=row1; ++row)
+   {
+      for (ossim_uint32 col=col0; col<=col1; ++col)
+      {
+         ossim_uint64 cell = static_cast<ossim_uint64>(row) * cols + col;
+         ids.insert(ids.end(),
+                    m_pointIds + m_cellOffsets[cell],
+                    m_pointIds + m_cellOffsets[cell + 1]);
+      }
+   }
+   std::sort(ids.begin(), ids.end());
+}
+
+ossim_uint32 ossimPointCloudIndex::getNumberOfColumns() const
+{
+   return m_header ? m_header->m_cols : 0;
+}
+
+ossim_uint32 ossimPointCloudIndex::getNumberOfRows() const
+{
+   return m_header ? m_header->m_rows : 0;
+}
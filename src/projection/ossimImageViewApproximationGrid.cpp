@@ -0,0 +1,225 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Error bounded interpolation grid standing in for a
+//              rigorous view-to-image projection.
+//
+//*******************************************************************
+
+#include <ossim/projection/ossimImageViewApproximationGrid.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimString.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+// Node spacing in view pixels: the first try, and the finest allowed.
+static const double INITIAL_SPACING = 256.0;
+static const double MIN_SPACING     = 8.0;
+
+// Cap on the nodes per grid, overrides MIN_SPACING for very large views.
+static const double MAX_NODES = 65536.0;
+
+// Refinement stops once at most this fraction of the cells misses the error.
+static const double MAX_UNUSABLE_FRACTION = 0.01;
+
+static const double NULL_VALUE = OSSIM_DEFAULT_NULL_PIX_DOUBLE;
+
+static const char* GRID_MAGIC   = "OSSIM_IMAGE_VIEW_APPROXIMATION_GRID";
+static const int   GRID_VERSION = 1;
+
+ossimImageViewApproximationGrid::ossimImageViewApproximationGrid()
+:  m_imageX(),
+   m_imageY(),
+   m_cellError(),
+   m_maxError(0.0),
+   m_resolvedCells(0),
+   m_failedCells(0)
+{
+}
+
+ossimImageViewApproximationGrid::~ossimImageViewApproximationGrid()
+{
+}
+
+bool ossimImageViewApproximationGrid::build(const ossimDrect& viewRect,
+                                            double maxError,
+                                            const Projector& project)
+{
+   m_maxError = maxError;
+   m_resolvedCells = 0;
+   m_failedCells = 0;
+   if (viewRect.hasNans() || !(maxError > 0.0) || !project)
+      return false;
+
+   double width  = viewRect.width();
+   double height = viewRect.height();
+   double minSpacing = std::max(MIN_SPACING, std::sqrt(width * height / MAX_NODES));
+   double spacing = std::max(minSpacing, std::min(INITIAL_SPACING, std::max(width, height) / 2.0));
+
+   // Halve the spacing until the grid is good enough or as fine as allowed:
+   while (true)
+   {
+      sample(viewRect, spacing, project);
+      if ((getUnusableFraction() <= MAX_UNUSABLE_FRACTION) || (spacing / 2.0 < minSpacing))
+         break;
+      spacing /= 2.0;
+   }
+
+   return (m_resolvedCells > m_failedCells);
+}
+
+void ossimImageViewApproximationGrid::sample(const ossimDrect& viewRect,
+                                             double spacing,
+                                             const Projector& project)
+{
+   int nx = static_cast<int>(std::ceil(viewRect.width()  / spacing)) + 1;
+   int ny = static_cast<int>(std::ceil(viewRect.height() / spacing)) + 1;
+   ossimDpt origin = viewRect.ul();
+   ossimDpt gridSpacing (spacing, spacing);
+
+   m_imageX.initialize(ossimIpt(nx, ny), origin, gridSpacing, NULL_VALUE);
+   m_imageY.initialize(ossimIpt(nx, ny), origin, gridSpacing, NULL_VALUE);
+   m_cellError.initialize(ossimIpt(nx - 1, ny - 1), origin + gridSpacing / 2.0, gridSpacing,
+                          NULL_VALUE);
+   m_resolvedCells = 0;
+   m_failedCells = 0;
+
+   // Nodes, one row per batch:
+   std::vector<ossimDpt> vpts (nx);
+   std::vector<ossimDpt> ipts (nx);
+   for (int y = 0; y < ny; ++y)
+   {
+      for (int x = 0; x < nx; ++x)
+         vpts[x] = ossimDpt(origin.x + x * spacing, origin.y + y * spacing);
+      project(&vpts.front(), nx, &ipts.front());
+      for (int x = 0; x < nx; ++x)
+      {
+         if (!ipts[x].hasNans())
+         {
+            m_imageX.setNode(x, y, ipts[x].x);
+            m_imageY.setNode(x, y, ipts[x].y);
+         }
+      }
+   }
+
+   // Cell centers, checked against the interpolation:
+   for (int y = 0; y < ny - 1; ++y)
+   {
+      for (int x = 0; x < nx - 1; ++x)
+         vpts[x] = ossimDpt(origin.x + (x + 0.5) * spacing, origin.y + (y + 0.5) * spacing);
+      project(&vpts.front(), nx - 1, &ipts.front());
+      for (int x = 0; x < nx - 1; ++x)
+      {
+         double nullValue = m_imageX.nullValue();
+         if ((m_imageX.getNode(x, y) == nullValue)     ||
+             (m_imageX.getNode(x + 1, y) == nullValue) ||
+             (m_imageX.getNode(x, y + 1) == nullValue) ||
+             (m_imageX.getNode(x + 1, y + 1) == nullValue))
+            continue; // Off the projection, not counted.
+
+         ++m_resolvedCells;
+         if (ipts[x].hasNans())
+         {
+            ++m_failedCells;
+            continue;
+         }
+
+         ossimDpt interpolated (m_imageX(vpts[x]), m_imageY(vpts[x]));
+         double error = (interpolated - ipts[x]).length();
+         if (error > m_maxError)
+            ++m_failedCells;
+         else
+            m_cellError.setNode(x, y, error);
+      }
+   }
+}
+
+bool ossimImageViewApproximationGrid::viewToImage(const ossimDpt& viewPoint,
+                                                  ossimDpt& imagePoint) const
+{
+   const ossimIpt& size = m_imageX.size();
+   if ((size.x < 2) || (size.y < 2))
+      return false;
+
+   const ossimDpt& origin  = m_imageX.origin();
+   const ossimDpt& spacing = m_imageX.spacing();
+   double xi = (viewPoint.x - origin.x) / spacing.x;
+   double yi = (viewPoint.y - origin.y) / spacing.y;
+   if (!(xi >= 0.0) || !(yi >= 0.0) || (xi > size.x - 1) || (yi > size.y - 1))
+      return false;
+
+   // The far edges belong to the last cell:
+   int cx = std::min(static_cast<int>(xi), size.x - 2);
+   int cy = std::min(static_cast<int>(yi), size.y - 2);
+   // Compared against the grid's own null, it is rounded when saved:
+   if (m_cellError.getNode(cx, cy) == m_cellError.nullValue())
+      return false;
+
+   imagePoint.x = m_imageX(viewPoint);
+   imagePoint.y = m_imageY(viewPoint);
+   return true;
+}
+
+double ossimImageViewApproximationGrid::getUnusableFraction() const
+{
+   if (m_resolvedCells == 0)
+      return 1.0;
+   return static_cast<double>(m_failedCells) / m_resolvedCells;
+}
+
+bool ossimImageViewApproximationGrid::save(const ossimFilename& file, ossim_uint64 key) const
+{
+   std::ofstream out (file.c_str());
+   if (!out)
+      return false;
+
+   out << GRID_MAGIC << " " << GRID_VERSION << " " << key << " "
+       << ossimString::toString(m_maxError, 15) << " "
+       << m_resolvedCells << " " << m_failedCells << "\n";
+   m_imageX.save(out, "image_x");
+   m_imageY.save(out, "image_y");
+   m_cellError.save(out, "cell_error");
+   out.close();
+
+   if (!out)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimImageViewApproximationGrid::save WARNING: Could not write <" << file << ">\n";
+      file.remove();
+      return false;
+   }
+   return true;
+}
+
+bool ossimImageViewApproximationGrid::load(const ossimFilename& file, ossim_uint64 key)
+{
+   std::ifstream in (file.c_str());
+   if (!in)
+      return false;
+
+   std::string magic;
+   int version = 0;
+   ossim_uint64 fileKey = 0;
+   in >> magic >> version >> fileKey >> m_maxError >> m_resolvedCells >> m_failedCells;
+   if (!in || (magic != GRID_MAGIC) || (version != GRID_VERSION) || (fileKey != key))
+      return false;
+
+   // Rest of the header line:
+   std::string line;
+   std::getline(in, line);
+
+   bool status = m_imageX.load(in) && m_imageY.load(in) && m_cellError.load(in) &&
+                 (m_imageY.size() == m_imageX.size()) &&
+                 (m_cellError.size() == m_imageX.size() - ossimIpt(1, 1));
+   if (!status)
+   {
+      m_imageX.deallocate();
+      m_imageY.deallocate();
+      m_cellError.deallocate();
+   }
+   return status;
+}
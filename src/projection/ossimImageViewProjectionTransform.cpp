@@ -24,13 +24,27 @@
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimPolyArea2d.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
 #include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <vector>
 
 RTTI_DEF1(ossimImageViewProjectionTransform,
           "ossimImageViewProjectionTransform",
           ossimImageViewTransform);
 
+// Approximation grids are built this much larger than the image footprint in the view.
+static const double APPROXIMATION_MARGIN = 0.05;
+
+static double defaultApproximationMaxError()
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("image_view_transform.approximation_max_error");
+   return lookup ? ossimString(lookup).toDouble() : 0.0;
+}
+
 //*****************************************************************************
 //  CONSTRUCTOR: ossimImageViewProjectionTransform
 //*****************************************************************************
@@ -38,7 +52,12 @@ ossimImageViewProjectionTransform::ossimImageViewProjectionTransform
 (  ossimImageGeometry* imageGeometry, ossimImageGeometry* viewGeometry)
 :  m_imageGeometry(imageGeometry),
    m_viewGeometry(viewGeometry),
-   m_crossesDateline(false)
+   m_crossesDateline(false),
+   m_approximationMaxError(defaultApproximationMaxError()),
+   m_approximationCacheFile(),
+   m_approximationMutex(),
+   m_approximationChecked(false),
+   m_approximationGrid()
 {
 }
 
@@ -50,8 +69,17 @@ ossimImageViewProjectionTransform(const ossimImageViewProjectionTransform& src)
 : ossimImageViewTransform(src),
   m_imageGeometry(src.m_imageGeometry),
   m_viewGeometry(src.m_viewGeometry),
-  m_crossesDateline(false)
+  m_crossesDateline(false),
+  m_approximationMaxError(src.m_approximationMaxError),
+  m_approximationCacheFile(src.m_approximationCacheFile),
+  m_approximationMutex(),
+  m_approximationChecked(false),
+  m_approximationGrid()
 {
+   // Same geometries, so the grid can be shared:
+   std::lock_guard<std::mutex> lock(src.m_approximationMutex);
+   m_approximationGrid = std::atomic_load(&src.m_approximationGrid);
+   m_approximationChecked = src.m_approximationChecked.load();
 }
 
 //*****************************************************************************
@@ -66,6 +94,7 @@ void ossimImageViewProjectionTransform::setViewGeometry(ossimImageGeometry* g)
   m_viewGeometry = g;
 
   initializeDatelineCrossing();
+  resetApproximationGrid();
 }   
 
 //! Assigns the geometry to use for input image. This object does NOT own the geometry.
@@ -73,6 +102,7 @@ void ossimImageViewProjectionTransform::setImageGeometry(ossimImageGeometry* g)
 { 
   m_imageGeometry = g; 
   initializeDatelineCrossing();
+  resetApproximationGrid();
 }  
 
 //*****************************************************************************
@@ -171,8 +201,14 @@ void ossimImageViewProjectionTransform::viewToImage(const ossimDpt& vp, ossimDpt
    
    //---
    // Completely different left and right side geoms (typical situation).
-   // Need to project to ground.
+   // Use the approximation grid if it covers the point, else project to ground.
    //---
+   std::shared_ptr<const ossimImageViewApproximationGrid> grid = getApproximationGrid();
+   if (grid && grid->viewToImage(vp, ip))
+   {
+      return;
+   }
+
    ossimGpt gp;
    m_viewGeometry->localToWorld(vp, gp);
    m_imageGeometry->worldToLocal(gp, ip);
@@ -186,6 +222,204 @@ void ossimImageViewProjectionTransform::viewToImage(const ossimDpt& vp, ossimDpt
 #endif
 }
 
+//*****************************************************************************
+//  Batch form of viewToImage.  Only the project-through-ground case differs
+//  from looping over viewToImage.
+//*****************************************************************************
+void ossimImageViewProjectionTransform::viewPointsToImage(const ossimDpt* viewPoints,
+                                                          ossim_uint32    count,
+                                                          ossimDpt*       imagePoints) const
+{
+   if (!needsGround() || (count < 2))
+   {
+      ossimImageViewTransform::viewPointsToImage(viewPoints, count, imagePoints);
+      return;
+   }
+
+   std::shared_ptr<const ossimImageViewApproximationGrid> grid = getApproximationGrid();
+   if (!grid)
+   {
+      rigorousViewPointsToImage(viewPoints, count, imagePoints);
+      return;
+   }
+
+   // Interpolate what the grid covers, project the rest as one set:
+   std::vector<ossim_uint32> misses;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (!grid->viewToImage(viewPoints[i], imagePoints[i]))
+      {
+         misses.push_back(i);
+      }
+   }
+   if (misses.size() == count)
+   {
+      rigorousViewPointsToImage(viewPoints, count, imagePoints);
+   }
+   else if (misses.size())
+   {
+      ossim_uint32 missCount = static_cast<ossim_uint32>(misses.size());
+      std::vector<ossimDpt> vpts(missCount);
+      std::vector<ossimDpt> ipts(missCount);
+      for (ossim_uint32 i = 0; i < missCount; ++i)
+      {
+         vpts[i] = viewPoints[misses[i]];
+      }
+      rigorousViewPointsToImage(&vpts.front(), missCount, &ipts.front());
+      for (ossim_uint32 i = 0; i < missCount; ++i)
+      {
+         imagePoints[misses[i]] = ipts[i];
+      }
+   }
+}
+
+//*****************************************************************************
+//  Returns true when neither the geometries nor their projections match.
+//*****************************************************************************
+bool ossimImageViewProjectionTransform::needsGround() const
+{
+   if ((m_imageGeometry == m_viewGeometry) || !m_imageGeometry.valid() || !m_viewGeometry.valid())
+   {
+      return false;
+   }
+   const ossimProjection* iproj = m_imageGeometry->getProjection();
+   const ossimProjection* vproj = m_viewGeometry->getProjection();
+   return !((iproj && vproj && iproj->isEqualTo(*vproj)) || (iproj == vproj));
+}
+
+void ossimImageViewProjectionTransform::rigorousViewPointsToImage(const ossimDpt* viewPoints,
+                                                                  ossim_uint32    count,
+                                                                  ossimDpt*       imagePoints) const
+{
+   if (count == 0)
+   {
+      return;
+   }
+   std::vector<ossimGpt> gpts(count);
+   m_viewGeometry->localToWorld(viewPoints, count, &gpts.front());
+   m_imageGeometry->worldToLocal(&gpts.front(), count, imagePoints);
+}
+
+void ossimImageViewProjectionTransform::setApproximationMaxError(double maxError)
+{
+   if (maxError != m_approximationMaxError)
+   {
+      m_approximationMaxError = maxError;
+      resetApproximationGrid();
+   }
+}
+
+void ossimImageViewProjectionTransform::setApproximationCacheFile(const ossimFilename& file)
+{
+   m_approximationCacheFile = file;
+}
+
+void ossimImageViewProjectionTransform::resetApproximationGrid()
+{
+   std::lock_guard<std::mutex> lock(m_approximationMutex);
+   std::atomic_store(&m_approximationGrid,
+                     std::shared_ptr<const ossimImageViewApproximationGrid>());
+   m_approximationChecked = false;
+}
+
+//*****************************************************************************
+//  FNV-1a of the saved state plus the error, so a cached grid is only reused
+//  for the same image and view.
+//*****************************************************************************
+ossim_uint64 ossimImageViewProjectionTransform::getApproximationKey() const
+{
+   ossimKeywordlist kwl;
+   saveState(kwl);
+   kwl.add("approximation_max_error", ossimString::toString(m_approximationMaxError, 15));
+   ossimString state;
+   kwl.toString(state);
+
+   ossim_uint64 key = 14695981039346656037ULL;
+   for (std::string::size_type i = 0; i < state.size(); ++i)
+   {
+      key ^= static_cast<ossim_uint8>(state[i]);
+      key *= 1099511628211ULL;
+   }
+   return key;
+}
+
+std::shared_ptr<const ossimImageViewApproximationGrid>
+ossimImageViewProjectionTransform::getApproximationGrid() const
+{
+   if (!(m_approximationMaxError > 0.0))
+   {
+      return std::shared_ptr<const ossimImageViewApproximationGrid>();
+   }
+   if (m_approximationChecked.load(std::memory_order_acquire))
+   {
+      return std::atomic_load(&m_approximationGrid);
+   }
+
+   std::lock_guard<std::mutex> lock(m_approximationMutex);
+   if (m_approximationChecked.load(std::memory_order_relaxed))
+   {
+      return std::atomic_load(&m_approximationGrid);
+   }
+
+   // Grid over the image footprint in the view. Dateline crossings have two footprints, skip them.
+   ossimDrect viewRect;
+   viewRect.makeNan();
+   if (needsGround() && !m_crossesDateline)
+   {
+      ossimDrect imageRect;
+      m_imageGeometry->getBoundingRect(imageRect);
+      if (!imageRect.hasNans())
+      {
+         viewRect = getImageToViewBounds(imageRect);
+      }
+   }
+
+   if (!viewRect.hasNans() && (viewRect.width() > 1.0) && (viewRect.height() > 1.0))
+   {
+      ossimDpt margin (viewRect.width()  * APPROXIMATION_MARGIN,
+                       viewRect.height() * APPROXIMATION_MARGIN);
+      viewRect = ossimDrect(viewRect.ul() - margin, viewRect.lr() + margin);
+
+      ossim_uint64 key = getApproximationKey();
+      ossimFilename cacheFile;
+      if (m_approximationCacheFile.size())
+      {
+         std::ostringstream keyString;
+         keyString << std::hex << std::setw(16) << std::setfill('0') << key;
+         cacheFile = m_approximationCacheFile.noExtension() + "." + keyString.str() + "." +
+                     m_approximationCacheFile.ext();
+      }
+
+      std::shared_ptr<ossimImageViewApproximationGrid> grid =
+         std::make_shared<ossimImageViewApproximationGrid>();
+      if (cacheFile.size() && cacheFile.exists() && grid->load(cacheFile, key))
+      {
+         std::atomic_store(&m_approximationGrid,
+                           std::shared_ptr<const ossimImageViewApproximationGrid>(grid));
+      }
+      else
+      {
+         ossimImageViewApproximationGrid::Projector project =
+            [this](const ossimDpt* vpts, ossim_uint32 count, ossimDpt* ipts)
+            {
+               rigorousViewPointsToImage(vpts, count, ipts);
+            };
+         if (grid->build(viewRect, m_approximationMaxError, project))
+         {
+            std::atomic_store(&m_approximationGrid,
+                              std::shared_ptr<const ossimImageViewApproximationGrid>(grid));
+            if (cacheFile.size())
+            {
+               grid->save(cacheFile, key);
+            }
+         }
+      }
+   }
+
+   m_approximationChecked.store(true, std::memory_order_release);
+   return std::atomic_load(&m_approximationGrid);
+}
+
 void ossimImageViewProjectionTransform::getViewSegments(std::vector<ossimDrect>& viewBounds, 
                                                       ossimPolyArea2d& polyArea,
                                                       ossim_uint32 numberOfEdgePoints)const
@@ -351,6 +585,7 @@ bool ossimImageViewProjectionTransform::setView(ossimObject* baseObject)
    ossimImageGeometry* g = dynamic_cast<ossimImageGeometry*>(baseObject);
    bool new_view_set = false;
    m_crossesDateline = false;
+   resetApproximationGrid();
    if (g)
    {
       m_viewGeometry = g;
@@ -483,7 +718,7 @@ bool ossimImageViewProjectionTransform::loadState(const ossimKeywordlist& kwl,
          m_viewGeometry = new ossimImageGeometry();
          m_viewGeometry->loadState(kwl, viewPrefix.c_str());
       }
-      
+      resetApproximationGrid();
    }
    
    return result;
@@ -38,6 +38,16 @@ void ossimImageViewTransform::viewToImage(const ossimDpt& viewPoint,
    ossim2dTo2dTransform::inverse(viewPoint, imagePoint);
 }
 
+void ossimImageViewTransform::viewPointsToImage(const ossimDpt* viewPoints,
+                                                ossim_uint32    count,
+                                                ossimDpt*       imagePoints)const
+{
+   for(ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      viewToImage(viewPoints[idx], imagePoints[idx]);
+   }
+}
+
 ossimDpt ossimImageViewTransform::imageToView(const ossimDpt& imagePoint)const
 {
    ossimDpt tempPt;
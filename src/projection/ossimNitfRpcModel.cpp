@@ -284,6 +284,35 @@ void ossimNitfRpcModel::lineSampleHeightToWorld(
    ossimRpcModel::lineSampleHeightToWorld(pt, heightEllipsoid, worldPoint);
 }
 
+void ossimNitfRpcModel::worldToLineSamples(const ossimGpt* world_points,
+                                           ossim_uint32    count,
+                                           ossimDpt*       image_points) const
+{
+   ossimRpcModel::worldToLineSamples(world_points, count, image_points);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      image_points[i].x = image_points[i].x * theDecimation;
+      image_points[i].y = image_points[i].y * theDecimation;
+   }
+}
+
+void ossimNitfRpcModel::lineSampleHeightsToWorld(const ossimDpt* image_points,
+                                                 const double*   heightsEllipsoid,
+                                                 ossim_uint32    count,
+                                                 ossimGpt*       worldPoints) const
+{
+   std::vector<ossimDpt> pts(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      pts[i].x = image_points[i].x / theDecimation;
+      pts[i].y = image_points[i].y / theDecimation;
+   }
+   if (count)
+   {
+      ossimRpcModel::lineSampleHeightsToWorld(&pts.front(), heightsEllipsoid, count, worldPoints);
+   }
+}
+
 bool ossimNitfRpcModel::saveState(ossimKeywordlist& kwl,
                                   const char* prefix) const
 {
@@ -168,6 +168,37 @@ void ossimProjection::worldToLineSample(const ossimGpt& worldPoint,
    
 }
 
+void ossimProjection::lineSamplesToWorld(const ossimDpt* lineSampPts,
+                                         ossim_uint32    count,
+                                         ossimGpt*       worldPts) const
+{
+   for(ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      lineSampleToWorld(lineSampPts[idx], worldPts[idx]);
+   }
+}
+
+void ossimProjection::worldToLineSamples(const ossimGpt* worldPts,
+                                         ossim_uint32    count,
+                                         ossimDpt*       lineSampPts) const
+{
+   for(ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      worldToLineSample(worldPts[idx], lineSampPts[idx]);
+   }
+}
+
+void ossimProjection::lineSampleHeightsToWorld(const ossimDpt* lineSampPts,
+                                               const double*   heightsAboveEllipsoid,
+                                               ossim_uint32    count,
+                                               ossimGpt*       worldPts) const
+{
+   for(ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      lineSampleHeightToWorld(lineSampPts[idx], heightsAboveEllipsoid[idx], worldPts[idx]);
+   }
+}
+
 void ossimProjection::getRoundTripError(const ossimDpt& imagePoint,
                                         ossimDpt& errorResult)const
 {
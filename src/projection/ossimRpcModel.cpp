@@ -33,6 +33,7 @@ RTTI_DEF1(ossimRpcModel, "ossimRpcModel", ossimSensorModel);
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <vector>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 
 #if OSSIM_HAS_JSONCPP
@@ -81,7 +82,92 @@ static const ossimString PARAM_UNITS[] ={"pixel",
                                         "scale",
                                         "degrees",
                                         "degrees"};
-      
+
+//***
+// Batch evaluation support. Points are transformed RPC_BLOCK_SIZE at a time
+// with the monomial terms of the block laid out term by term, so each
+// polynomial is a run of independent multiply-adds over the block that the
+// compiler vectorizes. The terms are computed once per point and shared by
+// the four polynomials and their partials.
+//***
+namespace
+{
+   const ossim_uint32 RPC_BLOCK_SIZE = 64;
+
+   // Index in the RPC00A coefficients of each RPC00B term:
+   const int A_TERM_OF_B_TERM[NUM_COEFFS] =
+      { 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 7, 11, 14, 17, 12, 15, 18, 13, 16, 19 };
+
+   // RPC00B terms with a nonzero partial wrt normalized lat and lon:
+   const int NUM_PARTIAL_TERMS = 10;
+   const int LAT_PARTIAL_TERMS[NUM_PARTIAL_TERMS] = { 2, 4, 6, 8, 10, 12, 14, 15, 16, 18 };
+   const int LON_PARTIAL_TERMS[NUM_PARTIAL_TERMS] = { 1, 4, 5, 7, 10, 11, 12, 13, 14, 17 };
+
+   typedef double TermBlock[NUM_COEFFS][RPC_BLOCK_SIZE];
+   typedef double PartialBlock[NUM_PARTIAL_TERMS][RPC_BLOCK_SIZE];
+
+   // RPC00B terms of n points, P = normalized lat, L = lon, H = hgt.
+   void computeTerms(const double* P, const double* L, const double* H,
+                     ossim_uint32 n, TermBlock& t)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         const double p = P[i];
+         const double l = L[i];
+         const double h = H[i];
+         t[ 0][i] = 1.0;   t[ 1][i] = l;     t[ 2][i] = p;     t[ 3][i] = h;
+         t[ 4][i] = l*p;   t[ 5][i] = l*h;   t[ 6][i] = p*h;   t[ 7][i] = l*l;
+         t[ 8][i] = p*p;   t[ 9][i] = h*h;   t[10][i] = l*p*h; t[11][i] = l*l*l;
+         t[12][i] = l*p*p; t[13][i] = l*h*h; t[14][i] = l*l*p; t[15][i] = p*p*p;
+         t[16][i] = p*h*h; t[17][i] = l*l*h; t[18][i] = p*p*h; t[19][i] = h*h*h;
+      }
+   }
+
+   // Nonzero partials of the terms, in LAT_PARTIAL_TERMS and LON_PARTIAL_TERMS order.
+   void computePartials(const double* P, const double* L, const double* H,
+                        ossim_uint32 n, PartialBlock& dLat, PartialBlock& dLon)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         const double p = P[i];
+         const double l = L[i];
+         const double h = H[i];
+         dLat[0][i] = 1.0;     dLat[1][i] = l;       dLat[2][i] = h;
+         dLat[3][i] = 2.0*p;   dLat[4][i] = l*h;     dLat[5][i] = 2.0*l*p;
+         dLat[6][i] = l*l;     dLat[7][i] = 3.0*p*p; dLat[8][i] = h*h;
+         dLat[9][i] = 2.0*p*h;
+         dLon[0][i] = 1.0;     dLon[1][i] = p;       dLon[2][i] = h;
+         dLon[3][i] = 2.0*l;   dLon[4][i] = p*h;     dLon[5][i] = 3.0*l*l;
+         dLon[6][i] = p*p;     dLon[7][i] = h*h;     dLon[8][i] = 2.0*l*p;
+         dLon[9][i] = 2.0*l*h;
+      }
+   }
+
+   // result[i] = sum of c[term[k]]*t[k][i] over numTerms terms.
+   template <class Block>
+   void evaluate(const double* c, const int* term, int numTerms,
+                 const Block& t, ossim_uint32 n, double* result)
+   {
+      const double c0 = c[term[0]];
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         result[i] = c0*t[0][i];
+      }
+      for (int k = 1; k < numTerms; ++k)
+      {
+         const double ck = c[term[k]];
+         for (ossim_uint32 i = 0; i < n; ++i)
+         {
+            result[i] += ck*t[k][i];
+         }
+      }
+   }
+
+   // Identity term list for the full polynomials.
+   const int ALL_TERMS[NUM_COEFFS] =
+      { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+}
+
 //*****************************************************************************
 //  DEFAULT CONSTRUCTOR: ossimRpcModel()
 //  
@@ -323,6 +409,65 @@ void ossimRpcModel::worldToLineSample(const ossimGpt& ground_point,
    return;
 }
 
+//*****************************************************************************
+//  METHOD: ossimRpcModel::worldToLineSamples()
+//  
+//  Overrides base class implementation. Same computation as
+//  worldToLineSample() for a block of points at a time.
+//*****************************************************************************
+void ossimRpcModel::worldToLineSamples(const ossimGpt* ground_points,
+                                       ossim_uint32    count,
+                                       ossimDpt*       img_pts) const
+{
+   double coeffs[4][NUM_COEFFS];
+   getBTermOrderCoefficients(coeffs);
+
+   double nlat[RPC_BLOCK_SIZE];
+   double nlon[RPC_BLOCK_SIZE];
+   double nhgt[RPC_BLOCK_SIZE];
+   double Pu[RPC_BLOCK_SIZE];
+   double Qu[RPC_BLOCK_SIZE];
+   double Pv[RPC_BLOCK_SIZE];
+   double Qv[RPC_BLOCK_SIZE];
+   TermBlock terms;
+
+   for (ossim_uint32 start = 0; start < count; start += RPC_BLOCK_SIZE)
+   {
+      const ossim_uint32 n = std::min(RPC_BLOCK_SIZE, count - start);
+      const ossimGpt* gpts = ground_points + start;
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         nlat[i] = (gpts[i].lat - theLatOffset) / theLatScale;
+         nlon[i] = (gpts[i].lon - theLonOffset) / theLonScale;
+         nhgt[i] = ((gpts[i].isHgtNan() ? 0.0 : gpts[i].hgt) - theHgtOffset) / theHgtScale;
+      }
+
+      computeTerms(nlat, nlon, nhgt, n, terms);
+      evaluate(coeffs[0], ALL_TERMS, NUM_COEFFS, terms, n, Pu);
+      evaluate(coeffs[1], ALL_TERMS, NUM_COEFFS, terms, n, Qu);
+      evaluate(coeffs[2], ALL_TERMS, NUM_COEFFS, terms, n, Pv);
+      evaluate(coeffs[3], ALL_TERMS, NUM_COEFFS, terms, n, Qv);
+
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         ossimDpt& img_pt = img_pts[start + i];
+         if (gpts[i].isLatNan() || gpts[i].isLonNan())
+         {
+            img_pt.makeNan();
+            continue;
+         }
+
+         // Back out the adjustable parameters as worldToLineSample() does:
+         double U_rot = Pu[i] / Qu[i];
+         double V_rot = Pv[i] / Qv[i];
+         double U = U_rot*theCosMapRot + V_rot*theSinMapRot;
+         double V = V_rot*theCosMapRot - U_rot*theSinMapRot;
+         img_pt.line = U*(theLineScale+theIntrackScale) + theLineOffset + theIntrackOffset;
+         img_pt.samp = V*(theSampScale+theCrtrackScale) + theSampOffset + theCrtrackOffset;
+      }
+   }
+}
+
 //*****************************************************************************
 //  METHOD: ossimRpcModel::lineSampleToWorld()
 //  
@@ -361,6 +506,68 @@ void  ossimRpcModel::lineSampleToWorld(const ossimDpt& imagePoint,
 #endif
 }
 
+//*****************************************************************************
+//  METHOD: ossimRpcModel::lineSamplesToWorld()
+//  
+//  Overrides base class implementation. Builds all imaging rays and then
+//  intersects them with the DEM in a single batch.
+//*****************************************************************************
+void ossimRpcModel::lineSamplesToWorld(const ossimDpt* imagePoints,
+                                       ossim_uint32    count,
+                                       ossimGpt*       worldPoints) const
+{
+   std::vector<ossimDpt> rayEnds;
+   std::vector<ossim_uint32> indices;
+   rayEnds.reserve(count*2);
+   indices.reserve(count);
+   for(ossim_uint32 idx = 0; idx < count; ++idx)
+   {
+      if(!imagePoints[idx].hasNans())
+      {
+         rayEnds.push_back(imagePoints[idx]);
+         indices.push_back(idx);
+      }
+      else
+      {
+         worldPoints[idx].makeNan();
+      }
+   }
+   if(indices.empty()) return;
+
+   //---
+   // Same rays as imagingRay(), with the "from" and "to" points of all
+   // rays projected in one batch.
+   //---
+   ossim_uint32 numRays = static_cast<ossim_uint32>(indices.size());
+   double vectorLength = theHgtScale ? (theHgtScale * 2.0) : 1000.0;
+   std::vector<double> heights(numRays*2, theHgtOffset);
+   std::fill(heights.begin(), heights.begin() + numRays, theHgtOffset + vectorLength);
+   rayEnds.resize(numRays*2);
+   std::copy(rayEnds.begin(), rayEnds.begin() + numRays, rayEnds.begin() + numRays);
+   std::vector<ossimGpt> endPoints(numRays*2);
+   lineSampleHeightsToWorld(&rayEnds.front(), &heights.front(), numRays*2, &endPoints.front());
+
+   std::vector<ossimEcefRay> rays(numRays);
+   for(ossim_uint32 idx = 0; idx < numRays; ++idx)
+   {
+      rays[idx] = ossimEcefRay(ossimEcefPoint(endPoints[idx]),
+                               ossimEcefPoint(endPoints[numRays + idx]));
+   }
+
+   std::vector<ossimGpt> gpts(rays.size());
+   for(ossim_uint32 idx = 0; idx < indices.size(); ++idx)
+   {
+      gpts[idx] = worldPoints[indices[idx]];
+   }
+   ossimElevManager::instance()->intersectRays(&rays.front(),
+                                               static_cast<ossim_uint32>(rays.size()),
+                                               &gpts.front());
+   for(ossim_uint32 idx = 0; idx < indices.size(); ++idx)
+   {
+      worldPoints[indices[idx]] = gpts[idx];
+   }
+}
+
 //*****************************************************************************
 //  METHOD: ossimRpcModel::imagingRay()
 //  
@@ -612,6 +819,131 @@ void ossimRpcModel::lineSampleHeightToWorld(const ossimDpt& image_point,
    
 }
 
+//*****************************************************************************
+//  METHOD: ossimRpcModel::lineSampleHeightsToWorld()
+//  
+//  Batch form of lineSampleHeightToWorld(). The Newton iteration runs for a
+//  block of points in lock step, each point dropping out once converged.
+//
+//*****************************************************************************
+void ossimRpcModel::lineSampleHeightsToWorld(const ossimDpt* image_points,
+                                             const double*   heights,
+                                             ossim_uint32    count,
+                                             ossimGpt*       gpts) const
+{
+   static const int    MAX_NUM_ITERATIONS  = 10;
+   static const double CONVERGENCE_EPSILON = 0.1;  // pixels
+
+   double coeffs[4][NUM_COEFFS];
+   getBTermOrderCoefficients(coeffs);
+
+   const double epsilonU = CONVERGENCE_EPSILON/(theLineScale+theIntrackScale);
+   const double epsilonV = CONVERGENCE_EPSILON/(theSampScale+theCrtrackScale);
+
+   double U[RPC_BLOCK_SIZE];
+   double V[RPC_BLOCK_SIZE];
+   double nlat[RPC_BLOCK_SIZE];
+   double nlon[RPC_BLOCK_SIZE];
+   double nhgt[RPC_BLOCK_SIZE];
+   bool   active[RPC_BLOCK_SIZE];
+   double poly[4][RPC_BLOCK_SIZE];
+   double dLat[4][RPC_BLOCK_SIZE];
+   double dLon[4][RPC_BLOCK_SIZE];
+   TermBlock terms;
+   PartialBlock latPartials;
+   PartialBlock lonPartials;
+   ossim_uint32 numUnconverged = 0;
+
+   for (ossim_uint32 start = 0; start < count; start += RPC_BLOCK_SIZE)
+   {
+      const ossim_uint32 n = std::min(RPC_BLOCK_SIZE, count - start);
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         // Normalize and rotate as lineSampleHeightToWorld() does, U = line, V = sample:
+         const ossimDpt& ipt = image_points[start + i];
+         double u = (ipt.y-theLineOffset - theIntrackOffset) / (theLineScale+theIntrackScale);
+         double v = (ipt.x-theSampOffset - theCrtrackOffset) / (theSampScale+theCrtrackScale);
+         U[i] = theCosMapRot*u - theSinMapRot*v;
+         V[i] = theSinMapRot*u + theCosMapRot*v;
+         nlat[i] = 0.0;
+         nlon[i] = 0.0;
+         if(ossim::isnan(heights[start + i]))
+            nhgt[i] = (theHgtScale - theHgtOffset) / theHgtScale;
+         else
+            nhgt[i] = (heights[start + i] - theHgtOffset) / theHgtScale;
+         active[i] = true;
+      }
+
+      ossim_uint32 numActive = n;
+      for (int iteration = 0; (iteration < MAX_NUM_ITERATIONS) && numActive; ++iteration)
+      {
+         computeTerms(nlat, nlon, nhgt, n, terms);
+         computePartials(nlat, nlon, nhgt, n, latPartials, lonPartials);
+         for (int p = 0; p < 4; ++p)
+         {
+            evaluate(coeffs[p], ALL_TERMS, NUM_COEFFS, terms, n, poly[p]);
+            evaluate(coeffs[p], LAT_PARTIAL_TERMS, NUM_PARTIAL_TERMS, latPartials, n, dLat[p]);
+            evaluate(coeffs[p], LON_PARTIAL_TERMS, NUM_PARTIAL_TERMS, lonPartials, n, dLon[p]);
+         }
+
+         for (ossim_uint32 i = 0; i < n; ++i)
+         {
+            if (!active[i])
+               continue;
+
+            const double Pu = poly[0][i];
+            const double Qu = poly[1][i];
+            const double Pv = poly[2][i];
+            const double Qv = poly[3][i];
+            double deltaU = U[i] - Pu/Qu;
+            double deltaV = V[i] - Pv/Qv;
+            if ((fabs(deltaU) > epsilonU) || (fabs(deltaV) > epsilonV))
+            {
+               double dU_dLat = (Qu*dLat[0][i] - Pu*dLat[1][i])/(Qu*Qu);
+               double dU_dLon = (Qu*dLon[0][i] - Pu*dLon[1][i])/(Qu*Qu);
+               double dV_dLat = (Qv*dLat[2][i] - Pv*dLat[3][i])/(Qv*Qv);
+               double dV_dLon = (Qv*dLon[2][i] - Pv*dLon[3][i])/(Qv*Qv);
+               double W = dU_dLon*dV_dLat - dU_dLat*dV_dLon;
+               nlat[i] += (dU_dLon*deltaV - dV_dLon*deltaU) / W;
+               nlon[i] += (dV_dLat*deltaU - dU_dLat*deltaV) / W;
+            }
+            else
+            {
+               active[i] = false;
+               --numActive;
+            }
+         }
+      }
+      numUnconverged += numActive;
+
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         ossimGpt& gpt = gpts[start + i];
+         gpt.lat = nlat[i]*theLatScale + theLatOffset;
+         gpt.lon = nlon[i]*theLonScale + theLonOffset;
+         gpt.hgt = heights[start + i];
+      }
+   }
+
+   if (numUnconverged)
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << "WARNING ossimRpcModel::lineSampleHeightsToWorld: \nMax number of iterations reached in "
+                                         << numUnconverged << " ground point solutions. Results are inaccurate." << endl;
+   }
+}
+
+void ossimRpcModel::getBTermOrderCoefficients(double coeffs[4][20]) const
+{
+   const double* source[4] = { theLineNumCoef, theLineDenCoef, theSampNumCoef, theSampDenCoef };
+   for (int p = 0; p < 4; ++p)
+   {
+      for (int k = 0; k < NUM_COEFFS; ++k)
+      {
+         coeffs[p][k] = source[p][(thePolyType == A) ? A_TERM_OF_B_TERM[k] : k];
+      }
+   }
+}
+
 //*****************************************************************************
 // PRIVATE METHOD: ossimRpcModel::polynomial
 //  
@@ -300,8 +300,7 @@ bool ossimRpcSolver::solve(const ossimDrect& imageBounds,
    ossimDpt ul = imageBounds.ul();
    ossim_float64 w = imageBounds.width();
    ossim_float64 h = imageBounds.height();
-   ossimDpt ipt, irpc;
-   ossimGpt gpt;
+   ossimDpt ipt;
 
    // Start at the minimum grid size:
    ossim_uint32 xSamples = STARTING_GRID_SIZE;
@@ -324,35 +323,51 @@ bool ossimRpcSolver::solve(const ossimDrect& imageBounds,
       double deltaY = h/(ySamples-1);
 
       // Sample the midpoints between image grid used to compute RPC:
+      std::vector<ossimDpt> ipts;
+      ipts.reserve((xSamples-1)*(ySamples-1));
       for (ossim_uint32 y=0; y<ySamples-1; ++y)
       {
          ipt.y = deltaY*((double)y + 0.5) + ul.y;
          for (ossim_uint32 x=0; x<xSamples-1; ++x)
          {
-            // Forward projection using input model:
             ipt.x = deltaX*((double)x + 0.5) + ul.x;
-            if (theUseElevationFlag)
-               geom->localToWorld(ipt, gpt);
-            else
-               geom->localToWorld(ipt, 0, gpt);
-            if(theHeightAboveMSLFlag)
-            {
-               double h = ossimElevManager::instance()->getHeightAboveMSL(gpt);
-               if(ossim::isnan(h) == false)
-                  gpt.height(h);
-            }
-
-            // Reverse projection using RPC:
-            evalPoint(gpt, irpc);
-
-            // Compute residual and accumulate:
-            residual = (ipt-irpc).length();
-            if (residual > theMaxResidual)
-               theMaxResidual = residual;
-            sumResiduals += residual;
-            ++numResiduals;
+            ipts.push_back(ipt);
          }
       }
+      ossim_uint32 numPoints = (ossim_uint32) ipts.size();
+
+      // Forward projection using input model, whole grid at once:
+      std::vector<ossimGpt> gpts(numPoints);
+      if (theUseElevationFlag)
+         geom->localToWorld(&ipts.front(), numPoints, &gpts.front());
+      else
+      {
+         for (ossim_uint32 i=0; i<numPoints; ++i)
+            geom->localToWorld(ipts[i], 0, gpts[i]);
+      }
+      if(theHeightAboveMSLFlag)
+      {
+         for (ossim_uint32 i=0; i<numPoints; ++i)
+         {
+            double h = ossimElevManager::instance()->getHeightAboveMSL(gpts[i]);
+            if(ossim::isnan(h) == false)
+               gpts[i].height(h);
+         }
+      }
+
+      // Reverse projection using RPC:
+      std::vector<ossimDpt> irpcs(numPoints);
+      evalPoints(&gpts.front(), numPoints, &irpcs.front());
+
+      // Compute residuals and accumulate:
+      for (ossim_uint32 i=0; i<numPoints; ++i)
+      {
+         residual = (ipts[i]-irpcs[i]).length();
+         if (residual > theMaxResidual)
+            theMaxResidual = residual;
+         sumResiduals += residual;
+         ++numResiduals;
+      }
 
       theMeanResidual = sumResiduals/numResiduals;
       if (theMaxResidual > tolerance)
@@ -688,6 +703,18 @@ void ossimRpcSolver::evalPoint(const ossimGpt& gpt, ossimDpt& ipt) const
    theRpcModel->worldToLineSample(gpt, ipt);
 }
 
+void ossimRpcSolver::evalPoints(const ossimGpt* gpts, ossim_uint32 count, ossimDpt* ipts) const
+{
+   if (!theRpcModel)
+   {
+      for (ossim_uint32 i=0; i<count; ++i)
+         ipts[i].makeNan();
+      return;
+   }
+
+   theRpcModel->worldToLineSamples(gpts, count, ipts);
+}
+
 
 ossimRefPtr<ossimNitfRegisteredTag> ossimRpcSolver::getNitfRpcBTag() const
 {
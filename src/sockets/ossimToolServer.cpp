@@ -25,6 +25,9 @@
 #include <ossim/base/ossimArgumentParser.h>
 #include <ossim/util/ossimChipProcTool.h>
 #include <ossim/util/ossimToolRegistry.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <iomanip>
+#include <streambuf>
 
 #ifdef _MSC_VER
 #include <winsock2.h>
@@ -33,7 +36,9 @@
 #define dup2 _dup2
 #define close closesocket
 #define pipe(phandles)  _pipe(phandles, 4096, _O_BINARY)
+#define poll WSAPoll
 #else
+#include <poll.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -50,35 +55,223 @@
 #define FORK_PROCESS false
 #define _DEBUG_ false
 
+namespace
+{
+   // Output buffer of the request running on this thread, threaded mode only.
+   thread_local std::streambuf* requestOutput = 0;
+
+   /**
+    * Installed as the buffer of std::cout in threaded mode. Writes go to the output of the
+    * request running on the calling thread, or to the console outside of requests.
+    */
+   class RequestOutputBuf : public std::streambuf
+   {
+   public:
+      explicit RequestOutputBuf(std::streambuf* console) : m_console(console) {}
+
+   protected:
+      virtual int overflow(int c)
+      {
+         if (c == traits_type::eof())
+            return traits_type::not_eof(c);
+         return target()->sputc(traits_type::to_char_type(c));
+      }
+
+      virtual std::streamsize xsputn(const char* s, std::streamsize n)
+      {
+         return target()->sputn(s, n);
+      }
+
+      virtual int sync()
+      {
+         return target()->pubsync();
+      }
+
+   private:
+      std::streambuf* target() const { return requestOutput ? requestOutput : m_console; }
+
+      std::streambuf* m_console;
+   };
+
+   /**
+    * Sends this thread's notify output to out while in scope. Tools writing straight to std::cout
+    * land in the buffer of out too, but share the formatting state of std::cout.
+    */
+   class RequestOutputCapture
+   {
+   public:
+      explicit RequestOutputCapture(std::ostream& out)
+      {
+         requestOutput = out.rdbuf();
+         ossimSetThreadNotifyStream(&out);
+      }
+      ~RequestOutputCapture()
+      {
+         ossimSetThreadNotifyStream(0);
+         requestOutput = 0;
+      }
+   };
+
+   ossim_uint64 microsecondsSince(const std::chrono::steady_clock::time_point& start)
+   {
+      return static_cast<ossim_uint64>(std::chrono::duration_cast<std::chrono::microseconds>(
+         std::chrono::steady_clock::now() - start).count());
+   }
+
+   template <class T>
+   void updateMax(std::atomic<T>& maxValue, T value)
+   {
+      T current = maxValue;
+      while ((value > current) && !maxValue.compare_exchange_weak(current, value));
+   }
+
+   void setNonBlocking(int sockfd)
+   {
+#ifdef _MSC_VER
+      u_long iMode = 1;
+      ioctlsocket(sockfd, FIONBIO, &iMode);
+#else
+      fcntl(sockfd, F_SETFL, O_NONBLOCK);
+#endif
+   }
+
+   /** Connected pair of sockets, the first one non-blocking. */
+   bool createSocketPair(int sockets[2])
+   {
+#ifdef _MSC_VER
+      // No socketpair() on Windows, connect two sockets over the loopback instead:
+      int listener = socket(AF_INET, SOCK_STREAM, 0);
+      struct sockaddr_in addr;
+      memset(&addr, 0, sizeof addr);
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr.sin_port = 0;
+      int addrlen = sizeof addr;
+      bool ok = (listener >= 0) &&
+                (bind(listener, (struct sockaddr*) &addr, addrlen) == 0) &&
+                (getsockname(listener, (struct sockaddr*) &addr, &addrlen) == 0) &&
+                (listen(listener, 1) == 0);
+      sockets[1] = ok ? (int) socket(AF_INET, SOCK_STREAM, 0) : -1;
+      ok = ok && (sockets[1] >= 0) &&
+           (connect(sockets[1], (struct sockaddr*) &addr, addrlen) == 0);
+      sockets[0] = ok ? (int) accept(listener, NULL, NULL) : -1;
+      if (listener >= 0)
+         close(listener);
+      if (sockets[0] < 0)
+      {
+         if (sockets[1] >= 0)
+            close(sockets[1]);
+         sockets[1] = -1;
+         return false;
+      }
+#else
+      if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1)
+         return false;
+#endif
+      setNonBlocking(sockets[0]);
+      return true;
+   }
+
+   std::string peerAddress(const struct sockaddr_in& cli_addr)
+   {
+      char dst[INET6_ADDRSTRLEN];
+      if (!inet_ntop(AF_INET, &(cli_addr.sin_addr), dst, INET6_ADDRSTRLEN))
+         return std::string("unknown");
+      return std::string(dst);
+   }
+}
+
+ossimToolServer::Connection::Connection(int sockfd, const std::string& peer)
+:  m_sockfd(sockfd),
+   m_peer(peer),
+   m_buffer(MAX_BUF_LEN + 1, 0),
+   m_requestStart(std::chrono::steady_clock::now()),
+   m_responseStarted(false)
+{}
+
 ossimToolServer::ossimToolServer()
 :  m_svrsockfd(-1),
-   m_clisockfd(-1),
-   m_buffer(new char[MAX_BUF_LEN])
-{}
+   m_numThreads(0),
+   m_returnedMutex(),
+   m_returned(),
+   m_toolMutex(),
+   m_toolCondition(),
+   m_sharedTools(0),
+   m_exclusiveWaiting(0),
+   m_exclusiveTool(false),
+   m_startTime(std::chrono::steady_clock::now()),
+   m_connectionCount(0),
+   m_openConnections(0),
+   m_requestCount(0),
+   m_errorCount(0),
+   m_activeRequests(0),
+   m_maxActiveRequests(0),
+   m_latencyMicroseconds(0),
+   m_maxLatencyMicroseconds(0),
+   m_firstByteMicroseconds(0)
+{
+   m_wakeSockets[0] = -1;
+   m_wakeSockets[1] = -1;
+   m_stopFlag = false;
+}
 
 ossimToolServer::~ossimToolServer()
 {
    close(m_svrsockfd);
+   if (m_wakeSockets[0] >= 0)
+   {
+      close(m_wakeSockets[0]);
+      close(m_wakeSockets[1]);
+   }
 }
 
+void ossimToolServer::setNumberOfThreads(ossim_uint32 numThreads)
+{
+   m_numThreads = numThreads;
+}
 
 void ossimToolServer::startListening(const char* portid)
 {
    initSocket(portid);
+   if ((m_wakeSockets[0] < 0) && !createSocketPair(m_wakeSockets))
+      error("Error creating wake sockets.");
+   m_startTime = std::chrono::steady_clock::now();
+
+   if (m_numThreads)
+   {
+      serveConnections();
+      m_stopFlag = false;
+      return;
+   }
 
    socklen_t clilen;
-   ostringstream xmsg;
-   bool status_ok = true;
 
-   // Loop forever to listen for OSSIM requests:
+   // Loop until stopListening() to listen for OSSIM requests:
    OINFO<<"Waiting for connections...\n"<<endl;
-   while (1)
+   while (!m_stopFlag)
    {
+      struct pollfd fds[2];
+      fds[0].fd = m_svrsockfd;
+      fds[1].fd = m_wakeSockets[0];
+      for (int i=0; i<2; ++i)
+      {
+         fds[i].events = POLLIN;
+         fds[i].revents = 0;
+      }
+      if (poll(fds, 2, -1) < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         error("Error on poll()");
+      }
+      if (!(fds[0].revents & POLLIN))
+         continue;
+
       // Message received at server socket, establish connection to client's socket:
       struct sockaddr_in cli_addr;
       clilen = sizeof(cli_addr);
-      m_clisockfd = accept(m_svrsockfd, (struct sockaddr *) &cli_addr, &clilen);
-      if (m_clisockfd < 0)
+      int clisockfd = accept(m_svrsockfd, (struct sockaddr *) &cli_addr, &clilen);
+      if (clisockfd < 0)
          error("Error accepting message on port.");
 
       // Test code:
@@ -88,8 +281,10 @@ void ossimToolServer::startListening(const char* portid)
       cout<<"ossimToolServer: Got connection from  "<<clientname<<":"<<clientport
             <<" Forking child process..."<<endl;
 
+      Connection connection (clisockfd, peerAddress(cli_addr));
+      ++m_connectionCount;
+      ++m_openConnections;
 
-#if 1
       // Fork process to handle client request:
       if (FORK_PROCESS)
       {
@@ -101,7 +296,7 @@ void ossimToolServer::startListening(const char* portid)
             // Receive request from client:
             bool connected = true;
             while (connected)
-               connected = processOssimRequest(cli_addr);
+               connected = processOssimRequest(connection);
 
             exit(0); // exit forked process
          }
@@ -110,32 +305,176 @@ void ossimToolServer::startListening(const char* portid)
       {
          bool connected = true;
          while (connected)
-            connected = processOssimRequest(cli_addr);
+            connected = processOssimRequest(connection);
       }
-#else
-      int n=0;
-      while (1)
+
+      // Finished serving this client. Close the connection:
+      closeConnection(connection);
+   }
+   m_stopFlag = false;
+}
+
+void ossimToolServer::stopListening()
+{
+   m_stopFlag = true;
+   wake();
+}
+
+void ossimToolServer::wake()
+{
+   char wake = 1;
+   if ((m_wakeSockets[1] >= 0) && (send(m_wakeSockets[1], &wake, 1, 0) != 1))
+      OWARN<<"ossimToolServer: Error waking the connection loop."<<endl;
+}
+
+void ossimToolServer::serveConnections()
+{
+   // Tool output is collected per request, see runCommand().
+   static RequestOutputBuf outputBuf (cout.rdbuf());
+   std::streambuf* console = cout.rdbuf(&outputBuf);
+
+   ossim::ThreadPool workers (m_numThreads);
+   std::vector< std::shared_ptr<Connection> > idle;
+   std::vector< std::shared_ptr<Connection> > waiting;
+   std::vector<struct pollfd> fds;
+
+   OINFO<<"Waiting for connections, "<<m_numThreads<<" worker threads...\n"<<endl;
+   while (!m_stopFlag)
+   {
+      // Listener, wake socket, then the connections between requests:
+      fds.resize(idle.size() + 2);
+      fds[0].fd = m_svrsockfd;
+      fds[1].fd = m_wakeSockets[0];
+      for (size_t i=0; i<idle.size(); ++i)
+         fds[i+2].fd = idle[i]->m_sockfd;
+      for (size_t i=0; i<fds.size(); ++i)
+      {
+         fds[i].events = POLLIN;
+         fds[i].revents = 0;
+      }
+
+      if (poll(&fds.front(), fds.size(), -1) < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         error("Error on poll()");
+      }
+
+      // Connections with a request waiting go to the workers, one worker per connection:
+      waiting.clear();
+      for (size_t i=0; i<idle.size(); ++i)
       {
-         // Clear the input m_buffer and read the message sent:
-         memset(m_buffer, 0, 256);
-         n = recv(m_clisockfd,m_buffer,256,0);
-         if (n < 0)
+         if (fds[i+2].revents & (POLLIN|POLLHUP|POLLERR|POLLNVAL))
          {
-            printf("recv returned -1 from port %d.\n", m_clisockfd);
+            std::shared_ptr<Connection> connection = idle[i];
+            workers.submit([this, connection]() { serveConnection(connection); });
          }
+         else
+            waiting.push_back(idle[i]);
+      }
+      idle.swap(waiting);
 
-         // Send acknowledgement back to client:
-         printf("Received: %s\n",m_buffer);
-         string msg ="server received message: ";
-         msg.append(m_buffer, strlen(m_buffer));
-         n = send(m_clisockfd, msg.c_str(), msg.size(), 0);
-         if (n < 0)
-            error("ERROR writing to socket");
+      // Connections handed back after their requests:
+      if (fds[1].revents & POLLIN)
+      {
+         char drain[64];
+         while (recv(m_wakeSockets[0], drain, sizeof(drain), 0) > 0);
+         std::lock_guard<std::mutex> lock (m_returnedMutex);
+         idle.insert(idle.end(), m_returned.begin(), m_returned.end());
+         m_returned.clear();
       }
-#endif
-      // Finished serving this client. Close the connection:
-      close(m_clisockfd);
+
+      // New connections:
+      if (fds[0].revents & POLLIN)
+      {
+         struct sockaddr_in cli_addr;
+         socklen_t clilen = sizeof(cli_addr);
+         int clisockfd = accept(m_svrsockfd, (struct sockaddr *) &cli_addr, &clilen);
+         if (clisockfd < 0)
+         {
+            OWARN<<"ossimToolServer: Error accepting message on port."<<endl;
+            continue;
+         }
+
+         // Responses start with a short header, don't let it wait for more data:
+         int yes=1;
+         setsockopt(clisockfd, IPPROTO_TCP, TCP_NODELAY, (const char*) &yes, sizeof yes);
+
+         std::shared_ptr<Connection> connection =
+            std::make_shared<Connection>(clisockfd, peerAddress(cli_addr));
+         ++m_connectionCount;
+         ++m_openConnections;
+         cout<<"ossimToolServer: Got connection from  "<<connection->m_peer<<endl;
+         idle.push_back(connection);
+      }
+   }
+
+   // Stopped. Let the running requests finish, then close every connection:
+   workers.waitForIdle();
+   {
+      std::lock_guard<std::mutex> lock (m_returnedMutex);
+      idle.insert(idle.end(), m_returned.begin(), m_returned.end());
+      m_returned.clear();
+   }
+   for (size_t i=0; i<idle.size(); ++i)
+      closeConnection(*idle[i]);
+   cout.rdbuf(console);
+}
+
+void ossimToolServer::serveConnection(std::shared_ptr<Connection> connection)
+{
+   bool connected = processOssimRequest(*connection);
+
+   // A request already waiting on this connection is served without a trip through poll loop:
+   while (connected)
+   {
+      struct pollfd pfd;
+      pfd.fd = connection->m_sockfd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if ((poll(&pfd, 1, 0) <= 0) || !(pfd.revents & (POLLIN|POLLHUP|POLLERR)))
+         break;
+      connected = processOssimRequest(*connection);
    }
+
+   if (!connected)
+   {
+      closeConnection(*connection);
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock (m_returnedMutex);
+      m_returned.push_back(connection);
+   }
+   wake();
+}
+
+void ossimToolServer::closeConnection(Connection& connection)
+{
+   if (connection.m_sockfd >= 0)
+   {
+      close(connection.m_sockfd);
+      connection.m_sockfd = -1;
+      --m_openConnections;
+   }
+}
+
+std::string ossimToolServer::getStatistics() const
+{
+   ossim_uint64 requests = m_requestCount;
+   double scale = requests ? 1.0e-3/requests : 0.0;
+   ostringstream out;
+   out << std::setiosflags(std::ios::fixed) << std::setprecision(3)
+       << "uptime_s: " << microsecondsSince(m_startTime)*1.0e-6 << "\n"
+       << "threads: " << m_numThreads << "\n"
+       << "connections: " << m_connectionCount << " (open " << m_openConnections << ")\n"
+       << "requests: " << requests << " (errors " << m_errorCount << ")\n"
+       << "active_requests: " << m_activeRequests << " (max " << m_maxActiveRequests << ")\n"
+       << "latency_ms: mean " << m_latencyMicroseconds*scale
+       << ", max " << m_maxLatencyMicroseconds*1.0e-3 << "\n"
+       << "first_byte_ms: mean " << m_firstByteMicroseconds*scale << "\n";
+   return out.str();
 }
 
 void ossimToolServer::initSocket(const char* portid)
@@ -204,39 +543,87 @@ void ossimToolServer::sigchld_handler(int s)
    errno = saved_errno;
 }
 
+bool ossimToolServer::isConcurrentSafe(const ossimString& command)
+{
+   // Tools that neither change process wide state nor write straight to std::cout:
+   ossimString name = command.before(" ");
+   return (name == "info") || (name == "subimage") || (name == "help");
+}
+
+void ossimToolServer::beginTool(bool exclusive)
+{
+   std::unique_lock<std::mutex> lock (m_toolMutex);
+   if (exclusive)
+   {
+      ++m_exclusiveWaiting;
+      m_toolCondition.wait(lock, [this]() { return !m_exclusiveTool && !m_sharedTools; });
+      --m_exclusiveWaiting;
+      m_exclusiveTool = true;
+   }
+   else
+   {
+      // Waiting exclusive tools go first so a stream of shared requests can't starve them:
+      m_toolCondition.wait(lock, [this]() { return !m_exclusiveTool && !m_exclusiveWaiting; });
+      ++m_sharedTools;
+   }
+}
+
+void ossimToolServer::endTool(bool exclusive)
+{
+   {
+      std::lock_guard<std::mutex> lock (m_toolMutex);
+      if (exclusive)
+         m_exclusiveTool = false;
+      else
+         --m_sharedTools;
+   }
+   m_toolCondition.notify_all();
+}
+
 void ossimToolServer::error(const char* msg)
 {
    perror(msg);
    exit (1);
 }
 
-void ossimToolServer::writeSocket(const char* buf, int bufsize)
+
+bool ossimToolServer::writeSocket(Connection& connection, const char* buf, int bufsize)
 {
    int remaining = bufsize;
    int n;
+   int flags = 0;
+#ifdef MSG_NOSIGNAL
+   flags = MSG_NOSIGNAL; // A client hanging up must not take the server down.
+#endif
 
-   //int optval = 1;
-   //setsockopt(clientfd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(int));
+   if (!connection.m_responseStarted)
+   {
+      connection.m_responseStarted = true;
+      m_firstByteMicroseconds += microsecondsSince(connection.m_requestStart);
+   }
 
    while (remaining)
    {
-      n = send(m_clisockfd, buf, remaining, 0);
+      n = send(connection.m_sockfd, buf, remaining, flags);
       if (n < 0)
-         error("ERROR writing to socket");
+      {
+         OWARN<<"ossimToolServer: ERROR writing to socket of "<<connection.m_peer<<endl;
+         return false;
+      }
       remaining -= n;
+      buf += n;
    }
+   return true;
 }
 
-bool ossimToolServer::sendFile(const ossimFilename& fname)
+bool ossimToolServer::sendFile(Connection& connection, const ossimFilename& fname)
 {
-   ostringstream xmsg;
-
    // Open the server-side image file:
    ifstream svrfile (fname.chars(), ios::binary|ios::in);
    if (svrfile.fail())
    {
-      xmsg<<"ossimToolServer.sendFile() -- Error opening file <"<<fname<<">."<<endl;
-      error(xmsg.str().c_str());
+      OWARN<<"ossimToolServer.sendFile() -- Error opening file <"<<fname<<">."<<endl;
+      return false;
    }
 
    // Determine file size:
@@ -249,92 +636,180 @@ bool ossimToolServer::sendFile(const ossimFilename& fname)
    char size_response[19];
    sprintf(size_response, "SIZE: %012d", (int) fsize);
    if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" sending <"<<size_response<<">"<<endl; //TODO REMOVE DEBUG
-   writeSocket(size_response, strlen(size_response));
-   if (!acknowledgeRcvd())
+   if (!writeSocket(connection, size_response, strlen(size_response)) ||
+       !acknowledgeRcvd(connection))
       return false;
 
    // Send file name to the client:
    char name_response[256];
    memset(name_response, 0, 256);
-   sprintf(name_response, "NAME: %s", fname.file().chars());
+   snprintf(name_response, 256, "NAME: %s", fname.file().chars());
    if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" sending <"<<name_response<<">"<<endl; //TODO REMOVE DEBUG
-   writeSocket(name_response, strlen(name_response));
-   if (!acknowledgeRcvd())
+   if (!writeSocket(connection, name_response, strlen(name_response)) ||
+       !acknowledgeRcvd(connection))
       return false;
 
-   memset(m_buffer, 0, MAX_BUF_LEN);
+   char* buffer = &connection.m_buffer.front();
+   memset(buffer, 0, MAX_BUF_LEN);
 
    // Send image in MAX_BUF_LEN byte packets
    int n = 0;
-   int r = 0;
    if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" sending binary data..."<<endl; //TODO REMOVE DEBUG
    while (!svrfile.eof())
    {
       // Read server-side file block:
-      svrfile.read(m_buffer, MAX_BUF_LEN);
+      svrfile.read(buffer, MAX_BUF_LEN);
       if (svrfile.bad())
-         error("ossimToolServer.sendFile() -- Error during file read()");
+      {
+         OWARN<<"ossimToolServer.sendFile() -- Error during file read()"<<endl;
+         return false;
+      }
 
       n = svrfile.gcount();
-      r += n;
 
       // transmit the block to the client:
-      writeSocket(m_buffer, n);
+      if (!writeSocket(connection, buffer, n))
+         return false;
    }
-   if (!acknowledgeRcvd())
+   if (!acknowledgeRcvd(connection))
       return false;
 
    cout << "Send complete."<<endl;
    svrfile.close();
    return true;
 }
-bool ossimToolServer::acknowledgeRcvd()
+
+bool ossimToolServer::acknowledgeRcvd(Connection& connection)
 {
+   char* buffer = &connection.m_buffer.front();
+   memset(buffer, 0, 12);
    if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Waiting to recv"<<endl; //TODO REMOVE DEBUG
-   int n = recv(m_clisockfd, m_buffer, 11, 0);
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Received <"<<m_buffer<<">"<<endl; //TODO REMOVE DEBUG
-   if (n < 0)
-      error("ossimToolServer: EOF encountered reading from port");
-   if (strcmp(m_buffer, "ok_to_send"))
+   int n = recv(connection.m_sockfd, buffer, 11, 0);
+   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Received <"<<buffer<<">"<<endl; //TODO REMOVE DEBUG
+   if (n <= 0)
+   {
+      OWARN<<"ossimToolServer: EOF encountered reading from "<<connection.m_peer<<endl;
+      return false;
+   }
+   if (strcmp(buffer, "ok_to_send"))
       return false;
    if (_DEBUG_) cout << "Send acknowledged by client."<<endl;
    return true;
 }
 
-bool ossimToolServer::runCommand(ossimString& command)
+bool ossimToolServer::runCommand(Connection& connection, ossimString& command)
 {
-   ostringstream xmsg;
-   bool status_ok = false;
-   static const char* msg = "\nossimToolServer.runCommand(): ";
-
    // Intercept test mode:
    if (command == "sendfile")
    {
       ossimFilename fname = command.after("sendfile").trim();
       const char* response = "FILE ";
-      writeSocket(response, strlen(response));
-      sendFile(fname);
-      return true;
+      return writeSocket(connection, response, strlen(response)) && sendFile(connection, fname);
+   }
+
+   // Intercept server statistics request:
+   if (command == "stats")
+   {
+      const char* response = "TEXT ";
+      string stats = getStatistics();
+      return writeSocket(connection, response, strlen(response)) &&
+             writeSocket(connection, stats.c_str(), stats.size()) &&
+             acknowledgeRcvd(connection);
    }
 
-   // Redirect stdout:
-   memset(m_buffer, 0, MAX_BUF_LEN);
-   int pipeDesc[2] = {0,0};
-   int savedStdout = dup( fileno(stdout) );
-   if( pipe( pipeDesc ) == -1 )
-      error("Could not redirect stdout (1).");
-   setbuf( stdout, NULL );
-   dup2( pipeDesc[1], fileno(stdout) );
+   ossimRefPtr<ossimTool> utility = 0;
+   bool status_ok = false;
+   string full_output;
+
+   if (m_numThreads)
+   {
+      // The workers share stdout, so each request writes to its own output stream:
+      ostringstream output;
+      bool exclusive = !isConcurrentSafe(command);
+      beginTool(exclusive);
+      {
+         RequestOutputCapture capture (output);
+         status_ok = executeCommand(command, utility, output);
+      }
+      endTool(exclusive);
+      full_output = output.str();
+   }
+   else
+   {
+      // Redirect stdout:
+      char* buffer = &connection.m_buffer.front();
+      memset(buffer, 0, MAX_BUF_LEN);
+      int pipeDesc[2] = {0,0};
+      int savedStdout = dup( fileno(stdout) );
+      if( pipe( pipeDesc ) == -1 )
+         error("Could not redirect stdout (1).");
+      setbuf( stdout, NULL );
+      dup2( pipeDesc[1], fileno(stdout) );
 
 #ifdef _MSC_VER
-   u_long iMode = 1;
-   ioctlsocket(pipeDesc[0], FIONBIO, &iMode);
+      u_long iMode = 1;
+      ioctlsocket(pipeDesc[0], FIONBIO, &iMode);
 #else
-   fcntl( pipeDesc[0], F_SETFL, O_NONBLOCK );
+      fcntl( pipeDesc[0], F_SETFL, O_NONBLOCK );
 #endif
 
+      status_ok = executeCommand(command, utility, cout);
+
+      // Stop redirecting stdout and copy the output stream buffer to local memory:
+      dup2( savedStdout, fileno(stdout) );
+      close( savedStdout );
+      close( pipeDesc[1] );
+      int n = MAX_BUF_LEN;
+      while (n == MAX_BUF_LEN)
+      {
+         n = read(pipeDesc[0], buffer, MAX_BUF_LEN);
+         if (n > 0)
+            full_output.append(buffer, n);
+      }
+      close( pipeDesc[0] );
+   }
+
+   if (status_ok)
+   {
+      if (utility.valid() && !utility->helpRequested() && utility->isChipProcessor())
+      {
+         const char* response = "FILE ";
+         ossimChipProcTool* ocp = (ossimChipProcTool*) utility.get();
+         ossimFilename prodFilename = ocp->getProductFilename();
+         status_ok = writeSocket(connection, response, strlen(response)) &&
+                     sendFile(connection, prodFilename);
+      }
+      else
+      {
+         const char* response = "TEXT ";
+         status_ok = writeSocket(connection, response, strlen(response)) &&
+                     writeSocket(connection, full_output.c_str(), full_output.size()) &&
+                     acknowledgeRcvd(connection);
+         if (!status_ok)
+            OWARN<<"ossimToolServer: ERROR receiving acknowledge from client."<<endl;
+      }
+      if (!status_ok)
+         closeConnection(connection);
+   }
+   else
+   {
+      const char* response = "ERROR";
+      writeSocket(connection, response, strlen(response));
+      writeSocket(connection, full_output.c_str(), full_output.size());
+      cout << "Sending ERROR to client and closing connection: <"<<full_output<<">"<<endl;
+      closeConnection(connection);
+   }
+
+   return status_ok;
+}
+
+bool ossimToolServer::executeCommand(ossimString& command, ossimRefPtr<ossimTool>& utility,
+                                     std::ostream& out)
+{
+   bool status_ok = false;
+   static const char* msg = "\nossimToolServer.runCommand(): ";
+
    ossimToolFactoryBase* factory = ossimToolRegistry::instance();
-   ossimRefPtr<ossimTool> utility = 0;
 
    // Intercept help request:
    ossimString c1 = command.before(" ");
@@ -352,10 +827,10 @@ bool ossimToolServer::runCommand(ossimString& command)
             map<string, string> capabilities;
             factory->getCapabilities(capabilities);
             map<string, string>::iterator iter = capabilities.begin();
-            cout<<"\nAvailable commands:\n"<<endl;
+            out<<"\nAvailable commands:\n"<<endl;
             for (;iter != capabilities.end(); ++iter)
-               cout<<"  "<<iter->first<<" -- "<<iter->second<<endl;
-            cout<<"\nUse option \"--help\" with above commands to get detailed tool command."<<endl;
+               out<<"  "<<iter->first<<" -- "<<iter->second<<endl;
+            out<<"\nUse option \"--help\" with above commands to get detailed tool command."<<endl;
             status_ok = true;
             break;
          }
@@ -364,111 +839,83 @@ bool ossimToolServer::runCommand(ossimString& command)
       ossimArgumentParser ap (command);
       ossimString util_name = ap[0];
       utility = factory->createTool(util_name);
+      if (utility.valid())
+         utility->setOutputStream(&out);
 
       try
       {
          // Perform OSSIM command execution:
          if (!utility.valid())
-            cout<<msg<<"Did not understand command <"<<util_name<<">"<<endl;
+            out<<msg<<"Did not understand command <"<<util_name<<">"<<endl;
          else if (!utility->initialize(ap))
-            cout<<msg<<"Could not execute command sequence <"<<command<<">."<<endl;
+            out<<msg<<"Could not execute command sequence <"<<command<<">."<<endl;
          else if (!utility->helpRequested() && !utility->execute())
-            cout<<msg<<"Error encountered executing\n    <"<<command <<">\nCheck options."<<endl;
+            out<<msg<<"Error encountered executing\n    <"<<command <<">\nCheck options."<<endl;
          else
             status_ok = true;
       }
       catch (ossimException& x)
       {
-         cout << msg << "Caught OSSIM exception: "<<x.what()<<endl;
+         out << msg << "Caught OSSIM exception: "<<x.what()<<endl;
       }
       catch (exception& x)
       {
-         cout << msg << "Caught unknown exception: "<<x.what()<<endl;
+         out << msg << "Caught unknown exception: "<<x.what()<<endl;
       }
 
       break;
    }
 
-   // Stop redirecting stdout and copy the output stream buffer to local memory:
-   dup2( savedStdout, fileno(stdout) );
-   int n = MAX_BUF_LEN;
-   string full_output;
-   while (n == MAX_BUF_LEN)
-   {
-       n = read(pipeDesc[0], m_buffer, MAX_BUF_LEN);
-       if (n > 0)
-          full_output.append(m_buffer, n);
-   }
-
-   if (status_ok)
-   {
-      if (utility.valid() && !utility->helpRequested() && utility->isChipProcessor())
-      {
-         const char* response = "FILE ";
-         writeSocket(response, strlen(response));
-         ossimChipProcTool* ocp = (ossimChipProcTool*) utility.get();
-         ossimFilename prodFilename = ocp->getProductFilename();
-         sendFile(prodFilename);
-      }
-      else
-      {
-         const char* response = "TEXT ";
-         writeSocket(response, strlen(response));
-         writeSocket(full_output.c_str(), full_output.size());
-         if (!acknowledgeRcvd())
-            error("ERROR receiving acknowledge from client.");
-      }
-   }
-   else
-   {
-      const char* response = "ERROR";
-      writeSocket(response, strlen(response));
-      writeSocket(full_output.c_str(), full_output.size());
-      cout << "Sending ERROR to client and closing connection: <"<<full_output<<">"<<endl;
-      close(m_clisockfd);
-   }
-
    return status_ok;
 }
 
-bool ossimToolServer::processOssimRequest(struct sockaddr_in& cli_addr)
+bool ossimToolServer::processOssimRequest(Connection& connection)
 {
-   char dst[INET6_ADDRSTRLEN];
-
    // TEST CODE:
    cout << "\nprocessOssimRequest() -- Process ID: "<<getpid()<<endl;
    cout <<   "                  Parent process ID: "<<getppid()<<endl;
 
-   // Clear the input m_buffer and read the message sent:
-   memset(m_buffer, 0, MAX_BUF_LEN);
+   // Clear the input buffer and read the message sent:
+   char* buffer = &connection.m_buffer.front();
+   memset(buffer, 0, MAX_BUF_LEN + 1);
    if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Waiting to recv"<<endl; //TODO REMOVE DEBUG
-   int n = recv(m_clisockfd, m_buffer, MAX_BUF_LEN, 0);
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Received <"<<m_buffer<<">"<<endl; //TODO REMOVE DEBUG
+   int n = recv(connection.m_sockfd, buffer, MAX_BUF_LEN, 0);
+   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Received <"<<buffer<<">"<<endl; //TODO REMOVE DEBUG
    if (n < 0)
-      error("ossimToolServer: EOF encountered reading from port");
-
-   // If message received, acknowledge back:
-   if (n != 0)
    {
-      // Log the message received:
-      void* addr = &(cli_addr.sin_addr);
-      if (!inet_ntop(AF_INET, addr, dst, INET6_ADDRSTRLEN))
-         error("ossimToolServer: Error returned from inet_ntop(). ");
-      cout << "\nossimToolServer: received message from: "<<dst<<"\n---------------\n"<<m_buffer
-            <<"\n---------------\n"<< endl;
+      OWARN<<"ossimToolServer: EOF encountered reading from "<<connection.m_peer<<endl;
+      return false;
+   }
 
-      // process request:
-      ossimString command (m_buffer);
-      command.trim();
+   // Nothing received means the client hung up:
+   if (n == 0)
+      return false;
 
-      if (command == "goodbye")
-      {
-         close(m_clisockfd);
-         return true;
-      }
+   connection.m_requestStart = std::chrono::steady_clock::now();
+   connection.m_responseStarted = false;
 
-      runCommand(command);
-      return true;
-   }
-   return false;
+   // Log the message received:
+   cout << "\nossimToolServer: received message from: "<<connection.m_peer
+         <<"\n---------------\n"<<buffer<<"\n---------------\n"<< endl;
+
+   // process request:
+   ossimString command (buffer);
+   command.trim();
+
+   if (command == "goodbye")
+      return false;
+
+   ++m_requestCount;
+   updateMax(m_maxActiveRequests, ++m_activeRequests);
+
+   bool status_ok = runCommand(connection, command);
+
+   --m_activeRequests;
+   ossim_uint64 latency = microsecondsSince(connection.m_requestStart);
+   m_latencyMicroseconds += latency;
+   updateMax(m_maxLatencyMicroseconds, latency);
+   if (!status_ok)
+      ++m_errorCount;
+
+   return status_ok;
 }
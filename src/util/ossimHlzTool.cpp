@@ -673,6 +673,7 @@ bool ossimHlzTool::PatchProcessorJob::level2Test()
       return false;
 
    ossimPointBlock pc_block(0, ossimPointRecord::ReturnNumber|ossimPointRecord::NumberOfReturns);
+   pc_block.setColumnar(true);
    pc_src->getBlock(grect, pc_block);
    if (pc_block.empty())
       return false;
@@ -686,7 +687,7 @@ bool ossimHlzTool::PatchProcessorJob::level2Test()
    for (ossim_uint32 i=0; (i<numPoints) && !found_obstruction; ++i)
    {
       //If this is not the only return, implies clutter along the ray:
-      int num_returns = (int) pc_block[i]->getField(ossimPointRecord::NumberOfReturns);
+      int num_returns = (int) pc_block.getField(i, ossimPointRecord::NumberOfReturns);
       if (num_returns > 1)
       {
          found_obstruction = true;
@@ -2705,6 +2705,7 @@ std::ostream& ossimInfo::printConfiguration(std::ostream& out) const
 
 void ossimInfo::printFactories(bool keywordListFlag)const
 {
+   std::ostream& out = ossimNotify(ossimNotifyLevel_INFO);
    std::vector<ossimString> typeList;
    ossimObjectFactoryRegistry::instance()->getTypeNameList(typeList);
    for(int i = 0; i < (int)typeList.size(); ++i)
@@ -2714,18 +2715,18 @@ void ossimInfo::printFactories(bool keywordListFlag)const
          ossimObject* obj = ossimObjectFactoryRegistry::instance()->createObject(typeList[i]);
          if(obj)
          {
-            cout << typeList[i] << endl;
-            cout << "______________________________________________________" << endl;
+            out << typeList[i] << endl;
+            out << "______________________________________________________" << endl;
             ossimKeywordlist kwl;
             obj->saveState(kwl);
-            cout << kwl << endl;
-            cout << "______________________________________________________" << endl;
+            out << kwl << endl;
+            out << "______________________________________________________" << endl;
             delete obj;
          }
       }
       else
       {
-         cout << typeList[i] << endl;
+         out << typeList[i] << endl;
       }
    }  
 }
@@ -26,7 +26,8 @@ using namespace std;
 
 ossimPointCloudTool::ossimPointCloudTool()
 :  m_operation (LOWEST_DEM),
-   m_gsd (0)
+   m_gsd (0),
+   m_buildIndex (false)
 {
 }
 
@@ -60,6 +61,10 @@ void ossimPointCloudTool::addArguments(ossimArgumentParser& ap)
          "mapping the single-band output image to an RGB. The LUT provided must be "
          "in the ossimIndexToRgbLutFilter format and must handle the three output "
          "viewshed values (see --values option).");
+   au->addCommandLineOption(
+         "--build-index",
+         "Builds the spatial index sidecar (.pci) of the point cloud if missing or out of date. "
+         "Region reads of the cloud use it to skip points outside the region.");
    au->addCommandLineOption(
          "--method",
          "Specify the desired operation. Possible values are:\n"
@@ -112,6 +117,9 @@ bool ossimPointCloudTool::initialize(ossimArgumentParser& ap)
    if ( ap.read("--lut", sp1) )
       m_lutFile = ts1;
 
+   if ( ap.read("--build-index") )
+      m_buildIndex = true;
+
    if ( ap.read("--method", sp1) )
    {
       if (ts1.contains("highest-dem") || ts1.contains("h-d"))
@@ -185,6 +193,13 @@ bool ossimPointCloudTool::loadPC()
       return false;
    }
 
+   if (m_buildIndex && !m_pcHandler->getIndex().valid() && !m_pcHandler->buildIndex())
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimPointCloudTool::loadPC WARN: Cannot build index for <"<<m_pcFile
+            <<">, reading without it.\n" << std::endl;
+   }
+
    // Use "rasterized" PC to establish best output image geometry:
    m_pciHandler = new ossimPointCloudImageHandler;
    m_pciHandler->setPointCloudHandler(m_pcHandler.get());
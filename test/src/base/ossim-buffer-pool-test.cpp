@@ -0,0 +1,184 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::BufferPool.  Checks the hit, miss and
+//              drop counts, the byte cap, flush of the buffers cached by
+//              another thread, and the recycling of tile buffers through
+//              ossimImageDataFactory.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/BufferPool.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/init/ossimInit.h>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+typedef ossim::BufferPool::Buffer Buffer;
+
+static bool check( const char* name, bool ok, bool& test_failed )
+{
+   cout << name << "? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   // Read by ossimImageDataFactory when first created:
+   ossimPreferences::instance()->addPreference(
+      "ossim.imaging.image_data_factory.pool.enabled", "true" );
+   ossimPreferences::instance()->addPreference(
+      "ossim.imaging.image_data_factory.pool.max_size", "1" );
+
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+   ossim::BufferPool* pool = ossim::BufferPool::instance();
+
+   // Tile recycling through the factory, enabled from the preferences:
+   {
+      ossimRefPtr<ossimImageData> tile =
+         ossimImageDataFactory::instance()->create( 0, OSSIM_UINT16, 3, 64, 64 );
+      check( "factory enables the pool from the preferences",
+             pool->getEnabled() && ( pool->getMaxBytes() == 1024 * 1024 ), test_failed );
+
+      tile->initialize();
+      tile = 0;
+      ossim_uint64 pooled = pool->getPooledBytes();
+      ossim_uint64 hits = pool->getHitCount();
+
+      tile = ossimImageDataFactory::instance()->create( 0, OSSIM_UINT16, 3, 64, 64 );
+      tile->initialize();
+      bool ok = ( pooled == 64 * 64 * 3 * 2 ) && ( pool->getHitCount() == hits + 1 ) &&
+         ( pool->getPooledBytes() == 0 ) && ( tile->getDataObjectStatus() == OSSIM_EMPTY );
+      tile = 0;
+      check( "released tile buffer is reused blank", ok, test_failed );
+   }
+   pool->flush();
+
+   // Hits only for the same size, misses counted:
+   {
+      ossim_uint64 hits = pool->getHitCount();
+      ossim_uint64 misses = pool->getMissCount();
+      Buffer a( 1000 );
+      pool->release( a );
+      Buffer b;
+      bool ok = a.empty() && ( pool->getPooledBytes() == 1000 ) &&
+         !pool->acquire( b, 999 ) && b.empty() &&
+         pool->acquire( b, 1000 ) && ( b.size() == 1000 ) &&
+         !pool->acquire( a, 1000 ) &&
+         ( pool->getHitCount() == hits + 1 ) && ( pool->getMissCount() == misses + 2 ) &&
+         ( pool->getPooledBytes() == 0 );
+      check( "hit and miss counts", ok, test_failed );
+   }
+
+   // Past the cap buffers are freed and counted as drops:
+   {
+      pool->setMaxBytes( 10000 );
+      ossim_uint64 drops = pool->getDropCount();
+      vector<Buffer> buffers( 20, Buffer( 1000 ) );
+      for ( ossim_uint32 i = 0; i < buffers.size(); ++i )
+      {
+         pool->release( buffers[i] );
+      }
+      bool ok = ( pool->getPooledBytes() == 10000 ) &&
+         ( pool->getDropCount() == drops + 10 );
+      check( "cap on the pooled bytes", ok, test_failed );
+      pool->flush();
+      check( "flush frees everything", pool->getPooledBytes() == 0, test_failed );
+   }
+
+   // Releases from several threads at once must not overshoot the cap:
+   {
+      pool->setMaxBytes( 50000 );
+      vector<std::thread> threads;
+      for ( ossim_uint32 t = 0; t < 4; ++t )
+      {
+         threads.push_back( std::thread( [pool]()
+         {
+            for ( ossim_uint32 i = 0; i < 40; ++i )
+            {
+               Buffer buffer( 1000 );
+               pool->release( buffer );
+               if ( pool->getPooledBytes() > pool->getMaxBytes() )
+               {
+                  cout << "over the cap: " << pool->getPooledBytes() << endl;
+               }
+            }
+         } ) );
+      }
+      for ( ossim_uint32 t = 0; t < threads.size(); ++t )
+      {
+         threads[t].join();
+      }
+      // The threads' own buffers went to the shared list at thread exit:
+      check( "cap holds across threads", pool->getPooledBytes() == 50000, test_failed );
+      pool->flush();
+   }
+
+   //---
+   // A flush from one thread also empties the cache of another, on that
+   // thread's next use of the pool:
+   //---
+   {
+      pool->setMaxBytes( 1024 * 1024 );
+      std::mutex mutex;
+      std::condition_variable condition;
+      int step = 0;
+      bool ok = false;
+      std::thread other( [&]()
+      {
+         Buffer buffer( 500 );
+         pool->release( buffer );
+         {
+            std::unique_lock<std::mutex> lock( mutex );
+            step = 1;
+            condition.notify_all();
+            condition.wait( lock, [&step]() { return step == 2; } );
+         }
+         Buffer again;
+         ok = !pool->acquire( again, 500 ) && ( pool->getPooledBytes() == 0 );
+      } );
+      {
+         std::unique_lock<std::mutex> lock( mutex );
+         condition.wait( lock, [&step]() { return step == 1; } );
+      }
+      bool held = ( pool->getPooledBytes() == 500 );
+      pool->flush();
+      {
+         std::lock_guard<std::mutex> lock( mutex );
+         step = 2;
+      }
+      condition.notify_all();
+      other.join();
+      check( "flush reaches another thread's buffers", held && ok, test_failed );
+   }
+
+   // Disabled, nothing is kept:
+   {
+      Buffer a( 100 );
+      pool->release( a );
+      pool->setEnabled( false );
+      Buffer b( 100 );
+      pool->release( b );
+      Buffer c;
+      bool ok = ( pool->getPooledBytes() == 0 ) && !pool->acquire( c, 100 );
+      check( "disabling empties the pool", ok, test_failed );
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
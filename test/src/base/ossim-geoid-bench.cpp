@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Times the geoid manager over random ground points, one point
+//              per call and in one batch call, and checks they agree.
+//              Geoids come from the preferences file as usual.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimGeoidManager.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/init/ossimInit.h>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static void usage( const std::string& app )
+{
+   cout << app << " [-n <points>]\n"
+        << "\nQueries the configured geoids at <points> random locations (default"
+        << "\n1000000) with offsetFromEllipsoid and offsetsFromEllipsoid.\n" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+   ossimArgumentParser ap(&argc, argv);
+   ossimInit::instance()->initialize(ap);
+
+   ossim_uint32 count = 1000000;
+   std::string ts;
+   ossimArgumentParser::ossimParameter sp(ts);
+   if ( ap.read("-n", sp) )
+   {
+      count = ossimString(ts).toUInt32();
+   }
+   if ( (ap.argc() > 1) || (count == 0) )
+   {
+      usage( std::string(argv[0]) );
+      return 1;
+   }
+
+   std::vector<ossimGpt> gpts( count );
+   std::srand( 1 );
+   for ( ossim_uint32 i = 0; i < count; ++i )
+   {
+      gpts[i] = ossimGpt( std::rand() * 180.0 / RAND_MAX - 90.0,
+                          std::rand() * 360.0 / RAND_MAX - 180.0 );
+   }
+
+   ossimGeoidManager* mgr = ossimGeoidManager::instance();
+   ossimTimer* timer = ossimTimer::instance();
+
+   std::vector<double> single( count );
+   timer->setStartTick();
+   for ( ossim_uint32 i = 0; i < count; ++i )
+   {
+      single[i] = mgr->offsetFromEllipsoid( gpts[i] );
+   }
+   double singleTime = timer->time_s();
+
+   std::vector<double> batch( count );
+   timer->setStartTick();
+   mgr->offsetsFromEllipsoid( &gpts.front(), count, &batch.front() );
+   double batchTime = timer->time_s();
+
+   ossim_uint32 mismatches = 0;
+   ossim_uint32 nans = 0;
+   for ( ossim_uint32 i = 0; i < count; ++i )
+   {
+      if ( ossim::isnan( single[i] ) )
+      {
+         ++nans;
+         if ( !ossim::isnan( batch[i] ) ) ++mismatches;
+      }
+      else if ( single[i] != batch[i] )
+      {
+         ++mismatches;
+      }
+   }
+
+   cout << std::setiosflags(ios::fixed) << std::setprecision(6)
+        << "points:       " << count
+        << "\nsingle:       " << singleTime << " s"
+        << "\nbatch:        " << batchTime << " s"
+        << "\nspeedup:      " << std::setprecision(2)
+        << ( batchTime > 0.0 ? singleTime / batchTime : 0.0 )
+        << "\nno offset:    " << nans
+        << "\nmismatches:   " << mismatches << endl;
+
+   return mismatches ? 1 : 0;
+}
@@ -0,0 +1,265 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::GeoidGrid and the grid lookups of
+//              ossimGeoidImage on small synthetic grids.  Checks the 16 bit
+//              storage against 32 bit floats, bicubic falling back to
+//              bilinear at nulls and edges, and the affine shortcut of
+//              ossimGeoidImage against worldToLocal.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/GeoidGrid.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimDatumFactory.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGeoidImage.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/projection/ossimEquDistCylProjection.h>
+#include <ossim/projection/ossimMercatorProjection.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim_uint32 WIDTH  = 40;
+static const ossim_uint32 HEIGHT = 30;
+
+// Smooth, geoid like values of tens of meters:
+static double surface( double x, double y )
+{
+   return 30.0 * std::sin( x * 0.21 ) * std::cos( y * 0.17 ) + 0.5 * x - 0.3 * y - 12.0;
+}
+
+// Catmull-Rom reproduces quadratics, bilinear does not:
+static double quadratic( double x, double y )
+{
+   return 0.02 * x * x - 0.03 * y * y + 0.01 * x * y + 0.5 * x - 2.0;
+}
+
+static void fillGrid( ossim::GeoidGrid& grid, ossim::GeoidGrid::Storage storage,
+                      double ( *f )( double, double ) )
+{
+   std::vector<ossim_float32> posts( WIDTH * HEIGHT );
+   for ( ossim_uint32 y = 0; y < HEIGHT; ++y )
+   {
+      for ( ossim_uint32 x = 0; x < WIDTH; ++x )
+      {
+         posts[y * WIDTH + x] = static_cast<ossim_float32>( f( x, y ) );
+      }
+   }
+   grid.create( WIDTH, HEIGHT, storage, 0.01 );
+   grid.setPosts( 0, HEIGHT, &posts.front(), -32767.0 );
+}
+
+// Grid lookups of ossimGeoidImage without an image file behind them.
+class TestGeoidImage : public ossimGeoidImage
+{
+public:
+   bool setGeometry( ossimImageGeometry* geom, const ossimIrect& rect )
+   {
+      m_geom = geom;
+      m_imageRect = rect;
+      computeAffine();
+      return m_affineFlag;
+   }
+
+   ossimDpt gridPoint( const ossimGpt& gpt ) const
+   {
+      return toGridPoint( gpt, ossimDatumFactory::instance()->wgs84() );
+   }
+
+   ossim::GeoidGrid& getGrid() { return m_grid; }
+};
+
+static bool check( const char* name, bool ok, bool& test_failed )
+{
+   cout << name << "? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+
+   //---
+   // 16 bit posts of 1 cm steps round by half a step at most, and bilinear
+   // weights between posts are positive and sum to one.  The float posts
+   // carry their own rounding, allowed for.
+   //---
+   {
+      ossim::GeoidGrid floats;
+      ossim::GeoidGrid shorts;
+      fillGrid( floats, ossim::GeoidGrid::FLOAT32_STORAGE, surface );
+      fillGrid( shorts, ossim::GeoidGrid::SINT16_STORAGE, surface );
+      const double TOLERANCE = 0.005 + 1.0e-5;
+      double maxDiff = 0.0;
+      for ( ossim_uint32 y = 0; y < HEIGHT; ++y )
+      {
+         for ( ossim_uint32 x = 0; x < WIDTH; ++x )
+         {
+            maxDiff = std::max( maxDiff, std::fabs( floats.getPost( x, y ) -
+                                                    shorts.getPost( x, y ) ) );
+         }
+      }
+      // Between the posts, past the outer ones bilinear extrapolates:
+      for ( double y = 0.0; y <= HEIGHT - 1.0; y += 0.37 )
+      {
+         for ( double x = 0.0; x <= WIDTH - 1.0; x += 0.41 )
+         {
+            maxDiff = std::max( maxDiff, std::fabs( floats.interpolate( x, y ) -
+                                                    shorts.interpolate( x, y ) ) );
+         }
+      }
+      bool ok = ( maxDiff <= TOLERANCE ) &&
+         ( shorts.getSizeInBytes() * 2 == floats.getSizeInBytes() );
+      cout << "int16 max difference " << maxDiff << " m" << endl;
+      check( "int16 storage within 0.5 cm of float32", ok, test_failed );
+   }
+
+   // Nulls stay null in both storages and get no weight:
+   {
+      bool ok = true;
+      for ( int s = 0; s < 2; ++s )
+      {
+         ossim::GeoidGrid grid;
+         fillGrid( grid, s ? ossim::GeoidGrid::SINT16_STORAGE :
+                   ossim::GeoidGrid::FLOAT32_STORAGE, surface );
+         std::vector<ossim_float32> nullRow( WIDTH, -32767.0f );
+         grid.setPosts( 10, 1, &nullRow.front(), -32767.0 );
+         ok = ok && ossim::isnan( grid.getPost( 5, 10 ) ) &&
+            ( std::fabs( grid.interpolate( 5.0, 9.5 ) - grid.getPost( 5, 9 ) ) < 1.0e-9 ) &&
+            ossim::isnan( grid.interpolate( 5.0, 10.0 ) ) &&
+            ossim::isnan( grid.interpolate( -0.6, 3.0 ) ) &&
+            ossim::isnan( grid.interpolate( 3.0, HEIGHT - 0.5 ) ) &&
+            ossim::isnan( grid.interpolate( ossim::nan(), 3.0 ) );
+      }
+      check( "null posts carry no weight", ok, test_failed );
+   }
+
+   //---
+   // Bicubic: exact on a quadratic where the 4 x 4 neighborhood is complete,
+   // the bilinear value next to the edges and around a null.
+   //---
+   {
+      ossim::GeoidGrid grid;
+      fillGrid( grid, ossim::GeoidGrid::FLOAT32_STORAGE, quadratic );
+      std::vector<ossim_float32> row( WIDTH );
+      for ( ossim_uint32 x = 0; x < WIDTH; ++x )
+      {
+         row[x] = ( x == 20 ) ? -32767.0f : static_cast<ossim_float32>( quadratic( x, 15 ) );
+      }
+      grid.setPosts( 15, 1, &row.front(), -32767.0 );
+
+      bool interiorOk = true;
+      bool fallbackOk = true;
+      ossim_uint32 interior = 0;
+      ossim_uint32 fallbacks = 0;
+      for ( double y = -0.45; y < HEIGHT - 0.5; y += 0.23 )
+      {
+         for ( double x = -0.45; x < WIDTH - 0.5; x += 0.29 )
+         {
+            double cubic  = grid.interpolate( x, y, ossim::GeoidGrid::BICUBIC );
+            double linear = grid.interpolate( x, y, ossim::GeoidGrid::BILINEAR );
+            ossim_int32 x0 = std::min( std::max( (ossim_int32)x, 0 ), (ossim_int32)WIDTH - 2 );
+            ossim_int32 y0 = std::min( std::max( (ossim_int32)y, 0 ), (ossim_int32)HEIGHT - 2 );
+            bool nearNull = ( x0 >= 18 ) && ( x0 <= 21 ) && ( y0 >= 13 ) && ( y0 <= 16 );
+            bool full = ( x >= 0.0 ) && ( y >= 0.0 ) && ( x0 >= 1 ) && ( y0 >= 1 ) &&
+               ( x0 + 2 < (ossim_int32)WIDTH ) && ( y0 + 2 < (ossim_int32)HEIGHT ) && !nearNull;
+            if ( full )
+            {
+               interiorOk &= ( std::fabs( cubic - quadratic( x, y ) ) < 1.0e-4 );
+               ++interior;
+            }
+            else
+            {
+               fallbackOk &= ( ( ossim::isnan( cubic ) && ossim::isnan( linear ) ) ||
+                               ( cubic == linear ) );
+               ++fallbacks;
+            }
+         }
+      }
+      // Bilinear is off the quadratic between posts, so the interior test means something:
+      double x = 10.5;
+      double y = 10.5;
+      bool bilinearOff = ( std::fabs( grid.interpolate( x, y ) - quadratic( x, y ) ) > 1.0e-3 );
+      check( "bicubic exact on a quadratic inside the grid",
+             interiorOk && bilinearOff && ( interior > 1000 ), test_failed );
+      check( "bicubic falls back to bilinear at nulls and edges",
+             fallbackOk && ( fallbacks > 100 ), test_failed );
+   }
+
+   //---
+   // The affine shortcut of ossimGeoidImage against worldToLocal, and the
+   // grid lookups through it.  Mercator is not affine in latitude and must
+   // keep using worldToLocal.
+   //---
+   {
+      ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+      proj->setDecimalDegreesPerPixel( ossimDpt( 0.25, 0.25 ) );
+      proj->setUlTiePoints( ossimGpt( 50.0, -10.0, 0.0 ) );
+      ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry( 0, proj.get() );
+      const ossimIrect RECT( 0, 0, WIDTH - 1, HEIGHT - 1 );
+
+      ossimRefPtr<TestGeoidImage> geoid = new TestGeoidImage();
+      bool ok = geoid->setGeometry( geom.get(), RECT );
+      fillGrid( geoid->getGrid(), ossim::GeoidGrid::FLOAT32_STORAGE, surface );
+
+      std::vector<ossimGpt> gpts;
+      for ( double lat = 51.0; lat > 41.0; lat -= 0.173 )
+      {
+         for ( double lon = -11.0; lon < 0.5; lon += 0.191 )
+         {
+            gpts.push_back( ossimGpt( lat, lon, 0.0 ) );
+         }
+      }
+      std::vector<double> batch( gpts.size() );
+      geoid->offsetsFromEllipsoid( &gpts.front(), (ossim_uint32)gpts.size(), &batch.front() );
+
+      double maxDiff = 0.0;
+      for ( ossim_uint32 i = 0; ok && ( i < gpts.size() ); ++i )
+      {
+         ossimDpt expected;
+         geom->worldToLocal( gpts[i], expected );
+         ossimDpt actual = geoid->gridPoint( gpts[i] );
+         maxDiff = std::max( maxDiff, std::max( std::fabs( expected.x - actual.x ),
+                                                std::fabs( expected.y - actual.y ) ) );
+         double offset = geoid->offsetFromEllipsoid( gpts[i] );
+         double direct = geoid->getGrid().interpolate( expected.x, expected.y );
+         ok = ( ossim::isnan( offset ) == ossim::isnan( direct ) ) &&
+            ( ossim::isnan( offset ) || ( std::fabs( offset - direct ) < 1.0e-6 ) ) &&
+            ( ossim::isnan( offset ) == ossim::isnan( batch[i] ) ) &&
+            ( ossim::isnan( offset ) || ( offset == batch[i] ) );
+      }
+      cout << "affine max difference " << maxDiff << " pixels" << endl;
+      check( "affine shortcut matches worldToLocal", ok && ( maxDiff < 1.0e-6 ), test_failed );
+
+      ossimRefPtr<ossimMercatorProjection> mercator = new ossimMercatorProjection();
+      mercator->setMetersPerPixel( ossimDpt( 25000.0, 25000.0 ) );
+      mercator->setUlTiePoints( ossimGpt( 50.0, -10.0, 0.0 ) );
+      ossimRefPtr<ossimImageGeometry> mercatorGeom =
+         new ossimImageGeometry( 0, mercator.get() );
+      ok = !geoid->setGeometry( mercatorGeom.get(), RECT );
+      ossimDpt expected;
+      mercatorGeom->worldToLocal( gpts[100], expected );
+      ossimDpt actual = geoid->gridPoint( gpts[100] );
+      ok = ok && ( std::fabs( expected.x - actual.x ) < 1.0e-9 ) &&
+         ( std::fabs( expected.y - actual.y ) < 1.0e-9 );
+      check( "no affine shortcut for mercator", ok, test_failed );
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
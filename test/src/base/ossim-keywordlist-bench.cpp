@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Times ossimKeywordlist loading and lookups over real keyword
+//              list files, e.g. image .geom files.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/init/ossimInit.h>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static void usage( const std::string& app )
+{
+   cout << app << " [-i <iterations>] <file.geom> [file2.geom ...]\n"
+        << "\nLoads each keyword list <iterations> times (default 100), then times"
+        << "\nfind, getNumberOfSubstringKeys and findAllKeysThatMatch on the loaded"
+        << "\nlists.\n" << endl;
+}
+
+static void report( const std::string& label, double seconds, ossim_uint64 count )
+{
+   cout << std::setiosflags(ios::fixed) << std::setprecision(6)
+        << std::setw(32) << std::left << label
+        << seconds << " s  "
+        << std::setprecision(3)
+        << ( count ? seconds * 1.0e6 / count : 0.0 ) << " us/op  ("
+        << count << " ops)" << std::right << endl;
+}
+
+int main(int argc, char* argv[])
+{
+   ossimArgumentParser ap(&argc, argv);
+   ossimInit::instance()->initialize(ap);
+
+   ossim_uint32 iterations = 100;
+   std::string ts;
+   ossimArgumentParser::ossimParameter sp(ts);
+   if ( ap.read("-i", sp) )
+   {
+      iterations = ossimString(ts).toUInt32();
+   }
+
+   if ( (ap.argc() < 2) || (iterations == 0) )
+   {
+      usage( std::string(argv[0]) );
+      return 1;
+   }
+
+   std::vector<ossimFilename> files;
+   for ( int i = 1; i < ap.argc(); ++i )
+   {
+      files.push_back( ossimFilename(ap[i]) );
+   }
+
+   ossimTimer* timer = ossimTimer::instance();
+
+   // Load:
+   std::vector<ossimKeywordlist> kwls( files.size() );
+   ossim_uint64 keyCount = 0;
+   ossim_uint64 loads = 0;
+   timer->setStartTick();
+   for ( ossim_uint32 i = 0; i < iterations; ++i )
+   {
+      for ( std::vector<ossimFilename>::size_type f = 0; f < files.size(); ++f )
+      {
+         ossimKeywordlist kwl;
+         if ( kwl.addFile( files[f] ) )
+         {
+            ++loads;
+            if ( i == 0 )
+            {
+               keyCount += kwl.getSize();
+               kwls[f] = kwl;
+            }
+         }
+         else if ( i == 0 )
+         {
+            cerr << "Could not load: " << files[f] << endl;
+         }
+      }
+   }
+   report( "addFile", timer->time_s(), loads );
+   cout << "keys per pass: " << keyCount << "\n" << endl;
+
+   // Every key of every list, looked up as prefix + key:
+   ossim_uint64 finds = 0;
+   ossim_uint64 found = 0;
+   timer->setStartTick();
+   for ( ossim_uint32 i = 0; i < iterations; ++i )
+   {
+      for ( std::vector<ossimKeywordlist>::size_type f = 0; f < kwls.size(); ++f )
+      {
+         const ossimKeywordlist::KeywordMap& map = kwls[f].getMap();
+         ossimKeywordlist::KeywordMap::const_iterator iter = map.begin();
+         while ( iter != map.end() )
+         {
+            const std::string& key = iter->first;
+            std::string::size_type dot = key.find_last_of( '.' );
+            const char* value = 0;
+            if ( dot != std::string::npos )
+            {
+               std::string prefix = key.substr( 0, dot + 1 );
+               value = kwls[f].find( prefix.c_str(), key.c_str() + dot + 1 );
+            }
+            else
+            {
+               value = kwls[f].find( key.c_str() );
+            }
+            if ( value ) ++found;
+            ++finds;
+            ++iter;
+         }
+      }
+   }
+   report( "find(prefix, key)", timer->time_s(), finds );
+   if ( found != finds )
+   {
+      cerr << "find missed " << (finds - found) << " keys!" << endl;
+   }
+
+   // Typical prefix queries made by the projection and image handler loaders:
+   const char* SUBSTRINGS[] = { "image0.", "band", "projection.", "tie_point", 0 };
+   ossim_uint64 substringQueries = 0;
+   ossim_uint64 substringKeys = 0;
+   timer->setStartTick();
+   for ( ossim_uint32 i = 0; i < iterations; ++i )
+   {
+      for ( std::vector<ossimKeywordlist>::size_type f = 0; f < kwls.size(); ++f )
+      {
+         for ( int s = 0; SUBSTRINGS[s]; ++s )
+         {
+            substringKeys += kwls[f].getNumberOfSubstringKeys( ossimString("^") + SUBSTRINGS[s] );
+            ++substringQueries;
+         }
+      }
+   }
+   report( "getNumberOfSubstringKeys", timer->time_s(), substringQueries );
+
+   ossim_uint64 matchQueries = 0;
+   ossim_uint64 matchKeys = 0;
+   timer->setStartTick();
+   for ( ossim_uint32 i = 0; i < iterations; ++i )
+   {
+      for ( std::vector<ossimKeywordlist>::size_type f = 0; f < kwls.size(); ++f )
+      {
+         std::vector<ossimString> keys;
+         kwls[f].findAllKeysThatMatch( keys, ossimString("^image0\\.") );
+         matchKeys += keys.size();
+         ++matchQueries;
+      }
+   }
+   report( "findAllKeysThatMatch", timer->time_s(), matchQueries );
+
+   cout << "\nsubstring keys: " << substringKeys
+        << "\nmatched keys:   " << matchKeys << endl;
+
+   return 0;
+}
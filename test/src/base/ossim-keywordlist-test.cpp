@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <vector>
 #include <ossim/init/ossimInit.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimTempFilename.h>
@@ -295,6 +298,156 @@ bool runIncludeTest()
    return test_failed;
 }
 
+// Parses input and compares the whole map with the expected pairs.
+bool checkParse( const std::string& name,
+                 const std::string& input,
+                 const std::map<std::string, std::string>& expected )
+{
+   ossimKeywordlist kwl;
+   bool ok = kwl.parseString( input ) && ( kwl.getMap() == expected );
+   cout << name << "? " << (ok ? "PASSED" : "FAILED") << endl;
+   if ( !ok )
+   {
+      cout << "Got:\n" << kwl << endl;
+   }
+   return !ok;
+}
+
+bool runParserTest()
+{
+   cout << "----------- Testing parsed keys and values ------------ \n";
+   bool test_failed = false;
+   std::map<std::string, std::string> expected;
+
+   expected.clear();
+   expected["k1"] = "v1";
+   expected["k2"] = "two words  ";
+   expected["k3"] = "v3";
+   test_failed |= checkParse( "simple pairs",
+                              "k1: v1\nk2:   two words  \n   k3   : v3\n", expected );
+
+   expected.clear();
+   expected["k1"] = "v1";
+   expected["k2"] = "v2 // not a comment";
+   test_failed |= checkParse( "comments",
+                              "// comment\nk1: v1\n  // indented comment\n"
+                              "k2: v2 // not a comment\n// last", expected );
+
+   expected.clear();
+   expected["k1"] = "v1";
+   expected["k2"] = "";
+   expected["k3"] = "v3";
+   test_failed |= checkParse( "\\r\\n endings",
+                              "k1: v1\r\nk2:\r\nk3: v3\r\n", expected );
+
+   expected.clear();
+   expected["k1"] = "v1";
+   expected["k2"] = "v2";
+   test_failed |= checkParse( "missing final newline", "k1: v1\nk2: v2", expected );
+
+   expected.clear();
+   expected["k1"] = "";
+   expected["k2"] = "";
+   expected["k3"] = "v3";
+   test_failed |= checkParse( "empty values", "k1:\nk2:   \nk3: v3\n", expected );
+
+   expected.clear();
+   expected["k1"] = "line one\nline two\r\n  line three";
+   expected["k2"] = "v2";
+   test_failed |= checkParse( "multi-line quoted value",
+                              "k1: \"\"\"line one\nline two\r\n  line three\"\"\"\nk2: v2\n",
+                              expected );
+
+   expected.clear();
+   expected["k1"] = "one line";
+   expected["k2"] = "say \"hi\" twice";
+   test_failed |= checkParse( "quoted values",
+                              "k1: \"\"\"one line\"\"\"\nk2: \"\"\"say \"hi\" twice\"\"\"\n",
+                              expected );
+
+   // No continuation character: a trailing backslash is kept and the next
+   // line is a key of its own.
+   expected.clear();
+   expected["k1"] = "part one \\";
+   expected["k2"] = "part two";
+   test_failed |= checkParse( "continuation lines",
+                              "k1: part one \\\nk2: part two\n", expected );
+
+   // The first occurrence of a key wins.
+   expected.clear();
+   expected["dup"] = "first";
+   expected["k1"]  = "v1";
+   test_failed |= checkParse( "duplicate key",
+                              "dup: first\nk1: v1\ndup: second\n", expected );
+
+   {
+      ossimKeywordlist kwl;
+      kwl.add( "dup", "original" );
+      kwl.parseString( "dup: parsed\n" );
+      bool ok = ( ossimString( kwl.find("dup") ) == "original" );
+      cout << "duplicate key parsed into existing list? " << (ok ? "PASSED" : "FAILED") << endl;
+      test_failed |= !ok;
+
+      ossimKeywordlist src;
+      src.add( "dup", "src" );
+      src.add( "other", "src" );
+      ossimKeywordlist preserved( kwl );
+      preserved.addList( src, false );
+      kwl.addList( src, true );
+      ok = ( ossimString( preserved.find("dup") ) == "original" ) &&
+           ( ossimString( preserved.find("other") ) == "src" ) &&
+           ( ossimString( kwl.find("dup") ) == "src" );
+      cout << "duplicate key preserved and overwritten? " << (ok ? "PASSED" : "FAILED") << endl;
+      test_failed |= !ok;
+   }
+
+   return test_failed;
+}
+
+bool runRegExpTest()
+{
+   cout << "----------- Testing regular expression key searches ------------ \n";
+   bool test_failed = false;
+
+   ossimKeywordlist kwl;
+   kwl.add( "abcdef.x", "1" );
+   kwl.add( "abx",      "2" );
+   kwl.add( "def.y",    "3" );
+   kwl.add( "defz",     "4" );
+   kwl.add( "a.image12.b", "5" );
+   kwl.add( "image7.c",    "6" );
+
+   std::vector<ossimString> keys;
+   kwl.findAllKeysThatMatch( keys, "^(abc)?def\\." );
+   bool ok = ( keys.size() == 2 ) &&
+      ( kwl.getNumberOfKeysThatMatch( "^(abc)?def\\." ) == 2 );
+   cout << "optional leading group? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+
+   ok = ( kwl.getNumberOfKeysThatMatch( "^abcd?" ) == 1 ) &&
+        ( kwl.getNumberOfKeysThatMatch( "^abc?" ) == 2 ) &&
+        ( kwl.getNumberOfKeysThatMatch( "^de(f\\.)?" ) == 2 ) &&
+        ( kwl.getNumberOfKeysThatMatch( "^def\\." ) == 1 );
+   cout << "anchored prefixes? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+
+   keys = kwl.getSubstringKeyList( "image[0-9]+" );
+   std::sort( keys.begin(), keys.end() );
+   ok = ( keys.size() == 2 ) && ( keys[0] == "image12" ) && ( keys[1] == "image7" );
+   cout << "substring keys past the start of a key? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+
+   ossimKeywordlist stripped;
+   stripped.add( "a.image12.b", "5" );
+   stripped.add( "c.d", "7" );
+   stripped.stripPrefixFromAll( "image[0-9]+\\." );
+   ok = ( stripped.getSize() == 2 ) && stripped.find( "a.b" ) && stripped.find( "c.d" );
+   cout << "strip matches past the start of a key? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+
+   return test_failed;
+}
+
 int main(int argc, char* argv[])
 {
    ossimInit::instance()->initialize(argc, argv);
@@ -389,6 +542,8 @@ int main(int argc, char* argv[])
    cout << "complicatedHtmlEmbed preserved? " << ((ossimString(kwl2.find("complicatedHtmlEmbed.value"))==complicatedHtmlEmbed)?"PASSED":"FAILED") << endl;
    bool test_failed = runTestForFileVariations();
    test_failed |= runIncludeTest();
+   test_failed |= runParserTest();
+   test_failed |= runRegExpTest();
 
    if (!test_failed)
       cout<<"\nAll tests PASSED.\n"<<endl;
@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::RectIndex.  Compares the ids the tree
+//              returns with a brute force overlap scan, on random rects and
+//              on empty, nan and single rect inputs.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/RectIndex.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimString.h>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static ossim_int32 random( ossim_int32 low, ossim_int32 high )
+{
+   return low + std::rand() % ( high - low + 1 );
+}
+
+static ossimIrect randomRect( ossim_int32 extent, ossim_int32 maxSize )
+{
+   ossim_int32 x = random( -extent, extent );
+   ossim_int32 y = random( -extent, extent );
+   return ossimIrect( x, y, x + random( 0, maxSize ), y + random( 0, maxSize ) );
+}
+
+static ossimIrect nanRect()
+{
+   ossimIrect rect;
+   rect.makeNan();
+   return rect;
+}
+
+static void bruteForce( const std::vector<ossimIrect>& rects, const ossimIrect& rect,
+                        std::vector<ossim_uint32>& ids )
+{
+   ids.clear();
+   for ( ossim_uint32 i = 0; i < rects.size(); ++i )
+   {
+      if ( !rects[i].hasNans() && rects[i].intersects( rect ) )
+      {
+         ids.push_back( i );
+      }
+   }
+}
+
+//---
+// Runs every query against the tree built over rects and the brute force
+// scan.  Also checks size() and count().
+//---
+static bool check( const char* name, const std::vector<ossimIrect>& rects,
+                   const std::vector<ossimIrect>& queries )
+{
+   ossim::RectIndex index;
+   index.build( rects );
+
+   bool ok = true;
+   ossim_uint32 valid = 0;
+   for ( ossim_uint32 i = 0; i < rects.size(); ++i )
+   {
+      if ( !rects[i].hasNans() ) ++valid;
+   }
+   if ( ( index.size() != valid ) || ( index.empty() != ( valid == 0 ) ) )
+   {
+      cout << name << ": size " << index.size() << " expected " << valid << endl;
+      ok = false;
+   }
+
+   std::vector<ossim_uint32> expected;
+   std::vector<ossim_uint32> ids;
+   ossim_uint32 hits = 0;
+   for ( ossim_uint32 q = 0; q < queries.size(); ++q )
+   {
+      bruteForce( rects, queries[q], expected );
+      ids.clear();
+      index.query( queries[q], ids );
+      if ( ( ids != expected ) || ( index.count( queries[q] ) != expected.size() ) )
+      {
+         cout << name << ": query " << queries[q] << " returned " << ids.size()
+              << " ids, expected " << expected.size() << endl;
+         ok = false;
+      }
+      hits += (ossim_uint32)expected.size();
+   }
+
+   cout << name << " (" << rects.size() << " rects, " << queries.size()
+        << " queries, " << hits << " hits)? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossim_uint32 count = 5000;
+   if ( argc > 1 )
+   {
+      count = ossimString( argv[1] ).toUInt32();
+   }
+
+   std::srand( 3 );
+   bool test_failed = false;
+
+   std::vector<ossimIrect> queries;
+   for ( ossim_uint32 q = 0; q < 200; ++q )
+   {
+      queries.push_back( randomRect( 10000, 2000 ) );
+   }
+   queries.push_back( ossimIrect( -20000, -20000, 20000, 20000 ) ); // Everything.
+   queries.push_back( ossimIrect( 50000, 50000, 50010, 50010 ) );   // Nothing.
+   queries.push_back( ossimIrect( 5, 5, 5, 5 ) );                   // One pixel.
+   queries.push_back( nanRect() );
+
+   std::vector<ossimIrect> rects;
+   test_failed |= !check( "empty", rects, queries );
+
+   rects.push_back( nanRect() );
+   rects.push_back( nanRect() );
+   test_failed |= !check( "all nans", rects, queries );
+
+   rects.clear();
+   rects.push_back( ossimIrect( 0, 0, 10, 10 ) );
+   std::vector<ossimIrect> edges( queries );
+   edges.push_back( ossimIrect( 10, 10, 20, 20 ) );   // Shares a corner.
+   edges.push_back( ossimIrect( 11, 0, 20, 10 ) );    // Just right of it.
+   edges.push_back( ossimIrect( -5, -5, -1, 20 ) );   // Just left of it.
+   edges.push_back( ossimIrect( 2, 2, 3, 3 ) );       // Inside.
+   test_failed |= !check( "single rect", rects, edges );
+
+   rects.clear();
+   for ( ossim_uint32 i = 0; i < count; ++i )
+   {
+      // Mostly small rects, a few large and some nans:
+      if ( i % 20 == 7 )
+      {
+         rects.push_back( nanRect() );
+      }
+      else if ( i % 50 == 3 )
+      {
+         rects.push_back( randomRect( 10000, 8000 ) );
+      }
+      else
+      {
+         rects.push_back( randomRect( 10000, 300 ) );
+      }
+   }
+   test_failed |= !check( "random", rects, queries );
+
+   // Duplicates and points stacked on one spot:
+   rects.clear();
+   for ( ossim_uint32 i = 0; i < 100; ++i )
+   {
+      rects.push_back( ( i % 2 ) ? ossimIrect( 5, 5, 5, 5 ) : ossimIrect( 0, 0, 10, 10 ) );
+   }
+   test_failed |= !check( "duplicates", rects, edges );
+
+   // Rebuilding replaces the previous tree:
+   ossim::RectIndex index;
+   index.build( rects );
+   rects.resize( 1 );
+   index.build( rects );
+   std::vector<ossim_uint32> ids;
+   index.query( ossimIrect( 0, 0, 10, 10 ), ids );
+   bool ok = ( index.size() == 1 ) && ( ids.size() == 1 ) && ( ids[0] == 0 ) &&
+      ( index.getBounds() == rects[0] );
+   index.clear();
+   ok = ok && index.empty() && index.getBounds().hasNans() &&
+      ( index.count( ossimIrect( 0, 0, 10, 10 ) ) == 0 );
+   cout << "rebuild and clear? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::SharedBlockIStream.  Reads and seeks a
+//              file through the shared block cache and compares with a plain
+//              std::ifstream, including reads spanning blocks and the short
+//              block at the end of the file.  Then rewrites the file and
+//              checks a new stream sees the new bytes.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/BlockCache.h>
+#include <ossim/base/SharedBlockIStream.h>
+#include <ossim/init/ossimInit.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Not a multiple of the block size so the last block is short:
+static const ossim_uint64 BLOCK_SIZE = 64;
+
+static void writeFile( const string& path, ossim_uint32 size, ossim_uint32 seed )
+{
+   ofstream out( path.c_str(), ios::out | ios::binary | ios::trunc );
+   for ( ossim_uint32 i = 0; i < size; ++i )
+   {
+      out.put( static_cast<char>( ( i * 31 + seed ) & 0xff ) );
+   }
+}
+
+static std::shared_ptr<ossim::SharedBlockIStream> openShared( const string& path )
+{
+   ossim::BlockSource::Opener opener = [path]() -> std::shared_ptr<ossim::istream>
+   {
+      return std::make_shared<std::ifstream>( path.c_str(), ios::in | ios::binary );
+   };
+   return std::make_shared<ossim::SharedBlockIStream>(
+      ossim::BlockSource::get( path, BLOCK_SIZE, opener(), opener, 2 ) );
+}
+
+//---
+// Reads count bytes at the current position of both streams.  The gcount
+// and the stream state must match as well as the bytes.
+//---
+static bool compareRead( istream& shared, istream& plain, ossim_uint32 count )
+{
+   vector<char> a( count, 0 );
+   vector<char> b( count, 0 );
+   shared.read( &a.front(), count );
+   plain.read( &b.front(), count );
+   bool result = ( shared.gcount() == plain.gcount() ) &&
+      ( shared.eof() == plain.eof() ) && ( a == b );
+   shared.clear();
+   plain.clear();
+   return result;
+}
+
+static bool compareSeek( istream& shared, istream& plain, ossim_int64 offset,
+                         ios_base::seekdir dir )
+{
+   shared.seekg( offset, dir );
+   plain.seekg( offset, dir );
+   return shared.tellg() == plain.tellg();
+}
+
+static bool compareFile( const string& path, ossim_uint32 size )
+{
+   std::shared_ptr<ossim::SharedBlockIStream> shared = openShared( path );
+   ifstream plain( path.c_str(), ios::in | ios::binary );
+   bool result = shared && shared->good() && plain.good();
+
+   // Within a block, across a block edge, across several blocks:
+   result &= compareSeek( *shared, plain, 3, ios_base::beg );
+   result &= compareRead( *shared, plain, 20 );
+   result &= compareSeek( *shared, plain, 50, ios_base::beg );
+   result &= compareRead( *shared, plain, 30 );
+   result &= compareRead( *shared, plain, 3 * BLOCK_SIZE + 7 );
+
+   // Relative seeks, back into a cached block and forward past uncached ones:
+   result &= compareSeek( *shared, plain, -100, ios_base::cur );
+   result &= compareRead( *shared, plain, 10 );
+   result &= compareSeek( *shared, plain, 300, ios_base::cur );
+   result &= compareRead( *shared, plain, 1 );
+
+   // Single characters across a block edge:
+   result &= compareSeek( *shared, plain, 2 * BLOCK_SIZE - 2, ios_base::beg );
+   for ( ossim_uint32 i = 0; i < 4; ++i )
+   {
+      result &= ( shared->get() == plain.get() );
+   }
+
+   // The short last block, a read running past the end and a read at the end:
+   result &= compareSeek( *shared, plain, -10, ios_base::end );
+   result &= compareRead( *shared, plain, 10 );
+   result &= compareSeek( *shared, plain, -5, ios_base::end );
+   result &= compareRead( *shared, plain, 100 );
+   result &= compareSeek( *shared, plain, 0, ios_base::end );
+   result &= ( static_cast<ossim_uint32>( shared->tellg() ) == size );
+   result &= compareRead( *shared, plain, 1 );
+
+   // The whole file in one read:
+   result &= compareSeek( *shared, plain, 0, ios_base::beg );
+   result &= compareRead( *shared, plain, size );
+   return result;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+   const string PATH = "ossim-shared-block-stream-test.bin";
+
+   writeFile( PATH, 1000, 0 );
+   bool ok = compareFile( PATH, 1000 );
+   cout << "reads and seeks match ifstream? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+
+   // Second stream while the first is open, served from the cache:
+   {
+      std::shared_ptr<ossim::SharedBlockIStream> first = openShared( PATH );
+      first->seekg( 0, ios_base::end );
+      ossim_uint64 hits = ossim::BlockCache::instance()->getHitCount();
+      ok = compareFile( PATH, 1000 ) &&
+         ( ossim::BlockCache::instance()->getHitCount() > hits );
+      cout << "second stream reads cached blocks? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+   }
+
+   // Rewrite with other bytes and another size once nothing has it open:
+   writeFile( PATH, 777, 5 );
+   ok = compareFile( PATH, 777 );
+   cout << "rewritten file is read afresh? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+
+   std::remove( PATH.c_str() );
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -0,0 +1,200 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::SparseBlockMatrix.  Builds a random
+//              reduced camera system, the kind a bundle adjustment gets
+//              after eliminating ground points, and checks the sparse
+//              Cholesky solution, the PCG solution and the inverse blocks
+//              against dense newmat results.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/SparseBlockMatrix.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/matrix/newmat.h>
+#include <ossim/matrix/newmatap.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static double random( double low, double high )
+{
+   return low + ( high - low ) * std::rand() / RAND_MAX;
+}
+
+int main(int argc, char *argv[])
+{
+   ossim_uint32 images = 200;
+   if ( argc > 1 )
+   {
+      images = ossimString( argv[1] ).toUInt32();
+   }
+   if ( images < 2 )
+   {
+      cout << argv[0] << " [images]\n" << endl;
+      return 1;
+   }
+
+   std::srand( 1 );
+
+   // Image blocks of 6 or 7 parameters:
+   std::vector<ossim_uint32> sizes( images );
+   for ( ossim_uint32 i = 0; i < images; ++i )
+   {
+      sizes[i] = 6 + ( i % 3 == 0 );
+   }
+   ossim::SparseBlockMatrix a;
+   a.create( sizes );
+   const int RANK = (int)a.getRank();
+   NEWMAT::SymmetricMatrix dense( RANK );
+   dense = 0.0;
+
+   // Prior weights on the diagonal:
+   for ( ossim_uint32 i = 0; i < images; ++i )
+   {
+      double* d = a.block( i, i );
+      for ( ossim_uint32 r = 0; r < sizes[i]; ++r )
+      {
+         d[r * sizes[i] + r] = 1.0;
+         dense( a.getOffset(i) + r + 1, a.getOffset(i) + r + 1 ) = 1.0;
+      }
+   }
+
+   // Ground points seen by neighboring images along a strip, plus a few
+   // between strips, each adding w * w' over the images seeing it:
+   for ( ossim_uint32 point = 0; point < images * 20; ++point )
+   {
+      std::vector<ossim_uint32> seen;
+      ossim_uint32 first = std::rand() % images;
+      seen.push_back( first );
+      seen.push_back( ( first + 1 ) % images );
+      if ( point % 4 == 0 ) seen.push_back( ( first + 2 ) % images );
+      if ( point % 25 == 0 ) seen.push_back( ( first + images / 2 ) % images );
+      std::sort( seen.begin(), seen.end() );
+      seen.erase( std::unique( seen.begin(), seen.end() ), seen.end() );
+
+      std::vector< std::vector<double> > w( seen.size() );
+      for ( std::vector<ossim_uint32>::size_type s = 0; s < seen.size(); ++s )
+      {
+         w[s].resize( sizes[seen[s]] );
+         for ( ossim_uint32 r = 0; r < w[s].size(); ++r )
+         {
+            w[s][r] = random( -1.0, 1.0 );
+         }
+      }
+      for ( std::vector<ossim_uint32>::size_type s = 0; s < seen.size(); ++s )
+      {
+         for ( std::vector<ossim_uint32>::size_type t = 0; t <= s; ++t )
+         {
+            ossim_uint32 i = seen[s];
+            ossim_uint32 k = seen[t];
+            double* b = a.block( i, k );
+            for ( ossim_uint32 r = 0; r < sizes[i]; ++r )
+            {
+               for ( ossim_uint32 c = 0; c < sizes[k]; ++c )
+               {
+                  b[r * sizes[k] + c] += w[s][r] * w[t][c];
+                  if ( ( i != k ) || ( r >= c ) )
+                  {
+                     dense( a.getOffset(i) + r + 1, a.getOffset(k) + c + 1 ) +=
+                        w[s][r] * w[t][c];
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   std::vector<double> rhs( RANK );
+   NEWMAT::ColumnVector denseRhs( RANK );
+   for ( int r = 0; r < RANK; ++r )
+   {
+      rhs[r] = random( -1.0, 1.0 );
+      denseRhs( r + 1 ) = rhs[r];
+   }
+
+   ossimTimer* timer = ossimTimer::instance();
+
+   // Dense reference:
+   timer->setStartTick();
+   NEWMAT::SymmetricMatrix denseInverse = dense.i();
+   NEWMAT::ColumnVector denseX = denseInverse * denseRhs;
+   double denseTime = timer->time_s();
+
+   // Sparse Cholesky:
+   timer->setStartTick();
+   bool ok = a.factor();
+   std::vector<double> x( RANK );
+   ok = ok && a.solve( &rhs.front(), &x.front() );
+   double sparseTime = timer->time_s();
+   timer->setStartTick();
+   ok = ok && a.computeInverse();
+   double inverseTime = timer->time_s();
+
+   // PCG:
+   std::vector<double> xPcg( RANK, 0.0 );
+   timer->setStartTick();
+   bool pcgOk = a.solvePcg( &rhs.front(), &xPcg.front(), 1.0e-12, 10 * RANK );
+   double pcgTime = timer->time_s();
+
+   double solveError = 0.0;
+   double pcgError = 0.0;
+   for ( int r = 0; r < RANK; ++r )
+   {
+      solveError = std::max( solveError, std::fabs( x[r] - denseX( r + 1 ) ) );
+      pcgError   = std::max( pcgError, std::fabs( xPcg[r] - denseX( r + 1 ) ) );
+   }
+
+   // Inverse blocks of every stored block:
+   double inverseError = 0.0;
+   ossim_uint32 missing = 0;
+   std::vector<double> out( 49 );
+   for ( ossim_uint32 k = 0; k < images; ++k )
+   {
+      for ( ossim_uint32 i = k; i < images; ++i )
+      {
+         if ( !a.findBlock( i, k ) ) continue;
+         if ( !ok || !a.getInverseBlock( i, k, &out.front() ) )
+         {
+            ++missing;
+            continue;
+         }
+         for ( ossim_uint32 r = 0; r < sizes[i]; ++r )
+         {
+            for ( ossim_uint32 c = 0; c < sizes[k]; ++c )
+            {
+               double expected = denseInverse( a.getOffset(i) + r + 1, a.getOffset(k) + c + 1 );
+               inverseError = std::max( inverseError,
+                                        std::fabs( out[r * sizes[k] + c] - expected ) );
+            }
+         }
+      }
+   }
+
+   const ossim::SparseBlockMatrix::Statistics& stats = a.getStatistics();
+   cout << std::setprecision(6)
+        << "images:              " << images << " rank " << RANK
+        << "\nblocks:              " << stats.m_blocks << " (" << stats.m_entries << " values)"
+        << "\nfactor blocks:       " << stats.m_factorBlocks << " (" << stats.m_factorEntries
+        << " values, fill-in " << ( stats.m_factorBlocks - stats.m_blocks ) << " blocks)"
+        << "\ndense inverse:       " << denseTime << " s"
+        << "\nsparse factor+solve: " << sparseTime << " s"
+        << "\nsparse inverse:      " << inverseTime << " s"
+        << "\npcg:                 " << pcgTime << " s, " << stats.m_iterations
+        << " iterations, residual " << stats.m_residual
+        << "\nsolve error:         " << solveError
+        << "\npcg error:           " << pcgError
+        << "\ninverse error:       " << inverseError
+        << "\nmissing blocks:      " << missing << endl;
+
+   bool passed = ok && pcgOk && ( missing == 0 ) &&
+      ( solveError < 1.0e-8 ) && ( pcgError < 1.0e-6 ) && ( inverseError < 1.0e-8 );
+   cout << ( passed ? "PASSED" : "FAILED" ) << endl;
+   return passed ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossimWLSBundleSolution.  Runs the dense and
+//              sparse solvers on the same synthetic block adjustment and
+//              compares corrections, full covariance and variances.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimAdjSolutionAttributes.h>
+#include <ossim/base/ossimWLSBundleSolution.h>
+#include <ossim/base/ossimString.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static double random( double low, double high )
+{
+   return low + ( high - low ) * std::rand() / RAND_MAX;
+}
+
+static double maxDifference( const NEWMAT::Matrix& a, const NEWMAT::Matrix& b )
+{
+   if ( ( a.Nrows() != b.Nrows() ) || ( a.Ncols() != b.Ncols() ) )
+   {
+      return 1.0e+30;
+   }
+   double result = 0.0;
+   for ( int r = 1; r <= a.Nrows(); ++r )
+   {
+      for ( int c = 1; c <= a.Ncols(); ++c )
+      {
+         result = std::max( result, std::fabs( a(r,c) - b(r,c) ) );
+      }
+   }
+   return result;
+}
+
+//---
+// Synthetic adjustment: images along a strip with 4 to 6 parameters each,
+// ground points seen by neighboring images, some by a third image or twice
+// by the same image.  The attributes are protected, so the test fills them
+// from a derived class.
+//---
+class TestAttributes : public ossimAdjSolutionAttributes
+{
+public:
+   TestAttributes( int numImages, int numObs, int numMeas, int rank )
+      : ossimAdjSolutionAttributes( numObs, numImages, numMeas, rank )
+   {
+   }
+
+   static TestAttributes* create( int numImages, int numObs )
+   {
+      std::srand( 7 );
+
+      std::vector<int> numpar( numImages );
+      int numParams = 0;
+      for ( int i = 0; i < numImages; ++i )
+      {
+         numpar[i] = 4 + i % 3;
+         numParams += numpar[i];
+      }
+
+      std::vector< std::vector<int> > seen( numObs );
+      int numMeas = 0;
+      int parRows = 0;
+      for ( int obs = 0; obs < numObs; ++obs )
+      {
+         int first = std::rand() % numImages;
+         seen[obs].push_back( first );
+         seen[obs].push_back( ( first + 1 ) % numImages );
+         if ( obs % 3 == 0 ) seen[obs].push_back( ( first + 3 ) % numImages );
+         if ( obs % 7 == 0 ) seen[obs].push_back( first );
+         for ( std::vector<int>::size_type m = 0; m < seen[obs].size(); ++m )
+         {
+            parRows += numpar[ seen[obs][m] ];
+         }
+         numMeas += (int)seen[obs].size();
+      }
+
+      TestAttributes* a = new TestAttributes( numImages, numObs, numMeas,
+                                              numParams + numObs * 3 );
+      for ( int i = 0; i < numImages; ++i )
+      {
+         a->theImgNumparXref.insert( std::make_pair( i, numpar[i] ) );
+      }
+      a->theAdjParCov.ReSize( numParams, numParams );
+      a->theAdjParCov = 0.0;
+      for ( int i = 1; i <= numParams; ++i )
+      {
+         a->theAdjParCov(i,i) = 0.5 + std::rand() % 3;
+      }
+      a->theObjectPtCov.ReSize( numObs * 3, 3 );
+      a->theImagePtCov.ReSize( numMeas * 2, 2 );
+      a->theMeasResiduals.ReSize( numMeas, 2 );
+      a->theObjPartials.ReSize( numMeas * 3, 2 );
+      a->theParPartials.ReSize( parRows, 2 );
+
+      int cMeas = 1;
+      int cPar = 1;
+      for ( int obs = 0; obs < numObs; ++obs )
+      {
+         NEWMAT::Matrix objCov( 3, 3 );
+         objCov = 0.0;
+         objCov(1,1) = 10.0;
+         objCov(2,2) = 20.0;
+         objCov(3,3) = 30.0;
+         objCov(1,2) = objCov(2,1) = 1.0;
+         a->theObjectPtCov.Rows( obs * 3 + 1, obs * 3 + 3 ) = objCov;
+
+         for ( std::vector<int>::size_type m = 0; m < seen[obs].size(); ++m )
+         {
+            a->theObjImgXref.insert( std::make_pair( obs, seen[obs][m] ) );
+
+            NEWMAT::Matrix measCov( 2, 2 );
+            measCov(1,1) = 1.0 + std::rand() % 2;
+            measCov(2,2) = 1.5;
+            measCov(1,2) = measCov(2,1) = 0.2;
+            a->theImagePtCov.Rows( cMeas * 2 - 1, cMeas * 2 ) = measCov;
+
+            a->theMeasResiduals(cMeas,1) = random( -1.0, 1.0 );
+            a->theMeasResiduals(cMeas,2) = random( -1.0, 1.0 );
+            for ( int r = 1; r <= 3; ++r )
+            {
+               a->theObjPartials( (cMeas-1) * 3 + r, 1 ) = random( -1.0, 1.0 );
+               a->theObjPartials( (cMeas-1) * 3 + r, 2 ) = random( -1.0, 1.0 );
+            }
+            for ( int p = 0; p < numpar[ seen[obs][m] ]; ++p, ++cPar )
+            {
+               a->theParPartials(cPar,1) = random( -1.0, 1.0 );
+               a->theParPartials(cPar,2) = random( -1.0, 1.0 );
+            }
+            ++cMeas;
+         }
+      }
+
+      for ( int i = 1; i <= a->fullRank(); ++i )
+      {
+         a->theTotalCorrections(i) = random( -0.1, 0.1 );
+      }
+      return a;
+   }
+
+   const NEWMAT::ColumnVector& corrections() const { return theTotalCorrections; }
+   const NEWMAT::UpperTriangularMatrix& covariance() const { return theFullCovMatrix; }
+   const NEWMAT::ColumnVector& variances() const { return theVariances; }
+};
+
+int main(int argc, char *argv[])
+{
+   int numImages = 8;
+   int numObs = 40;
+   if ( argc > 2 )
+   {
+      numImages = ossimString( argv[1] ).toInt32();
+      numObs    = ossimString( argv[2] ).toInt32();
+   }
+   if ( ( numImages < 4 ) || ( numObs < 1 ) )
+   {
+      cout << argv[0] << " [images points]\n" << endl;
+      return 1;
+   }
+
+   TestAttributes* dense = TestAttributes::create( numImages, numObs );
+   ossimWLSBundleSolution denseSolution;
+   denseSolution.setSolverType( ossimWLSBundleSolution::DENSE_SOLVER );
+   bool test_failed = !denseSolution.run( dense );
+   denseSolution.printStatistics( cout );
+
+   struct Case
+   {
+      const char* name;
+      ossimWLSBundleSolution::SolverType solver;
+      bool fullCovariance;
+   };
+   const Case CASES[] =
+   {
+      { "sparse cholesky",                 ossimWLSBundleSolution::SPARSE_CHOLESKY_SOLVER, true },
+      { "sparse pcg",                      ossimWLSBundleSolution::SPARSE_PCG_SOLVER,      true },
+      { "sparse cholesky, variances only", ossimWLSBundleSolution::SPARSE_CHOLESKY_SOLVER, false },
+      { "sparse pcg, variances only",      ossimWLSBundleSolution::SPARSE_PCG_SOLVER,      false }
+   };
+
+   for ( int c = 0; c < 4; ++c )
+   {
+      TestAttributes* sparse = TestAttributes::create( numImages, numObs );
+      ossimWLSBundleSolution sparseSolution;
+      sparseSolution.setSolverType( CASES[c].solver );
+      if ( !CASES[c].fullCovariance )
+      {
+         // Below the rank, so the variances come from the sparse inverse.
+         sparseSolution.setMaxFullCovarianceRank( dense->fullRank() - 1 );
+      }
+      bool ok = sparseSolution.run( sparse );
+
+      double correctionError = maxDifference( dense->corrections(), sparse->corrections() );
+      double varianceError = maxDifference( dense->variances(), sparse->variances() );
+      double covarianceError = 0.0;
+      if ( CASES[c].fullCovariance )
+      {
+         covarianceError = maxDifference( dense->covariance(), sparse->covariance() );
+      }
+      else if ( sparse->covariance().Nrows() != 0 )
+      {
+         ok = false;
+      }
+
+      ok = ok && ( correctionError < 1.0e-10 ) && ( varianceError < 1.0e-10 ) &&
+         ( covarianceError < 1.0e-10 );
+      cout << CASES[c].name << ": corrections " << correctionError
+           << ", variances " << varianceError
+           << ", covariance " << covarianceError
+           << "? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      if ( c == 1 )
+      {
+         sparseSolution.printStatistics( cout );
+      }
+      test_failed |= !ok;
+      delete sparse;
+   }
+   delete dense;
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -74,6 +74,21 @@ int main(int argc, char *argv[])
 
         << endl;
 
+   // Same lookups through the memory mapped cell:
+   ossimDtedHandler* mdh = new ossimDtedHandler(dtedCell, true);
+   ossim_uint64 residentBytes = 0;
+   ossim_uint64 virtualBytes  = 0;
+   bool mapped = mdh->getMemoryMapUsage(residentBytes, virtualBytes);
+   double mhpMid = mdh->getHeightAboveMSL(gpMid);
+
+   cout << "\nmapped:         " << (mapped?"true":"false")
+        << "\nmhpMid:         " << mhpMid
+        << "\nmatch:          " << ((mhpMid == hpMid)?"true":"false")
+        << "\nresident_bytes: " << residentBytes
+        << "\nvirtual_bytes:  " << virtualBytes
+        << endl;
+
+   delete mdh;
    delete dh;
    
    return 0;
@@ -0,0 +1,238 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the batch height lookups of
+//              ossimElevationCellDatabase.  Writes a few small synthetic
+//              DTED cells, one of the four missing and with some null posts,
+//              and checks that getHeightsAboveEllipsoid and
+//              getHeightsAboveMSL of a DTED database give for a shuffled set
+//              of points what the per point calls give, with memory mapped
+//              and with stream read cells.  A made up geoid makes the
+//              ellipsoid offsets differ from point to point.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGeoid.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/elevation/ossimDtedElevationDatabase.h>
+#include <ossim/init/ossimInit.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim_int32 POSTS       = 121; // 30 second spacing
+static const ossim_uint32 NUM_POINTS = 3000;
+
+class TestGeoid : public ossimGeoid
+{
+public:
+   virtual bool open(const ossimFilename&, ossimByteOrder)
+   {
+      return true;
+   }
+   virtual double offsetFromEllipsoid(const ossimGpt& gpt)
+   {
+      return -20.0 + 3.0 * ( gpt.lat - 39.0 ) - 0.5 * ( gpt.lon + 105.0 );
+   }
+};
+
+static ossim_int32 postHeight( ossim_int32 lonPost, ossim_int32 latPost )
+{
+   if ( ( lonPost * 7 + latPost * 3 ) % 97 == 0 )
+   {
+      return -32767; // null
+   }
+   return ( lonPost * 37 + latPost * 11 ) % 2500 - 300;
+}
+
+// Fixed width field, blank filled:
+static void field( char* buf, const char* value )
+{
+   memcpy( buf, value, strlen( value ) );
+}
+
+// Cell with its south west corner at lat, lon in whole degrees.
+static bool writeCell( const ossimFilename& file, int lat, int lon )
+{
+   char uhl[80];
+   char dsi[648];
+   char acc[2700];
+   memset( uhl, ' ', sizeof( uhl ) );
+   memset( dsi, ' ', sizeof( dsi ) );
+   memset( acc, ' ', sizeof( acc ) );
+
+   char tmp[16];
+   field( uhl, "UHL1" );
+   sprintf( tmp, "%03d0000%c", abs( lon ), ( lon < 0 ) ? 'W' : 'E' );
+   field( uhl + 4, tmp );
+   sprintf( tmp, "%03d0000%c", abs( lat ), ( lat < 0 ) ? 'S' : 'N' );
+   field( uhl + 12, tmp );
+   field( uhl + 20, "03000300" );
+   sprintf( tmp, "%04d%04d0", POSTS, POSTS );
+   field( uhl + 47, tmp );
+   field( dsi, "DSI" );
+   field( acc, "ACC" );
+
+   ofstream out( file.c_str(), ios::out | ios::binary | ios::trunc );
+   out.write( uhl, sizeof( uhl ) );
+   out.write( dsi, sizeof( dsi ) );
+   out.write( acc, sizeof( acc ) );
+
+   // One record per longitude line, big endian signed magnitude posts:
+   vector<unsigned char> record( 12 + POSTS * 2, 0 );
+   for ( ossim_int32 x = 0; x < POSTS; ++x )
+   {
+      record[0] = 0xaa;
+      record[4] = (unsigned char)( x >> 8 );
+      record[5] = (unsigned char)( x & 0xff );
+      for ( ossim_int32 y = 0; y < POSTS; ++y )
+      {
+         ossim_int32 h = postHeight( ( lon + 200 ) * POSTS + x, ( lat + 100 ) * POSTS + y );
+         ossim_uint32 v = ( h < 0 ) ? ( 0x8000 | -h ) : h;
+         record[8 + y * 2]     = (unsigned char)( v >> 8 );
+         record[8 + y * 2 + 1] = (unsigned char)( v & 0xff );
+      }
+      out.write( (const char*)&record.front(), record.size() );
+   }
+   return out.good();
+}
+
+static bool writeCells( const ossimFilename& dir )
+{
+   ossimFilename w105 = dir.dirCat( "w105" );
+   ossimFilename w104 = dir.dirCat( "w104" );
+   return w105.createDirectory( true ) && w104.createDirectory( true ) &&
+      writeCell( w105.dirCat( "n39.dt1" ), 39, -105 ) &&
+      writeCell( w105.dirCat( "n40.dt1" ), 40, -105 ) &&
+      writeCell( w104.dirCat( "n39.dt1" ), 39, -104 );
+}
+
+// Shuffled points over the cells, on posts, on cell edges and off the cells:
+static void createPoints( vector<ossimGpt>& points )
+{
+   ossim_uint32 seed = 4321;
+   points.clear();
+   for ( ossim_uint32 i = 0; i < NUM_POINTS; ++i )
+   {
+      seed = seed * 1103515245 + 12345;
+      double u = ( ( seed >> 8 ) & 0xffff ) / 65535.0;
+      seed = seed * 1103515245 + 12345;
+      double v = ( ( seed >> 8 ) & 0xffff ) / 65535.0;
+      if ( i % 10 == 0 )
+      {
+         // On a post:
+         u = floor( u * 240.0 ) / 120.0 / 2.2;
+         v = floor( v * 240.0 ) / 120.0 / 2.2;
+      }
+      points.push_back( ossimGpt( 38.9 + v * 2.2, -105.1 + u * 2.2 ) );
+   }
+   points.push_back( ossimGpt( 40.0, -104.5 ) );
+   points.push_back( ossimGpt( 39.5, -104.0 ) );
+   points.push_back( ossimGpt( 41.0, -105.0 ) );
+   points.push_back( ossimGpt( 39.0, -105.0 ) );
+}
+
+static bool sameHeight( double a, double b )
+{
+   return ( ossim::isnan( a ) && ossim::isnan( b ) ) || ( fabs( a - b ) < 1.0e-9 );
+}
+
+static bool compare( ossimElevationDatabase* db, const vector<ossimGpt>& points,
+                     bool ellipsoid, ossim_uint32& numValid )
+{
+   vector<ossim_float64> heights( points.size() );
+   bool* validPtr = new bool[points.size()];
+   numValid = ellipsoid ?
+      db->getHeightsAboveEllipsoid( &points.front(), (ossim_uint32)points.size(),
+                                    &heights.front(), validPtr ) :
+      db->getHeightsAboveMSL( &points.front(), (ossim_uint32)points.size(),
+                              &heights.front(), validPtr );
+   ossim_uint32 count = 0;
+   bool result = true;
+   for ( ossim_uint32 i = 0; result && ( i < points.size() ); ++i )
+   {
+      double expected = ellipsoid ? db->getHeightAboveEllipsoid( points[i] ) :
+         db->getHeightAboveMSL( points[i] );
+      result = sameHeight( expected, heights[i] ) &&
+         ( validPtr[i] == !ossim::isnan( heights[i] ) );
+      if ( !result )
+      {
+         cout << "point " << i << " " << points[i] << ": " << expected << " != "
+              << heights[i] << endl;
+      }
+      count += validPtr[i] ? 1 : 0;
+   }
+   delete [] validPtr;
+
+   // Some points have no cell, some sit on null posts:
+   return result && ( count == numValid ) && ( numValid > points.size() / 2 ) &&
+      ( numValid < points.size() );
+}
+
+static bool check( const char* name, bool ok, bool& test_failed )
+{
+   cout << name << "? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+   const ossimFilename DIR = "ossim-elevation-batch-test";
+
+   if ( !check( "write dted cells", writeCells( DIR ), test_failed ) )
+   {
+      return test_failed;
+   }
+
+   vector<ossimGpt> points;
+   createPoints( points );
+
+   for ( ossim_uint32 m = 0; m < 2; ++m )
+   {
+      bool memoryMap = ( m == 0 );
+      ossimRefPtr<ossimDtedElevationDatabase> db = new ossimDtedElevationDatabase();
+      db->setGeoid( new TestGeoid() );
+      db->setMemoryMapCellsFlag( memoryMap );
+      bool ok = db->open( DIR );
+      cout << "\n" << ( memoryMap ? "memory mapped" : "stream read" ) << " cells:" << endl;
+
+      // The cells read back, a post of w105/n39 and the geoid offset:
+      ossimGpt post( 39.5, -104.5 );
+      double h = postHeight( 95 * POSTS + 60, 139 * POSTS + 60 );
+      check( "post heights read back", ok && sameHeight( db->getHeightAboveMSL( post ), h ) &&
+             sameHeight( db->getHeightAboveEllipsoid( post ), h - 20.0 + 1.5 - 0.25 ),
+             test_failed );
+
+      ossim_uint32 numValid = 0;
+      check( "batch heights above MSL match per point",
+             ok && compare( db.get(), points, false, numValid ), test_failed );
+      cout << numValid << " of " << points.size() << " points have a height" << endl;
+      check( "batch heights above ellipsoid match per point",
+             ok && compare( db.get(), points, true, numValid ), test_failed );
+   }
+
+   DIR.dirCat( "w105" ).dirCat( "n39.dt1" ).remove();
+   DIR.dirCat( "w105" ).dirCat( "n40.dt1" ).remove();
+   DIR.dirCat( "w104" ).dirCat( "n39.dt1" ).remove();
+   DIR.dirCat( "w105" ).remove();
+   DIR.dirCat( "w104" ).remove();
+   DIR.remove();
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
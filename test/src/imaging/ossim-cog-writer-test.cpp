@@ -0,0 +1,448 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the cloud optimized mode of ossimTiffWriter.
+//              Writes a small image as a cloud optimized GeoTIFF and checks
+//              the file layout: the structural metadata block after the
+//              header, every directory ahead of the tile data and the
+//              overview tiles smallest level first.  The pixels of every
+//              level must match a plain tiled write with overviews built
+//              by ossimTiffOverviewBuilder.  The libtiff < 4.1 fallback,
+//              internal overviews only, is checked the same way minus the
+//              layout.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimTiffOverviewBuilder.h>
+#include <ossim/imaging/ossimTiffWriter.h>
+#include <ossim/init/ossimInit.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+using namespace std;
+
+static const ossim_int32 IMAGE_WIDTH  = 700;
+static const ossim_int32 IMAGE_HEIGHT = 500;
+static const ossim_int32 TILE_SIZE    = 64;
+
+// Writer as built against libtiff older than 4.1:
+class ossimFallbackTiffWriter : public ossimTiffWriter
+{
+protected:
+   virtual bool hasCogLayoutSupport()const
+   {
+      return false;
+   }
+};
+
+static ossimRefPtr<ossimImageSource> createSource()
+{
+   ossimRefPtr<ossimImageData> data =
+      new ossimImageData( 0, OSSIM_UINT8, 3, IMAGE_WIDTH, IMAGE_HEIGHT );
+   data->initialize();
+   for ( ossim_uint32 band = 0; band < 3; ++band )
+   {
+      ossim_uint8* buf = static_cast<ossim_uint8*>( data->getBuf( band ) );
+      for ( ossim_int32 y = 0; y < IMAGE_HEIGHT; ++y )
+      {
+         for ( ossim_int32 x = 0; x < IMAGE_WIDTH; ++x )
+         {
+            buf[y * IMAGE_WIDTH + x] = (ossim_uint8)( ( x * 3 + y * 7 + band * 40 ) % 255 + 1 );
+         }
+      }
+   }
+   data->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage( data );
+   return source.get();
+}
+
+static bool write( ossimTiffWriter* writer, const ossimFilename& file, bool cog )
+{
+   ossimRefPtr<ossimImageSource> source = createSource();
+   writer->setGeotiffFlag( false );
+   writer->setTileSize( ossimIpt( TILE_SIZE, TILE_SIZE ) );
+   writer->setCogFlag( cog );
+   writer->setOutputName( file );
+   writer->connectMyInputTo( 0, source.get() );
+   bool result = writer->execute();
+   writer->disconnect();
+   return result;
+}
+
+// Plain tiled write with internal overviews, the reference for the pixels:
+static bool writeReference( const ossimFilename& file )
+{
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   if ( !write( writer.get(), file, false ) )
+   {
+      return false;
+   }
+   ossimRefPtr<ossimImageHandler> ih = ossimImageHandlerRegistry::instance()->open( file );
+   ossimRefPtr<ossimTiffOverviewBuilder> ob = new ossimTiffOverviewBuilder();
+   bool result = ih.valid() && ob->setInputSource( ih.get() );
+   if ( result )
+   {
+      ob->setOutputTileSize( ossimIpt( TILE_SIZE, TILE_SIZE ) );
+      ob->setInternalOverviewsFlag( true );
+      ob->setOutputFile( file );
+      result = ob->execute();
+   }
+   ob = 0;
+   if ( ih.valid() )
+   {
+      ih->close();
+   }
+   return result;
+}
+
+//---
+// Minimal classic tiff directory reader, enough for the layout checks.
+//---
+struct Directory
+{
+   ossim_uint32 offset;
+   ossim_uint32 width;
+   ossim_uint32 subfileType;
+   std::vector<ossim_uint32> tileOffsets;
+   std::vector<ossim_uint32> tileByteCounts;
+};
+
+class TiffBytes
+{
+public:
+   TiffBytes( const ossimFilename& file )
+      : m_littleEndian( true )
+   {
+      std::ifstream in( file.c_str(), std::ios::binary );
+      m_bytes.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+      m_littleEndian = ( m_bytes.size() > 1 ) && ( m_bytes[0] == 'I' );
+   }
+
+   bool isClassicTiff() const
+   {
+      return ( m_bytes.size() >= 8 ) && ( get16( 2 ) == 42 );
+   }
+
+   std::string getString( ossim_uint32 offset, ossim_uint32 length ) const
+   {
+      if ( offset >= m_bytes.size() )
+      {
+         return std::string();
+      }
+      return std::string( &m_bytes[offset], std::min<size_t>( length, m_bytes.size() - offset ) );
+   }
+
+   bool readDirectories( std::vector<Directory>& dirs ) const
+   {
+      dirs.clear();
+      ossim_uint32 offset = get32( 4 );
+      while ( offset && ( dirs.size() < 64 ) )
+      {
+         if ( offset + 2 > m_bytes.size() )
+         {
+            return false;
+         }
+         Directory dir;
+         dir.offset = offset;
+         dir.width = 0;
+         dir.subfileType = 0;
+         ossim_uint32 entries = get16( offset );
+         if ( offset + 2 + entries * 12 + 4 > m_bytes.size() )
+         {
+            return false;
+         }
+         for ( ossim_uint32 i = 0; i < entries; ++i )
+         {
+            ossim_uint32 entry = offset + 2 + i * 12;
+            std::vector<ossim_uint32> values;
+            getValues( entry, values );
+            switch ( get16( entry ) )
+            {
+               case 254: dir.subfileType = values.empty() ? 0 : values[0]; break;
+               case 256: dir.width = values.empty() ? 0 : values[0];       break;
+               case 324: dir.tileOffsets = values;                         break;
+               case 325: dir.tileByteCounts = values;                      break;
+               default: break;
+            }
+         }
+         dirs.push_back( dir );
+         offset = get32( offset + 2 + entries * 12 );
+      }
+      return true;
+   }
+
+private:
+   ossim_uint32 byteAt( ossim_uint32 offset ) const
+   {
+      return ( offset < m_bytes.size() ) ? (ossim_uint8)m_bytes[offset] : 0;
+   }
+
+   ossim_uint32 get16( ossim_uint32 offset ) const
+   {
+      return m_littleEndian ? ( byteAt( offset ) | ( byteAt( offset + 1 ) << 8 ) )
+                            : ( ( byteAt( offset ) << 8 ) | byteAt( offset + 1 ) );
+   }
+
+   ossim_uint32 get32( ossim_uint32 offset ) const
+   {
+      return m_littleEndian ? ( get16( offset ) | ( get16( offset + 2 ) << 16 ) )
+                            : ( ( get16( offset ) << 16 ) | get16( offset + 2 ) );
+   }
+
+   // Short and long values, inline when they fit in four bytes.
+   void getValues( ossim_uint32 entry, std::vector<ossim_uint32>& values ) const
+   {
+      ossim_uint32 type  = get16( entry + 2 );
+      ossim_uint32 count = get32( entry + 4 );
+      ossim_uint32 size  = ( type == 3 ) ? 2 : ( ( type == 4 ) ? 4 : 0 );
+      if ( !size || ( count > m_bytes.size() ) )
+      {
+         return;
+      }
+      ossim_uint32 data = ( count * size <= 4 ) ? entry + 8 : get32( entry + 8 );
+      for ( ossim_uint32 i = 0; i < count; ++i )
+      {
+         values.push_back( ( size == 2 ) ? get16( data + i * 2 ) : get32( data + i * 4 ) );
+      }
+   }
+
+   std::vector<char> m_bytes;
+   bool m_littleEndian;
+};
+
+//---
+// Ghost area right after the header, then the directories, then the tiles
+// of the smallest level first and in tile order within each level.
+//---
+static bool checkLayout( const ossimFilename& file )
+{
+   TiffBytes tiff( file );
+   if ( !tiff.isClassicTiff() )
+   {
+      cout << file << ": not a classic tiff" << endl;
+      return false;
+   }
+
+   bool ok = true;
+   std::string ghost = tiff.getString( 8, 200 );
+   if ( ( ghost.find( "GDAL_STRUCTURAL_METADATA_SIZE=" ) != 0 ) ||
+        ( ghost.find( "LAYOUT=IFDS_BEFORE_DATA" ) == std::string::npos ) ||
+        ( ghost.find( "BLOCK_ORDER=ROW_MAJOR" ) == std::string::npos ) )
+   {
+      cout << "no structural metadata after the header" << endl;
+      ok = false;
+   }
+
+   std::vector<Directory> dirs;
+   if ( !tiff.readDirectories( dirs ) || ( dirs.size() < 2 ) )
+   {
+      cout << "expected full resolution and overview directories, found "
+           << dirs.size() << endl;
+      return false;
+   }
+
+   ossim_uint32 firstTile = 0xffffffff;
+   ossim_uint32 lastIfd = 0;
+   for ( ossim_uint32 i = 0; i < dirs.size(); ++i )
+   {
+      const Directory& dir = dirs[i];
+      lastIfd = std::max( lastIfd, dir.offset );
+      if ( ( dir.tileOffsets.size() == 0 ) ||
+           ( dir.tileOffsets.size() != dir.tileByteCounts.size() ) )
+      {
+         cout << "directory " << i << " has no tile offsets" << endl;
+         return false;
+      }
+      if ( ( i == 0 ) ? ( ( dir.width != (ossim_uint32)IMAGE_WIDTH ) || dir.subfileType )
+                      : ( ( dir.width >= dirs[i-1].width ) || ( dir.subfileType != 1 ) ) )
+      {
+         cout << "directory " << i << " is out of order, width " << dir.width << endl;
+         ok = false;
+      }
+      for ( ossim_uint32 t = 0; t < dir.tileOffsets.size(); ++t )
+      {
+         if ( dir.tileByteCounts[t] )
+         {
+            firstTile = std::min( firstTile, dir.tileOffsets[t] );
+         }
+         if ( t && ( dir.tileOffsets[t] <= dir.tileOffsets[t-1] ) )
+         {
+            cout << "directory " << i << ": tile " << t << " before tile " << t - 1 << endl;
+            ok = false;
+         }
+      }
+   }
+   if ( lastIfd >= firstTile )
+   {
+      cout << "directory at " << lastIfd << " after tile data at " << firstTile << endl;
+      ok = false;
+   }
+
+   // Each level's tiles end before the next larger level's begin:
+   for ( ossim_uint32 i = 1; i < dirs.size(); ++i )
+   {
+      const Directory& larger  = dirs[i-1];
+      const Directory& smaller = dirs[i];
+      ossim_uint32 smallerEnd = smaller.tileOffsets.back() + smaller.tileByteCounts.back();
+      if ( smallerEnd > larger.tileOffsets.front() )
+      {
+         cout << "overview " << i << " tiles not ahead of level " << i - 1 << endl;
+         ok = false;
+      }
+   }
+   return ok;
+}
+
+// The fallback has no structural metadata but the same levels:
+static bool checkFallbackLayout( const ossimFilename& file )
+{
+   TiffBytes tiff( file );
+   std::vector<Directory> dirs;
+   bool ok = tiff.isClassicTiff() && tiff.readDirectories( dirs ) && ( dirs.size() >= 2 ) &&
+      ( tiff.getString( 8, 30 ).find( "GDAL_STRUCTURAL_METADATA_SIZE=" ) != 0 ) &&
+      ( dirs[0].width == (ossim_uint32)IMAGE_WIDTH );
+   for ( ossim_uint32 i = 1; ok && ( i < dirs.size() ); ++i )
+   {
+      ok = ( dirs[i].subfileType == 1 ) && ( dirs[i].width < dirs[i-1].width );
+   }
+   return ok;
+}
+
+static bool sameTile( const ossimImageData* a, const ossimImageData* b )
+{
+   if ( !a || !b || ( a->getNumberOfBands() != b->getNumberOfBands() ) ||
+        ( a->getImageRectangle() != b->getImageRectangle() ) )
+   {
+      return false;
+   }
+   for ( ossim_uint32 band = 0; band < a->getNumberOfBands(); ++band )
+   {
+      if ( memcmp( a->getBuf( band ), b->getBuf( band ),
+                   a->getSizePerBandInBytes() ) != 0 )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+// Every level of file must match the same level of the reference:
+static bool checkPixels( const ossimFilename& file, const ossimFilename& reference )
+{
+   ossimRefPtr<ossimImageHandler> ih = ossimImageHandlerRegistry::instance()->open( file );
+   ossimRefPtr<ossimImageHandler> ref = ossimImageHandlerRegistry::instance()->open( reference );
+   if ( !ih.valid() || !ref.valid() )
+   {
+      cout << "could not open " << ( ih.valid() ? reference : file ) << endl;
+      return false;
+   }
+
+   bool ok = ( ih->getNumberOfDecimationLevels() == ref->getNumberOfDecimationLevels() ) &&
+      ( ref->getNumberOfDecimationLevels() > 1 );
+   if ( !ok )
+   {
+      cout << file << ": " << ih->getNumberOfDecimationLevels() << " levels, reference has "
+           << ref->getNumberOfDecimationLevels() << endl;
+   }
+   for ( ossim_uint32 level = 0; ok && ( level < ref->getNumberOfDecimationLevels() ); ++level )
+   {
+      ossimIrect rect = ref->getImageRectangle( level );
+      if ( rect != ih->getImageRectangle( level ) )
+      {
+         ok = false;
+      }
+      else
+      {
+         ossimRefPtr<ossimImageData> expected = ref->getTile( rect, level );
+         if ( expected.valid() )
+         {
+            expected = static_cast<ossimImageData*>( expected->dup() );
+         }
+         ok = sameTile( ih->getTile( rect, level ).get(), expected.get() );
+      }
+      if ( !ok )
+      {
+         cout << file << ": level " << level << " differs from the reference" << endl;
+      }
+   }
+   ih->close();
+   ref->close();
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   ossimFilename reference = "ossim-cog-writer-test-reference.tif";
+   ossimFilename cog       = "ossim-cog-writer-test.tif";
+   ossimFilename fallback  = "ossim-cog-writer-test-fallback.tif";
+
+   bool test_failed = false;
+   if ( !writeReference( reference ) )
+   {
+      cout << "Could not write " << reference << endl;
+      return 1;
+   }
+
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   if ( write( writer.get(), cog, true ) )
+   {
+      bool ok = checkLayout( cog );
+      cout << "cog layout? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+
+      ok = checkPixels( cog, reference );
+      cout << "cog pixels match a tiled write? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+   }
+   else
+   {
+      cout << "Could not write " << cog << endl;
+      test_failed = true;
+   }
+
+   writer = new ossimFallbackTiffWriter();
+   if ( write( writer.get(), fallback, true ) )
+   {
+      bool ok = checkFallbackLayout( fallback ) &&
+         !ossimFilename( fallback + ".r0.tmp" ).exists();
+      cout << "fallback internal overviews? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+
+      ok = checkPixels( fallback, reference );
+      cout << "fallback pixels match a tiled write? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+   }
+   else
+   {
+      cout << "Could not write " << fallback << endl;
+      test_failed = true;
+   }
+   writer = 0;
+
+   reference.remove();
+   cog.remove();
+   fallback.remove();
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
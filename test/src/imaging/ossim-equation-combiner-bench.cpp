@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Times ossimEquationCombiner with the equation compiled and
+//              with the original interpreter, tile by tile over the inputs,
+//              and reports the largest difference between the two.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimEquationCombiner.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/init/ossimInit.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static void usage( const std::string& app )
+{
+   cout << app << " -e <equation> [-t <tile size>] <image1> [image2 ...]\n"
+        << "\nRuns the equation over the bounding rectangle of image1, once with"
+        << "\nthe compiled evaluator and once with the interpreter, e.g.:\n"
+        << "\n" << app << " -e \"(band(in[0],3)-band(in[0],2))/(band(in[0],3)+band(in[0],2))\" a.tif\n"
+        << endl;
+}
+
+static double run( ossimEquationCombiner* combiner,
+                   const std::vector<ossimIrect>& tiles,
+                   std::vector< ossimRefPtr<ossimImageData> >* results )
+{
+   ossimTimer* timer = ossimTimer::instance();
+   timer->setStartTick();
+   for ( std::vector<ossimIrect>::size_type i = 0; i < tiles.size(); ++i )
+   {
+      ossimRefPtr<ossimImageData> tile = combiner->getTile( tiles[i] );
+      if ( results )
+      {
+         results->push_back( tile.valid() ? (ossimImageData*)tile->dup() : 0 );
+      }
+   }
+   return timer->time_s();
+}
+
+int main(int argc, char* argv[])
+{
+   ossimArgumentParser ap(&argc, argv);
+   ossimInit::instance()->initialize(ap);
+
+   std::string equation;
+   std::string ts;
+   ossimArgumentParser::ossimParameter eqParam(equation);
+   ossimArgumentParser::ossimParameter tsParam(ts);
+   ap.read("-e", eqParam);
+   ossim_int32 tileSize = 256;
+   if ( ap.read("-t", tsParam) )
+   {
+      tileSize = ossimString(ts).toInt32();
+   }
+
+   if ( (ap.argc() < 2) || equation.empty() || (tileSize < 1) )
+   {
+      usage( std::string(argv[0]) );
+      return 1;
+   }
+
+   ossimConnectableObject::ConnectableObjectList inputs;
+   for ( int i = 1; i < ap.argc(); ++i )
+   {
+      ossimRefPtr<ossimImageHandler> ih =
+         ossimImageHandlerRegistry::instance()->open( ossimFilename(ap[i]) );
+      if ( !ih.valid() )
+      {
+         cerr << "Could not open: " << ap[i] << endl;
+         return 1;
+      }
+      inputs.push_back( ih.get() );
+   }
+
+   ossimIrect rect = ((ossimImageHandler*)inputs[0].get())->getBoundingRect();
+   std::vector<ossimIrect> tiles;
+   for ( ossim_int32 y = rect.ul().y; y <= rect.lr().y; y += tileSize )
+   {
+      for ( ossim_int32 x = rect.ul().x; x <= rect.lr().x; x += tileSize )
+      {
+         tiles.push_back( ossimIrect( x, y, x + tileSize - 1, y + tileSize - 1 ) );
+      }
+   }
+
+   ossimRefPtr<ossimEquationCombiner> compiled = new ossimEquationCombiner( inputs );
+   ossimRefPtr<ossimEquationCombiner> interpreted = new ossimEquationCombiner( inputs );
+   compiled->setEquation( equation );
+   interpreted->setEquation( equation );
+   interpreted->setCompileFlag( false );
+   compiled->initialize();
+   interpreted->initialize();
+
+   // First pass warms the image handler caches and keeps the results:
+   std::vector< ossimRefPtr<ossimImageData> > a;
+   std::vector< ossimRefPtr<ossimImageData> > b;
+   run( compiled.get(), tiles, &a );
+   run( interpreted.get(), tiles, &b );
+
+   double compiledTime    = run( compiled.get(), tiles, 0 );
+   double interpretedTime = run( interpreted.get(), tiles, 0 );
+
+   double maxDiff = 0.0;
+   ossim_uint32 mismatches = 0;
+   for ( std::vector<ossimIrect>::size_type i = 0; i < tiles.size(); ++i )
+   {
+      if ( a[i].valid() != b[i].valid() )
+      {
+         ++mismatches;
+         continue;
+      }
+      if ( !a[i].valid() ) continue;
+      if ( ( a[i]->getDataObjectStatus() != b[i]->getDataObjectStatus() ) ||
+           ( a[i]->getNumberOfBands() != b[i]->getNumberOfBands() ) )
+      {
+         ++mismatches;
+         continue;
+      }
+      if ( !a[i]->getBuf() || !b[i]->getBuf() ) continue;
+      for ( ossim_uint32 band = 0; band < a[i]->getNumberOfBands(); ++band )
+      {
+         const ossim_float64* pa = (const ossim_float64*)a[i]->getBuf( band );
+         const ossim_float64* pb = (const ossim_float64*)b[i]->getBuf( band );
+         for ( ossim_uint32 p = 0; p < a[i]->getSizePerBand(); ++p )
+         {
+            if ( std::isnan(pa[p]) && std::isnan(pb[p]) ) continue;
+            double diff = std::fabs( pa[p] - pb[p] );
+            if ( !(diff <= maxDiff) ) maxDiff = diff;
+         }
+      }
+   }
+
+   cout << std::setiosflags(ios::fixed) << std::setprecision(6)
+        << "equation:     " << equation
+        << "\ntiles:        " << tiles.size() << " of " << tileSize << "x" << tileSize
+        << "\ncompiled:     " << compiledTime << " s"
+        << "\ninterpreted:  " << interpretedTime << " s"
+        << "\nspeedup:      " << std::setprecision(2)
+        << ( compiledTime > 0.0 ? interpretedTime / compiledTime : 0.0 )
+        << "\nmax diff:     " << std::setprecision(6) << maxDiff
+        << "\nmismatches:   " << mismatches << endl;
+
+   return mismatches ? 1 : 0;
+}
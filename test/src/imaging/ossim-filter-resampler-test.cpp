@@ -0,0 +1,223 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossimFilterResampler.  Resamples scale only
+//              transforms with the separable two pass path and with the
+//              general kernel loop and compares the outputs, for each
+//              scalar type, several filters and scales, with nulls in the
+//              input.
+//
+//              Optional argument: none, sse2 or avx2 caps the kernels the
+//              separable path uses (preference resampler.simd).
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimScalarTypeLut.h>
+#include <ossim/imaging/ossimFilterResampler.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/init/ossimInit.h>
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+static const ossim_int32 INPUT_WIDTH   = 160;
+static const ossim_int32 INPUT_HEIGHT  = 120;
+static const ossim_int32 OUTPUT_WIDTH  = 47;
+static const ossim_int32 OUTPUT_HEIGHT = 39;
+static const ossim_uint32 BANDS        = 3;
+
+//---
+// Pattern within the valid range of the type, with scattered nulls, a block
+// null in one band and a block null in all bands.
+//---
+template <class T>
+static void fill( ossimImageData* data )
+{
+   for ( ossim_uint32 band = 0; band < BANDS; ++band )
+   {
+      T* buf = static_cast<T*>( data->getBuf( band ) );
+      // The float types default to the full range, keep them near zero:
+      const bool   FLOATS = ( data->getScalarType() == OSSIM_FLOAT32 ) ||
+         ( data->getScalarType() == OSSIM_FLOAT64 );
+      const double NP   = data->getNullPix( band );
+      const double MIN  = FLOATS ? -1000.0 : data->getMinPix( band );
+      const double MAX  = FLOATS ? 1000.0 : data->getMaxPix( band );
+      const double SPAN = std::min( MAX - MIN, 60000.0 );
+      for ( ossim_int32 y = 0; y < INPUT_HEIGHT; ++y )
+      {
+         for ( ossim_int32 x = 0; x < INPUT_WIDTH; ++x )
+         {
+            double value;
+            if ( ( ( x * 7 + y * 13 + band ) % 37 == 0 ) ||
+                 ( ( band == 1 ) && ( x >= 40 ) && ( x < 60 ) && ( y >= 20 ) && ( y < 30 ) ) ||
+                 ( ( x >= 90 ) && ( x < 110 ) && ( y >= 60 ) && ( y < 75 ) ) )
+            {
+               value = NP;
+            }
+            else
+            {
+               // Fractions only show up in the float types:
+               double t = ( ( x * 31 + y * 17 + band * 101 ) % 997 ) / 996.0;
+               value = MIN + t * SPAN + 0.25;
+               if ( value > MAX ) value = MAX;
+            }
+            buf[y * INPUT_WIDTH + x] = static_cast<T>( value );
+         }
+      }
+   }
+   data->validate();
+}
+
+static void fill( ossimImageData* data )
+{
+   switch ( data->getScalarType() )
+   {
+      case OSSIM_UINT8:   fill<ossim_uint8>( data );   break;
+      case OSSIM_SINT8:   fill<ossim_sint8>( data );   break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11: fill<ossim_uint16>( data ); break;
+      case OSSIM_SINT16:  fill<ossim_sint16>( data );  break;
+      case OSSIM_UINT32:  fill<ossim_uint32>( data );  break;
+      case OSSIM_SINT32:  fill<ossim_sint32>( data );  break;
+      case OSSIM_FLOAT32: fill<ossim_float32>( data ); break;
+      case OSSIM_FLOAT64: fill<ossim_float64>( data ); break;
+      default: break;
+   }
+}
+
+//---
+// Integer outputs are truncated, so a different summing order can move a
+// value by one.  Float outputs may differ in the last bits.  Nulls must
+// match exactly.
+//---
+static bool compare( const ossimImageData* a, const ossimImageData* b,
+                     double& maxDiff, ossim_uint32& diffCount )
+{
+   const bool FLOATS = ( a->getScalarType() == OSSIM_FLOAT32 ) ||
+      ( a->getScalarType() == OSSIM_FLOAT64 );
+   bool result = true;
+   maxDiff = 0.0;
+   diffCount = 0;
+   for ( ossim_uint32 band = 0; band < BANDS; ++band )
+   {
+      const double NP = a->getNullPix( band );
+      for ( ossim_int32 y = 0; y < OUTPUT_HEIGHT; ++y )
+      {
+         for ( ossim_int32 x = 0; x < OUTPUT_WIDTH; ++x )
+         {
+            ossim_uint32 offset = y * OUTPUT_WIDTH + x;
+            double va = a->getPix( offset, band );
+            double vb = b->getPix( offset, band );
+            if ( ( va == NP ) != ( vb == NP ) )
+            {
+               result = false;
+               ++diffCount;
+               continue;
+            }
+            double diff = std::fabs( va - vb );
+            if ( diff > 0.0 )
+            {
+               ++diffCount;
+               maxDiff = std::max( maxDiff, diff );
+            }
+            double tolerance = FLOATS ? 1.0e-5 * std::max( 1.0, std::fabs( va ) ) : 1.0;
+            if ( diff > tolerance )
+            {
+               result = false;
+            }
+         }
+      }
+   }
+   return result;
+}
+
+static ossimRefPtr<ossimImageData> resample( ossimImageData* input, const char* filter,
+                                             double step, bool separable )
+{
+   ossimRefPtr<ossimImageData> output =
+      new ossimImageData( 0, input->getScalarType(), BANDS, OUTPUT_WIDTH, OUTPUT_HEIGHT );
+   output->initialize();
+   output->makeBlank();
+
+   ossimFilterResampler resampler;
+   resampler.setFilterType( filter );
+   resampler.setScaleFactor( ossimDpt( 1.0 / step, 1.0 / step ) );
+   resampler.setSeparableFlag( separable );
+
+   // Offset so the widest kernel stays inside the input tile:
+   ossimDpt ul( 12.3, 10.7 );
+   ossimDpt ur( ul.x + step * ( OUTPUT_WIDTH - 1 ), ul.y );
+   ossimDpt delta( 0.0, step );
+   resampler.resample( input, output, ul, ur, delta, delta,
+                       ossimDpt( OUTPUT_WIDTH, OUTPUT_HEIGHT ) );
+   return output;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   if ( argc > 1 )
+   {
+      ossimPreferences::instance()->addPreference( "resampler.simd", argv[1] );
+   }
+
+   const ossimScalarType TYPES[] =
+   {
+      OSSIM_UINT8, OSSIM_SINT8, OSSIM_UINT16, OSSIM_USHORT11, OSSIM_SINT16,
+      OSSIM_UINT32, OSSIM_SINT32, OSSIM_FLOAT32, OSSIM_FLOAT64
+   };
+   const char* FILTERS[] = { "nearest neighbor", "bilinear", "cubic", "lanczos", "gaussian" };
+   const double STEPS[]  = { 0.37, 1.0, 2.3 };
+
+   bool test_failed = false;
+   for ( ossim_uint32 t = 0; t < sizeof( TYPES ) / sizeof( TYPES[0] ); ++t )
+   {
+      ossimRefPtr<ossimImageData> input =
+         new ossimImageData( 0, TYPES[t], BANDS, INPUT_WIDTH, INPUT_HEIGHT );
+      input->initialize();
+      fill( input.get() );
+
+      bool ok = true;
+      double maxDiff = 0.0;
+      ossim_uint32 diffCount = 0;
+      for ( ossim_uint32 f = 0; f < sizeof( FILTERS ) / sizeof( FILTERS[0] ); ++f )
+      {
+         for ( ossim_uint32 s = 0; s < sizeof( STEPS ) / sizeof( STEPS[0] ); ++s )
+         {
+            ossimRefPtr<ossimImageData> separable =
+               resample( input.get(), FILTERS[f], STEPS[s], true );
+            ossimRefPtr<ossimImageData> general =
+               resample( input.get(), FILTERS[f], STEPS[s], false );
+            double diff;
+            ossim_uint32 count;
+            if ( !compare( separable.get(), general.get(), diff, count ) )
+            {
+               cout << FILTERS[f] << ", step " << STEPS[s] << ": " << count
+                    << " pixels differ, max " << diff << endl;
+               ok = false;
+            }
+            maxDiff = std::max( maxDiff, diff );
+            diffCount += count;
+         }
+      }
+
+      cout << "separable matches general, "
+           << ossimScalarTypeLut::instance()->getEntryString( TYPES[t] )
+           << " (" << diffCount << " pixels off, max " << maxDiff << ")? "
+           << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
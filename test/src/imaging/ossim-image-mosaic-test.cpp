@@ -0,0 +1,323 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossimImageMosaic.  Compares the mosaic, which
+//              asks the lower layers only for the rect still null, with a
+//              brute force compositing of every layer's full tile.  Covers
+//              nulls in one band only, inputs of different scalar types
+//              (the normalized path) and fewer bands, and the valid
+//              footprints option, which must skip requests without changing
+//              the output.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageMosaic.h>
+#include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/init/ossimInit.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim_int32 TILE_SIZE = 64;
+
+// Counts the requests reaching a layer.  Optionally claims a triangular footprint.
+class CountingSource : public ossimImageSourceFilter
+{
+public:
+   CountingSource( ossimImageSource* input, const std::vector<ossimIpt>& footprint )
+      : ossimImageSourceFilter( input ), m_footprint( footprint ), m_requests()
+   {
+   }
+
+   using ossimImageSourceFilter::getTile;
+
+   virtual ossimRefPtr<ossimImageData> getTile( const ossimIrect& rect, ossim_uint32 resLevel )
+   {
+      m_requests.push_back( rect );
+      return ossimImageSourceFilter::getTile( rect, resLevel );
+   }
+
+   virtual void getValidImageVertices( std::vector<ossimIpt>& vertices,
+                                       ossimVertexOrdering ordering,
+                                       ossim_uint32 resLevel ) const
+   {
+      if ( m_footprint.empty() )
+      {
+         ossimImageSourceFilter::getValidImageVertices( vertices, ordering, resLevel );
+      }
+      else
+      {
+         vertices = m_footprint;
+      }
+   }
+
+   std::vector<ossimIpt>   m_footprint;
+   std::vector<ossimIrect> m_requests;
+};
+
+struct Layer
+{
+   ossimScalarType scalar;
+   ossim_uint32    bands;
+   ossimIrect      rect;
+   bool            triangle; // Null below the diagonal, footprint to match.
+};
+
+// Values from 1 up, a null grid in band 1 only and a null block in every band.
+template <class T>
+static void fill( ossimImageData* data, const Layer& layer, ossim_uint32 seed )
+{
+   for ( ossim_uint32 band = 0; band < layer.bands; ++band )
+   {
+      T* buf = static_cast<T*>( data->getBuf( band ) );
+      const double MAX = std::min( data->getMaxPix( band ), 5000.0 );
+      ossim_int32 w = layer.rect.width();
+      ossim_int32 h = layer.rect.height();
+      for ( ossim_int32 y = 0; y < h; ++y )
+      {
+         for ( ossim_int32 x = 0; x < w; ++x )
+         {
+            bool isNull = ( ( band == 1 ) && ( ( x % 7 == 3 ) || ( y % 11 == 5 ) ) ) ||
+               ( ( x >= w / 3 ) && ( x < w / 2 ) && ( y >= h / 4 ) && ( y < h / 2 ) ) ||
+               ( layer.triangle && ( x * h + y * w >= w * h ) );
+            double value = 1.0 + ( ( x * 13 + y * 7 + band * 31 + seed * 17 ) % 997 ) *
+               ( MAX - 1.0 ) / 997.0;
+            buf[y * w + x] = static_cast<T>( isNull ? data->getNullPix( band ) : value );
+         }
+      }
+   }
+}
+
+static ossimRefPtr<CountingSource> createLayer( const Layer& layer, ossim_uint32 seed )
+{
+   ossimRefPtr<ossimImageData> data = new ossimImageData(
+      0, layer.scalar, layer.bands, layer.rect.width(), layer.rect.height() );
+   data->initialize();
+   data->setImageRectangle( layer.rect );
+   switch ( layer.scalar )
+   {
+      case OSSIM_UINT8:  fill<ossim_uint8>( data.get(), layer, seed );  break;
+      case OSSIM_UINT16: fill<ossim_uint16>( data.get(), layer, seed ); break;
+      default: break;
+   }
+   data->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> memory = new ossimMemoryImageSource();
+   memory->setImage( data );
+
+   std::vector<ossimIpt> footprint;
+   if ( layer.triangle )
+   {
+      footprint.push_back( layer.rect.ul() );
+      footprint.push_back( layer.rect.ur() );
+      footprint.push_back( layer.rect.ll() );
+   }
+   return new CountingSource( memory.get(), footprint );
+}
+
+//---
+// The mosaic done the long way: every layer's full tile, top down, the first
+// non null value of each band wins.  Fewer bands repeat the last one.  With
+// different inputs the values go through the normalized buffer as in the
+// mosaic.
+//---
+template <class T>
+static bool compareTile( std::vector<ossimRefPtr<CountingSource> >& layers,
+                         const ossimImageData* mosaicTile, bool normalized )
+{
+   const ossimIrect rect = mosaicTile->getImageRectangle();
+   const ossim_uint32 bands = mosaicTile->getNumberOfBands();
+   const ossim_uint32 size = mosaicTile->getSizePerBand();
+
+   std::vector< std::vector<T> > expected( bands );
+   for ( ossim_uint32 band = 0; band < bands; ++band )
+   {
+      expected[band].assign( size, static_cast<T>( mosaicTile->getNullPix( band ) ) );
+   }
+
+   for ( ossim_uint32 idx = 0; idx < layers.size(); ++idx )
+   {
+      ossimRefPtr<ossimImageData> tile = layers[idx]->getTile( rect, 0 );
+      if ( !tile.valid() || ( tile->getDataObjectStatus() == OSSIM_EMPTY ) )
+      {
+         continue;
+      }
+      ossim_uint32 srcBands = tile->getNumberOfBands();
+      std::vector<float> norm( size * srcBands );
+      tile->copyTileToNormalizedBuffer( &norm.front() );
+      for ( ossim_uint32 band = 0; band < bands; ++band )
+      {
+         ossim_uint32 srcBand = std::min( band, srcBands - 1 );
+         const T np = static_cast<T>( mosaicTile->getNullPix( band ) );
+         const T minP = static_cast<T>( mosaicTile->getMinPix( band ) );
+         const T maxP = static_cast<T>( mosaicTile->getMaxPix( band ) );
+         const float delta = maxP - minP;
+         for ( ossim_uint32 i = 0; i < size; ++i )
+         {
+            if ( expected[band][i] != np )
+            {
+               continue;
+            }
+            if ( normalized )
+            {
+               float value = norm[srcBand * size + i];
+               if ( value != 0.0f )
+               {
+                  expected[band][i] = static_cast<T>( minP + delta * value );
+               }
+            }
+            else if ( tile->getPix( i, srcBand ) != tile->getNullPix( srcBand ) )
+            {
+               expected[band][i] = static_cast<T>( tile->getPix( i, srcBand ) );
+            }
+         }
+      }
+   }
+
+   for ( ossim_uint32 band = 0; band < bands; ++band )
+   {
+      const T* buf = static_cast<const T*>( mosaicTile->getBuf( band ) );
+      for ( ossim_uint32 i = 0; i < size; ++i )
+      {
+         if ( buf[i] != expected[band][i] )
+         {
+            cout << "tile " << rect << " band " << band << " differs at ("
+                 << rect.ul().x + (ossim_int32)( i % rect.width() ) << ", "
+                 << rect.ul().y + (ossim_int32)( i / rect.width() ) << "): "
+                 << (double)buf[i] << " expected " << (double)expected[band][i] << endl;
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+//---
+// Mosaics the layers tile by tile over a grid that starts off the tile
+// boundaries and runs past the image, and compares every tile.  Returns the
+// number of requests the layers got from the mosaic, 0 on a mismatch.
+//---
+static ossim_uint32 runMosaic( const std::vector<Layer>& config, bool footprints,
+                               bool& requestsInsideHoles )
+{
+   std::vector<ossimRefPtr<CountingSource> > layers;
+   ossimConnectableObject::ConnectableObjectList inputs;
+   for ( ossim_uint32 idx = 0; idx < config.size(); ++idx )
+   {
+      layers.push_back( createLayer( config[idx], idx ) );
+      inputs.push_back( layers.back().get() );
+   }
+   ossimRefPtr<ossimImageMosaic> mosaic = new ossimImageMosaic( inputs );
+   mosaic->setUseValidFootprintsFlag( footprints );
+   mosaic->initialize();
+
+   bool normalized = false;
+   for ( ossim_uint32 idx = 1; idx < config.size(); ++idx )
+   {
+      normalized |= ( config[idx].scalar != config[0].scalar );
+   }
+
+   ossimIrect bounds = mosaic->getBoundingRect();
+   ossim_uint32 total = 0;
+   bool ok = true;
+   requestsInsideHoles = true;
+   for ( ossim_int32 y = bounds.ul().y - 10; ok && ( y <= bounds.lr().y + 10 ); y += TILE_SIZE )
+   {
+      for ( ossim_int32 x = bounds.ul().x - 20; ok && ( x <= bounds.lr().x + 20 ); x += TILE_SIZE )
+      {
+         ossimIrect rect( x, y, x + TILE_SIZE - 1, y + TILE_SIZE - 1 );
+         for ( ossim_uint32 idx = 0; idx < layers.size(); ++idx )
+         {
+            layers[idx]->m_requests.clear();
+         }
+         ossimRefPtr<ossimImageData> tile = mosaic->getTile( rect, 0 );
+         if ( !tile.valid() || ( tile->getImageRectangle() != rect ) )
+         {
+            ok = false;
+            break;
+         }
+         ossimRefPtr<ossimImageData> copy = static_cast<ossimImageData*>( tile->dup() );
+
+         // Every layer is asked for a part of the tile at most once per tile:
+         for ( ossim_uint32 idx = 0; idx < layers.size(); ++idx )
+         {
+            const std::vector<ossimIrect>& requests = layers[idx]->m_requests;
+            requestsInsideHoles &= ( requests.size() <= 1 ) &&
+               ( requests.empty() || requests[0].completely_within( rect ) );
+         }
+         ossim_uint32 count = 0;
+         for ( ossim_uint32 idx = 0; idx < layers.size(); ++idx )
+         {
+            count += (ossim_uint32)layers[idx]->m_requests.size();
+         }
+
+         switch ( copy->getScalarType() )
+         {
+            case OSSIM_UINT8:
+               ok = compareTile<ossim_uint8>( layers, copy.get(), normalized );
+               break;
+            case OSSIM_UINT16:
+               ok = compareTile<ossim_uint16>( layers, copy.get(), normalized );
+               break;
+            default:
+               ok = false;
+         }
+         total += count;
+      }
+   }
+   return ok ? total : 0;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+
+   // Top down: a partial layer, a triangle, one over everything, one hidden.
+   std::vector<Layer> layers;
+   Layer top      = { OSSIM_UINT8, 3, ossimIrect( 20, 10, 169, 109 ), false };
+   Layer triangle = { OSSIM_UINT8, 3, ossimIrect( 60, 40, 315, 231 ), true };
+   Layer base     = { OSSIM_UINT8, 3, ossimIrect( 0, 0, 299, 219 ), false };
+   Layer hidden   = { OSSIM_UINT8, 3, ossimIrect( 0, 150, 39, 191 ), false };
+   layers.push_back( top );
+   layers.push_back( triangle );
+   layers.push_back( base );
+   layers.push_back( hidden );
+
+   bool inside = false;
+   ossim_uint32 requests = runMosaic( layers, false, inside );
+   bool ok = ( requests > 0 ) && inside;
+   cout << "hole rect mosaic matches full tile compositing? " << ( ok ? "PASSED" : "FAILED" )
+        << endl;
+   test_failed |= !ok;
+
+   ossim_uint32 footprintRequests = runMosaic( layers, true, inside );
+   ok = ( footprintRequests > 0 ) && ( footprintRequests < requests ) && inside;
+   cout << "valid footprints skip requests, same output (" << footprintRequests << " of "
+        << requests << " requests)? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+
+   // Mixed scalar types and a single band layer go through the normalized path:
+   layers[1].scalar = OSSIM_UINT16;
+   layers[2].bands = 1;
+   ok = ( runMosaic( layers, false, inside ) > 0 ) && inside &&
+        ( runMosaic( layers, true, inside ) > 0 ) && inside;
+   cout << "normalized mosaic matches full tile compositing? " << ( ok ? "PASSED" : "FAILED" )
+        << endl;
+   test_failed |= !ok;
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
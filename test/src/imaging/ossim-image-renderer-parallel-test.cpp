@@ -0,0 +1,237 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the parallel resample of ossimImageRenderer.
+//              Renders the same views with the parallel threshold at 0, all
+//              tiles on the calling thread, and at 1, every tile on the
+//              thread pool, and compares the tiles.  Covers the same scale,
+//              a zoom out onto computed reduced resolution levels, a view
+//              whose scale changes enough across a tile to need several
+//              levels, some with sub rects too far apart for one read, and
+//              a view across the dateline.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimFilterResampler.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/imaging/ossimImageRenderer.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <ossim/projection/ossimEquDistCylProjection.h>
+#include <ossim/projection/ossimMercatorProjection.h>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+static const ossim_int32 IMAGE_WIDTH  = 1024;
+static const ossim_int32 IMAGE_HEIGHT = 512;
+
+// Latitude span, short of the poles where the mercator view has no points:
+static const double LAT_SPAN = 170.0;
+
+// All longitudes, geographic:
+static ossimRefPtr<ossimImageGeometry> createImageGeometry()
+{
+   ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+   proj->setDecimalDegreesPerPixel( ossimDpt( 360.0 / IMAGE_WIDTH, LAT_SPAN / IMAGE_HEIGHT ) );
+   proj->setUlTiePoints( ossimGpt( LAT_SPAN / 2.0, -180.0, 0.0 ) );
+   ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry( 0, proj.get() );
+
+   // The renderer walks the image edges for the view bounds:
+   geom->setImageSize( ossimIpt( IMAGE_WIDTH, IMAGE_HEIGHT ) );
+   return geom;
+}
+
+static ossimRefPtr<ossimImageSource> createSource()
+{
+   ossimRefPtr<ossimImageData> data =
+      new ossimImageData( 0, OSSIM_UINT8, 3, IMAGE_WIDTH, IMAGE_HEIGHT );
+   data->initialize();
+   for ( ossim_uint32 band = 0; band < 3; ++band )
+   {
+      ossim_uint8* buf = static_cast<ossim_uint8*>( data->getBuf( band ) );
+      for ( ossim_int32 y = 0; y < IMAGE_HEIGHT; ++y )
+      {
+         for ( ossim_int32 x = 0; x < IMAGE_WIDTH; ++x )
+         {
+            buf[y * IMAGE_WIDTH + x] = (ossim_uint8)( ( x * 5 + y * 3 + band * 60 ) % 255 + 1 );
+         }
+      }
+   }
+   data->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage( data );
+   source->setImageGeometry( createImageGeometry().get() );
+   return source.get();
+}
+
+static ossimRefPtr<ossimImageGeometry> createGeographicView( double scale, double lon )
+{
+   ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+   proj->setDecimalDegreesPerPixel( ossimDpt( scale * 360.0 / IMAGE_WIDTH,
+                                              scale * LAT_SPAN / IMAGE_HEIGHT ) );
+   proj->setUlTiePoints( ossimGpt( 60.0, lon, 0.0 ) );
+   return new ossimImageGeometry( 0, proj.get() );
+}
+
+// North is stretched by 1/cos(lat), so a tile from the equator to 80 degrees spans levels:
+static ossimRefPtr<ossimImageGeometry> createMercatorView()
+{
+   ossimRefPtr<ossimMercatorProjection> proj = new ossimMercatorProjection();
+   proj->setMetersPerPixel( ossimDpt( 100000.0, 100000.0 ) );
+   proj->setUlTiePoints( ossimGpt( 82.0, -40.0, 0.0 ) );
+   return new ossimImageGeometry( 0, proj.get() );
+}
+
+static bool sameTile( const ossimImageData* a, const ossimImageData* b )
+{
+   if ( !a || !b )
+   {
+      return ( a == b );
+   }
+   if ( ( a->getDataObjectStatus() != b->getDataObjectStatus() ) ||
+        ( a->getImageRectangle() != b->getImageRectangle() ) ||
+        ( a->getNumberOfBands() != b->getNumberOfBands() ) )
+   {
+      return false;
+   }
+   if ( !a->getBuf() || !b->getBuf() )
+   {
+      return ( a->getBuf() == b->getBuf() );
+   }
+   for ( ossim_uint32 band = 0; band < a->getNumberOfBands(); ++band )
+   {
+      if ( memcmp( a->getBuf( band ), b->getBuf( band ), a->getSizePerBandInBytes() ) != 0 )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+//---
+// Renders rects with the threshold at 0 and at 1 and compares.  Also
+// checks the tiles are not all empty so the view actually hits the image.
+//---
+static bool check( const char* name, ossimImageGeometry* view,
+                   const ossimIrect* rects, ossim_uint32 count )
+{
+   ossimRefPtr<ossimImageSource> source = createSource();
+   ossimRefPtr<ossimImageRenderer> renderer = new ossimImageRenderer();
+   renderer->connectMyInputTo( 0, source.get() );
+   renderer->setView( view );
+   renderer->initialize();
+
+   bool ok = true;
+   bool anyData = false;
+   for ( ossim_uint32 idx = 0; idx < count; ++idx )
+   {
+      renderer->setParallelThreshold( 0 );
+      ossimRefPtr<ossimImageData> serial = renderer->getTile( rects[idx] );
+      if ( serial.valid() )
+      {
+         serial = static_cast<ossimImageData*>( serial->dup() );
+         anyData |= ( serial->getDataObjectStatus() != OSSIM_EMPTY ) &&
+            ( serial->getDataObjectStatus() != OSSIM_NULL );
+      }
+
+      renderer->setParallelThreshold( 1 );
+      ossimRefPtr<ossimImageData> parallel = renderer->getTile( rects[idx] );
+
+      if ( !sameTile( serial.get(), parallel.get() ) )
+      {
+         cout << name << ": tile " << rects[idx] << " differs" << endl;
+         ok = false;
+      }
+   }
+   if ( !anyData )
+   {
+      cout << name << ": no tile hit the image" << endl;
+      ok = false;
+   }
+
+   renderer->disconnect();
+   cout << name << "? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   // The parallel path needs two pool threads, whatever the machine has:
+   ossimPreferences::instance()->addPreference( "ossim_threads", "4" );
+
+   if ( ossim::ThreadPool::instance()->getNumberOfThreads() < 2 )
+   {
+      cout << "Thread pool has fewer than two threads, nothing to compare." << endl;
+      return 1;
+   }
+
+   bool test_failed = false;
+
+   const ossimIrect TILES[] =
+   {
+      ossimIrect( 0, 0, 255, 255 ),
+      ossimIrect( 256, 0, 511, 255 ),
+      ossimIrect( 100, 50, 611, 561 ),  // Not tile aligned, crosses the image edge.
+      ossimIrect( -128, -128, 127, 127 )
+   };
+   const ossim_uint32 COUNT = sizeof( TILES ) / sizeof( TILES[0] );
+
+   test_failed |= !check( "same scale", createGeographicView( 1.0, -170.0 ).get(), TILES, COUNT );
+   test_failed |= !check( "zoom out, computed levels",
+                          createGeographicView( 3.3, -170.0 ).get(), TILES, COUNT );
+   test_failed |= !check( "mercator, levels change across a tile",
+                          createMercatorView().get(), TILES, COUNT );
+
+   // View starting west of the dateline, the image sub rects are at both ends:
+   const ossimIrect DATELINE[] =
+   {
+      ossimIrect( 0, 0, 255, 255 ),
+      ossimIrect( -64, 0, 447, 511 )
+   };
+   test_failed |= !check( "dateline", createGeographicView( 1.0, 160.0 ).get(),
+                          DATELINE, sizeof( DATELINE ) / sizeof( DATELINE[0] ) );
+
+   // Changing the filter must reach the pool resamplers:
+   {
+      ossimRefPtr<ossimImageSource> source = createSource();
+      ossimRefPtr<ossimImageRenderer> renderer = new ossimImageRenderer();
+      renderer->connectMyInputTo( 0, source.get() );
+      renderer->setView( createGeographicView( 0.7, -170.0 ).get() );
+      renderer->initialize();
+
+      bool ok = true;
+      const char* FILTERS[] = { "nearest neighbor", "bilinear", "cubic", "nearest neighbor" };
+      for ( ossim_uint32 f = 0; f < 4; ++f )
+      {
+         renderer->getResampler()->setFilterType( FILTERS[f] );
+         renderer->setParallelThreshold( 0 );
+         ossimRefPtr<ossimImageData> serial =
+            static_cast<ossimImageData*>( renderer->getTile( TILES[0] )->dup() );
+         renderer->setParallelThreshold( 1 );
+         ok = ok && sameTile( serial.get(), renderer->getTile( TILES[0] ).get() );
+      }
+      renderer->disconnect();
+      cout << "filter change? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
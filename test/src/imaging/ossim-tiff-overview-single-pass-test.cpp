@@ -0,0 +1,226 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the single pass mode of
+//              ossimTiffOverviewBuilder.  Builds the overviews of a small
+//              image once in a single pass and once level by level, for
+//              several scalar types and both resampling types, and compares
+//              every level.  The input has nulls so the box filter has to
+//              skip them.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimScalarTypeLut.h>
+#include <ossim/imaging/ossimFilterResampler.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimTiffOverviewBuilder.h>
+#include <ossim/imaging/ossimTiffWriter.h>
+#include <ossim/init/ossimInit.h>
+#include <iostream>
+using namespace std;
+
+// Odd sizes so the last tile of every level is partial:
+static const ossim_int32 IMAGE_WIDTH  = 530;
+static const ossim_int32 IMAGE_HEIGHT = 410;
+static const ossim_int32 TILE_SIZE    = 64;
+static const ossim_uint32 BANDS       = 2;
+
+template <class T>
+static void fill( ossimImageData* data )
+{
+   const bool FLOATS = ( data->getScalarType() == OSSIM_FLOAT32 ) ||
+      ( data->getScalarType() == OSSIM_FLOAT64 );
+   for ( ossim_uint32 band = 0; band < BANDS; ++band )
+   {
+      T* buf = static_cast<T*>( data->getBuf( band ) );
+      const double NP  = data->getNullPix( band );
+      const double MIN = FLOATS ? -500.0 : data->getMinPix( band );
+      const double MAX = FLOATS ? 500.0 : data->getMaxPix( band );
+      for ( ossim_int32 y = 0; y < IMAGE_HEIGHT; ++y )
+      {
+         for ( ossim_int32 x = 0; x < IMAGE_WIDTH; ++x )
+         {
+            double value;
+            if ( ( ( x * 5 + y * 3 + band ) % 23 == 0 ) ||
+                 ( ( x >= 100 ) && ( x < 190 ) && ( y >= 50 ) && ( y < 121 ) ) )
+            {
+               value = NP;
+            }
+            else
+            {
+               double t = ( ( x * 13 + y * 29 + band * 7 ) % 251 ) / 250.0;
+               value = MIN + t * ( MAX - MIN ) + 0.5;
+               if ( value > MAX ) value = MAX;
+            }
+            buf[y * IMAGE_WIDTH + x] = static_cast<T>( value );
+         }
+      }
+   }
+}
+
+static ossimRefPtr<ossimImageSource> createSource( ossimScalarType scalar )
+{
+   ossimRefPtr<ossimImageData> data =
+      new ossimImageData( 0, scalar, BANDS, IMAGE_WIDTH, IMAGE_HEIGHT );
+   data->initialize();
+   switch ( scalar )
+   {
+      case OSSIM_UINT8:   fill<ossim_uint8>( data.get() );   break;
+      case OSSIM_UINT16:  fill<ossim_uint16>( data.get() );  break;
+      case OSSIM_SINT16:  fill<ossim_sint16>( data.get() );  break;
+      case OSSIM_FLOAT32: fill<ossim_float32>( data.get() ); break;
+      case OSSIM_FLOAT64: fill<ossim_float64>( data.get() ); break;
+      default: break;
+   }
+   data->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage( data );
+   return source.get();
+}
+
+static bool writeImage( ossimScalarType scalar, const ossimFilename& file )
+{
+   ossimRefPtr<ossimImageSource> source = createSource( scalar );
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   writer->setGeotiffFlag( false );
+   writer->setTileSize( ossimIpt( TILE_SIZE, TILE_SIZE ) );
+   writer->setOutputName( file );
+   writer->connectMyInputTo( 0, source.get() );
+   bool result = writer->execute();
+   writer->disconnect();
+   return result;
+}
+
+static bool buildOverviews( const ossimFilename& image, const ossimFilename& ovr,
+                            ossimFilterResampler::ossimFilterResamplerType type,
+                            bool singlePass )
+{
+   ossimRefPtr<ossimImageHandler> ih = ossimImageHandlerRegistry::instance()->open( image );
+   ossimRefPtr<ossimTiffOverviewBuilder> ob = new ossimTiffOverviewBuilder();
+   bool result = ih.valid() && ob->setInputSource( ih.get() );
+   if ( result )
+   {
+      ob->setResampleType( type );
+      ob->setOutputTileSize( ossimIpt( TILE_SIZE, TILE_SIZE ) );
+      ob->setSinglePassFlag( singlePass );
+      ob->setOutputFile( ovr );
+      result = ob->execute();
+   }
+   ob = 0;
+   if ( ih.valid() )
+   {
+      ih->close();
+   }
+   return result;
+}
+
+// Compares every level of two overview files, the nulls included.
+static bool compareLevels( const ossimFilename& a, const ossimFilename& b,
+                           ossim_uint32& levels )
+{
+   ossimRefPtr<ossimImageHandler> ha = ossimImageHandlerRegistry::instance()->open( a );
+   ossimRefPtr<ossimImageHandler> hb = ossimImageHandlerRegistry::instance()->open( b );
+   levels = 0;
+   if ( !ha.valid() || !hb.valid() )
+   {
+      return false;
+   }
+   levels = ha->getNumberOfDecimationLevels();
+   bool result = ( levels > 1 ) && ( levels == hb->getNumberOfDecimationLevels() );
+   for ( ossim_uint32 level = 0; result && ( level < levels ); ++level )
+   {
+      ossimIrect rect = ha->getImageRectangle( level );
+      result = ( rect == hb->getImageRectangle( level ) );
+      for ( ossim_int32 y = rect.ul().y; result && ( y <= rect.lr().y ); y += TILE_SIZE )
+      {
+         for ( ossim_int32 x = rect.ul().x; result && ( x <= rect.lr().x ); x += TILE_SIZE )
+         {
+            ossimIrect tileRect( x, y, x + TILE_SIZE - 1, y + TILE_SIZE - 1 );
+            ossimRefPtr<ossimImageData> ta = ha->getTile( tileRect, level );
+            ossimRefPtr<ossimImageData> tb = hb->getTile( tileRect, level );
+            if ( !ta.valid() || !tb.valid() )
+            {
+               result = ( ta.valid() == tb.valid() );
+               continue;
+            }
+            for ( ossim_uint32 band = 0; result && ( band < BANDS ); ++band )
+            {
+               for ( ossim_uint32 i = 0; i < ta->getSizePerBand(); ++i )
+               {
+                  if ( ta->getPix( i, band ) != tb->getPix( i, band ) )
+                  {
+                     cout << "level " << level << " band " << band << " differs at ("
+                          << x + (ossim_int32)( i % TILE_SIZE ) << ", "
+                          << y + (ossim_int32)( i / TILE_SIZE ) << ")" << endl;
+                     result = false;
+                     break;
+                  }
+               }
+            }
+         }
+      }
+   }
+   ha->close();
+   hb->close();
+   return result;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   const ossimScalarType TYPES[] =
+   {
+      OSSIM_UINT8, OSSIM_UINT16, OSSIM_SINT16, OSSIM_FLOAT32, OSSIM_FLOAT64
+   };
+   const ossimFilterResampler::ossimFilterResamplerType RESAMPLERS[] =
+   {
+      ossimFilterResampler::ossimFilterResampler_BOX,
+      ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR
+   };
+
+   const ossimFilename IMAGE  = "ossim-tiff-overview-single-pass-test.tif";
+   const ossimFilename SINGLE = "ossim-tiff-overview-single-pass-test-single.ovr";
+   const ossimFilename LEVELS = "ossim-tiff-overview-single-pass-test-levels.ovr";
+
+   bool test_failed = false;
+   for ( ossim_uint32 t = 0; t < sizeof( TYPES ) / sizeof( TYPES[0] ); ++t )
+   {
+      for ( ossim_uint32 r = 0; r < sizeof( RESAMPLERS ) / sizeof( RESAMPLERS[0] ); ++r )
+      {
+         ossim_uint32 levels = 0;
+         bool ok = writeImage( TYPES[t], IMAGE ) &&
+            buildOverviews( IMAGE, SINGLE, RESAMPLERS[r], true ) &&
+            buildOverviews( IMAGE, LEVELS, RESAMPLERS[r], false ) &&
+            compareLevels( SINGLE, LEVELS, levels );
+
+         cout << "single pass matches level by level, "
+              << ossimScalarTypeLut::instance()->getEntryString( TYPES[t] )
+              << ( ( RESAMPLERS[r] == ossimFilterResampler::ossimFilterResampler_BOX ) ?
+                   ", box" : ", nearest" )
+              << " (" << levels << " levels)? "
+              << ( ok ? "PASSED" : "FAILED" ) << endl;
+         test_failed |= !ok;
+
+         SINGLE.remove();
+         LEVELS.remove();
+         IMAGE.remove();
+      }
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the tile pipeline of ossimTiffWriter.  Writes
+//              the same image with pipeline depth 0, written in line, and
+//              with a pipeline depth, for every tiff layout and for no,
+//              deflate and lzw compression.  Deflate takes the raw tile
+//              path compressing on the thread pool.  Both files are decoded
+//              and every tile compared with each other and with the input.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimTiffWriter.h>
+#include <ossim/init/ossimInit.h>
+#include <iostream>
+using namespace std;
+
+// Odd sizes so the last tiles and strips are partial:
+static const ossim_int32 IMAGE_WIDTH    = 530;
+static const ossim_int32 IMAGE_HEIGHT   = 410;
+static const ossim_int32 TILE_SIZE      = 64;
+static const ossim_uint32 BANDS         = 3;
+static const ossim_uint32 PIPELINE_DEPTH = 6;
+
+static ossimRefPtr<ossimImageData> createImage()
+{
+   ossimRefPtr<ossimImageData> data =
+      new ossimImageData( 0, OSSIM_UINT16, BANDS, IMAGE_WIDTH, IMAGE_HEIGHT );
+   data->initialize();
+   for ( ossim_uint32 band = 0; band < BANDS; ++band )
+   {
+      ossim_uint16* buf = static_cast<ossim_uint16*>( data->getBuf( band ) );
+      for ( ossim_int32 y = 0; y < IMAGE_HEIGHT; ++y )
+      {
+         for ( ossim_int32 x = 0; x < IMAGE_WIDTH; ++x )
+         {
+            // Smooth with some noise so deflate has something to do:
+            buf[y * IMAGE_WIDTH + x] = static_cast<ossim_uint16>(
+               1 + ( x * 7 + y * 3 + band * 1000 ) % 4000 + ( ( x * 31 + y * 17 ) % 13 ) );
+         }
+      }
+   }
+   data->validate();
+   return data;
+}
+
+static bool writeImage( ossimImageData* data, const ossimFilename& file,
+                        const ossimString& type, const ossimString& compression,
+                        ossim_uint32 depth )
+{
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage( data );
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   writer->setGeotiffFlag( false );
+   writer->setOutputImageType( type );
+   writer->setCompressionType( compression );
+   writer->setTileSize( ossimIpt( TILE_SIZE, TILE_SIZE ) );
+   writer->setPipelineDepth( depth );
+   writer->setOutputName( file );
+   writer->connectMyInputTo( 0, source.get() );
+   bool result = writer->execute() && ( writer->getPipelineDepth() == depth );
+   writer->disconnect();
+   return result;
+}
+
+// Decodes both files tile by tile and compares them with each other and the input.
+static bool compareFiles( const ossimFilename& a, const ossimFilename& b,
+                          const ossimImageData* input )
+{
+   ossimRefPtr<ossimImageHandler> ha = ossimImageHandlerRegistry::instance()->open( a );
+   ossimRefPtr<ossimImageHandler> hb = ossimImageHandlerRegistry::instance()->open( b );
+   if ( !ha.valid() || !hb.valid() )
+   {
+      return false;
+   }
+   ossimIrect rect = ha->getImageRectangle( 0 );
+   bool result = ( rect == hb->getImageRectangle( 0 ) ) &&
+      ( rect == input->getImageRectangle() ) &&
+      ( ha->getNumberOfOutputBands() == BANDS ) && ( hb->getNumberOfOutputBands() == BANDS );
+   for ( ossim_int32 y = rect.ul().y; result && ( y <= rect.lr().y ); y += TILE_SIZE )
+   {
+      for ( ossim_int32 x = rect.ul().x; result && ( x <= rect.lr().x ); x += TILE_SIZE )
+      {
+         ossimIrect tileRect( x, y, x + TILE_SIZE - 1, y + TILE_SIZE - 1 );
+         ossimRefPtr<ossimImageData> ta = ha->getTile( tileRect, 0 );
+         ossimRefPtr<ossimImageData> tb = hb->getTile( tileRect, 0 );
+         result = ta.valid() && tb.valid();
+         for ( ossim_int32 ty = y; result && ( ty < y + TILE_SIZE ); ++ty )
+         {
+            for ( ossim_int32 tx = x; result && ( tx < x + TILE_SIZE ); ++tx )
+            {
+               if ( ( tx > rect.lr().x ) || ( ty > rect.lr().y ) )
+               {
+                  continue;
+               }
+               ossim_uint32 i = ( ty - y ) * TILE_SIZE + ( tx - x );
+               ossim_uint32 j = ty * IMAGE_WIDTH + tx;
+               for ( ossim_uint32 band = 0; result && ( band < BANDS ); ++band )
+               {
+                  const ossim_uint16* expected =
+                     static_cast<const ossim_uint16*>( input->getBuf( band ) );
+                  result = ( ta->getPix( i, band ) == tb->getPix( i, band ) ) &&
+                     ( ta->getPix( i, band ) == expected[j] );
+                  if ( !result )
+                  {
+                     cout << "band " << band << " differs at (" << tx << ", " << ty << "): "
+                          << ta->getPix( i, band ) << ", " << tb->getPix( i, band )
+                          << ", input " << expected[j] << endl;
+                  }
+               }
+            }
+         }
+      }
+   }
+   ha->close();
+   hb->close();
+   return result;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   const char* TYPES[] =
+   {
+      "tiff_tiled", "tiff_tiled_band_separate", "tiff_strip", "tiff_strip_band_separate"
+   };
+   const char* COMPRESSIONS[] = { "none", "deflate", "lzw" };
+
+   const ossimFilename IN_LINE   = "ossim-tiff-writer-pipeline-test-0.tif";
+   const ossimFilename PIPELINED = "ossim-tiff-writer-pipeline-test-n.tif";
+
+   ossimRefPtr<ossimImageData> image = createImage();
+
+   bool test_failed = false;
+   for ( ossim_uint32 t = 0; t < sizeof( TYPES ) / sizeof( TYPES[0] ); ++t )
+   {
+      for ( ossim_uint32 c = 0; c < sizeof( COMPRESSIONS ) / sizeof( COMPRESSIONS[0] ); ++c )
+      {
+         bool ok = writeImage( image.get(), IN_LINE, TYPES[t], COMPRESSIONS[c], 0 ) &&
+            writeImage( image.get(), PIPELINED, TYPES[t], COMPRESSIONS[c], PIPELINE_DEPTH ) &&
+            compareFiles( IN_LINE, PIPELINED, image.get() );
+
+         cout << "pipeline depth " << PIPELINE_DEPTH << " matches depth 0, "
+              << TYPES[t] << ", " << COMPRESSIONS[c] << "? "
+              << ( ok ? "PASSED" : "FAILED" ) << endl;
+         test_failed |= !ok;
+
+         IN_LINE.remove();
+         PIPELINED.remove();
+      }
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
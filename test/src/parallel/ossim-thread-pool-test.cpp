@@ -0,0 +1,174 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::ThreadPool.  Checks async results,
+//              tasks fanning out sub tasks and waiting on them from inside
+//              the pool with every worker busy, clear() of queued tasks,
+//              waitForIdle, and the steal, executed and idle counters.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/parallel/ThreadPool.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Long enough for any machine, a deadlocked pool never gets there:
+static const std::chrono::seconds TIMEOUT(30);
+
+static bool check( const char* name, bool ok, bool& test_failed )
+{
+   cout << name << "? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+   return ok;
+}
+
+static void sleepMs( ossim_uint32 ms )
+{
+   std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+
+   // Results through async and wait from outside the pool:
+   {
+      ossim::ThreadPool pool( 4 );
+      vector<std::future<ossim_uint64> > parts;
+      for ( ossim_uint64 i = 0; i < 200; ++i )
+      {
+         parts.push_back( pool.async( [i]() { return i * i; } ) );
+      }
+      ossim_uint64 sum = 0;
+      for ( ossim_uint32 i = 0; i < parts.size(); ++i )
+      {
+         sum += pool.wait( parts[i] );
+      }
+      check( "async results", ( sum == 199 * 200 * 399 / 6 ), test_failed );
+   }
+
+   //---
+   // More outer tasks than workers, each fans out and waits on its sub tasks.
+   // With a blocking get() every worker would sit in an outer task waiting on
+   // sub tasks nobody runs.  The pool is leaked if it hangs so the test can
+   // still report.
+   //---
+   {
+      ossim::ThreadPool* pool = new ossim::ThreadPool( 2 );
+      std::future<ossim_uint32> all = pool->async( [pool]()
+      {
+         vector<std::future<ossim_uint32> > outer;
+         for ( ossim_uint32 i = 0; i < 6; ++i )
+         {
+            outer.push_back( pool->async( [pool, i]()
+            {
+               vector<std::future<ossim_uint32> > inner;
+               for ( ossim_uint32 j = 0; j < 8; ++j )
+               {
+                  inner.push_back( pool->async( [i, j]() { sleepMs( 1 ); return i * 8 + j; } ) );
+               }
+               ossim_uint32 sum = 0;
+               for ( ossim_uint32 j = 0; j < inner.size(); ++j )
+               {
+                  sum += pool->wait( inner[j] );
+               }
+               return sum;
+            } ) );
+         }
+         ossim_uint32 sum = 0;
+         for ( ossim_uint32 i = 0; i < outer.size(); ++i )
+         {
+            sum += pool->wait( outer[i] );
+         }
+         return sum;
+      } );
+      bool finished = ( all.wait_for( TIMEOUT ) == std::future_status::ready );
+      check( "nested fan out does not deadlock", finished && ( all.get() == 47 * 48 / 2 ),
+             test_failed );
+      if ( finished )
+      {
+         delete pool;
+      }
+   }
+
+   // clear() drops what is queued behind a busy worker, the running task finishes:
+   {
+      ossim::ThreadPool pool( 1 );
+      std::promise<void> release;
+      std::shared_future<void> released = release.get_future().share();
+      std::atomic<ossim_uint32> started( 0 );
+      std::atomic<ossim_uint32> count( 0 );
+      pool.submit( [&started, released]() { ++started; released.wait(); } );
+      while ( started == 0 )
+      {
+         sleepMs( 1 );
+      }
+      for ( ossim_uint32 i = 0; i < 10; ++i )
+      {
+         pool.submit( [&count]() { ++count; } );
+      }
+      bool ok = ( pool.getQueueDepth() == 10 ) && ( pool.getNumberOfBusyThreads() == 1 );
+      pool.clear();
+      ok = ok && ( pool.getQueueDepth() == 0 );
+      release.set_value();
+      pool.waitForIdle();
+      pool.submit( [&count]() { ++count; } );
+      pool.waitForIdle();
+      ok = ok && ( count == 1 ) && ( pool.getExecutedCount() == 2 );
+      check( "clear drops queued tasks", ok, test_failed );
+   }
+
+   // waitForIdle returns once every task, queued or running, is done:
+   {
+      ossim::ThreadPool pool( 3 );
+      std::atomic<ossim_uint32> count( 0 );
+      for ( ossim_uint32 i = 0; i < 60; ++i )
+      {
+         pool.submit( [&count]() { sleepMs( 1 ); ++count; } );
+      }
+      pool.waitForIdle();
+      bool ok = ( count == 60 ) && ( pool.getQueueDepth() == 0 ) &&
+         ( pool.getNumberOfBusyThreads() == 0 ) && ( pool.getExecutedCount() == 60 );
+      check( "waitForIdle", ok, test_failed );
+   }
+
+   //---
+   // Tasks submitted from a worker go to its own deque, the idle workers have
+   // to steal them.  The workers sleep first, the idle time counts it.
+   //---
+   {
+      ossim::ThreadPool pool( 4 );
+      sleepMs( 20 );
+      std::atomic<ossim_uint32> count( 0 );
+      pool.submit( [&pool, &count]()
+      {
+         for ( ossim_uint32 i = 0; i < 40; ++i )
+         {
+            pool.submit( [&count]() { sleepMs( 2 ); ++count; } );
+         }
+         sleepMs( 50 );
+      } );
+      pool.waitForIdle();
+      bool ok = ( count == 40 ) && ( pool.getExecutedCount() == 41 ) &&
+         ( pool.getStealCount() > 0 ) && ( pool.getStealCount() <= 40 ) &&
+         ( pool.getIdleTime() > 0.0 );
+      pool.print( cout ) << endl;
+      check( "steal and idle counters", ok, test_failed );
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -0,0 +1,189 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossim::TilePrefetcher.  Writes a small tiled
+//              tiff, reads it through a cache tile source with the reads
+//              prefetched on the thread pool and compares every tile with
+//              a direct read from the handler.  A second pass resets the
+//              cache on the main thread while prefetch reads are running.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimCacheTileSource.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimTiffWriter.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/parallel/TilePrefetcher.h>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+static const ossim_int32 IMAGE_SIZE = 512;
+static const ossim_int32 TILE_SIZE  = 128;
+
+static bool writeImage( const ossimFilename& file )
+{
+   ossimRefPtr<ossimImageData> data =
+      new ossimImageData( 0, OSSIM_UINT8, 3, IMAGE_SIZE, IMAGE_SIZE );
+   data->initialize();
+   for ( ossim_uint32 band = 0; band < 3; ++band )
+   {
+      ossim_uint8* buf = static_cast<ossim_uint8*>( data->getBuf( band ) );
+      for ( ossim_int32 y = 0; y < IMAGE_SIZE; ++y )
+      {
+         for ( ossim_int32 x = 0; x < IMAGE_SIZE; ++x )
+         {
+            buf[y * IMAGE_SIZE + x] = (ossim_uint8)( x * 7 + y * 3 + band * 50 + 1 );
+         }
+      }
+   }
+   data->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage( data );
+
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   writer->setGeotiffFlag( false );
+   writer->setTileSize( ossimIpt( 64, 64 ) );
+   writer->setOutputName( file );
+   writer->connectMyInputTo( 0, source.get() );
+   bool result = writer->execute();
+   writer->disconnect();
+   return result;
+}
+
+static bool sameTile( const ossimImageData* a, const ossimImageData* b )
+{
+   if ( !a || !b || ( a->getNumberOfBands() != b->getNumberOfBands() ) ||
+        ( a->getImageRectangle() != b->getImageRectangle() ) )
+   {
+      return false;
+   }
+   for ( ossim_uint32 band = 0; band < a->getNumberOfBands(); ++band )
+   {
+      if ( memcmp( a->getBuf( band ), b->getBuf( band ),
+                   a->getSizePerBandInBytes() ) != 0 )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+static bool getTileRect( ossim_int64 id, ossimIrect& rect )
+{
+   const ossim_int64 TILES_PER_ROW = IMAGE_SIZE / TILE_SIZE;
+   if ( ( id < 0 ) || ( id >= TILES_PER_ROW * TILES_PER_ROW ) )
+   {
+      return false;
+   }
+   ossimIpt ul( (ossim_int32)( id % TILES_PER_ROW ) * TILE_SIZE,
+                (ossim_int32)( id / TILES_PER_ROW ) * TILE_SIZE );
+   rect = ossimIrect( ul.x, ul.y, ul.x + TILE_SIZE - 1, ul.y + TILE_SIZE - 1 );
+   return true;
+}
+
+//---
+// Reads every tile through the cache, advancing the prefetcher first.  With
+// resetCache the main thread flushes and resizes the cache every few tiles,
+// which rebuilds the r-level cache list under the prefetch reads.
+//---
+static bool readAll( ossimCacheTileSource* cache, ossimImageHandler* handler,
+                     ossim::TilePrefetcher& prefetcher, bool resetCache )
+{
+   bool result = true;
+   ossimIrect rect;
+   for ( ossim_int64 id = 0; getTileRect( id, rect ); ++id )
+   {
+      if ( resetCache )
+      {
+         if ( id % 5 == 4 )
+         {
+            cache->initialize();
+         }
+         if ( id % 7 == 6 )
+         {
+            ossim_int32 size = ( id % 2 ) ? 64 : 128;
+            cache->setTileSize( ossimIpt( size, size ) );
+         }
+      }
+
+      prefetcher.advance( id );
+      ossimRefPtr<ossimImageData> cached = cache->getTile( rect, 0 );
+      ossimRefPtr<ossimImageData> direct = handler->getTile( rect, 0 );
+      if ( !sameTile( cached.get(), direct.get() ) )
+      {
+         cout << "tile " << id << " differs" << endl;
+         result = false;
+      }
+   }
+   return result;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   ossimFilename file = "ossim-tile-prefetcher-test.tif";
+   if ( !writeImage( file ) )
+   {
+      cout << "Could not write " << file << endl;
+      return 1;
+   }
+
+   bool test_failed = false;
+   {
+      ossimRefPtr<ossimImageHandler> handler =
+         ossimImageHandlerRegistry::instance()->open( file );
+      if ( !handler.valid() )
+      {
+         cout << "Could not open " << file << endl;
+         file.remove();
+         return 1;
+      }
+
+      ossimRefPtr<ossimCacheTileSource> cache = new ossimCacheTileSource();
+      cache->connectMyInputTo( 0, handler.get() );
+      cache->initialize();
+
+      ossim::TilePrefetcher prefetcher;
+      prefetcher.setDepth( 4 );
+      prefetcher.setInput( cache.get(), getTileRect );
+      bool ok = prefetcher.isEnabled();
+      cout << "prefetcher enabled? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+
+      ok = readAll( cache.get(), handler.get(), prefetcher, false );
+      ok = ok && ( prefetcher.getReadCount() > 0 ) &&
+         ( prefetcher.getHitCount() + prefetcher.getStallCount() > 0 );
+      prefetcher.print( cout ) << endl;
+      cout << "prefetched tiles match? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+
+      prefetcher.reset();
+      ok = readAll( cache.get(), handler.get(), prefetcher, true );
+      prefetcher.print( cout ) << endl;
+      cout << "prefetched tiles match with cache resets? "
+           << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+
+      cache->disconnect();
+      handler->close();
+   }
+   file.remove();
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
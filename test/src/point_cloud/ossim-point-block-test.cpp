@@ -0,0 +1,225 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the columnar storage of ossimPointBlock.  The
+//              same points are held once as per point records and once as
+//              columns, and every accessor must give the same answers:
+//              positions, fields, records, bounds and field minimums, copies
+//              between the two modes and conversions back and forth.  The
+//              record copies of a const columnar block are also read from
+//              several threads at once.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/point_cloud/ossimPointBlock.h>
+#include <ossim/point_cloud/ossimPointRecord.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+using namespace std;
+
+static const ossim_uint32 NUM_POINTS = 5000;
+static const ossim_uint32 FIELDS = ossimPointRecord::Intensity | ossimPointRecord::ReturnNumber |
+   ossimPointRecord::NumberOfReturns | ossimPointRecord::Red | ossimPointRecord::Green |
+   ossimPointRecord::Blue;
+
+static ossimPointRecord* createRecord(ossim_uint32 i)
+{
+   ossimPointRecord* point = new ossimPointRecord(FIELDS);
+   point->setPosition(ossimGpt(40.0 + (i * 37 % 1001) * 1.0e-4,
+                               -105.0 + (i * 53 % 997) * 1.0e-4,
+                               1500.0 + (i * 11 % 301)));
+   point->setPointId(i * 3);
+   point->setField(ossimPointRecord::Intensity, (ossim_float32)(i * 7 % 256));
+   point->setField(ossimPointRecord::ReturnNumber, (ossim_float32)(1 + i % 3));
+   point->setField(ossimPointRecord::NumberOfReturns, 3.0f);
+   point->setField(ossimPointRecord::Red, (ossim_float32)(i * 13 % 200 + 20));
+   point->setField(ossimPointRecord::Green, (ossim_float32)(i * 17 % 210 + 10));
+   point->setField(ossimPointRecord::Blue, (ossim_float32)(i * 19 % 220 + 5));
+   return point;
+}
+
+static void fill(ossimPointBlock& block, bool columnar)
+{
+   block.setFieldCode(FIELDS);
+   block.setColumnar(columnar);
+   block.reserve(NUM_POINTS);
+   for (ossim_uint32 i=0; i<NUM_POINTS; ++i)
+      block.addPoint(createRecord(i));
+}
+
+static bool sameRecord(const ossimPointRecord* a, const ossimPointRecord* b)
+{
+   return a && b && (a->getPointId() == b->getPointId()) &&
+      (a->getPosition() == b->getPosition()) &&
+      (a->getFieldCode() == b->getFieldCode()) && (a->getFieldMap() == b->getFieldMap());
+}
+
+// Compares every point of two blocks through the accessors valid in both modes.
+static bool sameBlock(const ossimPointBlock& a, const ossimPointBlock& b)
+{
+   if ((a.size() != b.size()) || (a.getFieldCode() != b.getFieldCode()))
+      return false;
+   vector<ossimPointRecord::FIELD_CODES> codes = a.getFieldCodesAsList();
+   for (ossim_uint32 i=0; i<a.size(); ++i)
+   {
+      if (!(a.getPosition(i) == b.getPosition(i)) || !sameRecord(a.getPoint(i), b.getPoint(i)))
+         return false;
+      for (ossim_uint32 c=0; c<codes.size(); ++c)
+      {
+         if (a.getField(i, codes[c]) != b.getField(i, codes[c]))
+            return false;
+      }
+   }
+   return true;
+}
+
+static bool check(const char* name, bool ok, bool& test_failed)
+{
+   cout << name << "? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+
+   ossimPointBlock records;
+   ossimPointBlock columns;
+   fill(records, false);
+   fill(columns, true);
+
+   // Columns are exposed only in columnar mode and hold what was added:
+   {
+      const ossim_float64* lat = columns.getLatitudes();
+      const ossim_uint32* ids = columns.getPointIds();
+      const ossim_float32* red = columns.getFieldValues(ossimPointRecord::Red);
+      bool ok = columns.isColumnar() && !records.isColumnar() && lat && ids && red &&
+         !records.getLatitudes() && !columns.getFieldValues(ossimPointRecord::GpsTime);
+      for (ossim_uint32 i=0; ok && (i<NUM_POINTS); ++i)
+      {
+         ok = (lat[i] == records[i]->getPosition().lat) &&
+            (ids[i] == records[i]->getPointId()) &&
+            (red[i] == records[i]->getField(ossimPointRecord::Red));
+      }
+      check("columns hold the added points", ok, test_failed);
+   }
+
+   check("columnar accessors match the records", sameBlock(columns, records), test_failed);
+
+   // Bounds, field minimums, and the color maximum latched as one:
+   {
+      ossimGrect a, b;
+      columns.getBounds(a);
+      records.getBounds(b);
+      bool ok = (a.ul() == b.ul()) && (a.lr() == b.lr());
+      const ossimPointRecord::FIELD_CODES MINS[] =
+      {
+         ossimPointRecord::Intensity, ossimPointRecord::ReturnNumber,
+         ossimPointRecord::NumberOfReturns, ossimPointRecord::Red
+      };
+      for (ossim_uint32 f=0; f<sizeof(MINS)/sizeof(MINS[0]); ++f)
+      {
+         ossim_float32 va, vb;
+         columns.getFieldMin(MINS[f], va);
+         records.getFieldMin(MINS[f], vb);
+         ok = ok && (va == vb);
+      }
+      ossim_float32 va, vb;
+      columns.getFieldMax(ossimPointRecord::Blue, va);
+      records.getFieldMax(ossimPointRecord::Blue, vb);
+      ok = ok && (va == vb);
+      check("bounds and field extremes match", ok, test_failed);
+   }
+
+   // Ranges copied between every pair of modes:
+   {
+      bool ok = true;
+      for (ossim_uint32 m=0; ok && (m<4); ++m)
+      {
+         const ossimPointBlock& source = (m & 1) ? columns : records;
+         ossimPointBlock a;
+         ossimPointBlock b;
+         a.setFieldCode(FIELDS);
+         b.setFieldCode(FIELDS);
+         a.setColumnar((m & 2) != 0);
+         a.addPoints(source, 100, 250);
+         a.addPoints(source, NUM_POINTS - 10, 100);
+         for (ossim_uint32 i=100; i<350; ++i)
+            b.addPoint(createRecord(i));
+         for (ossim_uint32 i=NUM_POINTS-10; i<NUM_POINTS; ++i)
+            b.addPoint(createRecord(i));
+         ok = (a.isColumnar() == ((m & 2) != 0)) && sameBlock(a, b);
+      }
+      check("addPoints across storage modes", ok, test_failed);
+   }
+
+   // Conversions, setField and the non-const records of a columnar block:
+   {
+      ossimPointBlock a;
+      a.setFieldCode(FIELDS);
+      a.addPoints(records, 0, NUM_POINTS);
+      a.setColumnar(true);
+      bool ok = a.isColumnar() && sameBlock(a, records);
+
+      a.setField(7, ossimPointRecord::Intensity, 1000.0f);
+      a.setField(8, ossimPointRecord::Infrared, 5.0f);
+      ok = ok && a.isColumnar() && (a.getField(7, ossimPointRecord::Intensity) == 1000.0f) &&
+         (a.getFieldCode() & ossimPointRecord::Infrared) &&
+         (a.getField(8, ossimPointRecord::Infrared) == 5.0f) &&
+         ossim::isnan(a.getField(9, ossimPointRecord::Infrared));
+      const ossimPointBlock& constA = a;
+      ok = ok && (constA.getPoint(7)->getField(ossimPointRecord::Intensity) == 1000.0f);
+
+      // A change through a record sticks, the block leaves columnar storage for it:
+      a.getPoint(10)->setField(ossimPointRecord::Red, 1.0f);
+      ok = ok && !a.isColumnar() && (a.getField(10, ossimPointRecord::Red) == 1.0f) &&
+         (a.getField(7, ossimPointRecord::Intensity) == 1000.0f) &&
+         (a.getField(11, ossimPointRecord::Red) == records.getField(11, ossimPointRecord::Red));
+      check("conversions and field updates", ok, test_failed);
+   }
+
+   // Records of a shared const columnar block read from several threads:
+   {
+      ossimPointBlock shared;
+      fill(shared, true);
+      const ossimPointBlock& constShared = shared;
+      vector<int> results(8, 0);
+      vector<std::thread> threads;
+      for (ossim_uint32 t=0; t<results.size(); ++t)
+      {
+         threads.push_back(std::thread([&constShared, &records, &results, t]()
+         {
+            bool ok = true;
+            for (ossim_uint32 i=0; i<NUM_POINTS; ++i)
+            {
+               ossim_uint32 p = (i * 7 + t * 613) % NUM_POINTS;
+               ok = ok && sameRecord(constShared.getPoint(p), records.getPoint(p));
+            }
+            ok = ok && (constShared.getPoints().size() == NUM_POINTS);
+            results[t] = ok ? 1 : 0;
+         }));
+      }
+      bool ok = true;
+      for (ossim_uint32 t=0; t<threads.size(); ++t)
+      {
+         threads[t].join();
+         ok = ok && (results[t] != 0);
+      }
+      check("const record access from several threads", ok, test_failed);
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -0,0 +1,166 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for ossimPointCloudIndex.  Builds the .pci sidecar
+//              of a synthetic cloud and checks, for a set of query rects,
+//              that the cells returned cover every point a brute force scan
+//              finds and that getBlock through the index returns exactly
+//              those points.  A second handler on the same file must pick
+//              the index up from disk.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/point_cloud/ossimGenericPointCloudHandler.h>
+#include <ossim/point_cloud/ossimPointBlock.h>
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim_uint32 NUM_POINTS      = 20000;
+static const ossim_uint32 POINTS_PER_CELL = 50;
+
+// The generic handler has no file, this one claims one so the index has a sidecar name:
+class TestHandler : public ossimGenericPointCloudHandler
+{
+public:
+   TestHandler(vector<ossimGpt>& points, const ossimFilename& file)
+      : ossimGenericPointCloudHandler(points)
+   {
+      m_inputFilename = file;
+   }
+};
+
+// Uneven density: a uniform spread plus a tight cluster.
+static void createPoints(vector<ossimGpt>& points)
+{
+   ossim_uint32 seed = 12345;
+   points.clear();
+   for (ossim_uint32 i=0; i<NUM_POINTS; ++i)
+   {
+      seed = seed * 1103515245 + 12345;
+      double u = ((seed >> 8) & 0xffff) / 65535.0;
+      seed = seed * 1103515245 + 12345;
+      double v = ((seed >> 8) & 0xffff) / 65535.0;
+      if (i % 4 == 0)
+         points.push_back(ossimGpt(40.20 + v * 0.01, -105.30 + u * 0.01, 1600.0));
+      else
+         points.push_back(ossimGpt(40.0 + v * 0.5, -105.5 + u * 0.8, 1600.0));
+   }
+}
+
+static void bruteForce(const vector<ossimGpt>& points, const ossimGrect& bounds,
+                       vector<ossim_uint32>& ids)
+{
+   ids.clear();
+   for (ossim_uint32 i=0; i<points.size(); ++i)
+   {
+      if (bounds.pointWithin(points[i]))
+         ids.push_back(i);
+   }
+}
+
+static bool checkQueries(const ossimPointCloudHandler& handler, const vector<ossimGpt>& points)
+{
+   ossimRefPtr<const ossimPointCloudIndex> index = handler.getIndex();
+   if (!index.valid() || (index->getNumberOfColumns() * index->getNumberOfRows() < 2))
+      return false;
+
+   vector<ossimGrect> queries;
+   queries.push_back(ossimGrect(ossimGpt(40.1, -105.4), ossimGpt(40.3, -105.2)));
+   queries.push_back(ossimGrect(ossimGpt(40.2, -105.3), ossimGpt(40.21, -105.29)));
+   queries.push_back(ossimGrect(ossimGpt(40.0, -105.5), ossimGpt(40.5, -104.7)));
+   queries.push_back(ossimGrect(ossimGpt(39.0, -106.0), ossimGpt(41.0, -104.0)));
+   queries.push_back(ossimGrect(ossimGpt(40.45, -104.9), ossimGpt(40.6, -104.6)));
+   queries.push_back(ossimGrect(ossimGpt(40.3333, -105.1111), ossimGpt(40.3334, -105.1110)));
+   queries.push_back(ossimGrect(ossimGpt(41.0, -105.0), ossimGpt(42.0, -104.0)));
+
+   bool result = true;
+   for (ossim_uint32 q=0; result && (q<queries.size()); ++q)
+   {
+      vector<ossim_uint32> expected;
+      bruteForce(points, queries[q], expected);
+
+      // The cells cover the query, every point inside is among their ids:
+      vector<ossim_uint32> candidates;
+      index->getPointIds(queries[q], candidates);
+      result = std::is_sorted(candidates.begin(), candidates.end()) &&
+               std::includes(candidates.begin(), candidates.end(),
+                             expected.begin(), expected.end());
+
+      // getBlock filters the candidates down to the points inside:
+      ossimPointBlock block;
+      handler.getBlock(queries[q], block);
+      vector<ossim_uint32> found;
+      for (ossim_uint32 i=0; i<block.size(); ++i)
+         found.push_back(block.getPoint(i)->getPointId());
+      std::sort(found.begin(), found.end());
+      result = result && (found == expected);
+
+      if (!result)
+      {
+         cout << "query " << q << ": " << expected.size() << " expected, "
+              << candidates.size() << " candidates, " << found.size() << " found" << endl;
+      }
+   }
+   return result;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+   const ossimFilename CLOUD = "ossim-point-cloud-index-test.dat";
+   const ossimFilename INDEX = ossimPointCloudIndex::getIndexFilename(CLOUD);
+
+   // The index checks the cloud's file size, any bytes will do:
+   {
+      ofstream out(CLOUD.c_str(), ios::out | ios::binary | ios::trunc);
+      out << "ossim-point-cloud-index-test";
+   }
+
+   vector<ossimGpt> points;
+   createPoints(points);
+
+   TestHandler handler(points, CLOUD);
+   bool ok = !handler.getIndex().valid() && handler.buildIndex(POINTS_PER_CELL) &&
+             INDEX.exists() && checkQueries(handler, points);
+   cout << "index queries match a brute force scan? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+
+   // Another handler on the same cloud finds the sidecar on its own:
+   {
+      TestHandler second(points, CLOUD);
+      ok = checkQueries(second, points);
+      cout << "second handler opens the existing index? " << (ok ? "PASSED" : "FAILED") << endl;
+      test_failed |= !ok;
+   }
+
+   // An index built for another version of the cloud is not used:
+   {
+      vector<ossimGpt> fewer(points.begin(), points.end() - 1);
+      TestHandler stale(fewer, CLOUD);
+      ok = !stale.getIndex().valid();
+      cout << "stale index ignored? " << (ok ? "PASSED" : "FAILED") << endl;
+      test_failed |= !ok;
+   }
+
+   INDEX.remove();
+   CLOUD.remove();
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
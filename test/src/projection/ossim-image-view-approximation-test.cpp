@@ -0,0 +1,228 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the approximation grid of
+//              ossimImageViewProjectionTransform.  A geographic image is
+//              viewed through a mercator view.  viewToImage and
+//              viewPointsToImage with the grid must stay within the maximum
+//              error of the rigorous transform, a grid saved to an .ivg file
+//              must load back to the same answers, and the on disk cache of
+//              the transform must be picked up by a second transform.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimDirectory.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimDrect.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/projection/ossimEquDistCylProjection.h>
+#include <ossim/projection/ossimImageViewApproximationGrid.h>
+#include <ossim/projection/ossimImageViewProjectionTransform.h>
+#include <ossim/projection/ossimMercatorProjection.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim_int32 IMAGE_WIDTH  = 1000;
+static const ossim_int32 IMAGE_HEIGHT = 800;
+static const double      MAX_ERROR    = 0.05;
+
+static ossimRefPtr<ossimImageGeometry> createImageGeometry()
+{
+   ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+   proj->setDecimalDegreesPerPixel( ossimDpt( 0.01, 0.01 ) );
+   proj->setUlTiePoints( ossimGpt( 50.0, -10.0, 0.0 ) );
+   ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry( 0, proj.get() );
+   geom->setImageSize( ossimIpt( IMAGE_WIDTH, IMAGE_HEIGHT ) );
+   return geom;
+}
+
+static ossimRefPtr<ossimImageGeometry> createViewGeometry()
+{
+   ossimRefPtr<ossimMercatorProjection> proj = new ossimMercatorProjection();
+   proj->setMetersPerPixel( ossimDpt( 1500.0, 1500.0 ) );
+   proj->setUlTiePoints( ossimGpt( 51.0, -11.0, 0.0 ) );
+   return new ossimImageGeometry( 0, proj.get() );
+}
+
+static ossimRefPtr<ossimImageViewProjectionTransform> createTransform( double maxError )
+{
+   ossimRefPtr<ossimImageViewProjectionTransform> ivt = new ossimImageViewProjectionTransform();
+   ivt->setImageGeometry( createImageGeometry().get() );
+   ivt->setViewGeometry( createViewGeometry().get() );
+   ivt->setApproximationMaxError( maxError );
+   return ivt;
+}
+
+//---
+// Points over the view footprint of the image and a little past it.  None
+// falls right on the grid edge, where the rounding of a saved grid decides.
+//---
+static void createViewPoints( const ossimImageViewProjectionTransform* ivt,
+                              std::vector<ossimDpt>& points )
+{
+   ossimDrect imageRect( 0.0, 0.0, IMAGE_WIDTH - 1.0, IMAGE_HEIGHT - 1.0 );
+   ossimDrect viewRect = ivt->getImageToViewBounds( imageRect );
+   points.clear();
+   for ( ossim_int32 j = -5; j <= 105; ++j )
+   {
+      for ( ossim_int32 i = -5; i <= 105; ++i )
+      {
+         points.push_back( ossimDpt( viewRect.ul().x + viewRect.width() * ( i + 0.3 ) * 0.0097,
+                                     viewRect.ul().y + viewRect.height() * ( j + 0.3 ) * 0.0093 ) );
+      }
+   }
+}
+
+static double maxDifference( const std::vector<ossimDpt>& a, const std::vector<ossimDpt>& b )
+{
+   double result = 0.0;
+   for ( ossim_uint32 i = 0; i < a.size(); ++i )
+   {
+      if ( a[i].hasNans() != b[i].hasNans() )
+      {
+         return 1.0e10;
+      }
+      if ( !a[i].hasNans() )
+      {
+         result = std::max( result, std::max( std::fabs( a[i].x - b[i].x ),
+                                              std::fabs( a[i].y - b[i].y ) ) );
+      }
+   }
+   return result;
+}
+
+static void viewToImage( const ossimImageViewProjectionTransform* ivt,
+                         const std::vector<ossimDpt>& viewPoints,
+                         std::vector<ossimDpt>& imagePoints )
+{
+   imagePoints.resize( viewPoints.size() );
+   for ( ossim_uint32 i = 0; i < viewPoints.size(); ++i )
+   {
+      ivt->viewToImage( viewPoints[i], imagePoints[i] );
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+
+   ossimRefPtr<ossimImageViewProjectionTransform> exact = createTransform( 0.0 );
+   std::vector<ossimDpt> viewPoints;
+   createViewPoints( exact.get(), viewPoints );
+   std::vector<ossimDpt> reference;
+   viewToImage( exact.get(), viewPoints, reference );
+
+   // Grid answers, one point at a time and as a batch:
+   ossimRefPtr<ossimImageViewProjectionTransform> approx = createTransform( MAX_ERROR );
+   std::vector<ossimDpt> single;
+   viewToImage( approx.get(), viewPoints, single );
+   std::vector<ossimDpt> batch( viewPoints.size() );
+   approx->viewPointsToImage( &viewPoints.front(), (ossim_uint32)viewPoints.size(),
+                              &batch.front() );
+   double diff = std::max( maxDifference( single, reference ),
+                           maxDifference( batch, reference ) );
+   bool ok = ( diff <= MAX_ERROR );
+   cout << "grid within " << MAX_ERROR << " pixels of the rigorous transform (max "
+        << diff << ")? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+
+   // Changing a geometry drops the grid, the answers follow the new geometry:
+   {
+      ossimRefPtr<ossimImageGeometry> shifted = createImageGeometry();
+      ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+      proj->setDecimalDegreesPerPixel( ossimDpt( 0.01, 0.01 ) );
+      proj->setUlTiePoints( ossimGpt( 50.5, -10.5, 0.0 ) );
+      shifted->setProjection( proj.get() );
+      approx->setImageGeometry( shifted.get() );
+      exact->setImageGeometry( shifted.get() );
+      std::vector<ossimDpt> shiftedReference;
+      viewToImage( exact.get(), viewPoints, shiftedReference );
+      viewToImage( approx.get(), viewPoints, single );
+      diff = maxDifference( single, shiftedReference );
+      ok = ( diff <= MAX_ERROR );
+      cout << "grid rebuilt after a geometry change (max " << diff << ")? "
+           << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+      exact = createTransform( 0.0 );
+   }
+
+   // A grid saved to disk answers the same once loaded, under its own key only:
+   {
+      ossimImageViewApproximationGrid grid;
+      ossimImageViewApproximationGrid::Projector project =
+         [&exact]( const ossimDpt* vpts, ossim_uint32 count, ossimDpt* ipts )
+         {
+            exact->viewPointsToImage( vpts, count, ipts );
+         };
+      ossimDrect viewRect = exact->getImageToViewBounds(
+         ossimDrect( 0.0, 0.0, IMAGE_WIDTH - 1.0, IMAGE_HEIGHT - 1.0 ) );
+      const ossimFilename GRID_FILE = "ossim-image-view-approximation-test.ivg";
+      ok = grid.build( viewRect, MAX_ERROR, project ) && grid.save( GRID_FILE, 42 );
+
+      ossimImageViewApproximationGrid loaded;
+      ossimImageViewApproximationGrid wrongKey;
+      ok = ok && loaded.load( GRID_FILE, 42 ) && !wrongKey.load( GRID_FILE, 43 ) &&
+         ( loaded.getSpacing() == grid.getSpacing() ) &&
+         ( loaded.getUnusableFraction() == grid.getUnusableFraction() );
+      for ( ossim_uint32 i = 0; ok && ( i < viewPoints.size() ); ++i )
+      {
+         ossimDpt a;
+         ossimDpt b;
+         bool hitA = grid.viewToImage( viewPoints[i], a );
+         bool hitB = loaded.viewToImage( viewPoints[i], b );
+         ok = ( hitA == hitB ) &&
+            ( !hitA || ( ( std::fabs( a.x - b.x ) < 1.0e-6 ) &&
+                         ( std::fabs( a.y - b.y ) < 1.0e-6 ) ) );
+      }
+      GRID_FILE.remove();
+      cout << ".ivg save and load round trip? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+      test_failed |= !ok;
+   }
+
+   // The transform's cache file, written by the first and read by the second:
+   {
+      const ossimFilename CACHE = "ossim-image-view-approximation-test-cache.ivg";
+      const ossimFilename PATTERN = "ossim-image-view-approximation-test-cache.*.ivg";
+      PATTERN.wildcardRemove();
+
+      ossimRefPtr<ossimImageViewProjectionTransform> first = createTransform( MAX_ERROR );
+      first->setApproximationCacheFile( CACHE );
+      std::vector<ossimDpt> firstPoints;
+      viewToImage( first.get(), viewPoints, firstPoints );
+
+      // One file, named with the key of the geometries:
+      std::vector<ossimFilename> written;
+      ossimDirectory( "." ).findAllFilesThatMatch(
+         written, "ossim-image-view-approximation-test-cache\\..*\\.ivg" );
+
+      ossimRefPtr<ossimImageViewProjectionTransform> second = createTransform( MAX_ERROR );
+      second->setApproximationCacheFile( CACHE );
+      std::vector<ossimDpt> secondPoints;
+      viewToImage( second.get(), viewPoints, secondPoints );
+
+      ok = ( written.size() == 1 ) &&
+         ( maxDifference( firstPoints, secondPoints ) < 1.0e-6 ) &&
+         ( maxDifference( secondPoints, reference ) <= MAX_ERROR );
+      PATTERN.wildcardRemove();
+      cout << "cache file reused by a second transform? " << ( ok ? "PASSED" : "FAILED" )
+           << endl;
+      test_failed |= !ok;
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
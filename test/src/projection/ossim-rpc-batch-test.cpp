@@ -0,0 +1,182 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the batch projections of ossimRpcModel.  For a
+//              sample RPC in both RPC00A and RPC00B term order, with and
+//              without adjustments, worldToLineSamples must match
+//              worldToLineSample and lineSampleHeightsToWorld must match
+//              lineSampleHeightToWorld point for point.  The point count is
+//              not a multiple of the block size and includes nan points.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/projection/ossimRpcModel.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim_uint32 NUM_POINTS = 150;
+
+// Sample coefficients, first four terms dominant as in a real RPC:
+static const double LINE_NUM[20] =
+{
+    2.1e-3, -3.2e-2, -1.02,    5.1e-3,  3.0e-4, -1.1e-4,  2.3e-4,  1.2e-4, -4.1e-4,  1.0e-5,
+    2.0e-6,  1.5e-6, -3.1e-6,  4.0e-7,  2.2e-6, -1.8e-6,  6.0e-7, -2.0e-7,  3.3e-7,  1.0e-8
+};
+static const double LINE_DEN[20] =
+{
+    1.0,     1.1e-3, -5.0e-4,  2.0e-4,  1.0e-5, -2.0e-6,  3.0e-6,  4.0e-6, -1.0e-6,  2.0e-7,
+    1.0e-7, -2.0e-7,  3.0e-8,  1.0e-8, -4.0e-8,  5.0e-8,  1.0e-8, -1.0e-8,  2.0e-8,  0.0
+};
+static const double SAMP_NUM[20] =
+{
+   -1.3e-3,  1.01,   -2.1e-2,  3.2e-2, -2.0e-4,  1.5e-4, -3.0e-4,  2.1e-4,  1.1e-4, -2.0e-5,
+   -1.0e-6,  2.5e-6,  1.1e-6, -6.0e-7,  1.2e-6,  2.8e-6, -4.0e-7,  1.0e-7, -2.3e-7,  2.0e-8
+};
+static const double SAMP_DEN[20] =
+{
+    1.0,    -7.0e-4,  1.1e-3,  3.0e-4, -2.0e-5,  1.0e-6, -4.0e-6,  2.0e-6,  3.0e-6, -1.0e-7,
+    2.0e-7,  1.0e-7, -1.0e-7,  3.0e-8,  2.0e-8, -1.0e-8,  4.0e-8,  1.0e-8, -3.0e-8,  0.0
+};
+
+static ossimRefPtr<ossimRpcModel> createModel(ossimRpcModel::PolynomialType type, bool adjusted)
+{
+   ossimRefPtr<ossimRpcModel> model = new ossimRpcModel();
+   model->setAttributes(6000.0, 5000.0, 6100.0, 5100.0,
+                        39.5, -105.2, 1800.0, 0.06, 0.08, 500.0,
+                        vector<double>(SAMP_NUM, SAMP_NUM + 20),
+                        vector<double>(SAMP_DEN, SAMP_DEN + 20),
+                        vector<double>(LINE_NUM, LINE_NUM + 20),
+                        vector<double>(LINE_DEN, LINE_DEN + 20),
+                        type, false);
+   if (adjusted)
+   {
+      // Intrack offset, crosstrack scale and map rotation:
+      model->setAdjustableParameter(0, 0.7);
+      model->setAdjustableParameter(3, -0.4);
+      model->setAdjustableParameter(4, 0.5);
+      model->updateModel();
+   }
+   return model;
+}
+
+// Ground points spread over and a little past the normalized range:
+static void createGroundPoints(vector<ossimGpt>& gpts)
+{
+   gpts.clear();
+   for (ossim_uint32 i=0; i<NUM_POINTS; ++i)
+   {
+      double u = (i * 37 % 101) / 100.0 * 2.2 - 1.1;
+      double v = (i * 53 % 97) / 96.0 * 2.2 - 1.1;
+      double h = (i * 11 % 23) / 22.0 * 2.0 - 1.0;
+      gpts.push_back(ossimGpt(39.5 + u * 0.06, -105.2 + v * 0.08, 1800.0 + h * 500.0));
+   }
+   gpts[70].hgt = ossim::nan();
+   gpts[71].lat = ossim::nan();
+   gpts[140].lon = ossim::nan();
+}
+
+static bool sameDpt(const ossimDpt& a, const ossimDpt& b)
+{
+   if (a.hasNans() || b.hasNans())
+      return a.hasNans() && b.hasNans();
+   return (fabs(a.x - b.x) < 1.0e-7) && (fabs(a.y - b.y) < 1.0e-7);
+}
+
+// About a millimeter on the ground:
+static bool sameGpt(const ossimGpt& a, const ossimGpt& b)
+{
+   return (fabs(a.lat - b.lat) < 1.0e-8) && (fabs(a.lon - b.lon) < 1.0e-8) &&
+      ((a.isHgtNan() && b.isHgtNan()) || (a.hgt == b.hgt));
+}
+
+static bool check(const char* name, bool ok, bool& test_failed)
+{
+   cout << name << "? " << (ok ? "PASSED" : "FAILED") << endl;
+   test_failed |= !ok;
+   return ok;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool test_failed = false;
+
+   vector<ossimGpt> gpts;
+   createGroundPoints(gpts);
+
+   for (ossim_uint32 m=0; m<4; ++m)
+   {
+      ossimRpcModel::PolynomialType type = (m & 1) ? ossimRpcModel::A : ossimRpcModel::B;
+      bool adjusted = (m & 2) != 0;
+      ossimRefPtr<ossimRpcModel> model = createModel(type, adjusted);
+      cout << "\nRPC00" << (char)type << (adjusted ? " adjusted" : "") << ":" << endl;
+
+      // Ground to image:
+      vector<ossimDpt> single(NUM_POINTS);
+      vector<ossimDpt> batch(NUM_POINTS);
+      for (ossim_uint32 i=0; i<NUM_POINTS; ++i)
+         model->worldToLineSample(gpts[i], single[i]);
+      model->worldToLineSamples(&gpts.front(), NUM_POINTS, &batch.front());
+      bool ok = true;
+      for (ossim_uint32 i=0; ok && (i<NUM_POINTS); ++i)
+      {
+         ok = sameDpt(single[i], batch[i]);
+         if (!ok)
+            cout << "point " << i << ": " << single[i] << " != " << batch[i] << endl;
+      }
+      check("worldToLineSamples matches worldToLineSample", ok, test_failed);
+
+      // Image to ground at the heights the image points came from:
+      vector<ossimDpt> ipts;
+      vector<double> heights;
+      vector<ossimGpt> expected;
+      for (ossim_uint32 i=0; i<NUM_POINTS; ++i)
+      {
+         if (!single[i].hasNans())
+         {
+            ipts.push_back(single[i]);
+            heights.push_back(gpts[i].hgt);
+         }
+      }
+      expected.resize(ipts.size());
+      for (ossim_uint32 i=0; i<ipts.size(); ++i)
+         model->lineSampleHeightToWorld(ipts[i], heights[i], expected[i]);
+      vector<ossimGpt> found(ipts.size());
+      model->lineSampleHeightsToWorld(&ipts.front(), &heights.front(),
+                                      (ossim_uint32)ipts.size(), &found.front());
+      ok = (ipts.size() == NUM_POINTS - 2);
+      for (ossim_uint32 i=0; ok && (i<ipts.size()); ++i)
+      {
+         ok = sameGpt(expected[i], found[i]);
+         if (!ok)
+            cout << "point " << i << ": " << expected[i] << " != " << found[i] << endl;
+      }
+      check("lineSampleHeightsToWorld matches lineSampleHeightToWorld", ok, test_failed);
+
+      //---
+      // The solutions land back on the image points, within the 0.1 pixel
+      // convergence.  A nan height means something else each way, skip it.
+      //---
+      vector<ossimDpt> back(found.size());
+      model->worldToLineSamples(&found.front(), (ossim_uint32)found.size(), &back.front());
+      ok = true;
+      for (ossim_uint32 i=0; ok && (i<back.size()); ++i)
+         ok = found[i].isHgtNan() || ((ipts[i] - back[i]).length() < 0.1);
+      check("round trip within convergence", ok, test_failed);
+   }
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}
@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test code for the threaded mode of ossimToolServer.  Starts a
+//              server with two worker threads, sends "stats" requests from
+//              several clients at once, leaves some of the connections open
+//              and stops the server.  Every request must be answered and
+//              every connection closed.
+//
+//              Optional argument: the port to listen on, default 23457.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/sockets/ossimToolClient.h>
+#include <ossim/sockets/ossimToolServer.h>
+#include <ossim/init/ossimInit.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+static const ossim_uint32 CLIENTS  = 4;
+static const ossim_uint32 REQUESTS = 3;
+
+static bool connect( ossimToolClient& client, const string& port )
+{
+   // The server may not be listening yet:
+   for ( ossim_uint32 attempt = 0; attempt < 50; ++attempt )
+   {
+      char host[] = "localhost";
+      vector<char> portid( port.begin(), port.end() );
+      portid.push_back( 0 );
+      if ( client.connectToServer( host, &portid.front() ) >= 0 )
+      {
+         return true;
+      }
+      std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+   }
+   return false;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   string port = ( argc > 1 ) ? argv[1] : "23457";
+
+   ossimToolServer server;
+   server.setNumberOfThreads( 2 );
+   std::thread listener( [&server, &port]() { server.startListening( port.c_str() ); } );
+
+   // Clients all at once, the odd ones hang up, the even ones stay connected:
+   std::atomic<ossim_uint32> answered( 0 );
+   vector< std::shared_ptr<ossimToolClient> > clients;
+   vector<std::thread> threads;
+   for ( ossim_uint32 i = 0; i < CLIENTS; ++i )
+   {
+      std::shared_ptr<ossimToolClient> client = std::make_shared<ossimToolClient>();
+      clients.push_back( client );
+      threads.push_back( std::thread( [client, i, &port, &answered]()
+      {
+         if ( !connect( *client, port ) )
+         {
+            return;
+         }
+         for ( ossim_uint32 r = 0; r < REQUESTS; ++r )
+         {
+            if ( client->execute( "stats" ) &&
+                 string( client->getTextResponse() ).find( "requests:" ) != string::npos )
+            {
+               ++answered;
+            }
+         }
+         if ( i % 2 )
+         {
+            client->disconnect();
+         }
+      } ) );
+   }
+   for ( ossim_uint32 i = 0; i < threads.size(); ++i )
+   {
+      threads[i].join();
+   }
+
+   bool test_failed = false;
+   bool ok = ( answered == CLIENTS * REQUESTS );
+   cout << "concurrent requests answered (" << answered << " of " << CLIENTS * REQUESTS
+        << ")? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   test_failed |= !ok;
+
+   // Connections still open must not keep the server from stopping:
+   server.stopListening();
+   listener.join();
+
+   string stats = server.getStatistics();
+   ostringstream connections;
+   connections << "connections: " << CLIENTS << " (open 0)";
+   ostringstream requests;
+   requests << "requests: " << CLIENTS * REQUESTS << " (errors 0)";
+   ok = ( stats.find( connections.str() ) != string::npos ) &&
+      ( stats.find( requests.str() ) != string::npos );
+   cout << "stopped with every connection closed? " << ( ok ? "PASSED" : "FAILED" ) << endl;
+   if ( !ok )
+   {
+      cout << stats << endl;
+   }
+   test_failed |= !ok;
+
+   clients.clear();
+
+   if (!test_failed)
+      cout<<"\nAll tests PASSED.\n"<<endl;
+   else
+      cout<<"\nEncountered at least one FAILED.\n"<<endl;
+
+   return test_failed;
+}